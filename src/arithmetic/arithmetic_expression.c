@@ -202,6 +202,9 @@ AR_ExpNode *AR_EXP_NewOpNode
 		// generate aggregation context and store it in node's private data
 		ASSERT(func->callbacks.private_data != NULL);
 		node->op.private_data = func->callbacks.private_data();
+	} else if(func->callbacks.new_private_data != NULL) {
+		// scalar function maintaining per node state
+		node->op.private_data = func->callbacks.new_private_data();
 	}
 
 	return node;
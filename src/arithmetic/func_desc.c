@@ -64,6 +64,15 @@ inline void AR_SetPrivateDataRoutines
 	func_desc->callbacks.clone = clone;
 }
 
+inline void AR_SetPrivateDataGenerator
+(
+	AR_FuncDesc *func_desc,
+	AR_Func_NewPrivateData new_private_data
+) {
+	ASSERT(func_desc->aggregate == false);
+	func_desc->callbacks.new_private_data = new_private_data;
+}
+
 // get arithmetic function
 AR_FuncDesc *AR_GetFunc
 (
@@ -34,12 +34,17 @@ typedef void *(*AR_Func_Clone)(void *orig);
 // AR_Func_PrivateData - function pointer to a routine which produce function's private data
 typedef AggregateCtx *(*AR_Func_PrivateData)(void);
 
+// AR_Func_NewPrivateData - function pointer to a routine which produce
+// a scalar function's per expression node private data
+typedef void *(*AR_Func_NewPrivateData)(void);
+
 // aggregation function callbacks
 typedef struct {
 	AR_Func_Free free;                  // [optional] function pointer to cleanup routine
 	AR_Func_Clone clone;                // [optional] function pointer to clone routine
 	AR_Func_Finalize finalize;          // [optional] function pointer to finalizing aggregate value routine
 	AR_Func_PrivateData private_data;   // function pointer to private data generator
+	AR_Func_NewPrivateData new_private_data;  // [optional] scalar function private data generator
 } AR_FuncCBs;
 
 typedef struct {
@@ -82,6 +87,14 @@ void AR_SetPrivateDataRoutines
 	AR_Func_Clone clone
 );
 
+// set the function pointer for generating a scalar function's private data
+// invoked once for each expression node calling the function
+void AR_SetPrivateDataGenerator
+(
+	AR_FuncDesc *func_desc,
+	AR_Func_NewPrivateData new_private_data
+);
+
 // retrieves an arithmetic function by its name
 AR_FuncDesc *AR_GetFunc
 (
@@ -0,0 +1,176 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "regex_cache.h"
+#include "../../util/rmalloc.h"
+#include "../../errors/errors.h"
+
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+struct RegexCache {
+	char *pattern;   // pattern compiled into regex
+	regex_t *regex;  // compiled regex
+	bool dynamic;    // call-site observed multiple patterns
+};
+
+// per-thread cache entry
+typedef struct {
+	char *pattern;      // regex pattern
+	size_t len;         // pattern length
+	regex_t *regex;     // compiled regex
+	uint64_t last_use;  // LRU clock of last access
+} ThreadRegexEntry;
+
+// per-thread LRU cache
+static __thread ThreadRegexEntry _thread_cache[REGEX_CACHE_THREAD_CAP];
+static __thread uint64_t _thread_clock;
+
+// global statistics
+static atomic_uint_fast64_t _hits;
+static atomic_uint_fast64_t _thread_hits;
+static atomic_uint_fast64_t _misses;
+static atomic_uint_fast64_t _evictions;
+
+// compile pattern
+// returns NULL and sets a query error if compilation failed
+static regex_t *_RegexCache_Compile
+(
+	const char *pattern,
+	size_t len
+) {
+	regex_t *regex;
+	OnigErrorInfo einfo;
+
+	atomic_fetch_add(&_misses, 1);
+
+	int rv = onig_new(&regex, (const UChar *)pattern,
+		(const UChar *)(pattern + len), ONIG_OPTION_DEFAULT,
+		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
+
+	if(rv != ONIG_NORMAL) {
+		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
+		onig_error_code_to_str((UChar* )s, rv, &einfo);
+		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
+		return NULL;
+	}
+
+	return regex;
+}
+
+// lookup pattern in the current thread's LRU cache
+// compiles and caches pattern on miss, evicting the least recently used entry
+static regex_t *_RegexCache_ThreadGet
+(
+	const char *pattern
+) {
+	size_t len = strlen(pattern);
+	uint64_t clock = ++_thread_clock;
+	ThreadRegexEntry *victim = _thread_cache;
+
+	for(int i = 0; i < REGEX_CACHE_THREAD_CAP; i++) {
+		ThreadRegexEntry *e = _thread_cache + i;
+		if(e->regex != NULL && e->len == len &&
+		   memcmp(e->pattern, pattern, len) == 0) {
+			atomic_fetch_add(&_thread_hits, 1);
+			e->last_use = clock;
+			return e->regex;
+		}
+
+		// track least recently used entry, prefer empty slots
+		if(victim->regex != NULL &&
+		   (e->regex == NULL || e->last_use < victim->last_use)) {
+			victim = e;
+		}
+	}
+
+	regex_t *regex = _RegexCache_Compile(pattern, len);
+	if(regex == NULL) return NULL;
+
+	// evict
+	if(victim->regex != NULL) {
+		atomic_fetch_add(&_evictions, 1);
+		onig_free(victim->regex);
+		rm_free(victim->pattern);
+	}
+
+	victim->len      = len;
+	victim->regex    = regex;
+	victim->pattern  = rm_strdup(pattern);
+	victim->last_use = clock;
+
+	return regex;
+}
+
+RegexCache *RegexCache_New(void) {
+	return rm_calloc(1, sizeof(RegexCache));
+}
+
+regex_t *RegexCache_Get
+(
+	RegexCache *cache,
+	const char *pattern
+) {
+	ASSERT(pattern != NULL);
+
+	if(cache == NULL || cache->dynamic) {
+		return _RegexCache_ThreadGet(pattern);
+	}
+
+	if(cache->regex != NULL) {
+		if(strcmp(cache->pattern, pattern) == 0) {
+			atomic_fetch_add(&_hits, 1);
+			return cache->regex;
+		}
+
+		// pattern changed, call-site pattern isn't fixed
+		// hand over to the per-thread cache from here on
+		onig_free(cache->regex);
+		rm_free(cache->pattern);
+		cache->regex   = NULL;
+		cache->pattern = NULL;
+		cache->dynamic = true;
+		return _RegexCache_ThreadGet(pattern);
+	}
+
+	// first lookup, compile and retain
+	regex_t *regex = _RegexCache_Compile(pattern, strlen(pattern));
+	if(regex == NULL) return NULL;
+
+	cache->regex   = regex;
+	cache->pattern = rm_strdup(pattern);
+
+	return regex;
+}
+
+void RegexCache_Free
+(
+	RegexCache *cache
+) {
+	ASSERT(cache != NULL);
+
+	if(cache->regex != NULL) {
+		onig_free(cache->regex);
+		rm_free(cache->pattern);
+	}
+
+	rm_free(cache);
+}
+
+void RegexCache_GetStats
+(
+	RegexCacheStats *stats
+) {
+	ASSERT(stats != NULL);
+
+	stats->hits        = atomic_load(&_hits);
+	stats->thread_hits = atomic_load(&_thread_hits);
+	stats->misses      = atomic_load(&_misses);
+	stats->evictions   = atomic_load(&_evictions);
+}
+
@@ -0,0 +1,58 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "../deps/oniguruma/src/oniguruma.h"
+
+// number of compiled regexes each thread keeps around
+#define REGEX_CACHE_THREAD_CAP 32
+
+// compiled regex cache
+//
+// a call-site cache is attached to each string.matchRegEx /
+// string.replaceRegEx expression node, it holds on to the compiled regex
+// as long as the pattern doesn't change, which is the case for constant and
+// parameterized patterns
+//
+// once a call-site observes more than a single pattern it switches over
+// to a bounded per-thread LRU cache
+typedef struct RegexCache RegexCache;
+
+// regex cache statistics
+typedef struct {
+	uint64_t hits;         // lookups served by a call-site cache
+	uint64_t thread_hits;  // lookups served by a per-thread cache
+	uint64_t misses;       // lookups which required compilation
+	uint64_t evictions;    // number of regexes evicted from per-thread caches
+} RegexCacheStats;
+
+// create a new call-site regex cache
+RegexCache *RegexCache_New(void);
+
+// get a compiled regex for pattern
+// returns NULL and sets a query error if pattern fails to compile
+// the returned regex is owned by the cache and remains valid until the next
+// call to RegexCache_Get on the same cache or thread
+regex_t *RegexCache_Get
+(
+	RegexCache *cache,   // [optional] call-site cache
+	const char *pattern  // regex pattern
+);
+
+// free call-site regex cache
+void RegexCache_Free
+(
+	RegexCache *cache
+);
+
+// collect regex cache statistics
+void RegexCache_GetStats
+(
+	RegexCacheStats *stats  // [output] statistics
+);
+
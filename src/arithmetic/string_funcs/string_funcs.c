@@ -4,12 +4,14 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
+#include "regex_cache.h"
 #include "string_funcs.h"
 #include "../func_desc.h"
 #include "../../util/arr.h"
 #include "../../util/uuid.h"
 #include "utf8proc/utf8proc.h"
 #include "../../util/rmalloc.h"
+#include "../../util/strsimd.h"
 #include "../../util/strutil.h"
 #include "../../errors/errors.h"
 #include "../../util/math_util.h"
@@ -314,6 +316,16 @@ static int match_regex_scan_cb(int n, int pos, OnigRegion *region, void *arg) {
 	return 0;
 }
 
+// regex functions private data routines
+// each call-site maintains its own compiled regex cache
+static void *RegexCache_PrivateData(void) {
+	return RegexCache_New();
+}
+
+static void RegexCache_PrivateDataFree(void *ctx) {
+	RegexCache_Free((RegexCache *)ctx);
+}
+
 // given a string and a regular expression,
 // return an array of all matches and matching regions
 // string.matchRegEx(str, regex) -> array(array(string))
@@ -323,44 +335,35 @@ SIValue AR_MATCHREGEX(SIValue *argv, int argc, void *private_data) {
 		return list;
 	}
 
-	regex_t *regex;
-	OnigErrorInfo einfo;
-	OnigRegion *region    = onig_region_new();
 	const char *str       = argv[0].stringval;
 	const char *regex_str = argv[1].stringval;
 
-	int rv = onig_new(&regex, (const UChar *)regex_str, 
-		(const UChar *)(regex_str + strlen(regex_str)), ONIG_OPTION_DEFAULT,
-		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
-	if(rv != ONIG_NORMAL) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
-		onig_error_code_to_str((UChar* )s, rv, &einfo);
-		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
-		onig_region_free(region, 1);
+	// get compiled regex, compiles on cache miss
+	regex_t *regex = RegexCache_Get(private_data, regex_str);
+	if(regex == NULL) {
 		SIValue_Free(list);
 		return SI_NullVal();
 	}
 
+	OnigRegion *region = onig_region_new();
+
 	match_regex_scan_cb_args args = {
 		.list = &list,
 		.str = str
 	};
 
-	rv = onig_scan(regex, (const UChar *)str,
+	int rv = onig_scan(regex, (const UChar *)str,
 		(const UChar *)(str + strlen(str)), region, ONIG_OPTION_DEFAULT,
 		match_regex_scan_cb, &args);
 	if(rv < 0) {
 		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 		onig_error_code_to_str((OnigUChar* )s, rv);
 		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
 		onig_region_free(region, 1);
 		SIValue_Free(list);
 		return SI_NullVal();
 	}
 
-	onig_free(regex);
 	onig_region_free(region, 1);
 
 	return list;
@@ -419,21 +422,11 @@ SIValue AR_REPLACEREGEX(SIValue *argv, int argc, void *private_data) {
 		replacement = argv[2].stringval;
 	}
 
-	regex_t *regex;
-	OnigErrorInfo einfo;
-	OnigRegion *region = onig_region_new();
+	// get compiled regex, compiles on cache miss
+	regex_t *regex = RegexCache_Get(private_data, regex_str);
+	if(regex == NULL) return SI_NullVal();
 
-	int rv = onig_new(&regex, (const UChar *)regex_str, 
-		(const UChar *)(regex_str + strlen(regex_str)), ONIG_OPTION_DEFAULT,
-		ONIG_ENCODING_UTF8, ONIG_SYNTAX_JAVA, &einfo);
-	if(rv != ONIG_NORMAL) {
-		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
-		onig_error_code_to_str((UChar* )s, rv, &einfo);
-		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
-		onig_region_free(region, 1);
-		return SI_NullVal();
-	}
+	OnigRegion *region = onig_region_new();
 
 	replace_regex_scan_cb_args args = {
 		.res = NULL,
@@ -444,19 +437,18 @@ SIValue AR_REPLACEREGEX(SIValue *argv, int argc, void *private_data) {
 		.replacement_len = strlen(replacement)
 	};
 
-	rv = onig_scan(regex, (const UChar *)str,
+	int rv = onig_scan(regex, (const UChar *)str,
 		(const UChar *)(str + strlen(str)), region, ONIG_OPTION_DEFAULT,
 		replace_regex_scan_cb, &args);
 	if(rv < 0) {
 		char s[ONIG_MAX_ERROR_MESSAGE_LEN];
 		onig_error_code_to_str((OnigUChar* )s, rv);
 		ErrorCtx_SetError(EMSG_INVALID_REGEX, s);
-		onig_free(regex);
 		onig_region_free(region, 1);
+		rm_free(args.res);
 		return SI_NullVal();
 	}
 
-	onig_free(regex);
 	onig_region_free(region, 1);
 
 	// copy the remaining string
@@ -507,10 +499,17 @@ SIValue AR_TOJSON(SIValue *argv, int argc, void *private_data) {
 // returns the original string with leading and trailing whitespace removed.
 SIValue AR_TRIM(SIValue *argv, int argc, void *private_data) {
 	if(SIValue_IsNull(argv[0])) return SI_NullVal();
-	SIValue ltrim = AR_LTRIM(argv, argc, NULL);
-	SIValue trimmed = AR_RTRIM(&ltrim, 1, NULL);
-	SIValue_Free(ltrim);
-	return trimmed;
+
+	const char *str = argv[0].stringval;
+
+	// skip leading whitespace
+	while(*str == ' ') str++;
+
+	// skip trailing whitespace
+	size_t len = strlen(str);
+	while(len > 0 && str[len - 1] == ' ') len--;
+
+	return SI_TransferStringVal(rm_strndup(str, len));
 }
 
 // returns true if argv[1] is a substring of argv[0].
@@ -522,7 +521,7 @@ SIValue AR_CONTAINS(SIValue *argv, int argc, void *private_data) {
 	const char *needle = argv[1].stringval;
 
 	// See if needle is in hay.
-	bool found = (strstr(hay, needle) != NULL);
+	bool found = (str_find(hay, strlen(hay), needle, strlen(needle)) != NULL);
 	return SI_BoolVal(found);
 }
 
@@ -533,18 +532,13 @@ SIValue AR_STARTSWITH(SIValue *argv, int argc, void *private_data) {
 
 	const char *str = argv[0].stringval;
 	const char *sub_string = argv[1].stringval;
-	size_t str_len = strlen(str);
 	size_t sub_string_len = strlen(sub_string);
 
-	// If sub-string is longer then string return quickly.
-	if(sub_string_len > str_len) return SI_BoolVal(false);
-
-	// Compare character by character, see if there's a match.
-	for(int i = 0; i < sub_string_len; i++) {
-		if(str[i] != sub_string[i]) return SI_BoolVal(false);
-	}
+	// If sub-string is longer then string return quickly,
+	// no need to scan str beyond sub-string's length.
+	if(strnlen(str, sub_string_len) < sub_string_len) return SI_BoolVal(false);
 
-	return SI_BoolVal(true);
+	return SI_BoolVal(memcmp(str, sub_string, sub_string_len) == 0);
 }
 
 // returns true if argv[0] ends with argv[1].
@@ -562,12 +556,8 @@ SIValue AR_ENDSWITH(SIValue *argv, int argc, void *private_data) {
 
 	// Advance str to the "end"
 	str += (str_len - sub_string_len);
-	// Compare character by character, see if there's a match.
-	for(int i = 0; i < sub_string_len; i++) {
-		if(str[i] != sub_string[i]) return SI_BoolVal(false);
-	}
 
-	return SI_BoolVal(true);
+	return SI_BoolVal(memcmp(str, sub_string, sub_string_len) == 0);
 }
 
 // returns a string in which all occurrences of a specified string in the original string have been replaced by ANOTHER (specified) string.
@@ -600,7 +590,7 @@ SIValue AR_REPLACE(SIValue *argv, int argc, void *private_data) {
 
 	while(ptr <= str + str_len) {
 		// find pointer to next substring
-		ptr = strstr(ptr, old_string);
+		ptr = str_find(ptr, str + str_len - ptr, old_string, old_string_len);
 
 		// if no substring found, then break from the loop
 		if(ptr == NULL) break;
@@ -788,6 +778,8 @@ void Register_StringFuncs() {
 	array_append(types, (T_STRING | T_NULL));
 	ret_type = T_ARRAY | T_NULL;
 	func_desc = AR_FuncDescNew("string.matchRegEx", AR_MATCHREGEX, 2, 2, types, ret_type, false, true);
+	AR_SetPrivateDataRoutines(func_desc, RegexCache_PrivateDataFree, NULL);
+	AR_SetPrivateDataGenerator(func_desc, RegexCache_PrivateData);
 	AR_RegFunc(func_desc);
 
 	types = array_new(SIType, 3);
@@ -796,6 +788,8 @@ void Register_StringFuncs() {
 	array_append(types, (T_STRING | T_NULL));
 	ret_type = T_STRING | T_NULL;
 	func_desc = AR_FuncDescNew("string.replaceRegEx", AR_REPLACEREGEX, 2, 3, types, ret_type, false, true);
+	AR_SetPrivateDataRoutines(func_desc, RegexCache_PrivateDataFree, NULL);
+	AR_SetPrivateDataGenerator(func_desc, RegexCache_PrivateData);
 	AR_RegFunc(func_desc);
 
 	types = array_new(SIType, 1);
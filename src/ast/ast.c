@@ -404,6 +404,8 @@ AST *AST_Build
 	ast->parse_result        = parse_result;
 	ast->referenced_entities = NULL;
 	ast->params_parse_result = NULL;
+	ast->fingerprint_query   = NULL;
+	ast->fingerprint         = 0;
 	ast->anot_ctx_collection = AST_AnnotationCtxCollection_New();
 
 	*(ast->ref_count) = 1;
@@ -442,6 +444,8 @@ AST *AST_NewSegment
 	ast->parse_result        = NULL;
 	ast->params_parse_result = NULL;
 	ast->referenced_entities = NULL;
+	ast->fingerprint_query   = NULL;
+	ast->fingerprint         = 0;
 	ast->anot_ctx_collection = master_ast->anot_ctx_collection;
 
 	uint n = end_offset - start_offset;
@@ -734,6 +738,8 @@ cypher_parse_result_t *parse_query
 		return NULL;
 	}
 
+	QueryCtx_Trace(QueryTrace_VALIDATE);
+
 	// get the index of a valid root (of type CYPHER_AST_STATEMENT)
 	int index;
 	if(AST_Validate_ParseResultRoot(result, &index) == AST_INVALID) {
@@ -850,6 +856,7 @@ void AST_Free
 		}
 
 		if(ast->referenced_entities) raxFree(ast->referenced_entities);
+		if(ast->fingerprint_query) rm_free(ast->fingerprint_query);
 
 		rm_free(ast->ref_count);
 	}
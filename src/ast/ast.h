@@ -28,6 +28,8 @@ typedef struct {
 	uint *ref_count;                                    // A pointer to reference counter (for deletion).
 	cypher_parse_result_t *parse_result;                // Query parsing output.
 	cypher_parse_result_t *params_parse_result;         // Parameters parsing output.
+	char *fingerprint_query;                            // Query text with literals stripped.
+	uint64_t fingerprint;                               // Hash of the fingerprint query.
 } AST;
 
 // checks to see if libcypher-parser reported any errors
@@ -167,6 +169,15 @@ void AST_SetParamsParseResult
 	cypher_parse_result_t *params_parse_result
 );
 
+// compute the AST's fingerprint
+// the query is normalized by replacing each literal with '?' and collapsing
+// whitespace, queries differing only in literal values share a fingerprint
+void AST_Fingerprint
+(
+	AST *ast,          // AST to fingerprint
+	const char *query  // query text the AST was parsed from
+);
+
 // returns a shallow copy of the original AST pointer with ref counter increased
 AST *AST_ShallowCopy
 (
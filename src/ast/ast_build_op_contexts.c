@@ -310,6 +310,33 @@ AST_UnwindContext AST_PrepareUnwindOp
 	return ctx;
 }
 
+//------------------------------------------------------------------------------
+// LOAD CSV operation
+//------------------------------------------------------------------------------
+
+AST_LoadCSVContext AST_PrepareLoadCSVOp
+(
+	const cypher_astnode_t *load_csv_clause
+) {
+	const cypher_astnode_t *url = cypher_ast_load_csv_get_url(load_csv_clause);
+	const cypher_astnode_t *alias =
+		cypher_ast_load_csv_get_identifier(load_csv_clause);
+	const cypher_astnode_t *terminator =
+		cypher_ast_load_csv_get_field_terminator(load_csv_clause);
+
+	AR_ExpNode *exp = AR_EXP_FromASTNode(url);
+	exp->resolved_name = cypher_ast_identifier_get_name(alias);
+
+	AST_LoadCSVContext ctx = {
+		.exp          = exp,
+		.with_headers = cypher_ast_load_csv_has_with_headers(load_csv_clause),
+		.delimiter    = (terminator != NULL) ?
+			cypher_ast_string_get_value(terminator)[0] : ','
+	};
+
+	return ctx;
+}
+
 //------------------------------------------------------------------------------
 // DELETE operation
 //------------------------------------------------------------------------------
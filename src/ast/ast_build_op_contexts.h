@@ -20,6 +20,12 @@ typedef struct {
 	AR_ExpNode *exp;
 } AST_UnwindContext;
 
+typedef struct {
+	AR_ExpNode *exp;    // URL expression, resolved name is the row alias
+	bool with_headers;  // first row holds column names
+	char delimiter;     // field delimiter
+} AST_LoadCSVContext;
+
 typedef struct {
 	rax *on_match;                   // rax of updates to make for ON MATCH directives
 	rax *on_create;                  // rax of updates to make for ON CREATE directives
@@ -65,6 +71,13 @@ AST_UnwindContext AST_PrepareUnwindOp
 	const cypher_astnode_t *unwind_clause
 );
 
+// extract the necessary information to populate a load CSV operation
+// from a LOAD CSV clause
+AST_LoadCSVContext AST_PrepareLoadCSVOp
+(
+	const cypher_astnode_t *load_csv_clause
+);
+
 void AST_PreparePathCreation
 (
 	const cypher_astnode_t *path,
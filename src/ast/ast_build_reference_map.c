@@ -324,6 +324,19 @@ static void _AST_MapUnwindClauseReferences
 	_AST_MapExpression(ast, expr);
 }
 
+// maps entities in LOAD CSV clause
+static void _AST_MapLoadCSVClauseReferences
+(
+	AST *ast,
+	const cypher_astnode_t *load_csv_clause
+) {
+	ASSERT(ast != NULL);
+	ASSERT(load_csv_clause != NULL);
+
+	const cypher_astnode_t *url = cypher_ast_load_csv_get_url(load_csv_clause);
+	_AST_MapExpression(ast, url);
+}
+
 // maps entities in a FOREACH clause
 // MATCH (n) FOREACH(v in [1,2,3,4] | CREATE (:L{x:v})-[:R]->(n))
 static void _AST_MapForeachClauseReferences
@@ -485,6 +498,9 @@ static void _ASTClause_BuildReferenceMap(AST *ast, const cypher_astnode_t *claus
 	} else if(type == CYPHER_AST_UNWIND) {
 		// add referenced aliases for UNWIND clause
 		_AST_MapUnwindClauseReferences(ast, clause);
+	} else if(type == CYPHER_AST_LOAD_CSV) {
+		// add referenced aliases for LOAD CSV clause
+		_AST_MapLoadCSVClauseReferences(ast, clause);
 	} else if(type == CYPHER_AST_FOREACH) {
 		// add referenced aliases for a FOREACH clause
 		_AST_MapForeachClauseReferences(ast, clause);
@@ -0,0 +1,121 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "ast.h"
+#include "xxhash.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+
+// literal's location within the query text
+typedef struct {
+	size_t start;  // offset of literal's first character
+	size_t end;    // offset past literal's last character
+} LiteralRange;
+
+static inline bool _is_literal
+(
+	const cypher_astnode_t *node
+) {
+	cypher_astnode_type_t t = cypher_astnode_type(node);
+	return (t == CYPHER_AST_INTEGER ||
+			t == CYPHER_AST_FLOAT   ||
+			t == CYPHER_AST_STRING  ||
+			t == CYPHER_AST_TRUE    ||
+			t == CYPHER_AST_FALSE);
+}
+
+// collect the ranges of all literals under node
+static void _collect_literals
+(
+	const cypher_astnode_t *node,  // node to inspect
+	LiteralRange **ranges          // [output] literal ranges
+) {
+	if(_is_literal(node)) {
+		struct cypher_input_range r = cypher_astnode_range(node);
+		LiteralRange range = {.start = r.start.offset, .end = r.end.offset};
+		array_append(*ranges, range);
+		return;
+	}
+
+	uint n = cypher_astnode_nchildren(node);
+	for(uint i = 0; i < n; i++) {
+		_collect_literals(cypher_astnode_get_child(node, i), ranges);
+	}
+}
+
+static int _cmp_ranges
+(
+	const void *a,
+	const void *b
+) {
+	const LiteralRange *ra = a;
+	const LiteralRange *rb = b;
+	return (ra->start > rb->start) - (ra->start < rb->start);
+}
+
+void AST_Fingerprint
+(
+	AST *ast,          // AST to fingerprint
+	const char *query  // query text the AST was parsed from
+) {
+	ASSERT(ast   != NULL);
+	ASSERT(query != NULL);
+	ASSERT(ast->fingerprint_query == NULL);
+
+	size_t len = strlen(query);
+
+	// rewritten clauses might visit a literal more than once
+	// ranges are sorted, overlapping and out of bound ranges are skipped
+	LiteralRange *ranges = array_new(LiteralRange, 0);
+	_collect_literals(ast->root, &ranges);
+
+	uint n = array_len(ranges);
+	qsort(ranges, n, sizeof(LiteralRange), _cmp_ranges);
+
+	// normalized query is never longer than the original
+	char *normalized = rm_malloc(len + 1);
+
+	uint r = 0;        // current range
+	size_t j = 0;      // normalized query length
+	bool space = true; // last emitted character is a space
+
+	for(size_t i = 0; i < len;) {
+		// skip ranges behind the current position
+		while(r < n && ranges[r].start < i) r++;
+
+		if(r < n && ranges[r].start == i && ranges[r].end > i &&
+		   ranges[r].end <= len) {
+			// replace literal
+			normalized[j++] = '?';
+			space = false;
+			i = ranges[r++].end;
+			continue;
+		}
+
+		// collapse whitespace
+		char c = query[i++];
+		if(isspace(c)) {
+			if(!space) normalized[j++] = ' ';
+			space = true;
+		} else {
+			normalized[j++] = c;
+			space = false;
+		}
+	}
+
+	// trim trailing whitespace
+	if(j > 0 && space) j--;
+	normalized[j] = '\0';
+
+	ast->fingerprint_query = normalized;
+	ast->fingerprint       = XXH64(normalized, j, 0);
+
+	array_free(ranges);
+}
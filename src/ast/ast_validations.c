@@ -1622,6 +1622,45 @@ static VISITOR_STRATEGY _Validate_UNWIND_Clause
 	return VISITOR_RECURSE;
 }
 
+// validate a LOAD CSV clause
+// LOAD CSV WITH HEADERS FROM 'file:///people.csv' AS row FIELDTERMINATOR ';'
+static VISITOR_STRATEGY _Validate_LOAD_CSV_Clause
+(
+	const cypher_astnode_t *n,  // ast-node
+	bool start,                 // first traversal
+	ast_visitor *visitor        // visitor
+) {
+	validations_ctx *vctx = AST_Visitor_GetContext(visitor);
+
+	// we enter ONLY when start=true, so no check is needed
+
+	vctx->clause = cypher_astnode_type(n);
+
+	// field terminator must be a single character
+	const cypher_astnode_t *terminator =
+		cypher_ast_load_csv_get_field_terminator(n);
+	if(terminator != NULL &&
+	   strlen(cypher_ast_string_get_value(terminator)) != 1) {
+		ErrorCtx_SetError(EMSG_LOAD_CSV_FIELD_TERMINATOR);
+		return VISITOR_BREAK;
+	}
+
+	// the URL expression can not refer to the row alias
+	AST_Visitor_visit(cypher_ast_load_csv_get_url(n), visitor);
+	if(ErrorCtx_EncounteredError()) {
+		return VISITOR_BREAK;
+	}
+
+	// introduce row alias to bound vars
+	const cypher_astnode_t *alias = cypher_ast_load_csv_get_identifier(n);
+	const char *identifier = cypher_ast_identifier_get_name(alias);
+	raxInsert(vctx->defined_identifiers, (unsigned char *)identifier,
+			strlen(identifier), NULL, NULL);
+
+	// do not traverse children
+	return VISITOR_CONTINUE;
+}
+
 // validate a FOREACH clause
 // MATCH (n) FOREACH(x in [1,2,3] | CREATE (n)-[:R]->({v:x}))
 static VISITOR_STRATEGY _Validate_FOREACH_Clause
@@ -1934,6 +1973,7 @@ static AST_Validation _ValidateClauseOrder
 		cypher_astnode_type_t type = cypher_astnode_type(clause);
 		if(encountered_updating_clause && (type == CYPHER_AST_MATCH          ||
 										   type == CYPHER_AST_UNWIND         ||
+										   type == CYPHER_AST_LOAD_CSV       ||
 										   type == CYPHER_AST_CALL           ||
 										   type == CYPHER_AST_CALL_SUBQUERY)) {
 			ErrorCtx_SetError(EMSG_MISSING_WITH, cypher_astnode_typestr(type));
@@ -2057,6 +2097,7 @@ bool AST_ValidationsMappingInit(void) {
 	validations_mapping[CYPHER_AST_SINGLE]                     = _Validate_list_comprehension;
 	validations_mapping[CYPHER_AST_RETURN]                     = _Validate_RETURN_Clause;
 	validations_mapping[CYPHER_AST_UNWIND]                     = _Validate_UNWIND_Clause;
+	validations_mapping[CYPHER_AST_LOAD_CSV]                   = _Validate_LOAD_CSV_Clause;
 	validations_mapping[CYPHER_AST_CREATE]                     = _Validate_CREATE_Clause;
 	validations_mapping[CYPHER_AST_DELETE]                     = _Validate_DELETE_Clause;
 	validations_mapping[CYPHER_AST_REDUCE]                     = _Validate_reduce;
@@ -2084,7 +2125,6 @@ bool AST_ValidationsMappingInit(void) {
 	validations_mapping[CYPHER_AST_FILTER]                      = _visit_break;
 	validations_mapping[CYPHER_AST_EXTRACT]                     = _visit_break;
 	validations_mapping[CYPHER_AST_COMMAND]                     = _visit_break;
-	validations_mapping[CYPHER_AST_LOAD_CSV]                    = _visit_break;
 	validations_mapping[CYPHER_AST_MATCH_HINT]                  = _visit_break;
 	validations_mapping[CYPHER_AST_USING_JOIN]                  = _visit_break;
 	validations_mapping[CYPHER_AST_USING_SCAN]                  = _visit_break;
@@ -2105,7 +2145,6 @@ bool AST_ValidationsMappingInit(void) {
 	validations_mapping[CYPHER_AST_REL_INDEX_LOOKUP]            = _visit_break;
 	validations_mapping[CYPHER_AST_NODE_INDEX_QUERY]            = _visit_break;
 	validations_mapping[CYPHER_AST_NODE_INDEX_LOOKUP]           = _visit_break;
-	validations_mapping[CYPHER_AST_USING_PERIODIC_COMMIT]       = _visit_break;
 	validations_mapping[CYPHER_AST_DROP_REL_PROP_CONSTRAINT]    = _visit_break;
 	validations_mapping[CYPHER_AST_DROP_NODE_PROP_CONSTRAINT]   = _visit_break;
 	validations_mapping[CYPHER_AST_CREATE_REL_PROP_CONSTRAINT]  = _visit_break;
@@ -2159,6 +2198,35 @@ AST_Validation AST_Validate_ParseResultRoot
 	return AST_INVALID;
 }
 
+// validate USING PERIODIC COMMIT query option
+// the option is only valid for queries loading data via LOAD CSV
+static AST_Validation _ValidatePeriodicCommit
+(
+	const AST *ast  // ast
+) {
+	uint noptions = cypher_ast_query_noptions(ast->root);
+	for(uint i = 0; i < noptions; i++) {
+		const cypher_astnode_t *option = cypher_ast_query_get_option(ast->root, i);
+		if(cypher_astnode_type(option) != CYPHER_AST_USING_PERIODIC_COMMIT) {
+			continue;
+		}
+
+		const cypher_astnode_t *limit =
+			cypher_ast_using_periodic_commit_get_limit(option);
+		if(limit != NULL && AST_ParseIntegerNode(limit) <= 0) {
+			ErrorCtx_SetError(EMSG_PERIODIC_COMMIT_BATCH);
+			return AST_INVALID;
+		}
+
+		if(!AST_TreeContainsType(ast->root, CYPHER_AST_LOAD_CSV)) {
+			ErrorCtx_SetError(EMSG_PERIODIC_COMMIT_LOAD_CSV);
+			return AST_INVALID;
+		}
+	}
+
+	return AST_VALID;
+}
+
 // validate a query
 AST_Validation AST_Validate_Query
 (
@@ -2185,6 +2253,11 @@ AST_Validation AST_Validate_Query
 		return AST_INVALID;
 	}
 
+	// Verify USING PERIODIC COMMIT is only used along with LOAD CSV.
+	if(_ValidatePeriodicCommit(&ast) != AST_VALID) {
+		return AST_INVALID;
+	}
+
 	// Verify that the clauses surrounding UNION return the same column names.
 	if(_ValidateUnion_Clauses(&ast) != AST_VALID) {
 		return AST_INVALID;
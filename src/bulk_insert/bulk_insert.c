@@ -10,6 +10,23 @@
 #include "../schema/schema.h"
 #include "../util/arr.h"
 #include "../util/rmalloc.h"
+#include "../util/import_folder.h"
+#include "../util/thpool/pools.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// entities are parsed in chunks by multiple workers
+// once parsed, entities are created in bulk, building the graph's matrices
+// in one go rather than setting individual matrix elements
+
+#define BULK_CHUNK_SIZE      16384     // #entities in a parsed chunk
+#define BULK_MAX_ARRAY_DEPTH 64        // max nesting depth of array properties
+#define BULK_MAX_LOAD_SIZE   (64 << 20)  // max #bytes loaded from file per call
 
 // the first byte of each property in the binary stream
 // is used to indicate the type of the subsequent SIValue
@@ -22,6 +39,30 @@ typedef enum {
 	BI_ARRAY = 5,
 } TYPE;
 
+// bulk file section types
+typedef enum {
+	BULK_SECTION_NODES = 0,
+	BULK_SECTION_EDGES = 1,
+} BulkSectionType;
+
+// bulk file section header: 1-byte section type followed by 8-byte blob length
+#define BULK_SECTION_HEADER_SIZE (1 + sizeof(uint64_t))
+
+// binary stream parsing context shared by all workers
+typedef struct {
+	const char *data;              // binary stream
+	const size_t *offsets;         // stream offset of each chunk
+	uint64_t count;                // number of entities in stream
+	uint64_t chunk_count;          // number of chunks
+	uint64_t _Atomic next_chunk;   // next chunk to parse
+	bool edges;                    // stream holds edges
+	uint prop_count;               // number of properties per entity
+	const Attribute_ID *props;     // properties IDs
+	NodeID *src;                   // [output] edges source node
+	NodeID *dest;                  // [output] edges destination node
+	AttributeSet *sets;            // [output] entities attributes
+} BulkParseCtx;
+
 /* binary header format:
  * - entity name : null-terminated C string
  * - property count : 4-byte unsigned integer
@@ -182,11 +223,15 @@ static SIValue _BulkInsert_ReadProperty
 			v = SIArray_New(len);
 			for (uint i = 0; i < len; i++) {
 				// Convert every element and add to array.
-				SIArray_Append(&v, _BulkInsert_ReadProperty(data, data_idx));
+				SIValue elem = _BulkInsert_ReadProperty(data, data_idx);
+				SIArray_Append(&v, elem);
+				// array holds a clone of the element
+				SIValue_Free(elem);
 			}
 			break;
 
 		default:
+			// blobs are validated prior to parsing
 			ASSERT(false);
 			break;
 	}
@@ -194,122 +239,407 @@ static SIValue _BulkInsert_ReadProperty
     return v;
 }
 
-static int _BulkInsert_ProcessNodeFile
+// advance stream index past a property without materializing it
+static void _BulkInsert_SkipProperty
 (
-	GraphContext* gc,
 	const char* data,
-	size_t data_len
+	size_t* data_idx
 ) {
-    uint prop_count;
-    size_t data_idx = 0;
+	int64_t len;
+	TYPE t = data[*data_idx];
+	*data_idx += 1;
 
-    // read the CSV file header labels and update all schemas
-    int* label_ids = _BulkInsert_ReadHeaderLabels(gc, SCHEMA_NODE, data, &data_idx);
-    uint label_count = array_len(label_ids);
-    // read the CSV header properties and collect their indices
-    Attribute_ID* prop_indices = _BulkInsert_ReadHeaderProperties(gc, SCHEMA_NODE, data,
-	&data_idx, &prop_count);
+	switch (t) {
+		case BI_NULL:
+			break;
 
-    // sync each matrix once
-    ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
+		case BI_BOOL:
+			*data_idx += 1;
+			break;
 
-	for (uint i = 0; i < label_count; i++) {
-		Graph_GetLabelMatrix(gc->g, label_ids[i]);
-	}
+		case BI_DOUBLE:
+			*data_idx += sizeof(double);
+			break;
 
-    // sync node-label matrix
-    Graph_GetNodeLabelMatrix(gc->g);
-    Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+		case BI_LONG:
+			*data_idx += sizeof(int64_t);
+			break;
 
-    //--------------------------------------------------------------------------
-    // load nodes
-    //--------------------------------------------------------------------------
+		case BI_STRING:
+			*data_idx += strlen(data + *data_idx) + 1;
+			break;
 
-	while (data_idx < data_len) {
-		Node n = GE_NEW_NODE();
-		GraphEntity* ge;
-		Graph_CreateNode(gc->g, &n, label_ids, label_count);
-		ge = (GraphEntity*)&n;
-		// process entity attributes
-		for (uint i = 0; i < prop_count; i++) {
-			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
-			// skip invalid attribute values
-			if (!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE))
-				continue;
-			GraphEntity_AddProperty(ge, prop_indices[i], value);
-		}
+		case BI_ARRAY:
+			len = *(int64_t*)&data[*data_idx];
+			*data_idx += sizeof(int64_t);
+			for (int64_t i = 0; i < len; i++) {
+				_BulkInsert_SkipProperty(data, data_idx);
+			}
+			break;
+
+		default:
+			// blobs are validated prior to parsing
+			ASSERT(false);
+			break;
 	}
+}
 
-    Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
-    if (prop_indices) rm_free(prop_indices);
-    array_free(label_ids);
+// validate a property, advancing the stream index past it
+// returns false if the property is malformed or exceeds the stream
+static bool _BulkInsert_ValidateProperty
+(
+	const char* data,  // binary stream
+	size_t data_len,   // stream length
+	size_t* data_idx,  // [input/output] stream index
+	uint depth         // array nesting depth
+) {
+	if (*data_idx >= data_len) return false;
 
-    return BULK_OK;
+	TYPE t = data[*data_idx];
+	*data_idx += 1;
+
+	size_t remaining = data_len - *data_idx;
+	const char* end;
+	int64_t len;
+
+	switch (t) {
+		case BI_NULL:
+			return true;
+
+		case BI_BOOL:
+			if (remaining < 1) return false;
+			*data_idx += 1;
+			return true;
+
+		case BI_DOUBLE:
+		case BI_LONG:
+			if (remaining < sizeof(int64_t)) return false;
+			*data_idx += sizeof(int64_t);
+			return true;
+
+		case BI_STRING:
+			// string must be terminated within the stream
+			end = memchr(data + *data_idx, '\0', remaining);
+			if (end == NULL) return false;
+			*data_idx = end - data + 1;
+			return true;
+
+		case BI_ARRAY:
+			if (depth >= BULK_MAX_ARRAY_DEPTH) return false;
+			if (remaining < sizeof(int64_t)) return false;
+			len = *(int64_t*)&data[*data_idx];
+			*data_idx += sizeof(int64_t);
+			// each element occupies at least one byte
+			if (len < 0 || (uint64_t)len > data_len - *data_idx) return false;
+			for (int64_t i = 0; i < len; i++) {
+				if (!_BulkInsert_ValidateProperty(data, data_len, data_idx,
+							depth + 1)) {
+					return false;
+				}
+			}
+			return true;
+
+		default:
+			// unknown property type
+			return false;
+	}
 }
 
-static int _BulkInsert_ProcessEdgeFile
+// validate a blob prior to loading it
+// every read is bounded by the blob length, such that once validated
+// the blob can be parsed without further checks
+// reports the number of entities in the blob and for edges the number of
+// nodes required for all edge endpoints to exist
+static bool _BulkInsert_ValidateBlob
 (
-	GraphContext* gc,
-	const char* data,
-	size_t data_len
+	const char* data,         // binary blob
+	size_t data_len,          // blob length
+	bool edges,               // blob holds edges
+	uint64_t* count,          // [output] number of entities
+	uint64_t* required_nodes  // [output] min #nodes referenced by edges
 ) {
-    int relation_id;
-    uint prop_count;
-    size_t data_idx = 0;
+	*count          = 0;
+	*required_nodes = 0;
 
-    // read the CSV file header
-    // and commit all labels and properties it introduces
-    int* type_ids = _BulkInsert_ReadHeaderLabels(gc, SCHEMA_EDGE, data, &data_idx);
-    uint type_count = array_len(type_ids);
+	// label(s) or relationship-type
+	const char* end = memchr(data, '\0', data_len);
+	if (end == NULL || end == data) return false;
 
-    // edges can only have one type
-    ASSERT(type_count == 1);
+	// edges can only have one type
+	if (edges && memchr(data, ':', end - data) != NULL) return false;
 
-    int type_id = type_ids[0];
-    Attribute_ID* prop_indices = _BulkInsert_ReadHeaderProperties(gc, SCHEMA_EDGE,
-	data, &data_idx, &prop_count);
+	size_t data_idx = end - data + 1;
 
-    // sync matrix once
-    ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
-    Graph_GetRelationMatrix(gc->g, type_id, false);
-    Graph_GetAdjacencyMatrix(gc->g, false);
-    Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+	// property count followed by property keys
+	if (data_len - data_idx < sizeof(uint)) return false;
+	uint prop_count = *(uint*)&data[data_idx];
+	data_idx += sizeof(uint);
+
+	for (uint j = 0; j < prop_count; j++) {
+		if (data_idx >= data_len) return false;
+		end = memchr(data + data_idx, '\0', data_len - data_idx);
+		if (end == NULL) return false;
+		data_idx = end - data + 1;
+	}
 
-    //--------------------------------------------------------------------------
-    // load edges
-    //--------------------------------------------------------------------------
+	// entities without a binary representation
+	if (!edges && prop_count == 0) return true;
 
 	while (data_idx < data_len) {
-		Edge e;
-		GraphEntity* ge;
+		if (edges) {
+			// source and destination IDs
+			if (data_len - data_idx < 2 * sizeof(NodeID)) return false;
+			NodeID src  = *(NodeID*)&data[data_idx];
+			NodeID dest = *(NodeID*)&data[data_idx + sizeof(NodeID)];
+			data_idx += 2 * sizeof(NodeID);
+
+			NodeID id = MAX(src, dest);
+			if (id == INVALID_ENTITY_ID) return false;
+			if (id >= *required_nodes) *required_nodes = id + 1;
+		}
+
+		for (uint i = 0; i < prop_count; i++) {
+			if (!_BulkInsert_ValidateProperty(data, data_len, &data_idx, 0)) {
+				return false;
+			}
+		}
+
+		(*count)++;
+	}
+
+	return true;
+}
+
+// locate the stream offset of each chunk
+// returns number of entities in stream
+static uint64_t _BulkInsert_LocateChunks
+(
+	const char* data,  // binary stream
+	size_t data_idx,   // offset of first entity
+	size_t data_len,   // stream length
+	bool edges,        // stream holds edges
+	uint prop_count,   // number of properties per entity
+	size_t** offsets   // [output] chunks offsets
+) {
+	// entities without a binary representation
+	if (!edges && prop_count == 0) return 0;
 
-		// next 8 bytes are source ID
-		NodeID src = *(NodeID*)&data[data_idx];
-		data_idx += sizeof(NodeID);
-		// next 8 bytes are destination ID
-		NodeID dest = *(NodeID*)&data[data_idx];
-		data_idx += sizeof(NodeID);
+	uint64_t count = 0;
+	while (data_idx < data_len) {
+		if (count % BULK_CHUNK_SIZE == 0) array_append(*offsets, data_idx);
 
-		Graph_CreateEdge(gc->g, src, dest, type_id, &e);
-		ge = (GraphEntity*)&e;
+		// source and destination IDs
+		if (edges) data_idx += 2 * sizeof(NodeID);
 
-		// process entity attributes
 		for (uint i = 0; i < prop_count; i++) {
-			SIValue value = _BulkInsert_ReadProperty(data, &data_idx);
-			// skip invalid attribute values
-			if (!(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE)) {
-				continue;
+			_BulkInsert_SkipProperty(data, &data_idx);
+		}
+
+		count++;
+	}
+
+	return count;
+}
+
+// parse worker
+// claims chunks until all chunks are parsed
+static void _BulkInsert_ParseWorker
+(
+	void* arg
+) {
+	BulkParseCtx* ctx = (BulkParseCtx*)arg;
+
+	while (true) {
+		uint64_t chunk = atomic_fetch_add(&ctx->next_chunk, 1);
+		if (chunk >= ctx->chunk_count) break;
+
+		size_t data_idx = ctx->offsets[chunk];
+		uint64_t first  = chunk * BULK_CHUNK_SIZE;
+		uint64_t last   = MIN(first + BULK_CHUNK_SIZE, ctx->count);
+
+		for (uint64_t i = first; i < last; i++) {
+			if (ctx->edges) {
+				// next 8 bytes are source ID
+				ctx->src[i] = *(NodeID*)&ctx->data[data_idx];
+				data_idx += sizeof(NodeID);
+				// next 8 bytes are destination ID
+				ctx->dest[i] = *(NodeID*)&ctx->data[data_idx];
+				data_idx += sizeof(NodeID);
 			}
 
-			GraphEntity_AddProperty(ge, prop_indices[i], value);
+			// process entity attributes
+			for (uint j = 0; j < ctx->prop_count; j++) {
+				SIValue value = _BulkInsert_ReadProperty(ctx->data, &data_idx);
+				// skip invalid attribute values
+				if (SI_TYPE(value) & SI_VALID_PROPERTY_VALUE) {
+					AttributeSet_Add(ctx->sets + i, ctx->props[j], value);
+				}
+				// attribute set holds a clone of the value
+				SIValue_Free(value);
+			}
 		}
 	}
+}
 
-    array_free(type_ids);
-    if (prop_indices) rm_free(prop_indices);
-    Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
+// parse stream's entities using multiple workers
+static void _BulkInsert_Parse
+(
+	BulkParseCtx* ctx
+) {
+	if (ctx->chunk_count == 0) return;
 
-    return BULK_OK;
+	// chunks are claimed by the workers, no point in having more workers
+	ThreadPools_RunParallel(_BulkInsert_ParseWorker, ctx, ctx->chunk_count);
+}
+
+static int _BulkInsert_ProcessNodeFile
+(
+	GraphContext* gc,
+	const char* data,
+	size_t data_len,
+	uint64_t* created
+) {
+	uint prop_count;
+	size_t data_idx = 0;
+
+	// read the CSV file header labels and update all schemas
+	int* label_ids = _BulkInsert_ReadHeaderLabels(gc, SCHEMA_NODE, data,
+			&data_idx);
+	uint label_count = array_len(label_ids);
+	// read the CSV header properties and collect their indices
+	Attribute_ID* prop_indices = _BulkInsert_ReadHeaderProperties(gc,
+			SCHEMA_NODE, data, &data_idx, &prop_count);
+
+	//--------------------------------------------------------------------------
+	// parse nodes
+	//--------------------------------------------------------------------------
+
+	size_t* offsets = array_new(size_t, 1);
+	uint64_t count = _BulkInsert_LocateChunks(data, data_idx, data_len, false,
+			prop_count, &offsets);
+
+	BulkParseCtx ctx;
+	ctx.data        = data;
+	ctx.edges       = false;
+	ctx.count       = count;
+	ctx.props       = prop_indices;
+	ctx.offsets     = offsets;
+	ctx.prop_count  = prop_count;
+	ctx.chunk_count = array_len(offsets);
+	ctx.next_chunk  = ATOMIC_VAR_INIT(0);
+	ctx.src         = NULL;
+	ctx.dest        = NULL;
+	ctx.sets        = (prop_count > 0 && count > 0) ?
+		rm_calloc(count, sizeof(AttributeSet)) : NULL;
+
+	_BulkInsert_Parse(&ctx);
+
+	//--------------------------------------------------------------------------
+	// load nodes
+	//--------------------------------------------------------------------------
+
+	// make room for nodes before syncing matrices
+	Graph_AllocateNodes(gc->g, count);
+
+	// sync each matrix once
+	ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
+
+	for (uint i = 0; i < label_count; i++) {
+		Graph_GetLabelMatrix(gc->g, label_ids[i]);
+	}
+
+	// sync node-label matrix
+	Graph_GetNodeLabelMatrix(gc->g);
+	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+
+	// nodes take ownership over parsed attributes
+	Graph_CreateNodes(gc->g, (LabelID*)label_ids, label_count, ctx.sets, count);
+
+	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
+
+	if (ctx.sets) rm_free(ctx.sets);
+	if (prop_indices) rm_free(prop_indices);
+	array_free(offsets);
+	array_free(label_ids);
+
+	*created += count;
+	return BULK_OK;
+}
+
+static int _BulkInsert_ProcessEdgeFile
+(
+	GraphContext* gc,
+	const char* data,
+	size_t data_len,
+	uint64_t* created
+) {
+	uint prop_count;
+	size_t data_idx = 0;
+
+	// read the CSV file header
+	// and commit all labels and properties it introduces
+	int* type_ids = _BulkInsert_ReadHeaderLabels(gc, SCHEMA_EDGE, data,
+			&data_idx);
+	uint type_count = array_len(type_ids);
+
+	// edges can only have one type
+	ASSERT(type_count == 1);
+
+	int type_id = type_ids[0];
+	Attribute_ID* prop_indices = _BulkInsert_ReadHeaderProperties(gc,
+			SCHEMA_EDGE, data, &data_idx, &prop_count);
+
+	//--------------------------------------------------------------------------
+	// parse edges
+	//--------------------------------------------------------------------------
+
+	size_t* offsets = array_new(size_t, 1);
+	uint64_t count = _BulkInsert_LocateChunks(data, data_idx, data_len, true,
+			prop_count, &offsets);
+
+	BulkParseCtx ctx;
+	ctx.data        = data;
+	ctx.edges       = true;
+	ctx.count       = count;
+	ctx.props       = prop_indices;
+	ctx.offsets     = offsets;
+	ctx.prop_count  = prop_count;
+	ctx.chunk_count = array_len(offsets);
+	ctx.next_chunk  = ATOMIC_VAR_INIT(0);
+	ctx.src         = rm_malloc(sizeof(NodeID) * MAX(count, 1));
+	ctx.dest        = rm_malloc(sizeof(NodeID) * MAX(count, 1));
+	ctx.sets        = (prop_count > 0 && count > 0) ?
+		rm_calloc(count, sizeof(AttributeSet)) : NULL;
+
+	_BulkInsert_Parse(&ctx);
+
+	//--------------------------------------------------------------------------
+	// load edges
+	//--------------------------------------------------------------------------
+
+	Graph_AllocateEdges(gc->g, count);
+
+	// sync matrix once
+	ASSERT(Graph_GetMatrixPolicy(gc->g) == SYNC_POLICY_RESIZE);
+	Graph_GetRelationMatrix(gc->g, type_id, false);
+	Graph_GetAdjacencyMatrix(gc->g, false);
+	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+
+	// edges take ownership over parsed attributes
+	Graph_CreateEdges(gc->g, type_id, ctx.src, ctx.dest, ctx.sets, NULL,
+			count);
+
+	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
+
+	rm_free(ctx.src);
+	rm_free(ctx.dest);
+	if (ctx.sets) rm_free(ctx.sets);
+	if (prop_indices) rm_free(prop_indices);
+	array_free(offsets);
+	array_free(type_ids);
+
+	*created += count;
+	return BULK_OK;
 }
 
 static int _BulkInsert_ProcessTokens
@@ -319,20 +649,48 @@ static int _BulkInsert_ProcessTokens
 	RedisModuleString** argv,
 	SchemaType type
 ) {
+	uint64_t created = 0;
 	for (int i = 0; i < token_count; i++) {
 		size_t len;
 		// retrieve a pointer to the next binary stream and record its length
 		const char* data = RedisModule_StringPtrLen(argv[i], &len);
 		int rc = (type == SCHEMA_NODE)
-			? _BulkInsert_ProcessNodeFile(gc, data, len)
-			: _BulkInsert_ProcessEdgeFile(gc, data, len);
-		UNUSED(rc);
-		ASSERT(rc == BULK_OK);
+			? _BulkInsert_ProcessNodeFile(gc, data, len, &created)
+			: _BulkInsert_ProcessEdgeFile(gc, data, len, &created);
+		if (rc != BULK_OK) return rc;
 	}
 
     return BULK_OK;
 }
 
+// validate binary streams prior to loading them
+// accumulates the number of nodes created by the streams
+// and the min number of nodes required by their edges
+static bool _BulkInsert_ValidateTokens
+(
+	int token_count,           // number of streams
+	RedisModuleString** argv,  // streams
+	bool edges,                // streams hold edges
+	uint64_t* node_count,      // [input/output] #nodes created by streams
+	uint64_t* required_nodes   // [input/output] min #nodes required by edges
+) {
+	for (int i = 0; i < token_count; i++) {
+		size_t len;
+		uint64_t count;
+		uint64_t required;
+		const char* data = RedisModule_StringPtrLen(argv[i], &len);
+
+		if (!_BulkInsert_ValidateBlob(data, len, edges, &count, &required)) {
+			return false;
+		}
+
+		if (edges) *required_nodes = MAX(*required_nodes, required);
+		else       *node_count += count;
+	}
+
+	return true;
+}
+
 int BulkInsert
 (
 	RedisModuleCtx* ctx,
@@ -369,6 +727,28 @@ int BulkInsert
 		return BULK_FAIL;
 	}
 
+	argc -= 2;
+
+	if (node_token_count < 0 || relation_token_count < 0 ||
+		node_token_count + relation_token_count != argc) {
+		RedisModule_ReplyWithError(ctx, "Bulk insert format error, \
+				token count mismatch.");
+		return BULK_FAIL;
+	}
+
+	// validate all streams prior to loading
+	// a malformed stream leaves the graph untouched
+	uint64_t created_nodes  = 0;
+	uint64_t required_nodes = 0;
+	if (!_BulkInsert_ValidateTokens(node_token_count, argv, false,
+				&created_nodes, &required_nodes) ||
+		!_BulkInsert_ValidateTokens(relation_token_count,
+			argv + node_token_count, true, &created_nodes, &required_nodes)) {
+		RedisModule_ReplyWithError(ctx, "Bulk insert format error, \
+				malformed bulk insert section.");
+		return BULK_FAIL;
+	}
+
 	Graph* g = gc->g;
 	int res = BULK_OK;
 
@@ -376,14 +756,20 @@ int BulkInsert
 	// allocate space for new nodes and edges
 	// set graph sync policy to resize only
 	Graph_AcquireWriteLock(g);
+
+	// edges must connect existing nodes
+	if (Graph_UncompactedNodeCount(g) + created_nodes < required_nodes) {
+		Graph_ReleaseLock(g);
+		RedisModule_ReplyWithError(ctx, "Bulk insert format error, \
+				edge references a missing node.");
+		return BULK_FAIL;
+	}
+
 	Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
 	Graph_AllocateNodes(g, node_count);
 	Graph_AllocateEdges(g, edge_count);
 
-	argc -= 2;
-
 	if (node_token_count > 0) {
-		ASSERT(argc >= node_token_count);
 		// process all node files
 		if (_BulkInsert_ProcessTokens(gc, node_token_count, argv,
 					SCHEMA_NODE)
@@ -396,7 +782,6 @@ int BulkInsert
 	}
 
 	if (relation_token_count > 0) {
-		ASSERT(argc >= relation_token_count);
 		// Process all relationship files
 		if (_BulkInsert_ProcessTokens(gc, relation_token_count, argv,
 					SCHEMA_EDGE)
@@ -417,3 +802,216 @@ cleanup:
 	return res;
 }
 
+// validate the sections to load from a bulk file
+// loading must start at a section boundary, every loaded section is
+// validated in full such that loading can't fail once the graph is modified
+// returns NULL on success, otherwise an error message
+static const char* _BulkInsert_ValidateSections
+(
+	const char* data,          // mapped file
+	uint64_t size,             // file size
+	uint64_t offset,           // offset of first section
+	uint64_t limit,            // max #bytes to load
+	uint64_t* end,             // [output] offset following last loaded section
+	uint64_t* required_nodes   // [output] min #nodes existing prior to loading
+) {
+	uint64_t pos = 0;
+	uint64_t nodes_loaded = 0;
+	*required_nodes = 0;
+
+	while (pos < size) {
+		// stop once limit is reached, at least one section is loaded
+		if (pos > offset && pos - offset >= limit) break;
+
+		if (size - pos < BULK_SECTION_HEADER_SIZE) {
+			return "Bulk file format error, malformed section.";
+		}
+
+		BulkSectionType t = data[pos];
+		uint64_t len = *(uint64_t*)&data[pos + 1];
+
+		if (t != BULK_SECTION_NODES && t != BULK_SECTION_EDGES) {
+			return "Bulk file format error, malformed section.";
+		}
+		if (len == 0 || len > size - pos - BULK_SECTION_HEADER_SIZE) {
+			return "Bulk file format error, malformed section.";
+		}
+
+		if (pos >= offset) {
+			uint64_t count;
+			uint64_t required;
+			const char* blob = data + pos + BULK_SECTION_HEADER_SIZE;
+			bool edges = (t == BULK_SECTION_EDGES);
+
+			if (!_BulkInsert_ValidateBlob(blob, len, edges, &count, &required)) {
+				return "Bulk file format error, malformed section.";
+			}
+
+			// edges may reference nodes created by earlier sections
+			if (!edges) {
+				nodes_loaded += count;
+			} else if (required > nodes_loaded) {
+				*required_nodes = MAX(*required_nodes, required - nodes_loaded);
+			}
+		}
+
+		pos += BULK_SECTION_HEADER_SIZE + len;
+
+		if (pos > offset && pos - BULK_SECTION_HEADER_SIZE - len < offset) {
+			return "Bulk file offset is not a section boundary.";
+		}
+	}
+
+	*end = pos;
+	return NULL;
+}
+
+int BulkInsert_FromFile
+(
+	RedisModuleCtx* ctx,
+	GraphContext* gc,
+	const char* path,
+	uint64_t offset,
+	uint64_t limit,
+	uint64_t* node_count,
+	uint64_t* edge_count,
+	uint64_t* checkpoint,
+	uint64_t* file_size
+) {
+	ASSERT(gc          !=  NULL);
+	ASSERT(ctx         !=  NULL);
+	ASSERT(path        !=  NULL);
+	ASSERT(node_count  !=  NULL);
+	ASSERT(edge_count  !=  NULL);
+	ASSERT(checkpoint  !=  NULL);
+	ASSERT(file_size   !=  NULL);
+
+	*node_count = 0;
+	*edge_count = 0;
+	*checkpoint = offset;
+	*file_size  = 0;
+
+	// bulk files are confined to the import folder
+	char* resolved = ImportFolder_ResolvePath(path);
+	if (resolved == NULL) {
+		RedisModule_ReplyWithErrorFormat(ctx,
+				"Bulk file '%s' is outside of the import folder", path);
+		return BULK_FAIL;
+	}
+
+	int fd = open(resolved, O_RDONLY);
+	rm_free(resolved);
+
+	// avoid disclosing why the file couldn't be accessed
+	struct stat st;
+	if (fd == -1 || fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)) {
+		RedisModule_ReplyWithErrorFormat(ctx,
+				"Failed to open bulk file '%s'", path);
+		if (fd != -1) close(fd);
+		return BULK_FAIL;
+	}
+
+	uint64_t size = st.st_size;
+	*file_size = size;
+
+	if (offset > size) {
+		RedisModule_ReplyWithError(ctx,
+				"Bulk file offset exceeds file size.");
+		close(fd);
+		return BULK_FAIL;
+	}
+
+	// nothing to load
+	if (offset == size) {
+		close(fd);
+		return BULK_OK;
+	}
+
+	// map file, pages are read on demand and dropped once loaded
+	// keeping memory consumption bounded regardless of file size
+	char* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		RedisModule_ReplyWithErrorFormat(ctx,
+				"Failed to map bulk file '%s'", path);
+		return BULK_FAIL;
+	}
+
+	madvise(data, size, MADV_SEQUENTIAL);
+
+	// loading runs on the main thread, cap the amount of work per call
+	// clients resume from the returned checkpoint
+	if (limit == 0 || limit > BULK_MAX_LOAD_SIZE) limit = BULK_MAX_LOAD_SIZE;
+
+	// validate sections prior to loading
+	// a malformed file leaves the graph untouched
+	uint64_t end;
+	uint64_t required_nodes;
+	const char* err = _BulkInsert_ValidateSections(data, size, offset, limit,
+			&end, &required_nodes);
+	if (err != NULL) {
+		RedisModule_ReplyWithError(ctx, err);
+		munmap(data, size);
+		return BULK_FAIL;
+	}
+
+	Graph* g = gc->g;
+	size_t page_size = sysconf(_SC_PAGESIZE);
+
+	// lock graph under write lock
+	// set graph sync policy to resize only
+	Graph_AcquireWriteLock(g);
+
+	// edges must connect existing nodes
+	if (Graph_UncompactedNodeCount(g) < required_nodes) {
+		Graph_ReleaseLock(g);
+		RedisModule_ReplyWithError(ctx,
+				"Bulk file format error, edge references a missing node.");
+		munmap(data, size);
+		return BULK_FAIL;
+	}
+
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
+
+	uint64_t pos = offset;
+	int res = BULK_OK;
+	while (pos < end) {
+		BulkSectionType t = data[pos];
+		uint64_t len = *(uint64_t*)&data[pos + 1];
+		const char* blob = data + pos + BULK_SECTION_HEADER_SIZE;
+
+		int rc = (t == BULK_SECTION_NODES)
+			? _BulkInsert_ProcessNodeFile(gc, blob, len, node_count)
+			: _BulkInsert_ProcessEdgeFile(gc, blob, len, edge_count);
+		if (rc != BULK_OK) {
+			res = rc;
+			break;
+		}
+
+		// release loaded pages
+		uintptr_t from = (uintptr_t)(data + pos) & ~(page_size - 1);
+		uintptr_t to   = (uintptr_t)(blob + len) & ~(page_size - 1);
+		if (to > from) madvise((void*)from, to - from, MADV_DONTNEED);
+
+		pos += BULK_SECTION_HEADER_SIZE + len;
+
+		RedisModule_Log(ctx, "notice", "Bulk loading graph %s: %" PRIu64
+				" of %" PRIu64 " bytes loaded", GraphContext_GetName(gc), pos,
+				size);
+	}
+
+	// reset graph sync policy
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
+	Graph_ReleaseLock(g);
+
+	munmap(data, size);
+
+	if (res != BULK_OK) {
+		RedisModule_ReplyWithError(ctx,
+				"Bulk file format error, failed to load section.");
+	}
+
+	*checkpoint = pos;
+	return res;
+}
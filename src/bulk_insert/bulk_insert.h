@@ -30,5 +30,22 @@ int BulkInsert(
 	uint edge_count             // Number of edges to be created.
 );
 
+/* Load entities from a local file holding a sequence of sections
+ * each section is a 1-byte type (0 nodes, 1 edges), an 8-byte blob length
+ * and a binary blob in the bulk insert format
+ * the path is resolved relative to the import folder
+ * loading starts at 'offset' and stops once 'limit' bytes were loaded */
+int BulkInsert_FromFile(
+	RedisModuleCtx *ctx,        // Redis thread-safe context.
+	GraphContext *gc,           // GraphContext hosting schemas and Graph.
+	const char *path,           // Path of file to load, relative to import folder.
+	uint64_t offset,            // File offset to resume loading from.
+	uint64_t limit,             // Max number of bytes to load, 0 for default cap.
+	uint64_t *node_count,       // [output] Number of created nodes.
+	uint64_t *edge_count,       // [output] Number of created edges.
+	uint64_t *checkpoint,       // [output] File offset to resume loading from.
+	uint64_t *file_size         // [output] File size.
+);
+
 #endif
 
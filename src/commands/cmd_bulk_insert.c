@@ -8,6 +8,8 @@
 #include "query_ctx.h"
 #include "bulk_insert/bulk_insert.h"
 
+#include <inttypes.h>
+
 // process "BEGIN" token, expected to be present only on first bulk-insert
 // batch, make sure graph key doesn't exists, fails if "BEGIN" token is present
 // and graph key 'graphname' already exists
@@ -48,6 +50,111 @@ static int _Graph_Bulk_Begin(RedisModuleCtx *ctx, RedisModuleString ***argv,
 	return BULK_OK;
 }
 
+// parse "FROM <path> [OFFSET <offset>] [LIMIT <bytes>]" arguments
+static int _Graph_Bulk_ParseFrom
+(
+	RedisModuleCtx *ctx,         // redis context
+	RedisModuleString **argv,    // arguments following "FROM"
+	int argc,                    // number of arguments
+	const char **path,           // [output] file path
+	long long *offset,           // [output] file offset to resume from
+	long long *limit             // [output] max number of bytes to load
+) {
+	*offset = 0;
+	*limit  = 0;
+
+	if(argc < 1 || argc % 2 != 1) {
+		RedisModule_WrongArity(ctx);
+		return BULK_FAIL;
+	}
+
+	*path = RedisModule_StringPtrLen(*argv++, NULL);
+	argc--;
+
+	for(; argc > 0; argc -= 2, argv += 2) {
+		const char *opt = RedisModule_StringPtrLen(argv[0], NULL);
+		long long *v = NULL;
+
+		if(strcasecmp(opt, "OFFSET") == 0) {
+			v = offset;
+		} else if(strcasecmp(opt, "LIMIT") == 0) {
+			v = limit;
+		} else {
+			RedisModule_ReplyWithErrorFormat(ctx,
+					"Unknown GRAPH.BULK argument '%s'", opt);
+			return BULK_FAIL;
+		}
+
+		if(RedisModule_StringToLongLong(argv[1], v) != REDISMODULE_OK ||
+				*v < 0) {
+			RedisModule_ReplyWithErrorFormat(ctx,
+					"Error parsing GRAPH.BULK %s value.", opt);
+			return BULK_FAIL;
+		}
+	}
+
+	return BULK_OK;
+}
+
+// load graph from a local file, loading can be split across multiple calls
+// each call reports the file offset to resume from
+static int _Graph_Bulk_From
+(
+	RedisModuleCtx *ctx,                // redis context
+	RedisModuleString **argv,           // arguments following "FROM"
+	int argc,                           // number of arguments
+	RedisModuleString *rs_graph_name,   // graph key name
+	bool begin                          // first bulk call
+) {
+	const char *path;
+	long long offset;
+	long long limit;
+
+	if(_Graph_Bulk_ParseFrom(ctx, argv, argc, &path, &offset, &limit)
+			!= BULK_OK) {
+		return REDISMODULE_OK;
+	}
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, rs_graph_name, false, begin);
+
+	// failed to retrieve GraphContext; an error has been emitted
+	if(gc == NULL) return REDISMODULE_OK;
+
+	uint64_t node_count;
+	uint64_t edge_count;
+	uint64_t checkpoint;
+	uint64_t file_size;
+
+	int rc = BulkInsert_FromFile(ctx, gc, path, offset, limit, &node_count,
+			&edge_count, &checkpoint, &file_size);
+
+	GraphContext_DecreaseRefCount(gc);
+
+	if(rc == BULK_FAIL) {
+		// the graph is left untouched on failure
+		// remove graph key if it was introduced by this call
+		if(begin) {
+			RedisModuleKey *key = NULL;
+			key = RedisModule_OpenKey(ctx, rs_graph_name, REDISMODULE_WRITE);
+			RedisModule_DeleteKey(key);
+			RedisModule_CloseKey(key);
+		}
+		return REDISMODULE_OK;
+	}
+
+	// replicas and AOF replay load the same file section
+	RedisModule_ReplicateVerbatim(ctx);
+
+	// replay to caller
+	char reply[1024];
+	int len = snprintf(reply, 1024, "%" PRIu64 " nodes created, %" PRIu64
+			" edges created, %" PRIu64 " of %" PRIu64 " bytes loaded",
+			node_count, edge_count, checkpoint, file_size);
+	RedisModule_ReplyWithStringBuffer(ctx, reply, len);
+
+	return REDISMODULE_OK;
+}
+
 int Graph_BulkInsert(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	if(argc < 3) return RedisModule_WrongArity(ctx);
 
@@ -68,6 +175,12 @@ int Graph_BulkInsert(RedisModuleCtx *ctx, RedisModuleString **argv, int argc) {
 	if(_Graph_Bulk_Begin(ctx, &argv, &argc, rs_graph_name, graphname, &begin)
 			!= BULK_OK) goto cleanup;
 
+	// load from a local file
+	if(argc > 0 &&
+	   strcasecmp(RedisModule_StringPtrLen(*argv, NULL), "FROM") == 0) {
+		return _Graph_Bulk_From(ctx, argv + 1, argc - 1, rs_graph_name, begin);
+	}
+
 	gc = GraphContext_Retrieve(ctx, rs_graph_name, false, begin);
 
 	// failed to retrieve GraphContext; an error has been emitted
@@ -39,6 +39,7 @@ CommandCtx *CommandCtx_New
 	context->compact            = compact;
 	context->timeout            = timeout;
 	context->ref_count          = ATOMIC_VAR_INIT(1);
+	context->disconnected       = ATOMIC_VAR_INIT(false);
 	context->graph_ctx          = graph_ctx;
 	context->timeout_rw         = timeout_rw;
 	context->received_ts        = received_ts;
@@ -46,6 +47,7 @@ CommandCtx *CommandCtx_New
 	context->replicated_command = replicated_command;
 
 	simple_timer_copy(timer, context->timer);
+	QueryTrace_Init(&context->trace, timer);
 
 	if(cmd_name) {
 		// make a copy of command name
@@ -147,6 +149,29 @@ void CommandCtx_ThreadSafeContextUnlock
 	}
 }
 
+void CommandCtx_ClientDisconnected
+(
+	RedisModuleCtx *ctx,          // redis module context
+	RedisModuleBlockedClient *bc  // disconnected blocked client
+) {
+	ASSERT(bc != NULL);
+
+	// locate the command context serving the blocked client
+	// a command waiting in a thread pool queue isn't tracked
+	// and will run to completion
+	uint32_t n = ThreadPools_ThreadCount() + 1;
+	CommandCtx *commands[n];
+	Globals_GetCommandCtxs(commands, &n);
+
+	for(uint32_t i = 0; i < n; i++) {
+		CommandCtx *cmd = commands[i];
+		if(cmd->bc == bc) {
+			atomic_store(&cmd->disconnected, true);
+		}
+		CommandCtx_Free(cmd);
+	}
+}
+
 void CommandCtx_UnblockClient
 (
 	CommandCtx *command_ctx
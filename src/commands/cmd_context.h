@@ -10,6 +10,7 @@
 #include "../redismodule.h"
 #include "../util/simple_timer.h"
 #include "../graph/graphcontext.h"
+#include "../queries_log/query_trace.h"
 
 #include <stdatomic.h>
 
@@ -35,6 +36,8 @@ typedef struct {
 	bool timeout_rw;               // apply timeout on both read and write queries
 	uint64_t received_ts;          // command received at this UNIX timestamp
 	simple_timer_t timer;          // stopwatch started upon command received
+	QueryTrace trace;              // query lifecycle trace
+	atomic_bool disconnected;      // client disconnected before being replied
 } CommandCtx;
 
 // create a new command context
@@ -102,6 +105,14 @@ void CommandCtx_ThreadSafeContextUnlock
 	const CommandCtx *command_ctx
 );
 
+// blocked client disconnect callback
+// marks the command context serving the disconnected client
+void CommandCtx_ClientDisconnected
+(
+	RedisModuleCtx *ctx,          // redis module context
+	RedisModuleBlockedClient *bc  // disconnected blocked client
+);
+
 // unblock the client
 void CommandCtx_UnblockClient
 (
@@ -252,6 +252,9 @@ int CommandDispatch
 								 is_replicated, compact, timeout, timeout_rw,
 								 received_ts, timer);
 
+		// get notified if the client disconnects mid execution
+		RedisModule_SetDisconnectCallback(bc, CommandCtx_ClientDisconnected);
+
 		if(ThreadPools_AddWorkReader(handler, context, false) ==
 				THPOOL_QUEUE_FULL) {
 			// report an error once our workers thread pool internal queue
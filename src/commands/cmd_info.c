@@ -10,6 +10,7 @@
 #include "redismodule.h"
 #include "cmd_context.h"
 #include "../util/thpool/pools.h"
+#include "../arithmetic/string_funcs/regex_cache.h"
 
 #include <ctype.h>
 #include <string.h>
@@ -20,9 +21,15 @@
 #define WAIT_DURATION_KEY_NAME      "Wait duration"
 #define RECEIVED_TIMESTAMP_KEY_NAME "Received at"
 #define EXECUTION_DURATION_KEY_NAME "Execution duration"
+#define STAGE_KEY_NAME              "Stage"
+#define STAGE_DURATIONS_KEY_NAME    "Stage durations"
 
 #define SUBCOMMAND_NAME_RUNNING_QUERIES "RunningQueries"
 #define SUBCOMMAND_NAME_WAITING_QUERIES "WaitingQueries"
+#define SUBCOMMAND_NAME_REGEX_CACHE     "RegexCache"
+#define SUBCOMMAND_NAME_QUERY_STAGES    "QueryStages"
+#define SUBCOMMAND_NAME_LATENCY         "Latency"
+#define SUBCOMMAND_NAME_RESETSTAT       "RESETSTAT"
 
 //------------------------------------------------------------------------------
 // Info section API
@@ -101,7 +108,7 @@ static void _emit_running_query
 	// compute query execution time
 	const double total_time = TIMER_GET_ELAPSED_MILLISECONDS(cmd->timer);
 
-	RedisModule_ReplyWithArray(ctx, 5 * 2);
+	RedisModule_ReplyWithArray(ctx, 7 * 2);
 
 	// emit query received timestamp
 	Info_SectionAddEntryLongLong(ctx, RECEIVED_TIMESTAMP_KEY_NAME,
@@ -120,6 +127,20 @@ static void _emit_running_query
 	// emit rather or not query was replicated
 	Info_SectionAddEntryLongLong(ctx, REPLICATION_KEY_NAME,
 			cmd->replicated_command);
+
+	// emit query's current stage
+	// the trace is updated by the executing thread, values might be stale
+	const QueryTrace *trace = &cmd->trace;
+	Info_SectionAddEntryString(ctx, STAGE_KEY_NAME,
+			QueryTrace_StageName(trace->stage));
+
+	// emit time spent in each completed stage
+	RedisModule_ReplyWithCString(ctx, STAGE_DURATIONS_KEY_NAME);
+	RedisModule_ReplyWithArray(ctx, QueryTrace_COUNT * 2);
+	for(int i = 0; i < QueryTrace_COUNT; i++) {
+		Info_SectionAddEntryDouble(ctx, QueryTrace_StageName(i),
+				trace->durations[i]);
+	}
 }
 
 // replies with query information
@@ -167,6 +188,8 @@ static void _info_running_queries
 	//     "Query"
 	//     "Execution duration"
 	//     "Replicated command"
+	//     "Stage"
+	//     "Stage durations"
 
 	ASSERT(ctx != NULL);
 
@@ -240,6 +263,222 @@ static void _info_waiting_queries
 	free(cmds);
 }
 
+// handles the "GRAPH.INFO RegexCache" section
+// "GRAPH.INFO RegexCache"
+static void _info_regex_cache
+(
+	RedisModuleCtx *ctx  // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO RegexCache
+	// reply:
+	// "# Regex cache"
+	//     "Call-site hits"
+	//     "Thread cache hits"
+	//     "Misses"
+	//     "Evictions"
+
+	ASSERT(ctx != NULL);
+
+	RegexCacheStats stats;
+	RegexCache_GetStats(&stats);
+
+	Info_AddSection(ctx, "# Regex cache", 4 * 2);
+	Info_SectionAddEntryLongLong(ctx, "Call-site hits", stats.hits);
+	Info_SectionAddEntryLongLong(ctx, "Thread cache hits", stats.thread_hits);
+	Info_SectionAddEntryLongLong(ctx, "Misses", stats.misses);
+	Info_SectionAddEntryLongLong(ctx, "Evictions", stats.evictions);
+}
+
+// handles the "GRAPH.INFO QueryStages" section
+// "GRAPH.INFO QueryStages"
+static void _info_query_stages
+(
+	RedisModuleCtx *ctx  // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO QueryStages
+	// reply:
+	// "# Query stages"
+	//     "Queue"
+	//         "Count"
+	//         "Total duration"
+	//         "p50"
+	//         "p99"
+	//         "p999"
+	//     "Parse"
+	//     ...
+
+	ASSERT(ctx != NULL);
+
+	Info_AddSection(ctx, "# Query stages", QueryTrace_COUNT * 2);
+
+	HdrHistogram *h = rm_malloc(sizeof(HdrHistogram));
+
+	for(int i = 0; i < QueryTrace_COUNT; i++) {
+		QueryTrace_GetHistogram(i, h);
+
+		// durations are reported in milliseconds
+		RedisModule_ReplyWithCString(ctx, QueryTrace_StageName(i));
+		RedisModule_ReplyWithArray(ctx, 5 * 2);
+		Info_SectionAddEntryLongLong(ctx, "Count", h->count);
+		Info_SectionAddEntryDouble(ctx, "Total duration", h->sum / 1000.0);
+		Info_SectionAddEntryDouble(ctx, "p50",
+				HdrHistogram_Percentile(h, 0.5) / 1000.0);
+		Info_SectionAddEntryDouble(ctx, "p99",
+				HdrHistogram_Percentile(h, 0.99) / 1000.0);
+		Info_SectionAddEntryDouble(ctx, "p999",
+				HdrHistogram_Percentile(h, 0.999) / 1000.0);
+	}
+
+	rm_free(h);
+}
+
+// replies with a latency histogram summary
+// durations are reported in milliseconds
+static void _emit_latency_histogram
+(
+	RedisModuleCtx *ctx,    // redis module context
+	const HdrHistogram *h   // histogram
+) {
+	ASSERT(h   != NULL);
+	ASSERT(ctx != NULL);
+
+	double mean = (h->count > 0) ? (double)h->sum / h->count : 0;
+
+	RedisModule_ReplyWithArray(ctx, 6 * 2);
+	Info_SectionAddEntryLongLong(ctx, "Count", h->count);
+	Info_SectionAddEntryDouble(ctx, "Mean", mean / 1000);
+	Info_SectionAddEntryDouble(ctx, "p50",
+			HdrHistogram_Percentile(h, 0.5) / 1000.0);
+	Info_SectionAddEntryDouble(ctx, "p99",
+			HdrHistogram_Percentile(h, 0.99) / 1000.0);
+	Info_SectionAddEntryDouble(ctx, "p999",
+			HdrHistogram_Percentile(h, 0.999) / 1000.0);
+	Info_SectionAddEntryDouble(ctx, "Max", h->max / 1000.0);
+}
+
+// replies with the merged histograms of each latency metric
+static void _emit_latency_stats
+(
+	RedisModuleCtx *ctx,  // redis module context
+	LatencyStats stats    // latency stats
+) {
+	ASSERT(ctx   != NULL);
+	ASSERT(stats != NULL);
+
+	HdrHistogram *h = rm_malloc(sizeof(HdrHistogram));
+
+	RedisModule_ReplyWithArray(ctx, LatencyMetric_COUNT * 2);
+	for(int i = 0; i < LatencyMetric_COUNT; i++) {
+		LatencyStats_Get(stats, i, h);
+		RedisModule_ReplyWithCString(ctx, LatencyStats_MetricName(i));
+		_emit_latency_histogram(ctx, h);
+	}
+
+	rm_free(h);
+}
+
+// handles the "GRAPH.INFO Latency" section
+// "GRAPH.INFO Latency"
+static void _info_latency
+(
+	RedisModuleCtx *ctx  // redis module context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO Latency
+	// reply:
+	// "# Latency"
+	//     "Commands"
+	//         "GRAPH.QUERY"
+	//             "Query latency"
+	//                 "Count"
+	//                 "Mean"
+	//                 "p50"
+	//                 "p99"
+	//                 "p999"
+	//                 "Max"
+	//             "Queue wait"
+	//             "Lock wait"
+	//             "Reply time"
+	//         "GRAPH.RO_QUERY"
+	//         ...
+	//     "Graphs"
+	//         "g"
+	//             "Query latency"
+	//             ...
+
+	ASSERT(ctx != NULL);
+
+	Info_AddSection(ctx, "# Latency", 2 * 2);
+
+	//--------------------------------------------------------------------------
+	// per command histograms
+	//--------------------------------------------------------------------------
+
+	uint n = 0;
+	for(int i = 0; i < CMD_COUNT; i++) {
+		if(Commands_GetLatencyStats(i) != NULL) n++;
+	}
+
+	RedisModule_ReplyWithCString(ctx, "Commands");
+	RedisModule_ReplyWithArray(ctx, n * 2);
+	for(int i = 0; i < CMD_COUNT; i++) {
+		LatencyStats stats = Commands_GetLatencyStats(i);
+		if(stats == NULL) continue;
+
+		RedisModule_ReplyWithCString(ctx, CommandToString(i));
+		_emit_latency_stats(ctx, stats);
+	}
+
+	//--------------------------------------------------------------------------
+	// per graph histograms
+	//--------------------------------------------------------------------------
+
+	// graphs are added and removed by the main thread, which we're on
+	RedisModule_ReplyWithCString(ctx, "Graphs");
+	RedisModule_ReplyWithArray(ctx, Globals_GetGraphCount() * 2);
+
+	GraphContext *gc = NULL;
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		RedisModule_ReplyWithCString(ctx, GraphContext_GetName(gc));
+		_emit_latency_stats(ctx, gc->latency_stats);
+		GraphContext_DecreaseRefCount(gc);
+	}
+}
+
+// handles "GRAPH.INFO RESETSTAT"
+// clears latency and query stage histograms and query fingerprint statistics
+static void _info_resetstat
+(
+	RedisModuleCtx *ctx  // redis module context
+) {
+	ASSERT(ctx != NULL);
+
+	QueryTrace_ResetHistograms();
+
+	for(int i = 0; i < CMD_COUNT; i++) {
+		LatencyStats stats = Commands_GetLatencyStats(i);
+		if(stats != NULL) LatencyStats_Reset(stats);
+	}
+
+	GraphContext *gc = NULL;
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		LatencyStats_Reset(gc->latency_stats);
+		FingerprintStats_Reset(gc->fingerprint_stats);
+		GraphContext_DecreaseRefCount(gc);
+	}
+
+	RedisModule_ReplyWithSimpleString(ctx, "OK");
+}
+
 // attempts to find the specified sections of "GRAPH.INFO" and dispatch it
 static void _handle_sections
 (
@@ -253,6 +492,9 @@ static void _handle_sections
 	int section_count = 0;
 	bool running_queries = false;
 	bool waiting_queries = false;
+	bool regex_cache     = false;
+	bool query_stages    = false;
+	bool latency         = false;
 
 	if(argc == 0) {
 		running_queries = true;
@@ -269,6 +511,18 @@ static void _handle_sections
 					  !strcasecmp(subcmd, SUBCOMMAND_NAME_WAITING_QUERIES)) {
 				waiting_queries = true;
 				section_count++;
+			} else if(!regex_cache &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_REGEX_CACHE)) {
+				regex_cache = true;
+				section_count++;
+			} else if(!query_stages &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_QUERY_STAGES)) {
+				query_stages = true;
+				section_count++;
+			} else if(!latency &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_LATENCY)) {
+				latency = true;
+				section_count++;
 			}
 		}
 	}
@@ -285,11 +539,21 @@ static void _handle_sections
 	if(waiting_queries) {
 		_info_waiting_queries(ctx);
 	}
+	if(regex_cache) {
+		_info_regex_cache(ctx);
+	}
+	if(query_stages) {
+		_info_query_stages(ctx);
+	}
+	if(latency) {
+		_info_latency(ctx);
+	}
 }
 
 // graph.info command handler
 // GRAPH.INFO [Section [Section ...]]
-// GRAPH.INFO RunningQueries WaitingQueries
+// GRAPH.INFO RunningQueries WaitingQueries RegexCache QueryStages Latency
+// GRAPH.INFO RESETSTAT
 int Graph_Info
 (
 	RedisModuleCtx *ctx,       // redis module context
@@ -303,6 +567,12 @@ int Graph_Info
 		return RedisModule_WrongArity(ctx);
 	}
 
+	if(argc == 2 && !strcasecmp(RedisModule_StringPtrLen(argv[1], NULL),
+				SUBCOMMAND_NAME_RESETSTAT)) {
+		_info_resetstat(ctx);
+		return REDISMODULE_OK;
+	}
+
 	_handle_sections(ctx, argv + 1, argc - 1);
 
 	return REDISMODULE_OK;
@@ -0,0 +1,509 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "commands.h"
+#include "../util/arr.h"
+#include "../index/index.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+#include "../graph/rg_matrix/rg_matrix_iter.h"
+
+#include <string.h>
+
+// default number of entities sampled per structure
+#define MEMORY_DEFAULT_SAMPLES 100
+
+// memory used by a label or a relationship-type
+typedef struct {
+	uint64_t count;     // number of entities
+	size_t matrix;      // main matrix bytes
+	size_t transpose;   // transposed matrix bytes
+	size_t delta;       // delta matrices bytes
+	size_t multi_edge;  // multi-edge arrays bytes (estimated)
+	size_t attributes;  // attribute-sets bytes (estimated)
+} SchemaMemory;
+
+// scales sampled bytes to the entire population
+static inline size_t _Scale
+(
+	size_t bytes,        // sampled bytes
+	uint64_t sampled,    // number of sampled items
+	uint64_t population  // total number of items
+) {
+	if(sampled == 0) return 0;
+	return (size_t)((double)bytes * population / sampled);
+}
+
+// accumulates the number of bytes used by a matrix and its transpose
+static void _MatrixMemory
+(
+	const RG_Matrix A,  // matrix to inspect
+	size_t *m,          // [output] main matrix bytes
+	size_t *transpose,  // [output] transposed matrix bytes
+	size_t *delta       // [output] delta matrices bytes
+) {
+	size_t size;
+	size_t delta_size;
+
+	RG_Matrix_memoryUsage(&size, &delta_size, A);
+	*m     += size;
+	*delta += delta_size;
+
+	RG_Matrix T = RG_Matrix_getTranspose(A);
+	if(T != NULL) {
+		RG_Matrix_memoryUsage(&size, &delta_size, T);
+		*transpose += size;
+		*delta     += delta_size;
+	}
+}
+
+// estimates the number of bytes used by the attribute-sets of all entities
+// stored in a datablock, sampling entities evenly spread across the block
+// per attribute estimates are added to 'attr_bytes'
+static size_t _EstimateEntityAttributes
+(
+	const Graph *g,      // graph
+	GraphEntityType t,   // entity type
+	uint64_t samples,    // max number of entities to sample, 0 for all
+	size_t *attr_bytes,  // [output] per attribute bytes
+	uint attr_count      // number of attributes
+) {
+	DataBlock *block = (t == GETYPE_NODE) ? g->nodes : g->edges;
+
+	uint64_t live  = DataBlock_ItemCount(block);
+	uint64_t total = live + DataBlock_DeletedItemsCount(block);
+	if(live == 0) return 0;
+
+	uint64_t step = 1;
+	if(samples > 0 && total > samples) step = total / samples;
+
+	size_t   n       = 0;
+	uint64_t sampled = 0;
+	size_t  *sample  = rm_calloc(attr_count + 1, sizeof(size_t));
+
+	for(uint64_t id = 0; id < total; id += step) {
+		if(samples > 0 && sampled == samples) break;
+
+		Node node;
+		Edge edge;
+		AttributeSet *set = NULL;
+		if(t == GETYPE_NODE) {
+			if(Graph_GetNode(g, id, &node)) set = node.attributes;
+		} else {
+			if(Graph_GetEdge(g, id, &edge)) set = edge.attributes;
+		}
+
+		// skip deleted entities
+		if(set == NULL) continue;
+
+		n += AttributeSet_MemoryUsage(*set, sample);
+		sampled++;
+	}
+
+	for(uint i = 0; i < attr_count; i++) {
+		attr_bytes[i] += _Scale(sample[i], sampled, live);
+	}
+
+	rm_free(sample);
+
+	return _Scale(n, sampled, live);
+}
+
+// collects memory used by label
+static void _LabelMemory
+(
+	const Graph *g,     // graph
+	LabelID l,          // label to inspect
+	uint64_t samples,   // max number of nodes to sample, 0 for all
+	SchemaMemory *mem   // [output] label memory
+) {
+	RG_Matrix L = g->labels[l];
+
+	mem->count = Graph_LabeledNodeCount(g, l);
+	_MatrixMemory(L, &mem->matrix, &mem->transpose, &mem->delta);
+
+	if(mem->count == 0) return;
+
+	// sample the first nodes carrying the label
+	size_t   n       = 0;
+	uint64_t sampled = 0;
+	GrB_Index id;
+	RG_MatrixTupleIter it = {0};
+
+	RG_MatrixTupleIter_attach(&it, L);
+	while((samples == 0 || sampled < samples) &&
+		  RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS) {
+		Node node;
+		if(!Graph_GetNode(g, id, &node)) continue;
+
+		n += AttributeSet_MemoryUsage(*node.attributes, NULL);
+		sampled++;
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	mem->attributes = _Scale(n, sampled, mem->count);
+}
+
+// returns number of bytes used by edge's attribute-set
+static size_t _EdgeAttributes
+(
+	const Graph *g,  // graph
+	EdgeID id        // edge to inspect
+) {
+	Edge e;
+	if(!Graph_GetEdge(g, id, &e)) return 0;
+	return AttributeSet_MemoryUsage(*e.attributes, NULL);
+}
+
+// collects memory used by relationship-type
+static void _RelationMemory
+(
+	const Graph *g,     // graph
+	RelationID r,       // relationship-type to inspect
+	uint64_t samples,   // max number of matrix entries to sample, 0 for all
+	SchemaMemory *mem   // [output] relationship-type memory
+) {
+	RG_Matrix R = g->relations[r];
+
+	mem->count = Graph_RelationEdgeCount(g, r);
+	_MatrixMemory(R, &mem->matrix, &mem->transpose, &mem->delta);
+
+	if(mem->count == 0) return;
+
+	// sample the first matrix entries
+	// an entry either holds a single edge id or points to an array of ids
+	size_t    multi   = 0;
+	size_t    attrs   = 0;
+	uint64_t  edges   = 0;
+	uint64_t  entries = 0;
+	uint64_t  v;
+	GrB_Index nvals;
+	RG_MatrixTupleIter it = {0};
+
+	RG_MatrixTupleIter_attach(&it, R);
+	while((samples == 0 || entries < samples) &&
+		  RG_MatrixTupleIter_next_UINT64(&it, NULL, NULL, &v) == GrB_SUCCESS) {
+		entries++;
+
+		if(SINGLE_EDGE(v)) {
+			attrs += _EdgeAttributes(g, v);
+			edges++;
+			continue;
+		}
+
+		EdgeID *ids = (EdgeID *)(CLEAR_MSB(v));
+		uint count = array_len(ids);
+		multi += array_sizeof(array_hdr(ids));
+		for(uint i = 0; i < count; i++) {
+			attrs += _EdgeAttributes(g, ids[i]);
+		}
+		edges += count;
+	}
+	RG_MatrixTupleIter_detach(&it);
+
+	RG_Matrix_nvals(&nvals, R);
+	mem->multi_edge = _Scale(multi, entries, nvals);
+	mem->attributes = _Scale(attrs, edges, mem->count);
+}
+
+// replies with datablock memory usage
+static void _ReplyWithDataBlockMemory
+(
+	RedisModuleCtx *ctx,              // redis module context
+	const DataBlockMemoryUsage *mem   // datablock memory usage
+) {
+	RedisModule_ReplyWithArray(ctx, 8);
+	RedisModule_ReplyWithCString(ctx, "used_bytes");
+	RedisModule_ReplyWithLongLong(ctx, mem->used);
+	RedisModule_ReplyWithCString(ctx, "deleted_bytes");
+	RedisModule_ReplyWithLongLong(ctx, mem->deleted);
+	RedisModule_ReplyWithCString(ctx, "slack_bytes");
+	RedisModule_ReplyWithLongLong(ctx, mem->slack);
+	RedisModule_ReplyWithCString(ctx, "overhead_bytes");
+	RedisModule_ReplyWithLongLong(ctx, mem->overhead);
+}
+
+// collects graph's indices
+// returns an array of indices, the caller is responsible for freeing it
+static Index *_CollectIndices
+(
+	GraphContext *gc  // graph context
+) {
+	Index *indices = array_new(Index, 0);
+	Index  schema_indices[SCHEMA_MAX_INDICIES];
+
+	SchemaType types[2] = {SCHEMA_NODE, SCHEMA_EDGE};
+	for(int t = 0; t < 2; t++) {
+		unsigned short n = GraphContext_SchemaCount(gc, types[t]);
+		for(unsigned short i = 0; i < n; i++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, i, types[t]);
+			unsigned short count = Schema_GetIndicies(s, schema_indices);
+			for(unsigned short j = 0; j < count; j++) {
+				array_append(indices, schema_indices[j]);
+			}
+		}
+	}
+
+	return indices;
+}
+
+// replies with index memory usage
+static void _ReplyWithIndexMemory
+(
+	RedisModuleCtx *ctx,  // redis module context
+	const Index idx,      // index
+	size_t bytes          // bytes used by index
+) {
+	const char *type;
+	switch(Index_Type(idx)) {
+		case IDX_EXACT_MATCH:
+			type = "exact-match";
+			break;
+		case IDX_FULLTEXT:
+			type = "full-text";
+			break;
+		default:
+			type = "vector";
+			break;
+	}
+
+	RedisModule_ReplyWithArray(ctx, 8);
+	RedisModule_ReplyWithCString(ctx, "label");
+	RedisModule_ReplyWithCString(ctx, Index_GetLabel(idx));
+	RedisModule_ReplyWithCString(ctx, "entitytype");
+	RedisModule_ReplyWithCString(ctx, Index_GraphEntityType(idx) == GETYPE_NODE
+			? "NODE" : "RELATIONSHIP");
+	RedisModule_ReplyWithCString(ctx, "type");
+	RedisModule_ReplyWithCString(ctx, type);
+	RedisModule_ReplyWithCString(ctx, "bytes");
+	RedisModule_ReplyWithLongLong(ctx, bytes);
+}
+
+// computes and replies with graph memory usage
+static void _Graph_Memory
+(
+	RedisModuleCtx *ctx,  // redis module context
+	GraphContext *gc,     // graph context
+	uint64_t samples      // max number of entities to sample, 0 for all
+) {
+	Graph *g = GraphContext_GetGraph(gc);
+
+	//--------------------------------------------------------------------------
+	// graph wide structures
+	//--------------------------------------------------------------------------
+
+	size_t adj           = 0;
+	size_t adj_transpose = 0;
+	size_t node_labels   = 0;
+	size_t delta         = 0;
+
+	_MatrixMemory(g->adjacency_matrix, &adj, &adj_transpose, &delta);
+	_MatrixMemory(g->node_labels, &node_labels, &node_labels, &delta);
+
+	DataBlockMemoryUsage node_block;
+	DataBlockMemoryUsage edge_block;
+	DataBlock_MemoryUsage(g->nodes, &node_block);
+	DataBlock_MemoryUsage(g->edges, &edge_block);
+
+	uint    attr_count = GraphContext_AttributeCount(gc);
+	size_t *attr_bytes = rm_calloc(attr_count + 1, sizeof(size_t));
+
+	size_t node_attrs = _EstimateEntityAttributes(g, GETYPE_NODE, samples,
+			attr_bytes, attr_count);
+	size_t edge_attrs = _EstimateEntityAttributes(g, GETYPE_EDGE, samples,
+			attr_bytes, attr_count);
+
+	//--------------------------------------------------------------------------
+	// labels and relationship-types
+	//--------------------------------------------------------------------------
+
+	int label_count    = Graph_LabelTypeCount(g);
+	int relation_count = Graph_RelationTypeCount(g);
+
+	SchemaMemory *labels    = rm_calloc(label_count + 1, sizeof(SchemaMemory));
+	SchemaMemory *relations = rm_calloc(relation_count + 1,
+			sizeof(SchemaMemory));
+
+	size_t schema_bytes = 0;
+
+	for(int i = 0; i < label_count; i++) {
+		_LabelMemory(g, i, samples, labels + i);
+		schema_bytes += labels[i].matrix + labels[i].transpose;
+		delta        += labels[i].delta;
+	}
+
+	for(int i = 0; i < relation_count; i++) {
+		_RelationMemory(g, i, samples, relations + i);
+		schema_bytes += relations[i].matrix + relations[i].transpose +
+			relations[i].multi_edge;
+		delta        += relations[i].delta;
+	}
+
+	//--------------------------------------------------------------------------
+	// reply
+	//--------------------------------------------------------------------------
+
+	size_t slowlog_bytes = SlowLog_MemoryUsage(gc->slowlog);
+
+	Index  *indices     = _CollectIndices(gc);
+	uint    index_count = array_len(indices);
+	size_t *index_bytes = rm_calloc(index_count + 1, sizeof(size_t));
+	size_t  index_total = 0;
+
+	for(uint i = 0; i < index_count; i++) {
+		index_bytes[i] = Index_MemoryUsage(indices[i]);
+		index_total   += index_bytes[i];
+	}
+
+	size_t total = adj + adj_transpose + node_labels + delta + schema_bytes +
+		node_block.used + node_block.deleted + node_block.slack +
+		node_block.overhead + edge_block.used + edge_block.deleted +
+		edge_block.slack + edge_block.overhead + node_attrs + edge_attrs +
+		index_total + slowlog_bytes;
+
+	RedisModule_ReplyWithArray(ctx, 18);
+
+	RedisModule_ReplyWithCString(ctx, "total_bytes");
+	RedisModule_ReplyWithLongLong(ctx, total);
+
+	RedisModule_ReplyWithCString(ctx, "samples");
+	RedisModule_ReplyWithLongLong(ctx, samples);
+
+	// graph section
+	RedisModule_ReplyWithCString(ctx, "graph");
+	RedisModule_ReplyWithArray(ctx, 16);
+	RedisModule_ReplyWithCString(ctx, "adjacency_matrix_bytes");
+	RedisModule_ReplyWithLongLong(ctx, adj);
+	RedisModule_ReplyWithCString(ctx, "adjacency_transpose_bytes");
+	RedisModule_ReplyWithLongLong(ctx, adj_transpose);
+	RedisModule_ReplyWithCString(ctx, "node_labels_matrix_bytes");
+	RedisModule_ReplyWithLongLong(ctx, node_labels);
+	RedisModule_ReplyWithCString(ctx, "delta_matrices_bytes");
+	RedisModule_ReplyWithLongLong(ctx, delta);
+	RedisModule_ReplyWithCString(ctx, "node_block");
+	_ReplyWithDataBlockMemory(ctx, &node_block);
+	RedisModule_ReplyWithCString(ctx, "edge_block");
+	_ReplyWithDataBlockMemory(ctx, &edge_block);
+	RedisModule_ReplyWithCString(ctx, "node_attributes_bytes");
+	RedisModule_ReplyWithLongLong(ctx, node_attrs);
+	RedisModule_ReplyWithCString(ctx, "edge_attributes_bytes");
+	RedisModule_ReplyWithLongLong(ctx, edge_attrs);
+
+	// labels section
+	RedisModule_ReplyWithCString(ctx, "labels");
+	RedisModule_ReplyWithArray(ctx, label_count * 2);
+	for(int i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		RedisModule_ReplyWithCString(ctx, Schema_GetName(s));
+		RedisModule_ReplyWithArray(ctx, 8);
+		RedisModule_ReplyWithCString(ctx, "nodes");
+		RedisModule_ReplyWithLongLong(ctx, labels[i].count);
+		RedisModule_ReplyWithCString(ctx, "matrix_bytes");
+		RedisModule_ReplyWithLongLong(ctx, labels[i].matrix +
+				labels[i].transpose);
+		RedisModule_ReplyWithCString(ctx, "delta_bytes");
+		RedisModule_ReplyWithLongLong(ctx, labels[i].delta);
+		RedisModule_ReplyWithCString(ctx, "attributes_bytes");
+		RedisModule_ReplyWithLongLong(ctx, labels[i].attributes);
+	}
+
+	// relations section
+	RedisModule_ReplyWithCString(ctx, "relations");
+	RedisModule_ReplyWithArray(ctx, relation_count * 2);
+	for(int i = 0; i < relation_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_EDGE);
+		RedisModule_ReplyWithCString(ctx, Schema_GetName(s));
+		RedisModule_ReplyWithArray(ctx, 12);
+		RedisModule_ReplyWithCString(ctx, "edges");
+		RedisModule_ReplyWithLongLong(ctx, relations[i].count);
+		RedisModule_ReplyWithCString(ctx, "matrix_bytes");
+		RedisModule_ReplyWithLongLong(ctx, relations[i].matrix);
+		RedisModule_ReplyWithCString(ctx, "transpose_bytes");
+		RedisModule_ReplyWithLongLong(ctx, relations[i].transpose);
+		RedisModule_ReplyWithCString(ctx, "delta_bytes");
+		RedisModule_ReplyWithLongLong(ctx, relations[i].delta);
+		RedisModule_ReplyWithCString(ctx, "multi_edge_bytes");
+		RedisModule_ReplyWithLongLong(ctx, relations[i].multi_edge);
+		RedisModule_ReplyWithCString(ctx, "attributes_bytes");
+		RedisModule_ReplyWithLongLong(ctx, relations[i].attributes);
+	}
+
+	// attributes section
+	RedisModule_ReplyWithCString(ctx, "attributes");
+	RedisModule_ReplyWithArray(ctx, attr_count * 2);
+	for(uint i = 0; i < attr_count; i++) {
+		RedisModule_ReplyWithCString(ctx, GraphContext_GetAttributeString(gc, i));
+		RedisModule_ReplyWithLongLong(ctx, attr_bytes[i]);
+	}
+
+	// indices section
+	RedisModule_ReplyWithCString(ctx, "indices");
+	RedisModule_ReplyWithArray(ctx, index_count);
+	for(uint i = 0; i < index_count; i++) {
+		_ReplyWithIndexMemory(ctx, indices[i], index_bytes[i]);
+	}
+
+	// cached execution plans can't be measured, report their count
+	RedisModule_ReplyWithCString(ctx, "plan_cache_entries");
+	RedisModule_ReplyWithLongLong(ctx, GraphContext_GetCache(gc)->size);
+
+	RedisModule_ReplyWithCString(ctx, "slowlog_bytes");
+	RedisModule_ReplyWithLongLong(ctx, slowlog_bytes);
+
+	rm_free(labels);
+	rm_free(relations);
+	rm_free(attr_bytes);
+	rm_free(index_bytes);
+	array_free(indices);
+}
+
+// GRAPH.MEMORY <graph> [SAMPLES <count>]
+// reports the number of bytes used by each of the graph's structures
+// attribute-sets and multi-edge arrays are estimated by sampling
+// SAMPLES 0 inspects every entity
+int Graph_Memory
+(
+	RedisModuleCtx *ctx,       // redis module context
+	RedisModuleString **argv,  // command arguments
+	int argc                   // number of arguments
+) {
+	if(argc != 2 && argc != 4) return RedisModule_WrongArity(ctx);
+
+	long long samples = MEMORY_DEFAULT_SAMPLES;
+
+	if(argc == 4) {
+		const char *arg = RedisModule_StringPtrLen(argv[2], NULL);
+		if(strcasecmp(arg, "SAMPLES") != 0) {
+			RedisModule_ReplyWithErrorFormat(ctx,
+					"Unknown GRAPH.MEMORY argument '%s'", arg);
+			return REDISMODULE_OK;
+		}
+
+		if(RedisModule_StringToLongLong(argv[3], &samples) != REDISMODULE_OK ||
+		   samples < 0) {
+			RedisModule_ReplyWithError(ctx,
+					"SAMPLES must be a non-negative integer");
+			return REDISMODULE_OK;
+		}
+	}
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, argv[1], true, false);
+
+	// failed to retrieve GraphContext; an error has been emitted
+	if(gc == NULL) return REDISMODULE_OK;
+
+	Graph *g = GraphContext_GetGraph(gc);
+
+	// writers modify the graph only while holding the write lock
+	Graph_AcquireReadLock(g);
+	_Graph_Memory(ctx, gc, samples);
+	Graph_ReleaseLock(g);
+
+	GraphContext_DecreaseRefCount(gc);
+
+	return REDISMODULE_OK;
+}
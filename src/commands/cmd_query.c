@@ -315,7 +315,11 @@ static void _ExecuteQuery(void *args) {
 		: (compact)
 			? FORMATTER_COMPACT
 			: FORMATTER_VERBOSE;
-	ResultSet *result_set = NewResultSet(rm_ctx, resultset_format);
+	// stream read-only results as they're produced
+	// write queries buffer their results as modifications might be rolled back
+	bool stream = readonly && resultset_format != FORMATTER_NOP;
+	ResultSet *result_set = NewResultSet(rm_ctx, resultset_format, stream,
+			stream ? &command_ctx->disconnected : NULL);
 	if(exec_ctx->cached) {
 		ResultSet_CachedExecution(result_set); // indicate a cached execution
 	}
@@ -323,6 +327,7 @@ static void _ExecuteQuery(void *args) {
 	QueryCtx_SetResultSet(result_set);
 
 	// acquire the appropriate lock
+	QueryCtx_Trace(QueryTrace_LOCK);
 	if(readonly) {
 		Graph_AcquireReadLock(gc->g);
 	} else {
@@ -336,6 +341,8 @@ static void _ExecuteQuery(void *args) {
 		CommandCtx_ThreadSafeContextUnlock(command_ctx);
 	}
 
+	QueryCtx_Trace(QueryTrace_EXECUTE);
+
 	if(exec_type == EXECUTION_TYPE_QUERY) {  // query operation
 		// set policy after lock acquisition,
 		// avoid resetting policies between readers and writers
@@ -351,6 +358,7 @@ static void _ExecuteQuery(void *args) {
 			if(!ErrorCtx_EncounteredError()) {
 				// transition the query from executing reporting
 				QueryCtx_AdvanceStage(query_ctx);
+				QueryCtx_Trace(QueryTrace_REPLY);
 				ExecutionPlan_Print(plan, rm_ctx);
 			}
 		}
@@ -370,6 +378,8 @@ static void _ExecuteQuery(void *args) {
 		ASSERT("Unhandled query type" && false);
 	}
 
+	QueryCtx_Trace(QueryTrace_COMMIT);
+
 	// in case of an error, rollback any modifications
 	if(ErrorCtx_EncounteredError()) {
 		QueryCtx_Rollback();
@@ -381,9 +391,14 @@ static void _ExecuteQuery(void *args) {
 	} else {
 		// replicate if graph was modified
 		if(ResultSetStat_IndicateModification(&result_set->stats)) {
+			QueryCtx_Trace(QueryTrace_REPLICATE);
+
 			// determine rather or not to replicate via effects
+			// once a batch was committed the query can't be replayed as a
+			// whole, the remaining modifications are replicated as effects
+			bool batched = QueryCtx_CommittedBatch();
 			if(EffectsBuffer_Length(QueryCtx_GetEffectsBuffer()) > 0 &&
-			   _should_replicate_effects()) {
+			   (batched || _should_replicate_effects())) {
 				// compute effects buffer
 				size_t effects_len = 0;
 				u_char *effects = EffectsBuffer_Buffer(
@@ -394,11 +409,13 @@ static void _ExecuteQuery(void *args) {
 				RedisModule_Replicate(rm_ctx, "GRAPH.EFFECT", "cb!",
 						GraphContext_GetName(gc), effects, effects_len);
 				rm_free(effects);
-			} else {
+			} else if(!batched) {
 				// replicate original query
 				QueryCtx_Replicate(query_ctx);
 			}
-		}	
+
+			QueryCtx_Trace(QueryTrace_COMMIT);
+		}
 	}
 
 	QueryCtx_UnlockCommit();
@@ -408,6 +425,7 @@ static void _ExecuteQuery(void *args) {
 		// send result-set back to client
 		// transition the query from executing reporting
 		QueryCtx_AdvanceStage(query_ctx);
+		QueryCtx_Trace(QueryTrace_REPLY);
 		ResultSet_Reply(result_set);
 
 		// transition the query from reporting to finished
@@ -421,6 +439,18 @@ static void _ExecuteQuery(void *args) {
 	SlowLog_Add(slowlog, command_ctx->command_name, command_ctx->query,
 				QueryCtx_GetRuntime(), NULL);
 
+	// aggregate statistics by query fingerprint
+	// the error context is cleared once the error is emitted, consult status
+	if(query_ctx->status == QueryExecutionStatus_SUCCESS &&
+	   ast->fingerprint_query != NULL) {
+		FingerprintStats_Add(gc->fingerprint_stats, ast->fingerprint,
+				ast->fingerprint_query, exec_ctx->plan_signature,
+				QueryCtx_GetRuntime(),
+				command_ctx->trace.durations[QueryTrace_LOCK],
+				ResultSet_RowCount(result_set), exec_ctx->cached,
+				rm_n_alloced_peak());
+	}
+
 	// clean up
 	ExecutionCtx_Free(exec_ctx);
 	GraphContext_DecreaseRefCount(gc);
@@ -440,6 +470,9 @@ static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	// Migrate to writer thread
 	//---------------------------------------------------------------------------
 
+	// account time spent waiting for the writer thread
+	QueryCtx_Trace(QueryTrace_QUEUE);
+
 	// write queries will be executed on a dedicated writer thread,
 	// clear this thread data
 	ErrorCtx_Clear();
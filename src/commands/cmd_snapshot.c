@@ -0,0 +1,220 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "commands.h"
+#include "../util/rmalloc.h"
+#include "../util/thpool/pools.h"
+#include "../util/import_folder.h"
+#include "../util/blocked_client.h"
+#include "../serializers/snapshot.h"
+
+#include <inttypes.h>
+
+// snapshot save task, runs on a reader thread
+typedef struct {
+	RedisModuleBlockedClient *bc;  // blocked client awaiting the save
+	GraphContext *gc;              // graph to save
+	char *path;                    // resolved snapshot file path
+} SnapshotSaveTask;
+
+// resolve snapshot path within the import folder
+// returns NULL and emits an error if the path leads outside of it
+static char *_Graph_Snapshot_ResolvePath
+(
+	RedisModuleCtx *ctx,  // redis context
+	const char *path      // snapshot file path, relative to the import folder
+) {
+	char *resolved = ImportFolder_ResolvePath(path);
+	if(resolved == NULL) {
+		RedisModule_ReplyWithErrorFormat(ctx,
+				"Snapshot file '%s' is outside of the import folder", path);
+	}
+
+	return resolved;
+}
+
+// write snapshot and reply to the saving client
+static void _Graph_Snapshot_SaveAndReply
+(
+	RedisModuleCtx *ctx,  // redis context
+	GraphContext *gc,     // graph to save
+	const char *path      // resolved snapshot file path
+) {
+	int rc = Snapshot_Save(ctx, gc, path);
+
+	GraphContext_DecreaseRefCount(gc);
+
+	// saving doesn't modify the keyspace, nothing to replicate
+	if(rc == SNAPSHOT_OK) RedisModule_ReplyWithSimpleString(ctx, "OK");
+}
+
+// save snapshot off Redis main thread
+static void _Graph_Snapshot_SaveTask
+(
+	void *arg
+) {
+	SnapshotSaveTask *task = (SnapshotSaveTask *)arg;
+
+	// replies to a blocked client's thread-safe context don't require the GIL
+	RedisModuleCtx *ctx = RedisModule_GetThreadSafeContext(task->bc);
+	_Graph_Snapshot_SaveAndReply(ctx, task->gc, task->path);
+	RedisModule_FreeThreadSafeContext(ctx);
+
+	RedisGraph_UnblockClient(task->bc);
+	rm_free(task->path);
+	rm_free(task);
+}
+
+// save graph to a snapshot file
+// the graph is read locked while the file is written, as such the write
+// is handed to a reader thread, keeping Redis main thread responsive
+static void _Graph_Snapshot_Save
+(
+	RedisModuleCtx *ctx,                // redis context
+	RedisModuleString *rs_graph_name,   // graph key name
+	const char *path                    // snapshot file path
+) {
+	char *resolved = _Graph_Snapshot_ResolvePath(ctx, path);
+	if(resolved == NULL) return;
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, rs_graph_name, true, false);
+
+	// failed to retrieve GraphContext; an error has been emitted
+	if(gc == NULL) {
+		rm_free(resolved);
+		return;
+	}
+
+	// save on Redis main thread when the client can't be blocked
+	int flags = RedisModule_GetContextFlags(ctx);
+	if(flags & (REDISMODULE_CTX_FLAGS_MULTI         |
+				REDISMODULE_CTX_FLAGS_LUA           |
+				REDISMODULE_CTX_FLAGS_DENY_BLOCKING |
+				REDISMODULE_CTX_FLAGS_LOADING)) {
+		_Graph_Snapshot_SaveAndReply(ctx, gc, resolved);
+		rm_free(resolved);
+		return;
+	}
+
+	SnapshotSaveTask *task = rm_malloc(sizeof(SnapshotSaveTask));
+
+	task->bc   = RedisGraph_BlockClient(ctx);
+	task->gc   = gc;
+	task->path = resolved;
+
+	if(ThreadPools_AddWorkReader(_Graph_Snapshot_SaveTask, task, false) ==
+			THPOOL_QUEUE_FULL) {
+		RedisModule_ReplyWithError(ctx, "Max pending queries exceeded");
+		GraphContext_DecreaseRefCount(gc);
+		RedisGraph_UnblockClient(task->bc);
+		rm_free(task->path);
+		rm_free(task);
+	}
+}
+
+// replicate a loaded graph as a RESTORE of its DUMP payload
+static void _Graph_Snapshot_Replicate
+(
+	RedisModuleCtx *ctx,              // redis context
+	RedisModuleString *rs_graph_name  // graph key name
+) {
+	RedisModuleCallReply *reply = RedisModule_Call(ctx, "DUMP", "s",
+			rs_graph_name);
+	ASSERT(reply != NULL);
+	ASSERT(RedisModule_CallReplyType(reply) == REDISMODULE_REPLY_STRING);
+
+	size_t len;
+	const char *payload = RedisModule_CallReplyStringPtr(reply, &len);
+	RedisModule_Replicate(ctx, "RESTORE", "slb", rs_graph_name, 0LL, payload,
+			len);
+
+	RedisModule_FreeCallReply(reply);
+}
+
+// load a new graph from a snapshot file
+static void _Graph_Snapshot_Load
+(
+	RedisModuleCtx *ctx,                // redis context
+	RedisModuleString *rs_graph_name,   // graph key name
+	const char *path                    // snapshot file path
+) {
+	const char *graphname = RedisModule_StringPtrLen(rs_graph_name, NULL);
+
+	// snapshots are only loaded into new graphs
+	RedisModuleKey *key = RedisModule_OpenKey(ctx, rs_graph_name,
+			REDISMODULE_READ);
+	RedisModule_CloseKey(key);
+
+	if(key) {
+		RedisModule_ReplyWithErrorFormat(ctx, "Graph with name '%s' cannot be "
+				"created, as key '%s' already exists.", graphname, graphname);
+		return;
+	}
+
+	char *resolved = _Graph_Snapshot_ResolvePath(ctx, path);
+	if(resolved == NULL) return;
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, rs_graph_name, false, true);
+
+	// failed to retrieve GraphContext; an error has been emitted
+	if(gc == NULL) {
+		rm_free(resolved);
+		return;
+	}
+
+	uint64_t node_count;
+	uint64_t edge_count;
+
+	int rc = Snapshot_Load(ctx, gc, resolved, &node_count, &edge_count);
+
+	rm_free(resolved);
+	GraphContext_DecreaseRefCount(gc);
+
+	if(rc == SNAPSHOT_FAIL) {
+		// remove the partially loaded graph
+		key = RedisModule_OpenKey(ctx, rs_graph_name, REDISMODULE_WRITE);
+		RedisModule_DeleteKey(key);
+		RedisModule_CloseKey(key);
+		return;
+	}
+
+	// replicas and AOF don't share the import folder's contents
+	// replicate the loaded graph rather than the snapshot file path
+	_Graph_Snapshot_Replicate(ctx, rs_graph_name);
+
+	// replay to caller
+	char reply[1024];
+	int len = snprintf(reply, 1024, "%" PRIu64 " nodes loaded, %" PRIu64
+			" edges loaded", node_count, edge_count);
+	RedisModule_ReplyWithStringBuffer(ctx, reply, len);
+}
+
+// GRAPH.SNAPSHOT SAVE <graph> <path>
+// GRAPH.SNAPSHOT LOAD <graph> <path>
+// paths are relative to the configured IMPORT_FOLDER
+int Graph_Snapshot
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	if(argc != 4) return RedisModule_WrongArity(ctx);
+
+	const char *op = RedisModule_StringPtrLen(argv[1], NULL);
+	const char *path = RedisModule_StringPtrLen(argv[3], NULL);
+
+	if(strcasecmp(op, "SAVE") == 0) {
+		_Graph_Snapshot_Save(ctx, argv[2], path);
+	} else if(strcasecmp(op, "LOAD") == 0) {
+		_Graph_Snapshot_Load(ctx, argv[2], path);
+	} else {
+		RedisModule_ReplyWithErrorFormat(ctx,
+				"Unknown GRAPH.SNAPSHOT subcommand '%s'", op);
+	}
+
+	return REDISMODULE_OK;
+}
@@ -26,3 +26,41 @@ GRAPH_Commands CommandFromString(const char *cmd_name) {
 	return CMD_UNKNOWN;
 }
 
+
+// convert from an enum to string representation
+const char *CommandToString(GRAPH_Commands cmd) {
+	switch(cmd) {
+		case CMD_INFO:        return "GRAPH.INFO";
+		case CMD_LIST:        return "GRAPH.LIST";
+		case CMD_QUERY:       return "GRAPH.QUERY";
+		case CMD_DEBUG:       return "GRAPH.DEBUG";
+		case CMD_EFFECT:      return "GRAPH.EFFECT";
+		case CMD_DELETE:      return "GRAPH.DELETE";
+		case CMD_CONFIG:      return "GRAPH.CONFIG";
+		case CMD_PROFILE:     return "GRAPH.PROFILE";
+		case CMD_EXPLAIN:     return "GRAPH.EXPLAIN";
+		case CMD_SLOWLOG:     return "GRAPH.SLOWLOG";
+		case CMD_RO_QUERY:    return "GRAPH.RO_QUERY";
+		case CMD_BULK_INSERT: return "GRAPH.BULK";
+		default:              return "UNKNOWN";
+	}
+}
+
+// module wide latency histograms, indexed by command
+// only commands executing queries are tracked
+static LatencyStats _latency_stats[CMD_COUNT] = {0};
+
+// create module wide latency histograms for query executing commands
+void Commands_InitLatencyStats(void) {
+	ASSERT(_latency_stats[CMD_QUERY] == NULL);
+
+	_latency_stats[CMD_QUERY]    = LatencyStats_New();
+	_latency_stats[CMD_RO_QUERY] = LatencyStats_New();
+	_latency_stats[CMD_PROFILE]  = LatencyStats_New();
+}
+
+// returns command's latency histograms, NULL if command isn't tracked
+LatencyStats Commands_GetLatencyStats(GRAPH_Commands cmd) {
+	ASSERT(cmd < CMD_COUNT);
+	return _latency_stats[cmd];
+}
@@ -27,7 +27,8 @@ typedef enum {
 	CMD_LIST        = 9,
 	CMD_DEBUG       = 10,
 	CMD_INFO        = 11,
-	CMD_EFFECT      = 12
+	CMD_EFFECT      = 12,
+	CMD_COUNT       = 13   // number of commands
 } GRAPH_Commands;
 
 //------------------------------------------------------------------------------
@@ -36,6 +37,19 @@ typedef enum {
 
 GRAPH_Commands CommandFromString(const char *cmd_name);
 
+// convert from an enum to string representation
+const char *CommandToString(GRAPH_Commands cmd);
+
+//------------------------------------------------------------------------------
+// commands latency
+//------------------------------------------------------------------------------
+
+// create module wide latency histograms for query executing commands
+void Commands_InitLatencyStats(void);
+
+// returns command's latency histograms, NULL if command isn't tracked
+LatencyStats Commands_GetLatencyStats(GRAPH_Commands cmd);
+
 void Graph_Query(void *args);
 void Graph_Profile(void *args);
 void Graph_Explain(void *args);
@@ -47,5 +61,7 @@ int Graph_Delete(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Effect(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Config(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Slowlog(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
+int Graph_Snapshot(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
+int Graph_Memory(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Constraint(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
@@ -53,6 +53,23 @@ static AST *_ExecutionCtx_ParseAST
 	return ast;
 }
 
+// hash op's type and shape along with its descendants
+static uint64_t _PlanSignature
+(
+	const OpBase *op,  // op to hash
+	uint64_t h         // hash so far
+) {
+	// FNV-1a
+	h = (h ^ op->type)       * 1099511628211ULL;
+	h = (h ^ op->childCount) * 1099511628211ULL;
+
+	for(int i = 0; i < op->childCount; i++) {
+		h = _PlanSignature(op->children[i], h);
+	}
+
+	return h;
+}
+
 static ExecutionCtx *_ExecutionCtx_New
 (
 	AST *ast,
@@ -66,6 +83,9 @@ static ExecutionCtx *_ExecutionCtx_New
 	exec_ctx->cached    = false;
 	exec_ctx->exec_type = exec_type;
 
+	exec_ctx->plan_signature = (plan != NULL) ?
+		_PlanSignature(plan->root, 14695981039346656037ULL) : 0;
+
 	return exec_ctx;
 }
 
@@ -86,6 +106,8 @@ ExecutionCtx *ExecutionCtx_Clone
 	clone->cached    = ctx->cached;
 	clone->exec_type = ctx->exec_type;
 
+	clone->plan_signature = ctx->plan_signature;
+
 	return clone;
 }
 
@@ -108,6 +130,8 @@ ExecutionCtx *ExecutionCtx_FromQuery
 		return NULL;
 	}
 
+	QueryCtx_Trace(QueryTrace_PARSE);
+
 	// parse and validate parameters only
 	// extract query string
 	// return invalid execution context if failed to parse params
@@ -137,6 +161,7 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	Cache *cache = GraphContext_GetCache(QueryCtx_GetGraphCtx());
 
 	// see if we already have a cached execution-ctx for given query
+	QueryCtx_Trace(QueryTrace_CACHE);
 	ret = Cache_GetValue(cache, q_str);
 
 	//--------------------------------------------------------------------------
@@ -154,6 +179,7 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	//--------------------------------------------------------------------------
 
 	// try to parse the query
+	QueryCtx_Trace(QueryTrace_PARSE);
 	AST *ast = _ExecutionCtx_ParseAST(q_str);
 
 	// parser failed
@@ -170,6 +196,9 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	// associate parameters with AST
 	AST_SetParamsParseResult(ast, params_parse_result);
 
+	// fingerprint query, cached executions share their AST's fingerprint
+	AST_Fingerprint(ast, q_str);
+
 	ExecutionType exec_type = _GetExecutionTypeFromAST(ast);
 	// in case of valid query
 	// create execution plan, and cache it and the AST
@@ -177,6 +206,7 @@ ExecutionCtx *ExecutionCtx_FromQuery
 		//----------------------------------------------------------------------
 		// build execution-plan
 		//----------------------------------------------------------------------
+		QueryCtx_Trace(QueryTrace_PLAN);
 		ExecutionPlan *plan = ExecutionPlan_FromTLS_AST();
 
 		// TODO: there must be a better way to understand if the execution-plan
@@ -22,6 +22,7 @@ typedef struct {
 	bool cached;              // cache hit/miss
 	ExecutionPlan *plan;      // execution plan
 	ExecutionType exec_type;  // execution type: query, index create/delete
+	uint64_t plan_signature;  // hash of the plan's operations, 0 if no plan
 } ExecutionCtx;
 
 // returns the objects and information required for query execution
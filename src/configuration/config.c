@@ -64,6 +64,18 @@
 // effects replication threshold
 #define EFFECTS_THRESHOLD "EFFECTS_THRESHOLD"
 
+// folder from which LOAD CSV reads files
+#define IMPORT_FOLDER "IMPORT_FOLDER"
+
+// folder to which cold attribute values are spilled
+#define TIERED_STORAGE_FOLDER "TIERED_STORAGE_FOLDER"
+
+// minimum size in bytes of a spilled attribute value
+#define TIERED_STORAGE_MIN_VALUE_SIZE "TIERED_STORAGE_MIN_VALUE_SIZE"
+
+// interval in milliseconds between tiered storage sweeps
+#define TIERED_STORAGE_SWEEP_INTERVAL "TIERED_STORAGE_SWEEP_INTERVAL"
+
 
 //------------------------------------------------------------------------------
 // Configuration defaults
@@ -94,6 +106,10 @@ typedef struct {
 	bool cmd_info_on;                  // If true, the GRAPH.INFO is enabled.
 	uint64_t effects_threshold;        // replicate via effects when runtime exceeds threshold
 	uint32_t max_info_queries_count;   // Maximum number of query info elements.
+	char import_folder[PATH_MAX];      // folder from which LOAD CSV reads files
+	char tiered_storage_folder[PATH_MAX]; // spill folder, empty when disabled
+	uint64_t tiered_storage_min_value_size; // min size of a spilled value
+	uint64_t tiered_storage_sweep_interval; // ms between tiered storage sweeps
 } RG_Config;
 
 RG_Config config; // global module configuration
@@ -436,6 +452,75 @@ static uint64_t Config_effects_threshold_get (void) {
 	return config.effects_threshold;
 }
 
+//------------------------------------------------------------------------------
+// import folder
+//------------------------------------------------------------------------------
+
+static bool Config_import_folder_set
+(
+	const char *folder
+) {
+	size_t len = strlen(folder);
+	if(len == 0) return false;
+
+	// make sure folder ends with a '/'
+	bool sep = folder[len - 1] == '/';
+	if(len + !sep >= PATH_MAX) return false;
+
+	memcpy(config.import_folder, folder, len);
+	if(!sep) config.import_folder[len++] = '/';
+	config.import_folder[len] = '\0';
+
+	return true;
+}
+
+static const char *Config_import_folder_get(void) {
+	return config.import_folder;
+}
+
+//------------------------------------------------------------------------------
+// tiered storage
+//------------------------------------------------------------------------------
+
+// an empty folder disables tiered storage
+static bool Config_tiered_storage_folder_set
+(
+	const char *folder
+) {
+	size_t len = strlen(folder);
+	if(len >= PATH_MAX) return false;
+
+	memcpy(config.tiered_storage_folder, folder, len + 1);
+
+	return true;
+}
+
+static const char *Config_tiered_storage_folder_get(void) {
+	return config.tiered_storage_folder;
+}
+
+static void Config_tiered_storage_min_value_size_set
+(
+	uint64_t size
+) {
+	config.tiered_storage_min_value_size = size;
+}
+
+static uint64_t Config_tiered_storage_min_value_size_get(void) {
+	return config.tiered_storage_min_value_size;
+}
+
+static void Config_tiered_storage_sweep_interval_set
+(
+	uint64_t interval
+) {
+	config.tiered_storage_sweep_interval = interval;
+}
+
+static uint64_t Config_tiered_storage_sweep_interval_get(void) {
+	return config.tiered_storage_sweep_interval;
+}
+
 bool Config_Contains_field
 (
 	const char *field_str,
@@ -477,6 +562,14 @@ bool Config_Contains_field
 		f = Config_CMD_INFO_MAX_QUERY_COUNT;
 	} else if (!(strcasecmp(field_str, EFFECTS_THRESHOLD))) {
 		f = Config_EFFECTS_THRESHOLD;
+	} else if (!(strcasecmp(field_str, IMPORT_FOLDER))) {
+		f = Config_IMPORT_FOLDER;
+	} else if (!(strcasecmp(field_str, TIERED_STORAGE_FOLDER))) {
+		f = Config_TIERED_STORAGE_FOLDER;
+	} else if (!(strcasecmp(field_str, TIERED_STORAGE_MIN_VALUE_SIZE))) {
+		f = Config_TIERED_STORAGE_MIN_VALUE_SIZE;
+	} else if (!(strcasecmp(field_str, TIERED_STORAGE_SWEEP_INTERVAL))) {
+		f = Config_TIERED_STORAGE_SWEEP_INTERVAL;
 	} else {
 		return false;
 	}
@@ -555,6 +648,22 @@ const char *Config_Field_name
 			name = EFFECTS_THRESHOLD;
 			break;
 
+		case Config_IMPORT_FOLDER:
+			name = IMPORT_FOLDER;
+			break;
+
+		case Config_TIERED_STORAGE_FOLDER:
+			name = TIERED_STORAGE_FOLDER;
+			break;
+
+		case Config_TIERED_STORAGE_MIN_VALUE_SIZE:
+			name = TIERED_STORAGE_MIN_VALUE_SIZE;
+			break;
+
+		case Config_TIERED_STORAGE_SWEEP_INTERVAL:
+			name = TIERED_STORAGE_SWEEP_INTERVAL;
+			break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -622,6 +731,14 @@ static void _Config_SetToDefaults(void) {
 
 	// replicate effects if avg change time μs > effects_threshold μs
 	config.effects_threshold = 300 ;
+
+	// LOAD CSV reads files from this folder
+	Config_import_folder_set(IMPORT_FOLDER_DEFAULT);
+
+	// tiered storage is disabled by default
+	Config_tiered_storage_folder_set("");
+	config.tiered_storage_min_value_size = TIERED_STORAGE_MIN_VALUE_SIZE_DEFAULT;
+	config.tiered_storage_sweep_interval = TIERED_STORAGE_SWEEP_INTERVAL_DEFAULT;
 }
 
 int Config_Init
@@ -930,6 +1047,62 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// import folder
+		//----------------------------------------------------------------------
+
+		case Config_IMPORT_FOLDER: {
+			va_start(ap, field);
+			const char **import_folder = va_arg(ap, const char **);
+			va_end(ap);
+
+			ASSERT(import_folder != NULL);
+			(*import_folder) = Config_import_folder_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// tiered storage folder
+		//----------------------------------------------------------------------
+
+		case Config_TIERED_STORAGE_FOLDER: {
+			va_start(ap, field);
+			const char **folder = va_arg(ap, const char **);
+			va_end(ap);
+
+			ASSERT(folder != NULL);
+			(*folder) = Config_tiered_storage_folder_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// tiered storage min value size
+		//----------------------------------------------------------------------
+
+		case Config_TIERED_STORAGE_MIN_VALUE_SIZE: {
+			va_start(ap, field);
+			uint64_t *min_value_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(min_value_size != NULL);
+			(*min_value_size) = Config_tiered_storage_min_value_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// tiered storage sweep interval
+		//----------------------------------------------------------------------
+
+		case Config_TIERED_STORAGE_SWEEP_INTERVAL: {
+			va_start(ap, field);
+			uint64_t *sweep_interval = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(sweep_interval != NULL);
+			(*sweep_interval) = Config_tiered_storage_sweep_interval_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -1169,6 +1342,56 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// import folder
+		//----------------------------------------------------------------------
+
+		case Config_IMPORT_FOLDER: {
+			if(!Config_import_folder_set(val)) {
+				if(err) *err = "Invalid IMPORT_FOLDER path";
+				return false;
+			}
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// tiered storage folder
+		//----------------------------------------------------------------------
+
+		case Config_TIERED_STORAGE_FOLDER: {
+			if(!Config_tiered_storage_folder_set(val)) {
+				if(err) *err = "Invalid TIERED_STORAGE_FOLDER path";
+				return false;
+			}
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// tiered storage min value size
+		//----------------------------------------------------------------------
+
+		case Config_TIERED_STORAGE_MIN_VALUE_SIZE: {
+			long long min_value_size;
+			if(!_Config_ParsePositiveInteger(val, &min_value_size)) {
+				return false;
+			}
+			Config_tiered_storage_min_value_size_set(min_value_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// tiered storage sweep interval
+		//----------------------------------------------------------------------
+
+		case Config_TIERED_STORAGE_SWEEP_INTERVAL: {
+			long long sweep_interval;
+			if(!_Config_ParsePositiveInteger(val, &sweep_interval)) {
+				return false;
+			}
+			Config_tiered_storage_sweep_interval_set(sweep_interval);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
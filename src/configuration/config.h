@@ -15,6 +15,9 @@
 #define QUERY_MEM_CAPACITY_UNLIMITED       0
 #define NODE_CREATION_BUFFER_DEFAULT       16384
 #define DELTA_MAX_PENDING_CHANGES_DEFAULT  10000
+#define IMPORT_FOLDER_DEFAULT              "/var/lib/redisgraph/import/"
+#define TIERED_STORAGE_MIN_VALUE_SIZE_DEFAULT 1024
+#define TIERED_STORAGE_SWEEP_INTERVAL_DEFAULT 60000
 
 typedef enum {
 	Config_TIMEOUT                   = 0,   // timeout value for queries
@@ -33,7 +36,11 @@ typedef enum {
 	Config_CMD_INFO                  = 13,  // toggle on/off the GRAPH.INFO
 	Config_CMD_INFO_MAX_QUERY_COUNT  = 14,  // the max number of info queries count
 	Config_EFFECTS_THRESHOLD         = 15,  // replicate queries via effects
-	Config_END_MARKER                = 16
+	Config_IMPORT_FOLDER             = 16,  // folder LOAD CSV reads files from
+	Config_TIERED_STORAGE_FOLDER     = 17,  // folder cold attribute values are spilled to
+	Config_TIERED_STORAGE_MIN_VALUE_SIZE = 18,  // min size of a spilled value
+	Config_TIERED_STORAGE_SWEEP_INTERVAL = 19,  // ms between tiered storage sweeps
+	Config_END_MARKER                = 20
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -8,6 +8,7 @@
 #include "cron.h"
 #include "util/rmalloc.h"
 #include "configuration/config.h"
+#include "tasks/spill_cold_attributes.h"
 #include "tasks/stream_finished_queries.h"
 
 typedef struct RecurringTaskCtx {
@@ -83,5 +84,6 @@ void CronTask_AddStreamFinishedQueries() {
 // add recurring tasks
 void Cron_AddRecurringTasks(void) {
 	CronTask_AddStreamFinishedQueries();
+	CronTask_AddSpillColdAttributes();
 }
 
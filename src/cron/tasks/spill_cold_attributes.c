@@ -0,0 +1,144 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "globals.h"
+#include "cron/cron.h"
+#include "util/rmalloc.h"
+#include "util/thpool/pools.h"
+#include "graph/graphcontext.h"
+#include "configuration/config.h"
+#include "spill_cold_attributes.h"
+#include "graph/entities/attribute_spill.h"
+
+// number of entities swept by a single writer job
+#define SWEEP_BATCH_SIZE 16384
+
+// delay in ms between consecutive batches of the same sweep
+#define SWEEP_BATCH_DELAY 10
+
+// sweeps are CLOCK like, each sweep visits every entity in every graph
+// an attribute read since the previous sweep has its access marker cleared
+// otherwise its value is spilled if it is a large enough string
+//
+// sweeps are carried out by the writer thread in batches,
+// each batch holds the graph's write lock, such that no query can access
+// the values being spilled
+
+// reschedule sweep
+static void _Reschedule
+(
+	SpillColdAttributesCtx *ctx,  // task context
+	uint when                     // ms until next invocation
+) {
+	Cron_AddTask(when, CronTask_spillColdAttributes, rm_free, ctx);
+}
+
+// sweep a batch of entities from the graph pointed at by the task context
+static void _SpillColdAttributes
+(
+	void *pdata  // task context
+) {
+	SpillColdAttributesCtx *ctx = (SpillColdAttributesCtx*)pdata;
+
+	uint64_t min_size;
+	uint64_t interval;
+	Config_Option_get(Config_TIERED_STORAGE_MIN_VALUE_SIZE, &min_size);
+	Config_Option_get(Config_TIERED_STORAGE_SWEEP_INTERVAL, &interval);
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	// pick up from where we've left
+	GraphIterator_Seek(&it, ctx->graph_idx);
+
+	GraphContext *gc = GraphIterator_Next(&it);
+
+	// sweep completed, start over once interval elapses
+	if(gc == NULL) {
+		if(ctx->released > 0) {
+			RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_VERBOSE,
+					"Tiered storage sweep spilled %zu bytes", ctx->released);
+		}
+
+		ctx->graph_idx  = 0;
+		ctx->entity_idx = 0;
+		ctx->released   = 0;
+
+		_Reschedule(ctx, interval);
+		return;
+	}
+
+	Graph *g = gc->g;
+
+	Graph_AcquireWriteLock(g);
+
+	uint64_t node_count = Graph_UncompactedNodeCount(g);
+	uint64_t edge_count = Graph_EdgeCount(g) + Graph_DeletedEdgeCount(g);
+	uint64_t total      = node_count + edge_count;
+	uint64_t end        = ctx->entity_idx + SWEEP_BATCH_SIZE;
+	if(end > total) end = total;
+
+	for(uint64_t i = ctx->entity_idx; i < end; i++) {
+		AttributeSet *set;
+
+		if(i < node_count) {
+			Node n;
+			if(!Graph_GetNode(g, i, &n)) continue;
+			set = n.attributes;
+		} else {
+			Edge e;
+			if(!Graph_GetEdge(g, i - node_count, &e)) continue;
+			set = e.attributes;
+		}
+
+		ctx->released += AttributeSet_Evict(*set, min_size);
+	}
+
+	Graph_ReleaseLock(g);
+
+	GraphContext_DecreaseRefCount(gc);
+
+	// advance to the next graph once this one is exhausted
+	if(end == total) {
+		ctx->graph_idx++;
+		ctx->entity_idx = 0;
+	} else {
+		ctx->entity_idx = end;
+	}
+
+	_Reschedule(ctx, SWEEP_BATCH_DELAY);
+}
+
+// cron task
+// hands the sweep over to the writer thread
+void CronTask_spillColdAttributes
+(
+	void *pdata  // task context
+) {
+	ASSERT(pdata != NULL);
+
+	// CRON frees the task's context once this function returns
+	SpillColdAttributesCtx *ctx = rm_malloc(sizeof(SpillColdAttributesCtx));
+	*ctx = *(SpillColdAttributesCtx*)pdata;
+
+	// the writer thread reschedules the task once the batch is done
+	if(ThreadPools_AddWorkWriter(_SpillColdAttributes, ctx, 0) != 0) {
+		// writer queue is full, try again later
+		_Reschedule(ctx, SWEEP_BATCH_DELAY);
+	}
+}
+
+void CronTask_AddSpillColdAttributes(void) {
+	if(!AttributeSpill_Enabled()) return;
+
+	uint64_t interval;
+	Config_Option_get(Config_TIERED_STORAGE_SWEEP_INTERVAL, &interval);
+
+	SpillColdAttributesCtx *ctx = rm_calloc(1, sizeof(SpillColdAttributesCtx));
+
+	Cron_AddTask(interval, CronTask_spillColdAttributes, rm_free, ctx);
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// task context
+typedef struct {
+	uint32_t graph_idx;   // graph currently being swept
+	uint64_t entity_idx;  // next entity to sweep, nodes followed by edges
+	size_t released;      // bytes released during the current sweep
+} SpillColdAttributesCtx;
+
+// register the tiered storage sweep task
+// this is a no-op if tiered storage isn't enabled
+void CronTask_AddSpillColdAttributes(void);
+
+// cron task
+// spill cold attribute values of a batch of graph entities
+void CronTask_spillColdAttributes
+(
+	void *pdata  // task context
+);
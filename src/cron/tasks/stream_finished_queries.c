@@ -10,10 +10,14 @@
 #include "graph/graphcontext.h"
 #include "configuration/config.h"
 #include "util/circular_buffer.h"
+#include "queries_log/query_trace.h"
 #include "stream_finished_queries.h"
 
-// event fields count
-#define FLD_COUNT 9
+// number of fixed event fields
+#define FLD_FIXED_COUNT 9
+
+// event fields count, fixed fields followed by a field per query stage
+#define FLD_COUNT (FLD_FIXED_COUNT + QueryTrace_COUNT)
 
 // field names
 #define FLD_WRITE                    "Write"
@@ -96,6 +100,15 @@ static void _initEventTemplate
 					FLD_TIMEOUT,
 					strlen(FLD_TIMEOUT)
 				 );
+
+	// query stages, e.g. "Lock wait time"
+	for(int i = 0; i < QueryTrace_COUNT; i++) {
+		char buff[64];
+		int l = snprintf(buff, sizeof(buff), "%s time",
+				QueryTrace_StageName(i));
+		_event[(FLD_FIXED_COUNT + i) * 2] =
+			RedisModule_CreateString(ctx, buff, l);
+	}
 }
 
 // populate event
@@ -142,6 +155,13 @@ static void _populateEvent
 
 	// FLD_TIMEOUT
 	_event[17] = RedisModule_CreateStringFromLongLong(ctx, q->timeout);
+
+	// query stages
+	for(int i = 0; i < QueryTrace_COUNT; i++) {
+		l = sprintf(buff, "%.6f", q->stage_durations[i]);
+		_event[(FLD_FIXED_COUNT + i) * 2 + 1] =
+			RedisModule_CreateString(ctx, buff, l);
+	}
 }
 
 // free event values
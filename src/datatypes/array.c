@@ -201,6 +201,20 @@ SIValue SIArray_FromBinary
 	return arr;
 }
 
+size_t SIArray_MemoryUsage
+(
+	SIValue siarray  // array to inspect
+) {
+	size_t n = array_sizeof(array_hdr(siarray.array));
+
+	uint arrayLen = SIArray_Length(siarray);
+	for(uint i = 0; i < arrayLen; i++) {
+		n += SIValue_MemoryUsage(siarray.array[i]);
+	}
+
+	return n;
+}
+
 void SIArray_Free(SIValue siarray) {
 	uint arrayLen = SIArray_Length(siarray);
 	for(uint i = 0; i < arrayLen; i++) {
@@ -106,6 +106,12 @@ SIValue SIArray_FromBinary
 	FILE *stream  // stream containing binary representation of an array
 );
 
+// returns number of heap bytes used by array, including its elements
+size_t SIArray_MemoryUsage
+(
+	SIValue siarray  // array to inspect
+);
+
 /**
   * @brief  delete an array
   * @param  siarray:
@@ -5,12 +5,14 @@
  */
 
 #include <stdio.h>
+#include <ctype.h>
 #include <signal.h>
 #include <pthread.h>
 #include <sys/types.h>
 #include "RG.h"
 #include "globals.h"
 #include "util/thpool/pools.h"
+#include "commands/commands.h"
 #include "commands/cmd_context.h"
 
 static struct sigaction old_act;
@@ -40,13 +42,68 @@ static void logCommands(void) {
 	}
 }
 
+// report module wide latency percentiles of each query command
+// durations are reported in milliseconds
+static void _InfoLatency
+(
+	RedisModuleInfoCtx *ctx
+) {
+	// metric field name suffixes
+	static const char *metrics[LatencyMetric_COUNT] = {
+		[LatencyMetric_TOTAL] = "latency",
+		[LatencyMetric_QUEUE] = "queue_wait",
+		[LatencyMetric_LOCK]  = "lock_wait",
+		[LatencyMetric_REPLY] = "reply_time",
+	};
+
+	RedisModule_InfoAddSection(ctx, "latency");
+
+	HdrHistogram *h = rm_malloc(sizeof(HdrHistogram));
+
+	for(int i = 0; i < CMD_COUNT; i++) {
+		LatencyStats stats = Commands_GetLatencyStats(i);
+		if(stats == NULL) continue;
+
+		// e.g. "graph_ro_query"
+		char cmd[32];
+		const char *name = CommandToString(i);
+		int l = 0;
+		for(; name[l] != '\0' && l < sizeof(cmd) - 1; l++) {
+			cmd[l] = (name[l] == '.') ? '_' : tolower(name[l]);
+		}
+		cmd[l] = '\0';
+
+		for(int j = 0; j < LatencyMetric_COUNT; j++) {
+			LatencyStats_Get(stats, j, h);
+
+			// e.g. "graph_query_lock_wait:calls=10,p50=0.01,p99=0.02,p999=0.02"
+			char field[64];
+			snprintf(field, sizeof(field), "%s_%s", cmd, metrics[j]);
+
+			RedisModule_InfoBeginDictField(ctx, field);
+			RedisModule_InfoAddFieldULongLong(ctx, "calls", h->count);
+			RedisModule_InfoAddFieldDouble(ctx, "p50",
+					HdrHistogram_Percentile(h, 0.5) / 1000.0);
+			RedisModule_InfoAddFieldDouble(ctx, "p99",
+					HdrHistogram_Percentile(h, 0.99) / 1000.0);
+			RedisModule_InfoAddFieldDouble(ctx, "p999",
+					HdrHistogram_Percentile(h, 0.999) / 1000.0);
+			RedisModule_InfoEndDictField(ctx);
+		}
+	}
+
+	rm_free(h);
+}
+
 void InfoFunc
 (
 	RedisModuleInfoCtx *ctx,
 	int for_crash_report
 ) {
-	// make sure information is requested for crash report
-	if(!for_crash_report) return;
+	if(!for_crash_report) {
+		_InfoLatency(ctx);
+		return;
+	}
 
 	// pause all working threads
 	// NOTE: pausing is not an atomic action;
@@ -28,6 +28,11 @@ struct _EffectsBuffer {
 	struct EffectsBufferBlock *head;     // first block
 	struct EffectsBufferBlock *current;  // current block
 	uint64_t n;                          // number of effects in buffer
+	EffectType run_type;                 // type of open creation run
+	unsigned char *run_count;            // location of open run's entity count
+	uint32_t run_len;                    // number of entities in open run
+	RelationID run_rel;                  // relationship type of open edge run
+	LabelID *run_labels;                 // labels of open node run
 };
 
 // forward declarations
@@ -117,6 +122,44 @@ static void EffectsBuffer_WriteBytes
 	}
 }
 
+// reserve n contiguous bytes within effects-buffer
+// returns a pointer to the reserved bytes
+static unsigned char *EffectsBuffer_Reserve
+(
+	size_t n,          // number of bytes to reserve
+	EffectsBuffer *eb  // effects-buffer
+) {
+	ASSERT(eb != NULL);
+	ASSERT(n <= eb->block_size);
+
+	if(BLOCK_AVAILABLE_SPACE(eb->current) < n) {
+		EffectsBuffer_AddBlock(eb);
+	}
+
+	unsigned char *ptr = eb->current->offset;
+	eb->current->offset += n;
+
+	return ptr;
+}
+
+// write unsigned integer as a varint
+static void EffectsBuffer_WriteVarint
+(
+	uint64_t v,        // value to write
+	EffectsBuffer *eb  // effects-buffer
+) {
+	unsigned char buf[10];
+	size_t n = 0;
+
+	while(v >= 0x80) {
+		buf[n++] = (v & 0x7F) | 0x80;
+		v >>= 7;
+	}
+	buf[n++] = v;
+
+	EffectsBuffer_WriteBytes(buf, n, eb);
+}
+
 static void EffectsBuffer_WriteString
 (
 	const char *str,
@@ -125,9 +168,43 @@ static void EffectsBuffer_WriteString
 	ASSERT(eb  != NULL);
 	ASSERT(str != NULL);
 
-	size_t l = strlen(str) + 1;
-	EffectsBuffer_WriteBytes(&l, sizeof(size_t), eb);
-	EffectsBuffer_WriteBytes(str, l, eb);
+	size_t l = strlen(str);
+	EffectsBuffer_WriteVarint(l, eb);
+	if(l > 0) EffectsBuffer_WriteBytes(str, l, eb);
+}
+
+// write effect type, closing any open creation run
+static void EffectsBuffer_WriteEffectType
+(
+	EffectType t,      // effect type
+	EffectsBuffer *eb  // effects-buffer
+) {
+	eb->run_type = EFFECT_UNKNOWN;
+
+	uint8_t _t = t;
+	EffectsBuffer_WriteBytes(&_t, sizeof(_t), eb);
+}
+
+// open a new creation run, reserving room for its entity count
+static void EffectsBuffer_OpenRun
+(
+	EffectType t,      // type of run
+	EffectsBuffer *eb  // effects-buffer
+) {
+	eb->run_type  = t;
+	eb->run_len   = 0;
+	eb->run_count = EffectsBuffer_Reserve(sizeof(uint32_t), eb);
+}
+
+// add an entity to the open creation run
+static void EffectsBuffer_ExtendRun
+(
+	EffectsBuffer *eb  // effects-buffer
+) {
+	ASSERT(eb->run_type != EFFECT_UNKNOWN);
+
+	eb->run_len++;
+	memcpy(eb->run_count, &eb->run_len, sizeof(uint32_t));
 }
 
 // writes a binary representation of v into Effect-Buffer
@@ -142,42 +219,50 @@ static void EffectsBuffer_WriteSIValue
 	// format:
 	//    type
 	//    value
-	bool b;
-	size_t len = 0;
-
-	SIType t = v->type;
-
-	// write type
-	EffectsBuffer_WriteBytes(&t, sizeof(SIType), buff);
+	uint8_t t;
+	uint64_t zigzag;
 
 	// write value
-	switch(t) {
+	switch(v->type) {
 		case T_POINT:
 			// write value to stream
+			t = EFFECT_VALUE_POINT;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 			EffectsBuffer_WriteBytes(&v->point, sizeof(Point), buff);
 			break;
 		case T_ARRAY:
 			// write array to stream
+			t = EFFECT_VALUE_ARRAY;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 			EffectsBuffer_WriteSIArray(v, buff);
 			break;
 		case T_STRING:
+			t = EFFECT_VALUE_STRING;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 			EffectsBuffer_WriteString(v->stringval, buff);
 			break;
 		case T_BOOL:
-			// write bool to stream
-			b = SIValue_IsTrue(*v);
-			EffectsBuffer_WriteBytes(&b, sizeof(bool), buff);
+			// value is encoded within type
+			t = SIValue_IsTrue(*v) ? EFFECT_VALUE_TRUE : EFFECT_VALUE_FALSE;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 			break;
 		case T_INT64:
-			// write int to stream
-			EffectsBuffer_WriteBytes(&v->longval, sizeof(v->longval), buff);
+			// zigzag encoding keeps small negative numbers short
+			t = EFFECT_VALUE_INT64;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+			zigzag = ((uint64_t)v->longval << 1) ^ (uint64_t)(v->longval >> 63);
+			EffectsBuffer_WriteVarint(zigzag, buff);
 			break;
 		case T_DOUBLE:
 			// write double to stream
+			t = EFFECT_VALUE_DOUBLE;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 			EffectsBuffer_WriteBytes(&v->doubleval, sizeof(v->doubleval), buff);
 			break;
 		case T_NULL:
 			// no additional data is required to represent NULL
+			t = EFFECT_VALUE_NULL;
+			EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
 			break;
 		default:
 			assert(false && "unknown SIValue type");
@@ -198,7 +283,7 @@ static void EffectsBuffer_WriteSIArray
 	uint32_t len = array_len(elements);
 
 	// write number of elements
-	EffectsBuffer_WriteBytes(&len, sizeof(uint32_t), buff);
+	EffectsBuffer_WriteVarint(len, buff);
 
 	// write each element
 	for (uint32_t i = 0; i < len; i++) {
@@ -217,7 +302,7 @@ static void EffectsBuffer_WriteAttributeSet
 	//--------------------------------------------------------------------------
 
 	ushort attr_count = AttributeSet_Count(attrs);
-	EffectsBuffer_WriteBytes(&attr_count, sizeof(attr_count), buff);
+	EffectsBuffer_WriteVarint(attr_count, buff);
 
 	//--------------------------------------------------------------------------
 	// write attributes
@@ -229,7 +314,9 @@ static void EffectsBuffer_WriteAttributeSet
 		SIValue attr = AttributeSet_GetIdx(attrs, i, &attr_id);
 
 		// write attribute ID
-		EffectsBuffer_WriteBytes(&attr_id, sizeof(Attribute_ID), buff);
+		// attribute IDs index the graph's attribute names
+		// introduced by EFFECT_ADD_ATTRIBUTE
+		EffectsBuffer_WriteVarint(attr_id, buff);
 
 		// write attribute value
 		EffectsBuffer_WriteSIValue(&attr, buff);
@@ -259,6 +346,11 @@ EffectsBuffer *EffectsBuffer_New
 	eb->head       = b;
 	eb->current    = b;
 	eb->block_size = n;
+	eb->run_type   = EFFECT_UNKNOWN;
+	eb->run_count  = NULL;
+	eb->run_len    = 0;
+	eb->run_rel    = GRAPH_NO_RELATION;
+	eb->run_labels = array_new(LabelID, 0);
 
 	// write effects version to newly created buffer
 	uint8_t v = EFFECTS_VERSION;
@@ -335,31 +427,46 @@ void EffectsBuffer_AddCreateNodeEffect
 	// effect type
 	// label count
 	// labels
-	// attribute count
-	// attributes (id,value) pair
+	// node count
+	// for each node:
+	//    attribute count
+	//    attributes (id,value) pair
 	//--------------------------------------------------------------------------
 	
 	ResultSetStatistics *stats = QueryCtx_GetResultSetStatistics();
 	stats->nodes_created++;
 	stats->properties_set += AttributeSet_Count(*n->attributes);
 
-	EffectType t = EFFECT_CREATE_NODE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	// nodes sharing the labels of the previous created node join its run
+	bool extend = (buff->run_type == EFFECT_CREATE_NODE &&
+			array_len(buff->run_labels) == label_count &&
+			(label_count == 0 ||
+			 memcmp(buff->run_labels, labels, sizeof(LabelID) * label_count) == 0));
 
-	//--------------------------------------------------------------------------
-	// write label count
-	//--------------------------------------------------------------------------
+	if(!extend) {
+		EffectsBuffer_WriteEffectType(EFFECT_CREATE_NODE, buff);
 
-	EffectsBuffer_WriteBytes(&label_count, sizeof(label_count), buff);
+		//----------------------------------------------------------------------
+		// write label count
+		//----------------------------------------------------------------------
 
-	//--------------------------------------------------------------------------
-	// write labels
-	//--------------------------------------------------------------------------
+		EffectsBuffer_WriteVarint(label_count, buff);
+
+		//----------------------------------------------------------------------
+		// write labels
+		//----------------------------------------------------------------------
 
-	if(label_count > 0) {
-		EffectsBuffer_WriteBytes(labels, sizeof(LabelID) * label_count, buff);
+		array_clear(buff->run_labels);
+		for(ushort i = 0; i < label_count; i++) {
+			EffectsBuffer_WriteVarint(labels[i], buff);
+			array_append(buff->run_labels, labels[i]);
+		}
+
+		EffectsBuffer_OpenRun(EFFECT_CREATE_NODE, buff);
 	}
 
+	EffectsBuffer_ExtendRun(buff);
+
 	//--------------------------------------------------------------------------
 	// write attribute set
 	//--------------------------------------------------------------------------
@@ -379,44 +486,47 @@ void EffectsBuffer_AddCreateEdgeEffect
 	//--------------------------------------------------------------------------
 	// effect format:
 	// effect type
-	// relationship count
-	// relationships
-	// src node ID
-	// dest node ID
-	// attribute count
-	// attributes (id,value) pair
+	// relationship type
+	// edge count
+	// for each edge:
+	//    src node ID
+	//    dest node ID
+	//    attribute count
+	//    attributes (id,value) pair
 	//--------------------------------------------------------------------------
 	
 	ResultSetStatistics *stats = QueryCtx_GetResultSetStatistics();
 	stats->relationships_created++;
 	stats->properties_set += AttributeSet_Count(*edge->attributes);
 
-	EffectType t = EFFECT_CREATE_EDGE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	// edges sharing the type of the previous created edge join its run
+	RelationID rel_id = Edge_GetRelationID(edge);
+	if(buff->run_type != EFFECT_CREATE_EDGE || buff->run_rel != rel_id) {
+		EffectsBuffer_WriteEffectType(EFFECT_CREATE_EDGE, buff);
 
-	//--------------------------------------------------------------------------
-	// write relationship type
-	//--------------------------------------------------------------------------
+		//----------------------------------------------------------------------
+		// write relationship type
+		//----------------------------------------------------------------------
 
-	ushort rel_count = 1;
-	EffectsBuffer_WriteBytes(&rel_count, sizeof(rel_count), buff);
+		EffectsBuffer_WriteVarint(rel_id, buff);
 
-	RelationID rel_id = Edge_GetRelationID(edge);
-	EffectsBuffer_WriteBytes(&rel_id, sizeof(RelationID), buff);
+		EffectsBuffer_OpenRun(EFFECT_CREATE_EDGE, buff);
+		buff->run_rel = rel_id;
+	}
+
+	EffectsBuffer_ExtendRun(buff);
 
 	//--------------------------------------------------------------------------
 	// write src node ID
 	//--------------------------------------------------------------------------
 	
-	NodeID src_id = Edge_GetSrcNodeID(edge);
-	EffectsBuffer_WriteBytes(&src_id, sizeof(NodeID), buff);
+	EffectsBuffer_WriteVarint(Edge_GetSrcNodeID(edge), buff);
 
 	//--------------------------------------------------------------------------
 	// write dest node ID
 	//--------------------------------------------------------------------------
 
-	NodeID dest_id = Edge_GetDestNodeID(edge);
-	EffectsBuffer_WriteBytes(&dest_id, sizeof(NodeID), buff);
+	EffectsBuffer_WriteVarint(Edge_GetDestNodeID(edge), buff);
 
 	//--------------------------------------------------------------------------
 	// write attribute set 
@@ -442,11 +552,10 @@ void EffectsBuffer_AddDeleteNodeEffect
 
 	QueryCtx_GetResultSetStatistics()->nodes_deleted++;
 
-	EffectType t = EFFECT_DELETE_NODE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsBuffer_WriteEffectType(EFFECT_DELETE_NODE, buff);
 
 	// write node ID
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(node), sizeof(EntityID), buff);
+	EffectsBuffer_WriteVarint(ENTITY_GET_ID(node), buff);
 
 	EffectsBuffer_IncEffectCount(buff);
 }
@@ -468,19 +577,12 @@ void EffectsBuffer_AddDeleteEdgeEffect
 
 	QueryCtx_GetResultSetStatistics()->relationships_deleted++;
 
-	EffectType t = EFFECT_DELETE_EDGE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), eb);
-
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(edge), sizeof(EntityID), eb);
+	EffectsBuffer_WriteEffectType(EFFECT_DELETE_EDGE, eb);
 
-	RelationID r_id = Edge_GetRelationID(edge);
-	EffectsBuffer_WriteBytes(&r_id, sizeof(RelationID), eb);
-
-	NodeID src_id = Edge_GetSrcNodeID(edge);
-	EffectsBuffer_WriteBytes(&src_id, sizeof(EntityID), eb);
-
-	NodeID dest_id = Edge_GetDestNodeID(edge);
-	EffectsBuffer_WriteBytes(&dest_id, sizeof(EntityID), eb);
+	EffectsBuffer_WriteVarint(ENTITY_GET_ID(edge), eb);
+	EffectsBuffer_WriteVarint(Edge_GetRelationID(edge), eb);
+	EffectsBuffer_WriteVarint(Edge_GetSrcNodeID(edge), eb);
+	EffectsBuffer_WriteVarint(Edge_GetDestNodeID(edge), eb);
 
 	EffectsBuffer_IncEffectCount(eb);
 };
@@ -501,20 +603,19 @@ static void EffectsBuffer_AddNodeUpdateEffect
 	//    attribute value
 	//--------------------------------------------------------------------------
 
-	EffectType t = EFFECT_UPDATE_NODE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsBuffer_WriteEffectType(EFFECT_UPDATE_NODE, buff);
 
 	//--------------------------------------------------------------------------
 	// write entity ID
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(node), sizeof(EntityID), buff);
+	EffectsBuffer_WriteVarint(ENTITY_GET_ID(node), buff);
 
 	//--------------------------------------------------------------------------
 	// write attribute ID
 	//--------------------------------------------------------------------------
 	
-	EffectsBuffer_WriteBytes(&attr_id, sizeof(Attribute_ID), buff);
+	EffectsBuffer_WriteVarint(attr_id, buff);
 
 	//--------------------------------------------------------------------------
 	// write attribute value
@@ -544,41 +645,37 @@ static void EffectsBuffer_AddEdgeUpdateEffect
 	//    attributes (id,value) pair
 	//--------------------------------------------------------------------------
 
-	EffectType t = EFFECT_UPDATE_EDGE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsBuffer_WriteEffectType(EFFECT_UPDATE_EDGE, buff);
 
 	//--------------------------------------------------------------------------
 	// write edge ID
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(edge), sizeof(EntityID), buff);
+	EffectsBuffer_WriteVarint(ENTITY_GET_ID(edge), buff);
 
 	//--------------------------------------------------------------------------
 	// write relation ID
 	//--------------------------------------------------------------------------
 
-	RelationID r = Edge_GetRelationID(edge);
-	EffectsBuffer_WriteBytes(&r, sizeof(RelationID), buff);
+	EffectsBuffer_WriteVarint(Edge_GetRelationID(edge), buff);
 
 	//--------------------------------------------------------------------------
 	// write src ID
 	//--------------------------------------------------------------------------
 
-	NodeID s = Edge_GetSrcNodeID(edge);
-	EffectsBuffer_WriteBytes(&s, sizeof(NodeID), buff);
+	EffectsBuffer_WriteVarint(Edge_GetSrcNodeID(edge), buff);
 
 	//--------------------------------------------------------------------------
 	// write dest ID
 	//--------------------------------------------------------------------------
 
-	NodeID d = Edge_GetDestNodeID(edge);
-	EffectsBuffer_WriteBytes(&d, sizeof(NodeID), buff);
+	EffectsBuffer_WriteVarint(Edge_GetDestNodeID(edge), buff);
 
 	//--------------------------------------------------------------------------
 	// write attribute ID
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&attr_id, sizeof(Attribute_ID), buff);
+	EffectsBuffer_WriteVarint(attr_id, buff);
 
 	//--------------------------------------------------------------------------
 	// write attribute value
@@ -669,16 +766,18 @@ void EffectsBuffer_AddSetRemoveLabelsEffect
 	//    label IDs
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsBuffer_WriteEffectType(t, buff);
 
 	// write node ID
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(node), sizeof(EntityID), buff); 
+	EffectsBuffer_WriteVarint(ENTITY_GET_ID(node), buff);
 	
 	// write labels count
-	EffectsBuffer_WriteBytes(&lbl_count, sizeof(lbl_count), buff); 
+	EffectsBuffer_WriteVarint(lbl_count, buff);
 	
 	// write label IDs
-	EffectsBuffer_WriteBytes(lbl_ids, sizeof(LabelID) * lbl_count, buff);
+	for(uint8_t i = 0; i < lbl_count; i++) {
+		EffectsBuffer_WriteVarint(lbl_ids[i], buff);
+	}
 
 	EffectsBuffer_IncEffectCount(buff);
 }
@@ -745,14 +844,13 @@ void EffectsBuffer_AddNewSchemaEffect
 	//    schema name
 	//--------------------------------------------------------------------------
 
-	EffectType t = EFFECT_ADD_SCHEMA;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsBuffer_WriteEffectType(EFFECT_ADD_SCHEMA, buff);
 
 	//--------------------------------------------------------------------------
 	// write schema type
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&st, sizeof(st), buff);
+	EffectsBuffer_WriteVarint(st, buff);
 
 	//--------------------------------------------------------------------------
 	// write schema name
@@ -775,8 +873,7 @@ void EffectsBuffer_AddNewAttributeEffect
 	// attribute name
 	//--------------------------------------------------------------------------
 
-	EffectType t = EFFECT_ADD_ATTRIBUTE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsBuffer_WriteEffectType(EFFECT_ADD_ATTRIBUTE, buff);
 
 	//--------------------------------------------------------------------------
 	// write attribute name
@@ -809,6 +906,7 @@ void EffectsBuffer_Free
 		b = next;
 	}
 
+	array_free(eb->run_labels);
 	rm_free(eb);
 }
 
@@ -8,7 +8,8 @@
 
 #include "../graph/graphcontext.h"
 
-#define EFFECTS_VERSION 1  // current effects encoding/decoding version
+#define EFFECTS_VERSION 2  // current effects encoding/decoding version
+#define EFFECTS_VERSION_V1 1  // previous effects encoding, still decoded
 
 // EffectsBuffer is an opaque data structure
 typedef struct _EffectsBuffer EffectsBuffer;
@@ -28,6 +29,32 @@ typedef enum {
 	EFFECT_ADD_ATTRIBUTE,  // add attribute
 } EffectType;
 
+// encoding format (version 2)
+//
+// effect types are encoded as a single byte
+// IDs, counts and lengths are encoded as varints, 7 bits per byte
+// least significant group first, the MSB of each byte marks continuation
+//
+// consecutive creations of nodes sharing the same labels and of edges
+// sharing the same relationship type are grouped into a single run:
+//    effect type
+//    labels / relationship type
+//    number of entities in run (uint32)
+//    entities
+// replicas apply each run as a single bulk creation
+
+// types of encoded values
+typedef enum {
+	EFFECT_VALUE_NULL = 0,  // null
+	EFFECT_VALUE_FALSE,     // boolean false
+	EFFECT_VALUE_TRUE,      // boolean true
+	EFFECT_VALUE_INT64,     // zigzag encoded varint
+	EFFECT_VALUE_DOUBLE,    // 8 bytes double
+	EFFECT_VALUE_STRING,    // varint length followed by bytes
+	EFFECT_VALUE_POINT,     // latitude and longitude floats
+	EFFECT_VALUE_ARRAY,     // varint length followed by values
+} EffectValueType;
+
 //------------------------------------------------------------------------------
 // effects API
 //------------------------------------------------------------------------------
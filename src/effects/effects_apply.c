@@ -6,6 +6,8 @@
 
 #include "RG.h"
 #include "effects.h"
+#include "effects_v1.h"
+#include "../datatypes/array.h"
 #include "../graph/graph_hub.h"
 
 #include <stdio.h>
@@ -15,12 +17,98 @@ static inline EffectType ReadEffectType
 (
 	FILE *stream  // effects stream
 ) {
-	EffectType t = EFFECT_UNKNOWN;  // default to unknown effect type
+	uint8_t t = EFFECT_UNKNOWN;  // default to unknown effect type
 
 	// read EffectType off of stream
-	fread_assert(&t, sizeof(EffectType), stream);
+	fread_assert(&t, sizeof(t), stream);
 
-	return t;
+	return (EffectType)t;
+}
+
+// read varint from stream
+static uint64_t ReadVarint
+(
+	FILE *stream  // effects stream
+) {
+	uint64_t v = 0;
+
+	for(uint shift = 0; ; shift += 7) {
+		int c = fgetc(stream);
+		ASSERT(c != EOF);
+		ASSERT(shift < 64);
+
+		v |= (uint64_t)(c & 0x7F) << shift;
+		if((c & 0x80) == 0) break;
+	}
+
+	return v;
+}
+
+// read string from stream
+// returned string is NULL terminated and owned by the caller
+static char *ReadString
+(
+	FILE *stream  // effects stream
+) {
+	size_t l = ReadVarint(stream);
+	char *str = rm_malloc(sizeof(char) * (l + 1));
+	if(l > 0) fread_assert(str, l, stream);
+	str[l] = '\0';
+
+	return str;
+}
+
+// read value from stream
+static SIValue ReadSIValue
+(
+	FILE *stream  // effects stream
+) {
+	uint8_t  t;
+	double   d;
+	Point    p;
+	uint64_t zigzag;
+	uint64_t len;
+	SIValue  v;
+
+	fread_assert(&t, sizeof(t), stream);
+
+	switch(t) {
+		case EFFECT_VALUE_NULL:
+			v = SI_NullVal();
+			break;
+		case EFFECT_VALUE_FALSE:
+			v = SI_BoolVal(false);
+			break;
+		case EFFECT_VALUE_TRUE:
+			v = SI_BoolVal(true);
+			break;
+		case EFFECT_VALUE_INT64:
+			zigzag = ReadVarint(stream);
+			v = SI_LongVal((int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1));
+			break;
+		case EFFECT_VALUE_DOUBLE:
+			fread_assert(&d, sizeof(d), stream);
+			v = SI_DoubleVal(d);
+			break;
+		case EFFECT_VALUE_STRING:
+			v = SI_TransferStringVal(ReadString(stream));
+			break;
+		case EFFECT_VALUE_POINT:
+			fread_assert(&p, sizeof(p), stream);
+			v = SI_Point(p.latitude, p.longitude);
+			break;
+		case EFFECT_VALUE_ARRAY:
+			len = ReadVarint(stream);
+			v = SI_Array(len);
+			for(uint64_t i = 0; i < len; i++) {
+				array_append(v.array, ReadSIValue(stream));
+			}
+			break;
+		default:
+			assert(false && "unknown effect value type");
+	}
+
+	return v;
 }
 
 static AttributeSet ReadAttributeSet
@@ -37,8 +125,7 @@ static AttributeSet ReadAttributeSet
 	// read attribute count
 	//--------------------------------------------------------------------------
 
-	ushort attr_count;
-	fread_assert(&attr_count, sizeof(attr_count), stream);
+	ushort attr_count = ReadVarint(stream);
 
 	//--------------------------------------------------------------------------
 	// read attributes
@@ -49,10 +136,10 @@ static AttributeSet ReadAttributeSet
 
 	for(ushort i = 0; i < attr_count; i++) {
 		// read attribute ID
-		fread_assert(ids + i, sizeof(Attribute_ID), stream);
+		ids[i] = ReadVarint(stream);
 		
 		// read attribute value
-		values[i] = SIValue_FromBinary(stream);
+		values[i] = ReadSIValue(stream);
 	}
 
 	AttributeSet attr_set = NULL;
@@ -61,7 +148,9 @@ static AttributeSet ReadAttributeSet
 	return attr_set;
 }
 
-static void ApplyCreateNode
+// apply a run of node creations
+// all nodes in the run share the same labels and are created in bulk
+static void ApplyCreateNodes
 (
 	FILE *stream,     // effects stream
 	GraphContext *gc  // graph to operate on
@@ -70,97 +159,120 @@ static void ApplyCreateNode
 	// effect format:
 	// label count
 	// labels
-	// attribute count
-	// attributes (id,value) pair
+	// node count
+	// for each node:
+	//    attribute count
+	//    attributes (id,value) pair
 	//--------------------------------------------------------------------------
 
 	//--------------------------------------------------------------------------
-	// read label count
+	// read labels
 	//--------------------------------------------------------------------------
 
-	ushort lbl_count;
-	fread_assert(&lbl_count, sizeof(lbl_count), stream);
+	ushort lbl_count = ReadVarint(stream);
+	LabelID *labels = array_new(LabelID, lbl_count);
+	for(ushort i = 0; i < lbl_count; i++) {
+		array_append(labels, ReadVarint(stream));
+	}
 
 	//--------------------------------------------------------------------------
-	// read labels
+	// read node count
 	//--------------------------------------------------------------------------
 
-	LabelID labels[lbl_count];
-	for(ushort i = 0; i < lbl_count; i++) {
-		fread_assert(labels + i, sizeof(LabelID), stream);
-	}
+	uint32_t n;
+	fread_assert(&n, sizeof(n), stream);
+	ASSERT(n > 0);
 
 	//--------------------------------------------------------------------------
 	// read attributes
 	//--------------------------------------------------------------------------
 
-	AttributeSet attr_set = ReadAttributeSet(stream);
+	Node         *nodes       = rm_malloc(sizeof(Node) * n);
+	Node        **node_ptrs   = rm_malloc(sizeof(Node *) * n);
+	LabelID     **node_labels = rm_malloc(sizeof(LabelID *) * n);
+	AttributeSet *sets        = rm_malloc(sizeof(AttributeSet) * n);
+
+	for(uint32_t i = 0; i < n; i++) {
+		nodes[i]       = GE_NEW_NODE();
+		node_ptrs[i]   = nodes + i;
+		node_labels[i] = labels;
+		sets[i]        = ReadAttributeSet(stream);
+	}
 
 	//--------------------------------------------------------------------------
-	// create node
+	// create nodes
 	//--------------------------------------------------------------------------
 
-	Node n = GE_NEW_NODE();
-	CreateNode(gc, &n, labels, lbl_count, attr_set, false);
+	CreateNodes(gc, node_ptrs, node_labels, sets, n, false);
+
+	rm_free(sets);
+	rm_free(nodes);
+	rm_free(node_ptrs);
+	rm_free(node_labels);
+	array_free(labels);
 }
 
-static void ApplyCreateEdge
+// apply a run of edge creations
+// all edges in the run share the same relationship type and are created
+// in bulk, forming their connections in a single matrix update
+static void ApplyCreateEdges
 (
 	FILE *stream,     // effects stream
 	GraphContext *gc  // graph to operate on
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	// effect type
-	// relationship count
-	// relationships
-	// src node ID
-	// dest node ID
-	// attribute count
-	// attributes (id,value) pair
-	//--------------------------------------------------------------------------
-
-	//--------------------------------------------------------------------------
-	// read relationship type count
+	// relationship type
+	// edge count
+	// for each edge:
+	//    src node ID
+	//    dest node ID
+	//    attribute count
+	//    attributes (id,value) pair
 	//--------------------------------------------------------------------------
 
-	ushort rel_count;
-	fread_assert(&rel_count, sizeof(rel_count), stream);
-	ASSERT(rel_count == 1);
-
 	//--------------------------------------------------------------------------
 	// read relationship type
 	//--------------------------------------------------------------------------
 
-	RelationID r;
-	fread_assert(&r, sizeof(r), stream);
+	RelationID r = ReadVarint(stream);
 
 	//--------------------------------------------------------------------------
-	// read src node ID
+	// read edge count
 	//--------------------------------------------------------------------------
 
-	NodeID src_id;
-	fread_assert(&src_id, sizeof(NodeID), stream);
+	uint32_t n;
+	fread_assert(&n, sizeof(n), stream);
+	ASSERT(n > 0);
 
 	//--------------------------------------------------------------------------
-	// read dest node ID
+	// read edges
 	//--------------------------------------------------------------------------
 
-	NodeID dest_id;
-	fread_assert(&dest_id, sizeof(NodeID), stream);
+	Edge         *edges     = rm_malloc(sizeof(Edge) * n);
+	Edge        **edge_ptrs = rm_malloc(sizeof(Edge *) * n);
+	AttributeSet *sets      = rm_malloc(sizeof(AttributeSet) * n);
 
-	//--------------------------------------------------------------------------
-	// read attributes
-	//--------------------------------------------------------------------------
+	for(uint32_t i = 0; i < n; i++) {
+		Edge *e = edges + i;
+		*e = GE_NEW_LABELED_EDGE(NULL, r);
+
+		Edge_SetSrcNodeID(e, ReadVarint(stream));
+		Edge_SetDestNodeID(e, ReadVarint(stream));
 
-	AttributeSet attr_set = ReadAttributeSet(stream);
+		edge_ptrs[i] = e;
+		sets[i]      = ReadAttributeSet(stream);
+	}
 
 	//--------------------------------------------------------------------------
-	// create edge
+	// create edges
 	//--------------------------------------------------------------------------
 
-	Edge e;
-	CreateEdge(gc, &e, src_id, dest_id, r, attr_set, false);
+	CreateEdges(gc, edge_ptrs, sets, n, false);
+
+	rm_free(sets);
+	rm_free(edges);
+	rm_free(edge_ptrs);
 }
 
 static void ApplyLabels
@@ -181,8 +293,7 @@ static void ApplyLabels
 	// read node ID
 	//--------------------------------------------------------------------------
 
-	EntityID id;
-	fread_assert(&id, sizeof(id), stream);
+	EntityID id = ReadVarint(stream);
 
 	//--------------------------------------------------------------------------
 	// get updated node
@@ -198,8 +309,7 @@ static void ApplyLabels
 	// read labels count
 	//--------------------------------------------------------------------------
 
-	uint8_t lbl_count;
-	fread_assert(&lbl_count, sizeof(lbl_count), stream);
+	uint8_t lbl_count = ReadVarint(stream);
 	ASSERT(lbl_count > 0);
 
 	// TODO: move to LabelID
@@ -223,8 +333,7 @@ static void ApplyLabels
 	//--------------------------------------------------------------------------
 
 	for(ushort i = 0; i < lbl_count; i++) {
-		LabelID l;
-		fread_assert(&l, sizeof(LabelID), stream);
+		LabelID l = ReadVarint(stream);
 		Schema *s = GraphContext_GetSchemaByID(gc, l, SCHEMA_NODE);
 		ASSERT(s != NULL);
 		lbl[i] = Schema_GetName(s);
@@ -251,20 +360,15 @@ static void ApplyAddSchema
 	//--------------------------------------------------------------------------
 
 	// read schema type
-	SchemaType t;
-	fread_assert(&t, sizeof(t), stream);
+	SchemaType t = ReadVarint(stream);
 
 	// read schema name
-	// read string length
-	size_t l;
-	fread_assert(&l, sizeof(l), stream);
-
-	// read string
-	char schema_name[l];
-	fread_assert(schema_name, l, stream);
+	char *schema_name = ReadString(stream);
 
 	// create schema
 	AddSchema(gc, schema_name, t, false);
+
+	rm_free(schema_name);
 }
 
 static void ApplyAddAttribute
@@ -278,19 +382,16 @@ static void ApplyAddAttribute
 	// attribute name
 	//--------------------------------------------------------------------------
 	
-	// read attribute name length
-	size_t l;
-	fread_assert(&l, sizeof(l), stream);
-
 	// read attribute name
-	const char attr[l];
-	fread_assert(attr, l, stream);
+	char *attr = ReadString(stream);
 
 	// attr should not exist
 	ASSERT(GraphContext_GetAttributeID(gc, attr) == ATTRIBUTE_ID_NONE);
 
 	// add attribute
 	FindOrAddAttribute(gc, attr, false);
+
+	rm_free(attr);
 }
 
 // process Update_Edge effect
@@ -321,41 +422,41 @@ static void ApplyUpdateEdge
 	// read edge ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&id, sizeof(EntityID), stream);
+	id = ReadVarint(stream);
 	ASSERT(id != INVALID_ENTITY_ID);
 
 	//--------------------------------------------------------------------------
 	// read relation ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&r_id, sizeof(RelationID), stream);
+	r_id = ReadVarint(stream);
 	ASSERT(r_id >= 0);
 
 	//--------------------------------------------------------------------------
 	// read src ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&s_id, sizeof(NodeID), stream);
+	s_id = ReadVarint(stream);
 	ASSERT(s_id != INVALID_ENTITY_ID);
 
 	//--------------------------------------------------------------------------
 	// read dest ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&t_id, sizeof(NodeID), stream);
+	t_id = ReadVarint(stream);
 	ASSERT(t_id != INVALID_ENTITY_ID);
 
 	//--------------------------------------------------------------------------
 	// read attribute ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&attr_id, sizeof(Attribute_ID), stream);
+	attr_id = ReadVarint(stream);
 
 	//--------------------------------------------------------------------------
 	// read attribute value
 	//--------------------------------------------------------------------------
 
-	v = SIValue_FromBinary(stream);
+	v = ReadSIValue(stream);
 	ASSERT(SI_TYPE(v) & (SI_VALID_PROPERTY_VALUE | T_NULL));
 	ASSERT((attr_id != ATTRIBUTE_ID_ALL || SIValue_IsNull(v)) && attr_id != ATTRIBUTE_ID_NONE);
 
@@ -386,19 +487,19 @@ static void ApplyUpdateNode
 	// read node ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&id, sizeof(EntityID), stream);
+	id = ReadVarint(stream);
 
 	//--------------------------------------------------------------------------
 	// read attribute ID
 	//--------------------------------------------------------------------------
 
-	fread_assert(&attr_id, sizeof(Attribute_ID), stream);
+	attr_id = ReadVarint(stream);
 
 	//--------------------------------------------------------------------------
 	// read attribute ID
 	//--------------------------------------------------------------------------
 
-	v = SIValue_FromBinary(stream);
+	v = ReadSIValue(stream);
 	ASSERT(SI_TYPE(v) & (SI_VALID_PROPERTY_VALUE | T_NULL));
 	ASSERT((attr_id != ATTRIBUTE_ID_ALL || SIValue_IsNull(v)) && attr_id != ATTRIBUTE_ID_NONE);
 
@@ -421,7 +522,7 @@ static void ApplyDeleteNode
 	Graph *g = gc->g;  // graph to delete node from
 
 	// read node ID off of stream
-	fread_assert(&id, sizeof(EntityID), stream);
+	id = ReadVarint(stream);
 
 	// retrieve node from graph
 	int res = Graph_GetNode(g, id, &n);
@@ -458,16 +559,16 @@ static void ApplyDeleteEdge
 	Graph *g = gc->g;  // graph to delete edge from
 
 	// read edge ID
-	fread_assert(&id, sizeof(EntityID), stream);
+	id = ReadVarint(stream);
 
 	// read relation ID
-	fread_assert(&r_id, sizeof(RelationID), stream);
+	r_id = ReadVarint(stream);
 
 	// read src node ID
-	fread_assert(&s_id, sizeof(EntityID), stream);
+	s_id = ReadVarint(stream);
 
 	// read dest node ID
-	fread_assert(&t_id, sizeof(EntityID), stream);
+	t_id = ReadVarint(stream);
 
 	// get edge from the graph
 	res = Graph_GetEdge(g, id, (Edge*)&e);
@@ -482,55 +583,37 @@ static void ApplyDeleteEdge
 	DeleteEdges(gc, &e, 1, false);
 }
 
-// returns false in case of effect encode/decode version mismatch
-static bool ValidateVersion
+// read effects version
+// returns false if the version can't be decoded
+static bool ReadVersion
 (
-	FILE *stream  // effects stream
+	FILE *stream,  // effects stream
+	uint8_t *v     // [output] effects version
 ) {
+	ASSERT(v      != NULL);
 	ASSERT(stream != NULL);
 
 	// read version
-	uint8_t v;
-	fread_assert(&v, sizeof(uint8_t), stream);
+	fread_assert(v, sizeof(uint8_t), stream);
 
-	if(v != EFFECTS_VERSION) {
+	if(*v != EFFECTS_VERSION && *v != EFFECTS_VERSION_V1) {
 		// unexpected effects version
 		RedisModule_Log(NULL, "warning",
-				"GRAPH.EFFECT version mismatch expected: %d got: %d",
-				EFFECTS_VERSION, v);
+				"GRAPH.EFFECT unknown version expected: %d or %d got: %d",
+				EFFECTS_VERSION, EFFECTS_VERSION_V1, *v);
 		return false;
 	}
 
 	return true;
 }
 
-// applys effects encoded in buffer
-void Effects_Apply
+// apply effects encoded in the current version
+static void ApplyEffects
 (
-	GraphContext *gc,          // graph to operate on
-	const char *effects_buff,  // encoded effects
-	size_t l                   // size of buffer
+	FILE *stream,      // effects stream, positioned past the version
+	GraphContext *gc,  // graph to operate on
+	size_t l           // size of stream
 ) {
-	// validations
-	ASSERT(l > 0);  // buffer can't be empty
-	ASSERT(effects_buff != NULL);  // buffer can't be NULL
-
-	// read buffer in a stream fashion
-	FILE *stream = fmemopen((void*)effects_buff, l, "r");
-
-	// validate effects version
-	if(ValidateVersion(stream) == false) {
-		// replica/primary out of sync
-		exit(1);
-	}
-
-	// lock graph for writing
-	Graph *g = GraphContext_GetGraph(gc);
-	Graph_AcquireWriteLock(g);
-
-	// update graph sync policy
-	MATRIX_POLICY policy = Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
-
 	// as long as there's data in stream
 	while(ftell(stream) < l) {
 		// read effect type
@@ -549,10 +632,10 @@ void Effects_Apply
 				ApplyUpdateEdge(stream, gc);
 				break;
 			case EFFECT_CREATE_NODE:    
-				ApplyCreateNode(stream, gc);
+				ApplyCreateNodes(stream, gc);
 				break;
 			case EFFECT_CREATE_EDGE:
-				ApplyCreateEdge(stream, gc);
+				ApplyCreateEdges(stream, gc);
 				break;
 			case EFFECT_SET_LABELS:
 				ApplyLabels(stream, gc, true);
@@ -571,6 +654,43 @@ void Effects_Apply
 				break;
 		}
 	}
+}
+
+// applys effects encoded in buffer
+void Effects_Apply
+(
+	GraphContext *gc,          // graph to operate on
+	const char *effects_buff,  // encoded effects
+	size_t l                   // size of buffer
+) {
+	// validations
+	ASSERT(l > 0);  // buffer can't be empty
+	ASSERT(effects_buff != NULL);  // buffer can't be NULL
+
+	// read buffer in a stream fashion
+	FILE *stream = fmemopen((void*)effects_buff, l, "r");
+
+	// validate effects version
+	// buffers of the previous version are still decoded, e.g. when replaying
+	// an AOF or when replicating from a primary yet to be upgraded
+	uint8_t v;
+	if(ReadVersion(stream, &v) == false) {
+		// replica/primary out of sync
+		exit(1);
+	}
+
+	// lock graph for writing
+	Graph *g = GraphContext_GetGraph(gc);
+	Graph_AcquireWriteLock(g);
+
+	// update graph sync policy
+	MATRIX_POLICY policy = Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
+
+	if(v == EFFECTS_VERSION_V1) {
+		Effects_Apply_v1(stream, gc, l);
+	} else {
+		ApplyEffects(stream, gc, l);
+	}
 
 	// restore graph sync policy
 	Graph_SetMatrixPolicy(g, policy);
@@ -0,0 +1,20 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "effects.h"
+
+#include <stdio.h>
+
+// apply effects encoded in version 1
+// the caller validated the version and holds the graph's write lock
+void Effects_Apply_v1
+(
+	FILE *stream,      // effects stream, positioned past the version
+	GraphContext *gc,  // graph to operate on
+	size_t l           // size of stream
+);
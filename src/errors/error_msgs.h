@@ -106,6 +106,13 @@
 #define EMSG_FULLTEXT_FIELD_TYPE "Field argument must be string or map"
 #define EMSG_FULLTEXT_DROP_INDEX "ERR Unable to drop index on :%s: no such index."
 #define EMSG_REDISEARCH "RediSearch: %s"
+#define EMSG_VECTOR_CONFIG_TYPE "Vector index configuration must be a map"
+#define EMSG_VECTOR_SIMILARITY "Similarity function must be one of 'euclidean', 'cosine' or 'ip'"
+#define EMSG_VECTOR_RANGE "%s must be an integer between %d and %d"
+#define EMSG_VECTOR_NO_INDEX "There is no vector index on :%s(%s)"
+#define EMSG_VECTOR_QUERY_TYPE "Query vector must be an array of %u numbers"
+#define EMSG_VECTOR_QUERY_K "k must be an integer between 0 and %u"
+#define EMSG_VECTOR_DROP_INDEX "ERR Unable to drop vector index on :%s: no such index."
 #define EMSG_MANDATORY_CONSTRAINT_VIOLATION_NODE "mandatory constraint violation: node with label %s missing property %s"
 #define EMSG_MANDATORY_CONSTRAINT_VIOLATION_EDGE "mandatory constraint violation: edge with relationship-type %s missing property %s";
 #define EMSG_UNIQUE_CONSTRAINT_VIOLATION_NODE "unique constraint violation on node of type %s"
@@ -117,3 +124,12 @@
 #define EMSG_SSPATH_INVALID_TYPE "sourceNode must be of type Node"
 #define EMSG_INDEX_SUPPORT_CONSTRAINTS "Index supports constraint"
 #define EMSG_QUERY_MEM_CONSUMPTION "Query's mem consumption exceeded capacity"
+#define EMSG_QUERY_MEM_CONSUMPTION_OWNER "Query's mem consumption exceeded capacity in operation %s"
+#define EMSG_LOAD_CSV_FIELD_TERMINATOR "LOAD CSV field terminator must be a single character"
+#define EMSG_LOAD_CSV_URL "LOAD CSV expects a 'file:///' URL string"
+#define EMSG_LOAD_CSV_PATH "LOAD CSV cannot access '%s' outside of the import folder"
+#define EMSG_LOAD_CSV_OPEN "LOAD CSV failed to open '%s': %s"
+#define EMSG_LOAD_CSV_MALFORMED "LOAD CSV encountered a malformed row in '%s', row %zu"
+#define EMSG_PERIODIC_COMMIT_LOAD_CSV "USING PERIODIC COMMIT can only be used with LOAD CSV"
+#define EMSG_PERIODIC_COMMIT_BATCH "USING PERIODIC COMMIT batch size must be a positive integer"
+#define EMSG_PERIODIC_COMMIT_CREATE "USING PERIODIC COMMIT requires LOAD CSV rows to stream directly into CREATE"
@@ -13,6 +13,7 @@
 #include "../errors/errors.h"
 #include "./optimizations/optimizer.h"
 #include "../ast/ast_build_filter_tree.h"
+#include "execution_plan_build/execution_plan_util.h"
 #include "execution_plan_build/execution_plan_modify.h"
 #include "execution_plan_build/execution_plan_construct.h"
 
@@ -347,6 +348,33 @@ static inline void _implicit_result(ExecutionPlan *plan) {
 	}
 }
 
+// apply USING PERIODIC COMMIT batch size to LOAD CSV operations
+static void _periodic_commit
+(
+	ExecutionPlan *plan,
+	const AST *ast
+) {
+	uint noptions = cypher_ast_query_noptions(ast->root);
+	for(uint i = 0; i < noptions; i++) {
+		const cypher_astnode_t *option = cypher_ast_query_get_option(ast->root, i);
+		if(cypher_astnode_type(option) != CYPHER_AST_USING_PERIODIC_COMMIT) {
+			continue;
+		}
+
+		const cypher_astnode_t *limit =
+			cypher_ast_using_periodic_commit_get_limit(option);
+		uint64_t batch_size = (limit != NULL) ? AST_ParseIntegerNode(limit) :
+			PERIODIC_COMMIT_BATCH_SIZE_DEFAULT;
+
+		OpBase **ops = ExecutionPlan_CollectOps(plan->root, OPType_LOAD_CSV);
+		uint op_count = array_len(ops);
+		for(uint j = 0; j < op_count; j++) {
+			LoadCSVOp_SetBatchSize((OpLoadCSV *)ops[j], batch_size);
+		}
+		array_free(ops);
+	}
+}
+
 ExecutionPlan *ExecutionPlan_FromTLS_AST(void) {
 	AST *ast = QueryCtx_GetAST();
 
@@ -367,6 +395,9 @@ ExecutionPlan *ExecutionPlan_FromTLS_AST(void) {
 	// or CALL clause
 	_implicit_result(plan);
 
+	// batch LOAD CSV rows if the query commits periodically
+	_periodic_commit(plan, ast);
+
 	// clean up
 	array_free(segments);
 
@@ -490,9 +521,8 @@ void ExecutionPlan_Drain(ExecutionPlan *plan) {
 static void _ExecutionPlan_InitProfiling(OpBase *root) {
 	root->profile = root->consume;
 	root->consume = OpBase_Profile;
-	root->stats = rm_malloc(sizeof(OpStats));
-	root->stats->profileExecTime = 0;
-	root->stats->profileRecordCount = 0;
+	root->stats = rm_calloc(1, sizeof(OpStats));
+	root->stats->profileMem.owner = root->name;
 
 	if(root->childCount) {
 		for(int i = 0; i < root->childCount; i++) {
@@ -515,7 +545,12 @@ static void _ExecutionPlan_FinalizeProfiling(OpBase *root) {
 
 ResultSet *ExecutionPlan_Profile(ExecutionPlan *plan) {
 	_ExecutionPlan_InitProfiling(plan->root);
+
+	// attribute allocations to the operation performing them
+	rm_alloc_stats_enable();
 	ResultSet *rs = ExecutionPlan_Execute(plan);
+	rm_alloc_stats_disable();
+
 	_ExecutionPlan_FinalizeProfiling(plan->root);
 	return rs;
 }
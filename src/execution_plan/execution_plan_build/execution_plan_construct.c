@@ -170,6 +170,16 @@ static inline void _buildUnwindOp(ExecutionPlan *plan, const cypher_astnode_t *c
 	ExecutionPlan_UpdateRoot(plan, op);
 }
 
+static inline void _buildLoadCSVOp
+(
+	ExecutionPlan *plan,
+	const cypher_astnode_t *clause
+) {
+	AST_LoadCSVContext ctx = AST_PrepareLoadCSVOp(clause);
+	OpBase *op = NewLoadCSVOp(plan, ctx.exp, ctx.with_headers, ctx.delimiter);
+	ExecutionPlan_UpdateRoot(plan, op);
+}
+
 static inline void _buildUpdateOp(GraphContext *gc, ExecutionPlan *plan,
 								  const cypher_astnode_t *clause) {
 	rax *update_exps = AST_PrepareUpdateOp(gc, clause);
@@ -226,6 +236,8 @@ static void _buildForeachOp
 	body_ast->parse_result = NULL;
 	body_ast->ref_count = ref_count;
 	body_ast->params_parse_result = NULL;
+	body_ast->fingerprint_query = NULL;
+	body_ast->fingerprint = 0;
 	body_ast->anot_ctx_collection = plan->ast_segment->anot_ctx_collection;
 	body_ast->referenced_entities =
 		raxClone(plan->ast_segment->referenced_entities);
@@ -352,6 +364,8 @@ void ExecutionPlanSegment_ConvertClause
 		_buildCreateOp(gc, ast, plan, clause);
 	} else if(t == CYPHER_AST_UNWIND) {
 		_buildUnwindOp(plan, clause);
+	} else if(t == CYPHER_AST_LOAD_CSV) {
+		_buildLoadCSVOp(plan, clause);
 	} else if(t == CYPHER_AST_MERGE) {
 		buildMergeOp(plan, ast, clause, gc);
 	} else if(t == CYPHER_AST_SET || t == CYPHER_AST_REMOVE) {
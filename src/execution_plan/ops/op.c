@@ -11,6 +11,8 @@
 #include "../../util/rmalloc.h"
 #include "../../util/simple_timer.h"
 
+#include <inttypes.h>
+
 // forward declarations
 Record ExecutionPlan_BorrowRecord(struct ExecutionPlan *plan);
 rax *ExecutionPlan_GetMappings(const struct ExecutionPlan *plan);
@@ -198,10 +200,25 @@ static void _OpBase_StatsToString
 	const OpBase *op,
 	sds *buff
 ) {
+	const OpStats *stats = op->stats;
+
 	*buff = sdscatprintf(*buff,
-					" | Records produced: %d, Execution time: %f ms",
-					op->stats->profileRecordCount,
-					op->stats->profileExecTime);
+					" | Records produced: %d, Execution time: %f ms"
+					", Memory allocated: %" PRId64 " bytes"
+					", Peak memory: %" PRId64 " bytes"
+					", Allocations: %" PRIu64,
+					stats->profileRecordCount,
+					stats->profileExecTime,
+					stats->profileMem.allocated,
+					stats->profileMem.peak,
+					stats->profileMem.count);
+
+	if(stats->profileGrB) {
+		*buff = sdscatprintf(*buff,
+						", GraphBLAS time: %f ms, Matrix entries: %" PRIu64,
+						stats->profileGrBTime,
+						stats->profileGrBNvals);
+	}
 }
 
 void OpBase_ToString
@@ -222,11 +239,15 @@ Record OpBase_Profile
 	OpBase *op
 ) {
 	double tic [2];
+	// charge allocations made by this operation to its statistics
+	// children charge their own statistics while being consumed
+	rm_alloc_stats *prev = rm_alloc_stats_set(&op->stats->profileMem);
 	// Start timer.
 	simple_tic(tic);
 	Record r = op->profile(op);
 	// Stop timer and accumulate.
 	op->stats->profileExecTime += simple_toc(tic);
+	rm_alloc_stats_set(prev);
 	if(r) op->stats->profileRecordCount++;
 	return r;
 }
@@ -8,6 +8,7 @@
 
 #include "../record.h"
 #include "../../util/arr.h"
+#include "../../util/rmalloc.h"
 #include "../../redismodule.h"
 #include "../../schema/schema.h"
 #include "../../graph/query_graph.h"
@@ -20,6 +21,7 @@ typedef enum {
 	OPType_ALL_NODE_SCAN,
 	OPType_NODE_BY_LABEL_SCAN,
 	OPType_NODE_BY_INDEX_SCAN,
+	OPType_NODE_BY_ORDERED_INDEX_SCAN,
 	OPType_EDGE_BY_INDEX_SCAN,
 	OPType_NODE_BY_ID_SEEK,
 	OPType_NODE_BY_LABEL_AND_ID_SCAN,
@@ -41,6 +43,7 @@ typedef enum {
 	OPType_UPDATE,
 	OPType_DELETE,
 	OPType_UNWIND,
+	OPType_LOAD_CSV,
 	OPType_FOREACH,
 	OPType_PROC_CALL,
 	OPType_CALLSUBQUERY,
@@ -120,6 +123,10 @@ typedef struct OpBase *(*fpClone)(const struct ExecutionPlan *, const struct OpB
 typedef struct {
 	int profileRecordCount;     // Number of records generated.
 	double profileExecTime;     // Operation total execution time in ms.
+	rm_alloc_stats profileMem;  // Memory allocated by the operation itself.
+	bool profileGrB;            // Operation reports GraphBLAS statistics.
+	double profileGrBTime;      // Time spent evaluating matrix expressions in ms.
+	uint64_t profileGrBNvals;   // Number of matrix entries produced.
 }  OpStats;
 
 struct OpBase {
@@ -64,7 +64,7 @@ void _traverse(OpCondTraverse *op) {
 	_populate_filter_matrix(op);
 
 	// evaluate expression
-	AlgebraicExpression_Eval(op->ae, op->M);
+	Traverse_Eval((OpBase *)op, op->ae, op->M);
 
 	RG_MatrixTupleIter_attach(&op->iter, op->M);
 }
@@ -11,6 +11,7 @@
 #include "../../errors/errors.h"
 
 // forward declarations
+static OpResult CreateInit(OpBase *opBase);
 static Record CreateConsume(OpBase *opBase);
 static OpBase *CreateClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void CreateFree(OpBase *opBase);
@@ -20,7 +21,7 @@ OpBase *NewCreateOp(const ExecutionPlan *plan, NodeCreateCtx *nodes, EdgeCreateC
 	op->records = NULL;
 	NewPendingCreationsContainer(&op->pending, nodes, edges); // Prepare all creation variables.
 	// Set our Op operations
-	OpBase_Init((OpBase *)op, OPType_CREATE, "Create", NULL, CreateConsume,
+	OpBase_Init((OpBase *)op, OPType_CREATE, "Create", CreateInit, CreateConsume,
 				NULL, NULL, CreateClone, CreateFree, true, plan);
 
 	uint node_blueprint_count = array_len(nodes);
@@ -136,6 +137,53 @@ static Record _handoff
 	return (array_len(op->records)) ? array_pop(op->records) : NULL;
 }
 
+// locate a batched LOAD CSV operation streaming directly into op
+// USING PERIODIC COMMIT LOAD CSV FROM 'file:///a.csv' AS row CREATE (:A)
+// batching is only possible when every operation in between is streaming
+// and the LOAD CSV operation has no child to reset between batches
+static OpLoadCSV *_LocateBatchSource
+(
+	OpBase *op
+) {
+	while(op->childCount == 1) {
+		op = op->children[0];
+
+		if(op->type == OPType_LOAD_CSV) {
+			OpLoadCSV *load_csv = (OpLoadCSV *)op;
+			bool batched = load_csv->batch_size > 0 && op->childCount == 0;
+			return batched ? load_csv : NULL;
+		}
+
+		for(uint i = 0; i < EAGER_OP_COUNT; i++) {
+			if(op->type == EAGER_OPERATIONS[i]) return NULL;
+		}
+	}
+
+	return NULL;
+}
+
+static OpResult CreateInit
+(
+	OpBase *opBase
+) {
+	OpCreate *op = (OpCreate *)opBase;
+
+	op->batch_source = _LocateBatchSource(opBase);
+	if(op->batch_source != NULL) LoadCSVOp_EnableBatching(op->batch_source);
+
+	return OP_OK;
+}
+
+// clear committed entities, preparing for the next batch
+static void _ClearPending
+(
+	OpCreate *op
+) {
+	array_clear(op->pending.node_labels);
+	array_clear(op->pending.created_nodes);
+	array_clear(op->pending.created_edges);
+}
+
 static Record CreateConsume
 (
 	OpBase *opBase
@@ -143,11 +191,23 @@ static Record CreateConsume
 	OpCreate *op = (OpCreate *)opBase;
 	Record r;
 
-	// return mode, all data was consumed
-	if(op->records) return _handoff(op);
+	// return mode, hand off records of the current batch
+	if(op->records) {
+		r = _handoff(op);
+		if(r != NULL || op->batch_source == NULL ||
+		   !LoadCSVOp_Paused(op->batch_source)) {
+			return r;
+		}
 
-	// consume mode
-	op->records = array_new(Record, 32);
+		// batch handed off, commit it and process the next one
+		// releasing all locks in between batches
+		QueryCtx_CommitBatch();
+		_ClearPending(op);
+		LoadCSVOp_Resume(op->batch_source);
+	} else {
+		// consume mode
+		op->records = array_new(Record, 32);
+	}
 
 	// initialize the records array with NULL, which will terminate execution
 	// upon depletion
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "op.h"
+#include "op_load_csv.h"
 #include "../execution_plan.h"
 #include "../../ast/ast_shared.h"
 #include "shared/create_functions.h"
@@ -19,6 +20,7 @@ typedef struct {
 	OpBase op;                 // The base operation.
 	Record *records;           // Array of Records created by this operation.
 	PendingCreations pending;  // Container struct for all graph changes to be committed.
+	OpLoadCSV *batch_source;   // LOAD CSV operation feeding batches, if any.
 } OpCreate;
 
 OpBase *NewCreateOp(const ExecutionPlan *plan, NodeCreateCtx *nodes, EdgeCreateCtx *edges);
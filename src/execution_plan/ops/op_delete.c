@@ -67,13 +67,14 @@ static void _DeleteEntities
 		}
 
 		array_append(distinct_nodes, *n);
-
-		// mark node's edges for deletion
-		Graph_GetNodeEdges(g, n, GRAPH_EDGE_DIR_BOTH, GRAPH_NO_RELATION,
-				&op->deleted_edges);
 	}
 
 	node_count = array_len(distinct_nodes);
+
+	// mark nodes' edges for deletion
+	if(node_count > 0) {
+		Graph_GetNodesEdges(g, distinct_nodes, node_count, &op->deleted_edges);
+	}
 	edge_count = array_len(op->deleted_edges);
 
 	//--------------------------------------------------------------------------
@@ -122,6 +123,9 @@ static void _DeleteEntities
 				DeleteNodes(gc, distinct_nodes, node_count, true);
 				node_deleted = node_count;
 			}
+
+			// remove deleted entities from indices
+			QueryCtx_ApplyIndexChanges();
 		}
 	}
 
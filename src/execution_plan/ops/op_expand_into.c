@@ -77,7 +77,7 @@ static void _traverse
 	_populate_filter_matrix(op);
 
 	// evaluate expression
-	AlgebraicExpression_Eval(op->ae, op->M);
+	Traverse_Eval((OpBase *)op, op->ae, op->M);
 }
 
 OpBase *NewExpandIntoOp
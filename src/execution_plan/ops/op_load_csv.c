@@ -0,0 +1,366 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "op_load_csv.h"
+#include "../../query_ctx.h"
+#include "../../errors/errors.h"
+#include "../../datatypes/map.h"
+#include "../../datatypes/array.h"
+#include "../../util/import_folder.h"
+
+#include <errno.h>
+#include <string.h>
+
+#define FILE_URL_PREFIX "file://"
+
+// forward declarations
+static void LoadCSVFree(OpBase *opBase);
+static OpResult LoadCSVInit(OpBase *opBase);
+static Record LoadCSVConsume(OpBase *opBase);
+static OpResult LoadCSVReset(OpBase *opBase);
+static OpBase *LoadCSVClone(const ExecutionPlan *plan, const OpBase *opBase);
+
+OpBase *NewLoadCSVOp
+(
+	const ExecutionPlan *plan,
+	AR_ExpNode *exp,
+	bool with_headers,
+	char delimiter
+) {
+	OpLoadCSV *op = rm_calloc(1, sizeof(OpLoadCSV));
+
+	op->exp          = exp;
+	op->with_headers = with_headers;
+	op->delimiter    = delimiter;
+	op->url          = SI_NullVal();
+
+	// set our Op operations
+	OpBase_Init((OpBase *)op, OPType_LOAD_CSV, "Load CSV", LoadCSVInit,
+			LoadCSVConsume, LoadCSVReset, NULL, LoadCSVClone, LoadCSVFree,
+			false, plan);
+
+	op->recIdx = OpBase_Modifies((OpBase *)op, exp->resolved_name);
+	return (OpBase *)op;
+}
+
+// close current file
+static void _closeFile
+(
+	OpLoadCSV *op
+) {
+	CSVReader_Free(&op->reader);
+
+	SIValue_Free(op->url);
+	op->url = SI_NullVal();
+
+	if(op->path != NULL) {
+		rm_free(op->path);
+		op->path = NULL;
+	}
+
+	if(op->headers != NULL) {
+		uint n = array_len(op->headers);
+		for(uint i = 0; i < n; i++) SIValue_Free(op->headers[i]);
+		array_free(op->headers);
+		op->headers = NULL;
+	}
+}
+
+// make sure scratch buffer can hold n bytes
+static inline void _reserveBuffer
+(
+	OpLoadCSV *op,
+	size_t n
+) {
+	if(n <= op->buffer_cap) return;
+	op->buffer_cap = (n > op->buffer_cap * 2) ? n : op->buffer_cap * 2;
+	op->buffer = rm_realloc(op->buffer, op->buffer_cap);
+}
+
+// convert field into a value
+// unquoted empty fields are missing values and are converted to null
+// the returned value points into the scratch buffer and must be cloned
+// before the next field is converted
+static SIValue _fieldValue
+(
+	OpLoadCSV *op,
+	const CSVField *field
+) {
+	if(field->len == 0 && !field->quoted) return SI_NullVal();
+
+	_reserveBuffer(op, field->len + 1);
+	CSVField_Copy(field, op->buffer);
+	return SI_ConstStringVal(op->buffer);
+}
+
+// resolve URL into a path within the import folder
+// file:///a/b.csv resolves to <IMPORT_FOLDER>/a/b.csv
+static char *_resolvePath
+(
+	SIValue url
+) {
+	if(SI_TYPE(url) != T_STRING) {
+		ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_URL);
+		return NULL;
+	}
+
+	const char *s = url.stringval;
+	size_t prefix_len = strlen(FILE_URL_PREFIX);
+
+	if(strncmp(s, FILE_URL_PREFIX, prefix_len) != 0 || s[prefix_len] != '/') {
+		ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_URL);
+		return NULL;
+	}
+
+	// skip scheme, resolve within the import folder
+	char *path = ImportFolder_ResolvePath(s + prefix_len);
+	if(path == NULL) {
+		ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_PATH, s);
+		return NULL;
+	}
+
+	return path;
+}
+
+// open the file referred to by the URL expression
+// when the file contains headers, its first row is consumed
+static void _openFile
+(
+	OpLoadCSV *op
+) {
+	_closeFile(op);
+
+	// URL is kept until the file is closed, as it is referred to by errors
+	op->url  = AR_EXP_Evaluate(op->exp, op->currentRecord);
+	op->path = _resolvePath(op->url);
+
+	op->reader = CSVReader_New(op->path, op->delimiter);
+	if(op->reader == NULL) {
+		ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_OPEN, op->path,
+				strerror(errno));
+		return;
+	}
+
+	if(!op->with_headers) return;
+
+	uint nfields;
+	const CSVField *fields;
+	op->headers = array_new(SIValue, 0);
+
+	CSVReaderStatus status = CSVReader_NextRow(op->reader, &fields, &nfields);
+	if(status == CSV_ERROR) {
+		ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_MALFORMED, op->path,
+				CSVReader_RowNumber(op->reader));
+		return;
+	}
+
+	if(status == CSV_EOF) return;
+
+	for(uint i = 0; i < nfields; i++) {
+		SIValue header = _fieldValue(op, fields + i);
+		// a missing column name is replaced by an empty string
+		if(SIValue_IsNull(header)) header = SI_ConstStringVal("");
+		array_append(op->headers, SI_CloneValue(header));
+	}
+}
+
+// build a value out of the next row in the file
+// returns false once the file is depleted
+static bool _nextRow
+(
+	OpLoadCSV *op,
+	SIValue *row
+) {
+	if(op->reader == NULL) return false;
+
+	uint nfields;
+	const CSVField *fields;
+
+	CSVReaderStatus status = CSVReader_NextRow(op->reader, &fields, &nfields);
+	if(status == CSV_EOF) return false;
+
+	if(status == CSV_ERROR) {
+		ErrorCtx_RaiseRuntimeException(EMSG_LOAD_CSV_MALFORMED, op->path,
+				CSVReader_RowNumber(op->reader));
+		return false;
+	}
+
+	if(!op->with_headers) {
+		*row = SI_Array(nfields);
+		for(uint i = 0; i < nfields; i++) {
+			SIArray_Append(row, _fieldValue(op, fields + i));
+		}
+		return true;
+	}
+
+	// fields without a matching column name are dropped
+	// while columns without a matching field are set to null
+	uint ncols = array_len(op->headers);
+	*row = SI_Map(ncols);
+	for(uint i = 0; i < ncols; i++) {
+		SIValue v = (i < nfields) ? _fieldValue(op, fields + i) : SI_NullVal();
+		Map_Add(row, op->headers[i], v);
+	}
+
+	return true;
+}
+
+void LoadCSVOp_SetBatchSize
+(
+	OpLoadCSV *op,
+	uint64_t batch_size
+) {
+	ASSERT(op != NULL);
+	op->batch_size = batch_size;
+}
+
+void LoadCSVOp_EnableBatching
+(
+	OpLoadCSV *op
+) {
+	ASSERT(op != NULL);
+	ASSERT(op->batch_size > 0);
+	op->batched = true;
+}
+
+inline bool LoadCSVOp_Paused
+(
+	const OpLoadCSV *op
+) {
+	ASSERT(op != NULL);
+	return op->paused;
+}
+
+void LoadCSVOp_Resume
+(
+	OpLoadCSV *op
+) {
+	ASSERT(op != NULL);
+	op->paused     = false;
+	op->batch_rows = 0;
+}
+
+static OpResult LoadCSVInit
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	// USING PERIODIC COMMIT is only honored when CREATE commits our batches
+	// the consuming CREATE operation is initialized before us
+	if(op->batch_size > 0 && !op->batched) {
+		ErrorCtx_RaiseRuntimeException(EMSG_PERIODIC_COMMIT_CREATE);
+	}
+
+	op->buffer_cap = 256;
+	op->buffer     = rm_malloc(op->buffer_cap);
+
+	if(op->op.childCount == 0) {
+		// no child operation, URL must be static
+		op->currentRecord = OpBase_CreateRecord((OpBase *)op);
+		_openFile(op);
+	}
+
+	return OP_OK;
+}
+
+static Record LoadCSVConsume
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	// batch complete, report depletion until resumed
+	if(op->batched && op->batch_rows == op->batch_size) {
+		op->paused = true;
+		return NULL;
+	}
+
+	SIValue row;
+	while(!_nextRow(op, &row)) {
+		// current file depleted, release it as soon as possible
+		_closeFile(op);
+
+		// no child operation to pull data from, we're done
+		if(op->op.childCount == 0) return NULL;
+
+		Record r = OpBase_Consume(op->op.children[0]);
+		if(r == NULL) return NULL;
+
+		if(op->currentRecord != NULL) OpBase_DeleteRecord(op->currentRecord);
+		op->currentRecord = r;
+
+		_openFile(op);
+	}
+
+	op->batch_rows++;
+
+	Record r = OpBase_CloneRecord(op->currentRecord);
+	Record_AddScalar(r, op->recIdx, row);
+	return r;
+}
+
+static OpResult LoadCSVReset
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	// a paused operation retains its position until resumed
+	if(op->paused) return OP_OK;
+
+	_closeFile(op);
+	op->batch_rows = 0;
+
+	if(op->op.childCount == 0) {
+		// URL is static, reload file from the start
+		_openFile(op);
+	} else if(op->currentRecord != NULL) {
+		OpBase_DeleteRecord(op->currentRecord);
+		op->currentRecord = NULL;
+	}
+
+	return OP_OK;
+}
+
+static inline OpBase *LoadCSVClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_LOAD_CSV);
+
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+	OpLoadCSV *clone = (OpLoadCSV *)NewLoadCSVOp(plan, AR_EXP_Clone(op->exp),
+			op->with_headers, op->delimiter);
+
+	LoadCSVOp_SetBatchSize(clone, op->batch_size);
+	return (OpBase *)clone;
+}
+
+static void LoadCSVFree
+(
+	OpBase *opBase
+) {
+	OpLoadCSV *op = (OpLoadCSV *)opBase;
+
+	_closeFile(op);
+
+	if(op->exp != NULL) {
+		AR_EXP_Free(op->exp);
+		op->exp = NULL;
+	}
+
+	if(op->buffer != NULL) {
+		rm_free(op->buffer);
+		op->buffer = NULL;
+	}
+
+	if(op->currentRecord != NULL) {
+		OpBase_DeleteRecord(op->currentRecord);
+		op->currentRecord = NULL;
+	}
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "../execution_plan.h"
+#include "../../util/csv_reader.h"
+#include "../../arithmetic/arithmetic_expression.h"
+
+// number of rows per batch when USING PERIODIC COMMIT omits a batch size
+#define PERIODIC_COMMIT_BATCH_SIZE_DEFAULT 1000
+
+// OP LoadCSV
+// streams rows out of a CSV file, each row is exposed either as a list of
+// strings or, when the file contains headers, as a map of column name to value
+typedef struct {
+	OpBase op;
+	AR_ExpNode *exp;        // URL expression (evaluated as a string)
+	bool with_headers;      // first row holds column names
+	char delimiter;         // field delimiter
+	int recIdx;             // update record at this index
+	Record currentRecord;   // record to clone and add a row to
+	SIValue url;            // URL of the file currently being loaded
+	CSVReader *reader;      // reader of the file currently being loaded
+	char *path;             // path of the file currently being loaded
+	SIValue *headers;       // column names
+	char *buffer;           // scratch buffer used to unescape fields
+	size_t buffer_cap;      // scratch buffer capacity
+	uint64_t batch_size;    // rows per batch, 0 if no batch size was specified
+	uint64_t batch_rows;    // rows produced within the current batch
+	bool batched;           // rows are split into batches
+	bool paused;            // current batch is complete
+} OpLoadCSV;
+
+// creates a new LoadCSV operation
+OpBase *NewLoadCSVOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	AR_ExpNode *exp,            // URL expression
+	bool with_headers,          // first row holds column names
+	char delimiter              // field delimiter
+);
+
+// set number of rows per batch
+// USING PERIODIC COMMIT <batch_size>
+void LoadCSVOp_SetBatchSize
+(
+	OpLoadCSV *op,       // load CSV operation
+	uint64_t batch_size  // rows per batch
+);
+
+// split rows into batches, invoked by the operation committing the batches
+// once a batch is complete the operation pauses, reporting depletion
+// while retaining its position within the file across resets
+void LoadCSVOp_EnableBatching
+(
+	OpLoadCSV *op  // load CSV operation
+);
+
+// returns true if the operation paused at the end of a batch
+bool LoadCSVOp_Paused
+(
+	const OpLoadCSV *op  // load CSV operation
+);
+
+// resume a paused operation, starting a new batch
+void LoadCSVOp_Resume
+(
+	OpLoadCSV *op  // load CSV operation
+);
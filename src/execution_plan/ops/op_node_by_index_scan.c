@@ -19,6 +19,16 @@ static void IndexScanFree(OpBase *opBase);
 static void IndexScanToString(const OpBase *ctx, sds *buf) {
 	IndexScan *op = (IndexScan *)ctx;
 	ScanToString(ctx, buf, op->n->alias, op->n->label);
+	if(op->covering != NULL) *buf = sdscat(*buf, " | Index Only");
+
+	if(op->combine != INDEX_COMBINE_NONE) {
+		*buf = sdscat(*buf, op->combine == INDEX_COMBINE_INTERSECT ?
+				" | Intersect" : " | Union");
+		uint n = array_len(op->sources);
+		for(uint i = 0; i < n; i++) {
+			*buf = sdscatprintf(*buf, " :%s", op->sources[i].label);
+		}
+	}
 }
 
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
@@ -34,7 +44,12 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 	op->n                    =  n;
 	op->idx                  =  idx;
 	op->iter                 =  NULL;
+	op->ids                  =  NULL;
+	op->ids_pos              =  0;
 	op->filter               =  filter;
+	op->combine              =  INDEX_COMBINE_NONE;
+	op->sources              =  NULL;
+	op->covering             =  NULL;
 	op->child_record         =  NULL;
 	op->unresolved_filters   =  NULL;
 	op->rebuild_index_query  =  false;
@@ -47,6 +62,33 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 	return (OpBase *)op;
 }
 
+void IndexScanOp_UseCoveringIndex
+(
+	IndexScan *op,
+	const CoveringIndex *covering
+) {
+	ASSERT(op       != NULL);
+	ASSERT(covering != NULL);
+
+	op->covering = covering;
+}
+
+void IndexScanOp_CombineIndices
+(
+	IndexScan *op,
+	IndexCombineMode mode,
+	IndexScanSource *sources
+) {
+	ASSERT(op      != NULL);
+	ASSERT(sources != NULL);
+	ASSERT(mode    != INDEX_COMBINE_NONE);
+	ASSERT(op->sources == NULL);
+	ASSERT(array_len(sources) > 0);
+
+	op->combine = mode;
+	op->sources = sources;
+}
+
 static OpResult IndexScanInit(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
@@ -59,6 +101,14 @@ static OpResult IndexScanInit(OpBase *opBase) {
 		op->rebuild_index_query = raxSize(entities) > 1; // this is us
 		raxFree(entities);
 
+		// combined indices might depend on runtime values as well
+		uint n = array_len(op->sources);
+		for(uint i = 0; i < n && !op->rebuild_index_query; i++) {
+			entities = FilterTree_CollectModified(op->sources[i].filter);
+			op->rebuild_index_query = raxSize(entities) > 1;
+			raxFree(entities);
+		}
+
 		OpBase_UpdateConsume(opBase, IndexScanConsumeFromChild);
 	}
 
@@ -76,11 +126,272 @@ static OpResult IndexScanInit(OpBase *opBase) {
 static inline void _UpdateRecord(IndexScan *op, Record r, EntityID node_id) {
 	// Populate the Record with the graph entity data.
 	Node n = GE_NEW_NODE();
+
+	// index-only scan, node's attributes are taken from the covering index
+	// avoiding an access to the graph's node storage
+	if(op->covering != NULL) {
+		n.id         = node_id;
+		n.attributes = CoveringIndex_Get(op->covering, node_id);
+		if(likely(n.attributes != NULL)) {
+			Record_AddNode(r, op->nodeRecIdx, n);
+			return;
+		}
+	}
+
 	int res = Graph_GetNode(op->g, node_id, &n);
 	ASSERT(res != 0);
 	Record_AddNode(r, op->nodeRecIdx, n);
 }
 
+//------------------------------------------------------------------------------
+// index combination
+//------------------------------------------------------------------------------
+
+static int _CompareIDs
+(
+	const void *a,
+	const void *b
+) {
+	EntityID x = *(const EntityID *)a;
+	EntityID y = *(const EntityID *)b;
+	return (x > y) - (x < y);
+}
+
+// sort and deduplicate IDs
+static EntityID *_SortIDs
+(
+	EntityID *ids
+) {
+	uint64_t n = array_len(ids);
+	if(n < 2) return ids;
+
+	qsort(ids, n, sizeof(EntityID), _CompareIDs);
+
+	uint64_t j = 0;
+	for(uint64_t i = 1; i < n; i++) {
+		if(ids[i] != ids[j]) ids[++j] = ids[i];
+	}
+
+	return array_trimm_len(ids, j + 1);
+}
+
+// intersect two sorted ID arrays, result is written to 'a'
+static EntityID *_IntersectIDs
+(
+	EntityID *a,
+	const EntityID *b
+) {
+	uint64_t i = 0;
+	uint64_t j = 0;
+	uint64_t k = 0;
+	uint64_t a_len = array_len(a);
+	uint64_t b_len = array_len(b);
+
+	while(i < a_len && j < b_len) {
+		if(a[i] < b[j]) {
+			i++;
+		} else if(a[i] > b[j]) {
+			j++;
+		} else {
+			a[k++] = a[i];
+			i++;
+			j++;
+		}
+	}
+
+	return array_trimm_len(a, k);
+}
+
+// returns true if sorted array 'ids' contains 'id'
+static bool _ContainsID
+(
+	const EntityID *ids,
+	EntityID id
+) {
+	int64_t lo = 0;
+	int64_t hi = (int64_t)array_len(ids) - 1;
+
+	while(lo <= hi) {
+		int64_t mid = lo + (hi - lo) / 2;
+		if(ids[mid] == id) return true;
+		if(ids[mid] < id) lo = mid + 1;
+		else hi = mid - 1;
+	}
+
+	return false;
+}
+
+// collect IDs of nodes matched by 'filter' against 'idx' into 'ids'
+static void _CollectIDs
+(
+	IndexScan *op,               // index scan
+	RSIndex *idx,                // index to query
+	const FT_FilterNode *filter, // filter to convert into an index query
+	bool check_label,            // require nodes to carry the scanned label
+	Record r,                    // record used to evaluate runtime values
+	EntityID **ids               // [output] collected IDs
+) {
+	RSQNode       *rs_query_node = NULL;
+	FT_FilterNode *unresolved    = NULL;
+
+	if(op->rebuild_index_query) {
+		// resolve runtime variables within filter
+		FT_FilterNode *resolved = FilterTree_Clone(filter);
+		FilterTree_ResolveVariables(resolved, r);
+		rs_query_node = FilterTreeToQueryNode(&unresolved, resolved, idx);
+		FilterTree_Free(resolved);
+	} else {
+		rs_query_node = FilterTreeToQueryNode(&unresolved, filter, idx);
+	}
+
+	ASSERT(rs_query_node != NULL);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(rs_query_node, idx);
+
+	const EntityID *id = NULL;
+	while((id = RediSearch_ResultsIteratorNext(iter, idx, NULL)) != NULL) {
+		if(check_label &&
+		   !Graph_IsNodeLabeled(op->g, *id, op->n->label_id)) {
+			continue;
+		}
+
+		// filters which couldn't be resolved by the index are applied
+		// per source, as a union requires each source to be exact
+		if(unresolved != NULL) {
+			_UpdateRecord(op, r, *id);
+			if(FilterTree_applyFilters(unresolved, r) != FILTER_PASS) continue;
+		}
+
+		array_append(*ids, *id);
+	}
+
+	RediSearch_ResultsIteratorFree(iter);
+	if(unresolved != NULL) FilterTree_Free(unresolved);
+}
+
+// query combined indices
+// for an intersection 'ids' holds the nodes matched by all sources
+// for a union 'ids' holds the nodes matched by either the scanned index or
+// any of the sources
+static void _CombineIndices
+(
+	IndexScan *op,  // index scan
+	Record r        // record used to evaluate runtime values
+) {
+	ASSERT(op->combine != INDEX_COMBINE_NONE);
+
+	array_free(op->ids);
+	op->ids     = NULL;
+	op->ids_pos = 0;
+
+	EntityID *ids = array_new(EntityID, 0);
+	uint n = array_len(op->sources);
+
+	if(op->combine == INDEX_COMBINE_UNION) {
+		// nodes retrieved from the scanned index carry the scanned label
+		_CollectIDs(op, op->idx, op->filter, false, r, &ids);
+		for(uint i = 0; i < n; i++) {
+			IndexScanSource *src = op->sources + i;
+			_CollectIDs(op, src->idx, src->filter, true, r, &ids);
+		}
+		op->ids = _SortIDs(ids);
+		return;
+	}
+
+	// intersect sources using sorted merges
+	_CollectIDs(op, op->sources[0].idx, op->sources[0].filter, false, r, &ids);
+	ids = _SortIDs(ids);
+
+	EntityID *src_ids = array_new(EntityID, 0);
+	for(uint i = 1; i < n && array_len(ids) > 0; i++) {
+		IndexScanSource *src = op->sources + i;
+		array_clear(src_ids);
+		_CollectIDs(op, src->idx, src->filter, false, r, &src_ids);
+		src_ids = _SortIDs(src_ids);
+		ids = _IntersectIDs(ids, src_ids);
+	}
+	array_free(src_ids);
+
+	op->ids = ids;
+}
+
+// create index iterator and query combined indices
+static void _Query
+(
+	IndexScan *op,  // index scan
+	Record r        // record used to evaluate runtime values
+) {
+	if(op->combine != INDEX_COMBINE_NONE) _CombineIndices(op, r);
+
+	// a union is fully resolved by combined indices
+	if(op->combine == INDEX_COMBINE_UNION) return;
+
+	RSQNode *rs_query_node = NULL;
+	if(op->rebuild_index_query) {
+		// rebuild index query, probably relies on runtime values
+		// resolve runtime variables within filter
+		FT_FilterNode *filter = FilterTree_Clone(op->filter);
+		FilterTree_ResolveVariables(filter, r);
+
+		// make sure there's only one unresolve entity in filter
+		#ifdef RG_DEBUG
+		{
+			rax *entities = FilterTree_CollectModified(filter);
+			ASSERT(raxSize(entities) == 1);
+			raxFree(entities);
+		}
+		#endif
+
+		// convert filter into a RediSearch query
+		rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters, filter,
+				op->idx);
+		FilterTree_Free(filter);
+	} else {
+		rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
+				op->filter, op->idx);
+	}
+
+	// create iterator
+	ASSERT(rs_query_node != NULL);
+	op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+}
+
+// returns true if index scan was queried
+static inline bool _Queried
+(
+	const IndexScan *op
+) {
+	return op->iter != NULL || op->ids != NULL;
+}
+
+// produce next matching node ID
+// returns false once depleted
+static bool _NextNodeID
+(
+	IndexScan *op,  // index scan
+	EntityID *id    // [output] node ID
+) {
+	if(op->combine == INDEX_COMBINE_UNION) {
+		if(op->ids_pos >= array_len(op->ids)) return false;
+		*id = op->ids[op->ids_pos++];
+		return true;
+	}
+
+	const EntityID *nodeId = NULL;
+	while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
+			!= NULL) {
+		// skip nodes not matched by intersected indices
+		if(op->combine == INDEX_COMBINE_INTERSECT &&
+		   !_ContainsID(op->ids, *nodeId)) {
+			continue;
+		}
+
+		*id = *nodeId;
+		return true;
+	}
+
+	return false;
+}
+
 static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
 	FT_FilterNode *unresolved_filters = op->unresolved_filters;
 	if(unresolved_filters == NULL) return true; // no filters
@@ -89,18 +400,17 @@ static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
 
 static Record IndexScanConsumeFromChild(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
-	const EntityID *nodeId = NULL;
+	EntityID nodeId;
 
 pull_index:
 	//--------------------------------------------------------------------------
 	// pull from index
 	//--------------------------------------------------------------------------
 
-	if(op->iter != NULL && op->child_record != NULL) {
-		while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-				!= NULL) {
+	if(_Queried(op) && op->child_record != NULL) {
+		while(_NextNodeID(op, &nodeId)) {
 			// populate record with node
-			_UpdateRecord(op, op->child_record, *nodeId);
+			_UpdateRecord(op, op->child_record, nodeId);
 			// apply unresolved filters
 			if(_PassUnresolvedFilters(op, op->child_record)) {
 				// clone the held Record, as it will be freed upstream
@@ -144,38 +454,17 @@ pull_index:
 		}
 
 		// rebuild index query, probably relies on runtime values
-		// resolve runtime variables within filter
-		FT_FilterNode *filter = FilterTree_Clone(op->filter);
-		FilterTree_ResolveVariables(filter, op->child_record);
-
-		// make sure there's only one unresolve entity in filter
-		#ifdef RG_DEBUG
-		{
-			rax *entities = FilterTree_CollectModified(filter);
-			ASSERT(raxSize(entities) == 1);
-			raxFree(entities);
-		}
-		#endif
-
-		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				filter, op->idx);
-		FilterTree_Free(filter);
-
-		// create iterator
-		ASSERT(rs_query_node != NULL);
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+		_Query(op, op->child_record);
 	} else {
 		// build index query only once (first call)
 		// reset it if already initialized
-		if(op->iter == NULL) {
+		if(!_Queried(op)) {
 			// first call to consume, create query and iterator
-			RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters, op->filter, op->idx);
-			ASSERT(rs_query_node != NULL);
-			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
+			_Query(op, op->child_record);
 		} else {
 			// reset existing iterator
-			RediSearch_ResultsIteratorReset(op->iter);
+			if(op->iter != NULL) RediSearch_ResultsIteratorReset(op->iter);
+			op->ids_pos = 0;
 		}
 	}
 
@@ -186,22 +475,16 @@ pull_index:
 static Record IndexScanConsume(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
-	// create iterator on first call
-	if(op->iter == NULL) {
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				op->filter, op->idx);
-
-		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
-	}
+	Record r = OpBase_CreateRecord((OpBase *)op);
 
-	const EntityID *nodeId = NULL;
+	// create iterator on first call
+	if(!_Queried(op)) _Query(op, r);
 
 	// populate the Record with the actual node
-	Record r = OpBase_CreateRecord((OpBase *)op);
-	while((nodeId = RediSearch_ResultsIteratorNext(op->iter, op->idx, NULL))
-			!= NULL) {
+	EntityID nodeId;
+	while(_NextNodeID(op, &nodeId)) {
 		// populate record with node
-		_UpdateRecord(op, r, *nodeId);
+		_UpdateRecord(op, r, nodeId);
 		// apply unresolved filters
 		if(_PassUnresolvedFilters(op, r)) {
 			return r;
@@ -226,6 +509,11 @@ static OpResult IndexScanReset(OpBase *opBase) {
 		op->unresolved_filters = NULL;
 	}
 
+	if(op->ids != NULL) {
+		array_free(op->ids);
+		op->ids = NULL;
+	}
+
 	return OP_OK;
 }
 
@@ -255,6 +543,18 @@ static void IndexScanFree(OpBase *opBase) {
 		op->unresolved_filters = NULL;
 	}
 
+	if(op->ids != NULL) {
+		array_free(op->ids);
+		op->ids = NULL;
+	}
+
+	if(op->sources != NULL) {
+		uint n = array_len(op->sources);
+		for(uint i = 0; i < n; i++) FilterTree_Free(op->sources[i].filter);
+		array_free(op->sources);
+		op->sources = NULL;
+	}
+
 	if(op->n != NULL) {
 		NodeScanCtx_Free(op->n);
 		op->n = NULL;
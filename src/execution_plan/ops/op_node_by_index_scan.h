@@ -13,6 +13,20 @@
 #include "shared/scan_functions.h"
 #include "redisearch_api.h"
 
+// how additional indices are combined with the scanned index
+typedef enum {
+	INDEX_COMBINE_NONE,       // single index scan
+	INDEX_COMBINE_INTERSECT,  // nodes must be matched by all indices
+	INDEX_COMBINE_UNION,      // nodes must be matched by any index
+} IndexCombineMode;
+
+// additional index queried by an index-combination scan
+typedef struct {
+	RSIndex *idx;           // index to query
+	const char *label;      // label indexed by idx
+	FT_FilterNode *filter;  // filter from which to compose index query
+} IndexScanSource;
+
 typedef struct {
 	OpBase op;
 	Graph *g;
@@ -24,9 +38,35 @@ typedef struct {
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // the Record this op acts on if it is not a tap
+	const CoveringIndex *covering;      // index-only scan, populate nodes from the covering index
+	IndexCombineMode combine;           // how additional indices are combined
+	IndexScanSource *sources;           // additional indices to combine
+	EntityID *ids;                      // sorted IDs matched by combined indices
+	uint64_t ids_pos;                   // position of next ID to produce (union)
 } IndexScan;
 
 // creates a new IndexScan operation
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 		RSIndex *idx, FT_FilterNode *filter);
 
+// combine additional indices with the scan
+// an intersection produces nodes matched by both the scanned index and all
+// sources, a union produces nodes matched by either
+// sources index other labels of the scanned node
+// the scan takes ownership over sources and their filters
+void IndexScanOp_CombineIndices
+(
+	IndexScan *op,             // index scan
+	IndexCombineMode mode,     // intersect or union
+	IndexScanSource *sources   // additional indices
+);
+
+// switch index scan to an index-only scan
+// nodes produced by the scan only expose the attributes held by the covering
+// index, the caller must make sure no other attribute is accessed
+void IndexScanOp_UseCoveringIndex
+(
+	IndexScan *op,                 // index scan
+	const CoveringIndex *covering  // index's covered attributes
+);
+
@@ -0,0 +1,369 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "op_node_by_ordered_index_scan.h"
+#include "RG.h"
+#include "../../ast/ast.h"
+#include "../../query_ctx.h"
+#include "../../util/qsort.h"
+#include "../../util/rmalloc.h"
+#include "shared/print_functions.h"
+
+// max number of tree entries fetched at once
+#define ORDERED_SCAN_MAX_BATCH 1024
+
+// number of tree entries fetched at once when the limit is unknown
+#define ORDERED_SCAN_DEFAULT_BATCH 64
+
+// forward declarations
+static OpResult OrderedIndexScanInit(OpBase *opBase);
+static Record OrderedIndexScanConsume(OpBase *opBase);
+static OpResult OrderedIndexScanReset(OpBase *opBase);
+static OpBase *OrderedIndexScanClone(const ExecutionPlan *plan, const OpBase *opBase);
+static void OrderedIndexScanFree(OpBase *opBase);
+
+static void OrderedIndexScanToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	OrderedIndexScan *op = (OrderedIndexScan *)ctx;
+	ScanToString(ctx, buf, op->n->alias, op->n->label);
+}
+
+OpBase *NewOrderedIndexScanOp
+(
+	const ExecutionPlan *plan,
+	NodeScanCtx *n,
+	const char *attr,
+	bool descending
+) {
+	ASSERT(n    != NULL);
+	ASSERT(attr != NULL);
+	ASSERT(plan != NULL);
+
+	OrderedIndexScan *op = rm_calloc(1, sizeof(OrderedIndexScan));
+
+	op->g          = QueryCtx_GetGraph();
+	op->n          = n;
+	op->attr       = rm_strdup(attr);
+	op->skip       = 0;
+	op->limit      = UNLIMITED;
+	op->stage      = ORDERED_SCAN_DEPLETED;
+	op->attr_id    = ATTRIBUTE_ID_NONE;
+	op->descending = descending;
+
+	OpBase_Init((OpBase *)op, OPType_NODE_BY_ORDERED_INDEX_SCAN,
+			"Node By Ordered Index Scan", OrderedIndexScanInit,
+			OrderedIndexScanConsume, OrderedIndexScanReset,
+			OrderedIndexScanToString, OrderedIndexScanClone,
+			OrderedIndexScanFree, false, plan);
+
+	op->nodeRecIdx = OpBase_Modifies((OpBase *)op, n->alias);
+
+	return (OpBase *)op;
+}
+
+// release per execution state
+static void _ReleaseState
+(
+	OrderedIndexScan *op
+) {
+	GrB_Info info = RG_MatrixTupleIter_detach(&op->label_it);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	if(op->sorted != NULL) {
+		array_free(op->sorted);
+		op->sorted = NULL;
+	}
+
+	op->oi        = NULL;
+	op->batch_len = 0;
+	op->batch_idx = 0;
+}
+
+static void _AttachLabelIterator
+(
+	OrderedIndexScan *op
+) {
+	RG_Matrix L = Graph_GetLabelMatrix(op->g, op->n->label_id);
+	GrB_Info info = RG_MatrixTupleIter_attach(&op->label_it, L);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+}
+
+typedef struct {
+	SIValue v;    // node's attribute value
+	EntityID id;  // node ID
+} _SortItem;
+
+static int _SortItemCmp
+(
+	const void *a,
+	const void *b,
+	void *udata
+) {
+	const OrderedIndexScan *op = (const OrderedIndexScan *)udata;
+	int rel = SIValue_Compare(((const _SortItem *)a)->v,
+			((const _SortItem *)b)->v, NULL);
+	return op->descending ? -rel : rel;
+}
+
+// fallback path, sort all labeled nodes by attribute
+static void _SortLabel
+(
+	OrderedIndexScan *op
+) {
+	uint64_t n = Graph_LabeledNodeCount(op->g, op->n->label_id);
+	_SortItem *items = array_new(_SortItem, n);
+
+	_AttachLabelIterator(op);
+
+	GrB_Index id;
+	while(RG_MatrixTupleIter_next_BOOL(&op->label_it, &id, NULL, NULL) ==
+			GrB_SUCCESS) {
+		Node node = GE_NEW_NODE();
+		Graph_GetNode(op->g, id, &node);
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)&node, op->attr_id);
+		_SortItem item = {(v == ATTRIBUTE_NOTFOUND) ? SI_NullVal() : *v, id};
+		array_append(items, item);
+	}
+
+	uint count = array_len(items);
+	sort_r(items, count, sizeof(_SortItem), _SortItemCmp, op);
+
+	op->sorted = array_newlen(EntityID, count);
+	for(uint i = 0; i < count; i++) op->sorted[i] = items[i].id;
+	op->sorted_idx = 0;
+
+	array_free(items);
+}
+
+// decide how nodes are produced
+static void _Prepare
+(
+	OrderedIndexScan *op
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	// resolve label ID now if it is still unknown
+	if(op->n->label_id == GRAPH_UNKNOWN_LABEL) {
+		Schema *s = GraphContext_GetSchema(gc, op->n->label, SCHEMA_NODE);
+		if(s != NULL) op->n->label_id = Schema_GetID(s);
+	}
+
+	if(op->n->label_id == GRAPH_UNKNOWN_LABEL) {
+		op->stage = ORDERED_SCAN_DEPLETED;
+		return;
+	}
+
+	// the index might have been dropped since the plan was built
+	op->attr_id = GraphContext_GetAttributeID(gc, op->attr);
+	if(op->attr_id != ATTRIBUTE_ID_NONE) {
+		Index idx = GraphContext_GetIndexByID(gc, op->n->label_id,
+				&op->attr_id, 1, IDX_EXACT_MATCH, GETYPE_NODE);
+		if(idx != NULL) op->oi = Index_GetOrderedIndex(idx, op->attr_id);
+	}
+
+	// tree can't reproduce sort order, sort the entire label
+	if(op->oi == NULL || OrderedIndex_UnorderedCount(op->oi) > 0) {
+		_SortLabel(op);
+		op->stage = ORDERED_SCAN_SORTED;
+		return;
+	}
+
+	uint64_t labeled = Graph_LabeledNodeCount(op->g, op->n->label_id);
+	uint64_t ordered = OrderedIndex_OrderedCount(op->oi);
+	ASSERT(labeled >= ordered);
+	op->nulls = labeled - ordered;
+
+	BTree_IteratorInit(&op->iter, OrderedIndex_Tree(op->oi), op->descending);
+
+	// nulls sort last, descending order produces them first
+	if(op->descending && op->nulls > 0) {
+		_AttachLabelIterator(op);
+		op->stage = ORDERED_SCAN_NULLS;
+	} else {
+		op->stage = ORDERED_SCAN_TREE;
+	}
+}
+
+static OpResult OrderedIndexScanInit
+(
+	OpBase *opBase
+) {
+	OrderedIndexScan *op = (OrderedIndexScan *)opBase;
+
+	// parents only require the first limit + skip records
+	// use that as the first batch size
+	uint64_t cap = ORDERED_SCAN_DEFAULT_BATCH;
+	if(op->limit != UNLIMITED) {
+		cap = (uint64_t)op->limit + op->skip;
+		if(cap == 0) cap = 1;
+		if(cap > ORDERED_SCAN_MAX_BATCH) cap = ORDERED_SCAN_MAX_BATCH;
+	}
+	op->batch_cap = cap;
+	op->batch = rm_malloc(sizeof(BTreeEntry) * cap);
+
+	_Prepare(op);
+
+	return OP_OK;
+}
+
+static inline Record _CreateRecord
+(
+	OrderedIndexScan *op,
+	EntityID id
+) {
+	Record r = OpBase_CreateRecord((OpBase *)op);
+	Node n = GE_NEW_NODE();
+	int res = Graph_GetNode(op->g, id, &n);
+	ASSERT(res != 0);
+	UNUSED(res);
+	Record_AddNode(r, op->nodeRecIdx, n);
+	return r;
+}
+
+// produce next node missing the attribute
+static bool _NextNull
+(
+	OrderedIndexScan *op,
+	EntityID *id
+) {
+	GrB_Index node_id;
+	while(op->nulls > 0 && RG_MatrixTupleIter_next_BOOL(&op->label_it,
+				&node_id, NULL, NULL) == GrB_SUCCESS) {
+		Node n = GE_NEW_NODE();
+		Graph_GetNode(op->g, node_id, &n);
+		if(GraphEntity_GetProperty((GraphEntity *)&n, op->attr_id) ==
+				ATTRIBUTE_NOTFOUND) {
+			op->nulls--;
+			*id = node_id;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// produce next node from the ordered tree
+static bool _NextOrdered
+(
+	OrderedIndexScan *op,
+	EntityID *id
+) {
+	if(op->batch_idx == op->batch_len) {
+		op->batch_idx = 0;
+		op->batch_len = BTree_IteratorNext(&op->iter, op->batch,
+				op->batch_cap);
+		if(op->batch_len == 0) return false;
+
+		// parents asked for more than expected, grow batch
+		if(op->batch_cap < ORDERED_SCAN_MAX_BATCH) {
+			op->batch_cap *= 2;
+			if(op->batch_cap > ORDERED_SCAN_MAX_BATCH) {
+				op->batch_cap = ORDERED_SCAN_MAX_BATCH;
+			}
+			op->batch = rm_realloc(op->batch,
+					sizeof(BTreeEntry) * op->batch_cap);
+		}
+	}
+
+	*id = op->batch[op->batch_idx++].id;
+	return true;
+}
+
+static Record OrderedIndexScanConsume
+(
+	OpBase *opBase
+) {
+	OrderedIndexScan *op = (OrderedIndexScan *)opBase;
+
+	EntityID id;
+
+	while(true) {
+		switch(op->stage) {
+			case ORDERED_SCAN_TREE:
+				if(_NextOrdered(op, &id)) return _CreateRecord(op, id);
+				if(!op->descending && op->nulls > 0) {
+					_AttachLabelIterator(op);
+					op->stage = ORDERED_SCAN_NULLS;
+				} else {
+					op->stage = ORDERED_SCAN_DEPLETED;
+				}
+				break;
+			case ORDERED_SCAN_NULLS:
+				if(_NextNull(op, &id)) return _CreateRecord(op, id);
+				op->stage = op->descending ? ORDERED_SCAN_TREE :
+					ORDERED_SCAN_DEPLETED;
+				break;
+			case ORDERED_SCAN_SORTED:
+				if(op->sorted_idx < array_len(op->sorted)) {
+					return _CreateRecord(op, op->sorted[op->sorted_idx++]);
+				}
+				op->stage = ORDERED_SCAN_DEPLETED;
+				break;
+			case ORDERED_SCAN_DEPLETED:
+				return NULL;
+			default:
+				ASSERT(false);
+				return NULL;
+		}
+	}
+}
+
+static OpResult OrderedIndexScanReset
+(
+	OpBase *opBase
+) {
+	OrderedIndexScan *op = (OrderedIndexScan *)opBase;
+
+	_ReleaseState(op);
+	_Prepare(op);
+
+	return OP_OK;
+}
+
+static OpBase *OrderedIndexScanClone
+(
+	const ExecutionPlan *plan,
+	const OpBase *opBase
+) {
+	ASSERT(opBase->type == OPType_NODE_BY_ORDERED_INDEX_SCAN);
+	OrderedIndexScan *op = (OrderedIndexScan *)opBase;
+
+	OrderedIndexScan *clone = (OrderedIndexScan *)NewOrderedIndexScanOp(plan,
+			NodeScanCtx_Clone(op->n), op->attr, op->descending);
+	clone->skip  = op->skip;
+	clone->limit = op->limit;
+
+	return (OpBase *)clone;
+}
+
+static void OrderedIndexScanFree
+(
+	OpBase *opBase
+) {
+	OrderedIndexScan *op = (OrderedIndexScan *)opBase;
+
+	_ReleaseState(op);
+
+	if(op->batch != NULL) {
+		rm_free(op->batch);
+		op->batch = NULL;
+	}
+
+	if(op->attr != NULL) {
+		rm_free(op->attr);
+		op->attr = NULL;
+	}
+
+	if(op->n != NULL) {
+		NodeScanCtx_Free(op->n);
+		op->n = NULL;
+	}
+}
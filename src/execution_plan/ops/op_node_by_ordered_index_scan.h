@@ -0,0 +1,63 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "op.h"
+#include "shared/scan_functions.h"
+#include "../execution_plan.h"
+#include "../../graph/graph.h"
+#include "../../index/index.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+
+// OrderedIndexScan, scans a label in the order of an indexed attribute
+// replacing a label scan followed by a sort
+//
+// nodes are produced in the same order a sort by the attribute would produce
+// numeric values come from the index's ordered tree in batches, nodes missing
+// the attribute sort last (first when descending) and are located by scanning
+// the label matrix
+// in case the index is missing or the attribute holds values the tree can't
+// order, the operation falls back to sorting the entire label
+
+typedef enum {
+	ORDERED_SCAN_TREE,      // produce nodes from the ordered tree
+	ORDERED_SCAN_NULLS,     // produce nodes missing the attribute
+	ORDERED_SCAN_SORTED,    // produce nodes sorted by the fallback path
+	ORDERED_SCAN_DEPLETED,  // done
+} OrderedScanStage;
+
+typedef struct {
+	OpBase op;
+	Graph *g;
+	NodeScanCtx *n;               // label data of node being scanned
+	uint nodeRecIdx;              // node position within record
+	char *attr;                   // attribute to order by
+	Attribute_ID attr_id;         // attribute ID to order by
+	bool descending;              // scan in descending order
+	uint limit;                   // number of records required by parent ops
+	uint skip;                    // number of records skipped by parent ops
+	OrderedScanStage stage;       // current stage
+	const OrderedIndex *oi;       // ordered index
+	BTreeIterator iter;           // ordered tree iterator
+	BTreeEntry *batch;            // current batch of tree entries
+	uint32_t batch_cap;           // batch capacity
+	uint32_t batch_len;           // number of entries in batch
+	uint32_t batch_idx;           // next entry to produce
+	uint64_t nulls;               // number of nodes missing the attribute
+	RG_MatrixTupleIter label_it;  // label matrix iterator
+	EntityID *sorted;             // node IDs sorted by the fallback path
+	uint64_t sorted_idx;          // next node to produce
+} OrderedIndexScan;
+
+// creates a new OrderedIndexScan operation
+OpBase *NewOrderedIndexScanOp
+(
+	const ExecutionPlan *plan,  // execution plan
+	NodeScanCtx *n,             // node to scan
+	const char *attr,           // attribute to order by
+	bool descending             // scan in descending order
+);
@@ -58,7 +58,10 @@ static Record ResultsConsume(OpBase *opBase) {
 	if(!r) return NULL;
 
 	// append to final result set
-	ResultSet_AddRecord(op->result_set, r);
+	if(ResultSet_AddRecord(op->result_set, r) == RESULTSET_FULL) {
+		// client disconnected, stop producing records
+		op->result_set_size_limit = 0;
+	}
 	return r;
 }
 
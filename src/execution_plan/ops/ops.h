@@ -23,6 +23,7 @@
 #include "op_foreach.h"
 #include "op_optional.h"
 #include "op_argument.h"
+#include "op_load_csv.h"
 #include "op_distinct.h"
 #include "op_aggregate.h"
 #include "op_semi_apply.h"
@@ -39,5 +40,6 @@
 #include "op_edge_by_index_scan.h"
 #include "op_node_by_label_scan.h"
 #include "op_node_by_index_scan.h"
+#include "op_node_by_ordered_index_scan.h"
 #include "op_conditional_traverse.h"
 #include "op_cond_var_len_traverse.h"
@@ -61,37 +61,39 @@ static void _CommitNodes
 	GraphContext *gc                  = QueryCtx_GetGraphCtx();
 	Graph        *g                   = gc->g;
 	uint         node_count           = array_len(pending->created_nodes);
-	bool         constraint_violation = false;
 
 	// sync policy should be set to NOP, no need to sync/resize
 	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_NOP);
 
+	// introduce nodes into graph
+	// matrices are updated in bulk, grouping nodes by label
+	CreateNodes(gc, pending->created_nodes, pending->node_labels,
+			pending->node_attributes, node_count, true);
+
+	// index created nodes in bulk
+	// constraints are enforced via indices, as such indices must be updated
+	// prior to constraint enforcement
+	QueryCtx_ApplyIndexChanges();
+
+	//--------------------------------------------------------------------------
+	// enforce constraints
+	//--------------------------------------------------------------------------
+
 	for(int i = 0; i < node_count; i++) {
 		n = pending->created_nodes[i];
 
-		AttributeSet attr        = pending->node_attributes[i];
-		int*         labels      = pending->node_labels[i];
-		uint         label_count = array_len(labels);
-
-		// introduce node into graph
-		CreateNode(gc, n, labels, label_count, attr, true);
-
-		//----------------------------------------------------------------------
-		// enforce constraints
-		//----------------------------------------------------------------------
-
-		if(constraint_violation == false) {
-			for(uint j = 0; j < label_count; j++) {
-				Schema *s = GraphContext_GetSchemaByID(gc, labels[j], SCHEMA_NODE);
-				char *err_msg = NULL;
-				if(!Schema_EnforceConstraints(s, (GraphEntity*)n, &err_msg)) {
-					// constraint violation
-					ASSERT(err_msg != NULL);
-					constraint_violation = true;
-					ErrorCtx_SetError("%s", err_msg);
-					free(err_msg);
-					break;
-				}
+		int*  labels      = pending->node_labels[i];
+		uint  label_count = array_len(labels);
+
+		for(uint j = 0; j < label_count; j++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[j], SCHEMA_NODE);
+			char *err_msg = NULL;
+			if(!Schema_EnforceConstraints(s, (GraphEntity*)n, &err_msg)) {
+				// constraint violation
+				ASSERT(err_msg != NULL);
+				ErrorCtx_SetError("%s", err_msg);
+				free(err_msg);
+				return;
 			}
 		}
 	}
@@ -139,37 +141,48 @@ static void _CommitEdges
 	GraphContext *gc                  = QueryCtx_GetGraphCtx();
 	Graph        *g                   = gc->g;
 	uint         edge_count           = array_len(pending->created_edges);
-	bool         constraint_violation = false;
 
 	// sync policy should be set to NOP, no need to sync/resize
 	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_NOP);
 
+	// resolve relationship types
+	// edges of the same blueprint share the same type
+	Schema *s = NULL;
 	for(int i = 0; i < edge_count; i++) {
 		e = pending->created_edges[i];
-		NodeID src_id  = Edge_GetSrcNodeID(e);
-		NodeID dest_id = Edge_GetDestNodeID(e);
-		AttributeSet attr = pending->edge_attributes[i];
+		if(s == NULL || strcmp(Schema_GetName(s), e->relationship) != 0) {
+			s = GraphContext_GetSchema(gc, e->relationship, SCHEMA_EDGE);
+			// all schemas have been created in the edge blueprint loop or earlier
+			ASSERT(s != NULL);
+		}
+		e->relationID = Schema_GetID(s);
+	}
 
-		Schema *s = GraphContext_GetSchema(gc, e->relationship, SCHEMA_EDGE);
-		// all schemas have been created in the edge blueprint loop or earlier
-		ASSERT(s != NULL);
-		int relation_id = Schema_GetID(s);
+	// introduce edges into graph
+	// matrices are updated in bulk, grouping edges by relationship type
+	CreateEdges(gc, pending->created_edges, pending->edge_attributes,
+			edge_count, true);
 
-		CreateEdge(gc, e, src_id, dest_id, relation_id, attr, true);
+	// index created edges in bulk
+	// constraints are enforced via indices, as such indices must be updated
+	// prior to constraint enforcement
+	QueryCtx_ApplyIndexChanges();
 
-		//----------------------------------------------------------------------
-		// enforce constraints
-		//----------------------------------------------------------------------
+	//--------------------------------------------------------------------------
+	// enforce constraints
+	//--------------------------------------------------------------------------
 
-		if(constraint_violation == false) {
-			char *err_msg = NULL;
-			if(!Schema_EnforceConstraints(s, (GraphEntity*)e, &err_msg)) {
-				// constraint violated!
-				ASSERT(err_msg != NULL);
-				constraint_violation = true;
-				ErrorCtx_SetError("%s", err_msg);
-				free(err_msg);
-			}
+	for(int i = 0; i < edge_count; i++) {
+		e = pending->created_edges[i];
+		Schema *s = GraphContext_GetSchemaByID(gc, Edge_GetRelationID(e),
+				SCHEMA_EDGE);
+		char *err_msg = NULL;
+		if(!Schema_EnforceConstraints(s, (GraphEntity*)e, &err_msg)) {
+			// constraint violated!
+			ASSERT(err_msg != NULL);
+			ErrorCtx_SetError("%s", err_msg);
+			free(err_msg);
+			return;
 		}
 	}
 }
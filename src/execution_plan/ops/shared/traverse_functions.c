@@ -5,6 +5,7 @@
  */
 #include "traverse_functions.h"
 #include "../../../query_ctx.h"
+#include "../../../util/simple_timer.h"
 
 // collect edges between the source and destination nodes
 static void _Traverse_CollectEdges
@@ -169,3 +170,32 @@ void EdgeTraverseCtx_Free
 	rm_free(edge_ctx);
 }
 
+// evaluate traversal expression into M
+void Traverse_Eval
+(
+	OpBase *op,               // traversal op
+	AlgebraicExpression *ae,  // expression to evaluate
+	RG_Matrix M               // [output] result matrix
+) {
+	ASSERT(op != NULL);
+	ASSERT(ae != NULL);
+	ASSERT(M  != NULL);
+
+	OpStats *stats = op->stats;
+
+	// op isn't profiled
+	if(stats == NULL) {
+		AlgebraicExpression_Eval(ae, M);
+		return;
+	}
+
+	double tic[2];
+	simple_tic(tic);
+	AlgebraicExpression_Eval(ae, M);
+	stats->profileGrBTime += simple_toc(tic) * 1000;  // milliseconds
+
+	GrB_Index nvals;
+	RG_Matrix_nvals(&nvals, M);
+	stats->profileGrB       = true;
+	stats->profileGrBNvals += nvals;
+}
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "../op.h"
 #include "../../execution_plan.h"
 #include "../../../arithmetic/algebraic_expression.h"
 
@@ -61,3 +62,13 @@ void EdgeTraverseCtx_Free
 	EdgeTraverseCtx *edge_ctx
 );
 
+
+// evaluate traversal expression into M
+// when op is profiled, evaluation time and the number of entries in M
+// are accumulated into op's statistics
+void Traverse_Eval
+(
+	OpBase *op,               // traversal op
+	AlgebraicExpression *ae,  // expression to evaluate
+	RG_Matrix M               // [output] result matrix
+);
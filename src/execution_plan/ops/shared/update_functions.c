@@ -50,7 +50,6 @@ void CommitUpdates
 	ASSERT(type    != ENTITY_UNKNOWN);
 
 	uint update_count         = HashTableElemCount(updates);
-	bool constraint_violation = false;
 
 	// return early if no updates are enqueued
 	if(update_count == 0) return;
@@ -78,42 +77,56 @@ void CommitUpdates
 				update->remove_labels, array_len(update->add_labels),
 				array_len(update->remove_labels), true);
 		}
+	}
+	Graph_SetMatrixPolicy(gc->g, policy);
+	HashTableReleaseIterator(it);
 
-		//----------------------------------------------------------------------
-		// enforce constraints
-		//----------------------------------------------------------------------
+	// reindex updated entities in bulk
+	// constraints are enforced via indices, as such indices must be updated
+	// prior to constraint enforcement
+	QueryCtx_ApplyIndexChanges();
 
-		if(constraint_violation == false) {
-			// retrieve labels/rel-type
-			uint label_count = 1;
-			if (type == ENTITY_NODE) {
-				label_count = Graph_LabelTypeCount(gc->g);
-			}
-			LabelID labels[label_count];
-			if (type == ENTITY_NODE) {
-				label_count = Graph_GetNodeLabels(gc->g, (Node*)update->ge, labels,
-						label_count);
-			} else {
-				labels[0] = Edge_GetRelationID((Edge*)update->ge);
-			}
+	//--------------------------------------------------------------------------
+	// enforce constraints
+	//--------------------------------------------------------------------------
 
-			SchemaType stype = type == ENTITY_NODE ? SCHEMA_NODE : SCHEMA_EDGE;
-			for(uint i = 0; i < label_count; i ++) {
-				Schema *s = GraphContext_GetSchemaByID(gc, labels[i], stype);
-				// TODO: a bit wasteful need to target relevant constraints only
-				char *err_msg = NULL;
-				if(!Schema_EnforceConstraints(s, update->ge, &err_msg)) {
-					// constraint violation
-					ASSERT(err_msg != NULL);
-					constraint_violation = true;
-					ErrorCtx_SetError("%s", err_msg);
-					free(err_msg);
-					break;
-				}
+	it = HashTableGetIterator(updates);
+	while((entry = HashTableNext(it)) != NULL) {
+		PendingUpdateCtx *update = HashTableGetVal(entry);
+
+		if(GraphEntity_IsDeleted(update->ge)) continue;
+
+		// retrieve labels/rel-type
+		uint label_count = 1;
+		if (type == ENTITY_NODE) {
+			label_count = Graph_LabelTypeCount(gc->g);
+		}
+		LabelID labels[label_count];
+		if (type == ENTITY_NODE) {
+			label_count = Graph_GetNodeLabels(gc->g, (Node*)update->ge, labels,
+					label_count);
+		} else {
+			labels[0] = Edge_GetRelationID((Edge*)update->ge);
+		}
+
+		bool constraint_violation = false;
+		SchemaType stype = type == ENTITY_NODE ? SCHEMA_NODE : SCHEMA_EDGE;
+		for(uint i = 0; i < label_count; i ++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[i], stype);
+			// TODO: a bit wasteful need to target relevant constraints only
+			char *err_msg = NULL;
+			if(!Schema_EnforceConstraints(s, update->ge, &err_msg)) {
+				// constraint violation
+				ASSERT(err_msg != NULL);
+				constraint_violation = true;
+				ErrorCtx_SetError("%s", err_msg);
+				free(err_msg);
+				break;
 			}
 		}
+
+		if(constraint_violation) break;
 	}
-	Graph_SetMatrixPolicy(gc->g, policy);
 	HashTableReleaseIterator(it);
 }
 
@@ -8,6 +8,7 @@
 #include "../ops/op_sort.h"
 #include "../ops/op_limit.h"
 #include "../ops/op_expand_into.h"
+#include "../ops/op_node_by_ordered_index_scan.h"
 #include "../ops/op_conditional_traverse.h"
 
 /* applyLimit will traverse the given execution plan looking for Limit operations.
@@ -41,6 +42,9 @@ static void notify_limit(OpBase *op, uint limit) {
 		case OPType_CONDITIONAL_TRAVERSE:
 			((OpCondTraverse *)op)->record_cap = limit;
 			break;
+		case OPType_NODE_BY_ORDERED_INDEX_SCAN:
+			((OrderedIndexScan *)op)->limit = limit;
+			break;
 		default:
 			break;
 	}
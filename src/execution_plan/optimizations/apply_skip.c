@@ -7,6 +7,7 @@
 #include "../ops/op.h"
 #include "../ops/op_sort.h"
 #include "../ops/op_skip.h"
+#include "../ops/op_node_by_ordered_index_scan.h"
 
 /* applySkip will traverse the given execution plan looking for Skip operations.
  * Once one is found, all relevant child operations (e.g. Sort) will be
@@ -25,6 +26,9 @@ static void notify_skip(OpBase *op, uint skip) {
 		case OPType_SORT:
 			((OpSort *)op)->skip = skip;
 			break;
+		case OPType_NODE_BY_ORDERED_INDEX_SCAN:
+			((OrderedIndexScan *)op)->skip = skip;
+			break;
 		default:
 			break;
 	}
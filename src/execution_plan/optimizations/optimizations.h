@@ -22,6 +22,7 @@ void orderExpressions(
 void compactFilters(ExecutionPlan *plan);
 void reduceScans(ExecutionPlan *plan);
 void utilizeIndices(ExecutionPlan *plan);
+void reduceSort(ExecutionPlan *plan);
 void seekByID(ExecutionPlan *plan);
 void filterVariableLengthEdges(ExecutionPlan *plan);
 void reduceCartesianProductStreamCount(ExecutionPlan *plan);
@@ -30,6 +31,7 @@ void reduceFilters(ExecutionPlan *plan);
 void reduceTraversal(ExecutionPlan *plan);
 void reduceDistinct(ExecutionPlan *plan);
 void reduceCount(ExecutionPlan *plan);
+void utilizeCoveringIndices(ExecutionPlan *plan);
 void applyLimit(ExecutionPlan *plan);
 void applySkip(ExecutionPlan *plan);
 void optimizeLabelScan(ExecutionPlan *plan);
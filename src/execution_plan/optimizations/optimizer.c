@@ -27,6 +27,9 @@ void optimizePlan(ExecutionPlan *plan) {
 	// when possible, replace label scan and filter ops with index scans
 	utilizeIndices(plan);
 
+	// when possible, replace label scan and sort ops with an ordered index scan
+	reduceSort(plan);
+
 	// scan label with least entities
 	optimizeLabelScan(plan);
 
@@ -55,6 +58,9 @@ void optimizePlan(ExecutionPlan *plan) {
 	// try to reduce execution plan incase it perform node or edge counting
 	reduceCount(plan);
 
+	// when possible, populate nodes directly from the index they're scanned by
+	utilizeCoveringIndices(plan);
+
 	// let operations know about specified limit(s)
 	applyLimit(plan);
 
@@ -0,0 +1,116 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../../query_ctx.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_project.h"
+#include "../execution_plan.h"
+#include "../../ast/ast_build_op_contexts.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../ops/op_node_by_ordered_index_scan.h"
+#include "../execution_plan_build/execution_plan_util.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// a sort by a single indexed node attribute, applied to the output of a label
+// scan is unnecessary, as the index can produce the labeled nodes already
+// ordered. this optimization looks for the pattern:
+//
+// Sort
+//     Project
+//         Filter (zero or more)
+//             Node By Label Scan
+//
+// where the sort key is an attribute of the scanned node covered by an
+// exact-match index, in which case the sort and label scan are replaced by
+// an ordered index scan. filters preserve their input order and remain in place
+
+// returns the projected expression named 'name'
+static AR_ExpNode *_ProjectedExp
+(
+	const OpProject *project,
+	const char *name
+) {
+	uint n = array_len(project->exps);
+	for(uint i = 0; i < n; i++) {
+		AR_ExpNode *exp = project->exps[i];
+		if(strcmp(exp->resolved_name, name) == 0) return exp;
+	}
+	return NULL;
+}
+
+static void _reduceSort
+(
+	ExecutionPlan *plan,
+	OpSort *sort
+) {
+	// sort by a single expression
+	if(array_len(sort->exps) != 1) return;
+
+	OpBase *child = sort->op.children[0];
+	if(child->type != OPType_PROJECT || child->childCount != 1) return;
+
+	// sort expression should be an attribute access n.v
+	char *attr;
+	AR_ExpNode *exp = _ProjectedExp((OpProject *)child,
+			sort->exps[0]->resolved_name);
+	if(exp == NULL || !AR_EXP_IsAttribute(exp, &attr)) return;
+
+	AR_ExpNode *entity = exp->op.children[0];
+	if(!AR_EXP_IsVariadic(entity)) return;
+	const char *alias = entity->operand.variadic.entity_alias;
+
+	// skip order preserving filters
+	OpBase *op = child->children[0];
+	while(op->type == OPType_FILTER) op = op->children[0];
+
+	// nodes should be produced by a label scan over the sorted entity
+	if(op->type != OPType_NODE_BY_LABEL_SCAN || op->childCount != 0) return;
+
+	NodeByLabelScan *scan = (NodeByLabelScan *)op;
+	if(strcmp(scan->n->alias, alias) != 0) return;
+	if(scan->n->label_id == GRAPH_UNKNOWN_LABEL) return;
+
+	// attribute must be indexed
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+
+	Index idx = GraphContext_GetIndexByID(gc, scan->n->label_id, &attr_id, 1,
+			IDX_EXACT_MATCH, GETYPE_NODE);
+	if(idx == NULL || Index_GetOrderedIndex(idx, attr_id) == NULL) return;
+
+	bool descending = (sort->directions[0] == DIR_DESC);
+	OpBase *ordered = NewOrderedIndexScanOp(scan->op.plan, scan->n, attr,
+			descending);
+	scan->n = NULL;
+
+	// replace label scan with the ordered scan
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, ordered);
+	OpBase_Free((OpBase *)scan);
+
+	// remove redundant sort
+	ExecutionPlan_RemoveOp(plan, (OpBase *)sort);
+	OpBase_Free((OpBase *)sort);
+}
+
+void reduceSort
+(
+	ExecutionPlan *plan
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	// return immediately if the graph has no indices
+	if(!GraphContext_HasIndices(gc)) return;
+
+	OpBase **sorts = ExecutionPlan_CollectOps(plan->root, OPType_SORT);
+
+	uint n = array_len(sorts);
+	for(uint i = 0; i < n; i++) {
+		_reduceSort(plan, (OpSort *)sorts[i]);
+	}
+
+	array_free(sorts);
+}
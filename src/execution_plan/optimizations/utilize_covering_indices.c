@@ -0,0 +1,204 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../../query_ctx.h"
+#include "../ops/op_filter.h"
+#include "../ops/op_project.h"
+#include "../ops/op_aggregate.h"
+#include "../execution_plan.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../execution_plan_build/execution_plan_util.h"
+
+// an index scan fetches each node from the graph such that its attributes can
+// be accessed by the operations following the scan, when these operations only
+// access attributes covered by the index, nodes can be populated straight from
+// the index. this optimization looks for the pattern:
+//
+// Project / Aggregate
+//     Filter (zero or more)
+//         Node By Index Scan
+//
+// where every reference to the scanned node is an access to an indexed
+// attribute, in which case the index scan is switched to an index-only scan
+// the scanned node doesn't outlive the projection, as long as the projection
+// doesn't return the node itself
+//
+// nodes produced by an index-only scan point to the index's copy of their
+// attributes, as such the optimization is limited to read-only queries
+
+// returns true if 'exp' only refers to 'alias' via covered attributes
+static bool _ExpCovered
+(
+	const AR_ExpNode *exp,        // expression to inspect
+	const char *alias,            // scanned node alias
+	const CoveringIndex *covering // index's covered attributes
+) {
+	if(exp->type == AR_EXP_OPERAND) {
+		switch(exp->operand.type) {
+			case AR_EXP_VARIADIC:
+				// direct reference to the scanned node
+				return strcmp(exp->operand.variadic.entity_alias, alias) != 0;
+			case AR_EXP_BORROW_RECORD:
+				// entire record is exposed
+				return false;
+			default:
+				return true;
+		}
+	}
+
+	ASSERT(exp->type == AR_EXP_OP);
+
+	// attribute access n.v
+	char *attr;
+	if(AR_EXP_IsAttribute(exp, &attr)) {
+		AR_ExpNode *entity = exp->op.children[0];
+		if(AR_EXP_IsVariadic(entity) &&
+		   strcmp(entity->operand.variadic.entity_alias, alias) == 0) {
+			GraphContext *gc = QueryCtx_GetGraphCtx();
+			Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+			return attr_id != ATTRIBUTE_ID_NONE &&
+				CoveringIndex_Covers(covering, attr_id);
+		}
+	}
+
+	// functions such as list comprehensions hold expressions in their
+	// private data, which are not reachable via the expression's children
+	const AR_FuncDesc *f = exp->op.f;
+	if(exp->op.private_data != NULL && !f->aggregate &&
+	   f->callbacks.new_private_data == NULL) {
+		return false;
+	}
+
+	for(int i = 0; i < exp->op.child_count; i++) {
+		if(!_ExpCovered(exp->op.children[i], alias, covering)) return false;
+	}
+
+	return true;
+}
+
+static bool _ExpsCovered
+(
+	AR_ExpNode **exps,             // expressions to inspect
+	const char *alias,             // scanned node alias
+	const CoveringIndex *covering  // index's covered attributes
+) {
+	uint n = array_len(exps);
+	for(uint i = 0; i < n; i++) {
+		if(!_ExpCovered(exps[i], alias, covering)) return false;
+	}
+	return true;
+}
+
+// returns true if filter tree only refers to 'alias' via covered attributes
+static bool _FilterCovered
+(
+	const FT_FilterNode *tree,     // filter tree to inspect
+	const char *alias,             // scanned node alias
+	const CoveringIndex *covering  // index's covered attributes
+) {
+	if(tree == NULL) return true;
+
+	switch(tree->t) {
+		case FT_N_EXP:
+			return _ExpCovered(tree->exp.exp, alias, covering);
+		case FT_N_PRED:
+			return _ExpCovered(tree->pred.lhs, alias, covering) &&
+				   _ExpCovered(tree->pred.rhs, alias, covering);
+		case FT_N_COND:
+			return _FilterCovered(tree->cond.left, alias, covering) &&
+				   _FilterCovered(tree->cond.right, alias, covering);
+		default:
+			ASSERT(false);
+			return false;
+	}
+}
+
+// returns true if op-tree rooted at 'op' contains a writer operation
+static bool _ContainsWriter
+(
+	const OpBase *op
+) {
+	if(OpBase_IsWriter((OpBase *)op)) return true;
+
+	for(int i = 0; i < op->childCount; i++) {
+		if(_ContainsWriter(op->children[i])) return true;
+	}
+
+	return false;
+}
+
+static void _utilizeCoveringIndex
+(
+	IndexScan *scan
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	const char *alias = scan->n->alias;
+
+	// combined indices evaluate filters over attributes of other labels
+	if(scan->combine != INDEX_COMBINE_NONE) return;
+
+	// locate scanned label's index
+	if(scan->n->label_id == GRAPH_UNKNOWN_LABEL) return;
+	Index idx = GraphContext_GetIndexByID(gc, scan->n->label_id, NULL, 0,
+			IDX_EXACT_MATCH, GETYPE_NODE);
+	if(idx == NULL || Index_RSIndex(idx) != scan->idx) return;
+
+	const CoveringIndex *covering = Index_GetCoveringIndex(idx);
+	if(covering == NULL) return;
+
+	// scan's own filters
+	if(!_FilterCovered(scan->filter, alias, covering)) return;
+
+	// skip filters
+	OpBase *op = scan->op.parent;
+	while(op != NULL && op->type == OPType_FILTER) {
+		if(op->childCount != 1) return;
+		OpFilter *filter = (OpFilter *)op;
+		if(!_FilterCovered(filter->filterTree, alias, covering)) return;
+		op = op->parent;
+	}
+
+	// scanned node should be dropped by a projection
+	if(op == NULL) return;
+
+	if(op->type == OPType_PROJECT) {
+		OpProject *project = (OpProject *)op;
+		if(!_ExpsCovered(project->exps, alias, covering)) return;
+	} else if(op->type == OPType_AGGREGATE) {
+		OpAggregate *aggregate = (OpAggregate *)op;
+		if(!_ExpsCovered(aggregate->key_exps, alias, covering)) return;
+		if(!_ExpsCovered(aggregate->aggregate_exps, alias, covering)) return;
+	} else {
+		return;
+	}
+
+	IndexScanOp_UseCoveringIndex(scan, covering);
+}
+
+void utilizeCoveringIndices
+(
+	ExecutionPlan *plan
+) {
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	// return immediately if the graph has no indices
+	if(!GraphContext_HasIndices(gc)) return;
+
+	// index-only scans expose the index's copy of node attributes
+	// which might be modified by the query
+	if(_ContainsWriter(plan->root)) return;
+
+	OpBase **scans = ExecutionPlan_CollectOps(plan->root,
+			OPType_NODE_BY_INDEX_SCAN);
+
+	uint n = array_len(scans);
+	for(uint i = 0; i < n; i++) {
+		_utilizeCoveringIndex((IndexScan *)scans[i]);
+	}
+
+	array_free(scans);
+}
+
@@ -286,6 +286,289 @@ static FT_FilterNode *_Concat_Filters(OpFilter **filter_ops) {
 	return root;
 }
 
+//------------------------------------------------------------------------------
+// Selectivity estimation
+//------------------------------------------------------------------------------
+
+// default selectivities, used in the absence of attribute statistics
+#define EQUALITY_SELECTIVITY 0.05
+#define RANGE_SELECTIVITY    0.3
+#define DISTANCE_SELECTIVITY 0.1
+
+// an additional index is intersected with the scanned index if the number of
+// nodes it is expected to match is within this factor of the scanned index's
+// estimate, beyond it evaluating filters on the scanned nodes is cheaper
+#define INDEX_INTERSECT_MAX_RATIO 16
+
+// estimate the fraction of indexed nodes passing filter
+static double _FilterSelectivity
+(
+	FT_FilterNode *filter
+) {
+	if(isDistanceFilter(filter)) return DISTANCE_SELECTIVITY;
+
+	if(isInFilter(filter)) {
+		SIValue list = SI_NullVal();
+		AR_EXP_ReduceToScalar(filter->exp.exp->op.children[1], true, &list);
+		if(SI_TYPE(list) != T_ARRAY) return RANGE_SELECTIVITY;
+		return MIN(1.0, SIArray_Length(list) * EQUALITY_SELECTIVITY);
+	}
+
+	double l;
+	double r;
+	switch(filter->t) {
+		case FT_N_PRED:
+			return (filter->pred.op == OP_EQUAL) ?
+				EQUALITY_SELECTIVITY : RANGE_SELECTIVITY;
+		case FT_N_COND:
+			l = _FilterSelectivity(filter->cond.left);
+			r = _FilterSelectivity(filter->cond.right);
+			if(filter->cond.op == OP_AND) return l * r;
+			return l + r - l * r;
+		default:
+			return 1.0;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Index combination
+//------------------------------------------------------------------------------
+
+// index which can be utilized by a scanned node label
+typedef struct {
+	int label_id;        // label ID
+	const char *label;   // label
+	Index idx;           // label's exact-match index
+	OpFilter **filters;  // filters resolved by index
+	double estimate;     // expected number of matching nodes
+} IndexCandidate;
+
+// estimate the number of nodes matched by candidate's filters
+static void _EstimateCandidate
+(
+	IndexCandidate *c
+) {
+	Graph *g = QueryCtx_GetGraph();
+
+	c->estimate = Graph_LabeledNodeCount(g, c->label_id);
+	uint n = array_len(c->filters);
+	for(uint i = 0; i < n; i++) {
+		c->estimate *= _FilterSelectivity(c->filters[i]->filterTree);
+	}
+}
+
+static inline bool _ContainsFilter
+(
+	OpFilter **filters,
+	const OpFilter *filter
+) {
+	uint n = array_len(filters);
+	for(uint i = 0; i < n; i++) {
+		if(filters[i] == filter) return true;
+	}
+	return false;
+}
+
+// collect disjuncts of an OR filter tree
+static void _CollectDisjuncts
+(
+	FT_FilterNode *filter,      // filter tree
+	FT_FilterNode ***disjuncts  // [output] disjuncts
+) {
+	if(filter->t == FT_N_COND && filter->cond.op == OP_OR) {
+		_CollectDisjuncts(filter->cond.left,  disjuncts);
+		_CollectDisjuncts(filter->cond.right, disjuncts);
+	} else {
+		array_append(*disjuncts, filter);
+	}
+}
+
+// try to resolve an OR filter using multiple label indices
+// each disjunct must be resolvable by one of the candidates indices
+// on success returns the number of candidates utilized, candidates' filters
+// hold the disjuncts they resolve, combined into a single filter tree
+static uint _UnionCandidates
+(
+	const char *alias,             // scanned node alias
+	FT_FilterNode *filter,         // OR filter
+	IndexCandidate *candidates,    // candidates, one per indexed label
+	FT_FilterNode **trees          // [output] disjuncts resolved by candidate
+) {
+	uint n = array_len(candidates);
+	if(filter->t != FT_N_COND || filter->cond.op != OP_OR) return 0;
+
+	FT_FilterNode **disjuncts = array_new(FT_FilterNode *, 2);
+	_CollectDisjuncts(filter, &disjuncts);
+
+	bool resolved = true;
+	uint utilized = 0;
+	uint disjunct_count = array_len(disjuncts);
+
+	for(uint i = 0; i < n; i++) trees[i] = NULL;
+
+	for(uint i = 0; i < disjunct_count && resolved; i++) {
+		resolved = false;
+		for(uint j = 0; j < n; j++) {
+			FT_FilterNode *disjunct = FilterTree_Clone(disjuncts[i]);
+			if(!_applicableFilter(alias, candidates[j].idx, &disjunct)) {
+				FilterTree_Free(disjunct);
+				continue;
+			}
+
+			// group disjuncts resolved by the same index
+			if(trees[j] == NULL) {
+				trees[j] = disjunct;
+				utilized++;
+			} else {
+				FT_FilterNode *or = FilterTree_CreateConditionFilter(OP_OR);
+				FilterTree_AppendLeftChild(or, trees[j]);
+				FilterTree_AppendRightChild(or, disjunct);
+				trees[j] = or;
+			}
+
+			resolved = true;
+			break;
+		}
+	}
+
+	// a union requires at least two indices
+	// a single index would have resolved the entire filter
+	if(!resolved || utilized < 2) {
+		for(uint i = 0; i < n; i++) {
+			if(trees[i] != NULL) FilterTree_Free(trees[i]);
+			trees[i] = NULL;
+		}
+		utilized = 0;
+	}
+
+	array_free(disjuncts);
+	return utilized;
+}
+
+// switch the label scanned by 'scan'
+// the previously scanned label is checked by the traversal which followed the
+// newly scanned label
+static void _SwapScannedLabel
+(
+	NodeByLabelScan *scan,  // label scan
+	int label_id,           // label to scan
+	const char *label       // label to scan
+) {
+	if(scan->n->label_id == label_id) return;
+
+	// the scanned label does not match the one we will build an
+	// index scan over, update the traversal expression to
+	// remove the indexed label and insert the previously-scanned label
+	OpBase *parent = scan->op.parent;
+	// skip filters
+	while(OpBase_Type(parent) == OPType_FILTER) parent = parent->parent;
+	if(OpBase_Type(parent) == OPType_CONDITIONAL_TRAVERSE) {
+		OpCondTraverse *op_traverse = (OpCondTraverse*)parent;
+		AlgebraicExpression *ae = op_traverse->ae;
+		AlgebraicExpression *operand;
+
+		const char *row_domain = scan->n->alias;
+		const char *column_domain = scan->n->alias;
+
+		bool found = AlgebraicExpression_LocateOperand(ae, &operand, NULL,
+				row_domain, column_domain, NULL, label);
+		ASSERT(found == true);
+
+		AlgebraicExpression *replacement = AlgebraicExpression_NewOperand(NULL,
+				true, AlgebraicExpression_Src(operand),
+				AlgebraicExpression_Dest(operand), NULL, scan->n->label);
+
+		_AlgebraicExpression_InplaceRepurpose(operand, replacement);
+	}
+
+	scan->n->label = label;
+	scan->n->label_id = label_id;
+}
+
+// remove and free filter ops
+static void _RemoveFilters
+(
+	ExecutionPlan *plan,
+	OpFilter **filters
+) {
+	// since this is a chain of single-child operations
+	// all operations are replaced in-place
+	// avoiding problems with stream-sensitive ops like SemiApply
+	uint n = array_len(filters);
+	for(uint i = 0; i < n; i++) {
+		OpFilter *filter = filters[i];
+		ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
+		OpBase_Free((OpBase *)filter);
+	}
+}
+
+// try to replace the scan and an OR filter with an index union
+// returns true if scan was replaced
+static bool _reduce_scan_op_union
+(
+	ExecutionPlan *plan,
+	NodeByLabelScan *scan,
+	IndexCandidate *candidates
+) {
+	uint n = array_len(candidates);
+	if(n < 2) return false;
+
+	const char *alias = scan->n->alias;
+	FT_FilterNode *trees[n];
+
+	OpBase *current = scan->op.parent;
+	while(current->type == OPType_FILTER) {
+		OpFilter *filter = (OpFilter *)current;
+		current = current->parent;
+
+		if(_UnionCandidates(alias, filter->filterTree, candidates, trees) == 0) {
+			continue;
+		}
+
+		// scan the utilized label with the fewest nodes
+		int driver = -1;
+		uint64_t min_nnz = UINT64_MAX;
+		Graph *g = QueryCtx_GetGraph();
+		for(uint i = 0; i < n; i++) {
+			if(trees[i] == NULL) continue;
+			uint64_t nnz = Graph_LabeledNodeCount(g, candidates[i].label_id);
+			if(nnz < min_nnz) {
+				driver  = i;
+				min_nnz = nnz;
+			}
+		}
+
+		IndexCandidate *d = candidates + driver;
+		_SwapScannedLabel(scan, d->label_id, d->label);
+
+		IndexScanSource *sources = array_new(IndexScanSource, n - 1);
+		for(uint i = 0; i < n; i++) {
+			if(trees[i] == NULL || (int)i == driver) continue;
+			IndexScanSource src = {.idx = Index_RSIndex(candidates[i].idx),
+				.label = candidates[i].label, .filter = trees[i]};
+			array_append(sources, src);
+		}
+
+		OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n,
+				Index_RSIndex(d->idx), trees[driver]);
+		IndexScanOp_CombineIndices((IndexScan *)indexOp, INDEX_COMBINE_UNION,
+				sources);
+		scan->n = NULL;
+
+		ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, indexOp);
+		OpBase_Free((OpBase *)scan);
+
+		OpFilter **filters = array_new(OpFilter *, 1);
+		array_append(filters, filter);
+		_RemoveFilters(plan, filters);
+		array_free(filters);
+
+		return true;
+	}
+
+	return false;
+}
+
 // try to replace given Label Scan operation and a set of Filter operations with
 // a single Index Scan operation
 void reduce_scan_op
@@ -294,19 +577,14 @@ void reduce_scan_op
 	NodeByLabelScan *scan
 ) {
 	// in the multi-label case, we want to pick the label which will allow us to
-	// both utilize an index and iterate over the fewest values
+	// utilize an index and iterate over the fewest values, additional label
+	// indices are combined with the scanned index when it is beneficial
 	GraphContext *gc  =  QueryCtx_GetGraphCtx();
-	Graph        *g   =  QueryCtx_GetGraph();
 	QueryGraph   *qg  =  scan->op.plan->query_graph;
 
-	// find label with filtered indexed properties
-	// that has the minimum NNZ entries
-	int         min_label_id;                 // tracks min label ID
-	uint64_t    min_nnz        = UINT64_MAX;  // tracks min entries
-	RSIndex     *rs_idx        = NULL;        // the index to be applied
-	OpFilter    **filters      = NULL;        // tracks indexed filters to apply
-	uint        filters_count  = 0;           // number of matching filters
-	const char  *min_label_str = NULL;        // tracks min label name
+	IndexCandidate *candidates = array_new(IndexCandidate, 1);  // label indices
+	IndexCandidate *applicable = array_new(IndexCandidate, 1);  // with filters
+	OpFilter       **consumed  = array_new(OpFilter *, 1);      // utilized filters
 
 	// see if scanned node has multiple labels
 	const char *node_alias = scan->n->alias;
@@ -315,108 +593,114 @@ void reduce_scan_op
 
 	uint label_count = QGNode_LabelCount(qn);
 	for(uint i = 0; i < label_count; i++) {
-		Index idx;
-		uint64_t nnz;
 		int label_id = QGNode_GetLabelID(qn, i);
 		const char *label = QGNode_GetLabel(qn, i);
 
 		// unknown label
 		if(label_id == GRAPH_UNKNOWN_LABEL) continue;
 
-		idx = GraphContext_GetIndexByID(gc, label_id, NULL, 0, IDX_EXACT_MATCH,
-				GETYPE_NODE);
+		Index idx = GraphContext_GetIndexByID(gc, label_id, NULL, 0,
+				IDX_EXACT_MATCH, GETYPE_NODE);
 
 		// no index for current label
 		if(idx == NULL) continue;
 
 		ASSERT(Index_Enabled(idx));
 
-		// TODO switch to reusable array
-		OpFilter **cur_filters = _applicableFilters((OpBase *)scan, scan->n->alias, idx);
+		IndexCandidate c = {.label_id = label_id, .label = label, .idx = idx,
+			.filters = NULL, .estimate = 0};
+		array_append(candidates, c);
 
-		// TODO consider heuristic which combines max
-		// number / restrictiveness of applicable filters
-		// vs. the label's NNZ?
-		uint cur_filters_count = array_len(cur_filters);
-		if(cur_filters_count == 0) {
+		c.filters = _applicableFilters((OpBase *)scan, node_alias, idx);
+		if(array_len(c.filters) == 0) {
 			// no filters
-			array_free(cur_filters);
+			array_free(c.filters);
 			continue;
 		}
 
-		// get all applicable filter for index
-		RSIndex *cur_idx = Index_RSIndex(idx);
-
-		nnz = Graph_LabeledNodeCount(g, label_id);
-		if(min_nnz > nnz) {
-			rs_idx         =  cur_idx;
-			min_nnz        =  nnz;
-			min_label_str  =  label;
-			min_label_id   =  label_id;
-
-			// swap previously stored index and
-			// filters array (if any) with current filters
-			array_free(filters);
-			filters = cur_filters;
-			filters_count = cur_filters_count;
-		}
+		_EstimateCandidate(&c);
+		array_append(applicable, c);
 	}
 
-	// no label possessed indexed and filtered attributes, return early
-	if(rs_idx == NULL) goto cleanup;
+	uint applicable_count = array_len(applicable);
+
+	// no label possessed indexed and filtered attributes
+	// try resolving a disjunction using multiple label indices
+	if(applicable_count == 0) {
+		_reduce_scan_op_union(plan, scan, candidates);
+		goto cleanup;
+	}
+
+	// scan the index expected to match the fewest nodes
+	IndexCandidate *driver = applicable;
+	for(uint i = 1; i < applicable_count; i++) {
+		if(applicable[i].estimate < driver->estimate) driver = applicable + i;
+	}
 
 	// did we found a better label to utilize? if so swap
-	if(scan->n->label_id != min_label_id) {
-		// the scanned label does not match the one we will build an
-		// index scan over, update the traversal expression to
-		// remove the indexed label and insert the previously-scanned label
-		OpBase *parent = scan->op.parent;
-		// skip filters
-		while(OpBase_Type(parent) == OPType_FILTER) parent = parent->parent;
-		if(OpBase_Type(parent) == OPType_CONDITIONAL_TRAVERSE) {
-			OpCondTraverse *op_traverse = (OpCondTraverse*)parent;
-			AlgebraicExpression *ae = op_traverse->ae;
-			AlgebraicExpression *operand;
-
-			const char *row_domain = scan->n->alias;
-			const char *column_domain = scan->n->alias;
-
-			bool found = AlgebraicExpression_LocateOperand(ae, &operand, NULL,
-					row_domain, column_domain, NULL, min_label_str);
-			ASSERT(found == true);
-
-			AlgebraicExpression *replacement = AlgebraicExpression_NewOperand(NULL,
-					true, AlgebraicExpression_Src(operand),
-					AlgebraicExpression_Dest(operand), NULL, scan->n->label);
-
-			_AlgebraicExpression_InplaceRepurpose(operand, replacement);
+	_SwapScannedLabel(scan, driver->label_id, driver->label);
+
+	FT_FilterNode *root = _Concat_Filters(driver->filters);
+	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n,
+			Index_RSIndex(driver->idx), root);
+	scan->n = NULL;
+
+	uint filters_count = array_len(driver->filters);
+	for(uint i = 0; i < filters_count; i++) {
+		array_append(consumed, driver->filters[i]);
+	}
+
+	//--------------------------------------------------------------------------
+	// intersect additional label indices
+	//--------------------------------------------------------------------------
+
+	IndexScanSource *sources = array_new(IndexScanSource, 0);
+	for(uint i = 0; i < applicable_count; i++) {
+		IndexCandidate *c = applicable + i;
+		if(c == driver) continue;
+
+		// discard filters already resolved
+		filters_count = array_len(c->filters);
+		for(uint j = 0; j < filters_count; j++) {
+			if(_ContainsFilter(consumed, c->filters[j])) {
+				array_del_fast(c->filters, j);
+				j--;
+				filters_count--;
+			}
 		}
+		if(filters_count == 0) continue;
+
+		_EstimateCandidate(c);
+		if(c->estimate > driver->estimate * INDEX_INTERSECT_MAX_RATIO) continue;
+
+		IndexScanSource src = {.idx = Index_RSIndex(c->idx), .label = c->label,
+			.filter = _Concat_Filters(c->filters)};
+		array_append(sources, src);
 
-		scan->n->label = min_label_str;
-		scan->n->label_id = min_label_id;
+		for(uint j = 0; j < filters_count; j++) {
+			array_append(consumed, c->filters[j]);
+		}
 	}
 
-	FT_FilterNode *root = _Concat_Filters(filters);
-	OpBase *indexOp = NewIndexScanOp(scan->op.plan, scan->g, scan->n, rs_idx,
-			root);
-	scan->n = NULL;
+	if(array_len(sources) > 0) {
+		IndexScanOp_CombineIndices((IndexScan *)indexOp,
+				INDEX_COMBINE_INTERSECT, sources);
+	} else {
+		array_free(sources);
+	}
 
 	// replace the redundant scan op with the newly-constructed Index Scan
 	ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, indexOp);
 	OpBase_Free((OpBase *)scan);
 
 	// remove and free all redundant filter ops
-	// since this is a chain of single-child operations
-	// all operations are replaced in-place
-	// avoiding problems with stream-sensitive ops like SemiApply
-	for(uint i = 0; i < filters_count; i++) {
-		OpFilter *filter = filters[i];
-		ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
-		OpBase_Free((OpBase *)filter);
-	}
+	_RemoveFilters(plan, consumed);
 
 cleanup:
-	array_free(filters);
+	for(uint i = 0; i < applicable_count; i++) array_free(applicable[i].filters);
+	array_free(candidates);
+	array_free(applicable);
+	array_free(consumed);
 }
 
 // try to replace given Conditional Traverse operation and a set of Filter operations with
@@ -495,14 +779,7 @@ void reduce_cond_op(ExecutionPlan *plan, OpCondTraverse *cond) {
 	OpBase_Free((OpBase *)cond);
 
 	// remove and free all redundant filter ops
-	// since this is a chain of single-child operations
-	// all operations are replaced in-place
-	// avoiding problems with stream-sensitive ops like SemiApply
-	for(uint i = 0; i < filters_count; i++) {
-		OpFilter *filter = filters[i];
-		ExecutionPlan_RemoveOp(plan, (OpBase *)filter);
-		OpBase_Free((OpBase *)filter);
-	}
+	_RemoveFilters(plan, filters);
 
 cleanup:
 	array_free(filters);
@@ -8,6 +8,7 @@
 
 #include "RG.h"
 #include "attribute_set.h"
+#include "attribute_spill.h"
 #include "../../util/rmalloc.h"
 #include "../../errors/errors.h"
 
@@ -24,6 +25,53 @@ SIValue *ATTRIBUTE_NOTFOUND = &(SIValue) {
 	.longval = 0, .type = T_NULL
 };
 
+// marks attribute as recently accessed and faults in its value if spilled
+// returns false if the value couldn't be faulted in, it remains spilled
+static inline bool _AttributeSet_Access
+(
+	Attribute *attr  // accessed attribute
+) {
+	// avoid dirtying the attribute when it is already marked
+	if(!__atomic_load_n(&attr->accessed, __ATOMIC_RELAXED)) {
+		__atomic_store_n(&attr->accessed, true, __ATOMIC_RELAXED);
+	}
+
+	if(unlikely(AttributeSpill_IsSpilled(&attr->value))) {
+		return AttributeSpill_FaultIn(&attr->value);
+	}
+
+	return true;
+}
+
+// accesses attribute's value on behalf of a reader
+// raises a runtime error if the value couldn't be faulted in
+static inline bool _AttributeSet_Read
+(
+	Attribute *attr  // accessed attribute
+) {
+	if(likely(_AttributeSet_Access(attr))) return true;
+
+	ErrorCtx_RaiseRuntimeException("Failed to read attribute value "
+			"from tiered storage");
+	return false;
+}
+
+// locates attribute within set, without accessing its value
+// returns NULL if the attribute is missing
+static Attribute *_AttributeSet_Find
+(
+	const AttributeSet set,  // set to search, read-only marker cleared
+	Attribute_ID attr_id     // attribute identifier
+) {
+	if(set == NULL || attr_id == ATTRIBUTE_ID_NONE) return NULL;
+
+	for(uint16_t i = 0; i < set->attr_count; ++i) {
+		if(attr_id == set->attributes[i].id) return set->attributes + i;
+	}
+
+	return NULL;
+}
+
 // removes an attribute from set
 static bool _AttributeSet_Remove
 (
@@ -83,8 +131,8 @@ uint16_t AttributeSet_Count
 }
 
 // retrieves a value from set
-// NOTE: if the key does not exist
-// we return the special constant value ATTRIBUTE_NOTFOUND
+// NOTE: if the key does not exist or its value can't be read from
+// tiered storage we return the special constant value ATTRIBUTE_NOTFOUND
 SIValue *AttributeSet_Get
 (
 	const AttributeSet set,  // set to retieve attribute from
@@ -93,30 +141,31 @@ SIValue *AttributeSet_Get
 	// in case attribute-set is marked as read-only, clear marker
 	AttributeSet _set = (AttributeSet)ATTRIBUTE_SET_CLEAR_MSB(set);
 
-	if(_set == NULL) {
-		return ATTRIBUTE_NOTFOUND;
-	}
-
-	if(attr_id == ATTRIBUTE_ID_NONE) {
-		return ATTRIBUTE_NOTFOUND;
-	}
-
 	// TODO: benchmark, consider alternatives:
 	// sorted set
 	// array divided in two:
 	// [attr_id_0, attr_id_1, attr_id_2, value_0, value_1, value_2]
-	for (uint16_t i = 0; i < _set->attr_count; ++i) {
-		Attribute *attr = _set->attributes + i;
-		if(attr_id == attr->id) {
-			// note, unsafe as attribute-set can get reallocated
-			// TODO: why do we return a pointer to value instead of a copy ?
-			// especially when AttributeSet_GetIdx returns SIValue
-			// note AttributeSet_Update operate on this pointer
-			return &attr->value;
-		}
-	}
+	Attribute *attr = _AttributeSet_Find(_set, attr_id);
+
+	// note, unsafe as attribute-set can get reallocated
+	// TODO: why do we return a pointer to value instead of a copy ?
+	// especially when AttributeSet_GetIdx returns SIValue
+	// note AttributeSet_Update operate on this pointer
+	if(attr == NULL || !_AttributeSet_Read(attr)) return ATTRIBUTE_NOTFOUND;
+
+	return &attr->value;
+}
+
+// returns true if set holds attribute
+bool AttributeSet_Contains
+(
+	const AttributeSet set,  // set to search
+	Attribute_ID attr_id     // attribute identifier
+) {
+	// in case attribute-set is marked as read-only, clear marker
+	AttributeSet _set = (AttributeSet)ATTRIBUTE_SET_CLEAR_MSB(set);
 
-	return ATTRIBUTE_NOTFOUND;
+	return _AttributeSet_Find(_set, attr_id) != NULL;
 }
 
 // retrieves a value from set by index
@@ -138,7 +187,7 @@ SIValue AttributeSet_GetIdx
 	Attribute *attr = _set->attributes + i;
 	*attr_id = attr->id;
 
-	return attr->value;
+	return _AttributeSet_Read(attr) ? attr->value : SI_NullVal();
 }
 
 static AttributeSet AttributeSet_AddPrepare
@@ -165,6 +214,22 @@ static AttributeSet AttributeSet_AddPrepare
 	return _set;
 }
 
+AttributeSet AttributeSet_FromAttributes
+(
+	const Attribute *attributes,  // attribute records
+	uint16_t n                    // number of attributes
+) {
+	ASSERT(attributes != NULL || n == 0);
+
+	if(n == 0) return NULL;
+
+	AttributeSet set = rm_malloc(sizeof(_AttributeSet) + n * sizeof(Attribute));
+	set->attr_count = n;
+	memcpy(set->attributes, attributes, sizeof(Attribute) * n);
+
+	return set;
+}
+
 // adds an attribute to the set without cloning the SIvalue
 void AttributeSet_AddNoClone
 (
@@ -192,7 +257,7 @@ void AttributeSet_AddNoClone
 	for(ushort i = 0; i < n; i++) {
 		ASSERT(SI_TYPE(values[i]) & t);
 		// make sure attribute isn't already in set
-		ASSERT(AttributeSet_Get(*set, ids[i]) == ATTRIBUTE_NOTFOUND);
+		ASSERT(!AttributeSet_Contains(*set, ids[i]));
 		// make sure value isn't volotile
 		ASSERT(SI_ALLOCATION(values + i) != M_VOLATILE);
 	}
@@ -205,8 +270,9 @@ void AttributeSet_AddNoClone
 	// add attributes to set
 	for(ushort i = 0; i < n; i++) {
 		Attribute *attr = attrs + i;
-		attr->id    = ids[i];
-		attr->value = values[i];
+		attr->id       = ids[i];
+		attr->accessed = true;
+		attr->value    = values[i];
 	}
 
 	// update pointer
@@ -231,15 +297,16 @@ void AttributeSet_Add
 	// value must be a valid property type
 	ASSERT(SI_TYPE(value) & SI_VALID_PROPERTY_VALUE);
 	// make sure attribute isn't already in set
-	ASSERT(AttributeSet_Get(*set, attr_id) == ATTRIBUTE_NOTFOUND);
+	ASSERT(!AttributeSet_Contains(*set, attr_id));
 #endif
 
 	AttributeSet _set = AttributeSet_AddPrepare(set, 1);
 
 	// set attribute
 	Attribute *attr = _set->attributes + _set->attr_count - 1;
-	attr->id = attr_id;
-	attr->value = SI_CloneValue(value);
+	attr->id       = attr_id;
+	attr->accessed = true;
+	attr->value    = SI_CloneValue(value);
 
 	// update pointer
 	*set = _set;
@@ -268,7 +335,7 @@ AttributeSetChangeType AttributeSet_Set_Allow_Null
 	ASSERT(SI_TYPE(value) & (SI_VALID_PROPERTY_VALUE | T_NULL));
 
 	// update the attribute if it is already presented in the set
-	if(AttributeSet_Get(_set, attr_id) != ATTRIBUTE_NOTFOUND) {
+	if(AttributeSet_Contains(_set, attr_id)) {
 		if(AttributeSet_Update(&_set, attr_id, value)) {
 			// update pointer
 			*set = _set;
@@ -289,8 +356,9 @@ AttributeSetChangeType AttributeSet_Set_Allow_Null
 
 	// set attribute
 	Attribute *attr = _set->attributes + _set->attr_count - 1;
-	attr->id = attr_id;
-	attr->value = SI_CloneValue(value);
+	attr->id       = attr_id;
+	attr->accessed = true;
+	attr->value    = SI_CloneValue(value);
 
 	// update pointer
 	*set = _set;
@@ -319,9 +387,12 @@ bool AttributeSet_UpdateNoClone
 		return _AttributeSet_Remove(set, attr_id);
 	}
 
-	SIValue *current = AttributeSet_Get(*set, attr_id);
-	ASSERT(current != ATTRIBUTE_NOTFOUND);
-	ASSERT(SIValue_Compare(*current, value, NULL) != 0);
+	Attribute *attr = _AttributeSet_Find(*set, attr_id);
+	ASSERT(attr != NULL);
+
+	SIValue *current = &attr->value;
+	ASSERT(AttributeSpill_IsSpilled(current) ||
+			SIValue_Compare(*current, value, NULL) != 0);
 
 	// value != current, update entity
 	SIValue_Free(*current);  // free previous value
@@ -354,11 +425,14 @@ bool AttributeSet_Update
 		return _AttributeSet_Remove(set, attr_id);
 	}
 
-	SIValue *current = AttributeSet_Get(_set, attr_id);
-	ASSERT(current != ATTRIBUTE_NOTFOUND);
+	Attribute *attr = _AttributeSet_Find(_set, attr_id);
+	ASSERT(attr != NULL);
 
 	// compare current value to new value, only update if current != new
-	if(unlikely(SIValue_Compare(*current, value, NULL) == 0)) {
+	// a value which can't be faulted in is replaced without comparison
+	SIValue *current = &attr->value;
+	if((!AttributeSpill_IsSpilled(current) || AttributeSpill_FaultIn(current)) &&
+	   unlikely(SIValue_Compare(*current, value, NULL) == 0)) {
 		return false;
 	}
 
@@ -387,8 +461,11 @@ AttributeSet AttributeSet_ShallowClone
 		Attribute *attr       = _set->attributes  + i;
 		Attribute *clone_attr = clone->attributes + i;
 
-		clone_attr->id = attr->id;
-		clone_attr->value = SI_ShareValue(attr->value);
+		clone_attr->id       = attr->id;
+		clone_attr->accessed = true;
+		// a value which can't be faulted in is cloned spilled
+		clone_attr->value    = _AttributeSet_Access(attr) ?
+			SI_ShareValue(attr->value) : attr->value;
 	}
 
     return clone;
@@ -411,6 +488,68 @@ void AttributeSet_PersistValues
 	}
 }
 
+// spill cold attribute values to the attribute spill file
+size_t AttributeSet_Evict
+(
+	AttributeSet set,  // set to evict values from
+	size_t min_size    // minimum size of a spilled value
+) {
+	ASSERT(AttributeSpill_Enabled());
+
+	// read-only sets are owned by the undo-log, leave them be
+	if(set == NULL || ATTRIBUTE_SET_IS_READONLY(set)) return 0;
+
+	size_t released = 0;
+
+	for(uint16_t i = 0; i < set->attr_count; ++i) {
+		Attribute *attr = set->attributes + i;
+
+		// give recently accessed attributes another round in memory
+		if(attr->accessed) {
+			attr->accessed = false;
+			continue;
+		}
+
+		SIValue *v = &attr->value;
+		if(SI_TYPE(*v) != T_STRING || SI_ALLOCATION(v) != M_SELF) continue;
+		if(strlen(v->stringval) < min_size) continue;
+
+		released += AttributeSpill_Evict(v);
+	}
+
+	return released;
+}
+
+// returns number of bytes used by attribute-set, including its values
+size_t AttributeSet_MemoryUsage
+(
+	const AttributeSet set,  // set to inspect
+	size_t *attr_bytes       // [optional] per attribute byte counts
+) {
+	// in case attribute-set is marked as read-only, clear marker
+	AttributeSet _set = (AttributeSet)ATTRIBUTE_SET_CLEAR_MSB(set);
+
+	if(_set == NULL) return 0;
+
+	size_t n = sizeof(_AttributeSet);
+
+	for(uint16_t i = 0; i < _set->attr_count; ++i) {
+		Attribute *attr = _set->attributes + i;
+
+		// spilled values don't own any memory
+		// check before reading the value, a reader might be faulting it in
+		size_t attr_n = sizeof(Attribute);
+		if(!AttributeSpill_IsSpilled(&attr->value)) {
+			attr_n += SIValue_MemoryUsage(attr->value);
+		}
+
+		if(attr_bytes != NULL) attr_bytes[attr->id] += attr_n;
+		n += attr_n;
+	}
+
+	return n;
+}
+
 // free attribute set
 void AttributeSet_Free
 (
@@ -33,6 +33,7 @@ typedef enum {
 
 typedef struct {
 	Attribute_ID id;  // attribute identifier
+	bool accessed;    // value was read since the last tiered storage sweep
 	SIValue value;    // attribute value
 } Attribute;
 
@@ -50,14 +51,22 @@ uint16_t AttributeSet_Count
 );
 
 // retrieves a value from set
-// NOTE: if the key does not exist
-//       we return the special constant value ATTRIBUTE_NOTFOUND
+// NOTE: if the key does not exist or its value can't be read from
+//       tiered storage we return the special constant value ATTRIBUTE_NOTFOUND
 SIValue *AttributeSet_Get
 (
 	const AttributeSet set,  // set to retieve attribute from
 	Attribute_ID attr_id     // attribute identifier
 );
 
+// returns true if set holds attribute
+// the attribute's value isn't accessed, as such it is never faulted in
+bool AttributeSet_Contains
+(
+	const AttributeSet set,  // set to search
+	Attribute_ID attr_id     // attribute identifier
+);
+
 // retrieves a value from set by index
 SIValue AttributeSet_GetIdx
 (
@@ -76,6 +85,14 @@ void AttributeSet_AddNoClone
 	bool allowNull		// accept NULLs
 );
 
+// creates an attribute-set holding a copy of n attribute records
+// attribute values are taken as is, without being cloned
+AttributeSet AttributeSet_FromAttributes
+(
+	const Attribute *attributes,  // attribute records
+	uint16_t n                    // number of attributes
+);
+
 // adds an attribute to the set (clones the value)
 void AttributeSet_Add
 (
@@ -124,6 +141,26 @@ void AttributeSet_PersistValues
 	const AttributeSet set  // set to persist
 );
 
+// spill cold attribute values to the attribute spill file
+// attributes accessed since the previous call have their access marker
+// cleared, unaccessed string values of at least min_size bytes are spilled
+// returns the number of bytes released
+size_t AttributeSet_Evict
+(
+	AttributeSet set,  // set to evict values from
+	size_t min_size    // minimum size of a spilled value
+);
+
+// returns number of bytes used by attribute-set, including its values
+// values are not faulted in, spilled values only account for their record
+// if 'attr_bytes' is provided, each attribute's bytes are added to
+// attr_bytes[attribute id]
+size_t AttributeSet_MemoryUsage
+(
+	const AttributeSet set,  // set to inspect
+	size_t *attr_bytes       // [optional] per attribute byte counts
+);
+
 // free attribute set
 void AttributeSet_Free
 (
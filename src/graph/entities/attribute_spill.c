@@ -0,0 +1,174 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "attribute_spill.h"
+#include "../../util/rmalloc.h"
+#include "../../configuration/config.h"
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/uio.h>
+
+// each spilled value is stored as a 4 bytes length followed by its content
+// the value's offset within the file is the offset of its length header
+
+static struct {
+	int fd;                 // spill file descriptor, -1 when disabled
+	uint64_t size;          // current file size, modified by the writer thread
+	pthread_mutex_t lock;   // serializes fault-ins
+} _spill = {.fd = -1, .size = 0, .lock = PTHREAD_MUTEX_INITIALIZER};
+
+// fork callbacks
+// a forked child (BGSAVE) faults values in while encoding the graph
+// make sure it doesn't inherit a locked mutex
+static void _AttributeSpill_ForkPrepare(void) {
+	pthread_mutex_lock(&_spill.lock);
+}
+
+static void _AttributeSpill_ForkRelease(void) {
+	pthread_mutex_unlock(&_spill.lock);
+}
+
+bool AttributeSpill_Init(void) {
+	ASSERT(_spill.fd == -1);
+
+	const char *folder = NULL;
+	Config_Option_get(Config_TIERED_STORAGE_FOLDER, &folder);
+
+	// tiered storage is disabled
+	if(folder == NULL || folder[0] == '\0') return true;
+
+	char path[PATH_MAX];
+	int len = snprintf(path, sizeof(path), "%s/redisgraph-spill-%d.dat",
+			folder, getpid());
+	if(len < 0 || len >= (int)sizeof(path)) {
+		RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+				"Tiered storage folder path is too long");
+		return false;
+	}
+
+	int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	if(fd == -1) {
+		RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+				"Failed to create attribute spill file %s: %s", path,
+				strerror(errno));
+		return false;
+	}
+
+	// the file is private to this process, remove it from the file system
+	// such that it is reclaimed once the process exits
+	unlink(path);
+
+	int res = pthread_atfork(_AttributeSpill_ForkPrepare,
+			_AttributeSpill_ForkRelease, _AttributeSpill_ForkRelease);
+	ASSERT(res == 0);
+	UNUSED(res);
+
+	_spill.fd   = fd;
+	_spill.size = 0;
+
+	RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_NOTICE,
+			"Tiered storage enabled, spilling attribute values to %s", folder);
+
+	return true;
+}
+
+bool AttributeSpill_Enabled(void) {
+	return _spill.fd != -1;
+}
+
+size_t AttributeSpill_Evict
+(
+	SIValue *v  // value to spill
+) {
+	ASSERT(v != NULL);
+	ASSERT(AttributeSpill_Enabled());
+
+	// only strings owned by the value are spilled
+	if(SI_TYPE(*v) != T_STRING || SI_ALLOCATION(v) != M_SELF) return 0;
+
+	size_t len = strlen(v->stringval);
+	if(len > UINT32_MAX) return 0;
+
+	uint32_t header = len;
+	struct iovec iov[2] = {
+		{.iov_base = &header,      .iov_len = sizeof(header)},
+		{.iov_base = v->stringval, .iov_len = len}
+	};
+
+	uint64_t offset = _spill.size;
+	ssize_t  n      = pwritev(_spill.fd, iov, 2, offset);
+	if(n != (ssize_t)(sizeof(header) + len)) {
+		// out of disk space or I/O error, keep value in memory
+		return 0;
+	}
+	_spill.size += n;
+
+	rm_free(v->stringval);
+	v->longval    = offset;
+	v->allocation = M_SPILLED;
+
+	return len + 1;
+}
+
+// read spilled string located at offset
+// returns NULL on failure
+static char *_AttributeSpill_Read
+(
+	uint64_t offset  // value offset within the spill file
+) {
+	uint32_t len;
+	if(pread(_spill.fd, &len, sizeof(len), offset) != sizeof(len)) {
+		return NULL;
+	}
+
+	char *s = rm_malloc(len + 1);
+	if(pread(_spill.fd, s, len, offset + sizeof(len)) != (ssize_t)len) {
+		rm_free(s);
+		return NULL;
+	}
+	s[len] = '\0';
+
+	return s;
+}
+
+bool AttributeSpill_FaultIn
+(
+	SIValue *v  // spilled value
+) {
+	ASSERT(v != NULL);
+
+	bool res = true;
+
+	pthread_mutex_lock(&_spill.lock);
+
+	// value might have been faulted in by a concurrent reader
+	if(AttributeSpill_IsSpilled(v)) {
+		char *s = _AttributeSpill_Read(v->longval);
+		if(likely(s != NULL)) {
+			v->stringval = s;
+
+			// publish value, readers check allocation before accessing stringval
+			__atomic_store_n(&v->allocation, M_SELF, __ATOMIC_RELEASE);
+		} else {
+			// keep value spilled, a later access might succeed
+			RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+					"Failed to read attribute value at offset %" PRId64
+					" from spill file: %s", v->longval, strerror(errno));
+			res = false;
+		}
+	}
+
+	pthread_mutex_unlock(&_spill.lock);
+
+	return res;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../value.h"
+
+// attribute spill file
+// when TIERED_STORAGE_FOLDER is configured, large string attribute values
+// which weren't accessed recently are moved out of memory into a process-wide
+// append-only file
+//
+// a spilled value keeps its T_STRING type, its allocation is set to M_SPILLED
+// and its longval holds the value's offset within the spill file
+// spilled values are faulted back into memory the next time they're accessed
+//
+// the file is unlinked as soon as it is created, its content is never reused
+// across restarts, space held by values which were faulted back in or deleted
+// is not reclaimed until the process exits
+
+// initialize attribute spill file
+// this is a no-op if tiered storage isn't configured
+// returns false if the spill file couldn't be created
+bool AttributeSpill_Init(void);
+
+// returns true if tiered storage is enabled
+bool AttributeSpill_Enabled(void);
+
+// returns true if value is spilled
+static inline bool AttributeSpill_IsSpilled
+(
+	const SIValue *v  // value to inspect
+) {
+	return __atomic_load_n(&v->allocation, __ATOMIC_ACQUIRE) == M_SPILLED;
+}
+
+// move value's string into the spill file and free its memory
+// only heap allocated strings (M_SELF) are spilled
+// returns the number of bytes released, 0 if value wasn't spilled
+//
+// the caller must guarantee no one else is accessing the value
+size_t AttributeSpill_Evict
+(
+	SIValue *v  // value to spill
+);
+
+// load a spilled value back into memory
+// safe to call concurrently from multiple readers of the same value
+// returns false if the value couldn't be read, in which case it remains spilled
+bool AttributeSpill_FaultIn
+(
+	SIValue *v  // spilled value
+);
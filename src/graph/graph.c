@@ -854,6 +854,124 @@ void Graph_CreateEdge
 	Graph_FormConnection(g, src, dest, id, r);
 }
 
+void Graph_LabelNodes
+(
+	Graph *g,
+	LabelID l,
+	const NodeID *ids,
+	uint64_t n
+) {
+	ASSERT(g != NULL);
+	ASSERT(n == 0 || ids != NULL);
+
+	if(n == 0) return;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	RG_Matrix L  = Graph_GetLabelMatrix(g, l);
+	RG_Matrix nl = Graph_GetNodeLabelMatrix(g);
+
+	if(n < GRAPH_BULK_BUILD_THRESHOLD) {
+		// small batch, introduce entries into the delta matrices
+		for(uint64_t i = 0; i < n; i++) {
+			info = RG_Matrix_setElement_BOOL(L, ids[i], ids[i]);
+			ASSERT(info == GrB_SUCCESS);
+			info = RG_Matrix_setElement_BOOL(nl, ids[i], l);
+			ASSERT(info == GrB_SUCCESS);
+		}
+	} else {
+		// set matrix diagonal at each [id, id]
+		info = RG_Matrix_build_BOOL(L, ids, ids, n);
+		ASSERT(info == GrB_SUCCESS);
+
+		// map label in each node's set of labels
+		GrB_Index *lbls = rm_malloc(sizeof(GrB_Index) * n);
+		for(uint64_t i = 0; i < n; i++) lbls[i] = l;
+		info = RG_Matrix_build_BOOL(nl, ids, lbls, n);
+		ASSERT(info == GrB_SUCCESS);
+		rm_free(lbls);
+	}
+
+	// update labels statistics
+	GraphStatistics_IncNodeCount(&g->stats, l, n);
+}
+
+void Graph_CreateNodes
+(
+	Graph *g,
+	LabelID *labels,
+	uint label_count,
+	AttributeSet *sets,
+	uint64_t n
+) {
+	ASSERT(g != NULL);
+	ASSERT(label_count == 0 || (label_count > 0 && labels != NULL));
+
+	if(n == 0) return;
+
+	NodeID *ids = rm_malloc(sizeof(NodeID) * n);
+	for(uint64_t i = 0; i < n; i++) {
+		AttributeSet *set = DataBlock_AllocateItem(g->nodes, ids + i);
+		*set = (sets != NULL) ? sets[i] : NULL;
+	}
+
+	for(uint i = 0; i < label_count; i++) {
+		Graph_LabelNodes(g, labels[i], ids, n);
+	}
+
+	rm_free(ids);
+}
+
+void Graph_CreateEdges
+(
+	Graph *g,
+	RelationID r,
+	const NodeID *src,
+	const NodeID *dest,
+	AttributeSet *sets,
+	EdgeID *ids,
+	uint64_t n
+) {
+	ASSERT(g    != NULL);
+	ASSERT(src  != NULL);
+	ASSERT(dest != NULL);
+	ASSERT(r < Graph_RelationTypeCount(g));
+
+	if(n == 0) return;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	EdgeID *_ids = (ids != NULL) ? ids : rm_malloc(sizeof(EdgeID) * n);
+	for(uint64_t i = 0; i < n; i++) {
+		AttributeSet *set = DataBlock_AllocateItem(g->edges, _ids + i);
+		*set = (sets != NULL) ? sets[i] : NULL;
+	}
+
+	if(n < GRAPH_BULK_BUILD_THRESHOLD) {
+		// small batch, introduce entries into the delta matrices
+		for(uint64_t i = 0; i < n; i++) {
+			Graph_FormConnection(g, src[i], dest[i], _ids[i], r);
+		}
+	} else {
+		RG_Matrix M   = Graph_GetRelationMatrix(g, r, false);
+		RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+
+		// rows represent source nodes, columns represent destination nodes
+		info = RG_Matrix_build_BOOL(adj, src, dest, n);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = RG_Matrix_build_UINT64(M, src, dest, _ids, n);
+		ASSERT(info == GrB_SUCCESS);
+
+		// edges of type r have just been created, update statistics
+		GraphStatistics_IncEdgeCount(&g->stats, r, n);
+	}
+
+	if(ids == NULL) rm_free(_ids);
+}
+
 // retrieves all either incoming or outgoing edges
 // to/from given node N, depending on given direction
 void Graph_GetNodeEdges
@@ -1086,6 +1204,475 @@ uint Graph_GetNodeLabels
 	return i;
 }
 
+// extract rows of a delta matrix, accounting for pending changes
+// C must be of dimensions n x ncols(R)
+static void _Graph_ExtractRows
+(
+	GrB_Matrix C,            // [output] extracted rows
+	const RG_Matrix R,       // matrix to extract rows from
+	const GrB_Index *rows,   // rows to extract
+	GrB_Index n,             // number of rows
+	GrB_BinaryOp accum       // accumulator matching C's type
+) {
+	GrB_Info   info;
+	GrB_Index  ncols;
+	GrB_Matrix dm = NULL;
+	UNUSED(info);
+
+	GrB_Matrix M  = RG_MATRIX_M(R);
+	GrB_Matrix DP = RG_MATRIX_DELTA_PLUS(R);
+	GrB_Matrix DM = RG_MATRIX_DELTA_MINUS(R);
+
+	info = GrB_Matrix_ncols(&ncols, M);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries pending deletion
+	info = GrB_Matrix_new(&dm, GrB_BOOL, n, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_extract(dm, NULL, NULL, DM, rows, n, GrB_ALL, ncols,
+			NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// rows of M excluding entries pending deletion
+	info = GrB_Matrix_extract(C, dm, NULL, M, rows, n, GrB_ALL, ncols,
+			GrB_DESC_RSC);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries pending addition
+	info = GrB_Matrix_extract(C, NULL, accum, DP, rows, n, GrB_ALL, ncols,
+			NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&dm);
+}
+
+// extract the entries of a delta matrix at the positions of a mask,
+// accounting for pending changes
+// V must be of type UINT64 and of the same dimensions as R
+static void _Graph_ExtractEntries
+(
+	GrB_Matrix V,        // [output] extracted entries
+	const RG_Matrix R,   // matrix to extract entries from
+	const GrB_Matrix P   // positions to extract
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Matrix M  = RG_MATRIX_M(R);
+	GrB_Matrix DP = RG_MATRIX_DELTA_PLUS(R);
+	GrB_Matrix DM = RG_MATRIX_DELTA_MINUS(R);
+
+	// entries of M excluding entries pending deletion
+	info = GrB_Matrix_eWiseMult_BinaryOp(V, DM, NULL, GrB_FIRST_UINT64, M, P,
+			GrB_DESC_RSC);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries pending addition
+	info = GrB_Matrix_eWiseMult_BinaryOp(V, NULL, GrB_SECOND_UINT64,
+			GrB_FIRST_UINT64, DP, P, NULL);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+// make sure tuple buffers can hold n tuples
+static void _Graph_ReserveTuples
+(
+	GrB_Index **I,  // [input/output] rows buffer
+	GrB_Index **J,  // [input/output] columns buffer
+	uint64_t **X,   // [input/output] values buffer
+	GrB_Index *cap, // [input/output] buffers capacity
+	GrB_Index n     // required capacity
+) {
+	if(n <= *cap) return;
+
+	*cap = n;
+	*I   = rm_realloc(*I, sizeof(GrB_Index) * n);
+	*J   = rm_realloc(*J, sizeof(GrB_Index) * n);
+	*X   = rm_realloc(*X, sizeof(uint64_t) * n);
+}
+
+// collects all edges incident to given nodes
+// for large batches, each relation matrix is consulted once, extracting the
+// rows of all nodes from it and from its transpose
+void Graph_GetNodesEdges
+(
+	const Graph *g,     // graph to get edges from
+	const Node *nodes,  // nodes to extract edges from
+	uint64_t n,         // number of nodes
+	Edge **edges        // [output] array_t incident edges
+) {
+	ASSERT(g     != NULL);
+	ASSERT(nodes != NULL);
+	ASSERT(edges != NULL);
+
+	if(n < GRAPH_BULK_BUILD_THRESHOLD) {
+		for(uint64_t i = 0; i < n; i++) {
+			Graph_GetNodeEdges(g, nodes + i, GRAPH_EDGE_DIR_BOTH,
+					GRAPH_NO_RELATION, edges);
+		}
+		return;
+	}
+
+	GrB_Info    info;
+	GrB_Index   nrows;
+	GrB_Index   nvals;
+	GrB_Index   cap  = 0;
+	GrB_Index  *I    = NULL;
+	GrB_Index  *J    = NULL;
+	uint64_t   *X    = NULL;
+	GrB_Scalar  s    = NULL;  // true scalar
+	GrB_Matrix  C    = NULL;  // extracted rows
+	GrB_Matrix  P    = NULL;  // positions of incoming edges
+	GrB_Matrix  V    = NULL;  // entries of incoming edges
+	UNUSED(info);
+
+	GrB_Index *ids = rm_malloc(sizeof(GrB_Index) * n);
+	for(uint64_t i = 0; i < n; i++) ids[i] = ENTITY_GET_ID(nodes + i);
+
+	info = GrB_Scalar_new(&s, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_BOOL(s, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint rel_count = Graph_RelationTypeCount(g);
+	for(uint r = 0; r < rel_count; r++) {
+		RG_Matrix R  = Graph_GetRelationMatrix(g, r, false);
+		RG_Matrix TR = Graph_GetRelationMatrix(g, r, true);
+
+		info = RG_Matrix_nrows(&nrows, R);
+		ASSERT(info == GrB_SUCCESS);
+
+		//----------------------------------------------------------------------
+		// outgoing edges
+		//----------------------------------------------------------------------
+
+		info = GrB_Matrix_new(&C, GrB_UINT64, n, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		_Graph_ExtractRows(C, R, ids, n, GrB_SECOND_UINT64);
+
+		info = GrB_Matrix_nvals(&nvals, C);
+		ASSERT(info == GrB_SUCCESS);
+		if(nvals > 0) {
+			_Graph_ReserveTuples(&I, &J, &X, &cap, nvals);
+			info = GrB_Matrix_extractTuples_UINT64(I, J, X, &nvals, C);
+			ASSERT(info == GrB_SUCCESS);
+		}
+		GrB_free(&C);
+
+		for(GrB_Index k = 0; k < nvals; k++) {
+			_CollectEdgesFromEntry(g, ids[I[k]], J[k], r, X[k], edges);
+		}
+
+		//----------------------------------------------------------------------
+		// incoming edges
+		//----------------------------------------------------------------------
+
+		info = GrB_Matrix_new(&C, GrB_BOOL, n, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		_Graph_ExtractRows(C, TR, ids, n, GrB_SECOND_BOOL);
+
+		info = GrB_Matrix_nvals(&nvals, C);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(nvals > 0) {
+			_Graph_ReserveTuples(&I, &J, &X, &cap, nvals);
+			info = GrB_Matrix_extractTuples_BOOL(I, J, NULL, &nvals, C);
+			ASSERT(info == GrB_SUCCESS);
+
+			// transposed entry [k, src] corresponds to edge src->ids[k]
+			for(GrB_Index k = 0; k < nvals; k++) I[k] = ids[I[k]];
+
+			info = GrB_Matrix_new(&P, GrB_BOOL, nrows, nrows);
+			ASSERT(info == GrB_SUCCESS);
+			info = GxB_Matrix_build_Scalar(P, J, I, s, nvals);
+			ASSERT(info == GrB_SUCCESS);
+
+			// retrieve edge IDs at incoming positions
+			info = GrB_Matrix_new(&V, GrB_UINT64, nrows, nrows);
+			ASSERT(info == GrB_SUCCESS);
+			_Graph_ExtractEntries(V, R, P);
+
+			info = GrB_Matrix_nvals(&nvals, V);
+			ASSERT(info == GrB_SUCCESS);
+			info = GrB_Matrix_extractTuples_UINT64(I, J, X, &nvals, V);
+			ASSERT(info == GrB_SUCCESS);
+
+			for(GrB_Index k = 0; k < nvals; k++) {
+				_CollectEdgesFromEntry(g, I[k], J[k], r, X[k], edges);
+			}
+
+			GrB_free(&P);
+			GrB_free(&V);
+		}
+
+		GrB_free(&C);
+	}
+
+	rm_free(ids);
+	if(I != NULL) rm_free(I);
+	if(J != NULL) rm_free(J);
+	if(X != NULL) rm_free(X);
+	GrB_free(&s);
+}
+
+// compare edges by source and destination nodes
+static int _Graph_EdgePositionCmp
+(
+	const void *a,
+	const void *b
+) {
+	const Edge *ea = *(const Edge **)a;
+	const Edge *eb = *(const Edge **)b;
+
+	if(ea->src_id  != eb->src_id)  return (ea->src_id  < eb->src_id)  ? -1 : 1;
+	if(ea->dest_id != eb->dest_id) return (ea->dest_id < eb->dest_id) ? -1 : 1;
+	return 0;
+}
+
+// removes edges in bulk
+// rather than clearing entries one by one, the entries of deleted edges are
+// extracted from each relation matrix with a single masked operation,
+// positions holding a single edge are cleared with a single masked
+// assignment, only multi-edge entries are inspected individually
+// the adjacency matrix is then cleared of all positions no longer
+// connected by any relationship type
+static void _Graph_DeleteEdgesBulk
+(
+	Graph *g,        // graph to delete edges from
+	Edge *edges,     // edges to delete
+	uint64_t n       // number of edges
+) {
+	GrB_Info    info;
+	GrB_Index   nrows;
+	GrB_Index   nvals;
+	GrB_Scalar  s       = NULL;  // true scalar
+	GrB_Scalar  empty   = NULL;  // empty scalar
+	GrB_Matrix  P       = NULL;  // positions of deleted edges
+	GrB_Matrix  V       = NULL;  // entries at deleted positions
+	GrB_Matrix  C       = NULL;  // positions to clear from a relation matrix
+	GrB_Matrix  cleared = NULL;  // positions cleared from relation matrices
+	UNUSED(info);
+
+	uint rel_count = Graph_RelationTypeCount(g);
+
+	// masks are shared across matrices, make sure all have the same dimensions
+	MATRIX_POLICY policy = Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
+
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+	info = RG_Matrix_nrows(&nrows, adj);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Scalar_new(&s, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_BOOL(s, true);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_new(&empty, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_new(&cleared, GrB_BOOL, nrows, nrows);
+	ASSERT(info == GrB_SUCCESS);
+
+	//--------------------------------------------------------------------------
+	// group edges by relationship type
+	//--------------------------------------------------------------------------
+
+	uint64_t *offsets = rm_calloc(rel_count + 1, sizeof(uint64_t));
+	uint64_t *cursors = rm_malloc(sizeof(uint64_t) * rel_count);
+	Edge    **grouped = rm_malloc(sizeof(Edge *) * n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		offsets[Edge_GetRelationID(edges + i) + 1]++;
+	}
+	for(uint r = 0; r < rel_count; r++) {
+		offsets[r + 1] += offsets[r];
+		cursors[r] = offsets[r];
+	}
+	for(uint64_t i = 0; i < n; i++) {
+		grouped[cursors[Edge_GetRelationID(edges + i)]++] = edges + i;
+	}
+
+	//--------------------------------------------------------------------------
+	// clear relation matrices
+	//--------------------------------------------------------------------------
+
+	GrB_Index  cap = 0;
+	GrB_Index *I   = rm_malloc(sizeof(GrB_Index) * n);
+	GrB_Index *J   = rm_malloc(sizeof(GrB_Index) * n);
+	EdgeID    *ids = rm_malloc(sizeof(EdgeID) * n);
+	GrB_Index *MI  = NULL;  // multi-edge rows
+	GrB_Index *MJ  = NULL;  // multi-edge columns
+	uint64_t  *MX  = NULL;  // multi-edge entries
+
+	for(uint r = 0; r < rel_count; r++) {
+		uint64_t start = offsets[r];
+		uint64_t end   = offsets[r + 1];
+		uint64_t count = end - start;
+		if(count == 0) continue;
+
+		// order edges by position, locating the deleted edges of a position
+		qsort(grouped + start, count, sizeof(Edge *), _Graph_EdgePositionCmp);
+
+		for(uint64_t i = start; i < end; i++) {
+			Edge *e = grouped[i];
+			ASSERT(!DataBlock_ItemIsDeleted((void *)e->attributes));
+			ids[i]       = ENTITY_GET_ID(e);
+			I[i - start] = Edge_GetSrcNodeID(e);
+			J[i - start] = Edge_GetDestNodeID(e);
+		}
+
+		// flush pending changes, entries are updated in M directly
+		RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+		info = RG_Matrix_wait(R, true);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Matrix m = RG_MATRIX_M(R);
+
+		// extract entries at deleted positions
+		info = GrB_Matrix_new(&P, GrB_BOOL, nrows, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		info = GxB_Matrix_build_Scalar(P, I, J, s, count);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_new(&V, GrB_UINT64, nrows, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_eWiseMult_BinaryOp(V, NULL, NULL, GrB_FIRST_UINT64,
+				m, P, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// positions holding a single edge are cleared entirely
+		info = GrB_Matrix_new(&C, GrB_BOOL, nrows, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_select_UINT64(C, NULL, NULL, GrB_VALUELT_UINT64, V,
+				MSB_MASK, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		// positions holding multiple edges
+		info = GrB_Matrix_select_UINT64(V, NULL, NULL, GrB_VALUEGE_UINT64, V,
+				MSB_MASK, NULL);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_nvals(&nvals, V);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(nvals > 0) {
+			_Graph_ReserveTuples(&MI, &MJ, &MX, &cap, nvals);
+			info = GrB_Matrix_extractTuples_UINT64(MI, MJ, MX, &nvals, V);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		for(GrB_Index k = 0; k < nvals; k++) {
+			// locate first deleted edge connecting src to dest
+			uint64_t lo = start;
+			uint64_t hi = end;
+			while(lo < hi) {
+				uint64_t mid = lo + (hi - lo) / 2;
+				Edge *e = grouped[mid];
+				if(Edge_GetSrcNodeID(e) < MI[k] ||
+				   (Edge_GetSrcNodeID(e) == MI[k] &&
+					Edge_GetDestNodeID(e) < MJ[k])) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+
+			// remove deleted edges from multi-edge entry
+			EdgeID *multi = (EdgeID *)(CLEAR_MSB(MX[k]));
+			for(uint64_t i = lo; i < end &&
+				  Edge_GetSrcNodeID(grouped[i])  == MI[k] &&
+				  Edge_GetDestNodeID(grouped[i]) == MJ[k]; i++) {
+				uint len = array_len(multi);
+				uint j = 0;
+				for(; j < len && multi[j] != ids[i]; j++);
+				ASSERT(j < len);
+				array_del_fast(multi, j);
+			}
+
+			uint len = array_len(multi);
+			if(len == 0) {
+				// all edges connecting src to dest deleted, clear position
+				array_free(multi);
+				info = GrB_Matrix_setElement_BOOL(C, true, MI[k], MJ[k]);
+				ASSERT(info == GrB_SUCCESS);
+			} else if(len == 1) {
+				// revert back to a single edge
+				uint64_t x = multi[0];
+				array_free(multi);
+				info = GrB_Matrix_setElement_UINT64(m, x, MI[k], MJ[k]);
+				ASSERT(info == GrB_SUCCESS);
+			}
+		}
+
+		info = GrB_Matrix_nvals(&nvals, C);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(nvals > 0) {
+			info = RG_Matrix_removeElements(R, C);
+			ASSERT(info == GrB_SUCCESS);
+
+			// accumulate cleared positions
+			info = GrB_Matrix_assign_Scalar(cleared, C, NULL, s, GrB_ALL,
+					nrows, GrB_ALL, nrows, GrB_DESC_S);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		GrB_free(&P);
+		GrB_free(&V);
+		GrB_free(&C);
+
+		// edges of type r have just been deleted, update statistics
+		GraphStatistics_DecEdgeCount(&g->stats, r, count);
+	}
+
+	//--------------------------------------------------------------------------
+	// clear adjacency matrix
+	//--------------------------------------------------------------------------
+
+	info = GrB_Matrix_nvals(&nvals, cleared);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(nvals > 0) {
+		info = GrB_Matrix_new(&V, GrB_UINT64, nrows, nrows);
+		ASSERT(info == GrB_SUCCESS);
+
+		// drop positions still connected by any relationship type
+		// pending changes are accounted for rather than flushed
+		for(uint r = 0; r < rel_count && nvals > 0; r++) {
+			RG_Matrix R = Graph_GetRelationMatrix(g, r, false);
+			_Graph_ExtractEntries(V, R, cleared);
+
+			info = GrB_Matrix_assign_Scalar(cleared, V, NULL, empty, GrB_ALL,
+					nrows, GrB_ALL, nrows, GrB_DESC_S);
+			ASSERT(info == GrB_SUCCESS);
+
+			info = GrB_Matrix_nvals(&nvals, cleared);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		if(nvals > 0) {
+			info = RG_Matrix_removeElements(adj, cleared);
+			ASSERT(info == GrB_SUCCESS);
+		}
+
+		GrB_free(&V);
+	}
+
+	// free and remove edges from datablock
+	DataBlock_DeleteItems(g->edges, ids, n);
+
+	Graph_SetMatrixPolicy(g, policy);
+
+	rm_free(I);
+	rm_free(J);
+	rm_free(ids);
+	if(MI != NULL) rm_free(MI);
+	if(MJ != NULL) rm_free(MJ);
+	if(MX != NULL) rm_free(MX);
+	rm_free(offsets);
+	rm_free(cursors);
+	rm_free(grouped);
+	GrB_free(&s);
+	GrB_free(&empty);
+	GrB_free(&cleared);
+}
+
 // removes edges from Graph and updates graph relevant matrices
 void Graph_DeleteEdges
 (
@@ -1097,6 +1684,11 @@ void Graph_DeleteEdges
 	ASSERT(n > 0);
 	ASSERT(edges != NULL);
 
+	if(n >= GRAPH_BULK_BUILD_THRESHOLD) {
+		_Graph_DeleteEdgesBulk(g, edges, n);
+		return;
+	}
+
 	uint64_t    x;
 	RG_Matrix   R;
 	RG_Matrix   M;
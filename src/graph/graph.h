@@ -24,6 +24,7 @@
 #define GRAPH_UNKNOWN_LABEL -2              // labels are numbered [0-N], -2 represents an unknown relation.
 #define GRAPH_NO_RELATION -1                // relations are numbered [0-N], -1 represents no relation.
 #define GRAPH_UNKNOWN_RELATION -2           // relations are numbered [0-N], -2 represents an unknown relation.
+#define GRAPH_BULK_BUILD_THRESHOLD 1024     // minimum batch size for which matrices are built or cleared in bulk rather than entry by entry.
 
 typedef enum {
 	GRAPH_EDGE_DIR_INCOMING,
@@ -134,6 +135,15 @@ void Graph_LabelNode
 	uint lbl_count  // number of labels
 );
 
+// label nodes in bulk, associating each node in 'ids' with label 'l'
+void Graph_LabelNodes
+(
+	Graph *g,           // graph to operate on
+	LabelID l,          // label to associate with nodes
+	const NodeID *ids,  // node IDs to update
+	uint64_t n          // number of nodes
+);
+
 // dissociates each label in 'lbls' from given node
 void Graph_RemoveNodeLabels
 (
@@ -209,6 +219,30 @@ void Graph_CreateEdge
 	Edge *e
 );
 
+// create nodes in bulk
+// all nodes share the same set of labels
+void Graph_CreateNodes
+(
+	Graph *g,            // graph on which to operate
+	LabelID *labels,     // nodes labels
+	uint label_count,    // number of labels
+	AttributeSet *sets,  // nodes attributes, NULL if nodes have no attributes
+	uint64_t n           // number of nodes to create
+);
+
+// create edges in bulk
+// edge i connects src[i] to dest[i], all edges share the same type
+void Graph_CreateEdges
+(
+	Graph *g,            // graph on which to operate
+	RelationID r,        // edges type
+	const NodeID *src,   // source node IDs
+	const NodeID *dest,  // destination node IDs
+	AttributeSet *sets,  // edges attributes, NULL if edges have no attributes
+	EdgeID *ids,         // [optional output] IDs of created edges
+	uint64_t n           // number of edges to create
+);
+
 // deletes nodes from the graph
 void Graph_DeleteNodes
 (
@@ -365,6 +399,16 @@ void Graph_GetNodeEdges
 	Edge **edges            // array_t incoming/outgoing edges
 );
 
+// collects all edges incident to given nodes
+// edges connecting two of the given nodes may be reported twice
+void Graph_GetNodesEdges
+(
+	const Graph *g,         // graph to get edges from
+	const Node *nodes,      // nodes to extract edges from
+	uint64_t n,             // number of nodes
+	Edge **edges            // array_t incident edges
+);
+
 // returns node incoming/outgoing degree
 uint64_t Graph_GetNodeDegree
 (
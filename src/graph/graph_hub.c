@@ -8,18 +8,88 @@
 #include "../query_ctx.h"
 #include "../undo_log/undo_log.h"
 
+// update node's indices under schema
+// index changes of logged operations are deferred until the operation commits
+static inline void _IndexNode
+(
+	const Schema *s,  // node's schema
+	const Node *n,    // node to index
+	bool log          // logged operation
+) {
+	if(!Schema_HasIndices(s)) return;
+
+	if(log) {
+		IndexChanges_IndexNode(QueryCtx_GetIndexChanges(), ENTITY_GET_ID(n),
+				Schema_GetID(s));
+	} else {
+		Schema_AddNodeToIndices(s, n);
+	}
+}
+
+// remove node from schema's indices
+// index changes of logged operations are deferred until the operation commits
+static inline void _UnindexNode
+(
+	const Schema *s,  // node's schema
+	const Node *n,    // node to remove
+	bool log          // logged operation
+) {
+	if(!Schema_HasIndices(s)) return;
+
+	if(log) {
+		IndexChanges_RemoveNode(QueryCtx_GetIndexChanges(), ENTITY_GET_ID(n),
+				Schema_GetID(s));
+	} else {
+		Schema_RemoveNodeFromIndices(s, n);
+	}
+}
+
+// update edge's indices
+// index changes of logged operations are deferred until the operation commits
+static inline void _IndexEdge
+(
+	const Schema *s,  // edge's schema
+	const Edge *e,    // edge to index
+	bool log          // logged operation
+) {
+	if(!Schema_HasIndices(s)) return;
+
+	if(log) {
+		IndexChanges_IndexEdge(QueryCtx_GetIndexChanges(), e);
+	} else {
+		Schema_AddEdgeToIndices(s, e);
+	}
+}
+
+// remove edge from schema's indices
+// index changes of logged operations are deferred until the operation commits
+static inline void _UnindexEdge
+(
+	const Schema *s,  // edge's schema
+	const Edge *e,    // edge to remove
+	bool log          // logged operation
+) {
+	if(!Schema_HasIndices(s)) return;
+
+	if(log) {
+		IndexChanges_RemoveEdge(QueryCtx_GetIndexChanges(), e);
+	} else {
+		Schema_RemoveEdgeFromIndices(s, e);
+	}
+}
+
 // delete all references to a node from any relevant index
 static void _DeleteNodeFromIndices
 (
 	GraphContext *gc,
-	Node *n
+	Node *n,
+	bool log
 ) {
 	ASSERT(n  != NULL);
 	ASSERT(gc != NULL);
 
 	Schema   *s      = NULL;
 	Graph    *g      = gc->g;
-	EntityID node_id = ENTITY_GET_ID(n);
 
 	// retrieve node labels
 	uint label_count;
@@ -31,38 +101,38 @@ static void _DeleteNodeFromIndices
 		ASSERT(s != NULL);
 
 		// update any indices this entity is represented in
-		Schema_RemoveNodeFromIndices(s, n);
+		_UnindexNode(s, n, log);
 	}
 }
 
 static void _DeleteEdgeFromIndices
 (
 	GraphContext *gc,
-	Edge *e
+	Edge *e,
+	bool log
 ) {
 	Schema  *s  =  NULL;
-	Graph   *g  =  gc->g;
 
 	int relation_id = Edge_GetRelationID(e);
 
 	s = GraphContext_GetSchemaByID(gc, relation_id, SCHEMA_EDGE);
 
 	// update any indices this entity is represented in
-	Schema_RemoveEdgeFromIndices(s, e);
+	_UnindexEdge(s, e, log);
 }
 
 // add node to any relevant index
 static void _AddNodeToIndices
 (
 	GraphContext *gc,
-	Node *n
+	Node *n,
+	bool log
 ) {
 	ASSERT(n  != NULL);
 	ASSERT(gc != NULL);
 
 	Schema    *s       =  NULL;
 	Graph     *g       =  gc->g;
-	EntityID  node_id  =  ENTITY_GET_ID(n);
 
 	// retrieve node labels
 	uint label_count;
@@ -72,21 +142,20 @@ static void _AddNodeToIndices
 		int label_id = labels[i];
 		s = GraphContext_GetSchemaByID(gc, label_id, SCHEMA_NODE);
 		ASSERT(s != NULL);
-		Schema_AddNodeToIndices(s, n);
+		_IndexNode(s, n, log);
 	}
 }
 
 // add edge to any relevant index
-static void _AddEdgeToIndices(GraphContext *gc, Edge *e) {
+static void _AddEdgeToIndices(GraphContext *gc, Edge *e, bool log) {
 	Schema  *s  =  NULL;
-	Graph   *g  =  gc->g;
 
 	int relation_id = Edge_GetRelationID(e);
 
 	s = GraphContext_GetSchemaByID(gc, relation_id, SCHEMA_EDGE);
 	ASSERT(s != NULL);
 
-	Schema_AddEdgeToIndices(s, e);
+	_IndexEdge(s, e, log);
 }
 
 void CreateNode
@@ -108,7 +177,7 @@ void CreateNode
 	for(uint i = 0; i < label_count; i++) {
 		Schema *s = GraphContext_GetSchemaByID(gc, labels[i], SCHEMA_NODE);
 		ASSERT(s);
-		Schema_AddNodeToIndices(s, n);
+		_IndexNode(s, n, log);
 	}
 
 	// add node creation operation to undo log
@@ -139,7 +208,7 @@ void CreateEdge
 	Schema *s = GraphContext_GetSchemaByID(gc, r, SCHEMA_EDGE);
 	// all schemas have been created in the edge blueprint loop or earlier
 	ASSERT(s != NULL);
-	Schema_AddEdgeToIndices(s, e);
+	_IndexEdge(s, e, log);
 
 	// add edge creation operation to undo log
 	if(log == true) {
@@ -150,6 +219,146 @@ void CreateEdge
 	}
 }
 
+void CreateNodes
+(
+	GraphContext *gc,
+	Node **nodes,
+	LabelID **labels,
+	AttributeSet *sets,
+	uint n,
+	bool log
+) {
+	ASSERT(gc     != NULL);
+	ASSERT(sets   != NULL);
+	ASSERT(nodes  != NULL);
+	ASSERT(labels != NULL);
+
+	Graph *g = gc->g;
+
+	// node IDs grouped by label
+	uint label_count = GraphContext_SchemaCount(gc, SCHEMA_NODE);
+	NodeID **groups = rm_calloc(label_count, sizeof(NodeID *));
+
+	// allocate nodes in order, honoring reserved IDs
+	for(uint i = 0; i < n; i++) {
+		Node *node = nodes[i];
+		Graph_CreateNode(g, node, NULL, 0);
+		*node->attributes = sets[i];
+
+		uint lbl_count = array_len(labels[i]);
+		for(uint j = 0; j < lbl_count; j++) {
+			LabelID l = labels[i][j];
+			ASSERT(l < label_count);
+			if(groups[l] == NULL) groups[l] = array_new(NodeID, n);
+			array_append(groups[l], ENTITY_GET_ID(node));
+		}
+	}
+
+	// label nodes, one batch per label
+	for(uint l = 0; l < label_count; l++) {
+		if(groups[l] == NULL) continue;
+		Graph_LabelNodes(g, l, groups[l], array_len(groups[l]));
+		array_free(groups[l]);
+	}
+	rm_free(groups);
+
+	UndoLog undo_log  = (log) ? QueryCtx_GetUndoLog() : NULL;
+	EffectsBuffer *eb = (log) ? QueryCtx_GetEffectsBuffer() : NULL;
+
+	for(uint i = 0; i < n; i++) {
+		Node *node = nodes[i];
+		uint lbl_count = array_len(labels[i]);
+
+		for(uint j = 0; j < lbl_count; j++) {
+			Schema *s = GraphContext_GetSchemaByID(gc, labels[i][j],
+					SCHEMA_NODE);
+			ASSERT(s != NULL);
+			_IndexNode(s, node, log);
+		}
+
+		// add node creation operation to undo log
+		if(log == true) {
+			UndoLog_CreateNode(undo_log, node);
+			EffectsBuffer_AddCreateNodeEffect(eb, node, labels[i], lbl_count);
+		}
+	}
+}
+
+void CreateEdges
+(
+	GraphContext *gc,
+	Edge **edges,
+	AttributeSet *sets,
+	uint n,
+	bool log
+) {
+	ASSERT(gc    != NULL);
+	ASSERT(sets  != NULL);
+	ASSERT(edges != NULL);
+
+	Graph *g = gc->g;
+
+	// edge positions grouped by relation type
+	uint relation_count = GraphContext_SchemaCount(gc, SCHEMA_EDGE);
+	uint **groups = rm_calloc(relation_count, sizeof(uint *));
+
+	for(uint i = 0; i < n; i++) {
+		RelationID r = edges[i]->relationID;
+		ASSERT(r >= 0 && r < relation_count);
+		if(groups[r] == NULL) groups[r] = array_new(uint, n);
+		array_append(groups[r], i);
+	}
+
+	UndoLog undo_log  = (log) ? QueryCtx_GetUndoLog() : NULL;
+	EffectsBuffer *eb = (log) ? QueryCtx_GetEffectsBuffer() : NULL;
+
+	NodeID       *src  = rm_malloc(sizeof(NodeID) * n);
+	NodeID       *dest = rm_malloc(sizeof(NodeID) * n);
+	EdgeID       *ids  = rm_malloc(sizeof(EdgeID) * n);
+	AttributeSet *attr = rm_malloc(sizeof(AttributeSet) * n);
+
+	// form connections, one batch per relation type
+	for(RelationID r = 0; r < relation_count; r++) {
+		uint *group = groups[r];
+		if(group == NULL) continue;
+
+		uint count = array_len(group);
+		for(uint i = 0; i < count; i++) {
+			Edge *e = edges[group[i]];
+			src[i]  = Edge_GetSrcNodeID(e);
+			dest[i] = Edge_GetDestNodeID(e);
+			attr[i] = sets[group[i]];
+		}
+
+		Graph_CreateEdges(g, r, src, dest, attr, ids, count);
+
+		Schema *s = GraphContext_GetSchemaByID(gc, r, SCHEMA_EDGE);
+		ASSERT(s != NULL);
+
+		// effects are emitted in ID allocation order
+		// such that replicas allocate the same IDs
+		for(uint i = 0; i < count; i++) {
+			Edge *e = edges[group[i]];
+			Graph_GetEdge(g, ids[i], e);
+			_IndexEdge(s, e, log);
+
+			// add edge creation operation to undo log
+			if(log == true) {
+				UndoLog_CreateEdge(undo_log, e);
+				EffectsBuffer_AddCreateEdgeEffect(eb, e);
+			}
+		}
+
+		array_free(group);
+	}
+
+	rm_free(src);
+	rm_free(dest);
+	rm_free(ids);
+	rm_free(attr);
+	rm_free(groups);
+}
+
 // delete a node
 // remove the node from the relevant indexes
 // add node deletion operation to undo-log
@@ -178,7 +387,7 @@ void DeleteNodes
 		}
 
 		if(has_indices) {
-			_DeleteNodeFromIndices(gc, n);
+			_DeleteNodeFromIndices(gc, n, log);
 		}
 	}
 
@@ -210,7 +419,7 @@ void DeleteEdges
 			}
 
 			if(has_indecise == true) {
-				_DeleteEdgeFromIndices(gc, edges + i);
+				_DeleteEdgeFromIndices(gc, edges + i, log);
 			}
 		}
 	}
@@ -241,9 +450,9 @@ void UpdateEntityProperties
 	*ge->attributes = set;
 
 	if(entity_type == GETYPE_NODE) {
-		_AddNodeToIndices(gc, (Node *)ge);
+		_AddNodeToIndices(gc, (Node *)ge, log);
 	} else {
-		_AddEdgeToIndices(gc, (Edge *)ge);
+		_AddEdgeToIndices(gc, (Edge *)ge, log);
 	}
 }
 
@@ -263,7 +472,7 @@ void UpdateNodeProperty
 
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(n.attributes);
-	} else if(GraphEntity_GetProperty((GraphEntity *)&n, attr_id) == ATTRIBUTE_NOTFOUND) {
+	} else if(!AttributeSet_Contains(*n.attributes, attr_id)) {
 		AttributeSet_AddNoClone(n.attributes, &attr_id, &v, 1, true);
 	} else {
 		AttributeSet_UpdateNoClone(n.attributes, attr_id, v);
@@ -308,7 +517,7 @@ void UpdateEdgeProperty
 
 	if(attr_id == ATTRIBUTE_ID_ALL) {
 		AttributeSet_Free(e.attributes);
-	} else if(GraphEntity_GetProperty((GraphEntity *)&e, attr_id) == ATTRIBUTE_NOTFOUND) {
+	} else if(!AttributeSet_Contains(*e.attributes, attr_id)) {
 		AttributeSet_AddNoClone(e.attributes, &attr_id, &v, 1, true);
 	} else {
 		AttributeSet_UpdateNoClone(e.attributes, attr_id, v);
@@ -380,7 +589,7 @@ void UpdateNodeLabels
 				// append label id
 				add_labels_ids[add_labels_index++] = schema_id;
 				// add to index
-				Schema_AddNodeToIndices(s, node);
+				_IndexNode(s, node, log);
 			}
 		}
 
@@ -420,7 +629,7 @@ void UpdateNodeLabels
 			// append label id
 			remove_labels_ids[remove_labels_index++] = Schema_GetID(s);
 			// remove node from index
-			Schema_RemoveNodeFromIndices(s, node);
+			_UnindexNode(s, node, log);
 		}
 
 		if(remove_labels_index > 0) {
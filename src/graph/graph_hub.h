@@ -40,6 +40,33 @@ void CreateEdge
 	bool log           // log operation in undo-log
 );
 
+// create nodes in bulk
+// node i is labeled with labels[i] and assigned attributes sets[i]
+// nodes are created in order, such that reserved node IDs are honored
+// matrix updates are grouped by label
+void CreateNodes
+(
+	GraphContext *gc,    // graph context to create the nodes
+	Node **nodes,        // output nodes created
+	LabelID **labels,    // labels of each node
+	AttributeSet *sets,  // attributes of each node
+	uint n,              // number of nodes
+	bool log             // log operations in undo-log
+);
+
+// create edges in bulk
+// edge i connects its source to its destination and is assigned sets[i]
+// each edge's endpoints and relation type must be set by the caller
+// matrix updates are grouped by relation type
+void CreateEdges
+(
+	GraphContext *gc,    // graph context to create the edges
+	Edge **edges,        // output edges created
+	AttributeSet *sets,  // attributes of each edge
+	uint n,              // number of edges
+	bool log             // log operations in undo-log
+);
+
 // delete nodes
 // remove nodes from the relevant indexes
 // add node deletion operations to undo-log
@@ -14,6 +14,7 @@
 #include "../util/rmalloc.h"
 #include "../util/thpool/pools.h"
 #include "../constraint/constraint.h"
+#include "../serializers/snapshot.h"
 #include "../serializers/graphcontext_type.h"
 #include "../commands/execution_ctx.h"
 
@@ -95,12 +96,15 @@ GraphContext *GraphContext_New
 	gc->version          = 0;  // initial graph version
 	gc->slowlog          = SlowLog_New();
 	gc->queries_log      = QueriesLog_New();
+	gc->latency_stats    = LatencyStats_New();
+	gc->fingerprint_stats = FingerprintStats_New();
 	gc->ref_count        = 0;  // no refences
 	gc->attributes       = raxNew();
 	gc->index_count      = 0;  // no indicies
 	gc->string_mapping   = array_new(char *, 64);
 	gc->encoding_context = GraphEncodeContext_New();
 	gc->decoding_context = GraphDecodeContext_New();
+	gc->snapshot         = NULL;
 
 	// read NODE_CREATION_BUFFER size from configuration
 	// this value controls how much extra room we're willing to spend for:
@@ -736,6 +740,46 @@ bool GraphContext_AddFullTextIndex
 	return index_changed;
 }
 
+// create a vector index for the given label and attribute
+bool GraphContext_AddVectorIndex
+(
+	Index *idx,                     // [input/output] index created
+	GraphContext *gc,               // graph context
+	const char *label,              // label of indexed nodes
+	const char *attribute,          // attribute holding vectors
+	const VectorIndexOptions *opts  // vector index configuration
+) {
+	ASSERT(idx       != NULL);
+	ASSERT(gc        != NULL);
+	ASSERT(opts      != NULL);
+	ASSERT(label     != NULL);
+	ASSERT(attribute != NULL);
+
+	// retrieve the schema for this label
+	ResultSet *result_set = QueryCtx_GetResultSet();
+	Schema    *s          = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+
+	if(s == NULL) {
+		s = GraphContext_AddSchema(gc, label, SCHEMA_NODE);
+	}
+
+	IndexField field;
+	Attribute_ID f_id = GraphContext_FindOrAddAttribute(gc, attribute, NULL);
+	IndexField_Default(&field, f_id, attribute);
+	if(Schema_AddIndex(idx, s, &field, IDX_VECTOR) != INDEX_OK) {
+		return false;
+	}
+
+	// update result-set
+	ResultSet_IndexCreated(result_set, INDEX_OK);
+
+	// configuration must be set prior to constructing the index structure
+	Index_SetVectorOptions(*idx, opts);
+	Index_Disable(*idx);
+
+	return true;
+}
+
 int GraphContext_DeleteIndex
 (
 	GraphContext *gc,
@@ -824,6 +868,7 @@ void GraphContext_LogQuery
 	bool utilized_cache,          // utilized cache
 	bool write,    		          // write query
 	bool timeout,    		      // timeout query
+	const double *stage_durations,  // [optional] time spent in each stage
 	const char *query             // query string
 ) {
 	ASSERT(gc != NULL);
@@ -831,7 +876,7 @@ void GraphContext_LogQuery
 
 	QueriesLog_AddQuery(gc->queries_log, received, wait_duration,
 			execution_duration, report_duration, parameterized, utilized_cache,
-			write, timeout, query);
+			write, timeout, stage_durations, query);
 }
 
 //------------------------------------------------------------------------------
@@ -878,6 +923,9 @@ static void _GraphContext_Free(void *arg) {
 		Graph_PartialFree(gc->g);
 	}
 
+	// unmap snapshot once no attribute refers to it
+	if(gc->snapshot != NULL) Snapshot_Free(gc->snapshot);
+
 	// Redis main thread is 0
 	RedisModuleCtx *ctx = NULL;
 	bool main_thread = ThreadPools_GetThreadID() == 0;
@@ -936,10 +984,12 @@ static void _GraphContext_Free(void *arg) {
 	}
 
 	//--------------------------------------------------------------------------
-	// free queries log
+	// free queries log and query statistics
 	//--------------------------------------------------------------------------
 
 	QueriesLog_Free(gc->queries_log);
+	LatencyStats_Free(gc->latency_stats);
+	FingerprintStats_Free(gc->fingerprint_stats);
 
 	//--------------------------------------------------------------------------
 	// free attribute mappings
@@ -13,6 +13,8 @@
 #include "../util/cache/cache.h"
 #include "../slow_log/slow_log.h"
 #include "../queries_log/queries_log.h"
+#include "../queries_log/latency_stats.h"
+#include "../queries_log/fingerprint_stats.h"
 #include "../serializers/encode_context.h"
 #include "../serializers/decode_context.h"
 
@@ -38,11 +40,14 @@ typedef struct {
 	unsigned short index_count;            // number of indicies
 	SlowLog *slowlog;                      // slowlog associated with graph
 	QueriesLog queries_log;                // log last x executed queries
+	LatencyStats latency_stats;            // graph's query latency histograms
+	FingerprintStats fingerprint_stats;    // statistics per query fingerprint
 	GraphEncodeContext *encoding_context;  // encode context of the graph
 	GraphDecodeContext *decoding_context;  // decode context of the graph
 	Cache *cache;                          // global cache of execution plans
 	XXH32_hash_t version;                  // graph version
 	RedisModuleString *telemetry_stream;   // telemetry stream name
+	struct GraphSnapshot *snapshot;        // mapped snapshot the graph was loaded from
 } GraphContext;
 
 //------------------------------------------------------------------------------
@@ -304,6 +309,16 @@ bool GraphContext_AddFullTextIndex
 	const char *language
 );
 
+// create a vector index for the given label and attribute
+bool GraphContext_AddVectorIndex
+(
+	Index *idx,                     // [input/output] index created
+	GraphContext *gc,               // graph context
+	const char *label,              // label of indexed nodes
+	const char *attribute,          // attribute holding vectors
+	const VectorIndexOptions *opts  // vector index configuration
+);
+
 // remove and free an index
 int GraphContext_DeleteIndex
 (
@@ -367,6 +382,7 @@ void GraphContext_LogQuery
 	bool utilized_cache,          // utilized cache
 	bool write,    		          // write query
 	bool timeout,    		      // timeout query
+	const double *stage_durations,  // [optional] time spent in each stage
 	const char *query             // query string
 );
 
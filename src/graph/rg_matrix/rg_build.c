@@ -0,0 +1,165 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rg_utils.h"
+#include "rg_matrix.h"
+#include "../../util/arr.h"
+
+static GrB_BinaryOp _graph_edge_merge = NULL;
+
+// merge two entries, each either a single edge ID or multiple edge IDs
+// multiple IDs held by 'y' are moved into the result
+static void _edge_merge(void *_z, const void *_x, const void *_y) {
+	uint64_t *ids;
+	uint64_t       *z  =  (uint64_t *)        _z;
+	const uint64_t *x  =  (const uint64_t *)  _x;
+	const uint64_t *y  =  (const uint64_t *)  _y;
+
+	if(SINGLE_EDGE(*x)) {
+		ids = array_new(uint64_t, 2);
+		array_append(ids, *x);
+	} else {
+		ids = (uint64_t *)(CLEAR_MSB(*x));
+	}
+
+	if(SINGLE_EDGE(*y)) {
+		array_append(ids, *y);
+	} else {
+		uint64_t *y_ids = (uint64_t *)(CLEAR_MSB(*y));
+		uint n = array_len(y_ids);
+		for(uint i = 0; i < n; i++) array_append(ids, y_ids[i]);
+		array_free(y_ids);
+	}
+
+	*z = (uint64_t)SET_MSB(ids);
+}
+
+// merge boolean tuples (I, J) into m
+static GrB_Info _merge_BOOL
+(
+	GrB_Matrix m,        // matrix to update
+	const GrB_Index *I,  // row indices
+	const GrB_Index *J,  // column indices
+	GrB_Index nvals      // number of tuples
+) {
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Scalar s = NULL;
+	GrB_Matrix T = NULL;
+
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Scalar_new(&s, GrB_BOOL);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Scalar_setElement_BOOL(s, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&T, GrB_BOOL, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	// duplicates collapse into a single iso entry
+	info = GxB_Matrix_build_Scalar(T, I, J, s, nvals);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_eWiseAdd_BinaryOp(m, NULL, NULL, GrB_LOR, m, T, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&s);
+	GrB_free(&T);
+
+	return info;
+}
+
+GrB_Info RG_Matrix_build_BOOL
+(
+	RG_Matrix C,
+	const GrB_Index *I,
+	const GrB_Index *J,
+	GrB_Index nvals
+) {
+	ASSERT(C != NULL);
+	ASSERT(!RG_MATRIX_MULTI_EDGE(C));
+	ASSERT(nvals == 0 || (I != NULL && J != NULL));
+
+	if(nvals == 0) return GrB_SUCCESS;
+
+	// flush pending changes, tuples are merged directly into M
+	GrB_Info info = RG_Matrix_wait(C, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = _merge_BOOL(RG_MATRIX_M(C), I, J, nvals);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		info = _merge_BOOL(RG_MATRIX_TM(C), J, I, nvals);
+	}
+
+	return info;
+}
+
+GrB_Info RG_Matrix_build_UINT64
+(
+	RG_Matrix C,
+	const GrB_Index *I,
+	const GrB_Index *J,
+	const uint64_t *X,
+	GrB_Index nvals
+) {
+	ASSERT(C != NULL);
+	ASSERT(RG_MATRIX_MULTI_EDGE(C));
+	ASSERT(nvals == 0 || (I != NULL && J != NULL && X != NULL));
+
+	if(nvals == 0) return GrB_SUCCESS;
+
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Matrix T = NULL;
+
+	// create edge merge binary function
+	if(!_graph_edge_merge) {
+		info = GrB_BinaryOp_new(&_graph_edge_merge, _edge_merge, GrB_UINT64,
+				GrB_UINT64, GrB_UINT64);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	// flush pending changes, tuples are merged directly into M
+	info = RG_Matrix_wait(C, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix m = RG_MATRIX_M(C);
+
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&T, GrB_UINT64, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+
+	// tuples sharing the same position form a multi-edge entry
+	info = GrB_Matrix_build_UINT64(T, I, J, X, nvals, _graph_edge_merge);
+	ASSERT(info == GrB_SUCCESS);
+
+	// entries already present in M are merged with the new ones
+	// multi-edge arrays held by T are moved into M
+	info = GrB_Matrix_eWiseAdd_BinaryOp(m, NULL, NULL, _graph_edge_merge, m, T,
+			NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&T);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		info = _merge_BOOL(RG_MATRIX_TM(C), J, I, nvals);
+	}
+
+	return info;
+}
+
@@ -145,6 +145,34 @@ GrB_Info RG_Matrix_nvals    // get the number of entries in a matrix
 	return info;
 }
 
+GrB_Info RG_Matrix_memoryUsage
+(
+	size_t *size,         // [output] # of bytes used by the main matrix
+	size_t *delta_size,   // [output] # of bytes used by the delta matrices
+	const RG_Matrix A     // matrix to query
+) {
+	ASSERT(A           !=  NULL);
+	ASSERT(size        !=  NULL);
+	ASSERT(delta_size  !=  NULL);
+
+	GrB_Info  info;
+	size_t    m_size   =  0;
+	size_t    dp_size  =  0;
+	size_t    dm_size  =  0;
+
+	info = GxB_Matrix_memoryUsage(&m_size, RG_MATRIX_M(A));
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_memoryUsage(&dp_size, RG_MATRIX_DELTA_PLUS(A));
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_memoryUsage(&dm_size, RG_MATRIX_DELTA_MINUS(A));
+	ASSERT(info == GrB_SUCCESS);
+
+	*size       = m_size;
+	*delta_size = dp_size + dm_size;
+
+	return info;
+}
+
 GrB_Info RG_Matrix_clear
 (
     RG_Matrix A
@@ -190,6 +190,15 @@ GrB_Info RG_Matrix_nvals    // get the number of entries in a matrix
 	const RG_Matrix A       // matrix to query
 );
 
+// get the number of bytes used by a matrix
+// the transposed matrix isn't accounted for
+GrB_Info RG_Matrix_memoryUsage
+(
+	size_t *size,         // [output] # of bytes used by the main matrix
+	size_t *delta_size,   // [output] # of bytes used by the delta matrices
+	const RG_Matrix A     // matrix to query
+);
+
 GrB_Info RG_Matrix_resize      // change the size of a matrix
 (
 	RG_Matrix C,                // matrix to modify
@@ -212,6 +221,27 @@ GrB_Info RG_Matrix_setElement_UINT64      // C (i,j) = x
 	GrB_Index j                         // column index
 );
 
+// add tuples (I, J) to C, duplicates collapse into a single entry
+// unlike GrB_Matrix_build, C may already hold entries
+GrB_Info RG_Matrix_build_BOOL
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	GrB_Index nvals                     // number of tuples
+);
+
+// add tuples (I, J, X) to C, duplicates form multi-edge entries
+// unlike GrB_Matrix_build, C may already hold entries
+GrB_Info RG_Matrix_build_UINT64
+(
+	RG_Matrix C,                        // matrix to modify
+	const GrB_Index *I,                 // row indices
+	const GrB_Index *J,                 // column indices
+	const uint64_t *X,                  // edge IDs
+	GrB_Index nvals                     // number of tuples
+);
+
 GrB_Info RG_Matrix_extractElement_BOOL     // x = A(i,j)
 (
 	bool *x,                               // extracted scalar
@@ -243,6 +273,15 @@ GrB_Info RG_Matrix_removeElement_UINT64
 	GrB_Index j                     // column index
 );
 
+// remove all entries of C at positions present in mask
+// pending changes are flushed and entries are cleared from M directly
+// multi-value entries are not freed, this is the caller's responsibility
+GrB_Info RG_Matrix_removeElements
+(
+	RG_Matrix C,                    // matrix to remove entries from
+	const GrB_Matrix mask           // structural mask of positions to clear
+);
+
 // remove value 'v' from multi-value entry at position C[i,j]
 GrB_Info RG_Matrix_removeEntry_UINT64
 (
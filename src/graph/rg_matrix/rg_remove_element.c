@@ -164,3 +164,77 @@ GrB_Info RG_Matrix_removeElement_UINT64
 	return info;
 }
 
+// clear entries of m at positions present in mask
+static GrB_Info _clearMasked
+(
+	GrB_Matrix m,      // matrix to clear entries from
+	GrB_Matrix mask    // positions to clear
+) {
+	GrB_Info   info;
+	GrB_Type   type;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Scalar s = NULL;
+
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_type(&type, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// assigning an empty scalar deletes entries
+	info = GrB_Scalar_new(&s, type);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_assign_Scalar(m, mask, NULL, s, GrB_ALL, nrows, GrB_ALL,
+			ncols, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+
+	// remove zombies, matrix is read concurrently once the write lock is freed
+	info = GrB_wait(m, GrB_MATERIALIZE);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&s);
+
+	return info;
+}
+
+GrB_Info RG_Matrix_removeElements
+(
+	RG_Matrix C,                    // matrix to remove entries from
+	const GrB_Matrix mask           // structural mask of positions to clear
+) {
+	ASSERT(C    != NULL);
+	ASSERT(mask != NULL);
+
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+
+	// flush pending changes, entries are cleared from M directly
+	info = RG_Matrix_wait(C, true);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = _clearMasked(RG_MATRIX_M(C), mask);
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		GrB_Matrix mask_t = NULL;
+
+		info = GrB_Matrix_nrows(&nrows, mask);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_ncols(&ncols, mask);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_new(&mask_t, GrB_BOOL, ncols, nrows);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_transpose(mask_t, NULL, NULL, mask, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = _clearMasked(RG_MATRIX_TM(C), mask_t);
+
+		GrB_free(&mask_t);
+	}
+
+	return info;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "covering_index.h"
+#include "../../util/arr.h"
+#include "../../util/dict.h"
+#include "../../util/rmalloc.h"
+
+struct CoveringIndex {
+	Attribute_ID *attrs;  // covered attributes
+	dict *entities;       // entity ID -> AttributeSet *
+};
+
+CoveringIndex *CoveringIndex_New
+(
+	const Attribute_ID *attrs,
+	uint n
+) {
+	ASSERT(attrs != NULL || n == 0);
+
+	CoveringIndex *ci = rm_malloc(sizeof(CoveringIndex));
+
+	ci->attrs    = array_new(Attribute_ID, n);
+	ci->entities = HashTableCreate(&def_dt);
+
+	for(uint i = 0; i < n; i++) array_append(ci->attrs, attrs[i]);
+
+	return ci;
+}
+
+bool CoveringIndex_Covers
+(
+	const CoveringIndex *ci,
+	Attribute_ID attr_id
+) {
+	ASSERT(ci != NULL);
+
+	uint n = array_len(ci->attrs);
+	for(uint i = 0; i < n; i++) {
+		if(ci->attrs[i] == attr_id) return true;
+	}
+
+	return false;
+}
+
+void CoveringIndex_Set
+(
+	CoveringIndex *ci,
+	const GraphEntity *e
+) {
+	ASSERT(ci != NULL);
+	ASSERT(e  != NULL);
+
+	// collect entity's covered attributes
+	AttributeSet set = NULL;
+	uint n = array_len(ci->attrs);
+	for(uint i = 0; i < n; i++) {
+		Attribute_ID attr_id = ci->attrs[i];
+		SIValue *v = GraphEntity_GetProperty(e, attr_id);
+		if(v == ATTRIBUTE_NOTFOUND) continue;
+		AttributeSet_Add(&set, attr_id, *v);
+	}
+
+	// attribute-sets are boxed, records referring to an entity's covered
+	// attributes hold the box address, which remains valid until the entity
+	// is removed
+	void *k = (void *)ENTITY_GET_ID(e);
+	AttributeSet *box = HashTableFetchValue(ci->entities, k);
+	if(box != NULL) {
+		AttributeSet_Free(box);
+	} else {
+		box = rm_malloc(sizeof(AttributeSet));
+		HashTableAdd(ci->entities, k, box);
+	}
+
+	*box = set;
+}
+
+void CoveringIndex_Remove
+(
+	CoveringIndex *ci,
+	EntityID id
+) {
+	ASSERT(ci != NULL);
+
+	void *k = (void *)id;
+	AttributeSet *box = HashTableFetchValue(ci->entities, k);
+	if(box == NULL) return;
+
+	AttributeSet_Free(box);
+	rm_free(box);
+	HashTableDelete(ci->entities, k);
+}
+
+AttributeSet *CoveringIndex_Get
+(
+	const CoveringIndex *ci,
+	EntityID id
+) {
+	ASSERT(ci != NULL);
+
+	return HashTableFetchValue(ci->entities, (void *)id);
+}
+
+uint64_t CoveringIndex_Count
+(
+	const CoveringIndex *ci
+) {
+	ASSERT(ci != NULL);
+
+	return HashTableElemCount(ci->entities);
+}
+
+size_t CoveringIndex_MemoryUsage
+(
+	const CoveringIndex *ci
+) {
+	ASSERT(ci != NULL);
+
+	size_t n = HashTableElemCount(ci->entities);
+	size_t set_size = sizeof(AttributeSet) + sizeof(_AttributeSet) +
+		sizeof(Attribute) * array_len(ci->attrs);
+
+	return sizeof(CoveringIndex) + HashTableMemUsage(ci->entities) +
+		n * set_size;
+}
+
+void CoveringIndex_Free
+(
+	CoveringIndex *ci
+) {
+	ASSERT(ci != NULL);
+
+	dictEntry *de;
+	dictIterator *it = HashTableGetIterator(ci->entities);
+	while((de = HashTableNext(it)) != NULL) {
+		AttributeSet *box = HashTableGetVal(de);
+		AttributeSet_Free(box);
+		rm_free(box);
+	}
+	HashTableReleaseIterator(it);
+
+	HashTableRelease(ci->entities);
+	array_free(ci->attrs);
+	rm_free(ci);
+}
+
@@ -0,0 +1,76 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../graph/entities/graph_entity.h"
+#include "../../graph/entities/attribute_set.h"
+
+// covering index, keeps a copy of each indexed entity's covered attributes
+//
+// an index scan which only accesses covered attributes can populate its
+// records from the covering index without fetching entities from the graph
+// the attribute-set returned for an entity has the same layout as the one
+// stored in the graph's DataBlock, such that attribute lookups are unaware of
+// its origin
+typedef struct CoveringIndex CoveringIndex;
+
+// create a new covering index
+CoveringIndex *CoveringIndex_New
+(
+	const Attribute_ID *attrs,  // covered attributes
+	uint n                      // number of covered attributes
+);
+
+// returns true if attribute is covered
+bool CoveringIndex_Covers
+(
+	const CoveringIndex *ci,  // covering index
+	Attribute_ID attr_id      // attribute to check
+);
+
+// set entity's covered attributes
+// replaces entity's previous attributes, if any
+void CoveringIndex_Set
+(
+	CoveringIndex *ci,    // index to update
+	const GraphEntity *e  // entity to cover
+);
+
+// remove entity from index
+void CoveringIndex_Remove
+(
+	CoveringIndex *ci,  // index to update
+	EntityID id         // entity to remove
+);
+
+// returns entity's covered attributes
+// NULL if entity isn't in the index
+AttributeSet *CoveringIndex_Get
+(
+	const CoveringIndex *ci,  // covering index
+	EntityID id               // entity ID
+);
+
+// number of entities in the index
+uint64_t CoveringIndex_Count
+(
+	const CoveringIndex *ci
+);
+
+// approximate number of bytes used by index
+// excluding heap allocated values e.g. strings
+size_t CoveringIndex_MemoryUsage
+(
+	const CoveringIndex *ci
+);
+
+// free index
+void CoveringIndex_Free
+(
+	CoveringIndex *ci
+);
+
@@ -24,9 +24,17 @@ struct _Index {
 	char *language;                // language
 	char **stopwords;              // stopwords
 	GraphEntityType entity_type;   // entity type (node/edge) indexed
-	IndexType type;                // index type exact-match / fulltext
+	IndexType type;                // index type exact-match / fulltext / vector
 	RSIndex *rsIdx;                // RediSearch index
+	HNSW *hnsw;                    // vector index graph
+	OrderedIndex **ordered;        // per field ordered index (node exact-match)
+	CoveringIndex *covering;       // indexed attribute values (node exact-match)
+	VectorIndexOptions vec_opts;   // vector index configuration
+	bool ordered_loaded;           // ordered indices restored, skip population
+	uint _Atomic ordered_restored; // number of ordered indices restored
 	uint _Atomic pending_changes;  // number of pending changes
+	uint64_t _Atomic populated;    // #entities processed by population
+	uint64_t _Atomic total;        // #entities to populate
 };
 
 static void _Index_ConstructFullTextStructure
@@ -95,6 +103,63 @@ static void _Index_ConstructExactMatchStructure
 	RediSearch_TagFieldSetCaseSensitive(rsIdx, fieldID, 1);
 }
 
+static void _Index_ConstructOrderedStructure
+(
+	Index idx
+) {
+	ASSERT(idx != NULL);
+	ASSERT(idx->ordered == NULL);
+
+	uint fields_count = array_len(idx->fields);
+	idx->ordered = array_new(OrderedIndex *, fields_count);
+	for(uint i = 0; i < fields_count; i++) {
+		array_append(idx->ordered, OrderedIndex_New(idx->fields[i].id));
+	}
+}
+
+static void _Index_FreeOrderedStructure
+(
+	Index idx
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->ordered == NULL) return;
+
+	uint n = array_len(idx->ordered);
+	for(uint i = 0; i < n; i++) OrderedIndex_Free(idx->ordered[i]);
+	array_free(idx->ordered);
+	idx->ordered = NULL;
+}
+
+static void _Index_ConstructCoveringStructure
+(
+	Index idx
+) {
+	ASSERT(idx != NULL);
+	ASSERT(idx->covering == NULL);
+
+	uint fields_count = array_len(idx->fields);
+	Attribute_ID *attrs = array_new(Attribute_ID, fields_count);
+	for(uint i = 0; i < fields_count; i++) {
+		array_append(attrs, idx->fields[i].id);
+	}
+
+	idx->covering = CoveringIndex_New(attrs, fields_count);
+	array_free(attrs);
+}
+
+static void _Index_FreeCoveringStructure
+(
+	Index idx
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->covering == NULL) return;
+
+	CoveringIndex_Free(idx->covering);
+	idx->covering = NULL;
+}
+
 // responsible for creating the index structure only!
 // e.g. fields, stopwords, language
 void Index_ConstructStructure
@@ -104,6 +169,15 @@ void Index_ConstructStructure
 	ASSERT(idx != NULL);
 	ASSERT(idx->rsIdx == NULL);
 
+	// vector indices are maintained natively
+	if(idx->type == IDX_VECTOR) {
+		ASSERT(idx->hnsw == NULL);
+		VectorIndexOptions *opts = &idx->vec_opts;
+		idx->hnsw = HNSW_New(opts->dimension, opts->similarity, opts->M,
+				opts->ef_construction);
+		return;
+	}
+
 	RSIndex *rsIdx = NULL;
 	RSIndexOptions *idx_options = RediSearch_CreateIndexOptions();
 	RediSearch_IndexOptionsSetLanguage(idx_options, idx->language);
@@ -136,6 +210,76 @@ void Index_ConstructStructure
 	// set RediSearch index
 	ASSERT(idx->rsIdx == NULL);
 	idx->rsIdx = rsIdx;
+
+	// node exact-match indices maintain natively ordered attributes
+	// allowing ordered scans
+	// and cover their indexed attributes allowing index-only scans
+	if(idx->type == IDX_EXACT_MATCH && idx->entity_type == GETYPE_NODE) {
+		_Index_ConstructOrderedStructure(idx);
+		_Index_ConstructCoveringStructure(idx);
+	}
+}
+
+// update entity's value in each ordered index
+void Index_OrderedIndexEntity
+(
+	Index idx,
+	const GraphEntity *e
+) {
+	ASSERT(idx != NULL);
+	ASSERT(e   != NULL);
+
+	// restored ordered indices already hold the entity
+	if(idx->ordered == NULL || idx->ordered_loaded) return;
+
+	EntityID id = ENTITY_GET_ID(e);
+	uint n = array_len(idx->ordered);
+	for(uint i = 0; i < n; i++) {
+		OrderedIndex *oi = idx->ordered[i];
+		SIValue *v = GraphEntity_GetProperty(e, OrderedIndex_Attribute(oi));
+		OrderedIndex_Set(oi, id, (v == ATTRIBUTE_NOTFOUND) ? SI_NullVal() : *v);
+	}
+}
+
+// remove entity from each ordered index
+void Index_OrderedRemoveEntity
+(
+	Index idx,
+	EntityID id
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->ordered == NULL || idx->ordered_loaded) return;
+
+	uint n = array_len(idx->ordered);
+	for(uint i = 0; i < n; i++) OrderedIndex_Remove(idx->ordered[i], id);
+}
+
+// update entity's covered attributes
+void Index_CoverEntity
+(
+	Index idx,
+	const GraphEntity *e
+) {
+	ASSERT(idx != NULL);
+	ASSERT(e   != NULL);
+
+	if(idx->covering == NULL) return;
+
+	CoveringIndex_Set(idx->covering, e);
+}
+
+// remove entity's covered attributes
+void Index_UncoverEntity
+(
+	Index idx,
+	EntityID id
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->covering == NULL) return;
+
+	CoveringIndex_Remove(idx->covering, id);
 }
 
 RSDoc *Index_IndexGraphEntity
@@ -290,13 +434,22 @@ Index Index_New
 
 	idx->type            = type;
 	idx->label           = rm_strdup(label);
+	idx->hnsw            = NULL;
 	idx->rsIdx           = NULL;
 	idx->fields          = array_new(IndexField, 1);
+	idx->ordered         = NULL;
+	idx->covering        = NULL;
 	idx->label_id        = label_id;
 	idx->language        = NULL;
 	idx->stopwords       = NULL;
 	idx->entity_type     = entity_type;
 	idx->pending_changes = ATOMIC_VAR_INIT(0);
+	idx->populated       = ATOMIC_VAR_INIT(0);
+	idx->total           = ATOMIC_VAR_INIT(0);
+	idx->ordered_loaded   = false;
+	idx->ordered_restored = ATOMIC_VAR_INIT(0);
+
+	memset(&idx->vec_opts, 0, sizeof(VectorIndexOptions));
 
 	return idx;
 }
@@ -316,9 +469,16 @@ Index Index_Clone
 	Index clone = rm_malloc(sizeof(_Index));
 	memcpy(clone, idx, sizeof(_Index));
 
+	clone->hnsw            = NULL;
 	clone->rsIdx           = NULL;
+	clone->ordered         = NULL;
+	clone->covering        = NULL;
 	clone->label           = rm_strdup(idx->label);
 	clone->pending_changes = ATOMIC_VAR_INIT(0);
+	clone->populated       = ATOMIC_VAR_INIT(0);
+	clone->total           = ATOMIC_VAR_INIT(0);
+	clone->ordered_loaded   = false;
+	clone->ordered_restored = ATOMIC_VAR_INIT(0);
 	
 	if(clone->stopwords != NULL) {
 		array_clone_with_cb(clone->stopwords, idx->stopwords, rm_strdup);
@@ -366,6 +526,17 @@ void Index_Disable
 		idx->rsIdx = NULL;
 	}
 
+	if(idx->hnsw != NULL) {
+		HNSW_Free(idx->hnsw);
+		idx->hnsw = NULL;
+	}
+
+	_Index_FreeOrderedStructure(idx);
+	_Index_FreeCoveringStructure(idx);
+
+	idx->ordered_loaded   = false;
+	idx->ordered_restored = 0;
+
 	// construct index structure
 	Index_ConstructStructure(idx);
 }
@@ -377,10 +548,55 @@ void Index_Enable
 	Index idx
 ) {
 	ASSERT(idx != NULL);
-	ASSERT(idx->rsIdx != NULL);
+	ASSERT(idx->rsIdx != NULL || idx->hnsw != NULL);
 	ASSERT(idx->pending_changes > 0);
 
 	idx->pending_changes--;
+
+	// ordered indices are maintained by every update from now on
+	if(idx->pending_changes == 0) {
+		idx->ordered_loaded   = false;
+		idx->ordered_restored = 0;
+	}
+}
+
+// resets index population progress
+void Index_PopulationBegin
+(
+	Index idx,      // index being populated
+	uint64_t total  // #entities to populate
+) {
+	ASSERT(idx != NULL);
+
+	idx->populated = 0;
+	idx->total     = total;
+}
+
+// advance index population progress
+void Index_PopulationAdvance
+(
+	Index idx,  // index being populated
+	uint64_t n  // #entities processed
+) {
+	ASSERT(idx != NULL);
+
+	idx->populated += n;
+}
+
+// get index population progress
+void Index_PopulationProgress
+(
+	const Index idx,     // index to inquery
+	uint64_t *populated, // [output] #entities processed
+	uint64_t *total      // [output] #entities to populate
+) {
+	ASSERT(idx       != NULL);
+	ASSERT(total     != NULL);
+	ASSERT(populated != NULL);
+
+	// entities might be added while the index is being populated
+	*total     = idx->total;
+	*populated = MIN(idx->populated, *total);
 }
 
 // adds field to index
@@ -514,6 +730,9 @@ const char *Index_GetLanguage
 ) {
 	ASSERT(idx != NULL);
 
+	// vector indices have no notion of language
+	if(idx->type == IDX_VECTOR) return NULL;
+
 	RSIndex *_idx = Index_RSIndex(idx);
 	ASSERT(_idx != NULL);
 
@@ -527,6 +746,9 @@ char **Index_GetStopwords
 ) {
 	ASSERT(idx != NULL);
 
+	*size = 0;
+	if(idx->type == IDX_VECTOR) return NULL;
+
 	RSIndex *_idx = Index_RSIndex(idx);
 	ASSERT(_idx != NULL);
 
@@ -563,6 +785,170 @@ void Index_SetStopwords
 	idx->stopwords = stopwords;
 }
 
+// set vector index configuration
+void Index_SetVectorOptions
+(
+	Index idx,
+	const VectorIndexOptions *opts
+) {
+	ASSERT(idx  != NULL);
+	ASSERT(opts != NULL);
+	ASSERT(idx->type == IDX_VECTOR);
+	ASSERT(idx->hnsw == NULL);
+
+	idx->vec_opts = *opts;
+}
+
+// returns vector index configuration
+const VectorIndexOptions *Index_GetVectorOptions
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+	ASSERT(idx->type == IDX_VECTOR);
+
+	return &idx->vec_opts;
+}
+
+// returns vector index HNSW graph
+HNSW *Index_HNSW
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+
+	return idx->hnsw;
+}
+
+// replace vector index HNSW graph
+void Index_SetHNSW
+(
+	Index idx,
+	HNSW *hnsw
+) {
+	ASSERT(idx  != NULL);
+	ASSERT(hnsw != NULL);
+	ASSERT(idx->type == IDX_VECTOR);
+	ASSERT(HNSW_Dimension(hnsw) == idx->vec_opts.dimension);
+
+	if(idx->hnsw != NULL) HNSW_Free(idx->hnsw);
+	idx->hnsw = hnsw;
+}
+
+// replace attribute's ordered index
+// returns false if index doesn't order the attribute
+bool Index_SetOrderedIndex
+(
+	Index idx,
+	OrderedIndex *oi
+) {
+	ASSERT(idx != NULL);
+	ASSERT(oi  != NULL);
+
+	if(idx->ordered == NULL) return false;
+
+	Attribute_ID attr_id = OrderedIndex_Attribute(oi);
+	uint n = array_len(idx->ordered);
+	for(uint i = 0; i < n; i++) {
+		if(OrderedIndex_Attribute(idx->ordered[i]) == attr_id) {
+			OrderedIndex_Free(idx->ordered[i]);
+			idx->ordered[i] = oi;
+			idx->ordered_restored++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// keep restored ordered indices if every ordered attribute was restored
+// and each holds no more than 'count' entities
+// otherwise reset ordered indices such that population rebuilds them
+// returns true if restored ordered indices are kept
+bool Index_KeepRestoredOrdered
+(
+	Index idx,
+	uint64_t count
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->ordered == NULL) return false;
+
+	bool keep = idx->ordered_restored == array_len(idx->ordered);
+
+	uint n = array_len(idx->ordered);
+	for(uint i = 0; i < n && keep; i++) {
+		OrderedIndex *oi = idx->ordered[i];
+		keep = OrderedIndex_OrderedCount(oi) +
+			OrderedIndex_UnorderedCount(oi) <= count;
+	}
+
+	if(!keep && idx->ordered_restored > 0) {
+		_Index_FreeOrderedStructure(idx);
+		_Index_ConstructOrderedStructure(idx);
+	}
+
+	idx->ordered_loaded   = keep;
+	idx->ordered_restored = 0;
+
+	return keep;
+}
+
+// returns attribute's ordered index
+// NULL if attribute isn't indexed or index doesn't maintain ordered attributes
+const OrderedIndex *Index_GetOrderedIndex
+(
+	const Index idx,
+	Attribute_ID attr_id
+) {
+	ASSERT(idx != NULL);
+
+	if(idx->ordered == NULL) return NULL;
+
+	uint n = array_len(idx->ordered);
+	for(uint i = 0; i < n; i++) {
+		if(OrderedIndex_Attribute(idx->ordered[i]) == attr_id) {
+			return idx->ordered[i];
+		}
+	}
+
+	return NULL;
+}
+
+// returns number of bytes used by index
+size_t Index_MemoryUsage
+(
+	const Index idx  // index to inspect
+) {
+	ASSERT(idx != NULL);
+
+	size_t n = 0;
+
+	if(idx->rsIdx    != NULL) n += RediSearch_MemUsage(idx->rsIdx);
+	if(idx->hnsw     != NULL) n += HNSW_MemoryUsage(idx->hnsw);
+	if(idx->covering != NULL) n += CoveringIndex_MemoryUsage(idx->covering);
+
+	if(idx->ordered != NULL) {
+		uint count = array_len(idx->ordered);
+		for(uint i = 0; i < count; i++) {
+			n += OrderedIndex_MemoryUsage(idx->ordered[i]);
+		}
+	}
+
+	return n;
+}
+
+// returns index's covered attributes
+// NULL if index doesn't cover attributes
+const CoveringIndex *Index_GetCoveringIndex
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+
+	return idx->covering;
+}
+
 // returns true if index doesn't contains any pending changes
 bool Index_Enabled
 (
@@ -594,6 +980,13 @@ void Index_Free
 		RediSearch_DropIndex(idx->rsIdx);
 	}
 
+	if(idx->hnsw) {
+		HNSW_Free(idx->hnsw);
+	}
+
+	_Index_FreeOrderedStructure(idx);
+	_Index_FreeCoveringStructure(idx);
+
 	if(idx->language) {
 		rm_free(idx->language);
 	}
@@ -10,6 +10,9 @@
 #include "../graph/entities/edge.h"
 #include "../graph/entities/graph_entity.h"
 #include "../graph/graph.h"
+#include "./vector/hnsw.h"
+#include "./ordered/ordered_index.h"
+#include "./covering/covering_index.h"
 #include "redisearch_api.h"
 
 #define INDEX_OK 1
@@ -21,6 +24,8 @@
 #define INDEX_FIELD_DEFAULT_NOSTEM false
 #define INDEX_FIELD_DEFAULT_PHONETIC "no"
 
+#define VECTOR_INDEX_MAX_DIMENSION 4096
+
 // initialize index field with default values
 #define IndexField_Default(field, id, name) IndexField_New(field, id, name,  \
 		INDEX_FIELD_DEFAULT_WEIGHT, INDEX_FIELD_DEFAULT_NOSTEM,              \
@@ -34,8 +39,18 @@ typedef enum {
 	IDX_ANY          =  0,
 	IDX_EXACT_MATCH  =  1,
 	IDX_FULLTEXT     =  2,
+	IDX_VECTOR       =  3,
 } IndexType;
 
+// vector index configuration
+typedef struct {
+	uint32_t dimension;           // vectors dimension
+	VectorSimilarity similarity;  // distance function
+	uint16_t M;                   // max number of links per element
+	uint16_t ef_construction;     // candidate list size during insertion
+	uint16_t ef_runtime;          // candidate list size during search
+} VectorIndexOptions;
+
 typedef struct {
 	EntityID src_id;
 	EntityID dest_id;
@@ -128,6 +143,23 @@ void Index_Populate
 	Graph *g    // graph holding entities to index
 );
 
+// populates indices in a single pass over the graph
+// all indices must index the same label / relationship-type
+void Index_PopulateIndices
+(
+	Index *indices,  // indices to populate
+	uint n,          // number of indices
+	Graph *g         // graph holding entities to index
+);
+
+// get index population progress
+void Index_PopulationProgress
+(
+	const Index idx,     // index to inquery
+	uint64_t *populated, // [output] #entities processed
+	uint64_t *total      // [output] #entities to populate
+);
+
 // adds field to index
 void Index_AddField
 (
@@ -248,6 +280,97 @@ void Index_SetStopwords
 	char **stopwords  // stopwords
 );
 
+// set vector index configuration
+// must be called before the index structure is constructed
+void Index_SetVectorOptions
+(
+	Index idx,                       // index modified
+	const VectorIndexOptions *opts   // vector index configuration
+);
+
+// returns attribute's ordered index
+// NULL if attribute isn't indexed or index doesn't maintain ordered attributes
+// only node exact-match indices maintain ordered attributes
+const OrderedIndex *Index_GetOrderedIndex
+(
+	const Index idx,      // index to query
+	Attribute_ID attr_id  // ordered attribute
+);
+
+// replace attribute's ordered index, e.g. with one restored from RDB
+// the index takes ownership of oi and frees its previous ordered index
+// returns false if index doesn't order oi's attribute, oi is left to the caller
+bool Index_SetOrderedIndex
+(
+	Index idx,        // node exact-match index
+	OrderedIndex *oi  // new ordered index
+);
+
+// keep restored ordered indices if every ordered attribute was restored
+// and each holds no more than 'count' entities, population then leaves them
+// untouched, otherwise ordered indices are reset and rebuilt by population
+// returns true if restored ordered indices are kept
+bool Index_KeepRestoredOrdered
+(
+	Index idx,      // pending node exact-match index
+	uint64_t count  // number of nodes carrying the indexed label
+);
+
+// returns index's covered attributes
+// NULL if index doesn't cover attributes
+// only node exact-match indices cover their indexed attributes
+const CoveringIndex *Index_GetCoveringIndex
+(
+	const Index idx  // index to query
+);
+
+// returns vector index configuration
+const VectorIndexOptions *Index_GetVectorOptions
+(
+	const Index idx  // index to query
+);
+
+// returns number of bytes used by index
+// including its RediSearch index and natively maintained structures
+size_t Index_MemoryUsage
+(
+	const Index idx  // index to inspect
+);
+
+// returns vector index HNSW graph
+HNSW *Index_HNSW
+(
+	const Index idx  // index to get internal HNSW graph from
+);
+
+// replace vector index HNSW graph, e.g. with a graph restored from RDB
+// the index takes ownership of hnsw and frees its previous graph
+void Index_SetHNSW
+(
+	Index idx,  // vector index
+	HNSW *hnsw  // new graph
+);
+
+// convert value to a float vector of the given dimension
+// returns false if value isn't an array of dim numerics
+bool Index_VectorFromValue
+(
+	SIValue v,     // value to convert
+	uint32_t dim,  // expected dimension
+	float *out     // [output] dim floats
+);
+
+// search vector index for the k nodes nearest to q
+// returns number of results, at most k
+uint32_t Index_VectorQuery
+(
+	const Index idx,  // vector index to query
+	const float *q,   // query vector
+	uint32_t k,       // number of neighbors
+	EntityID *ids,    // [output] nearest node IDs, sorted by distance
+	float *dists      // [output] distances
+);
+
 // free fulltext index
 void Index_Free
 (
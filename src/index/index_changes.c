@@ -0,0 +1,273 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "index_changes.h"
+#include "../util/arr.h"
+#include "../util/dict.h"
+#include "../util/rmalloc.h"
+#include "../schema/schema.h"
+
+// pending change of a node under a specific label
+typedef struct {
+	NodeID id;      // node ID
+	LabelID label;  // label whose indices are affected
+	bool index;     // true to (re)index node, false to remove it
+	int64_t next;   // position of node's next change, -1 if last
+} NodeChange;
+
+// pending change of an edge
+// an edge ID might be reused within a query, e.g. an edge is deleted and a new
+// edge is created, the edge's endpoints are part of its index key
+// as such each (ID, endpoints) combination is tracked separately
+typedef struct {
+	EdgeID id;          // edge ID
+	NodeID src;         // edge source node
+	NodeID dest;        // edge destination node
+	RelationID rel;     // edge relationship-type
+	bool index;         // true to (re)index edge, false to remove it
+} EdgeChange;
+
+struct IndexChanges {
+	NodeChange *nodes;  // node changes by order of arrival
+	EdgeChange *edges;  // edge changes by order of arrival
+	dict *node_lookup;  // node ID -> 1 + position of node's first change
+	dict *edge_lookup;  // edge ID -> 1 + position of edge's latest change
+};
+
+IndexChanges *IndexChanges_New(void) {
+	IndexChanges *changes = rm_malloc(sizeof(IndexChanges));
+
+	changes->nodes       = array_new(NodeChange, 0);
+	changes->edges       = array_new(EdgeChange, 0);
+	changes->node_lookup = HashTableCreate(&def_dt);
+	changes->edge_lookup = HashTableCreate(&def_dt);
+
+	return changes;
+}
+
+uint64_t IndexChanges_Count
+(
+	const IndexChanges *changes
+) {
+	ASSERT(changes != NULL);
+
+	return array_len(changes->nodes) + array_len(changes->edges);
+}
+
+// record node's final state under label
+static void _IndexChanges_SetNode
+(
+	IndexChanges *changes,  // buffer
+	NodeID id,              // node ID
+	LabelID label,          // affected label
+	bool index              // node's state
+) {
+	// walk node's changes looking for label
+	int64_t prev = -1;
+	int64_t pos  = (int64_t)(uintptr_t)HashTableFetchValue(changes->node_lookup,
+			(void *)id) - 1;
+
+	while(pos != -1) {
+		NodeChange *c = changes->nodes + pos;
+		if(c->label == label) {
+			// override previous state
+			c->index = index;
+			return;
+		}
+		prev = pos;
+		pos  = c->next;
+	}
+
+	// first change of node under label
+	NodeChange c = {.id = id, .label = label, .index = index, .next = -1};
+	array_append(changes->nodes, c);
+	pos = array_len(changes->nodes) - 1;
+
+	if(prev == -1) {
+		HashTableAdd(changes->node_lookup, (void *)id,
+				(void *)(uintptr_t)(pos + 1));
+	} else {
+		changes->nodes[prev].next = pos;
+	}
+}
+
+// record edge's final state
+static void _IndexChanges_SetEdge
+(
+	IndexChanges *changes,  // buffer
+	const Edge *e,          // edge
+	bool index              // edge's state
+) {
+	EdgeID     id   = ENTITY_GET_ID(e);
+	NodeID     src  = Edge_GetSrcNodeID(e);
+	NodeID     dest = Edge_GetDestNodeID(e);
+	RelationID rel  = Edge_GetRelationID(e);
+
+	dictEntry *entry = HashTableFind(changes->edge_lookup, (void *)id);
+	if(entry != NULL) {
+		uint64_t pos = (uint64_t)(uintptr_t)HashTableGetVal(entry) - 1;
+		EdgeChange *c = changes->edges + pos;
+		if(c->src == src && c->dest == dest && c->rel == rel) {
+			// override previous state
+			c->index = index;
+			return;
+		}
+	}
+
+	EdgeChange c = {.id = id, .src = src, .dest = dest, .rel = rel,
+		.index = index};
+	array_append(changes->edges, c);
+	uint64_t pos = array_len(changes->edges);
+
+	if(entry != NULL) {
+		// edge ID reused, track latest change
+		HashTableSetVal(changes->edge_lookup, entry, (void *)(uintptr_t)pos);
+	} else {
+		HashTableAdd(changes->edge_lookup, (void *)id, (void *)(uintptr_t)pos);
+	}
+}
+
+void IndexChanges_IndexNode
+(
+	IndexChanges *changes,
+	NodeID id,
+	LabelID label
+) {
+	ASSERT(changes != NULL);
+
+	_IndexChanges_SetNode(changes, id, label, true);
+}
+
+void IndexChanges_RemoveNode
+(
+	IndexChanges *changes,
+	NodeID id,
+	LabelID label
+) {
+	ASSERT(changes != NULL);
+
+	_IndexChanges_SetNode(changes, id, label, false);
+}
+
+void IndexChanges_IndexEdge
+(
+	IndexChanges *changes,
+	const Edge *e
+) {
+	ASSERT(e       != NULL);
+	ASSERT(changes != NULL);
+
+	_IndexChanges_SetEdge(changes, e, true);
+}
+
+void IndexChanges_RemoveEdge
+(
+	IndexChanges *changes,
+	const Edge *e
+) {
+	ASSERT(e       != NULL);
+	ASSERT(changes != NULL);
+
+	_IndexChanges_SetEdge(changes, e, false);
+}
+
+void IndexChanges_Apply
+(
+	IndexChanges *changes,
+	GraphContext *gc
+) {
+	ASSERT(gc      != NULL);
+	ASSERT(changes != NULL);
+
+	Graph *g = GraphContext_GetGraph(gc);
+
+	//--------------------------------------------------------------------------
+	// apply node changes
+	//--------------------------------------------------------------------------
+
+	uint64_t n = array_len(changes->nodes);
+	for(uint64_t i = 0; i < n; i++) {
+		NodeChange *c = changes->nodes + i;
+		Schema *s = GraphContext_GetSchemaByID(gc, c->label, SCHEMA_NODE);
+		ASSERT(s != NULL);
+
+		if(!Schema_HasIndices(s)) continue;
+
+		Node node = GE_NEW_NODE();
+		if(c->index) {
+			bool found = Graph_GetNode(g, c->id, &node);
+			UNUSED(found);
+			ASSERT(found == true);
+			Schema_AddNodeToIndices(s, &node);
+		} else {
+			// removal only requires node's ID
+			node.id = c->id;
+			Schema_RemoveNodeFromIndices(s, &node);
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	// apply edge changes
+	//--------------------------------------------------------------------------
+
+	n = array_len(changes->edges);
+	for(uint64_t i = 0; i < n; i++) {
+		EdgeChange *c = changes->edges + i;
+		Schema *s = GraphContext_GetSchemaByID(gc, c->rel, SCHEMA_EDGE);
+		ASSERT(s != NULL);
+
+		if(!Schema_HasIndices(s)) continue;
+
+		Edge e = GE_NEW_LABELED_EDGE(NULL, c->rel);
+		e.src_id  = c->src;
+		e.dest_id = c->dest;
+
+		if(c->index) {
+			bool found = Graph_GetEdge(g, c->id, &e);
+			UNUSED(found);
+			ASSERT(found == true);
+			Schema_AddEdgeToIndices(s, &e);
+		} else {
+			// removal only requires edge's key
+			e.id = c->id;
+			Schema_RemoveEdgeFromIndices(s, &e);
+		}
+	}
+
+	IndexChanges_Clear(changes);
+}
+
+void IndexChanges_Clear
+(
+	IndexChanges *changes
+) {
+	ASSERT(changes != NULL);
+
+	array_clear(changes->nodes);
+	array_clear(changes->edges);
+	HashTableEmpty(changes->node_lookup, NULL);
+	HashTableEmpty(changes->edge_lookup, NULL);
+}
+
+void IndexChanges_Free
+(
+	IndexChanges **changes
+) {
+	ASSERT(changes != NULL);
+
+	IndexChanges *c = *changes;
+	if(c == NULL) return;
+
+	array_free(c->nodes);
+	array_free(c->edges);
+	HashTableRelease(c->node_lookup);
+	HashTableRelease(c->edge_lookup);
+	rm_free(c);
+
+	*changes = NULL;
+}
+
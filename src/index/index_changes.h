@@ -0,0 +1,80 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../graph/graphcontext.h"
+#include "../graph/entities/node.h"
+#include "../graph/entities/edge.h"
+
+// index changes buffer
+//
+// collects the index maintenance required by a query's modifications
+// changes are deduplicated by entity, only the entity's final state is
+// recorded, e.g. a node updated multiple times is reindexed once
+// changes are applied in bulk once the modifying operation commits
+typedef struct IndexChanges IndexChanges;
+
+// create a new index changes buffer
+IndexChanges *IndexChanges_New(void);
+
+// returns number of pending changes
+uint64_t IndexChanges_Count
+(
+	const IndexChanges *changes  // buffer
+);
+
+// mark node as requiring reindexing under label
+void IndexChanges_IndexNode
+(
+	IndexChanges *changes,  // buffer
+	NodeID id,              // node to index
+	LabelID label           // label whose indices are updated
+);
+
+// mark node as requiring removal from label's indices
+void IndexChanges_RemoveNode
+(
+	IndexChanges *changes,  // buffer
+	NodeID id,              // node to remove
+	LabelID label           // label whose indices are updated
+);
+
+// mark edge as requiring reindexing
+void IndexChanges_IndexEdge
+(
+	IndexChanges *changes,  // buffer
+	const Edge *e           // edge to index
+);
+
+// mark edge as requiring removal from its relationship-type indices
+void IndexChanges_RemoveEdge
+(
+	IndexChanges *changes,  // buffer
+	const Edge *e           // edge to remove
+);
+
+// apply pending changes to the graph's indices and clear buffer
+// entities are reindexed using their current attributes
+// expecting the graph to be write locked
+void IndexChanges_Apply
+(
+	IndexChanges *changes,  // buffer
+	GraphContext *gc        // graph context
+);
+
+// discard pending changes
+void IndexChanges_Clear
+(
+	IndexChanges *changes  // buffer
+);
+
+// free buffer
+void IndexChanges_Free
+(
+	IndexChanges **changes  // buffer
+);
+
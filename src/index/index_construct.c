@@ -6,137 +6,197 @@
 
 #include "RG.h"
 #include "index.h"
+#include "../util/arr.h"
+#include "../util/thpool/pools.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
 
 #include <assert.h>
-
-// index nodes in an asynchronous manner
-// nodes are being indexed in batchs while the graph's read lock is held
-// to avoid interfering with the DB ongoing operation after each batch of nodes
-// is indexed the graph read lock is released
-// alowing for write queries to be processed
+#include <pthread.h>
+#include <stdatomic.h>
+
+// index population splits the scanned matrix rows into fixed size chunks
+// chunks are claimed by a number of workers, each worker indexes its chunk
+// in batches, for every batch the graph read lock is acquired
+// once the batch is indexed the read lock is released
+// allowing for write queries to be processed
+//
+// documents are built by the workers concurrently while their insertion into
+// the indices is serialized, a single pass over the graph populates all indices
+// sharing the same label
+
+#define POPULATE_CHUNK_SIZE   65536  // #matrix rows in a chunk
+#define NODE_BATCH_SIZE       10000  // max #nodes to index in one go
+#define EDGE_BATCH_SIZE       1000   // max #edges to index in one go
+
+extern RSDoc *Index_NodeDocument(Index idx, const Node *n);
+extern void Index_AddNodeDocument(Index idx, const Node *n, RSDoc *doc);
+extern RSDoc *Index_EdgeDocument(Index idx, const Edge *e);
+extern void Index_AddEdgeDocument(Index idx, const Edge *e, RSDoc *doc);
+extern void Index_PopulationBegin(Index idx, uint64_t total);
+extern void Index_PopulationAdvance(Index idx, uint64_t n);
+
+// population context shared by all workers
+typedef struct {
+	Index *indices;               // indices to populate
+	uint n;                       // number of indices
+	int label_id;                 // indexed label / relationship-type
+	Graph *g;                     // graph holding entities to index
+	uint64_t chunk_count;         // number of chunks
+	uint64_t _Atomic next_chunk;  // next chunk to process
+	pthread_mutex_t lock;         // serializes index updates
+} PopulateCtx;
+
+// worker's batch
+typedef struct {
+	Index *active;  // indices populated by the batch
+	Node *nodes;    // batched nodes
+	Edge *edges;    // batched edges
+	RSDoc **docs;   // batched documents, entity major
+} PopulateBatch;
+
+// collects indices which are still to be populated
+// returns number of active indices
 //
-// it is safe to run a write query which effects the index by either:
-// adding/removing/updating an entity while the index is being populated
-// in the "worst" case we will index that entity twice which is perfectly OK
-static void _Index_PopulateNodeIndex
+// an index state can change while being populated
+// this can happen if for example the following sequance is issued:
+// 1. CREATE INDEX FOR (n:Person) ON (n.age)
+// 2. CREATE INDEX FOR (n:Person) ON (n.height)
+// in which case the index's population is aborted, a later population task
+// will populate it
+static uint _ActiveIndices
 (
-	Index idx,
-	Graph *g
+	const PopulateCtx *ctx,  // population context
+	PopulateBatch *b         // batch to populate
 ) {
-	ASSERT(g   != NULL);
-	ASSERT(idx != NULL);
+	array_clear(b->active);
 
-	GrB_Index          rowIdx     = 0;
-	int                indexed    = 0;      // #entities in current batch
-	int                batch_size = 10000;  // max #entities to index in one go
-	RG_MatrixTupleIter it         = {0};
+	for(uint i = 0; i < ctx->n; i++) {
+		Index idx = ctx->indices[i];
+		if(Index_PendingChanges(idx) <= 1) {
+			array_append(b->active, idx);
+		}
+	}
+
+	return array_len(b->active);
+}
+
+// index nodes within the [start, end] range of the label matrix
+// returns false if there are no indices left to populate
+static bool _PopulateNodeChunk
+(
+	PopulateCtx *ctx,  // population context
+	PopulateBatch *b,  // worker's batch
+	GrB_Index start,   // first row in chunk
+	GrB_Index end      // last row in chunk
+) {
+	Graph              *g   = ctx->g;
+	GrB_Index          row  = start;
+	RG_MatrixTupleIter it   = {0};
 
 	while(true) {
 		// lock graph for reading
 		Graph_AcquireReadLock(g);
 
-		// index state changed, abort indexing
-		// this can happen if for example the following sequance is issued:
-		// 1. CREATE INDEX FOR (n:Person) ON (n.age)
-		// 2. CREATE INDEX FOR (n:Person) ON (n.height)
-		if(Index_PendingChanges(idx) > 1) {
-			break;
+		uint active = _ActiveIndices(ctx, b);
+		if(active == 0) {
+			Graph_ReleaseLock(g);
+			return false;
 		}
 
-		// reset number of indexed nodes in batch
-		indexed = 0;
-
 		// fetch label matrix
-		const RG_Matrix m = Graph_GetLabelMatrix(g, Index_GetLabelID(idx));
+		const RG_Matrix m = Graph_GetLabelMatrix(g, ctx->label_id);
 		ASSERT(m != NULL);
 
 		//----------------------------------------------------------------------
-		// resume scanning from rowIdx
+		// resume scanning from row
 		//----------------------------------------------------------------------
 
 		GrB_Info info;
 		info = RG_MatrixTupleIter_attach(&it, m);
 		ASSERT(info == GrB_SUCCESS);
-		info = RG_MatrixTupleIter_iterate_range(&it, rowIdx, UINT64_MAX);
+		info = RG_MatrixTupleIter_iterate_range(&it, row, end);
 		ASSERT(info == GrB_SUCCESS);
 
 		//----------------------------------------------------------------------
-		// batch index nodes
+		// build documents
 		//----------------------------------------------------------------------
 
 		EntityID id;
-		while(indexed < batch_size &&
+		array_clear(b->nodes);
+		array_clear(b->docs);
+		while(array_len(b->nodes) < NODE_BATCH_SIZE &&
 			  RG_MatrixTupleIter_next_BOOL(&it, &id, NULL, NULL) == GrB_SUCCESS)
 		{
 			Node n;
 			Graph_GetNode(g, id, &n);
-			Index_IndexNode(idx, &n);
-			indexed++;
+			array_append(b->nodes, n);
+
+			for(uint i = 0; i < active; i++) {
+				array_append(b->docs, Index_NodeDocument(b->active[i], &n));
+			}
 		}
 
 		//----------------------------------------------------------------------
-		// done with current batch
+		// add batch to indices
 		//----------------------------------------------------------------------
 
-		if(indexed != batch_size) {
-			// iterator depleted, no more nodes to index
-			break;
-		} else {
-			// release read lock
-			Graph_ReleaseLock(g);
+		uint indexed = array_len(b->nodes);
 
-			// finished current batch
-			RG_MatrixTupleIter_detach(&it);
+		pthread_mutex_lock(&ctx->lock);
+		for(uint j = 0; j < indexed; j++) {
+			for(uint i = 0; i < active; i++) {
+				Index_AddNodeDocument(b->active[i], b->nodes + j,
+						b->docs[j * active + i]);
+			}
+		}
+		pthread_mutex_unlock(&ctx->lock);
 
-			// continue next batch from row id+1
-			// this is true because we're iterating over a diagonal matrix
-			rowIdx = id + 1;
+		// release read lock
+		Graph_ReleaseLock(g);
+		RG_MatrixTupleIter_detach(&it);
+
+		for(uint i = 0; i < active; i++) {
+			Index_PopulationAdvance(b->active[i], indexed);
 		}
-	}
 
-	// release read lock
-	Graph_ReleaseLock(g);
-	RG_MatrixTupleIter_detach(&it);
+		if(indexed != NODE_BATCH_SIZE) {
+			// chunk depleted
+			return true;
+		}
+
+		// continue next batch from row id+1
+		// this is true because we're iterating over a diagonal matrix
+		row = id + 1;
+	}
 }
 
-// index edges in an asynchronous manner
-// edges are being indexed in batchs while the graph's read lock is held
-// to avoid interfering with the DB ongoing operation after each batch of edges
-// is indexed the graph read lock is released
-// alowing for write queries to be processed
-//
-// it is safe to run a write query which effects the index by either:
-// adding/removing/updating an entity while the index is being populated
-// in the "worst" case we will index that entity twice which is perfectly OK
-static void _Index_PopulateEdgeIndex
+// index edges within the [start, end] row range of the relation matrix
+// returns false if there are no indices left to populate
+static bool _PopulateEdgeChunk
 (
-	Index idx,
-	Graph *g
+	PopulateCtx *ctx,  // population context
+	PopulateBatch *b,  // worker's batch
+	GrB_Index start,   // first row in chunk
+	GrB_Index end      // last row in chunk
 ) {
-	ASSERT(g   != NULL);
-	ASSERT(idx != NULL);
-
 	GrB_Info  info;
-	EntityID  src_id       = 0;     // current processed row idx
-	EntityID  dest_id      = 0;     // current processed column idx
-	EntityID  edge_id      = 0;     // current processed edge id
-	EntityID  prev_src_id  = 0;     // last processed row idx
-	EntityID  prev_dest_id = 0;     // last processed column idx
-	int       indexed      = 0;     // number of entities indexed in current batch
-	int       batch_size   = 1000;  // max number of entities to index in one go
+	Graph     *g           = ctx->g;
+	EntityID  src_id       = start;  // current processed row idx
+	EntityID  dest_id      = 0;      // current processed column idx
+	EntityID  edge_id      = 0;      // current processed edge id
+	EntityID  prev_src_id  = 0;      // last processed row idx
+	EntityID  prev_dest_id = 0;      // last processed column idx
+	int       indexed      = 0;      // #entries indexed in current batch
 	RG_MatrixTupleIter it  = {0};
 
 	while(true) {
 		// lock graph for reading
 		Graph_AcquireReadLock(g);
 
-		// index state changed, abort indexing
-		// this can happen if for example the following sequance is issued:
-		// 1. CREATE INDEX FOR (:Person)-[e:WORKS]-(:Company) ON (e.since)
-		// 2. CREATE INDEX FOR (:Person)-[e:WORKS]-(:Company) ON (e.title)
-		if(Index_PendingChanges(idx) > 1) {
-			break;
+		uint active = _ActiveIndices(ctx, b);
+		if(active == 0) {
+			Graph_ReleaseLock(g);
+			return false;
 		}
 
 		// reset number of indexed edges in batch
@@ -145,8 +205,7 @@ static void _Index_PopulateEdgeIndex
 		prev_dest_id = dest_id;
 
 		// fetch relation matrix
-		const RG_Matrix m = Graph_GetRelationMatrix(g, Index_GetLabelID(idx),
-				false);
+		const RG_Matrix m = Graph_GetRelationMatrix(g, ctx->label_id, false);
 		ASSERT(m != NULL);
 
 		//----------------------------------------------------------------------
@@ -155,7 +214,7 @@ static void _Index_PopulateEdgeIndex
 
 		info = RG_MatrixTupleIter_attach(&it, m);
 		ASSERT(info == GrB_SUCCESS);
-		info = RG_MatrixTupleIter_iterate_range(&it, src_id, UINT64_MAX);
+		info = RG_MatrixTupleIter_iterate_range(&it, src_id, end);
 		ASSERT(info == GrB_SUCCESS);
 
 		// skip previously indexed edges
@@ -166,55 +225,178 @@ static void _Index_PopulateEdgeIndex
 
 		// process only if iterator is on an active entry
 		if(info != GrB_SUCCESS) {
-			break;
+			Graph_ReleaseLock(g);
+			RG_MatrixTupleIter_detach(&it);
+			return true;
 		}
 
 		//----------------------------------------------------------------------
-		// batch index edges
+		// collect edges
 		//----------------------------------------------------------------------
 
+		array_clear(b->edges);
+		array_clear(b->docs);
+
 		do {
 			Edge e;
 			e.src_id     = src_id;
 			e.dest_id    = dest_id;
-			e.relationID = Index_GetLabelID(idx);
+			e.relationID = ctx->label_id;
 
 			if(SINGLE_EDGE(edge_id)) {
 				Graph_GetEdge(g, edge_id, &e);
-				Index_IndexEdge(idx, &e);
+				array_append(b->edges, e);
 			} else {
 				EdgeID *edgeIds = (EdgeID *)(CLEAR_MSB(edge_id));
 				uint edgeCount = array_len(edgeIds);
 
 				for(uint i = 0; i < edgeCount; i++) {
-					edge_id = edgeIds[i];
-					Graph_GetEdge(g, edge_id, &e);
-					Index_IndexEdge(idx, &e);
+					Graph_GetEdge(g, edgeIds[i], &e);
+					array_append(b->edges, e);
 				}
 			}
 			indexed++; // single/multi edge are counted similarly
-		} while(indexed < batch_size &&
+		} while(indexed < EDGE_BATCH_SIZE &&
 			  RG_MatrixTupleIter_next_UINT64(&it, &src_id, &dest_id, &edge_id)
 				== GrB_SUCCESS);
 
 		//----------------------------------------------------------------------
-		// done with current batch
+		// build documents
 		//----------------------------------------------------------------------
 
-		if(indexed != batch_size) {
-			// iterator depleted, no more edges to index
-			break;
-		} else {
-			// finished current batch
-			// release read lock
-			Graph_ReleaseLock(g);
-			RG_MatrixTupleIter_detach(&it);
+		uint edge_count = array_len(b->edges);
+		for(uint j = 0; j < edge_count; j++) {
+			for(uint i = 0; i < active; i++) {
+				array_append(b->docs,
+						Index_EdgeDocument(b->active[i], b->edges + j));
+			}
+		}
+
+		//----------------------------------------------------------------------
+		// add batch to indices
+		//----------------------------------------------------------------------
+
+		pthread_mutex_lock(&ctx->lock);
+		for(uint j = 0; j < edge_count; j++) {
+			for(uint i = 0; i < active; i++) {
+				Index_AddEdgeDocument(b->active[i], b->edges + j,
+						b->docs[j * active + i]);
+			}
 		}
+		pthread_mutex_unlock(&ctx->lock);
+
+		// release read lock
+		Graph_ReleaseLock(g);
+		RG_MatrixTupleIter_detach(&it);
+
+		for(uint i = 0; i < active; i++) {
+			Index_PopulationAdvance(b->active[i], edge_count);
+		}
+
+		if(indexed != EDGE_BATCH_SIZE) {
+			// chunk depleted
+			return true;
+		}
+	}
+}
+
+// population worker
+// claims chunks until either all chunks are processed
+// or there are no indices left to populate
+static void _PopulateWorker
+(
+	void *arg
+) {
+	PopulateCtx *ctx = (PopulateCtx *)arg;
+	bool nodes = Index_GraphEntityType(ctx->indices[0]) == GETYPE_NODE;
+
+	PopulateBatch b;
+	b.active = array_new(Index, ctx->n);
+	b.nodes  = array_new(Node, nodes ? NODE_BATCH_SIZE : 0);
+	b.edges  = array_new(Edge, nodes ? 0 : EDGE_BATCH_SIZE);
+	b.docs   = array_new(RSDoc *, ctx->n *
+			(nodes ? NODE_BATCH_SIZE : EDGE_BATCH_SIZE));
+
+	while(true) {
+		uint64_t chunk = atomic_fetch_add(&ctx->next_chunk, 1);
+		if(chunk >= ctx->chunk_count) break;
+
+		GrB_Index start = chunk * POPULATE_CHUNK_SIZE;
+		// last chunk extends to the end of the matrix
+		GrB_Index end = (chunk == ctx->chunk_count - 1) ?
+			UINT64_MAX : start + POPULATE_CHUNK_SIZE - 1;
+
+		bool active = nodes ?
+			_PopulateNodeChunk(ctx, &b, start, end) :
+			_PopulateEdgeChunk(ctx, &b, start, end);
+
+		if(!active) break;
 	}
 
-	// release read lock
+	array_free(b.docs);
+	array_free(b.nodes);
+	array_free(b.edges);
+	array_free(b.active);
+}
+
+// populates indices in a single pass over the graph
+// all indices must index the same label / relationship-type
+void Index_PopulateIndices
+(
+	Index *indices,  // indices to populate
+	uint n,          // number of indices
+	Graph *g         // graph holding entities to index
+) {
+	ASSERT(g       != NULL);
+	ASSERT(n       > 0);
+	ASSERT(indices != NULL);
+
+	int label_id = Index_GetLabelID(indices[0]);
+	GraphEntityType t = Index_GraphEntityType(indices[0]);
+
+	for(uint i = 0; i < n; i++) {
+		ASSERT(!Index_Enabled(indices[i]));  // index should have pending changes
+		ASSERT(Index_GetLabelID(indices[i]) == label_id);
+		ASSERT(Index_GraphEntityType(indices[i]) == t);
+	}
+
+	PopulateCtx ctx;
+	ctx.g          = g;
+	ctx.n          = n;
+	ctx.indices    = indices;
+	ctx.label_id   = label_id;
+	ctx.next_chunk = ATOMIC_VAR_INIT(0);
+
+	int res = pthread_mutex_init(&ctx.lock, NULL);
+	ASSERT(res == 0);
+
+	//--------------------------------------------------------------------------
+	// determine scan range and population progress
+	//--------------------------------------------------------------------------
+
+	Graph_AcquireReadLock(g);
+
+	uint64_t total = (t == GETYPE_NODE) ?
+		Graph_LabeledNodeCount(g, label_id) :
+		Graph_RelationEdgeCount(g, label_id);
+
+	for(uint i = 0; i < n; i++) {
+		Index_PopulationBegin(indices[i], total);
+	}
+
+	// entities created once population began are indexed by their creator
+	ctx.chunk_count = Graph_RequiredMatrixDim(g) / POPULATE_CHUNK_SIZE + 1;
+
 	Graph_ReleaseLock(g);
-	RG_MatrixTupleIter_detach(&it);
+
+	//--------------------------------------------------------------------------
+	// populate indices
+	//--------------------------------------------------------------------------
+
+	// chunks are claimed by the workers, no point in having more workers
+	ThreadPools_RunParallel(_PopulateWorker, &ctx, ctx.chunk_count);
+
+	pthread_mutex_destroy(&ctx.lock);
 }
 
 // constructs index
@@ -225,16 +407,7 @@ void Index_Populate
 ) {
 	ASSERT(g != NULL);
 	ASSERT(idx != NULL);
-	ASSERT(!Index_Enabled(idx));  // index should have pending changes
 
-	//--------------------------------------------------------------------------
-	// populate index
-	//--------------------------------------------------------------------------
-
-	if(Index_GraphEntityType(idx) == GETYPE_NODE) {
-		_Index_PopulateNodeIndex(idx, g);
-	} else {
-		_Index_PopulateEdgeIndex(idx, g);
-	}
+	Index_PopulateIndices(&idx, 1, g);
 }
 
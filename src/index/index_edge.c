@@ -14,7 +14,11 @@
 extern RSDoc *Index_IndexGraphEntity(Index idx,const GraphEntity *e,
 		const void *key, size_t key_len, uint *doc_field_count);
 
-void Index_IndexEdge
+// builds edge's RediSearch document
+// returns NULL if edge doesn't possess any indexed attribute
+// documents can be built concurrently, while adding them to the index
+// via Index_AddEdgeDocument requires exclusive access to the index
+RSDoc *Index_EdgeDocument
 (
 	Index idx,
 	const Edge *e
@@ -23,7 +27,6 @@ void Index_IndexEdge
 	ASSERT(e    !=  NULL);
 
 	RSDoc    *doc    = NULL;
-	RSIndex  *rsIdx  = Index_RSIndex(idx);
 	EntityID src_id  = Edge_GetSrcNodeID(e);
 	EntityID dest_id = Edge_GetDestNodeID(e);
 	EntityID edge_id = ENTITY_GET_ID(e);
@@ -37,17 +40,49 @@ void Index_IndexEdge
 
 	if(doc_field_count == 0) {
 		// entity doesn't possess any attributes which are indexed
-		// remove entity from index and delete document
-		Index_RemoveEdge(idx, e);
 		RediSearch_FreeDocument(doc);
-		return;
+		return NULL;
 	}
 
-	// add document to active RediSearch index
 	// add src_node and dest_node fields
 	RediSearch_DocumentAddFieldNumber(doc, "_src_id", src_id, RSFLDTYPE_NUMERIC);
 	RediSearch_DocumentAddFieldNumber(doc, "_dest_id", dest_id, RSFLDTYPE_NUMERIC);
-	RediSearch_SpecAddDocument(rsIdx, doc);
+
+	return doc;
+}
+
+// adds edge's document to index
+// a NULL document removes the edge from the index
+void Index_AddEdgeDocument
+(
+	Index idx,
+	const Edge *e,
+	RSDoc *doc
+) {
+	ASSERT(idx  !=  NULL);
+	ASSERT(e    !=  NULL);
+
+	if(doc == NULL) {
+		// entity doesn't possess any attributes which are indexed
+		// remove entity from index
+		Index_RemoveEdge(idx, e);
+		return;
+	}
+
+	// add document to active RediSearch index
+	RediSearch_SpecAddDocument(Index_RSIndex(idx), doc);
+}
+
+void Index_IndexEdge
+(
+	Index idx,
+	const Edge *e
+) {
+	ASSERT(idx  !=  NULL);
+	ASSERT(e    !=  NULL);
+
+	RSDoc *doc = Index_EdgeDocument(idx, e);
+	Index_AddEdgeDocument(idx, e, doc);
 }
 
 void Index_RemoveEdge
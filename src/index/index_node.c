@@ -13,8 +13,18 @@
 
 extern RSDoc *Index_IndexGraphEntity(Index idx, const GraphEntity *e,
 		const void *key, size_t key_len, uint *doc_field_count);
+extern void Index_VectorIndexNode(Index idx, const Node *n);
+extern void Index_VectorRemoveNode(Index idx, const Node *n);
+extern void Index_OrderedIndexEntity(Index idx, const GraphEntity *e);
+extern void Index_OrderedRemoveEntity(Index idx, EntityID id);
+extern void Index_CoverEntity(Index idx, const GraphEntity *e);
+extern void Index_UncoverEntity(Index idx, EntityID id);
 
-void Index_IndexNode
+// builds node's RediSearch document
+// returns NULL if node doesn't possess any indexed attribute
+// documents can be built concurrently, while adding them to the index
+// via Index_AddNodeDocument requires exclusive access to the index
+RSDoc *Index_NodeDocument
 (
 	Index idx,
 	const Node *n
@@ -22,26 +32,68 @@ void Index_IndexNode
 	ASSERT(n    !=  NULL);
 	ASSERT(idx  !=  NULL);
 
+	// vector indices are maintained natively
+	if(Index_Type(idx) == IDX_VECTOR) return NULL;
+
 	EntityID key             = ENTITY_GET_ID(n);
-	RSDoc    *doc            = NULL;
-	RSIndex  *rsIdx          = Index_RSIndex(idx);
 	size_t   key_len         = sizeof(EntityID);
 	uint     doc_field_count = 0;
 
 	// create RediSearch document representing node
-	doc = Index_IndexGraphEntity(idx, (const GraphEntity *)n,
+	RSDoc *doc = Index_IndexGraphEntity(idx, (const GraphEntity *)n,
 			(const void *)&key, key_len, &doc_field_count);
 
 	if(doc_field_count == 0) {
 		// entity doesn't poses any attributes which are indexed
-		// remove entity from index and delete document
-		Index_RemoveNode(idx, n);
 		RediSearch_FreeDocument(doc);
+		return NULL;
+	}
+
+	return doc;
+}
+
+// adds node's document to index
+// a NULL document removes the node from the index
+void Index_AddNodeDocument
+(
+	Index idx,
+	const Node *n,
+	RSDoc *doc
+) {
+	ASSERT(n    !=  NULL);
+	ASSERT(idx  !=  NULL);
+
+	if(Index_Type(idx) == IDX_VECTOR) {
+		ASSERT(doc == NULL);
+		Index_VectorIndexNode(idx, n);
+		return;
+	}
+
+	if(doc == NULL) {
+		// entity doesn't poses any attributes which are indexed
+		// remove entity from index
+		Index_RemoveNode(idx, n);
 		return;
 	}
 
 	// add document to RediSearch index
-	RediSearch_SpecAddDocument(rsIdx, doc);
+	RediSearch_SpecAddDocument(Index_RSIndex(idx), doc);
+
+	// update ordered and covered attributes
+	Index_OrderedIndexEntity(idx, (const GraphEntity *)n);
+	Index_CoverEntity(idx, (const GraphEntity *)n);
+}
+
+void Index_IndexNode
+(
+	Index idx,
+	const Node *n
+) {
+	ASSERT(n    !=  NULL);
+	ASSERT(idx  !=  NULL);
+
+	RSDoc *doc = Index_NodeDocument(idx, n);
+	Index_AddNodeDocument(idx, n, doc);
 }
 
 void Index_RemoveNode
@@ -52,9 +104,16 @@ void Index_RemoveNode
 	ASSERT(n   != NULL);
 	ASSERT(idx != NULL);
 
+	if(Index_Type(idx) == IDX_VECTOR) {
+		Index_VectorRemoveNode(idx, n);
+		return;
+	}
+
 	EntityID id     = ENTITY_GET_ID(n);
 	RSIndex  *rsIdx = Index_RSIndex(idx);
 
 	RediSearch_DeleteDocument(rsIdx, &id, sizeof(EntityID));
+	Index_OrderedRemoveEntity(idx, id);
+	Index_UncoverEntity(idx, id);
 }
 
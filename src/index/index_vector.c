@@ -0,0 +1,89 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "index.h"
+#include "../value.h"
+#include "../datatypes/array.h"
+
+bool Index_VectorFromValue
+(
+	SIValue v,
+	uint32_t dim,
+	float *out
+) {
+	ASSERT(out != NULL);
+
+	if(SI_TYPE(v) != T_ARRAY) return false;
+	if(SIArray_Length(v) != dim) return false;
+
+	for(uint32_t i = 0; i < dim; i++) {
+		SIValue elem = SIArray_Get(v, i);
+		if(!(SI_TYPE(elem) & SI_NUMERIC)) return false;
+		out[i] = (float)SI_GET_NUMERIC(elem);
+	}
+
+	return true;
+}
+
+// index node's vector
+// nodes which do not hold a valid vector under the indexed attribute
+// are removed from the index
+void Index_VectorIndexNode
+(
+	Index idx,
+	const Node *n
+) {
+	ASSERT(n   != NULL);
+	ASSERT(idx != NULL);
+	ASSERT(Index_Type(idx) == IDX_VECTOR);
+	ASSERT(Index_FieldsCount(idx) == 1);
+
+	HNSW *hnsw = Index_HNSW(idx);
+	EntityID id = ENTITY_GET_ID(n);
+	const IndexField *field = Index_GetFields(idx);
+	uint32_t dim = Index_GetVectorOptions(idx)->dimension;
+
+	float vec[dim];
+	SIValue *v = GraphEntity_GetProperty((const GraphEntity *)n, field->id);
+	if(v == ATTRIBUTE_NOTFOUND || !Index_VectorFromValue(*v, dim, vec)) {
+		HNSW_Remove(hnsw, id);
+		return;
+	}
+
+	HNSW_Insert(hnsw, id, vec);
+}
+
+void Index_VectorRemoveNode
+(
+	Index idx,
+	const Node *n
+) {
+	ASSERT(n   != NULL);
+	ASSERT(idx != NULL);
+	ASSERT(Index_Type(idx) == IDX_VECTOR);
+
+	HNSW_Remove(Index_HNSW(idx), ENTITY_GET_ID(n));
+}
+
+uint32_t Index_VectorQuery
+(
+	const Index idx,
+	const float *q,
+	uint32_t k,
+	EntityID *ids,
+	float *dists
+) {
+	ASSERT(q     != NULL);
+	ASSERT(idx   != NULL);
+	ASSERT(ids   != NULL);
+	ASSERT(dists != NULL);
+	ASSERT(Index_Type(idx) == IDX_VECTOR);
+
+	const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+	return HNSW_Search(Index_HNSW(idx), q, k, opts->ef_runtime,
+			(uint64_t *)ids, dists);
+}
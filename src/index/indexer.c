@@ -6,6 +6,7 @@
 
 #include "indexer.h"
 #include "../redismodule.h"
+#include "../util/arr.h"
 #include "../util/circular_buffer.h"
 #include <assert.h>
 #include <pthread.h>
@@ -63,38 +64,51 @@ static void _indexer_PopTask(IndexerTask *task);
 static Indexer *indexer = NULL;
 
 // index populate task handler
+// populates all indices in a single pass over the graph
 static void _indexer_idx_populate
 (
-	IndexPopulateCtx *ctx
+	IndexPopulateCtx **tasks  // population tasks sharing the same label
 ) {
-	Index idx = ctx->idx;
-	GraphContext *gc = ctx->gc;
+	uint n = array_len(tasks);
+	GraphContext *gc = tasks[0]->gc;
+
+	Index indices[n];
+	for(uint i = 0; i < n; i++) {
+		indices[i] = tasks[i]->idx;
+	}
 
-	// populate index
-	Index_Populate(idx, ctx->gc->g);
+	// populate indices
+	Index_PopulateIndices(indices, n, gc->g);
 
 	// we're required to hold both GIL and write lock
 	// as Schema_ActivateIndex might drop an index
 	RedisModuleCtx *rm_ctx = RedisModule_GetThreadSafeContext(NULL);
 	RedisModule_ThreadSafeContextLock(rm_ctx);
-	Graph_AcquireWriteLock(ctx->gc->g);
+	Graph_AcquireWriteLock(gc->g);
+
+	for(uint i = 0; i < n; i++) {
+		IndexPopulateCtx *ctx = tasks[i];
 
-	// index populated, try to enable
-	Index_Enable(idx);
+		// index populated, try to enable
+		Index_Enable(ctx->idx);
 
-	if(Index_Enabled(idx)) {
-		Schema_ActivateIndex(ctx->s, idx);
+		if(Index_Enabled(ctx->idx)) {
+			Schema_ActivateIndex(ctx->s, ctx->idx);
+		}
 	}
 
 	// release locks
-	Graph_ReleaseLock(ctx->gc->g);
+	Graph_ReleaseLock(gc->g);
 	RedisModule_ThreadSafeContextUnlock(rm_ctx);
 	RedisModule_FreeThreadSafeContext(rm_ctx);
 
-	// decrease graph reference count
-	GraphContext_DecreaseRefCount(ctx->gc);
+	for(uint i = 0; i < n; i++) {
+		// decrease graph reference count
+		GraphContext_DecreaseRefCount(tasks[i]->gc);
+		rm_free(tasks[i]);
+	}
 
-	rm_free(ctx);
+	array_free(tasks);
 }
 
 // index drop task handler
@@ -188,6 +202,46 @@ static void _indexer_drop_constraint
 	rm_free(ctx);
 }
 
+// collects queued population tasks which can be served by the same pass
+// over the graph as 'ctx', e.g. indices created back to back on the same label
+// only consecutive tasks are collected, preserving the order of operations
+static IndexPopulateCtx **_indexer_CollectPopulateTasks
+(
+	IndexPopulateCtx *ctx  // population task
+) {
+	IndexPopulateCtx **tasks = array_new(IndexPopulateCtx *, 1);
+	array_append(tasks, ctx);
+
+	// lock queue
+	int res = pthread_mutex_lock(&indexer->m);
+	ASSERT(res == 0);
+
+	IndexerTask *next;
+	while((next = CircularBuffer_Peek(indexer->q)) != NULL) {
+		if(next->op != INDEXER_IDX_POPULATE) break;
+
+		// task must populate a different index on the same schema
+		IndexPopulateCtx *other = (IndexPopulateCtx *)next->pdata;
+		if(other->gc != ctx->gc || other->s != ctx->s) break;
+
+		bool dup = false;
+		uint n = array_len(tasks);
+		for(uint i = 0; i < n && !dup; i++) {
+			dup = (tasks[i]->idx == other->idx);
+		}
+		if(dup) break;
+
+		CircularBuffer_Read(indexer->q, NULL);
+		array_append(tasks, other);
+	}
+
+	// unlock
+	res = pthread_mutex_unlock(&indexer->m);
+	ASSERT(res == 0);
+
+	return tasks;
+}
+
 // populate index
 // this function executes on the indexer's worker thread
 static void *_indexer_run
@@ -204,7 +258,7 @@ static void *_indexer_run
 			case INDEXER_IDX_POPULATE:
 			{
 				IndexPopulateCtx *pdata = (IndexPopulateCtx*)ctx.pdata;
-				_indexer_idx_populate(pdata);
+				_indexer_idx_populate(_indexer_CollectPopulateTasks(pdata));
 				break;
 			}
 			case INDEXER_IDX_DROP:
@@ -0,0 +1,562 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "btree.h"
+#include "../../util/rmalloc.h"
+
+#include <math.h>
+#include <string.h>
+
+// max number of entries in a leaf
+#define BTREE_LEAF_CAP 64
+
+// max number of children of an inner node
+#define BTREE_INNER_CAP 64
+
+typedef struct BTreeNode BTreeNode;
+
+struct BTreeNode {
+	bool leaf;   // leaf or inner node
+	uint32_t n;  // number of entries (leaf) or children (inner)
+};
+
+typedef struct BTreeLeaf {
+	BTreeNode hdr;
+	struct BTreeLeaf *prev;               // left sibling
+	struct BTreeLeaf *next;               // right sibling
+	BTreeEntry entries[BTREE_LEAF_CAP];   // sorted entries
+} BTreeLeaf;
+
+// separator i is a lower bound of the entries under children[i + 1]
+// and a strict upper bound of the entries under children[i]
+typedef struct {
+	BTreeNode hdr;
+	BTreeEntry seps[BTREE_INNER_CAP - 1];  // separators
+	BTreeNode *children[BTREE_INNER_CAP];  // child nodes
+} BTreeInner;
+
+struct BTree {
+	BTreeNode *root;  // root node
+	uint64_t size;    // number of entries
+	uint64_t leafs;   // number of leaf nodes
+	uint64_t inners;  // number of inner nodes
+};
+
+static inline int _cmp
+(
+	const BTreeEntry *a,
+	double key,
+	uint64_t id
+) {
+	if(a->key < key) return -1;
+	if(a->key > key) return 1;
+	if(a->id < id)   return -1;
+	if(a->id > id)   return 1;
+	return 0;
+}
+
+static BTreeLeaf *_NewLeaf
+(
+	BTree *tree
+) {
+	BTreeLeaf *leaf = rm_malloc(sizeof(BTreeLeaf));
+	leaf->hdr.leaf = true;
+	leaf->hdr.n    = 0;
+	leaf->prev     = NULL;
+	leaf->next     = NULL;
+	tree->leafs++;
+	return leaf;
+}
+
+static BTreeInner *_NewInner
+(
+	BTree *tree
+) {
+	BTreeInner *inner = rm_malloc(sizeof(BTreeInner));
+	inner->hdr.leaf = false;
+	inner->hdr.n    = 0;
+	tree->inners++;
+	return inner;
+}
+
+// number of entries in leaf smaller than (key, id)
+static uint32_t _LeafLowerBound
+(
+	const BTreeLeaf *leaf,
+	double key,
+	uint64_t id
+) {
+	uint32_t lo = 0;
+	uint32_t hi = leaf->hdr.n;
+	while(lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		if(_cmp(leaf->entries + mid, key, id) < 0) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// number of entries in leaf smaller or equal to (key, id)
+static uint32_t _LeafUpperBound
+(
+	const BTreeLeaf *leaf,
+	double key,
+	uint64_t id
+) {
+	uint32_t lo = 0;
+	uint32_t hi = leaf->hdr.n;
+	while(lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		if(_cmp(leaf->entries + mid, key, id) <= 0) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// index of the child which should hold (key, id)
+static uint32_t _InnerChild
+(
+	const BTreeInner *inner,
+	double key,
+	uint64_t id
+) {
+	uint32_t lo = 0;
+	uint32_t hi = inner->hdr.n - 1;
+	while(lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		if(_cmp(inner->seps + mid, key, id) <= 0) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// index of the right most child which may hold entries smaller than (key, id)
+static uint32_t _InnerChildBelow
+(
+	const BTreeInner *inner,
+	double key,
+	uint64_t id
+) {
+	uint32_t lo = 0;
+	uint32_t hi = inner->hdr.n - 1;
+	while(lo < hi) {
+		uint32_t mid = (lo + hi) / 2;
+		if(_cmp(inner->seps + mid, key, id) < 0) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+BTree *BTree_New(void) {
+	BTree *tree = rm_calloc(1, sizeof(BTree));
+	tree->root = (BTreeNode *)_NewLeaf(tree);
+	return tree;
+}
+
+//------------------------------------------------------------------------------
+// insertion
+//------------------------------------------------------------------------------
+
+// insert entry into subtree rooted at node
+// in case node splits, sets 'split' to the new right sibling and 'sep' to
+// its smallest entry
+// returns false if entry is already present
+static bool _Insert
+(
+	BTree *tree,
+	BTreeNode *node,
+	double key,
+	uint64_t id,
+	BTreeNode **split,
+	BTreeEntry *sep
+) {
+	*split = NULL;
+
+	if(node->leaf) {
+		BTreeLeaf *leaf = (BTreeLeaf *)node;
+		uint32_t pos = _LeafLowerBound(leaf, key, id);
+		if(pos < leaf->hdr.n && _cmp(leaf->entries + pos, key, id) == 0) {
+			return false;
+		}
+
+		BTreeLeaf *target = leaf;
+		if(leaf->hdr.n == BTREE_LEAF_CAP) {
+			// split leaf in half, link new leaf to the right
+			BTreeLeaf *right = _NewLeaf(tree);
+			uint32_t half = BTREE_LEAF_CAP / 2;
+			right->hdr.n = BTREE_LEAF_CAP - half;
+			memcpy(right->entries, leaf->entries + half,
+					sizeof(BTreeEntry) * right->hdr.n);
+			leaf->hdr.n = half;
+
+			right->next = leaf->next;
+			right->prev = leaf;
+			if(leaf->next != NULL) leaf->next->prev = right;
+			leaf->next = right;
+
+			if(pos > half) {
+				target = right;
+				pos -= half;
+			}
+
+			*split = (BTreeNode *)right;
+		}
+
+		memmove(target->entries + pos + 1, target->entries + pos,
+				sizeof(BTreeEntry) * (target->hdr.n - pos));
+		target->entries[pos].key = key;
+		target->entries[pos].id  = id;
+		target->hdr.n++;
+
+		if(*split != NULL) *sep = ((BTreeLeaf *)*split)->entries[0];
+		return true;
+	}
+
+	BTreeInner *inner = (BTreeInner *)node;
+	uint32_t i = _InnerChild(inner, key, id);
+
+	BTreeNode *child_split;
+	BTreeEntry child_sep;
+	if(!_Insert(tree, inner->children[i], key, id, &child_split, &child_sep)) {
+		return false;
+	}
+	if(child_split == NULL) return true;
+
+	// introduce child's new sibling right after it
+	BTreeInner *target = inner;
+	uint32_t pos = i + 1;  // position of new child
+
+	if(inner->hdr.n == BTREE_INNER_CAP) {
+		// split inner node, children [half..n) move to the right node
+		// the separator between the two halves moves up
+		BTreeInner *right = _NewInner(tree);
+		uint32_t half = BTREE_INNER_CAP / 2;
+		right->hdr.n = BTREE_INNER_CAP - half;
+		memcpy(right->children, inner->children + half,
+				sizeof(BTreeNode *) * right->hdr.n);
+		memcpy(right->seps, inner->seps + half,
+				sizeof(BTreeEntry) * (right->hdr.n - 1));
+		*sep = inner->seps[half - 1];
+		inner->hdr.n = half;
+
+		if(pos > half) {
+			target = right;
+			pos -= half;
+		} else if(pos == half) {
+			// new child becomes the first child of the left half's end
+			// append to left node, its separator is the child's separator
+			inner->children[half] = child_split;
+			inner->seps[half - 1] = child_sep;
+			inner->hdr.n++;
+			*split = (BTreeNode *)right;
+			return true;
+		}
+
+		*split = (BTreeNode *)right;
+	}
+
+	uint32_t n = target->hdr.n;
+	memmove(target->children + pos + 1, target->children + pos,
+			sizeof(BTreeNode *) * (n - pos));
+	memmove(target->seps + pos, target->seps + pos - 1,
+			sizeof(BTreeEntry) * (n - pos));
+	target->children[pos] = child_split;
+	target->seps[pos - 1] = child_sep;
+	target->hdr.n++;
+
+	return true;
+}
+
+bool BTree_Insert
+(
+	BTree *tree,
+	double key,
+	uint64_t id
+) {
+	ASSERT(tree != NULL);
+	ASSERT(!isnan(key));  // NaN can't be ordered
+
+	BTreeNode *split;
+	BTreeEntry sep;
+	if(!_Insert(tree, tree->root, key, id, &split, &sep)) return false;
+
+	if(split != NULL) {
+		// grow tree
+		BTreeInner *root = _NewInner(tree);
+		root->hdr.n       = 2;
+		root->children[0] = tree->root;
+		root->children[1] = split;
+		root->seps[0]     = sep;
+		tree->root = (BTreeNode *)root;
+	}
+
+	tree->size++;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// removal
+//------------------------------------------------------------------------------
+
+// remove entry from subtree rooted at node
+// sets 'empty' if node no longer holds any entry
+// returns false if entry isn't present
+static bool _Remove
+(
+	BTree *tree,
+	BTreeNode *node,
+	double key,
+	uint64_t id,
+	bool *empty
+) {
+	*empty = false;
+
+	if(node->leaf) {
+		BTreeLeaf *leaf = (BTreeLeaf *)node;
+		uint32_t pos = _LeafLowerBound(leaf, key, id);
+		if(pos == leaf->hdr.n || _cmp(leaf->entries + pos, key, id) != 0) {
+			return false;
+		}
+
+		leaf->hdr.n--;
+		memmove(leaf->entries + pos, leaf->entries + pos + 1,
+				sizeof(BTreeEntry) * (leaf->hdr.n - pos));
+
+		*empty = (leaf->hdr.n == 0);
+		return true;
+	}
+
+	BTreeInner *inner = (BTreeInner *)node;
+	uint32_t i = _InnerChild(inner, key, id);
+	BTreeNode *child = inner->children[i];
+
+	bool child_empty;
+	if(!_Remove(tree, child, key, id, &child_empty)) return false;
+	if(!child_empty) return true;
+
+	// drop empty child
+	if(child->leaf) {
+		BTreeLeaf *leaf = (BTreeLeaf *)child;
+		if(leaf->prev != NULL) leaf->prev->next = leaf->next;
+		if(leaf->next != NULL) leaf->next->prev = leaf->prev;
+		tree->leafs--;
+	} else {
+		tree->inners--;
+	}
+	rm_free(child);
+
+	uint32_t n = inner->hdr.n;
+	memmove(inner->children + i, inner->children + i + 1,
+			sizeof(BTreeNode *) * (n - i - 1));
+
+	// removing the first child drops the first separator
+	// otherwise drop the separator to the left of the child
+	uint32_t s = (i == 0) ? 0 : i - 1;
+	if(n > 1) {
+		memmove(inner->seps + s, inner->seps + s + 1,
+				sizeof(BTreeEntry) * (n - 2 - s));
+	}
+
+	inner->hdr.n--;
+	*empty = (inner->hdr.n == 0);
+	return true;
+}
+
+bool BTree_Remove
+(
+	BTree *tree,
+	double key,
+	uint64_t id
+) {
+	ASSERT(tree != NULL);
+
+	bool empty;
+	if(!_Remove(tree, tree->root, key, id, &empty)) return false;
+	tree->size--;
+
+	if(empty && !tree->root->leaf) {
+		// all entries removed, start over with an empty leaf
+		tree->inners--;
+		rm_free(tree->root);
+		tree->root = (BTreeNode *)_NewLeaf(tree);
+		return true;
+	}
+
+	// shrink tree while root has a single child
+	while(!tree->root->leaf && tree->root->n == 1) {
+		BTreeInner *root = (BTreeInner *)tree->root;
+		tree->root = root->children[0];
+		tree->inners--;
+		rm_free(root);
+	}
+
+	return true;
+}
+
+uint64_t BTree_Size
+(
+	const BTree *tree
+) {
+	ASSERT(tree != NULL);
+	return tree->size;
+}
+
+size_t BTree_MemoryUsage
+(
+	const BTree *tree
+) {
+	ASSERT(tree != NULL);
+	return sizeof(BTree) +
+		tree->leafs  * sizeof(BTreeLeaf) +
+		tree->inners * sizeof(BTreeInner);
+}
+
+//------------------------------------------------------------------------------
+// scan
+//------------------------------------------------------------------------------
+
+void BTree_IteratorInit
+(
+	BTreeIterator *it,
+	const BTree *tree,
+	bool reverse
+) {
+	ASSERT(it   != NULL);
+	ASSERT(tree != NULL);
+
+	it->tree    = tree;
+	it->started = false;
+	it->reverse = reverse;
+}
+
+// locate the first entry following the iterator's position
+static const BTreeLeaf *_SeekForward
+(
+	const BTreeIterator *it,
+	uint32_t *pos
+) {
+	const BTreeNode *node = it->tree->root;
+	double key  = it->last.key;
+	uint64_t id = it->last.id;
+
+	while(!node->leaf) {
+		const BTreeInner *inner = (const BTreeInner *)node;
+		uint32_t i = it->started ? _InnerChild(inner, key, id) : 0;
+		node = inner->children[i];
+	}
+
+	const BTreeLeaf *leaf = (const BTreeLeaf *)node;
+	*pos = it->started ? _LeafUpperBound(leaf, key, id) : 0;
+	if(*pos == leaf->hdr.n) {
+		leaf = leaf->next;
+		*pos = 0;
+	}
+
+	return leaf;
+}
+
+// locate the last entry preceding the iterator's position
+static const BTreeLeaf *_SeekBackward
+(
+	const BTreeIterator *it,
+	uint32_t *pos
+) {
+	const BTreeNode *node = it->tree->root;
+	double key  = it->last.key;
+	uint64_t id = it->last.id;
+
+	while(!node->leaf) {
+		const BTreeInner *inner = (const BTreeInner *)node;
+		uint32_t i = it->started ? _InnerChildBelow(inner, key, id) :
+			inner->hdr.n - 1;
+		node = inner->children[i];
+	}
+
+	const BTreeLeaf *leaf = (const BTreeLeaf *)node;
+	uint32_t n = it->started ? _LeafLowerBound(leaf, key, id) : leaf->hdr.n;
+	if(n == 0) {
+		leaf = leaf->prev;
+		if(leaf == NULL) return NULL;
+		n = leaf->hdr.n;
+	}
+
+	*pos = n - 1;
+	return leaf;
+}
+
+uint32_t BTree_IteratorNext
+(
+	BTreeIterator *it,
+	BTreeEntry *entries,
+	uint32_t n
+) {
+	ASSERT(it      != NULL);
+	ASSERT(entries != NULL);
+
+	if(n == 0 || it->tree->size == 0) return 0;
+
+	uint32_t count = 0;
+	uint32_t pos;
+
+	if(!it->reverse) {
+		const BTreeLeaf *leaf = _SeekForward(it, &pos);
+		while(leaf != NULL && count < n) {
+			uint32_t m = leaf->hdr.n - pos;
+			if(m > n - count) m = n - count;
+			memcpy(entries + count, leaf->entries + pos,
+					sizeof(BTreeEntry) * m);
+			count += m;
+			leaf = leaf->next;
+			pos = 0;
+		}
+	} else {
+		const BTreeLeaf *leaf = _SeekBackward(it, &pos);
+		while(leaf != NULL && count < n) {
+			entries[count++] = leaf->entries[pos];
+			if(pos == 0) {
+				leaf = leaf->prev;
+				if(leaf != NULL) pos = leaf->hdr.n - 1;
+			} else {
+				pos--;
+			}
+		}
+	}
+
+	if(count > 0) {
+		it->last    = entries[count - 1];
+		it->started = true;
+	}
+
+	return count;
+}
+
+//------------------------------------------------------------------------------
+// free
+//------------------------------------------------------------------------------
+
+static void _FreeNode
+(
+	BTreeNode *node
+) {
+	if(!node->leaf) {
+		BTreeInner *inner = (BTreeInner *)node;
+		for(uint32_t i = 0; i < inner->hdr.n; i++) {
+			_FreeNode(inner->children[i]);
+		}
+	}
+	rm_free(node);
+}
+
+void BTree_Free
+(
+	BTree *tree
+) {
+	ASSERT(tree != NULL);
+
+	_FreeNode(tree->root);
+	rm_free(tree);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// B+tree over (key, id) pairs
+// entries are ordered by key and then by id, leaves are linked in both
+// directions to support forward and reverse ordered scans
+//
+// leaves are only reclaimed once they become empty, the tree doesn't merge
+// partially filled nodes
+//
+// the structure isn't synchronized, insertions and removals require exclusive
+// access while any number of scans may run concurrently
+typedef struct BTree BTree;
+
+typedef struct {
+	double key;   // ordering key
+	uint64_t id;  // entity id, breaks ties between equal keys
+} BTreeEntry;
+
+// ordered scan over a tree
+// the iterator only records the last entry it produced, each batch
+// seeks back into the tree, as such the tree may be modified between batches
+typedef struct {
+	const BTree *tree;  // scanned tree
+	BTreeEntry last;    // last entry produced
+	bool started;       // whether any entry was produced
+	bool reverse;       // scan in descending order
+} BTreeIterator;
+
+// create a new empty tree
+BTree *BTree_New(void);
+
+// add entry to tree
+// returns false if entry is already present
+bool BTree_Insert
+(
+	BTree *tree,  // tree to update
+	double key,   // entry key
+	uint64_t id   // entry id
+);
+
+// remove entry from tree
+// returns false if entry isn't present
+bool BTree_Remove
+(
+	BTree *tree,  // tree to update
+	double key,   // entry key
+	uint64_t id   // entry id
+);
+
+// number of entries in tree
+uint64_t BTree_Size
+(
+	const BTree *tree
+);
+
+// number of bytes used by tree
+size_t BTree_MemoryUsage
+(
+	const BTree *tree
+);
+
+// initialize an iterator positioned before the first entry
+// (after the last entry if reverse is set)
+void BTree_IteratorInit
+(
+	BTreeIterator *it,  // iterator to initialize
+	const BTree *tree,  // tree to scan
+	bool reverse        // scan in descending order
+);
+
+// fill 'entries' with up to 'n' entries following the iterator position
+// returns number of entries produced, 0 once the scan is depleted
+uint32_t BTree_IteratorNext
+(
+	BTreeIterator *it,    // iterator
+	BTreeEntry *entries,  // [output] entries
+	uint32_t n            // max number of entries to produce
+);
+
+// free tree
+void BTree_Free
+(
+	BTree *tree
+);
@@ -0,0 +1,368 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "ordered_index.h"
+#include "../../util/dict.h"
+#include "../../util/rmalloc.h"
+#include "xxhash.h"
+
+#include <math.h>
+#include <string.h>
+
+// integers beyond this magnitude lose precision as doubles
+#define ORDERED_INDEX_MAX_EXACT_INT (1LL << 53)
+#define ORDERED_INDEX_MAGIC         0x5844524F  // "ORDX"
+
+// number of entries fetched from the tree per serialization batch
+#define ORDERED_INDEX_BATCH 256
+
+struct OrderedIndex {
+	Attribute_ID attr_id;  // indexed attribute
+	BTree *tree;           // ordered numeric values
+	dict *keys;            // entity ID -> tree key
+	dict *unordered;       // entities holding values the tree can't order
+};
+
+// convert value to a tree key
+// returns false if value can't be ordered numerically
+static bool _OrderedIndex_Key
+(
+	SIValue v,
+	double *key
+) {
+	switch(SI_TYPE(v)) {
+		case T_INT64:
+			if(v.longval >  ORDERED_INDEX_MAX_EXACT_INT ||
+			   v.longval < -ORDERED_INDEX_MAX_EXACT_INT) {
+				return false;
+			}
+			*key = (double)v.longval;
+			return true;
+		case T_DOUBLE:
+			if(isnan(v.doubleval)) return false;
+			*key = v.doubleval;
+			return true;
+		default:
+			return false;
+	}
+}
+
+// tree keys are stored as the dict entry's value
+static inline void *_KeyToVal
+(
+	double key
+) {
+	uint64_t bits;
+	memcpy(&bits, &key, sizeof(bits));
+	return (void *)bits;
+}
+
+static inline double _ValToKey
+(
+	void *val
+) {
+	double key;
+	uint64_t bits = (uint64_t)val;
+	memcpy(&key, &bits, sizeof(key));
+	return key;
+}
+
+OrderedIndex *OrderedIndex_New
+(
+	Attribute_ID attr_id
+) {
+	OrderedIndex *oi = rm_malloc(sizeof(OrderedIndex));
+
+	oi->tree      = BTree_New();
+	oi->keys      = HashTableCreate(&def_dt);
+	oi->attr_id   = attr_id;
+	oi->unordered = HashTableCreate(&def_dt);
+
+	return oi;
+}
+
+Attribute_ID OrderedIndex_Attribute
+(
+	const OrderedIndex *oi
+) {
+	ASSERT(oi != NULL);
+	return oi->attr_id;
+}
+
+void OrderedIndex_Remove
+(
+	OrderedIndex *oi,
+	EntityID id
+) {
+	ASSERT(oi != NULL);
+
+	void *k = (void *)id;
+	dictEntry *de = HashTableFind(oi->keys, k);
+	if(de != NULL) {
+		bool removed = BTree_Remove(oi->tree, _ValToKey(HashTableGetVal(de)),
+				id);
+		ASSERT(removed);
+		UNUSED(removed);
+		HashTableDelete(oi->keys, k);
+		return;
+	}
+
+	HashTableDelete(oi->unordered, k);
+}
+
+void OrderedIndex_Set
+(
+	OrderedIndex *oi,
+	EntityID id,
+	SIValue v
+) {
+	ASSERT(oi != NULL);
+
+	double key;
+	void *k = (void *)id;
+
+	if(!_OrderedIndex_Key(v, &key)) {
+		OrderedIndex_Remove(oi, id);
+		if(SI_TYPE(v) != T_NULL) HashTableAdd(oi->unordered, k, NULL);
+		return;
+	}
+
+	dictEntry *de = HashTableFind(oi->keys, k);
+	if(de != NULL) {
+		// value didn't change
+		double prev = _ValToKey(HashTableGetVal(de));
+		if(prev == key) return;
+
+		BTree_Remove(oi->tree, prev, id);
+		HashTableSetVal(oi->keys, de, _KeyToVal(key));
+	} else {
+		HashTableDelete(oi->unordered, k);
+		HashTableAdd(oi->keys, k, _KeyToVal(key));
+	}
+
+	BTree_Insert(oi->tree, key, id);
+}
+
+uint64_t OrderedIndex_OrderedCount
+(
+	const OrderedIndex *oi
+) {
+	ASSERT(oi != NULL);
+	return BTree_Size(oi->tree);
+}
+
+uint64_t OrderedIndex_UnorderedCount
+(
+	const OrderedIndex *oi
+) {
+	ASSERT(oi != NULL);
+	return HashTableElemCount(oi->unordered);
+}
+
+const BTree *OrderedIndex_Tree
+(
+	const OrderedIndex *oi
+) {
+	ASSERT(oi != NULL);
+	return oi->tree;
+}
+
+size_t OrderedIndex_MemoryUsage
+(
+	const OrderedIndex *oi
+) {
+	ASSERT(oi != NULL);
+	return sizeof(OrderedIndex)           +
+		BTree_MemoryUsage(oi->tree)       +
+		HashTableMemUsage(oi->keys)       +
+		HashTableMemUsage(oi->unordered);
+}
+
+//------------------------------------------------------------------------------
+// serialization
+//------------------------------------------------------------------------------
+
+// buffer cursor
+typedef struct {
+	unsigned char *p;    // current position
+	unsigned char *end;  // end of buffer
+} OrderedIndexCursor;
+
+static inline void _write
+(
+	OrderedIndexCursor *c,
+	const void *v,
+	size_t n
+) {
+	ASSERT(c->p + n <= c->end);
+	memcpy(c->p, v, n);
+	c->p += n;
+}
+
+// returns false if buffer is exhausted
+static inline bool _read
+(
+	OrderedIndexCursor *c,
+	void *v,
+	size_t n
+) {
+	if((size_t)(c->end - c->p) < n) return false;
+	memcpy(v, c->p, n);
+	c->p += n;
+	return true;
+}
+
+#define WRITE(c, v) _write((c), &(v), sizeof(v))
+#define READ(c, v) if(!_read((c), &(v), sizeof(v))) goto error
+
+void *OrderedIndex_Serialize
+(
+	const OrderedIndex *oi,
+	size_t *size
+) {
+	// Format:
+	//  magic, attribute ID
+	//  #ordered entries
+	//  {key, entity ID} X #ordered entries, in tree order
+	//  #unordered entities
+	//  entity ID X #unordered entities
+	//  checksum             XXH64 of all of the above
+
+	ASSERT(oi   != NULL);
+	ASSERT(size != NULL);
+
+	uint32_t magic     = ORDERED_INDEX_MAGIC;
+	uint16_t attr_id   = oi->attr_id;
+	uint64_t ordered   = BTree_Size(oi->tree);
+	uint64_t unordered = HashTableElemCount(oi->unordered);
+
+	size_t n = sizeof(magic) + sizeof(attr_id) + sizeof(ordered) +
+		sizeof(unordered) + sizeof(XXH64_hash_t);
+	n += (sizeof(double) + sizeof(uint64_t)) * ordered;
+	n += sizeof(uint64_t) * unordered;
+
+	unsigned char *buffer = rm_malloc(n);
+	OrderedIndexCursor c = {buffer, buffer + n};
+
+	WRITE(&c, magic);
+	WRITE(&c, attr_id);
+	WRITE(&c, ordered);
+
+	uint32_t nentries;
+	BTreeIterator it;
+	BTreeEntry entries[ORDERED_INDEX_BATCH];
+
+	BTree_IteratorInit(&it, oi->tree, false);
+	while((nentries = BTree_IteratorNext(&it, entries, ORDERED_INDEX_BATCH))) {
+		for(uint32_t i = 0; i < nentries; i++) {
+			WRITE(&c, entries[i].key);
+			WRITE(&c, entries[i].id);
+		}
+	}
+
+	WRITE(&c, unordered);
+
+	dictEntry *de;
+	dictIterator *iter = HashTableGetIterator(oi->unordered);
+	while((de = HashTableNext(iter)) != NULL) {
+		uint64_t id = (uint64_t)HashTableGetKey(de);
+		WRITE(&c, id);
+	}
+	HashTableReleaseIterator(iter);
+
+	XXH64_hash_t checksum = XXH64(buffer, c.p - buffer, 0);
+	WRITE(&c, checksum);
+	ASSERT(c.p == c.end);
+
+	*size = n;
+	return buffer;
+}
+
+OrderedIndex *OrderedIndex_Deserialize
+(
+	const void *buffer,
+	size_t size
+) {
+	ASSERT(buffer != NULL);
+
+	OrderedIndex *oi = NULL;
+	OrderedIndexCursor c = {(unsigned char *)buffer,
+		(unsigned char *)buffer + size};
+
+	//--------------------------------------------------------------------------
+	// validate checksum
+	//--------------------------------------------------------------------------
+
+	XXH64_hash_t checksum;
+	if(size < sizeof(checksum)) return NULL;
+
+	c.end -= sizeof(checksum);
+	memcpy(&checksum, c.end, sizeof(checksum));
+	if(XXH64(buffer, size - sizeof(checksum), 0) != checksum) return NULL;
+
+	//--------------------------------------------------------------------------
+	// restore index
+	//--------------------------------------------------------------------------
+
+	uint32_t magic;
+	uint16_t attr_id;
+	uint64_t ordered;
+	uint64_t unordered;
+
+	READ(&c, magic);
+	READ(&c, attr_id);
+	READ(&c, ordered);
+
+	if(magic != ORDERED_INDEX_MAGIC) return NULL;
+
+	oi = OrderedIndex_New(attr_id);
+
+	for(uint64_t i = 0; i < ordered; i++) {
+		double key;
+		uint64_t id;
+		READ(&c, key);
+		READ(&c, id);
+
+		// keys are never NaN, each entity is indexed once
+		if(isnan(key) || !BTree_Insert(oi->tree, key, id)) goto error;
+		if(HashTableAdd(oi->keys, (void *)id, _KeyToVal(key)) != DICT_OK) {
+			goto error;
+		}
+	}
+
+	READ(&c, unordered);
+
+	for(uint64_t i = 0; i < unordered; i++) {
+		uint64_t id;
+		READ(&c, id);
+
+		void *k = (void *)id;
+		if(HashTableFind(oi->keys, k) != NULL) goto error;
+		if(HashTableAdd(oi->unordered, k, NULL) != DICT_OK) goto error;
+	}
+
+	// trailing bytes
+	if(c.p != c.end) goto error;
+
+	return oi;
+
+error:
+	if(oi != NULL) OrderedIndex_Free(oi);
+	return NULL;
+}
+
+void OrderedIndex_Free
+(
+	OrderedIndex *oi
+) {
+	ASSERT(oi != NULL);
+
+	BTree_Free(oi->tree);
+	HashTableRelease(oi->keys);
+	HashTableRelease(oi->unordered);
+	rm_free(oi);
+}
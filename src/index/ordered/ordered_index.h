@@ -0,0 +1,94 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "btree.h"
+#include "../../value.h"
+#include "../../graph/entities/graph_entity.h"
+
+// ordered index over a single attribute
+//
+// numeric values are kept sorted in a B+tree, entities holding a value which
+// can't be ordered numerically (strings, booleans, NaN, etc.) are only counted
+// such that callers can tell whether the tree covers every indexed entity
+typedef struct OrderedIndex OrderedIndex;
+
+// create a new ordered index
+OrderedIndex *OrderedIndex_New
+(
+	Attribute_ID attr_id  // indexed attribute
+);
+
+// returns indexed attribute
+Attribute_ID OrderedIndex_Attribute
+(
+	const OrderedIndex *oi
+);
+
+// set entity's indexed value
+// replaces entity's previous value, if any
+void OrderedIndex_Set
+(
+	OrderedIndex *oi,  // index to update
+	EntityID id,       // entity ID
+	SIValue v          // entity's value, null removes entity
+);
+
+// remove entity from index
+void OrderedIndex_Remove
+(
+	OrderedIndex *oi,  // index to update
+	EntityID id        // entity to remove
+);
+
+// number of entities held by the ordered tree
+uint64_t OrderedIndex_OrderedCount
+(
+	const OrderedIndex *oi
+);
+
+// number of entities holding a value which can't be ordered by the tree
+uint64_t OrderedIndex_UnorderedCount
+(
+	const OrderedIndex *oi
+);
+
+// returns index tree
+const BTree *OrderedIndex_Tree
+(
+	const OrderedIndex *oi
+);
+
+// number of bytes used by index
+size_t OrderedIndex_MemoryUsage
+(
+	const OrderedIndex *oi
+);
+
+// serialize index into a single buffer
+// such that the index can be restored without being repopulated
+// the buffer ends with a checksum of its content
+// caller is responsible for freeing the returned buffer using rm_free
+void *OrderedIndex_Serialize
+(
+	const OrderedIndex *oi,  // index to serialize
+	size_t *size             // [output] buffer size
+);
+
+// restore an index from a buffer produced by OrderedIndex_Serialize
+// returns NULL if the buffer is malformed or fails its checksum
+OrderedIndex *OrderedIndex_Deserialize
+(
+	const void *buffer,  // serialized index
+	size_t size          // buffer size
+);
+
+// free index
+void OrderedIndex_Free
+(
+	OrderedIndex *oi
+);
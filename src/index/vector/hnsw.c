@@ -0,0 +1,942 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "hnsw.h"
+#include "vector_distance.h"
+#include "../../util/arr.h"
+#include "../../util/dict.h"
+#include "../../util/rmalloc.h"
+#include "xxhash.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HNSW_MAX_LEVEL 16
+#define HNSW_NO_SLOT   UINT32_MAX
+#define HNSW_MAGIC     0x57534E48  // "HNSW"
+
+// access slot's vector
+#define VEC(h, slot) ((h)->vectors + (size_t)(slot) * (h)->dim)
+
+typedef struct {
+	uint64_t id;       // element id
+	int level;         // element's top level
+	bool deleted;      // element was removed
+	uint32_t **links;  // per level neighbors list: [count, n0, n1, ...]
+} HNSWElement;
+
+struct HNSW {
+	uint32_t dim;              // vectors dimension
+	VectorSimilarity sim;      // distance function
+	uint16_t M;                // max links per element on levels > 0
+	uint16_t M0;               // max links per element on level 0
+	uint16_t ef_construction;  // candidate list size during insertion
+	double level_mult;         // level generation factor, 1/ln(M)
+	uint64_t rng;              // level generator state
+	uint32_t count;            // number of used slots
+	uint32_t cap;              // number of allocated slots
+	uint64_t size;             // number of live elements
+	int64_t entry;             // entry point slot, -1 if graph is empty
+	int max_level;             // entry point level
+	float *vectors;            // elements vectors, cap * dim floats
+	HNSWElement *elements;     // elements
+	uint32_t *free_slots;      // slots of removed elements available for reuse
+	dict *ids;                 // element id to slot mapping
+};
+
+//------------------------------------------------------------------------------
+// candidates heap
+//------------------------------------------------------------------------------
+
+typedef struct {
+	float dist;     // distance to query
+	uint32_t slot;  // element slot
+} HNSWCandidate;
+
+typedef struct {
+	HNSWCandidate *items;  // heap items
+	uint32_t n;            // number of items
+	uint32_t cap;          // heap capacity
+	bool max;              // max-heap if true, min-heap otherwise
+} CandidateHeap;
+
+static void _heap_init
+(
+	CandidateHeap *hp,
+	uint32_t cap,
+	bool max
+) {
+	hp->n     = 0;
+	hp->cap   = cap;
+	hp->max   = max;
+	hp->items = rm_malloc(sizeof(HNSWCandidate) * cap);
+}
+
+static inline bool _heap_before
+(
+	const CandidateHeap *hp,
+	HNSWCandidate a,
+	HNSWCandidate b
+) {
+	return hp->max ? a.dist > b.dist : a.dist < b.dist;
+}
+
+static void _heap_push
+(
+	CandidateHeap *hp,
+	HNSWCandidate c
+) {
+	if(hp->n == hp->cap) {
+		hp->cap *= 2;
+		hp->items = rm_realloc(hp->items, sizeof(HNSWCandidate) * hp->cap);
+	}
+
+	uint32_t i = hp->n++;
+	while(i > 0) {
+		uint32_t parent = (i - 1) / 2;
+		if(!_heap_before(hp, c, hp->items[parent])) break;
+		hp->items[i] = hp->items[parent];
+		i = parent;
+	}
+	hp->items[i] = c;
+}
+
+static HNSWCandidate _heap_pop
+(
+	CandidateHeap *hp
+) {
+	ASSERT(hp->n > 0);
+
+	HNSWCandidate top  = hp->items[0];
+	HNSWCandidate last = hp->items[--hp->n];
+
+	uint32_t i = 0;
+	while(true) {
+		uint32_t child = 2 * i + 1;
+		if(child >= hp->n) break;
+		if(child + 1 < hp->n &&
+		   _heap_before(hp, hp->items[child + 1], hp->items[child])) {
+			child++;
+		}
+		if(!_heap_before(hp, hp->items[child], last)) break;
+		hp->items[i] = hp->items[child];
+		i = child;
+	}
+	if(hp->n > 0) hp->items[i] = last;
+
+	return top;
+}
+
+static inline HNSWCandidate _heap_top
+(
+	const CandidateHeap *hp
+) {
+	ASSERT(hp->n > 0);
+	return hp->items[0];
+}
+
+static void _heap_free
+(
+	CandidateHeap *hp
+) {
+	rm_free(hp->items);
+}
+
+//------------------------------------------------------------------------------
+// utilities
+//------------------------------------------------------------------------------
+
+static inline float _distance
+(
+	const HNSW *h,
+	const float *a,
+	const float *b
+) {
+	if(h->sim == VEC_SIM_EUCLIDEAN) return vec_l2sq(a, b, h->dim);
+	// cosine vectors are normalized on insertion
+	return 1.0f - vec_dot(a, b, h->dim);
+}
+
+// marks slot as visited, returns false if slot was already visited
+static inline bool _visit
+(
+	uint64_t *visited,
+	uint32_t slot
+) {
+	uint64_t bit = 1ULL << (slot & 63);
+	uint64_t *w  = visited + (slot >> 6);
+	if(*w & bit) return false;
+	*w |= bit;
+	return true;
+}
+
+static inline size_t _visited_words
+(
+	const HNSW *h
+) {
+	return (h->count + 63) / 64;
+}
+
+// draw an element level from an exponentially decaying distribution
+static int _random_level
+(
+	HNSW *h
+) {
+	// xorshift64*
+	h->rng ^= h->rng >> 12;
+	h->rng ^= h->rng << 25;
+	h->rng ^= h->rng >> 27;
+	uint64_t r = h->rng * 0x2545F4914F6CDD1DULL;
+
+	// uniform in (0, 1]
+	double u = ((r >> 11) + 1) * (1.0 / 9007199254740992.0);
+	int level = (int)(-log(u) * h->level_mult);
+
+	return (level > HNSW_MAX_LEVEL) ? HNSW_MAX_LEVEL : level;
+}
+
+static int _cmp_candidates
+(
+	const void *a,
+	const void *b
+) {
+	float da = ((const HNSWCandidate *)a)->dist;
+	float db = ((const HNSWCandidate *)b)->dist;
+	return (da > db) - (da < db);
+}
+
+static void _alloc_links
+(
+	HNSW *h,
+	HNSWElement *e,
+	int from,
+	int to
+) {
+	for(int l = from; l <= to; l++) {
+		uint32_t max = (l == 0) ? h->M0 : h->M;
+		e->links[l] = rm_malloc(sizeof(uint32_t) * (max + 1));
+		e->links[l][0] = 0;
+	}
+}
+
+static void _free_links
+(
+	HNSWElement *e
+) {
+	for(int l = 0; l <= e->level; l++) rm_free(e->links[l]);
+	rm_free(e->links);
+}
+
+// drop all elements
+static void _reset
+(
+	HNSW *h
+) {
+	for(uint32_t i = 0; i < h->count; i++) _free_links(h->elements + i);
+
+	h->count     = 0;
+	h->entry     = -1;
+	h->max_level = 0;
+	array_clear(h->free_slots);
+}
+
+//------------------------------------------------------------------------------
+// graph traversal
+//------------------------------------------------------------------------------
+
+// greedy walk towards q on a single level
+static uint32_t _greedy_closest
+(
+	const HNSW *h,
+	const float *q,
+	uint32_t ep,
+	float *ep_dist,
+	int level,
+	uint32_t exclude
+) {
+	bool changed = true;
+	while(changed) {
+		changed = false;
+		const uint32_t *links = h->elements[ep].links[level];
+		for(uint32_t i = 1; i <= links[0]; i++) {
+			uint32_t nb = links[i];
+			if(nb == exclude) continue;
+
+			float d = _distance(h, q, VEC(h, nb));
+			if(d < *ep_dist) {
+				*ep_dist = d;
+				ep       = nb;
+				changed  = true;
+			}
+		}
+	}
+
+	return ep;
+}
+
+// best-first search on a single level
+// W is a max-heap collecting the ef closest elements
+// removed elements are traversed but only reported if include_deleted is set
+static void _search_layer
+(
+	const HNSW *h,
+	const float *q,
+	uint32_t ep,
+	int level,
+	uint32_t ef,
+	uint64_t *visited,
+	CandidateHeap *W,
+	bool include_deleted
+) {
+	CandidateHeap C;
+	_heap_init(&C, ef + 1, false);
+
+	HNSWCandidate c = {_distance(h, q, VEC(h, ep)), ep};
+	_visit(visited, ep);
+	_heap_push(&C, c);
+	if(include_deleted || !h->elements[ep].deleted) _heap_push(W, c);
+
+	while(C.n > 0) {
+		c = _heap_pop(&C);
+		if(W->n >= ef && c.dist > _heap_top(W).dist) break;
+
+		const uint32_t *links = h->elements[c.slot].links[level];
+		for(uint32_t i = 1; i <= links[0]; i++) {
+			uint32_t nb = links[i];
+			if(!_visit(visited, nb)) continue;
+
+			float d = _distance(h, q, VEC(h, nb));
+			if(W->n < ef || d < _heap_top(W).dist) {
+				HNSWCandidate n = {d, nb};
+				_heap_push(&C, n);
+				if(include_deleted || !h->elements[nb].deleted) {
+					_heap_push(W, n);
+					if(W->n > ef) _heap_pop(W);
+				}
+			}
+		}
+	}
+
+	_heap_free(&C);
+}
+
+// neighbors selection heuristic
+// candidates must be sorted by ascending distance to the base element
+// a candidate is selected only if it is closer to the base element than
+// to any previously selected neighbor, keeping links spread out
+static uint32_t _select_neighbors
+(
+	const HNSW *h,
+	const HNSWCandidate *cands,
+	uint32_t n,
+	uint32_t M,
+	uint32_t *out
+) {
+	uint32_t selected = 0;
+
+	for(uint32_t i = 0; i < n && selected < M; i++) {
+		HNSWCandidate c = cands[i];
+		bool keep = true;
+		for(uint32_t j = 0; j < selected; j++) {
+			if(_distance(h, VEC(h, c.slot), VEC(h, out[j])) < c.dist) {
+				keep = false;
+				break;
+			}
+		}
+		if(keep) out[selected++] = c.slot;
+	}
+
+	return selected;
+}
+
+// add a link src -> dst on level, shrinking src's links if full
+static void _connect
+(
+	HNSW *h,
+	uint32_t src,
+	uint32_t dst,
+	int level
+) {
+	uint32_t *links = h->elements[src].links[level];
+	uint32_t max    = (level == 0) ? h->M0 : h->M;
+	uint32_t n      = links[0];
+
+	for(uint32_t i = 1; i <= n; i++) {
+		if(links[i] == dst) return;
+	}
+
+	if(n < max) {
+		links[n + 1] = dst;
+		links[0]++;
+		return;
+	}
+
+	// links are full, reselect among existing neighbors and dst
+	HNSWCandidate cands[max + 1];
+	const float *base = VEC(h, src);
+	for(uint32_t i = 0; i < n; i++) {
+		cands[i].slot = links[i + 1];
+		cands[i].dist = _distance(h, base, VEC(h, links[i + 1]));
+	}
+	cands[n].slot = dst;
+	cands[n].dist = _distance(h, base, VEC(h, dst));
+
+	qsort(cands, n + 1, sizeof(HNSWCandidate), _cmp_candidates);
+	links[0] = _select_neighbors(h, cands, n + 1, max, links + 1);
+}
+
+// acquire a slot for a new element of the given level
+// returns the slot, level is raised when reusing a higher slot
+static uint32_t _acquire_slot
+(
+	HNSW *h,
+	int *level
+) {
+	uint32_t slot;
+	HNSWElement *e;
+
+	if(array_len(h->free_slots) > 0) {
+		// reuse a removed element's slot
+		// elements linking to the slot expect it to be present on all of its
+		// levels, as such the slot level never decreases
+		slot = array_pop(h->free_slots);
+		e    = h->elements + slot;
+
+		if(*level < e->level) {
+			*level = e->level;
+		} else if(*level > e->level) {
+			e->links = rm_realloc(e->links, sizeof(uint32_t *) * (*level + 1));
+			_alloc_links(h, e, e->level + 1, *level);
+		}
+
+		for(int l = 0; l <= *level; l++) e->links[l][0] = 0;
+	} else {
+		if(h->count == h->cap) {
+			h->cap      = (h->cap == 0) ? 1024 : h->cap * 2;
+			h->vectors  = rm_realloc(h->vectors,
+					sizeof(float) * (size_t)h->cap * h->dim);
+			h->elements = rm_realloc(h->elements,
+					sizeof(HNSWElement) * h->cap);
+		}
+
+		slot     = h->count++;
+		e        = h->elements + slot;
+		e->links = rm_malloc(sizeof(uint32_t *) * (*level + 1));
+		_alloc_links(h, e, 0, *level);
+	}
+
+	e->level = *level;
+	return slot;
+}
+
+//------------------------------------------------------------------------------
+// API
+//------------------------------------------------------------------------------
+
+HNSW *HNSW_New
+(
+	uint32_t dim,
+	VectorSimilarity sim,
+	uint16_t M,
+	uint16_t ef_construction
+) {
+	ASSERT(dim > 0);
+	ASSERT(M > 1);
+	ASSERT(ef_construction > 0);
+
+	HNSW *h = rm_calloc(1, sizeof(HNSW));
+
+	h->M               = M;
+	h->M0              = 2 * M;
+	h->dim             = dim;
+	h->sim             = sim;
+	h->rng             = 0x9E3779B97F4A7C15ULL;
+	h->entry           = -1;
+	h->ids             = HashTableCreate(&def_dt);
+	h->level_mult      = 1.0 / log((double)M);
+	h->free_slots      = array_new(uint32_t, 0);
+	h->ef_construction = ef_construction;
+
+	return h;
+}
+
+void HNSW_Insert
+(
+	HNSW *h,
+	uint64_t id,
+	const float *v
+) {
+	ASSERT(h != NULL);
+	ASSERT(v != NULL);
+
+	// replace existing element
+	HNSW_Remove(h, id);
+
+	int level     = _random_level(h);
+	uint32_t slot = _acquire_slot(h, &level);
+
+	HNSWElement *e = h->elements + slot;
+	e->id      = id;
+	e->deleted = false;
+
+	float *q = VEC(h, slot);
+	memcpy(q, v, sizeof(float) * h->dim);
+	if(h->sim == VEC_SIM_COSINE) vec_normalize(q, h->dim);
+
+	HashTableAdd(h->ids, (void *)id, (void *)(uintptr_t)slot);
+	h->size++;
+
+	// first element
+	if(h->entry == -1) {
+		h->entry     = slot;
+		h->max_level = level;
+		return;
+	}
+
+	//--------------------------------------------------------------------------
+	// descend to element's top level
+	//--------------------------------------------------------------------------
+
+	uint32_t ep   = h->entry;
+	float ep_dist = _distance(h, q, VEC(h, ep));
+	for(int l = h->max_level; l > level; l--) {
+		ep = _greedy_closest(h, q, ep, &ep_dist, l, slot);
+	}
+
+	//--------------------------------------------------------------------------
+	// connect element on each of its levels
+	//--------------------------------------------------------------------------
+
+	size_t words       = _visited_words(h);
+	uint64_t *visited  = rm_malloc(sizeof(uint64_t) * words);
+	uint32_t *selected = rm_malloc(sizeof(uint32_t) * h->M0);
+	HNSWCandidate *cands =
+		rm_malloc(sizeof(HNSWCandidate) * (h->ef_construction + 1));
+
+	CandidateHeap W;
+	_heap_init(&W, h->ef_construction + 1, true);
+
+	int top = (level < h->max_level) ? level : h->max_level;
+	for(int l = top; l >= 0; l--) {
+		memset(visited, 0, sizeof(uint64_t) * words);
+		_visit(visited, slot);  // never link element to itself
+
+		_search_layer(h, q, ep, l, h->ef_construction, visited, &W, true);
+
+		// sort candidates by ascending distance
+		uint32_t n = W.n;
+		for(int i = n - 1; i >= 0; i--) cands[i] = _heap_pop(&W);
+		if(n == 0) continue;
+
+		uint32_t m = _select_neighbors(h, cands, n, h->M, selected);
+
+		uint32_t *links = e->links[l];
+		memcpy(links + 1, selected, sizeof(uint32_t) * m);
+		links[0] = m;
+
+		for(uint32_t i = 0; i < m; i++) _connect(h, selected[i], slot, l);
+
+		ep = cands[0].slot;
+	}
+
+	if(level > h->max_level) {
+		h->entry     = slot;
+		h->max_level = level;
+	}
+
+	_heap_free(&W);
+	rm_free(cands);
+	rm_free(visited);
+	rm_free(selected);
+}
+
+bool HNSW_Remove
+(
+	HNSW *h,
+	uint64_t id
+) {
+	ASSERT(h != NULL);
+
+	dictEntry *de = HashTableFind(h->ids, (void *)id);
+	if(de == NULL) return false;
+
+	uint32_t slot = (uintptr_t)HashTableGetVal(de);
+	HashTableDelete(h->ids, (void *)id);
+
+	h->elements[slot].deleted = true;
+	h->size--;
+
+	if(h->size == 0) {
+		_reset(h);
+	} else if(slot != h->entry) {
+		// the entry point is never reused as its links are required
+		// to reach the rest of the graph
+		array_append(h->free_slots, slot);
+	}
+
+	return true;
+}
+
+uint32_t HNSW_Search
+(
+	const HNSW *h,
+	const float *q,
+	uint32_t k,
+	uint32_t ef,
+	uint64_t *ids,
+	float *dists
+) {
+	ASSERT(h     != NULL);
+	ASSERT(q     != NULL);
+	ASSERT(ids   != NULL);
+	ASSERT(dists != NULL);
+
+	if(h->size == 0 || k == 0) return 0;
+	if(ef < k) ef = k;
+
+	float *normalized = NULL;
+	if(h->sim == VEC_SIM_COSINE) {
+		normalized = rm_malloc(sizeof(float) * h->dim);
+		memcpy(normalized, q, sizeof(float) * h->dim);
+		vec_normalize(normalized, h->dim);
+		q = normalized;
+	}
+
+	uint32_t ep   = h->entry;
+	float ep_dist = _distance(h, q, VEC(h, ep));
+	for(int l = h->max_level; l > 0; l--) {
+		ep = _greedy_closest(h, q, ep, &ep_dist, l, HNSW_NO_SLOT);
+	}
+
+	uint64_t *visited = rm_calloc(_visited_words(h), sizeof(uint64_t));
+
+	CandidateHeap W;
+	_heap_init(&W, ef + 1, true);
+	_search_layer(h, q, ep, 0, ef, visited, &W, false);
+
+	while(W.n > k) _heap_pop(&W);
+
+	uint32_t n = W.n;
+	for(int i = n - 1; i >= 0; i--) {
+		HNSWCandidate c = _heap_pop(&W);
+		ids[i]   = h->elements[c.slot].id;
+		dists[i] = c.dist;
+	}
+
+	_heap_free(&W);
+	rm_free(visited);
+	if(normalized != NULL) rm_free(normalized);
+
+	return n;
+}
+
+uint32_t HNSW_Dimension
+(
+	const HNSW *h
+) {
+	ASSERT(h != NULL);
+	return h->dim;
+}
+
+VectorSimilarity HNSW_Similarity
+(
+	const HNSW *h
+) {
+	ASSERT(h != NULL);
+	return h->sim;
+}
+
+uint64_t HNSW_Size
+(
+	const HNSW *h
+) {
+	ASSERT(h != NULL);
+	return h->size;
+}
+
+size_t HNSW_MemoryUsage
+(
+	const HNSW *h
+) {
+	ASSERT(h != NULL);
+
+	size_t n = sizeof(HNSW);
+	n += sizeof(float) * (size_t)h->cap * h->dim;
+	n += sizeof(HNSWElement) * h->cap;
+	n += sizeof(uint32_t) * array_len(h->free_slots);
+	n += HashTableMemUsage(h->ids);
+
+	for(uint32_t i = 0; i < h->count; i++) {
+		const HNSWElement *e = h->elements + i;
+		n += sizeof(uint32_t *) * (e->level + 1);
+		n += sizeof(uint32_t) * (h->M0 + 1);
+		n += sizeof(uint32_t) * (h->M + 1) * e->level;
+	}
+
+	return n;
+}
+
+//------------------------------------------------------------------------------
+// serialization
+//------------------------------------------------------------------------------
+
+// buffer cursor
+typedef struct {
+	unsigned char *p;    // current position
+	unsigned char *end;  // end of buffer
+} HNSWCursor;
+
+static inline void _write
+(
+	HNSWCursor *c,
+	const void *v,
+	size_t n
+) {
+	ASSERT(c->p + n <= c->end);
+	memcpy(c->p, v, n);
+	c->p += n;
+}
+
+// returns false if buffer is exhausted
+static inline bool _read
+(
+	HNSWCursor *c,
+	void *v,
+	size_t n
+) {
+	if((size_t)(c->end - c->p) < n) return false;
+	memcpy(v, c->p, n);
+	c->p += n;
+	return true;
+}
+
+#define WRITE(c, v) _write((c), &(v), sizeof(v))
+#define READ(c, v) if(!_read((c), &(v), sizeof(v))) goto error
+
+void *HNSW_Serialize
+(
+	const HNSW *h,
+	size_t *size
+) {
+	// Format:
+	//  magic, dim, similarity, M, ef_construction, rng state
+	//  #slots, #elements, entry point, max level, #free slots
+	//  vectors              #slots X dim X float
+	//  {
+	//   id, level, deleted
+	//   {#links, link X #links} X (level + 1)
+	//  } X #slots
+	//  free slots           #free slots X uint32
+	//  checksum             XXH64 of all of the above
+
+	ASSERT(h    != NULL);
+	ASSERT(size != NULL);
+
+	uint32_t magic = HNSW_MAGIC;
+	uint32_t sim   = h->sim;
+	uint32_t nfree = array_len(h->free_slots);
+
+	size_t n = sizeof(magic) + sizeof(h->dim) + sizeof(sim) + sizeof(h->M) +
+		sizeof(h->ef_construction) + sizeof(h->rng) + sizeof(h->count) +
+		sizeof(h->size) + sizeof(h->entry) + sizeof(h->max_level) +
+		sizeof(nfree);
+
+	n += sizeof(float) * (size_t)h->count * h->dim;
+	for(uint32_t i = 0; i < h->count; i++) {
+		const HNSWElement *e = h->elements + i;
+		n += sizeof(uint64_t) + 2 * sizeof(uint8_t);
+		for(int l = 0; l <= e->level; l++) {
+			n += sizeof(uint32_t) * (e->links[l][0] + 1);
+		}
+	}
+	n += sizeof(uint32_t) * nfree;
+	n += sizeof(XXH64_hash_t);
+
+	unsigned char *buffer = rm_malloc(n);
+	HNSWCursor c = {buffer, buffer + n};
+
+	WRITE(&c, magic);
+	WRITE(&c, h->dim);
+	WRITE(&c, sim);
+	WRITE(&c, h->M);
+	WRITE(&c, h->ef_construction);
+	WRITE(&c, h->rng);
+	WRITE(&c, h->count);
+	WRITE(&c, h->size);
+	WRITE(&c, h->entry);
+	WRITE(&c, h->max_level);
+	WRITE(&c, nfree);
+
+	_write(&c, h->vectors, sizeof(float) * (size_t)h->count * h->dim);
+
+	for(uint32_t i = 0; i < h->count; i++) {
+		const HNSWElement *e = h->elements + i;
+		uint8_t level   = e->level;
+		uint8_t deleted = e->deleted;
+
+		WRITE(&c, e->id);
+		WRITE(&c, level);
+		WRITE(&c, deleted);
+		for(int l = 0; l <= e->level; l++) {
+			_write(&c, e->links[l], sizeof(uint32_t) * (e->links[l][0] + 1));
+		}
+	}
+
+	_write(&c, h->free_slots, sizeof(uint32_t) * nfree);
+
+	XXH64_hash_t checksum = XXH64(buffer, c.p - buffer, 0);
+	WRITE(&c, checksum);
+	ASSERT(c.p == c.end);
+
+	*size = n;
+	return buffer;
+}
+
+HNSW *HNSW_Deserialize
+(
+	const void *buffer,
+	size_t size
+) {
+	ASSERT(buffer != NULL);
+
+	HNSW *h = NULL;
+	HNSWCursor c = {(unsigned char *)buffer, (unsigned char *)buffer + size};
+
+	//--------------------------------------------------------------------------
+	// validate checksum
+	//--------------------------------------------------------------------------
+
+	XXH64_hash_t checksum;
+	if(size < sizeof(checksum)) return NULL;
+
+	c.end -= sizeof(checksum);
+	memcpy(&checksum, c.end, sizeof(checksum));
+	if(XXH64(buffer, size - sizeof(checksum), 0) != checksum) return NULL;
+
+	//--------------------------------------------------------------------------
+	// restore graph
+	//--------------------------------------------------------------------------
+
+	uint32_t magic;
+	uint32_t dim;
+	uint32_t sim;
+	uint16_t M;
+	uint16_t ef_construction;
+
+	READ(&c, magic);
+	READ(&c, dim);
+	READ(&c, sim);
+	READ(&c, M);
+	READ(&c, ef_construction);
+
+	if(magic != HNSW_MAGIC || dim == 0 || sim > VEC_SIM_IP || M < 2 ||
+	   ef_construction == 0) {
+		return NULL;
+	}
+
+	h = HNSW_New(dim, sim, M, ef_construction);
+
+	uint32_t count;
+	uint32_t nfree;
+	READ(&c, h->rng);
+	READ(&c, count);
+	READ(&c, h->size);
+	READ(&c, h->entry);
+	READ(&c, h->max_level);
+	READ(&c, nfree);
+
+	// slots are restored one at a time such that a failure can free them
+	h->cap      = count;
+	h->vectors  = rm_malloc(sizeof(float) * (size_t)count * dim);
+	h->elements = rm_malloc(sizeof(HNSWElement) * count);
+
+	if(!_read(&c, h->vectors, sizeof(float) * (size_t)count * dim)) goto error;
+
+	uint64_t live = 0;
+	for(uint32_t i = 0; i < count; i++) {
+		HNSWElement *e = h->elements + i;
+		uint8_t level;
+		uint8_t deleted;
+
+		READ(&c, e->id);
+		READ(&c, level);
+		READ(&c, deleted);
+		if(level > HNSW_MAX_LEVEL) goto error;
+
+		e->level   = level;
+		e->deleted = deleted;
+		e->links   = rm_malloc(sizeof(uint32_t *) * (level + 1));
+		_alloc_links(h, e, 0, level);
+		h->count++;
+
+		for(int l = 0; l <= level; l++) {
+			uint32_t *links = e->links[l];
+			READ(&c, links[0]);
+			if(links[0] > ((l == 0) ? h->M0 : h->M)) goto error;
+			if(!_read(&c, links + 1, sizeof(uint32_t) * links[0])) goto error;
+		}
+
+		if(!deleted) {
+			// duplicated element
+			if(HashTableFind(h->ids, (void *)e->id) != NULL) goto error;
+			HashTableAdd(h->ids, (void *)e->id, (void *)(uintptr_t)i);
+			live++;
+		}
+	}
+
+	// links must refer to slots present on the linked level
+	for(uint32_t i = 0; i < count; i++) {
+		HNSWElement *e = h->elements + i;
+		for(int l = 0; l <= e->level; l++) {
+			uint32_t *links = e->links[l];
+			for(uint32_t j = 1; j <= links[0]; j++) {
+				if(links[j] >= count || h->elements[links[j]].level < l) {
+					goto error;
+				}
+			}
+		}
+	}
+
+	for(uint32_t i = 0; i < nfree; i++) {
+		uint32_t slot;
+		READ(&c, slot);
+		if(slot >= count || !h->elements[slot].deleted) goto error;
+		array_append(h->free_slots, slot);
+	}
+
+	if(c.p != c.end || live != h->size) goto error;
+
+	if(h->size == 0) {
+		if(h->entry != -1) goto error;
+	} else if(h->entry < 0 || h->entry >= count ||
+			  h->elements[h->entry].level != h->max_level) {
+		goto error;
+	}
+
+	return h;
+
+error:
+	if(h != NULL) HNSW_Free(h);
+	return NULL;
+}
+
+void HNSW_Free
+(
+	HNSW *h
+) {
+	ASSERT(h != NULL);
+
+	for(uint32_t i = 0; i < h->count; i++) _free_links(h->elements + i);
+
+	if(h->vectors != NULL)  rm_free(h->vectors);
+	if(h->elements != NULL) rm_free(h->elements);
+
+	array_free(h->free_slots);
+	HashTableRelease(h->ids);
+	rm_free(h);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define HNSW_DEFAULT_M               16
+#define HNSW_DEFAULT_EF_CONSTRUCTION 200
+#define HNSW_DEFAULT_EF_RUNTIME      10
+
+// hierarchical navigable small world graph
+// approximate k nearest neighbors search over float32 vectors
+//
+// elements are keyed by a 64 bit id (node ID), removed elements are marked
+// as deleted and remain in the graph as routing points, their slots are
+// reused by subsequent insertions
+//
+// the structure isn't synchronized, insertions and removals require exclusive
+// access while any number of searches may run concurrently
+typedef struct HNSW HNSW;
+
+// distance functions
+typedef enum {
+	VEC_SIM_EUCLIDEAN = 0,  // squared euclidean distance
+	VEC_SIM_COSINE    = 1,  // 1 - cosine similarity
+	VEC_SIM_IP        = 2,  // 1 - inner product
+} VectorSimilarity;
+
+// create a new HNSW graph
+HNSW *HNSW_New
+(
+	uint32_t dim,              // vectors dimension
+	VectorSimilarity sim,      // distance function
+	uint16_t M,                // max number of links per element
+	uint16_t ef_construction   // candidate list size during insertion
+);
+
+// add element to graph, replacing element's vector if id is already present
+void HNSW_Insert
+(
+	HNSW *hnsw,      // graph to update
+	uint64_t id,     // element id
+	const float *v   // element vector, dim floats
+);
+
+// remove element from graph
+// returns false if element isn't present
+bool HNSW_Remove
+(
+	HNSW *hnsw,  // graph to update
+	uint64_t id  // element to remove
+);
+
+// search for the k nearest elements to q
+// results are sorted by ascending distance
+// returns number of results, at most k
+uint32_t HNSW_Search
+(
+	const HNSW *hnsw,  // graph to search
+	const float *q,    // query vector, dim floats
+	uint32_t k,        // number of neighbors to return
+	uint32_t ef,       // candidate list size, raised to k if smaller
+	uint64_t *ids,     // [output] ids of nearest elements
+	float *dists       // [output] distances of nearest elements
+);
+
+// vectors dimension
+uint32_t HNSW_Dimension
+(
+	const HNSW *hnsw
+);
+
+// distance function
+VectorSimilarity HNSW_Similarity
+(
+	const HNSW *hnsw
+);
+
+// number of elements in graph
+uint64_t HNSW_Size
+(
+	const HNSW *hnsw
+);
+
+// number of bytes used by graph
+size_t HNSW_MemoryUsage
+(
+	const HNSW *hnsw
+);
+
+// serialize graph into a single buffer, including its links
+// such that the graph can be restored without being rebuilt
+// the buffer ends with a checksum of its content
+// caller is responsible for freeing the returned buffer using rm_free
+void *HNSW_Serialize
+(
+	const HNSW *hnsw,  // graph to serialize
+	size_t *size       // [output] buffer size
+);
+
+// restore a graph from a buffer produced by HNSW_Serialize
+// returns NULL if the buffer is malformed or fails its checksum
+HNSW *HNSW_Deserialize
+(
+	const void *buffer,  // serialized graph
+	size_t size          // buffer size
+);
+
+// free graph
+void HNSW_Free
+(
+	HNSW *hnsw
+);
@@ -0,0 +1,214 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "vector_distance.h"
+
+#include <math.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define VEC_SIMD_X86 1
+#endif
+
+//------------------------------------------------------------------------------
+// scalar kernels
+//------------------------------------------------------------------------------
+
+static float _l2sq_scalar
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	float acc = 0;
+	for(size_t i = 0; i < dim; i++) {
+		float d = a[i] - b[i];
+		acc += d * d;
+	}
+	return acc;
+}
+
+static float _dot_scalar
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	float acc = 0;
+	for(size_t i = 0; i < dim; i++) acc += a[i] * b[i];
+	return acc;
+}
+
+#ifdef VEC_SIMD_X86
+
+//------------------------------------------------------------------------------
+// SSE kernels
+//------------------------------------------------------------------------------
+
+static inline float _hsum_sse
+(
+	__m128 v
+) {
+	__m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 sums = _mm_add_ps(v, shuf);
+	shuf        = _mm_movehl_ps(shuf, sums);
+	sums        = _mm_add_ss(sums, shuf);
+	return _mm_cvtss_f32(sums);
+}
+
+static float _l2sq_sse
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	size_t i = 0;
+	__m128 acc = _mm_setzero_ps();
+
+	for(; i + 4 <= dim; i += 4) {
+		__m128 d = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+		acc = _mm_add_ps(acc, _mm_mul_ps(d, d));
+	}
+
+	return _hsum_sse(acc) + _l2sq_scalar(a + i, b + i, dim - i);
+}
+
+static float _dot_sse
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	size_t i = 0;
+	__m128 acc = _mm_setzero_ps();
+
+	for(; i + 4 <= dim; i += 4) {
+		acc = _mm_add_ps(acc,
+				_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+
+	return _hsum_sse(acc) + _dot_scalar(a + i, b + i, dim - i);
+}
+
+//------------------------------------------------------------------------------
+// AVX2 kernels
+//------------------------------------------------------------------------------
+
+__attribute__((target("avx2,fma")))
+static inline float _hsum_avx2
+(
+	__m256 v
+) {
+	__m128 lo = _mm256_castps256_ps128(v);
+	__m128 hi = _mm256_extractf128_ps(v, 1);
+	return _hsum_sse(_mm_add_ps(lo, hi));
+}
+
+__attribute__((target("avx2,fma")))
+static float _l2sq_avx2
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	size_t i = 0;
+	__m256 acc = _mm256_setzero_ps();
+
+	for(; i + 8 <= dim; i += 8) {
+		__m256 d = _mm256_sub_ps(_mm256_loadu_ps(a + i),
+				_mm256_loadu_ps(b + i));
+		acc = _mm256_fmadd_ps(d, d, acc);
+	}
+
+	return _hsum_avx2(acc) + _l2sq_sse(a + i, b + i, dim - i);
+}
+
+__attribute__((target("avx2,fma")))
+static float _dot_avx2
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	size_t i = 0;
+	__m256 acc = _mm256_setzero_ps();
+
+	for(; i + 8 <= dim; i += 8) {
+		acc = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+				acc);
+	}
+
+	return _hsum_avx2(acc) + _dot_sse(a + i, b + i, dim - i);
+}
+
+#endif // VEC_SIMD_X86
+
+//------------------------------------------------------------------------------
+// dispatch
+//------------------------------------------------------------------------------
+
+typedef struct {
+	const char *name;
+	float (*l2sq)(const float *, const float *, size_t);
+	float (*dot)(const float *, const float *, size_t);
+} VecDistanceImpl;
+
+#ifdef VEC_SIMD_X86
+static const VecDistanceImpl _avx2_impl = { "avx2", _l2sq_avx2, _dot_avx2 };
+
+// SSE is part of the x86-64 baseline
+static const VecDistanceImpl _sse_impl = { "sse", _l2sq_sse, _dot_sse };
+
+static const VecDistanceImpl *_impl = &_sse_impl;
+#else
+static const VecDistanceImpl _scalar_impl = {
+	"scalar", _l2sq_scalar, _dot_scalar
+};
+
+static const VecDistanceImpl *_impl = &_scalar_impl;
+#endif
+
+void vec_distance_init(void) {
+#ifdef VEC_SIMD_X86
+	__builtin_cpu_init();
+	_impl = (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ?
+		&_avx2_impl : &_sse_impl;
+#endif
+}
+
+const char *vec_distance_impl(void) {
+	return _impl->name;
+}
+
+float vec_l2sq
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	return _impl->l2sq(a, b, dim);
+}
+
+float vec_dot
+(
+	const float *a,
+	const float *b,
+	size_t dim
+) {
+	return _impl->dot(a, b, dim);
+}
+
+void vec_normalize
+(
+	float *v,
+	size_t dim
+) {
+	float norm = sqrtf(_impl->dot(v, v, dim));
+	if(norm == 0) return;
+
+	float inv = 1.0f / norm;
+	for(size_t i = 0; i < dim; i++) v[i] *= inv;
+}
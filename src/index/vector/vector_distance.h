@@ -0,0 +1,44 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+// vectorized float32 distance kernels
+//
+// x86-64 builds use SSE by default and switch to AVX2/FMA kernels
+// once vec_distance_init detects CPU support, other architectures use a
+// portable scalar implementation
+
+// pick the best implementation supported by the running CPU
+void vec_distance_init(void);
+
+// name of the active implementation: "avx2", "sse" or "scalar"
+const char *vec_distance_impl(void);
+
+// squared euclidean distance between a and b
+float vec_l2sq
+(
+	const float *a,  // first vector
+	const float *b,  // second vector
+	size_t dim       // vectors dimension
+);
+
+// inner product of a and b
+float vec_dot
+(
+	const float *a,  // first vector
+	const float *b,  // second vector
+	size_t dim       // vectors dimension
+);
+
+// scale v to unit length, zero vectors are left untouched
+void vec_normalize
+(
+	float *v,   // vector to normalize
+	size_t dim  // vector dimension
+);
@@ -13,6 +13,8 @@
 #include "globals.h"
 #include "util/arr.h"
 #include "cron/cron.h"
+#include "util/strsimd.h"
+#include "index/vector/vector_distance.h"
 #include "query_ctx.h"
 #include "index/indexer.h"
 #include "redisearch_api.h"
@@ -20,6 +22,7 @@
 #include "commands/commands.h"
 #include "util/thpool/pools.h"
 #include "graph/graphcontext.h"
+#include "graph/entities/attribute_spill.h"
 #include "util/redis_version.h"
 #include "ast/ast_validations.h"
 #include "configuration/config.h"
@@ -121,6 +124,14 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	Proc_Register();     // register procedures
 	AR_RegisterFuncs();  // register arithmetic functions
 
+	// select string kernels according to CPU features
+	str_simd_init();
+	RedisModule_Log(ctx, "notice", "Using %s string kernels.", str_simd_impl());
+
+	vec_distance_init();
+	RedisModule_Log(ctx, "notice", "Using %s vector distance kernels.",
+			vec_distance_impl());
+
 	// set up the module's configurable variables,
 	// using user-defined values where provided
 	// register for config updates
@@ -129,6 +140,9 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 
 	RegisterEventHandlers(ctx);
 
+	// open attribute spill file, prior to registering recurring tasks
+	if(!AttributeSpill_Init()) return REDISMODULE_ERR;
+
 	// create thread local storage keys for query and error contexts
 	if(!_Cron_Start())                return REDISMODULE_ERR;
 	if(!QueryCtx_Init())              return REDISMODULE_ERR;
@@ -140,6 +154,10 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 	RedisModule_Log(ctx, "notice", "Thread pool created, using %d threads.",
 			ThreadPools_ReadersCount());
 
+	// latency histograms are kept per thread, create them once thread pools
+	// are in place
+	Commands_InitLatencyStats();
+
 	int ompThreadCount;
 	Config_Option_get(Config_OPENMP_NTHREAD, &ompThreadCount);
 
@@ -218,6 +236,16 @@ int RedisModule_OnLoad(RedisModuleCtx *ctx, RedisModuleString **argv, int argc)
 		return REDISMODULE_ERR;
 	}
 
+	if(RedisModule_CreateCommand(ctx, "graph.SNAPSHOT", Graph_Snapshot,
+				"write deny-oom", 2, 2, 1) == REDISMODULE_ERR) {
+		return REDISMODULE_ERR;
+	}
+
+	if(RedisModule_CreateCommand(ctx, "graph.MEMORY", Graph_Memory, "readonly",
+				1, 1, 1) == REDISMODULE_ERR) {
+		return REDISMODULE_ERR;
+	}
+
 	// set up global variables scoped to the entire module
 	Globals_Init();
 
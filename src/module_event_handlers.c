@@ -15,6 +15,7 @@
 #include "util/redis_version.h"
 #include "graph/graphcontext.h"
 #include "configuration/config.h"
+#include "serializers/decode_pool.h"
 #include "serializers/graphmeta_type.h"
 #include "serializers/graphcontext_type.h"
 
@@ -333,6 +334,24 @@ static void _PersistenceEventHandler(RedisModuleCtx *ctx, RedisModuleEvent eid,
 	}
 }
 
+// server loading event handler
+// graphs are decoded by the decode pool, wait for all of them
+// to be fully constructed before the server starts serving clients
+// RDBs holding graphs are waited for once their keyspace is read,
+// see ModuleEventHandler_AUXAfterKeyspaceEvent
+static void _LoadingEventHandler
+(
+	RedisModuleCtx *ctx,
+	RedisModuleEvent eid,
+	uint64_t subevent,
+	void *data
+) {
+	if(subevent == REDISMODULE_SUBEVENT_LOADING_ENDED ||
+	   subevent == REDISMODULE_SUBEVENT_LOADING_FAILED) {
+		DecodePool_Wait();
+	}
+}
+
 // Perform clean-up upon server shutdown.
 static void _ShutdownEventHandler
 (
@@ -396,6 +415,11 @@ static void _RegisterServerEvents(RedisModuleCtx *ctx) {
 			_PersistenceEventHandler);
 	ASSERT(res == REDISMODULE_OK);
 
+	res = RedisModule_SubscribeToServerEvent(ctx,
+			RedisModuleEvent_Loading,
+			_LoadingEventHandler);
+	ASSERT(res == REDISMODULE_OK);
+
 	// TODO: try to use RedisModuleEvent_ModuleChange to start cron
 	//res = RedisModule_SubscribeToServerEvent(ctx,
 	//		RedisModuleEvent_ModuleChange,
@@ -524,7 +548,13 @@ void ModuleEventHandler_AUXBeforeKeyspaceEvent(void) {
 // so each shard is saving the aux field in its own RDB file
 // once the number is zero,
 // the module finished replicating and the meta keys can be deleted
+//
+// graphs decoded from the RDB must be fully constructed before the keyspace
+// is accessed, an AOF with an RDB preamble replays its tail commands
+// while the server is still loading
 void ModuleEventHandler_AUXAfterKeyspaceEvent(void) {
+	DecodePool_Wait();
+
 	aux_field_counter--;
 	_ModuleEventHandler_TryClearKeyspace();
 }
@@ -26,6 +26,7 @@ typedef struct {
 	SIValue *yield_entity_type; // yield index entity type
 	SIValue *yield_status;      // yield index status
 	SIValue *yield_info;        // yield info
+	SIValue *yield_progress;    // yield population progress
 } IndexesContext;
 
 static void _process_yield
@@ -37,6 +38,7 @@ static void _process_yield
 	ctx->yield_info        = NULL;
 	ctx->yield_label       = NULL;
 	ctx->yield_status      = NULL;
+	ctx->yield_progress    = NULL;
 	ctx->yield_language    = NULL;
 	ctx->yield_stopwords   = NULL;
 	ctx->yield_properties  = NULL;
@@ -91,6 +93,12 @@ static void _process_yield
 			idx++;
 			continue;
 		}
+
+		if(strcasecmp("progress", yield[i]) == 0) {
+			ctx->yield_progress = ctx->out + idx;
+			idx++;
+			continue;
+		}
 	}
 }
 
@@ -116,7 +124,7 @@ ProcedureResult Proc_IndexesInvoke
 	IndexesContext *pdata = rm_malloc(sizeof(IndexesContext));
 
 	pdata->gc      = gc;
-	pdata->out     = array_new(SIValue, 8);
+	pdata->out     = array_new(SIValue, 9);
 	pdata->indices = array_new(Index, 0);
 
 	//--------------------------------------------------------------------------
@@ -126,7 +134,7 @@ ProcedureResult Proc_IndexesInvoke
 	unsigned short n;            // number of schemas
 	Schema         *s;           // current schema
 	unsigned short idx_count;    // number of indicies in schema
-	Index          indicies[4];  // schema indicies
+	Index          indicies[SCHEMA_MAX_INDICIES];  // schema indicies
 
 	// collect indices from node schemas
 	n = GraphContext_SchemaCount(gc, SCHEMA_NODE);
@@ -155,6 +163,31 @@ ProcedureResult Proc_IndexesInvoke
 	return PROCEDURE_OK;
 }
 
+// vector index info map
+static SIValue _VectorIndexInfo
+(
+	Index idx
+) {
+	static const char *similarity[] = {"euclidean", "cosine", "ip"};
+
+	const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+	HNSW *hnsw = Index_HNSW(idx);
+
+	SIValue map = SI_Map(7);
+	Map_Add(&map, SI_ConstStringVal("dimension"),      SI_LongVal(opts->dimension));
+	Map_Add(&map, SI_ConstStringVal("similarityFunction"),
+			SI_ConstStringVal((char *)similarity[opts->similarity]));
+	Map_Add(&map, SI_ConstStringVal("M"),              SI_LongVal(opts->M));
+	Map_Add(&map, SI_ConstStringVal("efConstruction"), SI_LongVal(opts->ef_construction));
+	Map_Add(&map, SI_ConstStringVal("efRuntime"),      SI_LongVal(opts->ef_runtime));
+	Map_Add(&map, SI_ConstStringVal("numDocuments"),
+			SI_LongVal(hnsw ? HNSW_Size(hnsw) : 0));
+	Map_Add(&map, SI_ConstStringVal("memoryUsage"),
+			SI_LongVal(hnsw ? HNSW_MemoryUsage(hnsw) : 0));
+
+	return map;
+}
+
 static bool _EmitIndex
 (
 	IndexesContext *ctx,
@@ -184,15 +217,44 @@ static bool _EmitIndex
 		}
 	}
 
+	//--------------------------------------------------------------------------
+	// index population progress
+	//--------------------------------------------------------------------------
+
+	if(ctx->yield_progress != NULL) {
+		uint64_t indexed;
+		uint64_t total;
+
+		if(Index_Enabled(idx)) {
+			// operational index covers all entities
+			Graph *g = GraphContext_GetGraph(ctx->gc);
+			int label_id = Index_GetLabelID(idx);
+			total = (Index_GraphEntityType(idx) == GETYPE_NODE) ?
+				Graph_LabeledNodeCount(g, label_id) :
+				Graph_RelationEdgeCount(g, label_id);
+			indexed = total;
+		} else {
+			Index_PopulationProgress(idx, &indexed, &total);
+		}
+
+		SIValue map = SI_Map(2);
+		Map_Add(&map, SI_ConstStringVal("indexed"), SI_LongVal(indexed));
+		Map_Add(&map, SI_ConstStringVal("total"),   SI_LongVal(total));
+		*ctx->yield_progress = map;
+	}
+
 	//--------------------------------------------------------------------------
 	// index type
 	//--------------------------------------------------------------------------
 
 	if(ctx->yield_type != NULL) {
-		if(Index_Type(idx) == IDX_EXACT_MATCH) {
+		IndexType t = Index_Type(idx);
+		if(t == IDX_EXACT_MATCH) {
 			*ctx->yield_type = SI_ConstStringVal("exact-match");
-		} else {
+		} else if(t == IDX_FULLTEXT) {
 			*ctx->yield_type = SI_ConstStringVal("full-text");
+		} else {
+			*ctx->yield_type = SI_ConstStringVal("vector");
 		}
 	}
 
@@ -224,8 +286,9 @@ static bool _EmitIndex
 	//--------------------------------------------------------------------------
 
 	if(ctx->yield_language) {
-		*ctx->yield_language =
-			SI_ConstStringVal((char *)Index_GetLanguage(idx));
+		const char *lang = Index_GetLanguage(idx);
+		*ctx->yield_language = (lang != NULL) ?
+			SI_ConstStringVal((char *)lang) : SI_NullVal();
 	}
 
 	//--------------------------------------------------------------------------
@@ -252,7 +315,9 @@ static bool _EmitIndex
 	// index info
 	//--------------------------------------------------------------------------
 
-	if(ctx->yield_info) {
+	if(ctx->yield_info && Index_Type(idx) == IDX_VECTOR) {
+		*ctx->yield_info = _VectorIndexInfo(idx);
+	} else if(ctx->yield_info) {
 		RSIdxInfo info = { .version = RS_INFO_CURRENT_VERSION };
 
 		RSIndex *rsIdx = Index_RSIndex(idx);
@@ -346,7 +411,7 @@ ProcedureResult Proc_IndexesFree
 ProcedureCtx *Proc_IndexesCtx(void) {
 	void *privateData = NULL;
 	ProcedureOutput output;
-	ProcedureOutput *outputs = array_new(ProcedureOutput, 8);
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 9);
 
 	// index type (exact-match / fulltext)
 	output = (ProcedureOutput) {
@@ -396,6 +461,12 @@ ProcedureCtx *Proc_IndexesCtx(void) {
 	};
 	array_append(outputs, output);
 
+	// index population progress (indexed / total entities)
+	output = (ProcedureOutput) {
+		.name = "progress", .type = T_MAP
+	};
+	array_append(outputs, output);
+
 	ProcedureCtx *ctx = ProcCtxNew("db.indexes",
 								   0,
 								   outputs,
@@ -0,0 +1,228 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_query_stats.h"
+#include "RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+// procedure outputs
+typedef enum {
+	OUT_QUERY = 0,
+	OUT_CALLS,
+	OUT_TOTAL_TIME,
+	OUT_MEAN_TIME,
+	OUT_MAX_TIME,
+	OUT_ROWS,
+	OUT_CACHE_HIT_RATIO,
+	OUT_MEMORY_PEAK,
+	OUT_LOCK_WAIT,
+	OUT_PLAN_CHANGES,
+	OUT_COUNT
+} QueryStatsOutput;
+
+static const ProcedureOutput _outputs[OUT_COUNT] = {
+	[OUT_QUERY]           = {.name = "query",         .type = T_STRING},
+	[OUT_CALLS]           = {.name = "calls",         .type = T_INT64},
+	[OUT_TOTAL_TIME]      = {.name = "totalTime",     .type = T_DOUBLE},
+	[OUT_MEAN_TIME]       = {.name = "meanTime",      .type = T_DOUBLE},
+	[OUT_MAX_TIME]        = {.name = "maxTime",       .type = T_DOUBLE},
+	[OUT_ROWS]            = {.name = "rows",          .type = T_INT64},
+	[OUT_CACHE_HIT_RATIO] = {.name = "cacheHitRatio", .type = T_DOUBLE},
+	[OUT_MEMORY_PEAK]     = {.name = "memoryPeak",    .type = T_INT64},
+	[OUT_LOCK_WAIT]       = {.name = "lockWait",      .type = T_DOUBLE},
+	[OUT_PLAN_CHANGES]    = {.name = "planChanges",   .type = T_INT64},
+};
+
+typedef struct {
+	uint idx;                          // current entry
+	SIValue *out;                      // outputs
+	SIValue *yield[OUT_COUNT];         // output slot per yielded output
+	FingerprintStatsEntry *entries;    // snapshot of the statistics table
+} QueryStatsContext;
+
+static void _process_yield
+(
+	QueryStatsContext *ctx,
+	const char **yield
+) {
+	for(int i = 0; i < OUT_COUNT; i++) ctx->yield[i] = NULL;
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		for(int j = 0; j < OUT_COUNT; j++) {
+			if(strcasecmp(_outputs[j].name, yield[i]) == 0) {
+				ctx->yield[j] = ctx->out + idx;
+				idx++;
+				break;
+			}
+		}
+	}
+}
+
+// CALL db.queryStats()
+ProcedureResult Proc_QueryStatsInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	ASSERT(ctx   != NULL);
+	ASSERT(args  != NULL);
+	ASSERT(yield != NULL);
+
+	if(array_len((SIValue *)args) != 0) return PROCEDURE_ERR;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	QueryStatsContext *pdata = rm_malloc(sizeof(QueryStatsContext));
+
+	pdata->idx     = 0;
+	pdata->out     = array_new(SIValue, OUT_COUNT);
+	pdata->entries = FingerprintStats_Entries(gc->fingerprint_stats);
+
+	for(int i = 0; i < OUT_COUNT; i++) {
+		array_append(pdata->out, SI_NullVal());
+	}
+
+	_process_yield(pdata, yield);
+
+	ctx->privateData = pdata;
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_QueryStatsStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData != NULL);
+
+	QueryStatsContext *pdata = ctx->privateData;
+
+	// depleted?
+	if(pdata->idx >= array_len(pdata->entries)) return NULL;
+
+	const FingerprintStatsEntry *e = pdata->entries + pdata->idx++;
+	SIValue **yield = pdata->yield;
+
+	if(yield[OUT_QUERY]) {
+		*yield[OUT_QUERY] = SI_ConstStringVal(e->query);
+	}
+	if(yield[OUT_CALLS]) {
+		*yield[OUT_CALLS] = SI_LongVal(e->calls);
+	}
+	if(yield[OUT_TOTAL_TIME]) {
+		*yield[OUT_TOTAL_TIME] = SI_DoubleVal(e->total_time);
+	}
+	if(yield[OUT_MEAN_TIME]) {
+		*yield[OUT_MEAN_TIME] = SI_DoubleVal(e->total_time / e->calls);
+	}
+	if(yield[OUT_MAX_TIME]) {
+		*yield[OUT_MAX_TIME] = SI_DoubleVal(e->max_time);
+	}
+	if(yield[OUT_ROWS]) {
+		*yield[OUT_ROWS] = SI_LongVal(e->rows);
+	}
+	if(yield[OUT_CACHE_HIT_RATIO]) {
+		*yield[OUT_CACHE_HIT_RATIO] =
+			SI_DoubleVal((double)e->cache_hits / e->calls);
+	}
+	if(yield[OUT_MEMORY_PEAK]) {
+		*yield[OUT_MEMORY_PEAK] = SI_LongVal(e->memory_peak);
+	}
+	if(yield[OUT_LOCK_WAIT]) {
+		*yield[OUT_LOCK_WAIT] = SI_DoubleVal(e->lock_wait);
+	}
+	if(yield[OUT_PLAN_CHANGES]) {
+		*yield[OUT_PLAN_CHANGES] = SI_LongVal(e->plan_changes);
+	}
+
+	return pdata->out;
+}
+
+ProcedureResult Proc_QueryStatsFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		QueryStatsContext *pdata = ctx->privateData;
+		array_free(pdata->out);
+		FingerprintStats_FreeEntries(pdata->entries);
+		rm_free(pdata);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_QueryStatsCtx(void) {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, OUT_COUNT);
+	for(int i = 0; i < OUT_COUNT; i++) {
+		array_append(outputs, _outputs[i]);
+	}
+
+	ProcedureCtx *ctx = ProcCtxNew("db.queryStats",
+								   0,
+								   outputs,
+								   Proc_QueryStatsStep,
+								   Proc_QueryStatsInvoke,
+								   Proc_QueryStatsFree,
+								   privateData,
+								   true);
+	return ctx;
+}
+
+//------------------------------------------------------------------------------
+// reset
+//------------------------------------------------------------------------------
+
+// CALL db.queryStats.reset()
+ProcedureResult Proc_QueryStatsResetInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 0) return PROCEDURE_ERR;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	FingerprintStats_Reset(gc->fingerprint_stats);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_QueryStatsResetStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_QueryStatsResetFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_QueryStatsResetCtx(void) {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.queryStats.reset",
+								   0,
+								   outputs,
+								   Proc_QueryStatsResetStep,
+								   Proc_QueryStatsResetInvoke,
+								   Proc_QueryStatsResetFree,
+								   privateData,
+								   true);
+	return ctx;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_vector_create_index.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../index/index.h"
+#include "../errors/errors.h"
+#include "../index/indexer.h"
+#include "../graph/graphcontext.h"
+#include "../datatypes/datatypes.h"
+
+//------------------------------------------------------------------------------
+// vector createNodeIndex
+//------------------------------------------------------------------------------
+
+// read an optional integer configuration entry
+// validates value is within [min, max]
+static bool _getIntConfig
+(
+	SIValue config,    // configuration map
+	const char *key,   // entry to read
+	int min,           // minimal valid value
+	int max,           // maximal valid value
+	int64_t *value     // [input/output] default value / value read
+) {
+	SIValue v;
+	if(!MAP_GET(config, key, v)) return true;
+
+	if(SI_TYPE(v) != T_INT64 || v.longval < min || v.longval > max) {
+		ErrorCtx_SetError(EMSG_VECTOR_RANGE, key, min, max);
+		return false;
+	}
+
+	*value = v.longval;
+	return true;
+}
+
+// parse and validate index configuration map
+// [required] label <string>
+// [required] attribute <string>
+// [required] dimension <int>
+// [optional] similarityFunction <string> euclidean / cosine / ip
+// [optional] M <int>
+// [optional] efConstruction <int>
+// [optional] efRuntime <int>
+static ProcedureResult _parseIndexConfigMap
+(
+	SIValue config,               // configuration map
+	const char **label,           // [output] indexed label
+	const char **attribute,       // [output] indexed attribute
+	VectorIndexOptions *opts      // [output] index options
+) {
+	SIValue v;
+
+	if(!MAP_GET(config, "label", v)) {
+		ErrorCtx_SetError(EMSG_IS_MISSING, "Label");
+		return PROCEDURE_ERR;
+	}
+	if(SI_TYPE(v) != T_STRING) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Label", "string");
+		return PROCEDURE_ERR;
+	}
+	*label = v.stringval;
+
+	if(!MAP_GET(config, "attribute", v)) {
+		ErrorCtx_SetError(EMSG_IS_MISSING, "Attribute");
+		return PROCEDURE_ERR;
+	}
+	if(SI_TYPE(v) != T_STRING) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Attribute", "string");
+		return PROCEDURE_ERR;
+	}
+	*attribute = v.stringval;
+
+	if(!MAP_GET(config, "dimension", v)) {
+		ErrorCtx_SetError(EMSG_IS_MISSING, "Dimension");
+		return PROCEDURE_ERR;
+	}
+
+	opts->similarity = VEC_SIM_EUCLIDEAN;
+	if(MAP_GET(config, "similarityFunction", v)) {
+		if(SI_TYPE(v) != T_STRING) {
+			ErrorCtx_SetError(EMSG_VECTOR_SIMILARITY);
+			return PROCEDURE_ERR;
+		}
+
+		if(strcasecmp(v.stringval, "euclidean") == 0) {
+			opts->similarity = VEC_SIM_EUCLIDEAN;
+		} else if(strcasecmp(v.stringval, "cosine") == 0) {
+			opts->similarity = VEC_SIM_COSINE;
+		} else if(strcasecmp(v.stringval, "ip") == 0) {
+			opts->similarity = VEC_SIM_IP;
+		} else {
+			ErrorCtx_SetError(EMSG_VECTOR_SIMILARITY);
+			return PROCEDURE_ERR;
+		}
+	}
+
+	int64_t dim             = 0;
+	int64_t M               = HNSW_DEFAULT_M;
+	int64_t ef_construction = HNSW_DEFAULT_EF_CONSTRUCTION;
+	int64_t ef_runtime      = HNSW_DEFAULT_EF_RUNTIME;
+
+	if(!_getIntConfig(config, "dimension", 1, VECTOR_INDEX_MAX_DIMENSION, &dim) ||
+	   !_getIntConfig(config, "M", 2, 512, &M)                                  ||
+	   !_getIntConfig(config, "efConstruction", 1, 4096, &ef_construction)      ||
+	   !_getIntConfig(config, "efRuntime", 1, 4096, &ef_runtime)) {
+		return PROCEDURE_ERR;
+	}
+
+	opts->M               = M;
+	opts->dimension       = dim;
+	opts->ef_runtime      = ef_runtime;
+	opts->ef_construction = ef_construction;
+
+	return PROCEDURE_OK;
+}
+
+// CALL db.idx.vector.createNodeIndex({label:'Doc', attribute:'embedding',
+//      dimension:128, similarityFunction:'cosine'})
+ProcedureResult Proc_VectorCreateNodeIdxInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	if(array_len((SIValue *)args) != 1 || SI_TYPE(args[0]) != T_MAP) {
+		ErrorCtx_SetError(EMSG_VECTOR_CONFIG_TYPE);
+		return PROCEDURE_ERR;
+	}
+
+	const char *label     = NULL;
+	const char *attribute = NULL;
+	VectorIndexOptions opts;
+
+	if(_parseIndexConfigMap(args[0], &label, &attribute, &opts) ==
+			PROCEDURE_ERR) {
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	// a label holds at most a single vector index
+	if(GraphContext_GetIndex(gc, label, NULL, 0, IDX_VECTOR, SCHEMA_NODE)) {
+		ErrorCtx_SetError(EMSG_INDEX_ALREADY_EXISTS);
+		return PROCEDURE_ERR;
+	}
+
+	// create and build index
+	Index idx = NULL;
+	if(GraphContext_AddVectorIndex(&idx, gc, label, attribute, &opts)) {
+		Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+		Indexer_PopulateIndex(gc, s, idx);
+	}
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_VectorCreateNodeIdxStep(ProcedureCtx *ctx) {
+	return NULL;
+}
+
+ProcedureResult Proc_VectorCreateNodeIdxFree(ProcedureCtx *ctx) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_VectorCreateNodeIdxGen() {
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	return ProcCtxNew("db.idx.vector.createNodeIndex", 1, output,
+			Proc_VectorCreateNodeIdxStep, Proc_VectorCreateNodeIdxInvoke,
+			Proc_VectorCreateNodeIdxFree, NULL, false);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_vector_drop_index.h"
+#include "../query_ctx.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../errors/errors.h"
+#include "../graph/graphcontext.h"
+
+//------------------------------------------------------------------------------
+// vector drop index
+//------------------------------------------------------------------------------
+
+// CALL db.idx.vector.drop(label)
+// CALL db.idx.vector.drop('Doc')
+
+ProcedureResult Proc_VectorDropIndexInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// argument validations
+	// expecting arg[0] to be a string
+	if(array_len((SIValue *)args) != 1) {
+		return PROCEDURE_ERR;
+	}
+
+	if(!(SI_TYPE(args[0]) & T_STRING)) {
+		return PROCEDURE_ERR;
+	}
+
+	const char *l = args[0].stringval;
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	int res = GraphContext_DeleteIndex(gc, SCHEMA_NODE, l, NULL, IDX_VECTOR);
+
+	if(res != INDEX_OK) {
+		ErrorCtx_SetError(EMSG_VECTOR_DROP_INDEX, l);
+	}
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_VectorDropIndexStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_VectorDropIndexFree
+(
+	ProcedureCtx *ctx
+) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_VectorDropIdxGen() {
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	return ProcCtxNew("db.idx.vector.drop", 1, output,
+			Proc_VectorDropIndexStep, Proc_VectorDropIndexInvoke,
+			Proc_VectorDropIndexFree, NULL, false);
+}
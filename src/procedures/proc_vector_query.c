@@ -0,0 +1,179 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_vector_query.h"
+#include "RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../index/index.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../graph/graphcontext.h"
+#include "../datatypes/array.h"
+
+//------------------------------------------------------------------------------
+// vector query
+//------------------------------------------------------------------------------
+
+// CALL db.idx.vector.query(label, attribute, k, vector)
+// CALL db.idx.vector.query('Doc', 'embedding', 10, $q) YIELD node, distance
+
+typedef struct {
+	Node n;                  // current node
+	Graph *g;                // graph
+	SIValue *output;         // outputs
+	EntityID *ids;           // nearest nodes
+	float *dists;            // nearest nodes distances
+	uint32_t count;          // number of results
+	uint32_t current;        // next result to emit
+	SIValue *yield_node;     // yield node
+	SIValue *yield_distance; // yield distance
+} VectorQueryContext;
+
+static void _process_yield
+(
+	VectorQueryContext *ctx,
+	const char **yield
+) {
+	ctx->yield_node     = NULL;
+	ctx->yield_distance = NULL;
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("distance", yield[i]) == 0) {
+			ctx->yield_distance = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+ProcedureResult Proc_VectorQueryNodeInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	ctx->privateData = NULL;
+
+	if(array_len((SIValue *)args) != 4) return PROCEDURE_ERR;
+	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Label and attribute", "strings");
+		return PROCEDURE_ERR;
+	}
+	if(SI_TYPE(args[2]) != T_INT64 || args[2].longval < 0) {
+		ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "k");
+		return PROCEDURE_ERR;
+	}
+	if(args[2].longval > UINT32_MAX) {
+		ErrorCtx_SetError(EMSG_VECTOR_QUERY_K, UINT32_MAX);
+		return PROCEDURE_ERR;
+	}
+
+	GraphContext *gc      = QueryCtx_GetGraphCtx();
+	const char *label     = args[0].stringval;
+	const char *attribute = args[1].stringval;
+	uint64_t k            = args[2].longval;
+
+	// get vector index from schema
+	Attribute_ID attr = GraphContext_GetAttributeID(gc, attribute);
+	Index idx = GraphContext_GetIndex(gc, label, &attr, 1, IDX_VECTOR,
+			SCHEMA_NODE);
+	if(idx == NULL) {
+		ErrorCtx_SetError(EMSG_VECTOR_NO_INDEX, label, attribute);
+		return PROCEDURE_ERR;
+	}
+
+	uint32_t dim = Index_GetVectorOptions(idx)->dimension;
+	float q[dim];
+	if(!Index_VectorFromValue(args[3], dim, q)) {
+		ErrorCtx_SetError(EMSG_VECTOR_QUERY_TYPE, dim);
+		return PROCEDURE_ERR;
+	}
+
+	// no more results than indexed nodes
+	uint64_t size = HNSW_Size(Index_HNSW(idx));
+	if(k > size) k = size;
+
+	VectorQueryContext *pdata = rm_malloc(sizeof(VectorQueryContext));
+	ctx->privateData = pdata;
+
+	pdata->g       = gc->g;
+	pdata->n       = GE_NEW_NODE();
+	pdata->ids     = NULL;
+	pdata->dists   = NULL;
+	pdata->count   = 0;
+	pdata->output  = array_new(SIValue, 2);
+	pdata->current = 0;
+
+	_process_yield(pdata, yield);
+
+	// k = 0 or an empty index, no rows
+	if(k == 0) return PROCEDURE_OK;
+
+	pdata->ids   = rm_malloc(sizeof(EntityID) * k);
+	pdata->dists = rm_malloc(sizeof(float) * k);
+
+	// search index, results are emitted by ascending distance
+	pdata->count = Index_VectorQuery(idx, q, k, pdata->ids, pdata->dists);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_VectorQueryNodeStep
+(
+	ProcedureCtx *ctx
+) {
+	VectorQueryContext *pdata = (VectorQueryContext *)ctx->privateData;
+	if(pdata == NULL || pdata->current == pdata->count) return NULL;
+
+	uint32_t i = pdata->current++;
+
+	// get node
+	Node *n = &pdata->n;
+	Graph_GetNode(pdata->g, pdata->ids[i], n);
+
+	if(pdata->yield_node) *pdata->yield_node = SI_Node(n);
+	if(pdata->yield_distance) {
+		*pdata->yield_distance = SI_DoubleVal(pdata->dists[i]);
+	}
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_VectorQueryNodeFree
+(
+	ProcedureCtx *ctx
+) {
+	if(!ctx->privateData) return PROCEDURE_OK;
+
+	VectorQueryContext *pdata = ctx->privateData;
+	array_free(pdata->output);
+	if(pdata->ids   != NULL) rm_free(pdata->ids);
+	if(pdata->dists != NULL) rm_free(pdata->dists);
+	rm_free(pdata);
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_VectorQueryNodeGen() {
+	ProcedureOutput *output      = array_new(ProcedureOutput, 2);
+	ProcedureOutput out_node     = {.name = "node", .type = T_NODE};
+	ProcedureOutput out_distance = {.name = "distance", .type = T_DOUBLE};
+	array_append(output, out_node);
+	array_append(output, out_distance);
+
+	return ProcCtxNew("db.idx.vector.query", 4, output,
+			Proc_VectorQueryNodeStep, Proc_VectorQueryNodeInvoke,
+			Proc_VectorQueryNodeFree, NULL, true);
+}
@@ -32,6 +32,8 @@ void Proc_Register() {
 	_procRegister("db.propertyKeys", Proc_PropKeysCtx);
 	_procRegister("dbms.procedures", Proc_ProceduresCtx);
 	_procRegister("db.relationshipTypes", Proc_RelationsCtx);
+	_procRegister("db.queryStats", Proc_QueryStatsCtx);
+	_procRegister("db.queryStats.reset", Proc_QueryStatsResetCtx);
 
 	// Register graph algorithms.
 	_procRegister("algo.BFS", Proc_BFS_Ctx);
@@ -43,6 +45,11 @@ void Proc_Register() {
 	_procRegister("db.idx.fulltext.drop", Proc_FulltextDropIdxGen);
 	_procRegister("db.idx.fulltext.queryNodes", Proc_FulltextQueryNodeGen);
 	_procRegister("db.idx.fulltext.createNodeIndex", Proc_FulltextCreateNodeIdxGen);
+
+	// Register vector index procedures.
+	_procRegister("db.idx.vector.drop", Proc_VectorDropIdxGen);
+	_procRegister("db.idx.vector.query", Proc_VectorQueryNodeGen);
+	_procRegister("db.idx.vector.createNodeIndex", Proc_VectorCreateNodeIdxGen);
 }
 
 ProcedureCtx *ProcCtxNew(const char *name,
@@ -13,10 +13,14 @@
 #include "proc_ss_paths.h"
 #include "proc_relations.h"
 #include "proc_procedures.h"
+#include "proc_query_stats.h"
 #include "proc_list_indexes.h"
 #include "proc_list_constraints.h"
 #include "proc_property_keys.h"
 #include "proc_fulltext_query.h"
 #include "proc_fulltext_drop_index.h"
 #include "proc_fulltext_create_index.h"
+#include "proc_vector_query.h"
+#include "proc_vector_drop_index.h"
+#include "proc_vector_create_index.h"
 
@@ -0,0 +1,160 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "fingerprint_stats.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "rax.h"
+
+#include <pthread.h>
+
+// entries are updated under a single lock
+// the critical section is a lookup followed by a handful of additions
+typedef struct _FingerprintStats {
+	rax *entries;          // fingerprint to FingerprintStatsEntry
+	pthread_mutex_t lock;  // entries lock
+} _FingerprintStats;
+
+static void _FingerprintStats_FreeEntry
+(
+	void *entry
+) {
+	FingerprintStatsEntry *e = entry;
+	rm_free(e->query);
+	rm_free(e);
+}
+
+FingerprintStats FingerprintStats_New(void) {
+	_FingerprintStats *stats = rm_malloc(sizeof(_FingerprintStats));
+
+	stats->entries = raxNew();
+	int res = pthread_mutex_init(&stats->lock, NULL);
+	ASSERT(res == 0);
+
+	return stats;
+}
+
+void FingerprintStats_Add
+(
+	FingerprintStats stats,   // statistics table
+	uint64_t fingerprint,     // query fingerprint
+	const char *query,        // normalized query
+	uint64_t plan_signature,  // execution plan signature, 0 if no plan
+	double time,              // execution time in ms
+	double lock_wait,         // time spent waiting for locks in ms
+	uint64_t rows,            // number of rows returned
+	bool cached,              // execution utilized a cached plan
+	int64_t memory_peak       // memory consumed by the execution
+) {
+	ASSERT(stats != NULL);
+	ASSERT(query != NULL);
+
+	unsigned char *key = (unsigned char *)&fingerprint;
+
+	pthread_mutex_lock(&stats->lock);
+
+	FingerprintStatsEntry *e = raxFind(stats->entries, key,
+			sizeof(fingerprint));
+
+	if(e == raxNotFound) {
+		if(raxSize(stats->entries) >= FINGERPRINT_STATS_MAX_ENTRIES) {
+			pthread_mutex_unlock(&stats->lock);
+			return;
+		}
+
+		e = rm_calloc(1, sizeof(FingerprintStatsEntry));
+		e->query       = rm_strdup(query);
+		e->fingerprint = fingerprint;
+		raxInsert(stats->entries, key, sizeof(fingerprint), e, NULL);
+	}
+
+	// a plan different from the one last seen was used
+	if(plan_signature != 0) {
+		if(e->plan_signature != 0 && e->plan_signature != plan_signature) {
+			e->plan_changes++;
+		}
+		e->plan_signature = plan_signature;
+	}
+
+	e->calls++;
+	e->rows       += rows;
+	e->lock_wait  += lock_wait;
+	e->total_time += time;
+	e->cache_hits += cached;
+
+	if(time > e->max_time)          e->max_time    = time;
+	if(memory_peak > e->memory_peak) e->memory_peak = memory_peak;
+
+	pthread_mutex_unlock(&stats->lock);
+}
+
+FingerprintStatsEntry *FingerprintStats_Entries
+(
+	FingerprintStats stats  // statistics table
+) {
+	ASSERT(stats != NULL);
+
+	pthread_mutex_lock(&stats->lock);
+
+	FingerprintStatsEntry *entries = array_new(FingerprintStatsEntry,
+			raxSize(stats->entries));
+
+	raxIterator it;
+	raxStart(&it, stats->entries);
+	raxSeek(&it, "^", NULL, 0);
+	while(raxNext(&it)) {
+		FingerprintStatsEntry e = *(FingerprintStatsEntry *)it.data;
+		e.query = rm_strdup(e.query);
+		array_append(entries, e);
+	}
+	raxStop(&it);
+
+	pthread_mutex_unlock(&stats->lock);
+
+	return entries;
+}
+
+void FingerprintStats_FreeEntries
+(
+	FingerprintStatsEntry *entries  // entries to free
+) {
+	ASSERT(entries != NULL);
+
+	uint n = array_len(entries);
+	for(uint i = 0; i < n; i++) {
+		rm_free(entries[i].query);
+	}
+
+	array_free(entries);
+}
+
+void FingerprintStats_Reset
+(
+	FingerprintStats stats  // statistics table
+) {
+	ASSERT(stats != NULL);
+
+	rax *entries = raxNew();
+
+	pthread_mutex_lock(&stats->lock);
+	rax *old = stats->entries;
+	stats->entries = entries;
+	pthread_mutex_unlock(&stats->lock);
+
+	raxFreeWithCallback(old, _FingerprintStats_FreeEntry);
+}
+
+void FingerprintStats_Free
+(
+	FingerprintStats stats  // statistics table
+) {
+	ASSERT(stats != NULL);
+
+	raxFreeWithCallback(stats->entries, _FingerprintStats_FreeEntry);
+	pthread_mutex_destroy(&stats->lock);
+	rm_free(stats);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// maximum number of fingerprints tracked per graph
+// executions of new fingerprints are not recorded once the limit is reached
+#define FINGERPRINT_STATS_MAX_ENTRIES 1000
+
+// cumulative statistics of all executions sharing a fingerprint
+typedef struct {
+	char *query;              // normalized query
+	uint64_t fingerprint;     // query fingerprint
+	uint64_t calls;           // number of executions
+	uint64_t cache_hits;      // executions which utilized a cached plan
+	uint64_t rows;            // number of rows returned
+	uint64_t plan_changes;    // number of times the execution plan changed
+	uint64_t plan_signature;  // signature of the last execution plan
+	double total_time;        // total execution time in ms
+	double max_time;          // maximum execution time in ms
+	double lock_wait;         // total time spent waiting for locks in ms
+	int64_t memory_peak;      // maximum memory consumed by an execution
+} FingerprintStatsEntry;
+
+// forward declaration of opaque FingerprintStats structure
+typedef struct _FingerprintStats *FingerprintStats;
+
+// create a new fingerprint statistics table
+FingerprintStats FingerprintStats_New(void);
+
+// record an execution
+void FingerprintStats_Add
+(
+	FingerprintStats stats,   // statistics table
+	uint64_t fingerprint,     // query fingerprint
+	const char *query,        // normalized query
+	uint64_t plan_signature,  // execution plan signature, 0 if no plan
+	double time,              // execution time in ms
+	double lock_wait,         // time spent waiting for locks in ms
+	uint64_t rows,            // number of rows returned
+	bool cached,              // execution utilized a cached plan
+	int64_t memory_peak       // memory consumed by the execution
+);
+
+// returns a copy of all entries
+// caller is responsible for freeing the returned array
+// using FingerprintStats_FreeEntries
+FingerprintStatsEntry *FingerprintStats_Entries
+(
+	FingerprintStats stats  // statistics table
+);
+
+// free entries returned by FingerprintStats_Entries
+void FingerprintStats_FreeEntries
+(
+	FingerprintStatsEntry *entries  // entries to free
+);
+
+// clear all entries
+void FingerprintStats_Reset
+(
+	FingerprintStats stats  // statistics table
+);
+
+// free statistics table
+void FingerprintStats_Free
+(
+	FingerprintStats stats  // statistics table
+);
@@ -0,0 +1,131 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "latency_stats.h"
+#include "../util/rmalloc.h"
+#include "../util/thpool/pools.h"
+
+#include <string.h>
+
+// metric names
+static const char *_metric_names[LatencyMetric_COUNT] = {
+	[LatencyMetric_TOTAL] = "Query latency",
+	[LatencyMetric_QUEUE] = "Queue wait",
+	[LatencyMetric_LOCK]  = "Lock wait",
+	[LatencyMetric_REPLY] = "Reply time",
+};
+
+typedef struct _LatencyStats {
+	uint n;                 // number of threads
+	HdrHistogram **slots;   // per thread histograms, one per metric
+} _LatencyStats;
+
+// converts milliseconds to microseconds
+static inline uint64_t _ms_to_us
+(
+	double ms  // duration in milliseconds
+) {
+	return (ms > 0) ? (uint64_t)(ms * 1000) : 0;
+}
+
+LatencyStats LatencyStats_New(void) {
+	_LatencyStats *stats = rm_malloc(sizeof(_LatencyStats));
+
+	// #readers + #writers + Redis main thread
+	stats->n     = ThreadPools_ThreadCount() + 1;
+	stats->slots = rm_calloc(stats->n, sizeof(HdrHistogram *));
+
+	return stats;
+}
+
+void LatencyStats_Record
+(
+	LatencyStats stats,       // latency stats
+	const QueryTrace *trace   // closed query trace
+) {
+	ASSERT(stats != NULL);
+	ASSERT(trace != NULL);
+
+	int tid = ThreadPools_GetThreadID();
+	if(unlikely(tid >= stats->n)) return;
+
+	// histograms are allocated by the thread owning them
+	// the slot pointer is published for readers to observe
+	HdrHistogram *h = __atomic_load_n(stats->slots + tid, __ATOMIC_ACQUIRE);
+	if(unlikely(h == NULL)) {
+		h = rm_calloc(LatencyMetric_COUNT, sizeof(HdrHistogram));
+		__atomic_store_n(stats->slots + tid, h, __ATOMIC_RELEASE);
+	}
+
+	double total = 0;
+	for(int i = 0; i < QueryTrace_COUNT; i++) total += trace->durations[i];
+
+	HdrHistogram_Record(h + LatencyMetric_TOTAL, _ms_to_us(total));
+	HdrHistogram_Record(h + LatencyMetric_QUEUE,
+			_ms_to_us(trace->durations[QueryTrace_QUEUE]));
+	HdrHistogram_Record(h + LatencyMetric_LOCK,
+			_ms_to_us(trace->durations[QueryTrace_LOCK]));
+	HdrHistogram_Record(h + LatencyMetric_REPLY,
+			_ms_to_us(trace->durations[QueryTrace_REPLY]));
+}
+
+void LatencyStats_Get
+(
+	LatencyStats stats,    // latency stats
+	LatencyMetric metric,  // metric to get
+	HdrHistogram *h        // [output] merged histogram
+) {
+	ASSERT(h      != NULL);
+	ASSERT(stats  != NULL);
+	ASSERT(metric < LatencyMetric_COUNT);
+
+	memset(h, 0, sizeof(HdrHistogram));
+
+	for(uint i = 0; i < stats->n; i++) {
+		HdrHistogram *slot = __atomic_load_n(stats->slots + i, __ATOMIC_ACQUIRE);
+		if(slot != NULL) HdrHistogram_Merge(h, slot + metric);
+	}
+}
+
+void LatencyStats_Reset
+(
+	LatencyStats stats  // latency stats
+) {
+	ASSERT(stats != NULL);
+
+	// slots are kept, their owning threads might be recording
+	for(uint i = 0; i < stats->n; i++) {
+		HdrHistogram *slot = __atomic_load_n(stats->slots + i, __ATOMIC_ACQUIRE);
+		if(slot == NULL) continue;
+
+		for(int j = 0; j < LatencyMetric_COUNT; j++) {
+			HdrHistogram_Reset(slot + j);
+		}
+	}
+}
+
+const char *LatencyStats_MetricName
+(
+	LatencyMetric metric  // metric
+) {
+	ASSERT(metric < LatencyMetric_COUNT);
+	return _metric_names[metric];
+}
+
+void LatencyStats_Free
+(
+	LatencyStats stats  // latency stats
+) {
+	ASSERT(stats != NULL);
+
+	for(uint i = 0; i < stats->n; i++) {
+		if(stats->slots[i] != NULL) rm_free(stats->slots[i]);
+	}
+
+	rm_free(stats->slots);
+	rm_free(stats);
+}
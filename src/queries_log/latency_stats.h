@@ -0,0 +1,60 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "query_trace.h"
+#include "../util/hdr_histogram.h"
+
+// latency metrics tracked per query
+typedef enum {
+	LatencyMetric_TOTAL = 0,  // query latency, from receipt to reply
+	LatencyMetric_QUEUE,      // time waiting for a worker thread
+	LatencyMetric_LOCK,       // time waiting for the graph lock
+	LatencyMetric_REPLY,      // time spent formatting and emitting the reply
+	LatencyMetric_COUNT       // number of metrics
+} LatencyMetric;
+
+// forward declaration of opaque LatencyStats structure
+// holds a histogram per metric for each thread
+// threads record into their own histograms, histograms are merged on read
+typedef struct _LatencyStats *LatencyStats;
+
+// create a new latency stats structure
+LatencyStats LatencyStats_New(void);
+
+// record a finished query's latencies into the calling thread's histograms
+void LatencyStats_Record
+(
+	LatencyStats stats,       // latency stats
+	const QueryTrace *trace   // closed query trace
+);
+
+// merge all threads' histograms of metric into h
+void LatencyStats_Get
+(
+	LatencyStats stats,    // latency stats
+	LatencyMetric metric,  // metric to get
+	HdrHistogram *h        // [output] merged histogram
+);
+
+// clear all histograms
+void LatencyStats_Reset
+(
+	LatencyStats stats  // latency stats
+);
+
+// returns metric name
+const char *LatencyStats_MetricName
+(
+	LatencyMetric metric  // metric
+);
+
+// free latency stats
+void LatencyStats_Free
+(
+	LatencyStats stats  // latency stats
+);
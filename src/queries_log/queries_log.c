@@ -9,6 +9,7 @@
 #include "util/rmalloc.h"
 #include "configuration/config.h"
 
+#include <string.h>
 #include <pthread.h>
 #include <stdatomic.h>
 
@@ -64,6 +65,7 @@ void QueriesLog_AddQuery
 	bool utilized_cache,          // utilized cache
 	bool write,    	   	          // write query
 	bool timeout,    		      // timeout query
+	const double *stage_durations,  // [optional] time spent in each stage
 	const char *query             // query string
 ) {
 	// add query stats to buffer
@@ -93,6 +95,13 @@ void QueriesLog_AddQuery
 	q->utilized_cache     = utilized_cache;
 	q->query              = rm_strdup(query);
 
+	if(stage_durations != NULL) {
+		memcpy(q->stage_durations, stage_durations,
+				sizeof(q->stage_durations));
+	} else {
+		memset(q->stage_durations, 0, sizeof(q->stage_durations));
+	}
+
 	res = pthread_rwlock_unlock(&log->rwlock);
 	ASSERT(res == 0);
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "query_trace.h"
 #include "../util/circular_buffer.h"
 
 // query statistics
@@ -18,6 +19,7 @@ typedef struct QueryStats {
 	bool utilized_cache;        // utilized cache
 	bool write;    		        // write query
 	bool timeout;    		    // timeout query
+	double stage_durations[QueryTrace_COUNT];  // time spent in each stage
 	char *query;                // query string
 } LoggedQuery;
 
@@ -39,6 +41,7 @@ void QueriesLog_AddQuery
 	bool utilized_cache,        // utilized cache
 	bool write,    		        // write query
 	bool timeout,    		    // timeout query
+	const double *stage_durations,  // [optional] time spent in each stage
 	const char *query           // query string
 );
 
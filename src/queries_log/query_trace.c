@@ -0,0 +1,100 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "query_trace.h"
+
+#include <string.h>
+
+// stage names
+static const char *_stage_names[QueryTrace_COUNT] = {
+	[QueryTrace_QUEUE]     = "Queue",
+	[QueryTrace_PARSE]     = "Parse",
+	[QueryTrace_VALIDATE]  = "Validate",
+	[QueryTrace_CACHE]     = "Cache lookup",
+	[QueryTrace_PLAN]      = "Plan",
+	[QueryTrace_LOCK]      = "Lock wait",
+	[QueryTrace_EXECUTE]   = "Execute",
+	[QueryTrace_COMMIT]    = "Commit",
+	[QueryTrace_REPLICATE] = "Replicate",
+	[QueryTrace_REPLY]     = "Reply",
+};
+
+// module wide stage histograms, durations in microseconds
+// updated concurrently by all query executing threads
+static HdrHistogram _histograms[QueryTrace_COUNT];
+
+void QueryTrace_Init
+(
+	QueryTrace *trace,          // trace to initialize
+	const simple_timer_t timer  // time the query was received
+) {
+	ASSERT(trace != NULL);
+
+	memset(trace->durations, 0, sizeof(trace->durations));
+	trace->stage   = QueryTrace_QUEUE;
+	trace->entered = 1 << QueryTrace_QUEUE;
+	simple_timer_copy(timer, trace->timer);
+}
+
+QueryTraceStage QueryTrace_Enter
+(
+	QueryTrace *trace,      // trace to update
+	QueryTraceStage stage   // stage to enter
+) {
+	ASSERT(trace != NULL);
+	ASSERT(stage < QueryTrace_COUNT);
+
+	QueryTraceStage prev = trace->stage;
+
+	trace->durations[prev] += TIMER_GET_ELAPSED_MILLISECONDS(trace->timer);
+	trace->stage    = stage;
+	trace->entered |= 1 << stage;
+	simple_tic(trace->timer);
+
+	return prev;
+}
+
+void QueryTrace_Close
+(
+	QueryTrace *trace  // trace to close
+) {
+	ASSERT(trace != NULL);
+
+	QueryTrace_Enter(trace, trace->stage);
+
+	// stages the query never went through aren't recorded
+	for(int i = 0; i < QueryTrace_COUNT; i++) {
+		if(!(trace->entered & (1 << i))) continue;
+		HdrHistogram_Record(_histograms + i, trace->durations[i] * 1000);
+	}
+}
+
+const char *QueryTrace_StageName
+(
+	QueryTraceStage stage  // stage
+) {
+	ASSERT(stage < QueryTrace_COUNT);
+	return _stage_names[stage];
+}
+
+void QueryTrace_GetHistogram
+(
+	QueryTraceStage stage,  // stage
+	HdrHistogram *h         // [output] histogram
+) {
+	ASSERT(h != NULL);
+	ASSERT(stage < QueryTrace_COUNT);
+
+	memset(h, 0, sizeof(HdrHistogram));
+	HdrHistogram_Merge(h, _histograms + stage);
+}
+
+void QueryTrace_ResetHistograms(void) {
+	for(int i = 0; i < QueryTrace_COUNT; i++) {
+		HdrHistogram_Reset(_histograms + i);
+	}
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../util/simple_timer.h"
+#include "../util/hdr_histogram.h"
+
+#include <stdint.h>
+
+// query lifecycle stages
+// a query's wall time is split between these stages
+// each trace point ends the current stage and enters a new one
+typedef enum {
+	QueryTrace_QUEUE = 0,  // waiting for a worker thread
+	QueryTrace_PARSE,      // parsing query and parameters
+	QueryTrace_VALIDATE,   // AST validation and rewrites
+	QueryTrace_CACHE,      // execution-plan cache lookup
+	QueryTrace_PLAN,       // execution-plan construction and optimization
+	QueryTrace_LOCK,       // waiting for the graph lock or the GIL
+	QueryTrace_EXECUTE,    // executing the plan
+	QueryTrace_COMMIT,     // rollback, index changes and lock release
+	QueryTrace_REPLICATE,  // computing and replicating effects
+	QueryTrace_REPLY,      // formatting and emitting the reply
+	QueryTrace_COUNT       // number of stages
+} QueryTraceStage;
+
+// query trace
+typedef struct {
+	simple_timer_t timer;                // time of the last trace point
+	QueryTraceStage stage;               // current stage
+	uint32_t entered;                    // bitmask of entered stages
+	double durations[QueryTrace_COUNT];  // time spent in each stage in ms
+} QueryTrace;
+
+// initialize trace, the trace starts at the queue stage
+void QueryTrace_Init
+(
+	QueryTrace *trace,          // trace to initialize
+	const simple_timer_t timer  // time the query was received
+);
+
+// charge the time passed since the last trace point to the current stage
+// and enter a new stage
+// returns the stage the trace was in
+QueryTraceStage QueryTrace_Enter
+(
+	QueryTrace *trace,      // trace to update
+	QueryTraceStage stage   // stage to enter
+);
+
+// charge the time passed since the last trace point to the current stage
+// and record the durations of the entered stages in the stage histograms
+void QueryTrace_Close
+(
+	QueryTrace *trace  // trace to close
+);
+
+// returns stage name
+const char *QueryTrace_StageName
+(
+	QueryTraceStage stage  // stage
+);
+
+// get a snapshot of a stage histogram
+// durations are recorded in microseconds
+void QueryTrace_GetHistogram
+(
+	QueryTraceStage stage,  // stage
+	HdrHistogram *h         // [output] histogram
+);
+
+// clear all stage histograms
+void QueryTrace_ResetHistograms(void);
@@ -11,6 +11,7 @@
 #include "arithmetic/arithmetic_expression.h"
 #include "serializers/graphcontext_type.h"
 #include "undo_log/undo_log.h"
+#include "commands/commands.h"
 
 // GraphContext type as it is registered at Redis
 extern RedisModuleType *GraphContextRedisModuleType;
@@ -27,6 +28,7 @@ static inline QueryCtx *_QueryCtx_GetCreateCtx(void) {
 
 		// created lazily only when needed
 		ctx->undo_log       = NULL;
+		ctx->index_changes  = NULL;
 		ctx->effects_buffer = NULL;
 		ctx->stage          = QueryStage_WAITING;  // initial query stage
 
@@ -99,6 +101,24 @@ static void _QueryCtx_UpdateStageDuration
 	ctx->stats.durations[ctx->stage] += _QueryCtx_GetCountedMilliseconds(ctx);
 }
 
+// record query's latencies into its graph and command histograms
+static void _QueryCtx_RecordLatency
+(
+	QueryCtx *ctx,            // query context
+	const QueryTrace *trace   // closed query trace
+) {
+	ASSERT(ctx   != NULL);
+	ASSERT(trace != NULL);
+
+	if(ctx->gc->latency_stats != NULL) {
+		LatencyStats_Record(ctx->gc->latency_stats, trace);
+	}
+
+	GRAPH_Commands cmd = CommandFromString(ctx->global_exec_ctx.command_name);
+	LatencyStats stats = Commands_GetLatencyStats(cmd);
+	if(stats != NULL) LatencyStats_Record(stats, trace);
+}
+
 // advance query's stage
 // waiting   -> executing
 // executing -> reporting
@@ -117,7 +137,13 @@ void QueryCtx_AdvanceStage
 	_QueryCtx_UpdateStageDuration(ctx);
 
 	if(ctx->stage == QueryStage_REPORTING) {
-		// done reporting, log query
+		// done reporting, close trace and log query
+		QueryTrace *trace = ctx->stats.trace;
+		if(trace != NULL) {
+			QueryTrace_Close(trace);
+			_QueryCtx_RecordLatency(ctx, trace);
+		}
+
 		GraphContext_LogQuery(ctx->gc,
 				ctx->stats.received_ts,
 				ctx->stats.durations[QueryStage_WAITING],
@@ -127,6 +153,7 @@ void QueryCtx_AdvanceStage
 				ctx->stats.utilized_cache,
 				ctx->flags & QueryExecutionTypeFlag_WRITE,
 				ctx->status == QueryExecutionStatus_TIMEDOUT,
+				(trace != NULL) ? trace->durations : NULL,
 				ctx->query_data.query);
 	}
 
@@ -152,6 +179,17 @@ void QueryCtx_ResetStage
 	ctx->stage = QueryStage_WAITING;
 }
 
+// enter a new query lifecycle stage
+QueryTraceStage QueryCtx_Trace
+(
+	QueryTraceStage stage  // stage to enter
+) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(ctx == NULL || ctx->stats.trace == NULL) return stage;
+
+	return QueryTrace_Enter(ctx->stats.trace, stage);
+}
+
 // sets the "utilized_cache" flag of a QueryInfo
 void QueryCtx_SetUtilizedCache
 (
@@ -183,6 +221,9 @@ void QueryCtx_SetGlobalExecutionCtx
 
 	// received timestamp (epoch time)
 	ctx->stats.received_ts = cmd_ctx->received_ts;
+
+	// trace query's lifecycle
+	ctx->stats.trace = &cmd_ctx->trace;
 }
 
 // set the provided AST for access through the QueryCtx
@@ -271,6 +312,10 @@ void QueryCtx_Rollback(void) {
 
 	Graph_ResetReservedNode(ctx->gc->g);
 
+	// pending index changes were never applied, the undo-log restores
+	// the indices of changes which have already been applied
+	if(ctx->index_changes != NULL) IndexChanges_Clear(ctx->index_changes);
+
 	if(ctx->undo_log == NULL) return;
 	
 	UndoLog_Rollback(&ctx->undo_log);
@@ -288,6 +333,29 @@ EffectsBuffer *QueryCtx_GetEffectsBuffer(void) {
 	return ctx->effects_buffer;
 }
 
+// retrieve pending index changes buffer
+IndexChanges *QueryCtx_GetIndexChanges(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	if(ctx->index_changes == NULL) {
+		ctx->index_changes = IndexChanges_New();
+	}
+
+	return ctx->index_changes;
+}
+
+// apply pending index changes
+void QueryCtx_ApplyIndexChanges(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	if(ctx->index_changes == NULL) return;
+	if(IndexChanges_Count(ctx->index_changes) == 0) return;
+
+	IndexChanges_Apply(ctx->index_changes, ctx->gc);
+}
+
 // retrieve the Redis module context
 RedisModuleCtx *QueryCtx_GetRedisModuleCtx(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
@@ -346,6 +414,9 @@ bool QueryCtx_LockForCommit(void) {
 	QueryCtx *ctx = _QueryCtx_GetCreateCtx();
 	if(ctx->internal_exec_ctx.locked_for_commit) return true;
 
+	// account time spent waiting for the GIL and graph lock
+	QueryTraceStage stage = QueryCtx_Trace(QueryTrace_LOCK);
+
 	// lock GIL
 	RedisModuleCtx *redis_ctx = ctx->global_exec_ctx.redis_ctx;
 	GraphContext *gc = ctx->gc;
@@ -375,6 +446,8 @@ bool QueryCtx_LockForCommit(void) {
 	Graph_AcquireWriteLock(gc->g);
 	ctx->internal_exec_ctx.locked_for_commit = true;
 
+	QueryCtx_Trace(stage);
+
 	return true;
 
 clean_up:
@@ -384,6 +457,8 @@ clean_up:
 	// unlock GIL
 	_QueryCtx_ThreadSafeContextUnlock(ctx);
 
+	QueryCtx_Trace(stage);
+
 	// if there is a break point for runtime exception, raise it, otherwise return false
 	ErrorCtx_RaiseRuntimeException(NULL);
 	return false;
@@ -422,9 +497,55 @@ void QueryCtx_UnlockCommit() {
 	// already unlocked?
 	if(!ctx->internal_exec_ctx.locked_for_commit) return;
 
+	// apply any outstanding index changes while the graph is write locked
+	QueryCtx_ApplyIndexChanges();
+
+	_QueryCtx_UnlockCommit(ctx);
+}
+
+// commit modifications made so far, used by USING PERIODIC COMMIT
+void QueryCtx_CommitBatch(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	if(!ctx) return;
+
+	// nothing to commit
+	if(!ctx->internal_exec_ctx.locked_for_commit) return;
+
+	// apply any outstanding index changes while the graph is write locked
+	QueryCtx_ApplyIndexChanges();
+
+	// the query can't be replayed as a whole once a batch is committed
+	// replicate the batch's effects while the GIL is held
+	if(ctx->effects_buffer != NULL &&
+	   EffectsBuffer_Length(ctx->effects_buffer) > 0) {
+		size_t effects_len = 0;
+		unsigned char *effects = EffectsBuffer_Buffer(ctx->effects_buffer,
+				&effects_len);
+		ASSERT(effects_len > 0 && effects != NULL);
+
+		RedisModule_Replicate(ctx->global_exec_ctx.redis_ctx, "GRAPH.EFFECT",
+				"cb!", GraphContext_GetName(ctx->gc), effects, effects_len);
+		rm_free(effects);
+	}
+
+	// committed modifications can no longer be rolled back
+	UndoLog_Free(&ctx->undo_log);
+	EffectsBuffer_Free(ctx->effects_buffer);
+	ctx->effects_buffer = NULL;
+
+	ctx->internal_exec_ctx.committed_batch = true;
+
 	_QueryCtx_UnlockCommit(ctx);
 }
 
+// returns true if modifications were committed in batches
+bool QueryCtx_CommittedBatch(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	return ctx->internal_exec_ctx.committed_batch;
+}
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
@@ -455,6 +576,7 @@ void QueryCtx_Free(void) {
 	ASSERT(ctx != NULL);
 
 	UndoLog_Free(&ctx->undo_log);
+	IndexChanges_Free(&ctx->index_changes);
 	EffectsBuffer_Free(ctx->effects_buffer);
 
 	if(ctx->query_data.params != NULL) {
@@ -17,6 +17,7 @@
 #include "execution_plan/ops/op.h"
 #include "undo_log/undo_log.h"
 #include "effects/effects.h"
+#include "index/index_changes.h"
 #include <pthread.h>
 
 extern pthread_key_t _tlsQueryCtxKey;  // Thread local storage query context key.
@@ -58,6 +59,7 @@ typedef struct {
 	RedisModuleKey *key;     // graph open key, for later extraction and closing
 	ResultSet *result_set;   // execution result set
 	bool locked_for_commit;  // indicates if QueryCtx_LockForCommit been called
+	bool committed_batch;    // indicates if QueryCtx_CommitBatch been called
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
@@ -73,6 +75,7 @@ typedef struct {
 	double durations[3];   // stage durations
 	bool parameterized;    // uses parameters
 	bool utilized_cache;   // utilized cache
+	QueryTrace *trace;     // lifecycle trace, NULL if query isn't traced
 } QueryStats;
 
 typedef struct QueryCtx {
@@ -83,6 +86,7 @@ typedef struct QueryCtx {
 	QueryExecutionStatus status;                 // query execution status
 	QueryExecutionTypeFlag flags;                // execution flags
 	EffectsBuffer *effects_buffer;               // effects-buffer for replication, used when write query succeed and replication is needed
+	IndexChanges *index_changes;                 // pending index changes, applied once modifications are committed
 	QueryCtx_QueryData query_data;               // data related to the query syntax
 	QueryCtx_GlobalExecCtx global_exec_ctx;      // data related to global redis execution
 	QueryCtx_InternalExecCtx internal_exec_ctx;  // data related to internal query execution
@@ -123,6 +127,16 @@ void QueryCtx_ResetStage
 	QueryCtx *ctx  // query context
 );
 
+// enter a new query lifecycle stage
+// the time passed since the previous trace point is charged to the
+// stage the query was in
+// returns the stage the query was in
+// no-op if the calling thread isn't executing a traced query
+QueryTraceStage QueryCtx_Trace
+(
+	QueryTraceStage stage  // stage to enter
+);
+
 // sets the "utilized_cache" flag of a QueryInfo
 void QueryCtx_SetUtilizedCache
 (
@@ -189,6 +203,13 @@ void QueryCtx_Rollback(void);
 // retrieve effects-buffer
 EffectsBuffer *QueryCtx_GetEffectsBuffer(void);
 
+// retrieve pending index changes buffer
+IndexChanges *QueryCtx_GetIndexChanges(void);
+
+// apply pending index changes
+// expecting the graph to be locked for commit
+void QueryCtx_ApplyIndexChanges(void);
+
 // retrieve the Redis module context
 RedisModuleCtx *QueryCtx_GetRedisModuleCtx(void);
 
@@ -224,6 +245,19 @@ bool QueryCtx_LockForCommit(void);
 // 4. unlock GIL
 void QueryCtx_UnlockCommit(void);
 
+// commit modifications made so far, used by USING PERIODIC COMMIT
+// committed modifications are replicated as effects and can no longer be
+// rolled back, all locks are released until the next QueryCtx_LockForCommit
+// Commit flow:
+// 1. apply pending index changes
+// 2. replicate effects
+// 3. discard undo-log and effects
+// 4. unlock graph R/W lock, close key and unlock GIL
+void QueryCtx_CommitBatch(void);
+
+// returns true if modifications were committed in batches
+bool QueryCtx_CommittedBatch(void);
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
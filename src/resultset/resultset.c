@@ -28,6 +28,71 @@ static void _ResultSet_ReplyWithPreamble
 	}
 }
 
+// emit buffered rows and release them
+static void _ResultSet_EmitBufferedRows
+(
+	ResultSet *set
+) {
+	SIValue *row[set->column_count];
+	uint64_t cells = DataBlock_ItemCount(set->cells);
+	// for each row
+	for(uint64_t i = 0; i < cells; i += set->column_count) {
+		// for each column
+		for(uint j = 0; j < set->column_count; j++) {
+			row[j] = DataBlock_GetItem(set->cells, i + j);
+		}
+
+		set->formatter->EmitRow(set->ctx, set->gc, row, set->column_count);
+
+		// free emitted cells if resultset encountered a heap allocated value
+		if(set->cells_allocation & M_SELF) {
+			for(uint j = 0; j < set->column_count; j++) {
+				SIValue_Free(*row[j]);
+			}
+		}
+	}
+
+	DataBlock_Free(set->cells);
+	set->cells            = NULL;
+	set->cells_allocation = M_NONE;
+}
+
+// emit the header followed by all buffered rows
+// from this point on rows are emitted as they're added
+static void _ResultSet_StartStreaming
+(
+	ResultSet *set
+) {
+	ASSERT(set->stream    == true);
+	ASSERT(set->streaming == false);
+
+	_ResultSet_ReplyWithPreamble(set);
+
+	// number of rows is unknown until execution is done
+	RedisModule_ReplyWithArray(set->ctx, REDISMODULE_POSTPONED_LEN);
+	_ResultSet_EmitBufferedRows(set);
+
+	set->streaming = true;
+}
+
+// emit record's projected values directly, without buffering
+static void _ResultSet_EmitRecord
+(
+	ResultSet *set,  // resultset
+	Record r         // record containing projected data
+) {
+	SIValue values[set->column_count];
+	SIValue *row[set->column_count];
+
+	for(uint i = 0; i < set->column_count; i++) {
+		values[i] = Record_Get(r, set->columns_record_map[i]);
+		row[i]    = values + i;
+	}
+
+	// record retains ownership of its values
+	set->formatter->EmitRow(set->ctx, set->gc, row, set->column_count);
+}
+
 static void _ResultSet_SetColumns
 (
 	ResultSet *set
@@ -59,8 +124,10 @@ static void _ResultSet_SetColumns
 // create a new result set
 ResultSet *NewResultSet
 (
-	RedisModuleCtx *ctx,
-	ResultSetFormatterType format  // resultset format
+	RedisModuleCtx *ctx,              // redis context
+	ResultSetFormatterType format,    // resultset format
+	bool stream,                      // emit rows as they're produced
+	const atomic_bool *disconnected   // [optional] set once client disconnects
 ) {
 	ResultSet *set = rm_malloc(sizeof(ResultSet));
 
@@ -70,7 +137,10 @@ ResultSet *NewResultSet
 	set->format              =  format;
 	set->columns             =  NULL;
 	set->formatter           =  ResultSetFormatter_GetFormatter(format);
+	set->row_count           =  0;
+	set->streaming           =  false;
 	set->column_count        =  0;
+	set->disconnected        =  disconnected;
 	set->cells_allocation    =  M_NONE;
 	set->columns_record_map  =  NULL;
 
@@ -90,6 +160,9 @@ ResultSet *NewResultSet
 		set->cells = DataBlock_New(16384, nrows, sizeof(SIValue), NULL);
 	}
 
+	// only a result-set with columns has rows to stream
+	set->stream = stream && set->column_count > 0;
+
 	return set;
 }
 
@@ -124,7 +197,7 @@ uint64_t ResultSet_RowCount
 	ASSERT(set != NULL);
 
 	if(set->column_count == 0) return 0;
-	return DataBlock_ItemCount(set->cells) / set->column_count;
+	return set->row_count;
 }
 
 // add a new row to resultset
@@ -136,6 +209,19 @@ int ResultSet_AddRecord
 	ASSERT(r   != NULL);
 	ASSERT(set != NULL);
 
+	// stop producing rows once the client is gone
+	if(set->disconnected != NULL &&
+	   atomic_load_explicit(set->disconnected, memory_order_relaxed)) {
+		return RESULTSET_FULL;
+	}
+
+	set->row_count++;
+
+	if(set->streaming) {
+		_ResultSet_EmitRecord(set, r);
+		return RESULTSET_OK;
+	}
+
 	// copy projected values from record to resultset
 	for(int i = 0; i < set->column_count; i++) {
 		int idx = set->columns_record_map[i];
@@ -153,6 +239,11 @@ int ResultSet_AddRecord
 		Record_Remove(r, idx);
 	}
 
+	// result-set is large enough to start streaming
+	if(set->stream && set->row_count >= RESULTSET_STREAM_THRESHOLD) {
+		_ResultSet_StartStreaming(set);
+	}
+
 	return RESULTSET_OK;
 }
 
@@ -230,6 +321,20 @@ void ResultSet_Reply
 
 	uint64_t row_count = ResultSet_RowCount(set);
 
+	if(set->streaming) {
+		// header and rows were already emitted, complete the rows array
+		RedisModule_ReplySetArrayLength(set->ctx, row_count);
+
+		// an error encountered after streaming started
+		// takes the place of the statistics
+		if(ErrorCtx_EncounteredError()) {
+			ErrorCtx_EmitException();
+		} else {
+			ResultSetStat_emit(set->ctx, &set->stats);
+		}
+		return;
+	}
+
 	// check to see if we've encountered a run-time error
 	// if so, emit it as the only response
 	if(ErrorCtx_EncounteredError()) {
@@ -243,17 +348,7 @@ void ResultSet_Reply
 	// emit resultset
 	if(set->column_count > 0) {
 		RedisModule_ReplyWithArray(set->ctx, row_count);
-		SIValue *row[set->column_count];
-		uint64_t cells = DataBlock_ItemCount(set->cells);
-		// for each row
-		for(uint64_t i = 0; i < cells; i += set->column_count) {
-			// for each column
-			for(uint j = 0; j < set->column_count; j++) {
-				row[j] = DataBlock_GetItem(set->cells, i + j);
-			}
-
-			set->formatter->EmitRow(set->ctx, set->gc, row, set->column_count);
-		}
+		_ResultSet_EmitBufferedRows(set);
 	}
 
 	ResultSetStat_emit(set->ctx, &set->stats); // response with statistics
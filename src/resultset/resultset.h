@@ -12,9 +12,16 @@
 #include "rax.h"
 #include "./formatters/resultset_formatters.h"
 
+#include <stdatomic.h>
+
 #define RESULTSET_OK 1
 #define RESULTSET_FULL 0
 
+// number of rows buffered before a streaming result-set starts emitting rows
+// smaller result-sets are replied at once, such that an error encountered
+// during execution replaces the entire reply
+#define RESULTSET_STREAM_THRESHOLD 1024
+
 typedef struct {
 	RedisModuleCtx *ctx;            // redis context
 	GraphContext *gc;               // context used for mapping attribute strings and IDs
@@ -27,6 +34,10 @@ typedef struct {
 	ResultSetFormatterType format;  // result set format; compact/verbose/nop
 	ResultSetFormatter *formatter;  // result set data formatter
 	SIAllocation cells_allocation;  // encountered values allocation
+	uint64_t row_count;             // number of rows in result set
+	bool stream;                    // emit rows as they're produced
+	bool streaming;                 // header and buffered rows were emitted
+	const atomic_bool *disconnected;  // set once the client disconnects
 } ResultSet;
 
 // map each column to a record index
@@ -39,10 +50,14 @@ void ResultSet_MapProjection
 );
 
 // create a new result set
+// a streaming result-set emits its rows as they're produced
+// once more than RESULTSET_STREAM_THRESHOLD rows were added
 ResultSet *NewResultSet
 (
-	RedisModuleCtx *ctx,
-	ResultSetFormatterType format  // resultset format
+	RedisModuleCtx *ctx,              // redis context
+	ResultSetFormatterType format,    // resultset format
+	bool stream,                      // emit rows as they're produced
+	const atomic_bool *disconnected   // [optional] set once client disconnects
 );
 
 // returns number of rows in result-set
@@ -52,6 +67,8 @@ uint64_t ResultSet_RowCount
 );
 
 // add a new row to resultset
+// returns RESULTSET_FULL if no more rows should be added
+// as the client has disconnected
 int ResultSet_AddRecord
 (
 	ResultSet *set,  // resultset to extend
@@ -93,6 +110,8 @@ void ResultSet_CachedExecution
 );
 
 // flush resultset to network
+// for a streaming result-set which already emitted rows, this completes
+// the reply with either the statistics or the encountered error
 void ResultSet_Reply
 (
 	ResultSet *set  // resultset to reply with
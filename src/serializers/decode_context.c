@@ -16,6 +16,7 @@ GraphDecodeContext *GraphDecodeContext_New() {
 	ctx->graph_keys_count = 1;
 	ctx->meta_keys = raxNew();
 	ctx->multi_edge = NULL;
+	ctx->pending = ATOMIC_VAR_INIT(1);
 	return ctx;
 }
 
@@ -24,6 +25,7 @@ void GraphDecodeContext_Reset(GraphDecodeContext *ctx) {
 
 	ctx->keys_processed    =  0;
 	ctx->graph_keys_count  =  1;
+	ctx->pending           =  1;
 
 	if(ctx->multi_edge) {
 		array_free(ctx->multi_edge);
@@ -73,6 +75,17 @@ bool GraphDecodeContext_GetProcessedKeyCount(const GraphDecodeContext *ctx) {
 	return ctx->keys_processed;
 }
 
+void GraphDecodeContext_AddPendingTask(GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+	atomic_fetch_add(&ctx->pending, 1);
+}
+
+bool GraphDecodeContext_CompletePendingTask(GraphDecodeContext *ctx) {
+	ASSERT(ctx);
+	ASSERT(ctx->pending > 0);
+	return atomic_fetch_sub(&ctx->pending, 1) == 1;
+}
+
 void GraphDecodeContext_Free(GraphDecodeContext *ctx) {
 	if(ctx) {
 		raxFree(ctx->meta_keys);
@@ -9,6 +9,7 @@
 #include "stdlib.h"
 #include "stdbool.h"
 #include "stdint.h"
+#include "stdatomic.h"
 #include "rax.h"
 
 // A struct that maintains the state of a graph decoding from RDB.
@@ -17,6 +18,7 @@ typedef struct {
 	uint64_t graph_keys_count;  // The number of keys representing the graph.
 	rax *meta_keys;             // The meta keys encountered so far in the decode process.
 	uint64_t *multi_edge;       // Is relation contains multi edge values.
+	uint64_t _Atomic pending;   // Number of pending decode tasks, +1 until all keys are read.
 } GraphDecodeContext;
 
 // Creates a new graph decoding context.
@@ -49,5 +51,13 @@ void GraphDecodeContext_IncreaseProcessedKeyCount(GraphDecodeContext *ctx);
 // Returns the number of processed keys.
 bool GraphDecodeContext_GetProcessedKeyCount(const GraphDecodeContext *ctx);
 
+// Registers a decode task scheduled for the graph.
+void GraphDecodeContext_AddPendingTask(GraphDecodeContext *ctx);
+
+// Marks a pending decode task as completed, the last key read counts as a task.
+// Returns true if no decode task remains pending, in which case the graph
+// can be finalized.
+bool GraphDecodeContext_CompletePendingTask(GraphDecodeContext *ctx);
+
 // Free graph decoding context.
 void GraphDecodeContext_Free(GraphDecodeContext *ctx);
@@ -0,0 +1,62 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "decode_pool.h"
+#include "../util/rmalloc.h"
+#include "../util/thpool/pools.h"
+
+#include <pthread.h>
+
+// scheduled decode task
+typedef struct {
+	void (*task)(void *);  // task to run
+	void *arg;             // task argument
+} DecodePoolTask;
+
+static uint64_t _pending = 0;  // number of scheduled decode tasks
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  _done = PTHREAD_COND_INITIALIZER;
+
+static void _DecodePool_RunTask
+(
+	void *arg
+) {
+	DecodePoolTask *t = (DecodePoolTask *)arg;
+
+	t->task(t->arg);
+	rm_free(t);
+
+	pthread_mutex_lock(&_lock);
+	if(--_pending == 0) pthread_cond_broadcast(&_done);
+	pthread_mutex_unlock(&_lock);
+}
+
+void DecodePool_AddTask
+(
+	void (*task)(void *),
+	void *arg
+) {
+	ASSERT(task != NULL);
+
+	DecodePoolTask *t = rm_malloc(sizeof(DecodePoolTask));
+	t->arg  = arg;
+	t->task = task;
+
+	pthread_mutex_lock(&_lock);
+	_pending++;
+	pthread_mutex_unlock(&_lock);
+
+	int res = ThreadPools_AddWorkWorker(_DecodePool_RunTask, t);
+	ASSERT(res == 0);
+	UNUSED(res);
+}
+
+void DecodePool_Wait(void) {
+	pthread_mutex_lock(&_lock);
+	while(_pending > 0) pthread_cond_wait(&_done, &_lock);
+	pthread_mutex_unlock(&_lock);
+}
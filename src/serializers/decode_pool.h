@@ -0,0 +1,26 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// decode pool
+//
+// while loading an RDB, Redis main thread performs the RDB reads
+// and hands the decoded payloads over to the shared workers thread pool
+// which constructs attribute-sets and matrices and finalizes graphs
+//
+// the pool only tracks scheduled decode tasks, it is only accessed from
+// Redis main thread
+
+// schedule a decode task
+void DecodePool_AddTask
+(
+	void (*task)(void *),  // task to run
+	void *arg              // task argument
+);
+
+// wait for all scheduled decode tasks to complete
+void DecodePool_Wait(void);
@@ -0,0 +1,393 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+#include "../../../decode_pool.h"
+#include "../../../../index/indexer.h"
+
+static GraphContext *_GetOrCreateGraphContext
+(
+	char *graph_name
+) {
+	GraphContext *gc = GraphContext_UnsafeGetGraphContext(graph_name);
+	if(gc == NULL) {
+		// new graph is being decoded
+		// inform the module and create new graph context
+		gc = GraphContext_New(graph_name);
+		// while loading the graph
+		// minimize matrix realloc and synchronization calls
+		Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_RESIZE);
+	}
+
+	// free the name string, as it either not in used or copied
+	RedisModule_Free(graph_name);
+
+	return gc;
+}
+
+// the first initialization of the graph data structure guarantees that
+// there will be no further re-allocation of data blocks and matrices
+// since they are all in the appropriate size
+static void _InitGraphDataStructure
+(
+	Graph *g,
+	uint64_t node_count,
+	uint64_t edge_count,
+	uint64_t deleted_node_count,
+	uint64_t deleted_edge_count,
+	uint64_t label_count,
+	uint64_t relation_count
+) {
+	Graph_AllocateNodes(g, node_count + deleted_node_count);
+	Graph_AllocateEdges(g, edge_count + deleted_edge_count);
+	for(uint64_t i = 0; i < label_count; i++) Graph_AddLabel(g);
+	for(uint64_t i = 0; i < relation_count; i++) Graph_AddRelationType(g);
+	// flush all matrices
+	// guarantee matrix dimensions matches graph's nodes count
+	Graph_ApplyAllPending(g, true);
+}
+
+static GraphContext *_DecodeHeader
+(
+	RedisModuleIO *rdb
+) {
+	// Header format:
+	// Graph name
+	// Node count
+	// Edge count
+	// Deleted node count
+	// Deleted edge count
+	// Label matrix count
+	// Relation matrix count - N
+	// Does relationship matrix Ri holds mutiple edges under a single entry X N
+	// Number of graph keys (graph context key + meta keys)
+	// Schema
+
+	// graph name
+	char *graph_name = RedisModule_LoadStringBuffer(rdb, NULL);
+
+	// each key header contains the following:
+	// #nodes, #edges, #deleted nodes, #deleted edges, #labels matrices, #relation matrices
+	uint64_t  node_count          =  RedisModule_LoadUnsigned(rdb);
+	uint64_t  edge_count          =  RedisModule_LoadUnsigned(rdb);
+	uint64_t  deleted_node_count  =  RedisModule_LoadUnsigned(rdb);
+	uint64_t  deleted_edge_count  =  RedisModule_LoadUnsigned(rdb);
+	uint64_t  label_count         =  RedisModule_LoadUnsigned(rdb);
+	uint64_t  relation_count      =  RedisModule_LoadUnsigned(rdb);
+	uint64_t  multi_edge[relation_count];
+
+	for(uint i = 0; i < relation_count; i++) {
+		multi_edge[i] = RedisModule_LoadUnsigned(rdb);
+	}
+
+	// total keys representing the graph
+	uint64_t key_number = RedisModule_LoadUnsigned(rdb);
+
+	GraphContext *gc = _GetOrCreateGraphContext(graph_name);
+	Graph *g = gc->g;
+
+	// if it is the first key of this graph,
+	// allocate all the data structures, with the appropriate dimensions
+	bool first_vkey =
+		GraphDecodeContext_GetProcessedKeyCount(gc->decoding_context) == 0;
+
+	if(first_vkey == true) {
+		_InitGraphDataStructure(gc->g, node_count, edge_count,
+			deleted_node_count, deleted_edge_count, label_count, relation_count);
+
+		gc->decoding_context->multi_edge = array_new(uint64_t, relation_count);
+		for(uint i = 0; i < relation_count; i++) {
+			// enable/Disable support for multi-edge
+			// we will enable support for multi-edge on all relationship
+			// matrices once we finish loading the graph
+			array_append(gc->decoding_context->multi_edge,  multi_edge[i]);
+		}
+
+		GraphDecodeContext_SetKeyCount(gc->decoding_context, key_number);
+	}
+
+	// decode graph schemas
+	RdbLoadGraphSchema_v14(rdb, gc, !first_vkey);
+
+	return gc;
+}
+
+// populate schema's pending indices in a single pass and enable them
+static void _EnablePendingIndices
+(
+	Schema *s,
+	Graph *g
+) {
+	ASSERT(s != NULL);
+
+	uint  n = 0;
+	Index indices[3];
+
+	// number of nodes carrying the schema's label
+	// restored index structures may not hold more entities
+	GrB_Index nvals = 0;
+	if(Schema_GetType(s) == SCHEMA_NODE) {
+		RG_Matrix_nvals(&nvals, Graph_GetLabelMatrix(g, Schema_GetID(s)));
+	}
+
+	// exact-match ordered indices are restored from the RDB
+	// their RediSearch documents and covered attributes are repopulated
+	// ordered indices are rebuilt as well if any of them failed to restore
+	// or holds unknown nodes
+	Index exact = PENDING_EXACTMATCH_IDX(s);
+	if(exact != NULL) {
+		Index_KeepRestoredOrdered(exact, nvals);
+		indices[n++] = exact;
+	}
+
+	if(PENDING_FULLTEXT_IDX(s) != NULL) indices[n++] = PENDING_FULLTEXT_IDX(s);
+
+	// vector index contents are restored from the RDB
+	// the index is only repopulated if its restoration failed
+	bool  restored = false;
+	Index vector   = PENDING_VECTOR_IDX(s);
+	if(vector != NULL) {
+		HNSW *hnsw = Index_HNSW(vector);
+
+		// every indexed node must carry the indexed label
+		if(HNSW_Size(hnsw) > nvals) {
+			RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+					"Vector index over label %s holds unknown nodes, repopulating",
+					Schema_GetName(s));
+
+			const VectorIndexOptions *opts = Index_GetVectorOptions(vector);
+			hnsw = HNSW_New(opts->dimension, opts->similarity, opts->M,
+					opts->ef_construction);
+			Index_SetHNSW(vector, hnsw);
+		}
+
+		restored = HNSW_Size(hnsw) > 0;
+		if(!restored) indices[n++] = vector;
+	}
+
+	if(n > 0) Index_PopulateIndices(indices, n, g);
+
+	for(uint i = 0; i < n; i++) {
+		Index_Enable(indices[i]);
+		Schema_ActivateIndex(s, indices[i]);
+	}
+
+	if(restored) {
+		Index_Enable(vector);
+		Schema_ActivateIndex(s, vector);
+	}
+}
+
+// finalize a fully decoded graph
+// called once all of the graph's keys are read
+// and all of its decode tasks are completed
+static void _FinalizeGraph
+(
+	void *arg
+) {
+	GraphContext *gc = (GraphContext *)arg;
+	Graph *g = gc->g;
+
+	// set the node label matrix
+	Serializer_Graph_SetNodeLabels(g);
+
+	// set the adjacency matrix
+	Serializer_Graph_SetAdjacencyMatrix(g);
+
+	// flush graph matrices
+	Graph_ApplyAllPending(g, true);
+
+	// revert to default synchronization behavior
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
+
+	uint rel_count   = Graph_RelationTypeCount(g);
+	uint label_count = Graph_LabelTypeCount(g);
+
+	// update the node statistics
+	for(uint i = 0; i < label_count; i++) {
+		GrB_Index nvals;
+		RG_Matrix L = Graph_GetLabelMatrix(g, i);
+		RG_Matrix_nvals(&nvals, L);
+		GraphStatistics_IncNodeCount(&g->stats, i, nvals);
+	}
+
+	// populate and enable all indices
+	// entities are indexed in bulk once the graph is fully loaded
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		_EnablePendingIndices(s, g);
+	}
+
+	for(uint i = 0; i < rel_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_EDGE);
+		_EnablePendingIndices(s, g);
+	}
+
+	// make sure graph doesn't contains may pending changes
+	ASSERT(Graph_Pending(g) == false);
+
+	GraphDecodeContext_Reset(gc->decoding_context);
+
+	RedisModule_Log(NULL, "notice", "Done decoding graph %s", gc->graph_name);
+}
+
+// decode task wrapper
+typedef struct {
+	GraphContext *gc;      // graph the task decodes
+	void (*task)(void *);  // task to run
+	void *arg;             // task argument
+} DecodeTask;
+
+static void _RunDecodeTask
+(
+	void *arg
+) {
+	DecodeTask   *t  = (DecodeTask *)arg;
+	GraphContext *gc = t->gc;
+
+	t->task(t->arg);
+	rm_free(t);
+
+	// the last task to complete finalizes the graph
+	if(GraphDecodeContext_CompletePendingTask(gc->decoding_context)) {
+		_FinalizeGraph(gc);
+	}
+}
+
+void RdbAddDecodeTask_v14
+(
+	GraphContext *gc,
+	void (*task)(void *),
+	void *arg
+) {
+	DecodeTask *t = rm_malloc(sizeof(DecodeTask));
+
+	t->gc   = gc;
+	t->arg  = arg;
+	t->task = task;
+
+	GraphDecodeContext_AddPendingTask(gc->decoding_context);
+	DecodePool_AddTask(_RunDecodeTask, t);
+}
+
+static PayloadInfo *_RdbLoadKeySchema
+(
+	RedisModuleIO *rdb
+) {
+	// Format:
+	// #Number of payloads info - N
+	// N * Payload info:
+	//     Encode state
+	//     Number of entities encoded in this state.
+
+	uint64_t payloads_count = RedisModule_LoadUnsigned(rdb);
+	PayloadInfo *payloads = array_new(PayloadInfo, payloads_count);
+
+	for(uint i = 0; i < payloads_count; i++) {
+		// for each payload
+		// load its type and the number of entities it contains
+		PayloadInfo payload_info;
+		payload_info.state =  RedisModule_LoadUnsigned(rdb);
+		payload_info.entities_count =  RedisModule_LoadUnsigned(rdb);
+		array_append(payloads, payload_info);
+	}
+	return payloads;
+}
+
+GraphContext *RdbLoadGraphContext_v14
+(
+	RedisModuleIO *rdb
+) {
+
+	// Key format:
+	//  Header
+	//  Payload(s) count: N
+	//  Key content X N:
+	//      Payload type (Nodes / Edges / Deleted nodes/ Deleted edges/ Graph schema / Matrices / Indices)
+	//      Entities in payload
+	//  Payload(s) X N
+
+	GraphContext *gc = _DecodeHeader(rdb);
+
+	// load the key schema
+	PayloadInfo *key_schema = _RdbLoadKeySchema(rdb);
+
+	// The decode process contains the decode operation of many meta keys, representing independent parts of the graph
+	// Each key contains data on one or more of the following:
+	// 1. Nodes - The nodes that are currently valid in the graph
+	// 2. Deleted nodes - Nodes that were deleted and there ids can be re-used. Used for exact replication of data block state
+	// 3. Edges - The edges that are currently valid in the graph
+	// 4. Deleted edges - Edges that were deleted and there ids can be re-used. Used for exact replication of data block state
+	// 5. Graph schema - Properties, indices
+	// 6. Matrices - Label and relation matrices
+	// 7. Indices - Vector index contents
+	// The following switch checks which part of the graph the current key holds, and decodes it accordingly
+	uint payloads_count = array_len(key_schema);
+	for(uint i = 0; i < payloads_count; i++) {
+		PayloadInfo payload = key_schema[i];
+		switch(payload.state) {
+			case ENCODE_STATE_NODES:
+				Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+				RdbLoadNodes_v14(rdb, gc, payload.entities_count);
+				break;
+			case ENCODE_STATE_DELETED_NODES:
+				RdbLoadDeletedNodes_v14(rdb, gc, payload.entities_count);
+				break;
+			case ENCODE_STATE_EDGES:
+				Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+				RdbLoadEdges_v14(rdb, gc, payload.entities_count);
+				break;
+			case ENCODE_STATE_DELETED_EDGES:
+				RdbLoadDeletedEdges_v14(rdb, gc, payload.entities_count);
+				break;
+			case ENCODE_STATE_GRAPH_SCHEMA:
+				// skip, handled in _DecodeHeader
+				break;
+			case ENCODE_STATE_MATRICES:
+				Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_NOP);
+				RdbLoadMatrices_v14(rdb, gc, payload.entities_count);
+				break;
+			case ENCODE_STATE_INDICES:
+				RdbLoadIndices_v14(rdb, gc, payload.entities_count);
+				break;
+			default:
+				ASSERT(false && "Unknown encoding");
+				break;
+		}
+	}
+
+	array_free(key_schema);
+
+	// update decode context
+	GraphDecodeContext_IncreaseProcessedKeyCount(gc->decoding_context);
+
+	// before finalizing keep encountered meta keys names, for future deletion
+	const RedisModuleString *rm_key_name = RedisModule_GetKeyNameFromIO(rdb);
+	const char *key_name = RedisModule_StringPtrLen(rm_key_name, NULL);
+
+	// the virtual key name is not equal the graph name
+	if(strcmp(key_name, gc->graph_name) != 0) {
+		GraphDecodeContext_AddMetaKey(gc->decoding_context, key_name);
+	}
+
+	if(GraphDecodeContext_Finished(gc->decoding_context)) {
+		// all keys were read, release the graph's reader reference
+		// the graph is finalized once its last decode task completes
+		if(GraphDecodeContext_CompletePendingTask(gc->decoding_context)) {
+			DecodePool_AddTask(_FinalizeGraph, gc);
+		}
+
+		// outside of server loading (e.g. RESTORE) the graph must be
+		// fully decoded by the time this function returns
+		RedisModuleCtx *ctx = RedisModule_GetContextFromIO(rdb);
+		if(!(RedisModule_GetContextFlags(ctx) & REDISMODULE_CTX_FLAGS_LOADING)) {
+			DecodePool_Wait();
+		}
+	}
+
+	return gc;
+}
+
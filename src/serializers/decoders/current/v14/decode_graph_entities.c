@@ -0,0 +1,241 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+
+// forward declarations
+static SIValue _RdbLoadPoint(RedisModuleIO *rdb);
+static SIValue _RdbLoadSIArray(RedisModuleIO *rdb);
+
+static SIValue _RdbLoadSIValue
+(
+	RedisModuleIO *rdb
+) {
+	// Format:
+	// SIType
+	// Value
+	SIType t = RedisModule_LoadUnsigned(rdb);
+	switch(t) {
+	case T_INT64:
+		return SI_LongVal(RedisModule_LoadSigned(rdb));
+	case T_DOUBLE:
+		return SI_DoubleVal(RedisModule_LoadDouble(rdb));
+	case T_STRING:
+		// transfer ownership of the heap-allocated string to the
+		// newly-created SIValue
+		return SI_TransferStringVal(RedisModule_LoadStringBuffer(rdb, NULL));
+	case T_BOOL:
+		return SI_BoolVal(RedisModule_LoadSigned(rdb));
+	case T_ARRAY:
+		return _RdbLoadSIArray(rdb);
+	case T_POINT:
+		return _RdbLoadPoint(rdb);
+	case T_NULL:
+	default: // currently impossible
+		return SI_NullVal();
+	}
+}
+
+static SIValue _RdbLoadPoint
+(
+	RedisModuleIO *rdb
+) {
+	double lat = RedisModule_LoadDouble(rdb);
+	double lon = RedisModule_LoadDouble(rdb);
+	return SI_Point(lat, lon);
+}
+
+static SIValue _RdbLoadSIArray
+(
+	RedisModuleIO *rdb
+) {
+	/* loads array as
+	   unsinged : array legnth
+	   array[0]
+	   .
+	   .
+	   .
+	   array[array length -1]
+	 */
+	uint arrayLen = RedisModule_LoadUnsigned(rdb);
+	SIValue list = SI_Array(arrayLen);
+	for(uint i = 0; i < arrayLen; i++) {
+		SIValue elem = _RdbLoadSIValue(rdb);
+		SIArray_Append(&list, elem);
+		SIValue_Free(elem);
+	}
+	return list;
+}
+
+// attribute-sets construction task
+typedef struct {
+	AttributeSet **sets;     // entities attribute-sets
+	uint16_t *count;         // number of attributes per entity
+	Attribute_ID *attr_ids;  // attribute IDs
+	SIValue *values;         // attribute values
+	uint64_t n;              // number of entities
+} AttributeSetsTask;
+
+// populate entities attribute-sets, runs on a decode worker
+static void _PopulateAttributeSets
+(
+	void *arg
+) {
+	AttributeSetsTask *task = (AttributeSetsTask *)arg;
+
+	for(uint64_t i = 0, k = 0; i < task->n; i++) {
+		uint16_t attr_count = task->count[i];
+		if(attr_count == 0) continue;
+
+		AttributeSet_AddNoClone(task->sets[i], task->attr_ids + k,
+				task->values + k, attr_count, false);
+		k += attr_count;
+	}
+
+	rm_free(task->sets);
+	rm_free(task->values);
+	RedisModule_Free(task->count);
+	RedisModule_Free(task->attr_ids);
+	rm_free(task);
+}
+
+// load a columnar section of graph entities
+// entities are allocated right away while their attribute-sets
+// are constructed by a decode worker
+static void _RdbLoadEntities
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	GraphEntityType t,
+	uint64_t n
+) {
+	// Format:
+	//  IDs                  N X EntityID
+	//  #attributes          N X uint16
+	//  attribute IDs        (#attributes X N) X Attribute_ID
+	//  attribute values     (#attributes X N) X value
+
+	size_t len;
+
+	EntityID *ids = (EntityID *)RedisModule_LoadStringBuffer(rdb, &len);
+	ASSERT(len == sizeof(EntityID) * n);
+
+	uint16_t *count = (uint16_t *)RedisModule_LoadStringBuffer(rdb, &len);
+	ASSERT(len == sizeof(uint16_t) * n);
+
+	Attribute_ID *attr_ids = (Attribute_ID *)RedisModule_LoadStringBuffer(rdb,
+			&len);
+
+	uint64_t      total  = len / sizeof(Attribute_ID);
+	SIValue       *vals  = rm_malloc(sizeof(SIValue) * total);
+	AttributeSet  **sets = rm_malloc(sizeof(AttributeSet *) * n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		if(t == GETYPE_NODE) {
+			Node node;
+			Serializer_Graph_SetNode(gc->g, ids[i], NULL, 0, &node);
+			sets[i] = node.attributes;
+		} else {
+			Edge edge;
+			Serializer_Graph_AllocateEdge(gc->g, ids[i], &edge);
+			sets[i] = edge.attributes;
+		}
+	}
+
+	for(uint64_t k = 0; k < total; k++) {
+		vals[k] = _RdbLoadSIValue(rdb);
+	}
+
+	RedisModule_Free(ids);
+
+	AttributeSetsTask *task = rm_malloc(sizeof(AttributeSetsTask));
+
+	task->n        = n;
+	task->sets     = sets;
+	task->count    = count;
+	task->values   = vals;
+	task->attr_ids = attr_ids;
+
+	RdbAddDecodeTask_v14(gc, _PopulateAttributeSets, task);
+}
+
+void RdbLoadNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t node_count
+) {
+	// Format:
+	//  columnar section of node_count nodes
+	//  node labels are set once the label matrices are loaded
+
+	if(node_count == 0) return;
+	_RdbLoadEntities(rdb, gc, GETYPE_NODE, node_count);
+}
+
+// load a buffer of deleted entity IDs
+static uint64_t *_RdbLoadDeletedEntities
+(
+	RedisModuleIO *rdb,
+	uint64_t n
+) {
+	size_t len;
+	uint64_t *ids = (uint64_t *)RedisModule_LoadStringBuffer(rdb, &len);
+	ASSERT(len == sizeof(uint64_t) * n);
+	UNUSED(len);
+
+	return ids;
+}
+
+void RdbLoadDeletedNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_node_count
+) {
+	// Format:
+	// node id X N
+
+	if(deleted_node_count == 0) return;
+
+	uint64_t *ids = _RdbLoadDeletedEntities(rdb, deleted_node_count);
+	for(uint64_t i = 0; i < deleted_node_count; i++) {
+		Serializer_Graph_MarkNodeDeleted(gc->g, ids[i]);
+	}
+	RedisModule_Free(ids);
+}
+
+void RdbLoadEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t edge_count
+) {
+	// Format:
+	//  columnar section of edge_count edges
+	//  edge connections are set once the relation matrices are loaded
+
+	if(edge_count == 0) return;
+	_RdbLoadEntities(rdb, gc, GETYPE_EDGE, edge_count);
+}
+
+void RdbLoadDeletedEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_edge_count
+) {
+	// Format:
+	// edge id X N
+
+	if(deleted_edge_count == 0) return;
+
+	uint64_t *ids = _RdbLoadDeletedEntities(rdb, deleted_edge_count);
+	for(uint64_t i = 0; i < deleted_edge_count; i++) {
+		Serializer_Graph_MarkEdgeDeleted(gc->g, ids[i]);
+	}
+	RedisModule_Free(ids);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+
+// index restoration task
+typedef struct {
+	GraphContext *gc;  // graph being decoded
+	IndexType type;    // restored index type
+	LabelID label;     // indexed label
+	char *buffer;      // serialized index structure
+	size_t size;       // serialized index structure size
+} IndexTask;
+
+// restore a vector index's HNSW graph
+// returns false if the graph is inconsistent with the index
+static bool _RestoreVectorIndex
+(
+	Schema *s,
+	const IndexTask *task
+) {
+	Index idx = PENDING_VECTOR_IDX(s);
+	if(idx == NULL) return false;
+
+	HNSW *hnsw = HNSW_Deserialize(task->buffer, task->size);
+	if(hnsw == NULL) return false;
+
+	const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+	if(HNSW_Dimension(hnsw)  != opts->dimension ||
+	   HNSW_Similarity(hnsw) != opts->similarity) {
+		HNSW_Free(hnsw);
+		return false;
+	}
+
+	Index_SetHNSW(idx, hnsw);
+	return true;
+}
+
+// restore one of an exact-match index's ordered indices
+// returns false if the ordered index is inconsistent with the index
+static bool _RestoreOrderedIndex
+(
+	Schema *s,
+	const IndexTask *task
+) {
+	Index idx = PENDING_EXACTMATCH_IDX(s);
+	if(idx == NULL) return false;
+
+	OrderedIndex *oi = OrderedIndex_Deserialize(task->buffer, task->size);
+	if(oi == NULL) return false;
+
+	if(!Index_SetOrderedIndex(idx, oi)) {
+		OrderedIndex_Free(oi);
+		return false;
+	}
+
+	return true;
+}
+
+// restore a persisted index structure, runs on a decode worker
+// on failure the structure is left empty and is repopulated
+// once the graph is fully loaded
+static void _RestoreIndex
+(
+	void *arg
+) {
+	IndexTask    *task = (IndexTask *)arg;
+	GraphContext *gc   = task->gc;
+	bool         ok    = false;
+
+	if(task->label < GraphContext_SchemaCount(gc, SCHEMA_NODE)) {
+		Schema *s = GraphContext_GetSchemaByID(gc, task->label, SCHEMA_NODE);
+		if(task->type == IDX_VECTOR) {
+			ok = _RestoreVectorIndex(s, task);
+		} else if(task->type == IDX_EXACT_MATCH) {
+			ok = _RestoreOrderedIndex(s, task);
+		}
+	}
+
+	if(!ok) {
+		RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+				"Graph %s: inconsistent index contents, repopulating",
+				gc->graph_name);
+	}
+
+	RedisModule_Free(task->buffer);
+	rm_free(task);
+}
+
+void RdbLoadIndices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t index_count
+) {
+	// Format:
+	//  offset - index of the first index in this payload
+	//  {
+	//   index type
+	//   label ID
+	//   serialized HNSW graph or ordered index, ends with a checksum
+	//  } X index_count
+	//
+	// index structures are restored by decode workers
+
+	if(index_count == 0) return;
+
+	// offset isn't required, indices are identified by their label
+	RedisModule_LoadUnsigned(rdb);
+
+	for(uint64_t i = 0; i < index_count; i++) {
+		IndexTask *task = rm_malloc(sizeof(IndexTask));
+
+		task->gc     = gc;
+		task->type   = RedisModule_LoadUnsigned(rdb);
+		task->label  = RedisModule_LoadUnsigned(rdb);
+		task->buffer = RedisModule_LoadStringBuffer(rdb, &task->size);
+
+		RdbAddDecodeTask_v14(gc, _RestoreIndex, task);
+	}
+}
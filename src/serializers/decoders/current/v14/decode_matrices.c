@@ -0,0 +1,94 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "decode_v14.h"
+
+// matrix construction task
+typedef struct {
+	Graph *g;               // graph being decoded
+	uint64_t idx;           // matrix index, labels followed by relations
+	char *blob;             // serialized matrix
+	size_t blob_size;       // serialized matrix size
+	uint64_t *multi_edges;  // multi-edge entries, NULL if there are none
+	size_t multi_edges_len; // number of elements in multi_edges
+} MatrixTask;
+
+// deserialize a matrix and set it in the graph, runs on a decode worker
+static void _BuildMatrix
+(
+	void *arg
+) {
+	MatrixTask *task  = (MatrixTask *)arg;
+	Graph      *g     = task->g;
+	uint       labels = Graph_LabelTypeCount(g);
+	bool       label  = task->idx < labels;
+	GrB_Type   t      = label ? GrB_BOOL : GrB_UINT64;
+	GrB_Matrix m      = NULL;
+
+	GrB_Info info = GxB_Matrix_deserialize(&m, t, task->blob, task->blob_size,
+			NULL);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	if(label) {
+		Serializer_Graph_SetLabelMatrix(g, task->idx, m);
+	} else {
+		GrB_Index nvals;
+		GrB_Matrix_nvals(&nvals, m);
+
+		if(task->multi_edges != NULL) {
+			nvals += Serializer_Graph_UnpackMultiEdges(m, task->multi_edges,
+					task->multi_edges_len);
+			RedisModule_Free(task->multi_edges);
+		}
+
+		Serializer_Graph_SetRelationMatrix(g, task->idx - labels, m, nvals);
+	}
+
+	RedisModule_Free(task->blob);
+	rm_free(task);
+}
+
+void RdbLoadMatrices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t matrix_count
+) {
+	// Format:
+	//  offset - index of the first matrix in this payload
+	//  label matrix X #labels
+	//  {
+	//   relation matrix
+	//   multi-edge entries (only if the relation holds multi-edge entries)
+	//  } X #relations
+	//
+	// matrices are deserialized by decode workers
+
+	if(matrix_count == 0) return;
+
+	Graph    *g          = gc->g;
+	uint     label_count = Graph_LabelTypeCount(g);
+	uint64_t offset      = RedisModule_LoadUnsigned(rdb);
+
+	for(uint64_t i = offset; i < offset + matrix_count; i++) {
+		MatrixTask *task = rm_calloc(1, sizeof(MatrixTask));
+
+		task->g    = g;
+		task->idx  = i;
+		task->blob = RedisModule_LoadStringBuffer(rdb, &task->blob_size);
+
+		if(i >= label_count &&
+		   gc->decoding_context->multi_edge[i - label_count]) {
+			size_t len;
+			task->multi_edges = (uint64_t *)RedisModule_LoadStringBuffer(rdb,
+					&len);
+			task->multi_edges_len = len / sizeof(uint64_t);
+		}
+
+		RdbAddDecodeTask_v14(gc, _BuildMatrix, task);
+	}
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../../serializers_include.h"
+
+GraphContext *RdbLoadGraphContext_v14
+(
+	RedisModuleIO *rdb
+);
+
+// schedule a decode task on behalf of gc
+// gc is finalized once its last pending decode task completes
+void RdbAddDecodeTask_v14
+(
+	GraphContext *gc,
+	void (*task)(void *),
+	void *arg
+);
+
+void RdbLoadNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t node_count
+);
+
+void RdbLoadDeletedNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_node_count
+);
+
+void RdbLoadEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t edge_count
+);
+
+void RdbLoadDeletedEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_edge_count
+);
+
+void RdbLoadMatrices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t matrix_count
+);
+
+void RdbLoadIndices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t index_count
+);
+
+void RdbLoadGraphSchema_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	bool already_loaded
+);
+
@@ -9,3 +9,4 @@
 #include "v10/decode_v10.h"
 #include "v11/decode_v11.h"
 #include "v12/decode_v12.h"
+#include "v13/decode_v13.h"
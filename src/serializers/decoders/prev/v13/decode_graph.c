@@ -240,6 +240,12 @@ GraphContext *RdbLoadGraphContext_v13
 				Index_Enable(idx);
 				Schema_ActivateIndex(s, idx);
 			}
+
+			idx = PENDING_VECTOR_IDX(s);
+			if(idx != NULL) {
+				Index_Enable(idx);
+				Schema_ActivateIndex(s, idx);
+			}
 		}
 
 		// enable all edge indices
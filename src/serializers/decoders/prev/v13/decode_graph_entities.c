@@ -129,6 +129,7 @@ void RdbLoadNodes_v13
 
 			if(PENDING_FULLTEXT_IDX(s)) Index_IndexNode(PENDING_FULLTEXT_IDX(s), &n);
 			if(PENDING_EXACTMATCH_IDX(s)) Index_IndexNode(PENDING_EXACTMATCH_IDX(s), &n);
+			if(PENDING_VECTOR_IDX(s)) Index_IndexNode(PENDING_VECTOR_IDX(s), &n);
 		}
 	}
 }
@@ -97,6 +97,47 @@ static void _RdbLoadExactMatchIndex
 	}
 }
 
+static void _RdbLoadVectorIndex
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	Schema *s,
+	bool already_loaded
+) {
+	/* Format:
+	 * property
+	 * dimension
+	 * similarity function
+	 * M
+	 * efConstruction
+	 * efRuntime */
+
+	VectorIndexOptions opts;
+	char *field_name     = RedisModule_LoadStringBuffer(rdb, NULL);
+	opts.dimension       = RedisModule_LoadUnsigned(rdb);
+	opts.similarity      = RedisModule_LoadUnsigned(rdb);
+	opts.M               = RedisModule_LoadUnsigned(rdb);
+	opts.ef_construction = RedisModule_LoadUnsigned(rdb);
+	opts.ef_runtime      = RedisModule_LoadUnsigned(rdb);
+
+	if(!already_loaded) {
+		Index idx = NULL;
+		IndexField field;
+		Attribute_ID field_id = GraphContext_FindOrAddAttribute(gc, field_name,
+				NULL);
+		IndexField_Default(&field, field_id, field_name);
+		Schema_AddIndex(&idx, s, &field, IDX_VECTOR);
+		ASSERT(idx != NULL);
+
+		Index_SetVectorOptions(idx, &opts);
+		// disable and create index structure
+		// must be enabled once the graph is fully loaded
+		Index_Disable(idx);
+	}
+
+	RedisModule_Free(field_name);
+}
+
 static void _RdbLoadConstaint
 (
 	RedisModuleIO *rdb,
@@ -220,6 +261,9 @@ static void _RdbLoadSchema
 			case IDX_EXACT_MATCH:
 				_RdbLoadExactMatchIndex(rdb, gc, s, already_loaded);
 				break;
+			case IDX_VECTOR:
+				_RdbLoadVectorIndex(rdb, gc, s, already_loaded);
+				break;
 			default:
 				ASSERT(false);
 				break;
@@ -0,0 +1,231 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "encode_v14.h"
+#include "../../../datatypes/datatypes.h"
+
+// forword decleration
+static void _RdbSaveSIValue
+(
+	RedisModuleIO *rdb,
+	const SIValue *v
+);
+
+static void _RdbSaveSIArray
+(
+	RedisModuleIO *rdb,
+	const SIValue list
+) {
+	/* saves array as
+	   unsigned : array legnth
+	   array[0]
+	   .
+	   .
+	   .
+	   array[array length -1]
+	 */
+	uint arrayLen = SIArray_Length(list);
+	RedisModule_SaveUnsigned(rdb, arrayLen);
+	for(uint i = 0; i < arrayLen; i ++) {
+		SIValue value = SIArray_Get(list, i);
+		_RdbSaveSIValue(rdb, &value);
+	}
+}
+
+static void _RdbSaveSIValue
+(
+	RedisModuleIO *rdb,
+	const SIValue *v
+) {
+	// Format:
+	// SIType
+	// Value
+	RedisModule_SaveUnsigned(rdb, v->type);
+	switch(v->type) {
+		case T_BOOL:
+		case T_INT64:
+			RedisModule_SaveSigned(rdb, v->longval);
+			return;
+		case T_DOUBLE:
+			RedisModule_SaveDouble(rdb, v->doubleval);
+			return;
+		case T_STRING:
+			RedisModule_SaveStringBuffer(rdb, v->stringval, strlen(v->stringval) + 1);
+			return;
+		case T_ARRAY:
+			_RdbSaveSIArray(rdb, *v);
+			return;
+		case T_POINT:
+			RedisModule_SaveDouble(rdb, Point_lat(*v));
+			RedisModule_SaveDouble(rdb, Point_lon(*v));
+		case T_NULL:
+			return; // No data beyond the type needs to be encoded for a NULL value.
+		default:
+			ASSERT(0 && "Attempted to serialize value of invalid type.");
+	}
+}
+
+// save a columnar section of graph entities
+// each column is written as a single buffer, followed by the attribute values
+static void _RdbSaveEntities
+(
+	RedisModuleIO *rdb,            // RDB IO
+	DataBlockIterator *iter,       // entities iterator
+	uint64_t n                     // number of entities to encode
+) {
+	// Format:
+	//  IDs                  N X EntityID
+	//  #attributes          N X uint16
+	//  attribute IDs        (#attributes X N) X Attribute_ID
+	//  attribute values     (#attributes X N) X value
+
+	uint64_t      total  = 0;
+	EntityID      *ids   = rm_malloc(sizeof(EntityID) * n);
+	uint16_t      *count = rm_malloc(sizeof(uint16_t) * n);
+	AttributeSet  *sets  = rm_malloc(sizeof(AttributeSet) * n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		AttributeSet *set = (AttributeSet *)DataBlockIterator_Next(iter, ids + i);
+		ASSERT(set != NULL);
+
+		sets[i]  = *set;
+		count[i] = AttributeSet_Count(sets[i]);
+		total   += count[i];
+	}
+
+	Attribute_ID *attr_ids = rm_malloc(sizeof(Attribute_ID) * total);
+	for(uint64_t i = 0, k = 0; i < n; i++) {
+		for(uint16_t j = 0; j < count[i]; j++, k++) {
+			AttributeSet_GetIdx(sets[i], j, attr_ids + k);
+		}
+	}
+
+	RedisModule_SaveStringBuffer(rdb, (const char *)ids, sizeof(EntityID) * n);
+	RedisModule_SaveStringBuffer(rdb, (const char *)count, sizeof(uint16_t) * n);
+	RedisModule_SaveStringBuffer(rdb, (const char *)attr_ids,
+			sizeof(Attribute_ID) * total);
+
+	for(uint64_t i = 0; i < n; i++) {
+		for(uint16_t j = 0; j < count[i]; j++) {
+			Attribute_ID attr_id;
+			SIValue value = AttributeSet_GetIdx(sets[i], j, &attr_id);
+			_RdbSaveSIValue(rdb, &value);
+		}
+	}
+
+	rm_free(ids);
+	rm_free(sets);
+	rm_free(count);
+	rm_free(attr_ids);
+}
+
+static void _RdbSaveDeletedEntities_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_entities_to_encode,
+	uint64_t *deleted_id_list
+) {
+	// get the number of deleted entities already encoded
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+
+	// the required range is contiguous within the datablock deleted items
+	RedisModule_SaveStringBuffer(rdb, (const char *)(deleted_id_list + offset),
+			sizeof(uint64_t) * deleted_entities_to_encode);
+}
+
+void RdbSaveDeletedNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_nodes_to_encode
+) {
+	// Format:
+	// node id X N
+
+	if(deleted_nodes_to_encode == 0) return;
+	// get deleted nodes list
+	uint64_t *deleted_nodes_list = Serializer_Graph_GetDeletedNodesList(gc->g);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_nodes_to_encode, deleted_nodes_list);
+}
+
+void RdbSaveDeletedEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t deleted_edges_to_encode
+) {
+	// Format:
+	// edge id X N
+
+	if(deleted_edges_to_encode == 0) return;
+
+	// get deleted edges list
+	uint64_t *deleted_edges_list = Serializer_Graph_GetDeletedEdgesList(gc->g);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_edges_to_encode, deleted_edges_list);
+}
+
+// encode the next entities in the datablock scanned by scan
+static void _RdbSaveDataBlock
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	DataBlockIterator *(*scan)(const Graph *g),
+	uint64_t entity_count,
+	uint64_t entities_to_encode
+) {
+	// get the number of entities already encoded
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+
+	// get datablock iterator from context,
+	// already set to offset by a previous encodeing, or create new one
+	DataBlockIterator *iter = GraphEncodeContext_GetDatablockIterator(gc->encoding_context);
+	if(!iter) {
+		iter = scan(gc->g);
+		GraphEncodeContext_SetDatablockIterator(gc->encoding_context, iter);
+	}
+
+	_RdbSaveEntities(rdb, iter, entities_to_encode);
+
+	// check if done encodeing entities
+	if(offset + entities_to_encode == entity_count) {
+		DataBlockIterator_Free(iter);
+		GraphEncodeContext_SetDatablockIterator(gc->encoding_context, NULL);
+	}
+}
+
+void RdbSaveNodes_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t nodes_to_encode
+) {
+	// Format:
+	//  columnar section of nodes_to_encode nodes
+	//  node labels are encoded by the label matrices
+
+	if(nodes_to_encode == 0) return;
+
+	_RdbSaveDataBlock(rdb, gc, Graph_ScanNodes, Graph_NodeCount(gc->g),
+			nodes_to_encode);
+}
+
+void RdbSaveEdges_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t edges_to_encode
+) {
+	// Format:
+	//  columnar section of edges_to_encode edges
+	//  edges endpoints and relationship type are encoded by the
+	//  relation matrices
+
+	if(edges_to_encode == 0) return;
+
+	_RdbSaveDataBlock(rdb, gc, Graph_ScanEdges, Graph_EdgeCount(gc->g),
+			edges_to_encode);
+}
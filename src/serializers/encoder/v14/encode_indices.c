@@ -0,0 +1,94 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "encode_v14.h"
+
+// returns the i-th index structure whose contents are persisted
+// active vector indices persist their HNSW graph and active node exact-match
+// indices persist each of their ordered indices, the remaining structures
+// are repopulated once the graph is loaded
+// sets 'oi' to the persisted ordered index, NULL for vector indices
+static Index _PersistedIndex
+(
+	GraphContext *gc,
+	uint64_t i,
+	const OrderedIndex **oi
+) {
+	uint n = GraphContext_SchemaCount(gc, SCHEMA_NODE);
+	for(uint j = 0; j < n; j++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, j, SCHEMA_NODE);
+
+		Index idx = ACTIVE_VECTOR_IDX(s);
+		if(idx != NULL && i-- == 0) {
+			*oi = NULL;
+			return idx;
+		}
+
+		idx = ACTIVE_EXACTMATCH_IDX(s);
+		if(idx == NULL) continue;
+
+		uint nfields = Index_FieldsCount(idx);
+		const IndexField *fields = Index_GetFields(idx);
+		for(uint k = 0; k < nfields; k++) {
+			const OrderedIndex *ordered =
+				Index_GetOrderedIndex(idx, fields[k].id);
+			if(ordered != NULL && i-- == 0) {
+				*oi = ordered;
+				return idx;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+uint64_t RdbPersistedIndexCount_v14
+(
+	GraphContext *gc
+) {
+	uint64_t count = 0;
+	const OrderedIndex *oi;
+	while(_PersistedIndex(gc, count, &oi) != NULL) count++;
+	return count;
+}
+
+void RdbSaveIndices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t indices_to_encode
+) {
+	// Format:
+	//  offset - index of the first index in this payload
+	//  {
+	//   index type
+	//   label ID
+	//   serialized HNSW graph or ordered index, ends with a checksum
+	//  } X indices_to_encode
+
+	if(indices_to_encode == 0) return;
+
+	// get the number of indices already encoded
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+	RedisModule_SaveUnsigned(rdb, offset);
+
+	for(uint64_t i = offset; i < offset + indices_to_encode; i++) {
+		const OrderedIndex *oi;
+		Index idx = _PersistedIndex(gc, i, &oi);
+		ASSERT(idx != NULL);
+
+		size_t size;
+		void *buffer = (oi == NULL) ?
+			HNSW_Serialize(Index_HNSW(idx), &size) :
+			OrderedIndex_Serialize(oi, &size);
+
+		RedisModule_SaveUnsigned(rdb, Index_Type(idx));
+		RedisModule_SaveUnsigned(rdb, Index_GetLabelID(idx));
+		RedisModule_SaveStringBuffer(rdb, buffer, size);
+
+		rm_free(buffer);
+	}
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "encode_v14.h"
+
+// save a GraphBLAS matrix as a serialized blob
+static void _RdbSaveMatrix
+(
+	RedisModuleIO *rdb,
+	GrB_Matrix m
+) {
+	// Format:
+	//  GxB_Matrix_serialize blob
+
+	void      *blob = NULL;
+	GrB_Index size  = 0;
+	GrB_Info  info  = GxB_Matrix_serialize(&blob, &size, m, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	RedisModule_SaveStringBuffer(rdb, blob, size);
+	rm_free(blob);
+}
+
+// save the edge IDs held by each multi-edge entry of relation matrix m
+static void _RdbSaveMultiEdges
+(
+	RedisModuleIO *rdb,
+	GrB_Matrix m
+) {
+	// Format:
+	//  buffer of uint64:
+	//  (source node ID, destination node ID, #edges K, edge ID X K) X N
+
+	uint64_t *buffer = Serializer_Graph_PackMultiEdges(m);
+
+	RedisModule_SaveStringBuffer(rdb, (const char *)buffer,
+			sizeof(uint64_t) * array_len(buffer));
+
+	array_free(buffer);
+}
+
+// save the content of an RG_Matrix, without applying its pending changes
+static void _RdbSaveRGMatrix
+(
+	RedisModuleIO *rdb,
+	RG_Matrix M,
+	bool multi_edge
+) {
+	GrB_Matrix m = RG_MATRIX_M(M);
+	GrB_Matrix exported = NULL;
+
+	// encoding must not modify the graph, export pending changes to a copy
+	if(!RG_Matrix_Synced(M)) {
+		GrB_Info info = RG_Matrix_export(&exported, M);
+		ASSERT(info == GrB_SUCCESS);
+		UNUSED(info);
+		m = exported;
+	}
+
+	_RdbSaveMatrix(rdb, m);
+	if(multi_edge) _RdbSaveMultiEdges(rdb, m);
+
+	if(exported != NULL) GrB_Matrix_free(&exported);
+}
+
+void RdbSaveMatrices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t matrices_to_encode
+) {
+	// Format:
+	//  offset - index of the first matrix in this payload
+	//  label matrix X #labels
+	//  {
+	//   relation matrix
+	//   multi-edge entries (only if the relation holds multi-edge entries)
+	//  } X #relations
+	//
+	// the adjacency and node labels matrices, as well as the transposed
+	// relation matrices are computed while decoding
+
+	if(matrices_to_encode == 0) return;
+
+	Graph *g = gc->g;
+	GraphEncodeHeader *header = &(gc->encoding_context->header);
+	uint label_count = header->label_matrix_count;
+
+	// get the number of matrices already encoded
+	uint64_t offset = GraphEncodeContext_GetProcessedEntitiesOffset(gc->encoding_context);
+	RedisModule_SaveUnsigned(rdb, offset);
+
+	for(uint64_t i = offset; i < offset + matrices_to_encode; i++) {
+		if(i < label_count) {
+			_RdbSaveRGMatrix(rdb, Graph_GetLabelMatrix(g, i), false);
+		} else {
+			RelationID r = i - label_count;
+			_RdbSaveRGMatrix(rdb, Graph_GetRelationMatrix(g, r, false),
+					header->multi_edge[r]);
+		}
+	}
+}
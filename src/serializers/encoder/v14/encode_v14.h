@@ -8,41 +8,61 @@
 
 #include "../../serializers_include.h"
 
-void RdbSaveGraph_v13
+void RdbSaveGraph_v14
 (
 	RedisModuleIO *rdb,
 	void *value
 );
 
-void RdbSaveNodes_v13
+void RdbSaveNodes_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
 	uint64_t nodes_to_encode
 );
 
-void RdbSaveDeletedNodes_v13
+void RdbSaveDeletedNodes_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
 	uint64_t deleted_nodes_to_encode
 );
 
-void RdbSaveEdges_v13
+void RdbSaveEdges_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
 	uint64_t edges_to_encode
 );
 
-void RdbSaveDeletedEdges_v13
+void RdbSaveDeletedEdges_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
 	uint64_t deleted_edges_to_encode
 );
 
-void RdbSaveGraphSchema_v13
+void RdbSaveMatrices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t matrices_to_encode
+);
+
+// number of indices whose contents are persisted
+uint64_t RdbPersistedIndexCount_v14
+(
+	GraphContext *gc
+);
+
+void RdbSaveIndices_v14
+(
+	RedisModuleIO *rdb,
+	GraphContext *gc,
+	uint64_t indices_to_encode
+);
+
+void RdbSaveGraphSchema_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc
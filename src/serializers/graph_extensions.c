@@ -6,6 +6,7 @@
 
 #include "graph_extensions.h"
 #include "../RG.h"
+#include "../util/arr.h"
 #include "../util/datablock/oo_datablock.h"
 
 // functions declerations - implemented in graph.c
@@ -217,6 +218,197 @@ void Serializer_Graph_SetEdge
 	}
 }
 
+// allocates an edge's attribute-set in the graph
+void Serializer_Graph_AllocateEdge
+(
+	Graph *g,
+	EdgeID edge_id,
+	Edge *e
+) {
+	ASSERT(g);
+
+	AttributeSet *set = DataBlock_AllocateItemOutOfOrder(g->edges, edge_id);
+	*set = NULL;
+
+	e->id         = edge_id;
+	e->attributes = set;
+}
+
+// replaces C's underlying matrix with m, updating C's transpose if maintained
+static void _SetMatrix
+(
+	Graph *g,
+	RG_Matrix C,
+	GrB_Matrix m
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	ASSERT(RG_Matrix_Synced(C));
+
+	// matrix was serialized with the encoding graph dimensions
+	GrB_Index dim = Graph_RequiredMatrixDim(g);
+	info = GrB_Matrix_resize(m, dim, dim);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_set(m, GxB_SPARSITY_CONTROL, GxB_SPARSE | GxB_HYPERSPARSE);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Matrix_free(&RG_MATRIX_M(C));
+	RG_MATRIX_M(C) = m;
+
+	if(RG_MATRIX_MAINTAIN_TRANSPOSE(C)) {
+		// transposed matrices only track structure
+		info = GrB_Matrix_apply(RG_MATRIX_TM(C), NULL, NULL, GxB_ONE_BOOL, m,
+				GrB_DESC_T0);
+		ASSERT(info == GrB_SUCCESS);
+	}
+}
+
+void Serializer_Graph_SetLabelMatrix
+(
+	Graph *g,
+	LabelID l,
+	GrB_Matrix m
+) {
+	ASSERT(g);
+	ASSERT(m);
+
+	_SetMatrix(g, Graph_GetLabelMatrix(g, l), m);
+}
+
+void Serializer_Graph_SetRelationMatrix
+(
+	Graph *g,
+	RelationID r,
+	GrB_Matrix m,
+	uint64_t edge_count
+) {
+	ASSERT(g);
+	ASSERT(m);
+
+	_SetMatrix(g, Graph_GetRelationMatrix(g, r, false), m);
+
+	GraphStatistics_IncEdgeCount(&g->stats, r, edge_count);
+}
+
+uint64_t *Serializer_Graph_PackMultiEdges
+(
+	GrB_Matrix m
+) {
+	ASSERT(m != NULL);
+
+	GrB_Info   info;
+	GrB_Index  nrows;
+	GrB_Index  ncols;
+	GrB_Index  nvals;
+	GrB_Matrix multi = NULL;
+
+	UNUSED(info);
+
+	info = GrB_Matrix_nrows(&nrows, m);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, m);
+	ASSERT(info == GrB_SUCCESS);
+
+	// multi-edge entries are tagged with their MSB set
+	info = GrB_Matrix_new(&multi, GrB_UINT64, nrows, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_select_UINT64(multi, NULL, NULL, GrB_VALUEGE_UINT64, m,
+			MSB_MASK, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_nvals(&nvals, multi);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index *rows = rm_malloc(sizeof(GrB_Index) * nvals);
+	GrB_Index *cols = rm_malloc(sizeof(GrB_Index) * nvals);
+	uint64_t  *vals = rm_malloc(sizeof(uint64_t) * nvals);
+
+	info = GrB_Matrix_extractTuples_UINT64(rows, cols, vals, &nvals, multi);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint64_t *buffer = array_new(uint64_t, nvals * 4);
+	for(GrB_Index i = 0; i < nvals; i++) {
+		EdgeID *ids = (EdgeID *)(CLEAR_MSB(vals[i]));
+		uint    n   = array_len(ids);
+
+		array_append(buffer, rows[i]);
+		array_append(buffer, cols[i]);
+		array_append(buffer, n);
+		for(uint j = 0; j < n; j++) array_append(buffer, ids[j]);
+	}
+
+	rm_free(rows);
+	rm_free(cols);
+	rm_free(vals);
+	GrB_Matrix_free(&multi);
+
+	return buffer;
+}
+
+uint64_t Serializer_Graph_UnpackMultiEdges
+(
+	GrB_Matrix m,
+	const uint64_t *buffer,
+	uint64_t n
+) {
+	ASSERT(m != NULL);
+	ASSERT(buffer != NULL || n == 0);
+
+	uint64_t extra = 0;
+
+	for(uint64_t i = 0; i < n;) {
+		NodeID   src   = buffer[i++];
+		NodeID   dest  = buffer[i++];
+		uint64_t count = buffer[i++];
+		ASSERT(count > 1 && i + count <= n);
+
+		EdgeID *ids = array_new(EdgeID, count);
+		for(uint64_t j = 0; j < count; j++) array_append(ids, buffer[i++]);
+
+		GrB_Info info = GrB_Matrix_setElement_UINT64(m, SET_MSB((uint64_t)ids),
+				src, dest);
+		ASSERT(info == GrB_SUCCESS);
+		UNUSED(info);
+
+		extra += count - 1;
+	}
+
+	return extra;
+}
+
+// computes AdjacencyMatrix out of relation matrices
+// AdjacencyMatrix[i,j] = OR(RelationMatrix[r][i,j])
+// must be called once after all virtual keys loaded for perf
+void Serializer_Graph_SetAdjacencyMatrix
+(
+	Graph *g
+) {
+	ASSERT(g);
+
+	GrB_Info info;
+	UNUSED(info);
+
+	RG_Matrix  adj       = Graph_GetAdjacencyMatrix(g, false);
+	GrB_Matrix adj_m     = RG_MATRIX_M(adj);
+	GrB_Index  dim       = Graph_RequiredMatrixDim(g);
+	int        rel_count = Graph_RelationTypeCount(g);
+
+	for(int r = 0; r < rel_count; r++) {
+		RG_Matrix  R = Graph_GetRelationMatrix(g, r, false);
+		GrB_Matrix m = RG_MATRIX_M(R);
+
+		// set adj[i,j] wherever R[i,j] is present
+		info = GrB_Matrix_assign_BOOL(adj_m, m, NULL, true, GrB_ALL, dim,
+				GrB_ALL, dim, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	info = GrB_transpose(RG_MATRIX_TM(adj), NULL, NULL, adj_m, NULL);
+	ASSERT(info == GrB_SUCCESS);
+}
+
 // returns the graph deleted nodes list
 uint64_t *Serializer_Graph_GetDeletedNodesList
 (
@@ -36,6 +36,58 @@ void Serializer_Graph_SetEdge
 	Edge *e                 // pointer to edge
 );
 
+// allocates an edge's attribute-set in the graph
+// the edge connection is set by Serializer_Graph_SetRelationMatrix
+void Serializer_Graph_AllocateEdge
+(
+	Graph *g,               // graph to add edge to
+	EdgeID edge_id,         // edge ID
+	Edge *e                 // pointer to edge
+);
+
+// replaces label matrix content, graph takes ownership over m
+void Serializer_Graph_SetLabelMatrix
+(
+	Graph *g,               // graph to update
+	LabelID l,              // label ID
+	GrB_Matrix m            // label matrix content
+);
+
+// replaces relation matrix content, graph takes ownership over m
+// multi-edge entries of m must already point to their edge ID arrays
+void Serializer_Graph_SetRelationMatrix
+(
+	Graph *g,               // graph to update
+	RelationID r,           // relationship-type ID
+	GrB_Matrix m,           // relation matrix content
+	uint64_t edge_count     // number of edges held by m
+);
+
+// packs the edge IDs held by each multi-edge entry of relation matrix m
+// buffer of uint64:
+// (source node ID, destination node ID, #edges K, edge ID X K) X N
+// returns an arr.h array, caller is responsible for freeing it
+uint64_t *Serializer_Graph_PackMultiEdges
+(
+	GrB_Matrix m            // relation matrix
+);
+
+// restores multi-edge entries packed by Serializer_Graph_PackMultiEdges
+// returns the number of edges added on top of m's entries
+uint64_t Serializer_Graph_UnpackMultiEdges
+(
+	GrB_Matrix m,           // relation matrix to update
+	const uint64_t *buffer, // packed multi-edge entries
+	uint64_t n              // number of elements in buffer
+);
+
+// computes graph's adjacency matrix out of its relation matrices
+// must be called once after all relation matrices are set
+void Serializer_Graph_SetAdjacencyMatrix
+(
+	Graph *g
+);
+
 // marks a node ID as deleted
 void Serializer_Graph_MarkNodeDeleted
 (
@@ -0,0 +1,1367 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "snapshot.h"
+#include "graph_extensions.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../index/indexer.h"
+#include "../schema/schema.h"
+#include "../datatypes/array.h"
+#include "../constraint/constraint.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// File format:
+//  header                        page 0
+//  {
+//   section content              page aligned
+//  } X SECTION_COUNT
+//
+// all integers are stored in native byte order
+// a snapshot can only be loaded by a build sharing the saving build's
+// in-memory layout, which is verified through the header
+
+#define SNAPSHOT_MAGIC    0x50414E5348504752  // "RGPHSNAP"
+#define SNAPSHOT_VERSION  1
+#define SNAPSHOT_ALIGN    4096  // sections alignment
+#define SNAPSHOT_WORD     8     // alignment within sections
+
+typedef enum {
+	SECTION_SCHEMA = 0,  // attribute names, schemas, indices and constraints
+	SECTION_NODES,       // node IDs and attributes
+	SECTION_EDGES,       // edge IDs and attributes
+	SECTION_HEAP,        // strings and arrays referred to by attributes
+	SECTION_MATRICES,    // label and relation matrices
+	SECTION_INDICES,     // vector indices HNSW graphs
+	SECTION_COUNT
+} SnapshotSectionType;
+
+typedef struct {
+	uint64_t offset;  // section file offset
+	uint64_t size;    // section size in bytes
+} SnapshotSection;
+
+typedef struct {
+	uint64_t magic;                            // SNAPSHOT_MAGIC
+	uint32_t version;                          // SNAPSHOT_VERSION
+	uint32_t attribute_size;                   // sizeof(Attribute)
+	SnapshotSection sections[SECTION_COUNT];   // section table
+} SnapshotHeader;
+
+struct GraphSnapshot {
+	void *data;   // mapped file
+	size_t size;  // mapping size
+};
+
+// report a failed file operation
+// the client gets a generic error, avoiding disclosing file system details
+// while the failure's cause is logged
+static void _FileError
+(
+	RedisModuleCtx *ctx,  // redis context, used for error replies
+	const char *op,       // failed operation
+	const char *path      // snapshot file path
+) {
+	RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+			"Failed to %s snapshot file '%s': %s", op, path, strerror(errno));
+	RedisModule_ReplyWithErrorFormat(ctx, "Failed to %s snapshot file", op);
+}
+
+//------------------------------------------------------------------------------
+// save
+//------------------------------------------------------------------------------
+
+typedef struct {
+	FILE *f;        // output file
+	uint64_t pos;   // current file offset
+	bool failed;    // write failed
+} SnapshotWriter;
+
+static void _Write
+(
+	SnapshotWriter *w,
+	const void *data,
+	size_t n
+) {
+	if(w->failed || n == 0) return;
+
+	if(fwrite(data, 1, n, w->f) != n) w->failed = true;
+	w->pos += n;
+}
+
+static void _WriteU64
+(
+	SnapshotWriter *w,
+	uint64_t v
+) {
+	_Write(w, &v, sizeof(uint64_t));
+}
+
+// pad output with zeros up to the next multiple of align
+static void _Pad
+(
+	SnapshotWriter *w,
+	uint64_t align
+) {
+	static const char zeros[SNAPSHOT_ALIGN] = {0};
+	_Write(w, zeros, (align - w->pos % align) % align);
+}
+
+static void _WriteString
+(
+	SnapshotWriter *w,
+	const char *s
+) {
+	// Format:
+	//  length, including the terminating NUL
+	//  characters (padded to 8 bytes)
+
+	uint64_t len = strlen(s) + 1;
+	_WriteU64(w, len);
+	_Write(w, s, len);
+	_Pad(w, SNAPSHOT_WORD);
+}
+
+static void _BeginSection
+(
+	SnapshotWriter *w,
+	SnapshotHeader *header,
+	SnapshotSectionType t
+) {
+	_Pad(w, SNAPSHOT_ALIGN);
+	header->sections[t].offset = w->pos;
+}
+
+static void _EndSection
+(
+	SnapshotWriter *w,
+	SnapshotHeader *header,
+	SnapshotSectionType t
+) {
+	header->sections[t].size = w->pos - header->sections[t].offset;
+}
+
+// reserve n bytes at the end of the heap, returns their offset
+static uint64_t _HeapReserve
+(
+	char **heap,
+	size_t n
+) {
+	uint64_t len = array_len(*heap);
+	uint64_t pad = (SNAPSHOT_WORD - len % SNAPSHOT_WORD) % SNAPSHOT_WORD;
+
+	*heap = array_grow(*heap, pad + n);
+	memset(*heap + len, 0, pad);
+
+	return len + pad;
+}
+
+// translate a value into its snapshot form
+// strings and arrays are moved to the heap and refer to it by offset
+static SIValue _HeapValue
+(
+	char **heap,
+	SIValue v
+) {
+	v.allocation = M_NONE;
+
+	if(v.type == T_STRING) {
+		size_t len = strlen(v.stringval) + 1;
+		uint64_t offset = _HeapReserve(heap, len);
+		memcpy(*heap + offset, v.stringval, len);
+		v.longval = offset;
+	} else if(v.type == T_ARRAY) {
+		// Format:
+		//  length
+		//  elements X length
+		//
+		// elements are translated first, as such nested values always
+		// precede the array referring to them
+
+		uint32_t len = SIArray_Length(v);
+		SIValue *elems = rm_malloc(sizeof(SIValue) * len);
+		for(uint32_t i = 0; i < len; i++) {
+			elems[i] = _HeapValue(heap, SIArray_Get(v, i));
+		}
+
+		uint64_t offset = _HeapReserve(heap,
+				sizeof(uint64_t) + sizeof(SIValue) * len);
+		uint64_t n = len;
+		memcpy(*heap + offset, &n, sizeof(uint64_t));
+		memcpy(*heap + offset + sizeof(uint64_t), elems, sizeof(SIValue) * len);
+
+		rm_free(elems);
+		v.longval = offset;
+	}
+
+	return v;
+}
+
+static void _SaveEntities
+(
+	SnapshotWriter *w,           // snapshot writer
+	char **heap,                 // heap for strings and arrays
+	DataBlockIterator *iter,     // entities iterator
+	uint64_t n,                  // number of entities
+	const uint64_t *deleted,     // deleted entity IDs
+	uint64_t deleted_count       // number of deleted entities
+) {
+	// Format:
+	//  #entities N
+	//  #deleted entities D
+	//  entity IDs             N X EntityID
+	//  deleted entity IDs     D X EntityID
+	//  #attributes            N X uint16 (padded to 8 bytes)
+	//  attributes             (#attributes X N) X Attribute
+
+	EntityID      *ids   = rm_malloc(sizeof(EntityID) * n);
+	uint16_t      *count = rm_malloc(sizeof(uint16_t) * n);
+	AttributeSet  *sets  = rm_malloc(sizeof(AttributeSet) * n);
+
+	for(uint64_t i = 0; i < n; i++) {
+		AttributeSet *set = (AttributeSet *)DataBlockIterator_Next(iter, ids + i);
+		ASSERT(set != NULL);
+
+		sets[i]  = *set;
+		count[i] = AttributeSet_Count(sets[i]);
+	}
+
+	_WriteU64(w, n);
+	_WriteU64(w, deleted_count);
+	_Write(w, ids, sizeof(EntityID) * n);
+	_Write(w, deleted, sizeof(EntityID) * deleted_count);
+	_Write(w, count, sizeof(uint16_t) * n);
+	_Pad(w, SNAPSHOT_WORD);
+
+	for(uint64_t i = 0; i < n; i++) {
+		for(uint16_t j = 0; j < count[i]; j++) {
+			// zero padding bytes, keeping the file deterministic
+			Attribute attr;
+			memset(&attr, 0, sizeof(Attribute));
+
+			SIValue v = AttributeSet_GetIdx(sets[i], j, &attr.id);
+			attr.value = _HeapValue(heap, v);
+
+			_Write(w, &attr, sizeof(Attribute));
+		}
+	}
+
+	rm_free(ids);
+	rm_free(sets);
+	rm_free(count);
+}
+
+static void _SaveIndex
+(
+	SnapshotWriter *w,
+	Index idx
+) {
+	// Format:
+	//  index type
+	//  #fields
+	//  {name, weight, nostem, phonetic} X #fields
+	//  language, #stopwords, stopword X #stopwords (full-text only)
+	//  dimension, similarity, M, efConstruction, efRuntime (vector only)
+
+	IndexType t = Index_Type(idx);
+	uint n = Index_FieldsCount(idx);
+	const IndexField *fields = Index_GetFields(idx);
+
+	_WriteU64(w, t);
+	_WriteU64(w, n);
+	for(uint i = 0; i < n; i++) {
+		const IndexField *f = fields + i;
+		_WriteString(w, f->name);
+		_Write(w, &f->weight, sizeof(double));
+		_WriteU64(w, f->nostem);
+		_WriteString(w, f->phonetic);
+	}
+
+	if(t == IDX_FULLTEXT) {
+		_WriteString(w, Index_GetLanguage(idx));
+
+		size_t stopwords_count;
+		char **stopwords = Index_GetStopwords(idx, &stopwords_count);
+		_WriteU64(w, stopwords_count);
+		for(size_t i = 0; i < stopwords_count; i++) {
+			_WriteString(w, stopwords[i]);
+			rm_free(stopwords[i]);
+		}
+		rm_free(stopwords);
+	} else if(t == IDX_VECTOR) {
+		const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+		_WriteU64(w, opts->dimension);
+		_WriteU64(w, opts->similarity);
+		_WriteU64(w, opts->M);
+		_WriteU64(w, opts->ef_construction);
+		_WriteU64(w, opts->ef_runtime);
+	}
+}
+
+static void _SaveSchema
+(
+	SnapshotWriter *w,
+	Schema *s
+) {
+	// Format:
+	//  name
+	//  #indices
+	//  index X #indices
+	//  #constraints
+	//  {type, #fields, field IDs} X #constraints
+
+	_WriteString(w, Schema_GetName(s));
+
+	// prefer pending indices over active ones, as done by the RDB encoder
+	Index indices[3] = {
+		PENDING_EXACTMATCH_IDX(s) ? PENDING_EXACTMATCH_IDX(s) : ACTIVE_EXACTMATCH_IDX(s),
+		PENDING_FULLTEXT_IDX(s)   ? PENDING_FULLTEXT_IDX(s)   : ACTIVE_FULLTEXT_IDX(s),
+		PENDING_VECTOR_IDX(s)     ? PENDING_VECTOR_IDX(s)     : ACTIVE_VECTOR_IDX(s)
+	};
+
+	uint64_t index_count = 0;
+	for(int i = 0; i < 3; i++) index_count += (indices[i] != NULL);
+
+	_WriteU64(w, index_count);
+	for(int i = 0; i < 3; i++) {
+		if(indices[i] != NULL) _SaveIndex(w, indices[i]);
+	}
+
+	// only active constraints are saved
+	uint64_t constraint_count = 0;
+	uint n = array_len(s->constraints);
+	for(uint i = 0; i < n; i++) {
+		constraint_count += Constraint_GetStatus(s->constraints[i]) == CT_ACTIVE;
+	}
+
+	_WriteU64(w, constraint_count);
+	for(uint i = 0; i < n; i++) {
+		Constraint c = s->constraints[i];
+		if(Constraint_GetStatus(c) != CT_ACTIVE) continue;
+
+		const Attribute_ID *attrs;
+		uint8_t field_count = Constraint_GetAttributes(c, &attrs, NULL);
+
+		_WriteU64(w, Constraint_GetType(c));
+		_WriteU64(w, field_count);
+		for(uint8_t j = 0; j < field_count; j++) _WriteU64(w, attrs[j]);
+	}
+}
+
+static void _SaveSchemas
+(
+	SnapshotWriter *w,
+	GraphContext *gc
+) {
+	// Format:
+	//  #attributes
+	//  attribute name X #attributes
+	//  #node schemas
+	//  node schema X #node schemas
+	//  #relation schemas
+	//  relation schema X #relation schemas
+
+	uint attr_count = GraphContext_AttributeCount(gc);
+	_WriteU64(w, attr_count);
+	for(uint i = 0; i < attr_count; i++) {
+		_WriteString(w, gc->string_mapping[i]);
+	}
+
+	SchemaType types[2] = {SCHEMA_NODE, SCHEMA_EDGE};
+	for(int t = 0; t < 2; t++) {
+		uint n = GraphContext_SchemaCount(gc, types[t]);
+		_WriteU64(w, n);
+		for(uint i = 0; i < n; i++) {
+			_SaveSchema(w, GraphContext_GetSchemaByID(gc, i, types[t]));
+		}
+	}
+}
+
+static void _SaveMatrix
+(
+	SnapshotWriter *w,
+	GrB_Descriptor desc,
+	RG_Matrix M,
+	bool multi_edge
+) {
+	// Format:
+	//  blob size
+	//  #multi-edge elements K
+	//  GxB_Matrix_serialize blob (padded to 8 bytes)
+	//  multi-edge entries K X uint64
+
+	GrB_Info   info;
+	GrB_Matrix m        = RG_MATRIX_M(M);
+	GrB_Matrix exported = NULL;
+
+	UNUSED(info);
+
+	// saving must not modify the graph, export pending changes to a copy
+	if(!RG_Matrix_Synced(M)) {
+		info = RG_Matrix_export(&exported, M);
+		ASSERT(info == GrB_SUCCESS);
+		m = exported;
+	}
+
+	void      *blob = NULL;
+	GrB_Index size  = 0;
+	info = GxB_Matrix_serialize(&blob, &size, m, desc);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint64_t *multi = multi_edge ? Serializer_Graph_PackMultiEdges(m) : NULL;
+	uint64_t multi_len = multi != NULL ? array_len(multi) : 0;
+
+	_WriteU64(w, size);
+	_WriteU64(w, multi_len);
+	_Write(w, blob, size);
+	_Pad(w, SNAPSHOT_WORD);
+	_Write(w, multi, sizeof(uint64_t) * multi_len);
+
+	rm_free(blob);
+	if(multi != NULL) array_free(multi);
+	if(exported != NULL) GrB_Matrix_free(&exported);
+}
+
+static void _SaveMatrices
+(
+	SnapshotWriter *w,
+	Graph *g
+) {
+	// Format:
+	//  #labels
+	//  #relations
+	//  label matrix X #labels
+	//  relation matrix X #relations
+	//
+	// matrices are serialized uncompressed, such that loading them
+	// is merely a copy out of the mapping
+
+	GrB_Descriptor desc;
+	GrB_Info info = GrB_Descriptor_new(&desc);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Desc_set(desc, GxB_COMPRESSION, GxB_COMPRESSION_NONE);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	uint label_count    = Graph_LabelTypeCount(g);
+	uint relation_count = Graph_RelationTypeCount(g);
+
+	_WriteU64(w, label_count);
+	_WriteU64(w, relation_count);
+
+	for(uint i = 0; i < label_count; i++) {
+		_SaveMatrix(w, desc, Graph_GetLabelMatrix(g, i), false);
+	}
+
+	for(uint i = 0; i < relation_count; i++) {
+		_SaveMatrix(w, desc, Graph_GetRelationMatrix(g, i, false),
+				Graph_RelationshipContainsMultiEdge(g, i, false));
+	}
+
+	GrB_free(&desc);
+}
+
+static void _SaveIndices
+(
+	SnapshotWriter *w,
+	GraphContext *gc
+) {
+	// Format:
+	//  #indices
+	//  {
+	//   label ID
+	//   serialized HNSW graph size
+	//   serialized HNSW graph (padded to 8 bytes)
+	//  } X #indices
+	//
+	// only active vector indices are saved, other indices are
+	// repopulated once the snapshot is loaded
+
+	uint64_t n = 0;
+	uint label_count = GraphContext_SchemaCount(gc, SCHEMA_NODE);
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		n += ACTIVE_VECTOR_IDX(s) != NULL;
+	}
+
+	_WriteU64(w, n);
+	for(uint i = 0; i < label_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, i, SCHEMA_NODE);
+		Index idx = ACTIVE_VECTOR_IDX(s);
+		if(idx == NULL) continue;
+
+		size_t size;
+		void *buffer = HNSW_Serialize(Index_HNSW(idx), &size);
+
+		_WriteU64(w, i);
+		_WriteU64(w, size);
+		_Write(w, buffer, size);
+		_Pad(w, SNAPSHOT_WORD);
+
+		rm_free(buffer);
+	}
+}
+
+int Snapshot_Save
+(
+	RedisModuleCtx *ctx,
+	GraphContext *gc,
+	const char *path
+) {
+	ASSERT(gc   != NULL);
+	ASSERT(ctx  != NULL);
+	ASSERT(path != NULL);
+
+	// saves may run concurrently, each writes to its own temporary file
+	static uint64_t _Atomic save_id = ATOMIC_VAR_INIT(0);
+
+	// write to a temporary file, replacing the target once complete
+	// a snapshot file in use by a loaded graph is never modified in place
+	size_t tmp_len = strlen(path) + 64;
+	char *tmp_path = rm_malloc(tmp_len);
+	snprintf(tmp_path, tmp_len, "%s.tmp-%d-%" PRIu64, path, getpid(),
+			save_id++);
+
+	FILE *f = fopen(tmp_path, "wb");
+	if(f == NULL) {
+		_FileError(ctx, "create", tmp_path);
+		rm_free(tmp_path);
+		return SNAPSHOT_FAIL;
+	}
+
+	Graph          *g      = gc->g;
+	char           *heap   = array_new(char, SNAPSHOT_ALIGN);
+	SnapshotWriter w       = {.f = f, .pos = 0, .failed = false};
+	SnapshotHeader header  = {0};
+
+	header.magic          = SNAPSHOT_MAGIC;
+	header.version        = SNAPSHOT_VERSION;
+	header.attribute_size = sizeof(Attribute);
+
+	// header is rewritten once the section table is known
+	_Write(&w, &header, sizeof(SnapshotHeader));
+
+	Graph_AcquireReadLock(g);
+
+	_BeginSection(&w, &header, SECTION_SCHEMA);
+	_SaveSchemas(&w, gc);
+	_EndSection(&w, &header, SECTION_SCHEMA);
+
+	DataBlockIterator *iter = Graph_ScanNodes(g);
+	_BeginSection(&w, &header, SECTION_NODES);
+	_SaveEntities(&w, &heap, iter, Graph_NodeCount(g),
+			Serializer_Graph_GetDeletedNodesList(g), Graph_DeletedNodeCount(g));
+	_EndSection(&w, &header, SECTION_NODES);
+	DataBlockIterator_Free(iter);
+
+	iter = Graph_ScanEdges(g);
+	_BeginSection(&w, &header, SECTION_EDGES);
+	_SaveEntities(&w, &heap, iter, Graph_EdgeCount(g),
+			Serializer_Graph_GetDeletedEdgesList(g), Graph_DeletedEdgeCount(g));
+	_EndSection(&w, &header, SECTION_EDGES);
+	DataBlockIterator_Free(iter);
+
+	// heap ends with a NUL, bounding strings to the section
+	_HeapReserve(&heap, SNAPSHOT_WORD);
+	memset(heap + array_len(heap) - SNAPSHOT_WORD, 0, SNAPSHOT_WORD);
+
+	_BeginSection(&w, &header, SECTION_HEAP);
+	_Write(&w, heap, array_len(heap));
+	_EndSection(&w, &header, SECTION_HEAP);
+	array_free(heap);
+
+	_BeginSection(&w, &header, SECTION_MATRICES);
+	_SaveMatrices(&w, g);
+	_EndSection(&w, &header, SECTION_MATRICES);
+
+	_BeginSection(&w, &header, SECTION_INDICES);
+	_SaveIndices(&w, gc);
+	_EndSection(&w, &header, SECTION_INDICES);
+
+	Graph_ReleaseLock(g);
+
+	// rewrite header
+	if(!w.failed && fseek(f, 0, SEEK_SET) != 0) w.failed = true;
+	_Write(&w, &header, sizeof(SnapshotHeader));
+
+	if(!w.failed && fflush(f) != 0)    w.failed = true;
+	if(!w.failed && fsync(fileno(f)))  w.failed = true;
+	if(fclose(f) != 0)                 w.failed = true;
+	if(!w.failed && rename(tmp_path, path) != 0) w.failed = true;
+
+	if(w.failed) {
+		_FileError(ctx, "write", path);
+		unlink(tmp_path);
+		rm_free(tmp_path);
+		return SNAPSHOT_FAIL;
+	}
+
+	rm_free(tmp_path);
+	return SNAPSHOT_OK;
+}
+
+//------------------------------------------------------------------------------
+// load
+//------------------------------------------------------------------------------
+
+typedef struct {
+	const char *p;    // read position
+	const char *end;  // section end
+	bool failed;      // read past the section's end
+} SnapshotReader;
+
+static SnapshotReader _Reader
+(
+	const char *data,
+	const SnapshotSection *section
+) {
+	return (SnapshotReader) {
+		.p      = data + section->offset,
+		.end    = data + section->offset + section->size,
+		.failed = false
+	};
+}
+
+// read n elements of the given size, returns NULL if out of bounds
+static const void *_ReadArray
+(
+	SnapshotReader *r,
+	uint64_t n,
+	size_t elem_size
+) {
+	if(r->failed || n > (uint64_t)(r->end - r->p) / elem_size) {
+		r->failed = true;
+		return NULL;
+	}
+
+	const void *v = r->p;
+	r->p += n * elem_size;
+	return v;
+}
+
+static uint64_t _ReadU64
+(
+	SnapshotReader *r
+) {
+	const uint64_t *v = _ReadArray(r, 1, sizeof(uint64_t));
+	return (v != NULL) ? *v : 0;
+}
+
+// skip padding up to the next 8 bytes boundary
+static void _Align
+(
+	SnapshotReader *r
+) {
+	_ReadArray(r, (SNAPSHOT_WORD - (uintptr_t)r->p % SNAPSHOT_WORD) %
+			SNAPSHOT_WORD, 1);
+}
+
+static const char *_ReadString
+(
+	SnapshotReader *r
+) {
+	uint64_t   len = _ReadU64(r);
+	const char *s  = _ReadArray(r, len, 1);
+	_Align(r);
+
+	if(s == NULL || len == 0 || s[len - 1] != '\0') {
+		r->failed = true;
+		return NULL;
+	}
+
+	return s;
+}
+
+static bool _LoadIndex
+(
+	SnapshotReader *r,
+	GraphContext *gc,
+	Schema *s
+) {
+	Index     idx = NULL;
+	IndexType t   = _ReadU64(r);
+	uint64_t  n   = _ReadU64(r);
+
+	if(t != IDX_EXACT_MATCH && t != IDX_FULLTEXT && t != IDX_VECTOR) {
+		return false;
+	}
+
+	if(n == 0 || (t == IDX_VECTOR && n != 1)) return false;
+
+	for(uint64_t i = 0; i < n && !r->failed; i++) {
+		const char   *name     = _ReadString(r);
+		const double *weight   = _ReadArray(r, 1, sizeof(double));
+		bool         nostem    = _ReadU64(r);
+		const char   *phonetic = _ReadString(r);
+
+		if(r->failed) return false;
+
+		IndexField field;
+		Attribute_ID id = GraphContext_FindOrAddAttribute(gc, name, NULL);
+		IndexField_New(&field, id, name, *weight, nostem, phonetic);
+		if(Schema_AddIndex(&idx, s, &field, t) != INDEX_OK) return false;
+	}
+
+	if(t == IDX_FULLTEXT) {
+		const char *language = _ReadString(r);
+		uint64_t   count     = _ReadU64(r);
+		if(r->failed) return false;
+
+		Index_SetLanguage(idx, language);
+
+		if(count > 0) {
+			char **stopwords = array_new(char *, count);
+			for(uint64_t i = 0; i < count && !r->failed; i++) {
+				const char *stopword = _ReadString(r);
+				if(stopword != NULL) array_append(stopwords, rm_strdup(stopword));
+			}
+			Index_SetStopwords(idx, stopwords);
+		}
+	} else if(t == IDX_VECTOR) {
+		VectorIndexOptions opts;
+		opts.dimension       = _ReadU64(r);
+		opts.similarity      = _ReadU64(r);
+		opts.M               = _ReadU64(r);
+		opts.ef_construction = _ReadU64(r);
+		opts.ef_runtime      = _ReadU64(r);
+		if(r->failed) return false;
+
+		Index_SetVectorOptions(idx, &opts);
+	}
+
+	if(r->failed) return false;
+
+	// disable and create index structure
+	// enabled once the graph is fully loaded
+	Index_Disable(idx);
+
+	return true;
+}
+
+static bool _LoadConstraint
+(
+	SnapshotReader *r,
+	GraphContext *gc,
+	Schema *s
+) {
+	ConstraintType t = _ReadU64(r);
+	uint64_t       n = _ReadU64(r);
+
+	if(r->failed || n == 0 || n > UINT8_MAX) return false;
+
+	Attribute_ID attr_ids[n];
+	const char *attr_strs[n];
+
+	for(uint64_t i = 0; i < n; i++) {
+		uint64_t attr = _ReadU64(r);
+		if(r->failed || attr >= GraphContext_AttributeCount(gc)) return false;
+
+		attr_ids[i]  = attr;
+		attr_strs[i] = GraphContext_GetAttributeString(gc, attr);
+	}
+
+	GraphEntityType et = (Schema_GetType(s) == SCHEMA_NODE) ?
+		GETYPE_NODE : GETYPE_EDGE;
+
+	Constraint c = Constraint_New((struct GraphContext *)gc, t, Schema_GetID(s),
+			attr_ids, attr_strs, n, et, NULL);
+	if(c == NULL) return false;
+
+	// only active constraints are saved
+	Constraint_SetStatus(c, CT_ACTIVE);
+	Schema_AddConstraint(s, c);
+
+	return true;
+}
+
+static bool _LoadSchemas
+(
+	SnapshotReader *r,
+	GraphContext *gc
+) {
+	uint64_t attr_count = _ReadU64(r);
+	for(uint64_t i = 0; i < attr_count && !r->failed; i++) {
+		const char *name = _ReadString(r);
+		if(name == NULL) return false;
+
+		// attribute IDs must match the saved graph's
+		if(GraphContext_FindOrAddAttribute(gc, name, NULL) != i) return false;
+	}
+
+	SchemaType types[2] = {SCHEMA_NODE, SCHEMA_EDGE};
+	for(int t = 0; t < 2; t++) {
+		uint64_t n = _ReadU64(r);
+		for(uint64_t i = 0; i < n && !r->failed; i++) {
+			const char *name = _ReadString(r);
+			if(name == NULL) return false;
+
+			Schema *s = GraphContext_AddSchema(gc, name, types[t]);
+
+			uint64_t index_count = _ReadU64(r);
+			for(uint64_t j = 0; j < index_count && !r->failed; j++) {
+				if(!_LoadIndex(r, gc, s)) return false;
+			}
+
+			uint64_t constraint_count = _ReadU64(r);
+			for(uint64_t j = 0; j < constraint_count && !r->failed; j++) {
+				if(!_LoadConstraint(r, gc, s)) return false;
+			}
+		}
+	}
+
+	return !r->failed;
+}
+
+// restore a value out of its snapshot form
+// strings point into the mapped heap, arrays are rebuilt on the heap
+// values referred to by v must precede limit within the heap
+static bool _RestoreValue
+(
+	const SnapshotSection *heap,  // heap section
+	const char *data,             // mapped file
+	SIValue *v,                   // value to restore
+	uint64_t limit                // heap offset bound
+) {
+	if(!(v->type & SI_VALID_PROPERTY_VALUE)) return false;
+
+	const char *base = data + heap->offset;
+	v->allocation    = M_NONE;
+
+	if(v->type == T_STRING) {
+		// heap ends with a NUL, strings are bounded by the section
+		if((uint64_t)v->longval >= limit) return false;
+		*v = SI_ConstStringVal(base + v->longval);
+	} else if(v->type == T_ARRAY) {
+		uint64_t offset = v->longval;
+		if(offset % SNAPSHOT_WORD != 0 || offset >= limit ||
+		   limit - offset < sizeof(uint64_t)) {
+			return false;
+		}
+
+		uint64_t len = *(const uint64_t *)(base + offset);
+		if(len > (limit - offset - sizeof(uint64_t)) / sizeof(SIValue)) {
+			return false;
+		}
+
+		const SIValue *elems =
+			(const SIValue *)(base + offset + sizeof(uint64_t));
+
+		SIValue list = SI_Array(len);
+		for(uint64_t i = 0; i < len; i++) {
+			// nested values precede the array
+			SIValue elem = elems[i];
+			if(!_RestoreValue(heap, data, &elem, offset)) {
+				SIArray_Free(list);
+				return false;
+			}
+
+			SIArray_Append(&list, elem);
+			SIValue_Free(elem);
+		}
+
+		*v = list;
+	}
+
+	return true;
+}
+
+static bool _LoadEntities
+(
+	SnapshotReader *r,            // section reader
+	GraphContext *gc,             // graph to populate
+	const SnapshotSection *heap,  // heap section
+	const char *data,             // mapped file
+	GraphEntityType t,            // entity type
+	uint64_t *count               // [output] number of loaded entities
+) {
+	Graph    *g             = gc->g;
+	uint64_t n              = _ReadU64(r);
+	uint64_t deleted_count  = _ReadU64(r);
+	uint     attr_count     = GraphContext_AttributeCount(gc);
+
+	const EntityID *ids     = _ReadArray(r, n, sizeof(EntityID));
+	const EntityID *deleted = _ReadArray(r, deleted_count, sizeof(EntityID));
+	const uint16_t *counts  = _ReadArray(r, n, sizeof(uint16_t));
+	_Align(r);
+
+	if(r->failed) return false;
+
+	uint64_t max_id = n + deleted_count;
+	if(t == GETYPE_NODE) {
+		Graph_AllocateNodes(g, max_id);
+	} else {
+		Graph_AllocateEdges(g, max_id);
+	}
+
+	Attribute *attrs = rm_malloc(sizeof(Attribute) * UINT16_MAX);
+
+	for(uint64_t i = 0; i < n; i++) {
+		uint16_t        attr_n = counts[i];
+		const Attribute *saved = _ReadArray(r, attr_n, sizeof(Attribute));
+
+		if(saved == NULL || ids[i] >= max_id) goto error;
+
+		// copy attributes out of the mapping and restore their values
+		for(uint16_t j = 0; j < attr_n; j++) {
+			attrs[j] = saved[j];
+			if(attrs[j].id >= attr_count ||
+			   !_RestoreValue(heap, data, &attrs[j].value, heap->size)) {
+				for(uint16_t k = 0; k < j; k++) SIValue_Free(attrs[k].value);
+				goto error;
+			}
+		}
+
+		AttributeSet *set;
+		if(t == GETYPE_NODE) {
+			Node node;
+			Serializer_Graph_SetNode(g, ids[i], NULL, 0, &node);
+			set = node.attributes;
+		} else {
+			Edge edge;
+			Serializer_Graph_AllocateEdge(g, ids[i], &edge);
+			set = edge.attributes;
+		}
+
+		*set = AttributeSet_FromAttributes(attrs, attr_n);
+	}
+
+	rm_free(attrs);
+
+	for(uint64_t i = 0; i < deleted_count; i++) {
+		if(deleted[i] >= max_id) return false;
+
+		if(t == GETYPE_NODE) {
+			Serializer_Graph_MarkNodeDeleted(g, deleted[i]);
+		} else {
+			Serializer_Graph_MarkEdgeDeleted(g, deleted[i]);
+		}
+	}
+
+	*count = n;
+	return true;
+
+error:
+	rm_free(attrs);
+	return false;
+}
+
+// returns true if 'id' refers to an existing edge
+static bool _ValidEdgeID
+(
+	const Graph *g,
+	uint64_t id
+) {
+	Edge e;
+	uint64_t cap = Graph_EdgeCount(g) + Graph_DeletedEdgeCount(g);
+	return id < cap && Graph_GetEdge(g, id, &e);
+}
+
+// validate relation matrix entries and install its multi-edge entries
+// multi-edge entries in the blob hold stale pointers, these are dropped
+// and replaced by the packed multi-edge entries which must match them one to one
+static bool _LoadRelationMatrix
+(
+	Graph *g,                // graph
+	GrB_Matrix m,            // deserialized relation matrix
+	const uint64_t *multi,   // packed multi-edge entries
+	uint64_t multi_len,      // length of packed multi-edge entries
+	GrB_Index dim,           // matrix dimension
+	GrB_Index *nvals         // [output] number of edges in matrix
+) {
+	GrB_Info  info;
+	GrB_Index n;
+	GrB_Index single;
+
+	info = GrB_Matrix_nvals(&n, m);
+	if(info != GrB_SUCCESS) return false;
+
+	info = GrB_Matrix_select_UINT64(m, NULL, NULL, GrB_VALUELT_UINT64, m,
+			MSB_MASK, NULL);
+	if(info != GrB_SUCCESS) return false;
+
+	info = GrB_Matrix_nvals(&single, m);
+	if(info != GrB_SUCCESS) return false;
+
+	// every single-edge entry must refer to an existing edge
+	uint64_t *vals = rm_malloc(sizeof(uint64_t) * (single + 1));
+	GrB_Index len  = single;
+	info = GrB_Matrix_extractTuples_UINT64(NULL, NULL, vals, &len, m);
+
+	bool valid = (info == GrB_SUCCESS);
+	for(GrB_Index i = 0; valid && i < len; i++) {
+		valid = _ValidEdgeID(g, vals[i]);
+	}
+	rm_free(vals);
+	if(!valid) return false;
+
+	*nvals = single;
+
+	// each multi-edge entry must replace a dropped entry
+	// entries are validated before any edge ID array is allocated
+	// positions are reserved with a placeholder to detect duplicates
+	uint64_t entries = 0;
+	for(uint64_t i = 0; i < multi_len;) {
+		if(multi_len - i < 3) return false;
+
+		uint64_t src   = multi[i];
+		uint64_t dest  = multi[i + 1];
+		uint64_t count = multi[i + 2];
+
+		if(src >= dim || dest >= dim) return false;
+		if(count < 2 || count > multi_len - i - 3) return false;
+
+		uint64_t v;
+		info = GrB_Matrix_extractElement_UINT64(&v, m, src, dest);
+		if(info != GrB_NO_VALUE) return false;
+
+		for(uint64_t j = 0; j < count; j++) {
+			if(!_ValidEdgeID(g, multi[i + 3 + j])) return false;
+		}
+
+		info = GrB_Matrix_setElement_UINT64(m, MSB_MASK, src, dest);
+		if(info != GrB_SUCCESS) return false;
+
+		*nvals += count;
+		entries++;
+		i += 3 + count;
+	}
+
+	if(entries != n - single) return false;
+
+	Serializer_Graph_UnpackMultiEdges(m, multi, multi_len);
+	return true;
+}
+
+static bool _LoadMatrices
+(
+	SnapshotReader *r,
+	Graph *g
+) {
+	uint64_t label_count    = _ReadU64(r);
+	uint64_t relation_count = _ReadU64(r);
+
+	if(r->failed ||
+	   label_count    != (uint64_t)Graph_LabelTypeCount(g) ||
+	   relation_count != (uint64_t)Graph_RelationTypeCount(g)) {
+		return false;
+	}
+
+	// matrices must match the graph's dimensions
+	GrB_Index dim = Graph_RequiredMatrixDim(g);
+
+	for(uint64_t i = 0; i < label_count + relation_count; i++) {
+		bool     label     = i < label_count;
+		uint64_t size      = _ReadU64(r);
+		uint64_t multi_len = _ReadU64(r);
+		const void *blob   = _ReadArray(r, size, 1);
+		_Align(r);
+		const uint64_t *multi = _ReadArray(r, multi_len, sizeof(uint64_t));
+
+		if(r->failed || (label && multi_len > 0)) return false;
+
+		// copy matrix out of the mapping
+		GrB_Matrix m = NULL;
+		GrB_Info info = GxB_Matrix_deserialize(&m,
+				label ? GrB_BOOL : GrB_UINT64, blob, size, NULL);
+		if(info != GrB_SUCCESS) return false;
+
+		GrB_Index nrows;
+		GrB_Index ncols;
+		GrB_Index nvals;
+		bool valid = GrB_Matrix_nrows(&nrows, m) == GrB_SUCCESS &&
+			GrB_Matrix_ncols(&ncols, m) == GrB_SUCCESS &&
+			nrows == dim && ncols == dim;
+
+		if(valid && !label) {
+			valid = _LoadRelationMatrix(g, m, multi, multi_len, dim, &nvals);
+		}
+
+		if(!valid) {
+			GrB_Matrix_free(&m);
+			return false;
+		}
+
+		if(label) {
+			Serializer_Graph_SetLabelMatrix(g, i, m);
+		} else {
+			Serializer_Graph_SetRelationMatrix(g, i - label_count, m, nvals);
+		}
+	}
+
+	return true;
+}
+
+// restore vector indices HNSW graphs
+// an index which fails to restore is repopulated
+static bool _LoadIndices
+(
+	SnapshotReader *r,
+	GraphContext *gc
+) {
+	uint64_t n = _ReadU64(r);
+
+	for(uint64_t i = 0; i < n && !r->failed; i++) {
+		uint64_t   label  = _ReadU64(r);
+		uint64_t   size   = _ReadU64(r);
+		const void *blob  = _ReadArray(r, size, 1);
+		_Align(r);
+
+		if(r->failed) return false;
+		if(label >= GraphContext_SchemaCount(gc, SCHEMA_NODE)) return false;
+
+		Schema *s = GraphContext_GetSchemaByID(gc, label, SCHEMA_NODE);
+		Index idx = PENDING_VECTOR_IDX(s);
+		if(idx == NULL) return false;
+
+		HNSW *hnsw = HNSW_Deserialize(blob, size);
+		const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+
+		if(hnsw != NULL &&
+		   HNSW_Dimension(hnsw)  == opts->dimension &&
+		   HNSW_Similarity(hnsw) == opts->similarity) {
+			Index_SetHNSW(idx, hnsw);
+		} else {
+			RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+					"Graph %s: inconsistent vector index contents, repopulating",
+					GraphContext_GetName(gc));
+			if(hnsw != NULL) HNSW_Free(hnsw);
+		}
+	}
+
+	return !r->failed;
+}
+
+// enable the schema's pending indices
+// restored vector indices are activated right away
+// all other indices are populated asynchronously by the indexer
+static void _EnableIndices
+(
+	GraphContext *gc,
+	Schema *s
+) {
+	Index vector = PENDING_VECTOR_IDX(s);
+	if(vector != NULL) {
+		GrB_Index nvals = 0;
+		if(Schema_GetType(s) == SCHEMA_NODE) {
+			RG_Matrix_nvals(&nvals, Graph_GetLabelMatrix(gc->g, Schema_GetID(s)));
+		}
+
+		// every indexed node must carry the indexed label
+		HNSW *hnsw = Index_HNSW(vector);
+		if(HNSW_Size(hnsw) > nvals) {
+			RedisModule_Log(NULL, REDISMODULE_LOGLEVEL_WARNING,
+					"Vector index over label %s holds unknown nodes, repopulating",
+					Schema_GetName(s));
+
+			const VectorIndexOptions *opts = Index_GetVectorOptions(vector);
+			hnsw = HNSW_New(opts->dimension, opts->similarity, opts->M,
+					opts->ef_construction);
+			Index_SetHNSW(vector, hnsw);
+		}
+
+		if(HNSW_Size(hnsw) > 0) {
+			Index_Enable(vector);
+			Schema_ActivateIndex(s, vector);
+		} else {
+			Indexer_PopulateIndex(gc, s, vector);
+		}
+	}
+
+	if(PENDING_EXACTMATCH_IDX(s) != NULL) {
+		Indexer_PopulateIndex(gc, s, PENDING_EXACTMATCH_IDX(s));
+	}
+
+	if(PENDING_FULLTEXT_IDX(s) != NULL) {
+		Indexer_PopulateIndex(gc, s, PENDING_FULLTEXT_IDX(s));
+	}
+}
+
+// validate snapshot header, returns NULL if the snapshot is malformed
+static const SnapshotHeader *_ValidateHeader
+(
+	const char *data,
+	uint64_t size
+) {
+	if(size < sizeof(SnapshotHeader)) return NULL;
+
+	const SnapshotHeader *header = (const SnapshotHeader *)data;
+
+	if(header->magic          != SNAPSHOT_MAGIC   ||
+	   header->version        != SNAPSHOT_VERSION ||
+	   header->attribute_size != sizeof(Attribute)) {
+		return NULL;
+	}
+
+	for(int i = 0; i < SECTION_COUNT; i++) {
+		const SnapshotSection *s = header->sections + i;
+		if(s->offset % SNAPSHOT_ALIGN != 0 || s->offset > size ||
+		   s->size > size - s->offset) {
+			return NULL;
+		}
+	}
+
+	// heap must end with a NUL
+	const SnapshotSection *heap = header->sections + SECTION_HEAP;
+	if(heap->size == 0 || data[heap->offset + heap->size - 1] != '\0') {
+		return NULL;
+	}
+
+	return header;
+}
+
+int Snapshot_Load
+(
+	RedisModuleCtx *ctx,
+	GraphContext *gc,
+	const char *path,
+	uint64_t *node_count,
+	uint64_t *edge_count
+) {
+	ASSERT(gc          != NULL);
+	ASSERT(ctx         != NULL);
+	ASSERT(path        != NULL);
+	ASSERT(node_count  != NULL);
+	ASSERT(edge_count  != NULL);
+	ASSERT(gc->snapshot == NULL);
+
+	*node_count = 0;
+	*edge_count = 0;
+
+	int fd = open(path, O_RDONLY);
+	if(fd == -1) {
+		_FileError(ctx, "open", path);
+		return SNAPSHOT_FAIL;
+	}
+
+	// only regular files are mapped
+	struct stat st;
+	int res = fstat(fd, &st);
+	if(res == 0 && !S_ISREG(st.st_mode)) {
+		res   = -1;
+		errno = EINVAL;
+	}
+
+	if(res == -1) {
+		_FileError(ctx, "open", path);
+		close(fd);
+		return SNAPSHOT_FAIL;
+	}
+
+	uint64_t size = st.st_size;
+	if(size == 0) {
+		RedisModule_ReplyWithError(ctx,
+				"Snapshot file format error, malformed header.");
+		close(fd);
+		return SNAPSHOT_FAIL;
+	}
+
+	// pages are read on demand and shared with the page cache
+	// the mapping is private, it is never written to
+	char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if(data == MAP_FAILED) {
+		_FileError(ctx, "map", path);
+		return SNAPSHOT_FAIL;
+	}
+
+	const SnapshotHeader *header = _ValidateHeader(data, size);
+	if(header == NULL) {
+		RedisModule_ReplyWithError(ctx,
+				"Snapshot file format error, malformed header.");
+		munmap(data, size);
+		return SNAPSHOT_FAIL;
+	}
+
+	// graph holds on to the mapping from this point on
+	// string attributes refer to it for as long as the graph lives
+	gc->snapshot = rm_malloc(sizeof(GraphSnapshot));
+	gc->snapshot->data = data;
+	gc->snapshot->size = size;
+
+	Graph *g = gc->g;
+	const SnapshotSection *sections = header->sections;
+	const SnapshotSection *heap     = sections + SECTION_HEAP;
+
+	// lock graph under write lock
+	// set graph sync policy to resize only
+	Graph_AcquireWriteLock(g);
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
+
+	SnapshotReader schema   = _Reader(data, sections + SECTION_SCHEMA);
+	SnapshotReader nodes    = _Reader(data, sections + SECTION_NODES);
+	SnapshotReader edges    = _Reader(data, sections + SECTION_EDGES);
+	SnapshotReader matrices = _Reader(data, sections + SECTION_MATRICES);
+	SnapshotReader indices  = _Reader(data, sections + SECTION_INDICES);
+
+	bool ok = _LoadSchemas(&schema, gc)                                    &&
+		_LoadEntities(&nodes, gc, heap, data, GETYPE_NODE, node_count)     &&
+		_LoadEntities(&edges, gc, heap, data, GETYPE_EDGE, edge_count);
+
+	if(ok) {
+		// matrices dimensions must match the graph's prior to being set
+		Graph_ApplyAllPending(g, true);
+		ok = _LoadMatrices(&matrices, g) && _LoadIndices(&indices, gc);
+	}
+
+	if(ok) {
+		// set the node label and adjacency matrices
+		Serializer_Graph_SetNodeLabels(g);
+		Serializer_Graph_SetAdjacencyMatrix(g);
+
+		// flush graph matrices
+		Graph_ApplyAllPending(g, true);
+
+		// update the node statistics
+		uint label_count = Graph_LabelTypeCount(g);
+		for(uint i = 0; i < label_count; i++) {
+			GrB_Index nvals;
+			RG_Matrix_nvals(&nvals, Graph_GetLabelMatrix(g, i));
+			GraphStatistics_IncNodeCount(&g->stats, i, nvals);
+		}
+	}
+
+	// reset graph sync policy
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_FLUSH_RESIZE);
+	Graph_ReleaseLock(g);
+
+	if(!ok) {
+		RedisModule_ReplyWithError(ctx,
+				"Snapshot file format error, malformed section.");
+		return SNAPSHOT_FAIL;
+	}
+
+	// enable indices once the graph lock is released
+	// as the indexer acquires it while populating
+	SchemaType types[2] = {SCHEMA_NODE, SCHEMA_EDGE};
+	for(int t = 0; t < 2; t++) {
+		uint n = GraphContext_SchemaCount(gc, types[t]);
+		for(uint i = 0; i < n; i++) {
+			_EnableIndices(gc, GraphContext_GetSchemaByID(gc, i, types[t]));
+		}
+	}
+
+	return SNAPSHOT_OK;
+}
+
+void Snapshot_Free
+(
+	GraphSnapshot *snapshot
+) {
+	ASSERT(snapshot != NULL);
+
+	munmap(snapshot->data, snapshot->size);
+	rm_free(snapshot);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../redismodule.h"
+#include "../graph/graphcontext.h"
+
+// a snapshot is a read-only file holding a graph in a layout mirroring
+// its in-memory structures, the file is memory-mapped when loaded
+// such that loading doesn't parse or rebuild the graph:
+//
+// 1. string attributes point directly into the mapping
+// 2. attribute-sets and matrices are copied out of the mapping as is
+// 3. vector indices are restored from their persisted HNSW graphs
+//
+// a loaded snapshot is kept mapped for the lifetime of its graph
+// values modified after load are allocated on the heap, replacing
+// their mapped counterparts, the mapping itself is never written to
+
+#define SNAPSHOT_OK 1
+#define SNAPSHOT_FAIL 0
+
+typedef struct GraphSnapshot GraphSnapshot;
+
+// save graph to a snapshot file
+// the file is written to a temporary path and renamed once complete
+// the graph is read locked for the duration of the write, callers are
+// expected to save from a worker thread rather than Redis main thread
+// returns SNAPSHOT_OK on success, otherwise an error is emitted
+int Snapshot_Save
+(
+	RedisModuleCtx *ctx,  // redis context, used for error replies
+	GraphContext *gc,     // graph to save
+	const char *path      // snapshot file path
+);
+
+// load a snapshot file into an empty graph
+// on success the graph holds on to the snapshot's mapping
+// on failure the graph might be partially loaded, an error is emitted
+int Snapshot_Load
+(
+	RedisModuleCtx *ctx,  // redis context, used for error replies
+	GraphContext *gc,     // empty graph to populate
+	const char *path,     // snapshot file path
+	uint64_t *node_count, // [output] number of loaded nodes
+	uint64_t *edge_count  // [output] number of loaded edges
+);
+
+// unmap snapshot
+// must be called once the graph referring to it is freed
+void Snapshot_Free
+(
+	GraphSnapshot *snapshot  // snapshot to free
+);
@@ -261,6 +261,37 @@ void SlowLog_Clear
 	}
 }
 
+// returns number of bytes used by slowlog entries
+size_t SlowLog_MemoryUsage
+(
+	SlowLog *slowlog  // slowlog to inspect
+) {
+	ASSERT(slowlog != NULL);
+
+	size_t n = sizeof(SlowLog) + slowlog->count *
+		(sizeof(pthread_mutex_t) + sizeof(rax *) + sizeof(heap_t *));
+
+	for(int t_id = 0; t_id < slowlog->count; t_id++) {
+		// enter critical section
+		if(pthread_mutex_lock(slowlog->locks + t_id) != 0) continue;
+
+		raxIterator iter;
+		raxStart(&iter, slowlog->lookup[t_id]);
+		raxSeek(&iter, "^", NULL, 0);
+		while(raxNext(&iter)) {
+			SlowLogItem *item = iter.data;
+			n += sizeof(SlowLogItem) + strlen(item->cmd) + 1 +
+				strlen(item->query) + 1 + iter.key_len;
+		}
+		raxStop(&iter);
+
+		// end of critical section
+		pthread_mutex_unlock(slowlog->locks + t_id);
+	}
+
+	return n;
+}
+
 void SlowLog_Replay
 (
 	const SlowLog *slowlog,
@@ -49,6 +49,12 @@ void SlowLog_Clear
 	SlowLog *slowlog  // slowlog to clear
 );
 
+// returns number of bytes used by slowlog entries
+size_t SlowLog_MemoryUsage
+(
+	SlowLog *slowlog  // slowlog to inspect
+);
+
 // Replies with slow log content.
 void SlowLog_Replay
 (
@@ -111,10 +111,7 @@ static void _UndoLog_Restore_Entity_Property
 	Attribute_ID attr_id,
 	SIValue value
 ) {
-	// try to get current attribute value
-	SIValue *old_value = GraphEntity_GetProperty(ge, attr_id);
-
-	if(old_value == ATTRIBUTE_NOTFOUND) {
+	if(!AttributeSet_Contains(*ge->attributes, attr_id)) {
 		// adding a new attribute; do nothing if its value is NULL
 		if(SI_TYPE(value) != T_NULL) {
 			AttributeSet_AddNoClone(ge->attributes, &attr_id, &value, 1, false);
@@ -240,6 +240,22 @@ void *CircularBuffer_Reserve
 	return cb->data + offset;
 }
 
+// returns oldest item in buffer without removing it
+// returns NULL if buffer is empty
+// note: this function is not thread-safe
+void *CircularBuffer_Peek
+(
+	const CircularBuffer cb  // buffer to inspect
+) {
+	ASSERT(cb != NULL);
+
+	if(unlikely(CircularBuffer_Empty(cb))) {
+		return NULL;
+	}
+
+	return cb->read;
+}
+
 // read oldest item from buffer
 // note: this function is not thread-safe
 void *CircularBuffer_Read
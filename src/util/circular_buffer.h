@@ -71,6 +71,13 @@ void *CircularBuffer_Read
 	void *item          // [optional] pointer populated with removed item
 );
 
+// returns oldest item in buffer without removing it
+// returns NULL if buffer is empty
+void *CircularBuffer_Peek
+(
+	const CircularBuffer cb  // buffer to inspect
+);
+
 // sets the read pointer to the beginning of the buffer
 void CircularBuffer_ResetReader
 (
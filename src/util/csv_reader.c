@@ -0,0 +1,273 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "csv_reader.h"
+#include "arr.h"
+#include "rmalloc.h"
+#include "strsimd.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// number of consumed bytes after which pages behind the reader are released
+#define CSV_RELEASE_THRESHOLD (64 * 1024 * 1024)
+
+struct CSVReader {
+	const char *data;   // mapped file
+	size_t size;        // file size
+	size_t pos;         // current position within the file
+	size_t released;    // offset up to which pages were released
+	size_t row;         // number of the last row read
+	char delimiter;     // field delimiter
+	CSVField *fields;   // current row fields
+};
+
+CSVReader *CSVReader_New
+(
+	const char *path,
+	char delimiter
+) {
+	ASSERT(path != NULL);
+
+	int fd = open(path, O_RDONLY);
+	if(fd == -1) return NULL;
+
+	struct stat st;
+	if(fstat(fd, &st) == -1) {
+		close(fd);
+		return NULL;
+	}
+
+	if(!S_ISREG(st.st_mode)) {
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	const char *data = NULL;
+	size_t size = st.st_size;
+
+	if(size > 0) {
+		data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED) {
+			close(fd);
+			return NULL;
+		}
+		madvise((void *)data, size, MADV_SEQUENTIAL);
+	}
+
+	close(fd);
+
+	CSVReader *reader = rm_malloc(sizeof(CSVReader));
+
+	reader->data      = data;
+	reader->size      = size;
+	reader->pos       = 0;
+	reader->released  = 0;
+	reader->row       = 0;
+	reader->delimiter = delimiter;
+	reader->fields    = array_new(CSVField, 16);
+
+	// skip UTF-8 byte order mark
+	if(size >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) reader->pos = 3;
+
+	return reader;
+}
+
+// release pages which were fully consumed
+static void _CSVReader_Release
+(
+	CSVReader *reader
+) {
+	if(reader->pos - reader->released < CSV_RELEASE_THRESHOLD) return;
+
+	size_t page_size = sysconf(_SC_PAGESIZE);
+	size_t to = reader->pos & ~(page_size - 1);
+
+	madvise((void *)(reader->data + reader->released), to - reader->released,
+			MADV_DONTNEED);
+	reader->released = to;
+}
+
+// read a quoted field starting at reader's position
+// returns false if the closing quote is missing
+static bool _CSVReader_QuotedField
+(
+	CSVReader *reader,
+	CSVField *field
+) {
+	const char *data = reader->data;
+	size_t end = reader->size;
+	size_t i = reader->pos + 1;  // skip opening quote
+
+	field->str     = data + i;
+	field->quoted  = true;
+	field->escaped = false;
+
+	while(true) {
+		const char *q = memchr(data + i, '"', end - i);
+		if(q == NULL) return false;
+
+		i = q - data;
+
+		// escaped quote
+		if(i + 1 < end && data[i + 1] == '"') {
+			field->escaped = true;
+			i += 2;
+			continue;
+		}
+
+		field->len  = (data + i) - field->str;
+		reader->pos = i + 1;  // skip closing quote
+		return true;
+	}
+}
+
+// read an unquoted field starting at reader's position
+static void _CSVReader_Field
+(
+	CSVReader *reader,
+	CSVField *field
+) {
+	const char *start = reader->data + reader->pos;
+	size_t remaining = reader->size - reader->pos;
+
+	const char *p = str_find_either(start, remaining, reader->delimiter, '\n');
+	size_t len = (p != NULL) ? (size_t)(p - start) : remaining;
+
+	field->str     = start;
+	field->quoted  = false;
+	field->escaped = false;
+	reader->pos   += len;
+
+	// strip carriage return of CRLF line endings
+	if(len > 0 && start[len - 1] == '\r' && (p == NULL || *p == '\n')) len--;
+
+	field->len = len;
+}
+
+CSVReaderStatus CSVReader_NextRow
+(
+	CSVReader *reader,
+	const CSVField **fields,
+	uint *nfields
+) {
+	ASSERT(reader  != NULL);
+	ASSERT(fields  != NULL);
+	ASSERT(nfields != NULL);
+
+	const char *data = reader->data;
+	size_t size = reader->size;
+
+	_CSVReader_Release(reader);
+
+next_row:
+	array_clear(reader->fields);
+	if(reader->pos >= size) return CSV_EOF;
+
+	reader->row++;
+
+	while(true) {
+		CSVField field;
+
+		if(data[reader->pos] == '"') {
+			if(!_CSVReader_QuotedField(reader, &field)) return CSV_ERROR;
+
+			// allow a carriage return prior to the line ending
+			if(reader->pos < size && data[reader->pos] == '\r' &&
+			   reader->pos + 1 < size && data[reader->pos + 1] == '\n') {
+				reader->pos++;
+			}
+		} else {
+			_CSVReader_Field(reader, &field);
+		}
+
+		array_append(reader->fields, field);
+
+		// end of file
+		if(reader->pos >= size) break;
+
+		char c = data[reader->pos++];
+
+		// end of row
+		if(c == '\n') break;
+
+		// data following a closing quote
+		if(c != reader->delimiter) return CSV_ERROR;
+
+		// delimiter at end of file introduces a trailing empty field
+		if(reader->pos >= size) {
+			field = (CSVField){data + size, 0, false, false};
+			array_append(reader->fields, field);
+			break;
+		}
+	}
+
+	// skip blank lines
+	if(array_len(reader->fields) == 1 && reader->fields[0].len == 0 &&
+	   !reader->fields[0].quoted) {
+		goto next_row;
+	}
+
+	*fields  = reader->fields;
+	*nfields = array_len(reader->fields);
+
+	return CSV_ROW;
+}
+
+size_t CSVReader_RowNumber
+(
+	const CSVReader *reader
+) {
+	ASSERT(reader != NULL);
+	return reader->row;
+}
+
+size_t CSVField_Copy
+(
+	const CSVField *field,
+	char *dst
+) {
+	ASSERT(field != NULL);
+	ASSERT(dst   != NULL);
+
+	if(!field->escaped) {
+		memcpy(dst, field->str, field->len);
+		dst[field->len] = '\0';
+		return field->len;
+	}
+
+	// collapse escaped quotes
+	size_t n = 0;
+	for(size_t i = 0; i < field->len; i++) {
+		dst[n++] = field->str[i];
+		if(field->str[i] == '"') i++;
+	}
+	dst[n] = '\0';
+
+	return n;
+}
+
+void CSVReader_Free
+(
+	CSVReader **reader
+) {
+	ASSERT(reader != NULL);
+
+	CSVReader *r = *reader;
+	if(r == NULL) return;
+
+	if(r->data != NULL) munmap((void *)r->data, r->size);
+	array_free(r->fields);
+	rm_free(r);
+
+	*reader = NULL;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+// streaming CSV reader
+//
+// the file is memory-mapped and tokenized in place, fields point directly
+// into the mapping and remain valid until the next row is read
+// pages behind the reader are released as it advances, keeping memory
+// consumption bounded regardless of file size
+
+typedef struct CSVReader CSVReader;
+
+// a single field within a row
+typedef struct {
+	const char *str;  // field content, not NULL terminated
+	size_t len;       // field length in bytes
+	bool quoted;      // field was enclosed in quotes
+	bool escaped;     // field contains escaped ("") quotes
+} CSVField;
+
+typedef enum {
+	CSV_ROW,    // a row was read
+	CSV_EOF,    // no more rows
+	CSV_ERROR,  // malformed row
+} CSVReaderStatus;
+
+// open CSV file for reading
+// returns NULL and sets errno on failure
+CSVReader *CSVReader_New
+(
+	const char *path,  // path to CSV file
+	char delimiter     // field delimiter
+);
+
+// read next row
+CSVReaderStatus CSVReader_NextRow
+(
+	CSVReader *reader,        // reader
+	const CSVField **fields,  // [output] row fields
+	uint *nfields             // [output] number of fields
+);
+
+// number of the last row read, starting at 1
+size_t CSVReader_RowNumber
+(
+	const CSVReader *reader  // reader
+);
+
+// copy field content into dst, unescaping quotes
+// dst must be able to hold field->len + 1 bytes
+// returns number of bytes written, excluding the NULL terminator
+size_t CSVField_Copy
+(
+	const CSVField *field,  // field to copy
+	char *dst               // destination buffer
+);
+
+// close reader
+void CSVReader_Free
+(
+	CSVReader **reader  // reader to free
+);
@@ -220,6 +220,17 @@ void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx) {
 	dataBlock->itemCount--;
 }
 
+void DataBlock_DeleteItems(DataBlock *dataBlock, const uint64_t *idx, uint64_t n) {
+	ASSERT(dataBlock != NULL);
+	ASSERT(n == 0 || idx != NULL);
+
+	// reserve room for the freed indices up front.
+	dataBlock->deletedIdx = array_ensure_cap(dataBlock->deletedIdx,
+			array_len(dataBlock->deletedIdx) + n);
+
+	for(uint64_t i = 0; i < n; i++) DataBlock_DeleteItem(dataBlock, idx[i]);
+}
+
 uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock) {
 	return array_len(dataBlock->deletedIdx);
 }
@@ -259,6 +270,25 @@ void DataBlock_MarkAsDeletedOutOfOrder
 	array_append(dataBlock->deletedIdx, idx);
 }
 
+void DataBlock_MemoryUsage
+(
+	const DataBlock *dataBlock,   // datablock to inspect
+	DataBlockMemoryUsage *usage   // [output] memory usage
+) {
+	ASSERT(usage     != NULL);
+	ASSERT(dataBlock != NULL);
+
+	uint64_t deleted = array_len(dataBlock->deletedIdx);
+	uint64_t unused  = dataBlock->itemCap - dataBlock->itemCount - deleted;
+
+	usage->used     = dataBlock->itemCount * dataBlock->itemSize;
+	usage->deleted  = deleted * dataBlock->itemSize;
+	usage->slack    = unused  * dataBlock->itemSize;
+	usage->overhead = sizeof(DataBlock)                          +
+		dataBlock->blockCount * (sizeof(Block) + sizeof(Block *)) +
+		array_sizeof(array_hdr(dataBlock->deletedIdx));
+}
+
 void DataBlock_Free(DataBlock *dataBlock) {
 	for(uint i = 0; i < dataBlock->blockCount; i++) Block_Free(dataBlock->blocks[i]);
 
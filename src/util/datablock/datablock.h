@@ -94,12 +94,30 @@ void *DataBlock_AllocateItem(DataBlock *dataBlock, uint64_t *idx);
 // Removes item at position idx.
 void DataBlock_DeleteItem(DataBlock *dataBlock, uint64_t idx);
 
+// Removes items at positions idx[0..n).
+void DataBlock_DeleteItems(DataBlock *dataBlock, const uint64_t *idx, uint64_t n);
+
 // Returns the number of deleted items.
 uint DataBlock_DeletedItemsCount(const DataBlock *dataBlock);
 
 // Returns true if the given item has been deleted.
 bool DataBlock_ItemIsDeleted(void *item);
 
+// memory held by a datablock, broken down by slot state
+typedef struct {
+	size_t used;      // bytes held by live items
+	size_t deleted;   // bytes held by deleted items awaiting reuse
+	size_t slack;     // bytes allocated for items yet to be created
+	size_t overhead;  // block headers and bookkeeping
+} DataBlockMemoryUsage;
+
+// computes the number of bytes held by datablock
+void DataBlock_MemoryUsage
+(
+	const DataBlock *dataBlock,   // datablock to inspect
+	DataBlockMemoryUsage *usage   // [output] memory usage
+);
+
 // Free block.
 void DataBlock_Free(DataBlock *block);
 
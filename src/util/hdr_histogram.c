@@ -0,0 +1,123 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "hdr_histogram.h"
+
+#include <string.h>
+
+// returns the bucket a value falls into
+static inline uint _HdrHistogram_Bucket
+(
+	uint64_t v  // value
+) {
+	if(v < HDR_SUB_BUCKET_COUNT) return v;
+
+	// magnitude of v, at least HDR_SUB_BUCKET_BITS
+	uint m = 63 - __builtin_clzll(v);
+
+	// keep the HDR_SUB_BUCKET_BITS most significant bits of v
+	uint shift = m - (HDR_SUB_BUCKET_BITS - 1);
+
+	return HDR_SUB_BUCKET_COUNT + (shift - 1) * HDR_SUB_BUCKET_HALF +
+		(v >> shift) - HDR_SUB_BUCKET_HALF;
+}
+
+// returns the highest value which falls into bucket
+static inline uint64_t _HdrHistogram_BucketMax
+(
+	uint b  // bucket
+) {
+	if(b < HDR_SUB_BUCKET_COUNT) return b;
+
+	b -= HDR_SUB_BUCKET_COUNT;
+	uint shift = b / HDR_SUB_BUCKET_HALF + 1;
+	uint64_t sub = b % HDR_SUB_BUCKET_HALF + HDR_SUB_BUCKET_HALF;
+
+	return ((sub + 1) << shift) - 1;
+}
+
+void HdrHistogram_Record
+(
+	HdrHistogram *h,  // histogram
+	uint64_t v        // value to record
+) {
+	ASSERT(h != NULL);
+
+	if(v > HDR_MAX_VALUE) v = HDR_MAX_VALUE;
+
+	__atomic_fetch_add(h->buckets + _HdrHistogram_Bucket(v), 1,
+			__ATOMIC_RELAXED);
+	__atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&h->sum, v, __ATOMIC_RELAXED);
+
+	// raise max, retry if a concurrent update raced us
+	uint64_t max = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+	while(v > max && !__atomic_compare_exchange_n(&h->max, &max, v, true,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+void HdrHistogram_Merge
+(
+	HdrHistogram *dest,       // histogram to update
+	const HdrHistogram *src   // histogram to add
+) {
+	ASSERT(src  != NULL);
+	ASSERT(dest != NULL);
+
+	dest->count += __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+	dest->sum   += __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+
+	uint64_t max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+	if(max > dest->max) dest->max = max;
+
+	for(uint i = 0; i < HDR_BUCKET_COUNT; i++) {
+		dest->buckets[i] += __atomic_load_n(src->buckets + i, __ATOMIC_RELAXED);
+	}
+}
+
+void HdrHistogram_Reset
+(
+	HdrHistogram *h  // histogram to clear
+) {
+	ASSERT(h != NULL);
+
+	__atomic_store_n(&h->count, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&h->sum, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&h->max, 0, __ATOMIC_RELAXED);
+
+	for(uint i = 0; i < HDR_BUCKET_COUNT; i++) {
+		__atomic_store_n(h->buckets + i, 0, __ATOMIC_RELAXED);
+	}
+}
+
+uint64_t HdrHistogram_Percentile
+(
+	const HdrHistogram *h,  // histogram
+	double p                // percentile
+) {
+	ASSERT(h != NULL);
+	ASSERT(p >= 0 && p <= 1);
+
+	// buckets are updated one by one, their sum might differ from count
+	uint64_t n = 0;
+	for(uint i = 0; i < HDR_BUCKET_COUNT; i++) n += h->buckets[i];
+	if(n == 0) return 0;
+
+	uint64_t rank = p * n;
+	if(rank == 0) rank = 1;
+
+	uint64_t seen = 0;
+	for(uint i = 0; i < HDR_BUCKET_COUNT; i++) {
+		seen += h->buckets[i];
+		if(seen >= rank) {
+			uint64_t v = _HdrHistogram_BucketMax(i);
+			return (h->max > 0 && v > h->max) ? h->max : v;
+		}
+	}
+
+	return h->max;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// high dynamic range histogram
+// values are split into power of two ranges, each range is divided into
+// HDR_SUB_BUCKET_HALF linear sub buckets, bounding the relative error of a
+// reported value to 1 / HDR_SUB_BUCKET_HALF (~6%)
+//
+// values smaller than HDR_SUB_BUCKET_COUNT are recorded exactly
+// values greater than HDR_MAX_VALUE are recorded as HDR_MAX_VALUE
+//
+// recording uses relaxed atomics, a histogram can be updated concurrently
+
+#define HDR_SUB_BUCKET_BITS  5
+#define HDR_SUB_BUCKET_COUNT (1 << HDR_SUB_BUCKET_BITS)
+#define HDR_SUB_BUCKET_HALF  (HDR_SUB_BUCKET_COUNT >> 1)
+#define HDR_MAX_MAGNITUDE    40  // values up to 2^40
+#define HDR_MAX_VALUE        ((1ULL << HDR_MAX_MAGNITUDE) - 1)
+
+// number of buckets
+#define HDR_BUCKET_COUNT \
+	(HDR_SUB_BUCKET_COUNT + \
+	 (HDR_MAX_MAGNITUDE - HDR_SUB_BUCKET_BITS) * HDR_SUB_BUCKET_HALF)
+
+typedef struct {
+	uint64_t count;                    // number of recorded values
+	uint64_t sum;                      // sum of recorded values
+	uint64_t max;                      // largest recorded value
+	uint64_t buckets[HDR_BUCKET_COUNT];  // value counts
+} HdrHistogram;
+
+// record value
+void HdrHistogram_Record
+(
+	HdrHistogram *h,  // histogram
+	uint64_t v        // value to record
+);
+
+// add src's counts to dest
+void HdrHistogram_Merge
+(
+	HdrHistogram *dest,       // histogram to update
+	const HdrHistogram *src   // histogram to add
+);
+
+// clear histogram
+void HdrHistogram_Reset
+(
+	HdrHistogram *h  // histogram to clear
+);
+
+// returns the value at the p-th percentile, p is in the range [0, 1]
+// the returned value is the highest value equivalent to the percentile's
+// bucket, capped by the largest recorded value
+uint64_t HdrHistogram_Percentile
+(
+	const HdrHistogram *h,  // histogram
+	double p                // percentile
+);
@@ -0,0 +1,48 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rmalloc.h"
+#include "import_folder.h"
+#include "../configuration/config.h"
+
+#include <string.h>
+
+char *ImportFolder_ResolvePath
+(
+	const char *path  // path relative to the import folder
+) {
+	ASSERT(path != NULL);
+
+	// skip root
+	while(*path == '/') path++;
+
+	// reject parent directory components, preventing access to files
+	// outside of the import folder
+	const char *component = path;
+	while(true) {
+		const char *end = strchr(component, '/');
+		size_t len = (end != NULL) ? (size_t)(end - component) : strlen(component);
+		if(len == 2 && component[0] == '.' && component[1] == '.') return NULL;
+		if(end == NULL) break;
+		component = end + 1;
+	}
+
+	const char *folder;
+	bool found = Config_Option_get(Config_IMPORT_FOLDER, &folder);
+	ASSERT(found == true);
+	UNUSED(found);
+
+	// import folder is always terminated by a '/'
+	size_t folder_len = strlen(folder);
+	size_t path_len   = strlen(path);
+	char *resolved    = rm_malloc(folder_len + path_len + 1);
+
+	memcpy(resolved, folder, folder_len);
+	memcpy(resolved + folder_len, path, path_len + 1);
+
+	return resolved;
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// resolve a path within the import folder
+// leading '/' characters are ignored, both "/a/b.csv" and "a/b.csv"
+// resolve to <IMPORT_FOLDER>/a/b.csv
+// returns NULL if the path contains a parent directory component
+// which might lead outside of the import folder
+// caller is responsible for freeing the returned path
+char *ImportFolder_ResolvePath
+(
+	const char *path  // path relative to the import folder
+);
@@ -4,10 +4,12 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
+#include "RG.h"
 #include "rmalloc.h"
-
 #include "../errors/errors.h"
 
+#include <pthread.h>
+
 #ifdef REDIS_MODULE_TARGET /* Set this when compiling your code as a module */
 
 // amount of memory allocated for currently executed query thread_local counter
@@ -19,8 +21,21 @@
 // actual allocated size from 'n_alloced' which can lead to negative values if
 // bytes requested < bytes allocated
 static __thread int64_t n_alloced;
+static __thread int64_t n_alloced_peak;  // maximum value 'n_alloced' reached
 static int64_t mem_capacity;  // maximum memory consumption for thread
 
+// allocation statistics currently charged by this thread, NULL if none
+static __thread rm_alloc_stats *alloc_stats;
+
+// number of threads attributing allocations to statistics
+static uint32_t n_stats_users;
+
+// true if the tracking allocator is installed
+static bool tracking;
+
+// serializes allocator installation
+static pthread_mutex_t tracking_lock = PTHREAD_MUTEX_INITIALIZER;
+
 // function pointers which hold the original address of RedisModule_Alloc*
 static void (*RedisModule_Free_Orig)(void *ptr);
 static void * (*RedisModule_Alloc_Orig)(size_t bytes);
@@ -29,25 +44,47 @@ static void * (*RedisModule_Realloc_Orig)(void *ptr, size_t bytes);
 static void * (*RedisModule_Calloc_Orig)(size_t nmemb, size_t size);
 
 void rm_reset_n_alloced() {
-	n_alloced = 0;
+	n_alloced      = 0;
+	n_alloced_peak = 0;
+}
+
+int64_t rm_n_alloced_peak(void) {
+	return n_alloced_peak;
 }
 
 // removes n_bytes from thread memory consumption
 static inline void _nmalloc_decrement(int64_t n_bytes) {
 	n_alloced -= n_bytes;
+
+	if(alloc_stats != NULL) alloc_stats->live -= n_bytes;
 }
 
 // adds nbytes to thread memory consumption
 static inline void _nmalloc_increment(int64_t n_bytes) {
+	rm_alloc_stats *stats = alloc_stats;
+	if(stats != NULL) {
+		stats->count++;
+		stats->allocated += n_bytes;
+		stats->live      += n_bytes;
+		if(stats->live > stats->peak) stats->peak = stats->live;
+	}
+
 	n_alloced += n_bytes;
+	if(n_alloced > n_alloced_peak) n_alloced_peak = n_alloced;
+
 	// check if capacity exceeded
-	if(n_alloced > mem_capacity) {
+	if(mem_capacity > 0 && n_alloced > mem_capacity) {
 		// set n_alloced to MIN to avoid further out of memory exceptions
 		// TODO: consider switching to double -inf
 		n_alloced = INT32_MIN;
 
 		// throw exception cause memory limit exceeded
-		ErrorCtx_SetError(EMSG_QUERY_MEM_CONSUMPTION);
+		// name the operation which was allocating if known
+		if(stats != NULL && stats->owner != NULL) {
+			ErrorCtx_SetError(EMSG_QUERY_MEM_CONSUMPTION_OWNER, stats->owner);
+		} else {
+			ErrorCtx_SetError(EMSG_QUERY_MEM_CONSUMPTION);
+		}
 	}
 }
 
@@ -59,7 +96,7 @@ void *rm_alloc_with_capacity(size_t n_bytes) {
 
 void *rm_realloc_with_capacity(void *ptr, size_t n_bytes) {
 	// remove bytes of original allocation
-	_nmalloc_decrement(RedisModule_MallocSize(ptr));
+	if(ptr != NULL) _nmalloc_decrement(RedisModule_MallocSize(ptr));
 	// track new allocation size
 	_nmalloc_increment(n_bytes);
 	return RedisModule_Realloc_Orig(ptr, n_bytes);
@@ -80,22 +117,21 @@ char *rm_strdup_with_capacity(const char *str) {
 }
 
 void rm_free_with_capacity(void *ptr) {
+	if(ptr == NULL) return;
 	_nmalloc_decrement(RedisModule_MallocSize(ptr));
 	RedisModule_Free_Orig(ptr);
 }
 
-void rm_set_mem_capacity(int64_t cap) {
-	bool is_capped = (mem_capacity > 0); // current allocator applies memory cap
-	bool should_cap = (cap > 0); // should we use a memory capped allocator
+// install or uninstall the tracking allocator
+// the tracking allocator is required as long as a memory cap is applied
+// or any thread attributes allocations to statistics
+// must be called while holding 'tracking_lock'
+static void _rm_update_allocator(void) {
+	bool should_track = (mem_capacity > 0 || n_stats_users > 0);
 
-	// The local enforced capacity should be set
-	// before resetting function pointers
-	// for instance if we're switching to capped allocator
-	// we want the memory cap to be set
-	mem_capacity = cap;
-	if(should_cap && !is_capped) {
+	if(should_track && !tracking) {
 		// store the function pointer original values and change them
-		// to the capped version
+		// to the tracking version
 		RedisModule_Free_Orig     =  RedisModule_Free;
 		RedisModule_Alloc_Orig    =  RedisModule_Alloc;
 		RedisModule_Calloc_Orig   =  RedisModule_Calloc;
@@ -106,7 +142,7 @@ void rm_set_mem_capacity(int64_t cap) {
 		RedisModule_Calloc        =  rm_calloc_with_capacity;
 		RedisModule_Strdup        =  rm_strdup_with_capacity;
 		RedisModule_Realloc       =  rm_realloc_with_capacity;
-	} else if(!should_cap && is_capped) {
+	} else if(!should_track && tracking) {
 		// restore all function pointers to their original values
 		RedisModule_Free     =  RedisModule_Free_Orig;
 		RedisModule_Alloc    =  RedisModule_Alloc_Orig;
@@ -114,6 +150,49 @@ void rm_set_mem_capacity(int64_t cap) {
 		RedisModule_Strdup   =  RedisModule_Strdup_Orig;
 		RedisModule_Realloc  =  RedisModule_Realloc_Orig;
 	}
+
+	tracking = should_track;
+}
+
+void rm_set_mem_capacity(int64_t cap) {
+	pthread_mutex_lock(&tracking_lock);
+
+	// The local enforced capacity should be set
+	// before resetting function pointers
+	// for instance if we're switching to capped allocator
+	// we want the memory cap to be set
+	mem_capacity = cap;
+	_rm_update_allocator();
+
+	pthread_mutex_unlock(&tracking_lock);
+}
+
+void rm_alloc_stats_enable(void) {
+	pthread_mutex_lock(&tracking_lock);
+
+	n_stats_users++;
+	_rm_update_allocator();
+
+	pthread_mutex_unlock(&tracking_lock);
+}
+
+void rm_alloc_stats_disable(void) {
+	// stop charging allocations on this thread
+	alloc_stats = NULL;
+
+	pthread_mutex_lock(&tracking_lock);
+
+	ASSERT(n_stats_users > 0);
+	n_stats_users--;
+	_rm_update_allocator();
+
+	pthread_mutex_unlock(&tracking_lock);
+}
+
+rm_alloc_stats *rm_alloc_stats_set(rm_alloc_stats *stats) {
+	rm_alloc_stats *prev = alloc_stats;
+	alloc_stats = stats;
+	return prev;
 }
 
 #else
@@ -121,9 +200,23 @@ void rm_set_mem_capacity(int64_t cap) {
 void rm_reset_n_alloced() {
 }
 
+int64_t rm_n_alloced_peak(void) {
+	return 0;
+}
+
 void rm_set_mem_capacity(int64_t cap) {
 }
 
+void rm_alloc_stats_enable(void) {
+}
+
+void rm_alloc_stats_disable(void) {
+}
+
+rm_alloc_stats *rm_alloc_stats_set(rm_alloc_stats *stats) {
+	return NULL;
+}
+
 #endif // REDIS_MODULE_TARGET
 
 /* Redefine the allocator functions to use the malloc family.
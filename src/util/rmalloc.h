@@ -1,10 +1,40 @@
 #ifndef __REDISGRAPH_ALLOC__
 #define __REDISGRAPH_ALLOC__
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../redismodule.h"
 
+// allocation statistics
+// a thread charges its allocations and frees to its active statistics
+// memory freed by a thread is deducted from the statistics active at the time
+// of the free, as such 'live' might be negative
+typedef struct {
+	int64_t allocated;  // number of bytes allocated
+	int64_t live;       // allocated bytes minus freed bytes
+	int64_t peak;       // maximum value 'live' reached
+	uint64_t count;     // number of allocations
+	const char *owner;  // [optional] name reported when exceeding capacity
+} rm_alloc_stats;
+
+// start attributing allocations to statistics
+// installs the tracking allocator if it isn't already installed
+// must be balanced by a call to rm_alloc_stats_disable
+void rm_alloc_stats_enable(void);
+
+// stop attributing allocations to statistics
+// clears the calling thread's active statistics
+void rm_alloc_stats_disable(void);
+
+// set calling thread's active allocation statistics
+// returns previously active statistics
+// NULL stops charging allocations on the calling thread
+rm_alloc_stats *rm_alloc_stats_set
+(
+	rm_alloc_stats *stats  // statistics to charge
+);
+
 #ifdef REDIS_MODULE_TARGET /* Set this when compiling your code as a module */
 
 // called when mem_capacity configuration changes
@@ -18,6 +48,11 @@ void rm_set_mem_capacity(int64_t cap);
 // reset thread memory consumption counter to 0 (no memory consumed)
 void rm_reset_n_alloced();
 
+// returns the thread's peak memory consumption since the last reset
+// consumption is only counted while the tracking allocator is installed
+// i.e. a query memory capacity is set or allocation statistics are enabled
+int64_t rm_n_alloced_peak(void);
+
 static inline void *rm_malloc(size_t n) {
 	return RedisModule_Alloc(n);
 }
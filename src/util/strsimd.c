@@ -0,0 +1,422 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "strsimd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define STR_SIMD_X86 1
+#endif
+
+#define ASCII_HIGH_BITS 0x8080808080808080ULL
+
+//------------------------------------------------------------------------------
+// scalar kernels
+//------------------------------------------------------------------------------
+
+static bool _is_ascii_scalar
+(
+	const char *str,
+	size_t len
+) {
+	size_t i = 0;
+	uint64_t acc = 0;
+
+	// inspect 8 bytes at a time
+	for(; i + 8 <= len; i += 8) {
+		uint64_t w;
+		memcpy(&w, str + i, 8);
+		acc |= w;
+	}
+
+	for(; i < len; i++) acc |= (uint8_t)str[i];
+
+	return (acc & ASCII_HIGH_BITS) == 0;
+}
+
+static void _tolower_scalar
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	for(size_t i = 0; i < len; i++) {
+		char c = src[i];
+		dst[i] = (c >= 'A' && c <= 'Z') ? c | 0x20 : c;
+	}
+}
+
+static void _toupper_scalar
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	for(size_t i = 0; i < len; i++) {
+		char c = src[i];
+		dst[i] = (c >= 'a' && c <= 'z') ? c & ~0x20 : c;
+	}
+}
+
+static const char *_find_scalar
+(
+	const char *hay,
+	size_t hay_len,
+	const char *needle,
+	size_t needle_len
+) {
+	return memmem(hay, hay_len, needle, needle_len);
+}
+
+static const char *_find_either_scalar
+(
+	const char *str,
+	size_t len,
+	char a,
+	char b
+) {
+	for(size_t i = 0; i < len; i++) {
+		if(str[i] == a || str[i] == b) return str + i;
+	}
+	return NULL;
+}
+
+#ifdef STR_SIMD_X86
+
+//------------------------------------------------------------------------------
+// SSE2 kernels
+//------------------------------------------------------------------------------
+
+static bool _is_ascii_sse2
+(
+	const char *str,
+	size_t len
+) {
+	size_t i = 0;
+	__m128i acc = _mm_setzero_si128();
+
+	for(; i + 16 <= len; i += 16) {
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i *)(str + i)));
+	}
+
+	if(_mm_movemask_epi8(acc) != 0) return false;
+
+	return _is_ascii_scalar(str + i, len - i);
+}
+
+// flip case bit of every byte within [lo, hi]
+// bytes >= 0x80 are negative as signed chars and never match
+static inline __m128i _flip_case_sse2
+(
+	__m128i v,
+	char lo,
+	char hi
+) {
+	__m128i ge = _mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1));
+	__m128i le = _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1));
+	__m128i in = _mm_and_si128(ge, le);
+	return _mm_xor_si128(v, _mm_and_si128(in, _mm_set1_epi8(0x20)));
+}
+
+static void _tolower_sse2
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	size_t i = 0;
+	for(; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_si128((__m128i *)(dst + i), _flip_case_sse2(v, 'A', 'Z'));
+	}
+	_tolower_scalar(src + i, dst + i, len - i);
+}
+
+static void _toupper_sse2
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	size_t i = 0;
+	for(; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+		_mm_storeu_si128((__m128i *)(dst + i), _flip_case_sse2(v, 'a', 'z'));
+	}
+	_toupper_scalar(src + i, dst + i, len - i);
+}
+
+// substring search comparing needle's first and last bytes against
+// 16 candidate positions at once, candidates are verified with memcmp
+static const char *_find_sse2
+(
+	const char *hay,
+	size_t hay_len,
+	const char *needle,
+	size_t needle_len
+) {
+	const __m128i first = _mm_set1_epi8(needle[0]);
+	const __m128i last  = _mm_set1_epi8(needle[needle_len - 1]);
+
+	size_t i = 0;
+	for(; i + needle_len - 1 + 16 <= hay_len; i += 16) {
+		__m128i f = _mm_loadu_si128((const __m128i *)(hay + i));
+		__m128i l = _mm_loadu_si128((const __m128i *)(hay + i + needle_len - 1));
+		uint32_t mask = _mm_movemask_epi8(_mm_and_si128(
+					_mm_cmpeq_epi8(f, first), _mm_cmpeq_epi8(l, last)));
+
+		while(mask != 0) {
+			int bit = __builtin_ctz(mask);
+			if(memcmp(hay + i + bit + 1, needle + 1, needle_len - 2) == 0) {
+				return hay + i + bit;
+			}
+			mask &= mask - 1;
+		}
+	}
+
+	return _find_scalar(hay + i, hay_len - i, needle, needle_len);
+}
+
+static const char *_find_either_sse2
+(
+	const char *str,
+	size_t len,
+	char a,
+	char b
+) {
+	const __m128i va = _mm_set1_epi8(a);
+	const __m128i vb = _mm_set1_epi8(b);
+
+	size_t i = 0;
+	for(; i + 16 <= len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(str + i));
+		uint32_t mask = _mm_movemask_epi8(_mm_or_si128(
+					_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+		if(mask != 0) return str + i + __builtin_ctz(mask);
+	}
+
+	return _find_either_scalar(str + i, len - i, a, b);
+}
+
+//------------------------------------------------------------------------------
+// AVX2 kernels
+//------------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static bool _is_ascii_avx2
+(
+	const char *str,
+	size_t len
+) {
+	size_t i = 0;
+	__m256i acc = _mm256_setzero_si256();
+
+	for(; i + 32 <= len; i += 32) {
+		acc = _mm256_or_si256(acc,
+				_mm256_loadu_si256((const __m256i *)(str + i)));
+	}
+
+	if(_mm256_movemask_epi8(acc) != 0) return false;
+
+	return _is_ascii_sse2(str + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i _flip_case_avx2
+(
+	__m256i v,
+	char lo,
+	char hi
+) {
+	__m256i ge = _mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1));
+	__m256i le = _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v);
+	__m256i in = _mm256_and_si256(ge, le);
+	return _mm256_xor_si256(v, _mm256_and_si256(in, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+static void _tolower_avx2
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	size_t i = 0;
+	for(; i + 32 <= len; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+		_mm256_storeu_si256((__m256i *)(dst + i), _flip_case_avx2(v, 'A', 'Z'));
+	}
+	_tolower_sse2(src + i, dst + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static void _toupper_avx2
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	size_t i = 0;
+	for(; i + 32 <= len; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(src + i));
+		_mm256_storeu_si256((__m256i *)(dst + i), _flip_case_avx2(v, 'a', 'z'));
+	}
+	_toupper_sse2(src + i, dst + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static const char *_find_avx2
+(
+	const char *hay,
+	size_t hay_len,
+	const char *needle,
+	size_t needle_len
+) {
+	const __m256i first = _mm256_set1_epi8(needle[0]);
+	const __m256i last  = _mm256_set1_epi8(needle[needle_len - 1]);
+
+	size_t i = 0;
+	for(; i + needle_len - 1 + 32 <= hay_len; i += 32) {
+		__m256i f = _mm256_loadu_si256((const __m256i *)(hay + i));
+		__m256i l = _mm256_loadu_si256(
+				(const __m256i *)(hay + i + needle_len - 1));
+		uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+					_mm256_cmpeq_epi8(f, first), _mm256_cmpeq_epi8(l, last)));
+
+		while(mask != 0) {
+			int bit = __builtin_ctz(mask);
+			if(memcmp(hay + i + bit + 1, needle + 1, needle_len - 2) == 0) {
+				return hay + i + bit;
+			}
+			mask &= mask - 1;
+		}
+	}
+
+	return _find_sse2(hay + i, hay_len - i, needle, needle_len);
+}
+
+__attribute__((target("avx2")))
+static const char *_find_either_avx2
+(
+	const char *str,
+	size_t len,
+	char a,
+	char b
+) {
+	const __m256i va = _mm256_set1_epi8(a);
+	const __m256i vb = _mm256_set1_epi8(b);
+
+	size_t i = 0;
+	for(; i + 32 <= len; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(str + i));
+		uint32_t mask = _mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)));
+		if(mask != 0) return str + i + __builtin_ctz(mask);
+	}
+
+	return _find_either_sse2(str + i, len - i, a, b);
+}
+
+#endif // STR_SIMD_X86
+
+//------------------------------------------------------------------------------
+// dispatch
+//------------------------------------------------------------------------------
+
+typedef struct {
+	const char *name;
+	bool (*is_ascii)(const char *, size_t);
+	void (*tolower)(const char *, char *, size_t);
+	void (*toupper)(const char *, char *, size_t);
+	const char *(*find)(const char *, size_t, const char *, size_t);
+	const char *(*find_either)(const char *, size_t, char, char);
+} StrSimdImpl;
+
+#ifdef STR_SIMD_X86
+static const StrSimdImpl _avx2_impl = {
+	"avx2", _is_ascii_avx2, _tolower_avx2, _toupper_avx2, _find_avx2,
+	_find_either_avx2
+};
+
+// SSE2 is part of the x86-64 baseline
+static const StrSimdImpl _sse2_impl = {
+	"sse2", _is_ascii_sse2, _tolower_sse2, _toupper_sse2, _find_sse2,
+	_find_either_sse2
+};
+
+static const StrSimdImpl *_impl = &_sse2_impl;
+#else
+static const StrSimdImpl _scalar_impl = {
+	"scalar", _is_ascii_scalar, _tolower_scalar, _toupper_scalar, _find_scalar,
+	_find_either_scalar
+};
+
+static const StrSimdImpl *_impl = &_scalar_impl;
+#endif
+
+void str_simd_init(void) {
+#ifdef STR_SIMD_X86
+	__builtin_cpu_init();
+	_impl = __builtin_cpu_supports("avx2") ? &_avx2_impl : &_sse2_impl;
+#endif
+}
+
+const char *str_simd_impl(void) {
+	return _impl->name;
+}
+
+bool str_is_ascii
+(
+	const char *str,
+	size_t len
+) {
+	return _impl->is_ascii(str, len);
+}
+
+void str_ascii_tolower
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	_impl->tolower(src, dst, len);
+}
+
+void str_ascii_toupper
+(
+	const char *src,
+	char *dst,
+	size_t len
+) {
+	_impl->toupper(src, dst, len);
+}
+
+const char *str_find
+(
+	const char *hay,
+	size_t hay_len,
+	const char *needle,
+	size_t needle_len
+) {
+	if(needle_len == 0) return hay;
+	if(needle_len > hay_len) return NULL;
+	if(needle_len == 1) return memchr(hay, needle[0], hay_len);
+
+	return _impl->find(hay, hay_len, needle, needle_len);
+}
+
+const char *str_find_either
+(
+	const char *str,
+	size_t len,
+	char a,
+	char b
+) {
+	return _impl->find_either(str, len, a, b);
+}
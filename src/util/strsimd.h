@@ -0,0 +1,67 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// vectorized string kernels
+//
+// x86-64 builds use SSE2 by default and switch to AVX2 kernels
+// once str_simd_init detects CPU support, other architectures use a
+// portable scalar implementation
+
+// pick the best implementation supported by the running CPU
+void str_simd_init(void);
+
+// name of the active implementation: "avx2", "sse2" or "scalar"
+const char *str_simd_impl(void);
+
+// returns true if the first len bytes of str are all ASCII
+bool str_is_ascii
+(
+	const char *str,  // string to inspect
+	size_t len        // number of bytes to inspect
+);
+
+// convert len ASCII bytes to lower case
+// src and dst may point to the same buffer
+void str_ascii_tolower
+(
+	const char *src,  // source
+	char *dst,        // destination, at least len bytes
+	size_t len        // number of bytes to convert
+);
+
+// convert len ASCII bytes to upper case
+// src and dst may point to the same buffer
+void str_ascii_toupper
+(
+	const char *src,  // source
+	char *dst,        // destination, at least len bytes
+	size_t len        // number of bytes to convert
+);
+
+// locate the first occurrence of needle within hay
+// returns NULL if needle isn't found
+const char *str_find
+(
+	const char *hay,       // string to search in
+	size_t hay_len,        // hay length in bytes
+	const char *needle,    // string to search for
+	size_t needle_len      // needle length in bytes
+);
+
+// locate the first byte equal to either a or b
+// returns NULL if neither is found
+const char *str_find_either
+(
+	const char *str,  // string to search in
+	size_t len,       // string length in bytes
+	char a,           // first byte to search for
+	char b            // second byte to search for
+);
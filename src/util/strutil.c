@@ -5,9 +5,9 @@
  */
 
 #include <string.h>
-#include <ctype.h>
 #include "RG.h"
 #include "rmalloc.h"
+#include "strsimd.h"
 #include "utf8proc/utf8proc.h"
 #include "oniguruma/src/oniguruma.h"
 
@@ -25,7 +25,7 @@ void str_tolower_ascii
 	// update lower len
 	*lower_len = str_len;
 
-	for(size_t i = 0; i < str_len; i++) lower[i] = tolower(str[i]);
+	str_ascii_tolower(str, lower, str_len);
 	lower[str_len] = 0;
 }
 
@@ -34,6 +34,9 @@ bool str_utf8_validate
 (
 	const char *str
 ) {
+	// ASCII strings are valid utf8
+	if(str_is_ascii(str, strlen(str))) return true;
+
 	// hold current Unicode character
 	utf8proc_int32_t c;
 
@@ -58,6 +61,10 @@ int str_length
 (
 	const char *str
 ) {
+	// ASCII fast path, a character per byte
+	size_t n = strlen(str);
+	if(str_is_ascii(str, n)) return n;
+
 	// hold current Unicode character
 	utf8proc_int32_t c;
 
@@ -79,6 +86,15 @@ char *str_tolower
 (
 	const char *str
 ) {
+	// ASCII fast path
+	size_t n = strlen(str);
+	if(str_is_ascii(str, n)) {
+		char *lower = rm_malloc(n + 1);
+		str_ascii_tolower(str, lower, n);
+		lower[n] = 0;
+		return lower;
+	}
+
 	// hold current Unicode character
 	utf8proc_int32_t c;
 	const utf8proc_uint8_t *str_i = (const utf8proc_uint8_t *)str;
@@ -108,6 +124,15 @@ char *str_toupper
 (
 	const char *str
 ) {
+	// ASCII fast path
+	size_t n = strlen(str);
+	if(str_is_ascii(str, n)) {
+		char *upper = rm_malloc(n + 1);
+		str_ascii_toupper(str, upper, n);
+		upper[n] = 0;
+		return upper;
+	}
+
 	// hold current Unicode character
 	utf8proc_int32_t c;
 	const utf8proc_uint8_t *str_i = (const utf8proc_uint8_t *)str;
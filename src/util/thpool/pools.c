@@ -7,6 +7,7 @@
 #include <pthread.h>
 #include "RG.h"
 #include "pools.h"
+#include "../rmalloc.h"
 #include "../../configuration/config.h"
 
 //------------------------------------------------------------------------------
@@ -15,6 +16,23 @@
 
 static threadpool _readers_thpool = NULL;  // readers
 static threadpool _writers_thpool = NULL;  // writers
+static threadpool _workers_thpool = NULL;  // parallel tasks workers
+
+static pthread_once_t _workers_once = PTHREAD_ONCE_INIT;
+
+// parallel run, tracks scheduled invocations
+// the run outlives its caller until every scheduled invocation was dequeued
+// invocations dequeued once the caller returned skip the task, as such
+// a caller running on a worker never waits for invocations queued behind it
+typedef struct {
+	void (*task)(void *);  // task to run
+	void *arg;             // task argument
+	uint refs;             // caller + scheduled invocations
+	uint active;           // number of running invocations
+	bool closed;           // caller completed the task
+	pthread_mutex_t lock;  // run lock
+	pthread_cond_t done;   // signaled once the last active invocation completes
+} ParallelRun;
 
 int ThreadPools_Init
 (
@@ -121,6 +139,7 @@ void ThreadPools_Pause
 
 	thpool_pause(_readers_thpool);
 	thpool_pause(_writers_thpool);
+	if(_workers_thpool != NULL) thpool_pause(_workers_thpool);
 }
 
 void ThreadPools_Resume
@@ -133,6 +152,7 @@ void ThreadPools_Resume
 
 	thpool_resume(_readers_thpool);
 	thpool_resume(_writers_thpool);
+	if(_workers_thpool != NULL) thpool_resume(_workers_thpool);
 }
 
 // adds a read task
@@ -165,6 +185,113 @@ int ThreadPools_AddWorkWriter
 	return thpool_add_work(_writers_thpool, function_p, arg_p);
 }
 
+// create workers pool, sized as the readers pool
+static void _ThreadPools_CreateWorkers(void) {
+	int thread_count = 1;
+	bool config_read = Config_Option_get(Config_THREAD_POOL_SIZE,
+			&thread_count);
+	ASSERT(config_read == true);
+	UNUSED(config_read);
+
+	_workers_thpool = thpool_init(thread_count, "worker");
+	ASSERT(_workers_thpool != NULL);
+}
+
+// drop a reference to run, freeing it once unreferenced
+// expects run's lock to be held, the lock is released
+static void _ThreadPools_ReleaseRun
+(
+	ParallelRun *run
+) {
+	bool last = --run->refs == 0;
+	pthread_mutex_unlock(&run->lock);
+
+	if(last) {
+		pthread_cond_destroy(&run->done);
+		pthread_mutex_destroy(&run->lock);
+		rm_free(run);
+	}
+}
+
+// runs a single invocation of a parallel task
+static void _ThreadPools_RunInvocation
+(
+	void *arg
+) {
+	ParallelRun *run = (ParallelRun *)arg;
+
+	// the caller already completed the task, its argument might be gone
+	pthread_mutex_lock(&run->lock);
+	bool skip = run->closed;
+	if(!skip) run->active++;
+	pthread_mutex_unlock(&run->lock);
+
+	if(!skip) run->task(run->arg);
+
+	pthread_mutex_lock(&run->lock);
+	if(!skip && --run->active == 0) pthread_cond_signal(&run->done);
+	_ThreadPools_ReleaseRun(run);
+}
+
+void ThreadPools_RunParallel
+(
+	void (*task)(void *),  // task to run
+	void *arg,             // task argument, shared by all invocations
+	uint64_t n             // max number of concurrent invocations
+) {
+	ASSERT(n    > 0);
+	ASSERT(task != NULL);
+
+	pthread_once(&_workers_once, _ThreadPools_CreateWorkers);
+
+	ParallelRun *run = rm_malloc(sizeof(ParallelRun));
+	run->arg    = arg;
+	run->task   = task;
+	run->refs   = 1;
+	run->active = 0;
+	run->closed = false;
+
+	int res = pthread_mutex_init(&run->lock, NULL);
+	ASSERT(res == 0);
+	res = pthread_cond_init(&run->done, NULL);
+	ASSERT(res == 0);
+	UNUSED(res);
+
+	// the calling thread runs one of the invocations
+	uint64_t workers = thpool_num_threads(_workers_thpool);
+	if(workers > n - 1) workers = n - 1;
+
+	pthread_mutex_lock(&run->lock);
+	for(uint64_t i = 0; i < workers; i++) {
+		if(thpool_add_work(_workers_thpool, _ThreadPools_RunInvocation,
+					run) == 0) {
+			run->refs++;
+		}
+	}
+	pthread_mutex_unlock(&run->lock);
+
+	task(arg);
+
+	// wait for running invocations
+	// invocations which didn't start yet won't run the task
+	pthread_mutex_lock(&run->lock);
+	run->closed = true;
+	while(run->active > 0) pthread_cond_wait(&run->done, &run->lock);
+	_ThreadPools_ReleaseRun(run);
+}
+
+int ThreadPools_AddWorkWorker
+(
+	void (*function_p)(void *),
+	void *arg_p
+) {
+	ASSERT(function_p != NULL);
+
+	pthread_once(&_workers_once, _ThreadPools_CreateWorkers);
+
+	return thpool_add_work(_workers_thpool, function_p, arg_p);
+}
+
 void ThreadPools_SetMaxPendingWork(uint64_t val) {
 	if(_readers_thpool != NULL) thpool_set_jobqueue_cap(_readers_thpool, val);
 	if(_writers_thpool != NULL) thpool_set_jobqueue_cap(_writers_thpool, val);
@@ -215,5 +342,6 @@ void ThreadPools_Destroy
 
 	thpool_destroy(_readers_thpool);
 	thpool_destroy(_writers_thpool);
+	if(_workers_thpool != NULL) thpool_destroy(_workers_thpool);
 }
 
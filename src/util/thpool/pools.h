@@ -59,6 +59,27 @@ int ThreadPools_AddWorkWriter
 	int force                    // true will add task even if internal queue is full
 );
 
+// run 'task' concurrently on up to 'n' threads
+// the calling thread runs one invocation while the remaining invocations
+// are handed to a dedicated workers pool, created on first use
+// invocations share the work, the calling thread's invocation must complete
+// it on its own, invocations yet to start once it returns are skipped
+// returns once all started invocations completed
+void ThreadPools_RunParallel
+(
+	void (*task)(void *),  // task to run
+	void *arg,             // task argument, shared by all invocations
+	uint64_t n             // max number of concurrent invocations
+);
+
+// add a task to the workers pool, the pool's queue is unbounded
+// tasks may call ThreadPools_RunParallel
+int ThreadPools_AddWorkWorker
+(
+	void (*function_p)(void *),  // function to run
+	void *arg_p                  // function arguments
+);
+
 // sets the limit on max queued queries in each thread pool
 void ThreadPools_SetMaxPendingWork
 (
@@ -597,6 +597,14 @@ int SIValue_Compare(const SIValue a, const SIValue b, int *disjointOrNull) {
 
 			return SAFE_COMPARISON_RESULT(a.doubleval - b.doubleval);
 		case T_STRING:
+			// strings borrowed from the same source share a buffer
+			// e.g. a constant compared against itself, skip the scan
+			if(a.stringval == b.stringval) return 0;
+			// first byte mismatch is the common case for equality filters
+			if(a.stringval[0] != b.stringval[0]) {
+				return (unsigned char)a.stringval[0] -
+					(unsigned char)b.stringval[0];
+			}
 			return strcmp(a.stringval, b.stringval);
 		case T_NODE:
 		case T_EDGE:
@@ -825,6 +833,22 @@ SIValue SIValue_FromBinary
 	return v;
 }
 			
+size_t SIValue_MemoryUsage
+(
+	SIValue v  // value to inspect
+) {
+	if(v.allocation != M_SELF) return 0;
+
+	switch(v.type) {
+	case T_STRING:
+		return strlen(v.stringval) + 1;
+	case T_ARRAY:
+		return SIArray_MemoryUsage(v);
+	default:
+		return 0;
+	}
+}
+
 void SIValue_Free(SIValue v) {
 	// The free routine only performs work if it owns a heap allocation.
 	if(v.allocation != M_SELF) return;
@@ -44,7 +44,8 @@ typedef enum {
 	M_NONE = 0,             // SIValue is not heap-allocated
 	M_SELF = (1 << 0),      // SIValue is responsible for freeing its reference
 	M_VOLATILE = (1 << 1),  // SIValue does not own its reference and may go out of scope
-	M_CONST = (1 << 2)      // SIValue does not own its allocation, but its access is safe
+	M_CONST = (1 << 2),     // SIValue does not own its allocation, but its access is safe
+	M_SPILLED = (1 << 3)    // SIValue's content resides in the attribute spill file
 } SIAllocation;
 
 #define SI_TYPE(value) (value).type
@@ -213,6 +214,13 @@ SIValue SIValue_FromBinary
 	FILE *stream  // stream to read value from
 );
 
+// returns number of heap bytes owned by value, excluding the SIValue itself
+// spilled values and values not owning their allocation report 0
+size_t SIValue_MemoryUsage
+(
+	SIValue v  // value to inspect
+);
+
 /* Free an SIValue's internal property if that property is a heap allocation owned
  * by this object. */
 void SIValue_Free(SIValue v);
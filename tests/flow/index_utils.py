@@ -55,6 +55,14 @@ def drop_fulltext_index(graph, label):
     q = f"CALL db.idx.fulltext.drop('{label}')"
     return graph.query(q)
 
+def create_vector_index(graph, label, attribute, dim, similarity='euclidean', sync=False):
+    q = f"CALL db.idx.vector.createNodeIndex({{label: '{label}', attribute: '{attribute}', dimension: {dim}, similarityFunction: '{similarity}'}})"
+    return _create_index(graph, q, label, "vector", sync)
+
+def drop_vector_index(graph, label):
+    q = f"CALL db.idx.vector.drop('{label}')"
+    return graph.query(q)
+
 # validate index is being populated
 def index_under_construction(graph, label, t):
     params = {'lbl': label, 'typ': t}
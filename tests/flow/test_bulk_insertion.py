@@ -1,7 +1,9 @@
 # -*- coding: utf-8 -*-
 from common import *
 import csv
+import struct
 import time
+import tempfile
 import threading
 from click.testing import CliRunner
 from redisgraph_bulk_loader.bulk_insert import bulk_insert
@@ -9,6 +11,7 @@ from redisgraph_bulk_loader.bulk_insert import bulk_insert
 redis_con = None
 port = None
 redis_graph = None
+IMPORT_FOLDER = tempfile.mkdtemp()
 
 
 def run_bulk_loader(graphname, filename):
@@ -19,7 +22,8 @@ def run_bulk_loader(graphname, filename):
 
 class testGraphBulkInsertFlow(FlowTestsBase):
     def __init__(self):
-        self.env = Env(decodeResponses=True)
+        self.env = Env(decodeResponses=True,
+                       moduleArgs=f"IMPORT_FOLDER {IMPORT_FOLDER}")
 
         # skip test if we're running under Valgrind
         if VALGRIND:
@@ -715,3 +719,129 @@ class testGraphBulkInsertFlow(FlowTestsBase):
             query_result = graph.query(q)
             self.env.assertEquals(query_result.result_set, expected_result)
 
+    # Validate loading a graph from a local file
+    def test12_load_from_file(self):
+        graphname = "file_graph"
+
+        def header(name, props):
+            h = name.encode() + b'\0' + struct.pack('<I', len(props))
+            for p in props:
+                h += p.encode() + b'\0'
+            return h
+
+        def section(t, blob):
+            return struct.pack('<BQ', t, len(blob)) + blob
+
+        # 10 Person nodes with a name and an age
+        nodes = header('Person', ['name', 'age'])
+        for i in range(10):
+            nodes += b'\x03' + f'p{i}'.encode() + b'\0'  # string
+            nodes += b'\x04' + struct.pack('<q', i)       # integer
+
+        # chain of KNOWS edges between consecutive nodes
+        edges = header('KNOWS', [])
+        for i in range(9):
+            edges += struct.pack('<QQ', i, i + 1)
+
+        first  = section(0, nodes)
+        second = section(1, edges)
+        path   = 'bulk_from.tmp'
+        with open(os.path.join(IMPORT_FOLDER, path), mode='wb') as f:
+            f.write(first + second)
+
+        # load first section only
+        res = redis_con.execute_command("GRAPH.BULK", graphname, "BEGIN",
+                                        "FROM", path, "LIMIT", 1)
+        self.env.assertEquals(res, f"10 nodes created, 0 edges created, "
+                                   f"{len(first)} of {len(first + second)} bytes loaded")
+
+        # resume from checkpoint
+        res = redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path,
+                                        "OFFSET", len(first))
+        self.env.assertEquals(res, f"0 nodes created, 9 edges created, "
+                                   f"{len(first + second)} of {len(first + second)} bytes loaded")
+
+        graph = Graph(redis_con, graphname)
+        q = "MATCH (a:Person)-[:KNOWS]->(b:Person) RETURN a.name, b.age ORDER BY a.age"
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [[f'p{i}', i + 1] for i in range(9)])
+
+        # offset must be a section boundary
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path,
+                                      "OFFSET", 1)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("not a section boundary", str(e))
+
+        # paths outside of the import folder are rejected
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM",
+                                      "../bulk_from.tmp")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("outside of the import folder", str(e))
+
+        # edges referencing missing nodes are rejected
+        with open(os.path.join(IMPORT_FOLDER, path), mode='wb') as f:
+            f.write(section(1, header('KNOWS', []) +
+                            struct.pack('<QQ', 0, 1000)))
+
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("missing node", str(e))
+
+        # unknown property type, graph is left untouched
+        bad = header('Person', ['name']) + b'\x09'
+        with open(os.path.join(IMPORT_FOLDER, path), mode='wb') as f:
+            f.write(section(0, bad))
+
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("malformed section", str(e))
+
+        # unterminated string property
+        bad = header('Person', ['name']) + b'\x03abc'
+        with open(os.path.join(IMPORT_FOLDER, path), mode='wb') as f:
+            f.write(section(0, bad))
+
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("malformed section", str(e))
+
+        # malformed file, graph is left untouched
+        with open(os.path.join(IMPORT_FOLDER, path), mode='wb') as f:
+            f.write(first[:-1])
+
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("malformed section", str(e))
+
+        res = graph.query("MATCH (n) RETURN count(n)").result_set
+        self.env.assertEquals(res[0][0], 10)
+
+        # failed BEGIN call doesn't leave a graph behind
+        try:
+            redis_con.execute_command("GRAPH.BULK", "missing_file_graph",
+                                      "BEGIN", "FROM", path)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("malformed section", str(e))
+        self.env.assertFalse(redis_con.exists("missing_file_graph"))
+
+        os.remove(os.path.join(IMPORT_FOLDER, path))
+
+        # missing file
+        try:
+            redis_con.execute_command("GRAPH.BULK", graphname, "FROM", path)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Failed to open bulk file", str(e))
@@ -3,7 +3,7 @@ from common import *
 redis_con = None
 redis_graph = None
 # Number of options available.
-NUMBER_OF_OPTIONS = 16
+NUMBER_OF_OPTIONS = 20
 
 class testConfig(FlowTestsBase):
     def __init__(self):
@@ -25,7 +25,7 @@ class testConfig(FlowTestsBase):
         # Try reading all configurations
         config_name = "*"
         response = redis_con.execute_command("GRAPH.CONFIG GET " + config_name)
-        # 16 configurations should be reported
+        # 20 configurations should be reported
         self.env.assertEquals(len(response), NUMBER_OF_OPTIONS)
 
     def test02_config_get_invalid_name(self):
@@ -1,4 +1,5 @@
 import time
+import struct
 import threading
 from common import *
 
@@ -836,3 +837,106 @@ class testEffects():
         self.master.wait(1, 0)
         self.assert_graph_eq()
 
+
+    def test16_bulk_create_effect(self):
+        # creations sharing labels / relationship type are replicated as runs
+        # and applied in bulk by the replica
+
+        # update graph key
+        global GRAPH_ID
+        GRAPH_ID = "bulk_create"
+
+        # update graph objects to use new graph key
+        self.master_graph = Graph(self.master, GRAPH_ID)
+        self.replica_graph = Graph(self.replica, GRAPH_ID)
+
+        # runs larger than the bulk build threshold
+        q = """UNWIND range(1, 3000) AS x
+               CREATE (:A {v: x, neg: -x})-[:R {v: x}]->(:B {s: toString(x)})"""
+        res = self.query_master_and_wait(q)
+        self.env.assertEquals(res.nodes_created, 6000)
+        self.env.assertEquals(res.relationships_created, 3000)
+        self.wait_for_effect()
+
+        # interleaved labels and relationship types break runs
+        q = """UNWIND range(1, 100) AS x
+               CREATE (a:A), (b:B), (c:A:B), (a)-[:R]->(b), (b)-[:S]->(c)"""
+        res = self.query_master_and_wait(q)
+        self.env.assertEquals(res.nodes_created, 300)
+        self.wait_for_effect()
+
+        # runs following deletions reuse deleted IDs in the same order
+        q = "MATCH (n:B) WHERE n.s IS NOT NULL AND toInteger(n.s) % 2 = 0 DELETE n"
+        self.query_master_and_wait(q)
+        self.wait_for_effect()
+
+        q = "UNWIND range(1, 2000) AS x CREATE (:C {v: x})"
+        self.query_master_and_wait(q)
+        self.wait_for_effect()
+
+        self.assert_graph_eq()
+
+
+# effects encoded in version 1, as produced by primaries yet to be upgraded
+# and as found in existing AOF files
+class testEffectsV1():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.con = self.env.getConnection()
+        self.graph = Graph(self.con, "effects_v1")
+
+    # version 1 value, encoded by SIValue_ToBinary
+    def value(self, v):
+        if isinstance(v, bool):
+            return struct.pack("<i?", 1 << 12, v)
+        if isinstance(v, int):
+            return struct.pack("<iq", 1 << 13, v)
+        if isinstance(v, float):
+            return struct.pack("<id", 1 << 14, v)
+        return struct.pack("<iQ", 1 << 11, len(v) + 1) + v.encode() + b"\0"
+
+    def attributes(self, attrs):
+        buf = struct.pack("<H", len(attrs))
+        for attr_id, v in attrs:
+            buf += struct.pack("<H", attr_id) + self.value(v)
+        return buf
+
+    def string(self, s):
+        return struct.pack("<Q", len(s) + 1) + s.encode() + b"\0"
+
+    def test01_apply_v1_buffer(self):
+        buf = struct.pack("<B", 1)  # version
+
+        # schemas: node labels L (0) and M (1), relationship type R (0)
+        buf += struct.pack("<ii", 9, 0) + self.string("L")
+        buf += struct.pack("<ii", 9, 0) + self.string("M")
+        buf += struct.pack("<ii", 9, 1) + self.string("R")
+
+        # attributes: v (0) and s (1)
+        buf += struct.pack("<i", 10) + self.string("v")
+        buf += struct.pack("<i", 10) + self.string("s")
+
+        # create nodes 0 and 1, labeled L
+        buf += struct.pack("<iHi", 3, 1, 0) + self.attributes([(0, 7), (1, "abc")])
+        buf += struct.pack("<iHi", 3, 1, 0) + self.attributes([(0, 8)])
+
+        # create edge 0, (0)-[:R]->(1)
+        buf += struct.pack("<iHiQQ", 4, 1, 0, 0, 1) + self.attributes([(0, 1.5)])
+
+        # update node 1, s = true
+        buf += struct.pack("<iQH", 1, 1, 1) + self.value(True)
+
+        # add label M to node 0
+        buf += struct.pack("<iQBi", 7, 0, 1, 1)
+
+        res = self.con.execute_command("GRAPH.EFFECT", "effects_v1", buf)
+        self.env.assertEquals(res, "OK")
+
+        res = self.graph.query("MATCH (n:L) RETURN n.v, n.s ORDER BY n.v").result_set
+        self.env.assertEquals(res, [[7, "abc"], [8, True]])
+
+        res = self.graph.query("MATCH (n:M) RETURN n.v").result_set
+        self.env.assertEquals(res, [[7]])
+
+        res = self.graph.query("MATCH (a)-[r:R]->(b) RETURN a.v, r.v, b.v").result_set
+        self.env.assertEquals(res, [[7, 1.5, 8]])
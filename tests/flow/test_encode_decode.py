@@ -2,6 +2,7 @@ from common import *
 from index_utils import *
 from random_graph import create_random_schema, create_random_graph, run_random_graph_ops, ALL_OPS
 import re
+import time
 
 redis_con = None
 
@@ -343,3 +344,140 @@ class test_encode_decode(FlowTestsBase):
 
         compare_nodes_result_set(self.env, nodes_before.result_set, nodes_after.result_set)
         self.env.assertEquals(edges_before.result_set, edges_after.result_set)
+
+    def test13_matrices_over_multiple_keys(self):
+        redis_con.flushall()
+
+        # spread label and relation matrices across virtual keys
+        response = redis_con.execute_command(
+            "GRAPH.CONFIG SET VKEY_MAX_ENTITY_COUNT 5")
+        self.env.assertEqual(response, "OK")
+
+        graph_name = "matrices_over_multiple_keys"
+        redis_graph = Graph(redis_con, graph_name)
+
+        redis_graph.query("""UNWIND range(0, 9) AS i
+                             CREATE (a:A:B {v: i})-[:R {v: i}]->(b:C {v: i}),
+                                    (a)-[:R {v: -i}]->(b),
+                                    (b)-[:S]->(a),
+                                    (a)-[:T]->(:D)""")
+        create_node_exact_match_index(redis_graph, "A", "v", sync=True)
+        create_edge_exact_match_index(redis_graph, "R", "v", sync=True)
+
+        queries = [
+            "MATCH (a:A:B)-[r:R]->(b:C) RETURN id(a), id(r), r.v, id(b) ORDER BY id(r)",
+            "MATCH (b:C)<-[r:R]-(a) RETURN id(b), id(r), id(a) ORDER BY id(r)",
+            "MATCH (a)-[]->(b) RETURN count(DISTINCT [id(a), id(b)])",
+            "MATCH (a:A)<-[:S]-(b) RETURN id(a), id(b) ORDER BY id(a)",
+            "MATCH (n) RETURN labels(n), count(n) ORDER BY labels(n)",
+            "MATCH (a:A {v: 7}) RETURN id(a)",
+            "MATCH ()-[r:R {v: -7}]->() RETURN id(r)",
+        ]
+        expected = [redis_graph.query(q).result_set for q in queries]
+
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(redis_graph.query(q).result_set, e)
+
+        # indices are populated once the graph is loaded
+        plan = redis_graph.execution_plan("MATCH (a:A {v: 7}) RETURN id(a)")
+        self.env.assertIn("Node By Index Scan", plan)
+        plan = redis_graph.execution_plan("MATCH ()-[r:R {v: -7}]->() RETURN id(r)")
+        self.env.assertIn("Edge By Index Scan", plan)
+
+        # multi-edge entries are restored, deleting one edge retains the other
+        res = redis_graph.query("MATCH ()-[r:R {v: -3}]->() DELETE r")
+        self.env.assertEquals(res.relationships_deleted, 1)
+        res = redis_graph.query("MATCH (:A {v: 3})-[r:R]->(:C) RETURN r.v")
+        self.env.assertEquals(res.result_set, [[3]])
+
+    def test14_parallel_decode_multiple_graphs(self):
+        redis_con.flushall()
+
+        response = redis_con.execute_command(
+            "GRAPH.CONFIG SET VKEY_MAX_ENTITY_COUNT 5")
+        self.env.assertEqual(response, "OK")
+
+        # graphs are decoded concurrently, each by multiple decode tasks
+        graphs = [Graph(redis_con, f"parallel_decode_{i}") for i in range(4)]
+        for i, g in enumerate(graphs):
+            g.query(f"""UNWIND range(0, {10 * (i + 1)}) AS x
+                        CREATE (:L{i} {{v: x, s: toString(x)}})-[:R{i} {{v: x}}]->(:M {{v: [x, x]}})""")
+            create_node_exact_match_index(g, f"L{i}", "v", sync=True)
+
+        queries = [
+            "MATCH (a)-[r]->(b) RETURN a.v, a.s, type(r), r.v, b.v ORDER BY a.v",
+            "MATCH (n) RETURN labels(n), count(n) ORDER BY labels(n)",
+        ]
+        expected = [[g.query(q).result_set for q in queries] for g in graphs]
+
+        # Save RDB & Load from RDB
+        redis_con.execute_command("DEBUG", "RELOAD")
+
+        for i, g in enumerate(graphs):
+            for q, e in zip(queries, expected[i]):
+                self.env.assertEquals(g.query(q).result_set, e)
+
+            res = g.query(f"MATCH (a:L{i} {{v: 3}}) RETURN a.s").result_set
+            self.env.assertEquals(res, [["3"]])
+            plan = g.execution_plan(f"MATCH (a:L{i} {{v: 3}}) RETURN a.s")
+            self.env.assertIn("Node By Index Scan", plan)
+
+        # a graph restored outside of server loading
+        # is fully decoded once RESTORE returns
+        response = redis_con.execute_command(
+            "GRAPH.CONFIG SET VKEY_MAX_ENTITY_COUNT 10000")
+        self.env.assertEqual(response, "OK")
+
+        dump = redis_con.dump(graphs[0].name)
+        redis_con.delete(graphs[0].name)
+        redis_con.restore(graphs[0].name, 0, dump)
+
+        for q, e in zip(queries, expected[0]):
+            self.env.assertEquals(graphs[0].query(q).result_set, e)
+
+
+class test_aof_rdb_preamble(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True, useAof=True,
+                       moduleArgs='VKEY_MAX_ENTITY_COUNT 10',
+                       enableDebugCommand=True)
+        self.redis_con = self.env.getConnection()
+        self.redis_con.config_set("aof-use-rdb-preamble", "yes")
+
+    def wait_for_aof_rewrite(self):
+        while self.redis_con.info("persistence")["aof_rewrite_in_progress"]:
+            time.sleep(0.1)
+
+    def test01_replay_tail_over_decoded_graph(self):
+        g = Graph(self.redis_con, "aof_preamble")
+        g.query("""UNWIND range(0, 999) AS x
+                   CREATE (:A {v: x, s: toString(x)})-[:R {v: x}]->(:B {v: x})""")
+        create_node_exact_match_index(g, "A", "v", sync=True)
+
+        # rewrite the AOF, the graph is saved within its RDB preamble
+        self.redis_con.execute_command("BGREWRITEAOF")
+        self.wait_for_aof_rewrite()
+
+        # graph writes appended to the AOF tail, replayed on load
+        # while the server is still loading
+        g.query("MATCH (a:A) WHERE a.v < 100 SET a.s = 'updated'")
+        g.query("MATCH (a:A) WHERE a.v >= 900 DETACH DELETE a")
+        g.query("UNWIND range(0, 9) AS x CREATE (:A {v: 1000 + x})-[:R]->(:B)")
+
+        queries = [
+            "MATCH (a:A)-[r:R]->(b:B) RETURN a.v, a.s, r.v, b.v ORDER BY a.v, b.v",
+            "MATCH (n) RETURN labels(n), count(n) ORDER BY labels(n)",
+            "MATCH (a:A {v: 5}) RETURN a.s",
+        ]
+        expected = [g.query(q).result_set for q in queries]
+
+        self.redis_con.execute_command("DEBUG", "LOADAOF")
+
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(g.query(q).result_set, e)
+
+        plan = g.execution_plan("MATCH (a:A {v: 5}) RETURN a.s")
+        self.env.assertIn("Node By Index Scan", plan)
@@ -2765,3 +2765,44 @@ class testFunctionCallsFlow(FlowTestsBase):
         }
         for query, expected_result in query_to_expected_result.items():
             self.get_res_and_assertEquals(query, expected_result)
+
+    def test94_regex_cache(self):
+        def regex_cache_stats():
+            res = redis_con.execute_command("GRAPH.INFO", "RegexCache")
+            stats = res[1]
+            return dict(zip(stats[::2], stats[1::2]))
+
+        # constant pattern evaluated against multiple strings
+        # compiled once, reused for every record
+        before = regex_cache_stats()
+        query = """UNWIND ['ab', 'cb', 'b'] AS s
+                   RETURN string.replaceRegEx(s, '[b]', 'x')"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [['ax'], ['cx'], ['x']])
+        after = regex_cache_stats()
+        self.env.assertEquals(after['Misses'] - before['Misses'], 1)
+        self.env.assertEquals(after['Call-site hits'] - before['Call-site hits'], 2)
+
+        # parameterized pattern
+        before = regex_cache_stats()
+        query = """UNWIND ['a1', 'b22', 'c'] AS s
+                   RETURN string.matchRegEx(s, $pattern)"""
+        actual_result = graph.query(query, {'pattern': '\\d+'})
+        self.env.assertEquals(actual_result.result_set, [[[['1']]], [[['22']]], [[]]])
+        after = regex_cache_stats()
+        self.env.assertEquals(after['Misses'] - before['Misses'], 1)
+
+        # pattern changes between records
+        # results must match regardless of caching
+        query = """UNWIND [['ab', 'a'], ['ab', 'b'], ['cb', 'b'], ['cb', 'c']] AS p
+                   RETURN string.replaceRegEx(p[0], p[1], 'x')"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [['xb'], ['ax'], ['cx'], ['xb']])
+
+        # invalid pattern should still be reported after caching valid ones
+        try:
+            query = """UNWIND ['[a-z]', '?'] AS p RETURN string.matchRegEx('a', p)"""
+            graph.query(query)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("Invalid regex", str(e))
@@ -9,6 +9,9 @@ from common import *
 
 GRAPH_ID ="info"
 
+QUERY_STAGES = ["Queue", "Parse", "Validate", "Cache lookup", "Plan",
+                "Lock wait", "Execute", "Commit", "Replicate", "Reply"]
+
 class LoggedQuery:
     def __init__(self, event):
         # make sure event contains all expected fields
@@ -16,6 +19,7 @@ class LoggedQuery:
                   "Execution duration", "Report duration", "Utilized cache",
                   "Write", "Timeout"]
         assert(all(field in event for field in fields))
+        assert(all(f"{stage} time" in event for stage in QUERY_STAGES))
 
         # cast and initialize
         self.received_at        = datetime.datetime.fromtimestamp(int(event['Received at']))
@@ -25,8 +29,10 @@ class LoggedQuery:
         self.execution_duration = float(event['Execution duration'])
         self.report_duration    = float(event['Report duration'])
         self.utilized_cache     = False if event['Utilized cache'] == '0' else True
+        self.stage_durations    = {stage: float(event[f"{stage} time"]) for stage in QUERY_STAGES}
 
         assert (self.TotalDuration >= (self.ExecutionDuration + self.ReportDuration))
+        assert (all(d >= 0 for d in self.stage_durations.values()))
 
     def __str__(self):
         return f"""ReceivedAt: {self.ReceivedAt}
@@ -65,6 +71,10 @@ class LoggedQuery:
     def UtilizedCache(self):
         return self.utilized_cache
 
+    @property
+    def StageDurations(self):
+        return self.stage_durations
+
 def StreamName(graph):
     return f"telemetry{{{graph.name}}}"
 
@@ -394,6 +404,10 @@ class testGraphInfo(FlowTestsBase):
         self.env.assertEquals(running_query[4], "Query")
         self.env.assertEquals(running_query[6], "Execution duration")
         self.env.assertEquals(running_query[8], "Replicated command")
+        self.env.assertEquals(running_query[10], "Stage")
+        self.env.assertEquals(running_query[12], "Stage durations")
+        self.env.assertIn(running_query[11], QUERY_STAGES)
+        self.env.assertEquals(running_query[13][0::2], QUERY_STAGES)
 
         self.env.assertEquals(running_query[3], GRAPH_ID)
         self.env.assertTrue(running_query[5] == read_query or
@@ -433,3 +447,99 @@ class testGraphInfo(FlowTestsBase):
         # wait for all threads to complete
         for t in threads:
             t.join()
+
+    def test08_query_stages(self):
+        """make sure per stage latencies are aggregated"""
+
+        self.conn.execute_command("GRAPH.INFO", "RESETSTAT")
+
+        self.graph.query("CREATE (:L {v: 1})")
+        self.graph.query("MATCH (n:L) RETURN n.v")
+
+        res = self.conn.execute_command("GRAPH.INFO", "QueryStages")
+        self.env.assertEquals(len(res), 2)
+        self.env.assertEquals(res[0], "# Query stages")
+
+        stages = res[1]
+        self.env.assertEquals(stages[0::2], QUERY_STAGES)
+
+        for stats in stages[1::2]:
+            self.env.assertEquals(stats[0::2],
+                    ["Count", "Total duration", "p50", "p99", "p999"])
+
+            p50, p99, p999 = [float(x) for x in stats[5::2]]
+            self.env.assertLessEqual(p50, p99)
+            self.env.assertLessEqual(p99, p999)
+
+        # only stages a query went through are recorded
+        # the read query isn't replicated
+        counts = {stage: stats[1] for stage, stats in zip(stages[0::2], stages[1::2])}
+        self.env.assertGreaterEqual(counts["Queue"], 2)
+        self.env.assertGreaterEqual(counts["Execute"], 2)
+        self.env.assertGreaterEqual(counts["Reply"], 2)
+        self.env.assertEquals(counts["Replicate"], 1)
+
+        # executed queries spent time executing
+        execute = stages[stages.index("Execute") + 1]
+        self.env.assertGreater(float(execute[3]), 0)
+
+        # logged queries report their stage breakdown
+        self.graph.query("RETURN 1")
+        logged_queries = self.consumeStream(StreamName(self.graph),
+                                            n_items=3)
+        for logged_query in logged_queries:
+            self.env.assertEquals(list(logged_query.StageDurations.keys()),
+                                  QUERY_STAGES)
+
+    def test09_latency(self):
+        """make sure latency histograms are maintained per command and graph"""
+
+        metrics = ["Query latency", "Queue wait", "Lock wait", "Reply time"]
+        fields = ["Count", "Mean", "p50", "p99", "p999", "Max"]
+
+        self.conn.execute_command("GRAPH.INFO", "RESETSTAT")
+
+        for i in range(10):
+            self.graph.query("CREATE (:L {v: 1})")
+            self.graph.ro_query("MATCH (n:L) RETURN n.v")
+
+        res = self.conn.execute_command("GRAPH.INFO", "Latency")
+        self.env.assertEquals(len(res), 2)
+        self.env.assertEquals(res[0], "# Latency")
+
+        latency = res[1]
+        self.env.assertEquals(latency[0], "Commands")
+        self.env.assertEquals(latency[2], "Graphs")
+
+        commands = latency[1]
+        self.env.assertEquals(commands[0::2],
+                ["GRAPH.QUERY", "GRAPH.RO_QUERY", "GRAPH.PROFILE"])
+
+        for cmd, stats in zip(commands[0::2], commands[1::2]):
+            self.env.assertEquals(stats[0::2], metrics)
+            expected = 0 if cmd == "GRAPH.PROFILE" else 10
+            for histogram in stats[1::2]:
+                self.env.assertEquals(histogram[0::2], fields)
+                self.env.assertEquals(histogram[1], expected)
+                p50, p99, p999, max = [float(x) for x in histogram[5::2]]
+                self.env.assertLessEqual(p50, p99)
+                self.env.assertLessEqual(p99, p999)
+                self.env.assertLessEqual(p999, max)
+
+        graphs = latency[3]
+        self.env.assertIn(GRAPH_ID, graphs[0::2])
+        stats = graphs[graphs.index(GRAPH_ID) + 1]
+        self.env.assertEquals(stats[0::2], metrics)
+        self.env.assertEquals(stats[1][1], 20)
+
+        # latency percentiles are reported by INFO
+        info = self.conn.info("graph_latency")
+        self.env.assertEquals(info["graph_ro_query_latency"]["calls"], 10)
+        self.env.assertIn("p999", info["graph_query_lock_wait"])
+
+        # reset histograms
+        self.env.assertEquals(self.conn.execute_command("GRAPH.INFO", "RESETSTAT"), "OK")
+        res = self.conn.execute_command("GRAPH.INFO", "Latency")
+        graphs = res[1][3]
+        stats = graphs[graphs.index(GRAPH_ID) + 1]
+        self.env.assertEquals(stats[1][1], 0)
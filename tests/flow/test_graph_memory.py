@@ -0,0 +1,101 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "memory"
+
+
+def to_dict(reply):
+    # convert a flat [name, value, name, value, ...] reply into a dict
+    return {reply[i]: reply[i + 1] for i in range(0, len(reply), 2)}
+
+
+class testGraphMemory():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        self.graph.query("""UNWIND range(0, 999) AS x
+                            CREATE (a:A {v: x, s: 'str_' + toString(x)})
+                            CREATE (b:B {v: x})
+                            CREATE (a)-[:R {v: x}]->(b), (a)-[:R {v: -x}]->(b)""")
+
+        # introduce deleted entities
+        self.graph.query("MATCH (a:A) WHERE a.v % 10 = 0 DETACH DELETE a")
+
+        create_node_exact_match_index(self.graph, 'A', 'v', sync=True)
+
+    def memory(self, *args):
+        return to_dict(self.redis_con.execute_command("GRAPH.MEMORY", GRAPH_ID, *args))
+
+    def test01_reply_structure(self):
+        res = self.memory()
+
+        self.env.assertEquals(res['samples'], 100)
+        self.env.assertGreater(res['total_bytes'], 0)
+
+        graph = to_dict(res['graph'])
+        self.env.assertGreater(graph['adjacency_matrix_bytes'], 0)
+        self.env.assertGreater(graph['node_attributes_bytes'], 0)
+        self.env.assertGreater(graph['edge_attributes_bytes'], 0)
+
+        node_block = to_dict(graph['node_block'])
+        self.env.assertGreater(node_block['used_bytes'], 0)
+        self.env.assertGreater(node_block['deleted_bytes'], 0)
+
+        labels = to_dict(res['labels'])
+        self.env.assertEquals(sorted(labels.keys()), ['A', 'B'])
+        a = to_dict(labels['A'])
+        self.env.assertEquals(a['nodes'], 900)
+        self.env.assertGreater(a['matrix_bytes'], 0)
+        self.env.assertGreater(a['attributes_bytes'], 0)
+
+        relations = to_dict(res['relations'])
+        self.env.assertEquals(list(relations.keys()), ['R'])
+        r = to_dict(relations['R'])
+        self.env.assertEquals(r['edges'], 1800)
+        self.env.assertGreater(r['transpose_bytes'], 0)
+        # every connected pair is connected by two edges
+        self.env.assertGreater(r['multi_edge_bytes'], 0)
+
+        attributes = to_dict(res['attributes'])
+        self.env.assertEquals(sorted(attributes.keys()), ['s', 'v'])
+        self.env.assertGreater(attributes['s'], 0)
+
+        indices = [to_dict(idx) for idx in res['indices']]
+        self.env.assertEquals(len(indices), 1)
+        self.env.assertEquals(indices[0]['label'], 'A')
+        self.env.assertEquals(indices[0]['entitytype'], 'NODE')
+        self.env.assertEquals(indices[0]['type'], 'exact-match')
+        self.env.assertGreater(indices[0]['bytes'], 0)
+
+    def test02_exhaustive_scan(self):
+        res = self.memory("SAMPLES", 0)
+        self.env.assertEquals(res['samples'], 0)
+
+        attributes = to_dict(res['attributes'])
+        self.env.assertGreater(attributes['s'], 0)
+        self.env.assertGreater(attributes['v'], 0)
+
+        # sampled estimates are in the same ballpark as exact figures
+        sampled = to_dict(self.memory("SAMPLES", 50)['graph'])
+        exact = to_dict(res['graph'])
+        self.env.assertGreater(sampled['node_attributes_bytes'], exact['node_attributes_bytes'] / 2)
+        self.env.assertLess(sampled['node_attributes_bytes'], exact['node_attributes_bytes'] * 2)
+
+    def test03_invalid_arguments(self):
+        for args in [["SAMPLES", -1], ["SAMPLES", "x"], ["LIMIT", 10]]:
+            try:
+                self.memory(*args)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
+
+        # missing graph
+        try:
+            self.redis_con.execute_command("GRAPH.MEMORY", "missing")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Invalid graph operation on empty key", str(e))
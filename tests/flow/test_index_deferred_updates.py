@@ -0,0 +1,151 @@
+from common import *
+from index_utils import *
+from constraint_utils import *
+
+GRAPH_ID = "index_deferred_updates"
+
+# index maintenance is deferred to the modifying operation's commit
+# validate indices reflect the final state of entities modified multiple times
+# within a single query
+class testIndexDeferredUpdates():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+
+        create_node_exact_match_index(self.graph, 'N', 'v', sync=True)
+        create_edge_exact_match_index(self.graph, 'R', 'v', sync=True)
+
+    def lookup(self, v):
+        q = "MATCH (n:N) WHERE n.v = $v RETURN n.id ORDER BY n.id"
+        plan = str(self.graph.explain(q, {'v': v}))
+        self.env.assertIn("Node By Index Scan", plan)
+        return [row[0] for row in self.graph.query(q, {'v': v}).result_set]
+
+    def lookup_edge(self, v):
+        q = "MATCH ()-[e:R]->() WHERE e.v = $v RETURN e.id ORDER BY e.id"
+        plan = str(self.graph.explain(q, {'v': v}))
+        self.env.assertIn("Edge By Index Scan", plan)
+        return [row[0] for row in self.graph.query(q, {'v': v}).result_set]
+
+    def test01_repeated_updates(self):
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:N {id: i, v: 0})")
+
+        # update the same nodes multiple times within a single query
+        q = """MATCH (n:N)
+               UNWIND range(1, 5) AS x
+               SET n.v = x"""
+        res = self.graph.query(q)
+        self.env.assertEquals(res.properties_set, 50)
+
+        self.env.assertEquals(self.lookup(0), [])
+        self.env.assertEquals(self.lookup(5), list(range(10)))
+
+        self.graph.query("MATCH (n:N) DELETE n")
+
+    def test02_create_then_match(self):
+        # entities created by an earlier clause are visible to a later
+        # index scan within the same query
+        q = """CREATE (:N {id: 1, v: 'a'})
+               WITH 1 AS x
+               MATCH (n:N) WHERE n.v = 'a'
+               RETURN n.id"""
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[1]])
+
+        self.graph.query("MATCH (n:N) DELETE n")
+
+    def test03_delete_and_recreate(self):
+        self.graph.query("CREATE (:N {id: 1, v: 'x'})")
+
+        # delete node and create a new one reusing its ID
+        q = """MATCH (n:N {v: 'x'}) DELETE n
+               WITH 1 AS x
+               CREATE (:N {id: 2, v: 'y'})"""
+        self.graph.query(q)
+
+        self.env.assertEquals(self.lookup('x'), [])
+        self.env.assertEquals(self.lookup('y'), [2])
+
+        self.graph.query("MATCH (n:N) DELETE n")
+
+    def test04_label_updates(self):
+        self.graph.query("CREATE (:M {id: 1, v: 'l'})")
+
+        # add and remove the indexed label within a single query
+        q = """MATCH (n:M)
+               SET n:N
+               WITH n
+               REMOVE n:N
+               WITH n
+               SET n:N"""
+        self.graph.query(q)
+        self.env.assertEquals(self.lookup('l'), [1])
+
+        q = """MATCH (n:N {id: 1})
+               REMOVE n:N"""
+        self.graph.query(q)
+        self.env.assertEquals(self.lookup('l'), [])
+
+        self.graph.query("MATCH (n) DELETE n")
+
+    def test05_edge_updates(self):
+        q = """UNWIND range(0, 9) AS i
+               CREATE (:A)-[:R {v: 0}]->(:B)"""
+        self.graph.query(q)
+
+        q = """MATCH ()-[e:R]->()
+               UNWIND range(1, 3) AS x
+               SET e.v = x"""
+        self.graph.query(q)
+
+        self.env.assertEquals(len(self.lookup_edge(0)), 0)
+        self.env.assertEquals(len(self.lookup_edge(3)), 10)
+
+        # delete all edges and create new ones reusing their IDs
+        q = """MATCH ()-[e:R]->() DELETE e
+               WITH count(1) AS x
+               MATCH (a:A), (b:B)
+               WITH a, b LIMIT 1
+               CREATE (b)-[:R {v: 4}]->(a)"""
+        self.graph.query(q)
+
+        self.env.assertEquals(len(self.lookup_edge(3)), 0)
+        self.env.assertEquals(len(self.lookup_edge(4)), 1)
+
+        self.graph.query("MATCH (n) DELETE n")
+
+    def test06_constraint_violation(self):
+        create_unique_node_constraint(self.graph, 'U', 'v', sync=True)
+
+        # violation among entities created by the same operation
+        try:
+            self.graph.query("CREATE (:U {v: 1}), (:U {v: 1})")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type U", str(e))
+
+        # violation introduced by an update
+        self.graph.query("CREATE (:U {v: 1}), (:U {v: 2})")
+        try:
+            self.graph.query("MATCH (n:U {v: 2}) SET n.v = 1")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("unique constraint violation on node of type U", str(e))
+
+        # failed queries are rolled back, index content is unaffected
+        q = "MATCH (n:U) WHERE n.v = 1 RETURN count(n)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], 1)
+
+        q = "MATCH (n:U) WHERE n.v = 2 RETURN count(n)"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], 1)
+
+        # swapping values within a single query doesn't violate the constraint
+        q = """MATCH (a:U {v: 1}), (b:U {v: 2})
+               SET a.v = 2, b.v = 1"""
+        self.graph.query(q)
+
+        res = self.graph.query("MATCH (n:U) RETURN n.v ORDER BY n.v").result_set
+        self.env.assertEquals(res, [[1], [2]])
@@ -0,0 +1,105 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "index_only_scan"
+
+class testIndexOnlyScan():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        q = """UNWIND range(0, 99) AS i
+               CREATE (:User {id: i, email: 'u' + tostring(i) + '@x.com',
+                              name: 'user' + tostring(i), age: i % 50})"""
+        self.graph.query(q)
+
+        # user without an id
+        self.graph.query("CREATE (:User {email: 'anon@x.com', name: 'anon'})")
+
+        create_node_exact_match_index(self.graph, 'User', 'email', 'id', 'age', sync=True)
+
+    def index_only(self, q, params=None):
+        plan = str(self.graph.explain(q, params))
+        return "Index Only" in plan
+
+    def test01_index_only_plan(self):
+        queries = ["MATCH (u:User {email: $e}) RETURN u.id",
+                   "MATCH (u:User {email: $e}) RETURN u.id, u.age + 1 AS age",
+                   "MATCH (u:User) WHERE u.age = 3 RETURN u.email ORDER BY u.id",
+                   "MATCH (u:User) WHERE u.age > 40 AND u.id % 2 = 0 RETURN count(u.id)",
+                   "MATCH (u:User) WHERE u.age < 5 RETURN u.age, collect(u.id)",
+                   "MATCH (u:User {email: $e}) WITH u.id AS id RETURN id"]
+
+        for q in queries:
+            self.env.assertTrue(self.index_only(q, {'e': 'u1@x.com'}))
+
+        # queries accessing the node itself or non-indexed attributes
+        # must fetch the node from the graph
+        queries = ["MATCH (u:User {email: $e}) RETURN u",
+                   "MATCH (u:User {email: $e}) RETURN u.name",
+                   "MATCH (u:User {email: $e}) RETURN id(u)",
+                   "MATCH (u:User {email: $e}) RETURN u.id, labels(u)",
+                   "MATCH (u:User {email: $e}) WHERE u.name = 'x' RETURN u.id",
+                   "MATCH (u:User {email: $e}) RETURN u.id ORDER BY u.name",
+                   "MATCH (u:User {email: $e}) RETURN [x IN [1] | u.name]",
+                   "MATCH (u:User {email: $e}) RETURN count(u)",
+                   "MATCH (u:User {email: $e}) WITH u RETURN u.id",
+                   "MATCH (u:User {email: $e})-[]->(v) RETURN u.id",
+                   "MATCH (u:User {email: $e}) SET u.age = 1 RETURN u.id"]
+
+        for q in queries:
+            self.env.assertFalse(self.index_only(q, {'e': 'u1@x.com'}))
+
+    def test02_index_only_results(self):
+        # results must match the ones produced by fetching nodes
+        queries = ["MATCH (u:User {email: 'u7@x.com'}) RETURN u.id, u.age",
+                   "MATCH (u:User {email: 'anon@x.com'}) RETURN u.id, u.email",
+                   "MATCH (u:User) WHERE u.age = 3 RETURN u.email, u.id ORDER BY u.id",
+                   "MATCH (u:User) WHERE u.age > 40 AND u.id % 2 = 0 RETURN count(u.id), sum(u.age)",
+                   "MATCH (u:User) WHERE u.age < 5 RETURN u.age, collect(u.id) ORDER BY u.age"]
+
+        for q in queries:
+            self.env.assertTrue(self.index_only(q))
+            actual = self.graph.query(q).result_set
+            # same query, accessing a non-indexed attribute forces a node fetch
+            expected = self.graph.query(q.replace("RETURN", "WITH u, u.name AS _ RETURN", 1)).result_set
+            self.env.assertEquals(actual, expected)
+
+        res = self.graph.query("MATCH (u:User {email: 'u7@x.com'}) RETURN u.id, u.age").result_set
+        self.env.assertEquals(res, [[7, 7]])
+
+        res = self.graph.query("MATCH (u:User {email: 'anon@x.com'}) RETURN u.id, u.email").result_set
+        self.env.assertEquals(res, [[None, 'anon@x.com']])
+
+    def test03_updates(self):
+        q = "MATCH (u:User {email: 'u9@x.com'}) RETURN u.id, u.age"
+        self.env.assertTrue(self.index_only(q))
+
+        # update covered attribute
+        self.graph.query("MATCH (u:User {email: 'u9@x.com'}) SET u.age = 100")
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[9, 100]])
+
+        # remove covered attribute
+        self.graph.query("MATCH (u:User {email: 'u9@x.com'}) REMOVE u.id")
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[None, 100]])
+
+        # delete node
+        self.graph.query("MATCH (u:User {email: 'u9@x.com'}) DELETE u")
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [])
+
+    def test04_new_indexed_attribute(self):
+        # indexing an additional attribute makes it covered
+        q = "MATCH (u:User {email: 'u3@x.com'}) RETURN u.name"
+        self.env.assertFalse(self.index_only(q))
+
+        create_node_exact_match_index(self.graph, 'User', 'name', sync=True)
+
+        self.env.assertTrue(self.index_only(q))
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [['user3']])
@@ -0,0 +1,98 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "index_population"
+
+# number of nodes, spans multiple population chunks
+NODE_COUNT = 200000
+
+class testIndexPopulation():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        q = """UNWIND range(0, $n - 1) AS i
+               CREATE (:Person {id: i, age: i % 100, name: 'p' + tostring(i)})"""
+        self.graph.query(q, {'n': NODE_COUNT})
+
+        q = """MATCH (a:Person), (b:Person)
+               WHERE a.id < 5000 AND b.id = a.id + 1
+               CREATE (a)-[:KNOWS {since: a.id % 10}]->(b)"""
+        self.graph.query(q)
+
+    def progress(self, label):
+        q = """CALL db.indexes() YIELD type, label, progress
+               WHERE label = $label
+               RETURN type, progress.indexed, progress.total
+               ORDER BY type"""
+        return self.graph.query(q, {'label': label}).result_set
+
+    def test01_populate_shared_label(self):
+        # create multiple indices over the same label back to back
+        # all of which are populated by a single pass over the graph
+        create_node_exact_match_index(self.graph, 'Person', 'age')
+        create_fulltext_index(self.graph, 'Person', 'name')
+        create_node_exact_match_index(self.graph, 'Person', 'id')
+
+        # population progress never exceeds total
+        for t, indexed, total in self.progress('Person'):
+            self.env.assertLessEqual(indexed, total)
+
+        wait_for_indices_to_sync(self.graph)
+
+        # fully populated
+        res = self.progress('Person')
+        self.env.assertEquals(res, [['exact-match', NODE_COUNT, NODE_COUNT],
+                                    ['full-text', NODE_COUNT, NODE_COUNT]])
+
+        # validate indices content
+        q = "MATCH (p:Person) WHERE p.age = 7 RETURN count(p)"
+        plan = str(self.graph.explain(q))
+        self.env.assertIn("Node By Index Scan", plan)
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], NODE_COUNT // 100)
+
+        # nodes from every chunk are indexed
+        for i in [0, 65535, 65536, 131072, NODE_COUNT - 1]:
+            q = "MATCH (p:Person {id: $id}) RETURN p.name"
+            res = self.graph.query(q, {'id': i}).result_set
+            self.env.assertEquals(res, [['p' + str(i)]])
+
+        q = "CALL db.idx.fulltext.queryNodes('Person', 'p199999') YIELD node RETURN node.id"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[NODE_COUNT - 1]])
+
+    def test02_populate_edges(self):
+        create_edge_exact_match_index(self.graph, 'KNOWS', 'since', sync=True)
+
+        res = self.progress('KNOWS')
+        self.env.assertEquals(res, [['exact-match', 5000, 5000]])
+
+        q = "MATCH ()-[e:KNOWS]->() WHERE e.since = 3 RETURN count(e)"
+        plan = str(self.graph.explain(q))
+        self.env.assertIn("Edge By Index Scan", plan)
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], 500)
+
+    def test03_modify_while_populating(self):
+        # create index and update the graph while the index is populated
+        create_node_exact_match_index(self.graph, 'Person', 'name')
+        self.graph.query("CREATE (:Person {id: -1, name: 'new'})")
+        self.graph.query("MATCH (p:Person {id: 0}) SET p.name = 'updated'")
+
+        wait_for_indices_to_sync(self.graph)
+
+        q = "MATCH (p:Person) WHERE p.name = 'new' RETURN p.id"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[-1]])
+
+        q = "MATCH (p:Person) WHERE p.name = 'updated' RETURN p.id"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[0]])
+
+        q = "MATCH (p:Person) WHERE p.name = 'p0' RETURN p.id"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [])
@@ -710,3 +710,68 @@ class testIndexScanFlow():
 
         # expecting an no index scan operation
         self.env.assertNotIn('Node By Index Scan', plan)
+
+    def test_24_index_intersection(self):
+        g = Graph(self.env.getConnection(), 'index_combination')
+
+        # country is indexed under Person, status is indexed under Employee
+        q = """UNWIND range(0, 999) AS i
+               CREATE (:Person:Employee {
+                 country: ['DE', 'FR', 'IT', 'ES', 'NL'][i % 5],
+                 status: CASE WHEN i % 4 = 0 THEN 'active' ELSE 'inactive' END})"""
+        g.query(q)
+
+        # nodes carrying only one of the labels
+        g.query("UNWIND range(0, 99) AS i CREATE (:Person {country: 'DE', status: 'active'})")
+        g.query("UNWIND range(0, 99) AS i CREATE (:Employee {country: 'DE', status: 'active'})")
+
+        create_node_exact_match_index(g, 'Person', 'country', sync=True)
+        create_node_exact_match_index(g, 'Employee', 'status', sync=True)
+
+        queries = ["MATCH (n:Person:Employee) WHERE n.country = 'DE' AND n.status = 'active' RETURN count(n)",
+                   "MATCH (n:Employee:Person) WHERE n.country = 'DE' AND n.status = 'active' RETURN count(n)",
+                   "MATCH (n:Person:Employee) WHERE n.status = 'active' AND n.country = 'DE' RETURN count(n)"]
+
+        for q in queries:
+            # both indices are utilized and intersected
+            plan = str(g.explain(q))
+            self.env.assertIn("Node By Index Scan", plan)
+            self.env.assertIn("Intersect", plan)
+            self.env.assertNotIn("Filter", plan)
+
+            res = g.query(q).result_set
+            self.env.assertEquals(res[0][0], 50)
+
+        # runtime values
+        q = """UNWIND ['DE', 'FR'] AS c
+               MATCH (n:Person:Employee)
+               WHERE n.country = c AND n.status = 'active'
+               RETURN c, count(n) ORDER BY c"""
+        plan = str(g.explain(q))
+        self.env.assertIn("Intersect", plan)
+        res = g.query(q).result_set
+        self.env.assertEquals(res, [['DE', 50], ['FR', 50]])
+
+    def test_25_index_union(self):
+        g = Graph(self.env.getConnection(), 'index_combination')
+
+        queries = ["MATCH (n:Person:Employee) WHERE n.country = 'DE' OR n.status = 'active' RETURN count(n)",
+                   "MATCH (n:Employee:Person) WHERE n.status = 'active' OR n.country = 'DE' RETURN count(n)"]
+
+        for q in queries:
+            # each disjunct is resolved by a different label index
+            plan = str(g.explain(q))
+            self.env.assertIn("Node By Index Scan", plan)
+            self.env.assertIn("Union", plan)
+            self.env.assertNotIn("Label Scan", plan)
+
+            # nodes carrying a single label are not reported
+            res = g.query(q).result_set
+            self.env.assertEquals(res[0][0], 400)
+
+        # disjunct which can't be resolved by an index
+        q = "MATCH (n:Person:Employee) WHERE n.country = 'DE' OR n.name = 'x' RETURN count(n)"
+        plan = str(g.explain(q))
+        self.env.assertNotIn("Union", plan)
+        res = g.query(q).result_set
+        self.env.assertEquals(res[0][0], 200)
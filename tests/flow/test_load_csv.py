@@ -0,0 +1,159 @@
+import os
+import tempfile
+from common import *
+
+graph = None
+GRAPH_ID = "load_csv"
+IMPORT_FOLDER = tempfile.mkdtemp()
+
+def write_csv(name, content):
+    with open(os.path.join(IMPORT_FOLDER, name), "w") as f:
+        f.write(content)
+
+class testLoadCSV():
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs=f"IMPORT_FOLDER {IMPORT_FOLDER}")
+        global graph
+        self.redis_con = self.env.getConnection()
+        graph = Graph(self.redis_con, GRAPH_ID)
+
+    def test01_without_headers(self):
+        write_csv("rows.csv", "a,b\n1,\"x,y\"\n,\"\"\n")
+
+        q = "LOAD CSV FROM 'file:///rows.csv' AS row RETURN row"
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [[['a', 'b']], [['1', 'x,y']], [[None, '']]])
+
+    def test02_with_headers(self):
+        write_csv("people.csv", "name,age\r\nAlice,30\r\nBob\r\n")
+
+        q = """LOAD CSV WITH HEADERS FROM 'file:///people.csv' AS row
+               RETURN row.name, row.age"""
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [['Alice', '30'], ['Bob', None]])
+
+    def test03_field_terminator(self):
+        write_csv("rows.tsv", "a;b;c\n")
+
+        q = "LOAD CSV FROM 'file:///rows.tsv' AS row FIELDTERMINATOR ';' RETURN row"
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [[['a', 'b', 'c']]])
+
+        # field terminator must be a single character
+        try:
+            q = "LOAD CSV FROM 'file:///rows.tsv' AS row FIELDTERMINATOR ';;' RETURN row"
+            graph.query(q)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("single character", str(e))
+
+    def test04_create(self):
+        write_csv("nodes.csv", "id\n" + "".join(f"{i}\n" for i in range(100)))
+
+        q = """LOAD CSV WITH HEADERS FROM 'file:///nodes.csv' AS row
+               CREATE (:N {id: toInteger(row.id)})"""
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 100)
+
+        res = graph.query("MATCH (n:N) RETURN count(n), sum(n.id)").result_set
+        self.env.assertEquals(res, [[100, sum(range(100))]])
+
+    def test05_periodic_commit(self):
+        write_csv("edges.csv", "".join(f"{i},{i+1}\n" for i in range(99)))
+
+        # batches do not evenly divide the number of rows
+        q = """USING PERIODIC COMMIT 7
+               LOAD CSV FROM 'file:///edges.csv' AS row
+               MATCH (a:N {id: toInteger(row[0])}), (b:N {id: toInteger(row[1])})
+               CREATE (a)-[e:R]->(b)
+               RETURN count(e)"""
+        res = graph.query(q)
+        self.env.assertEquals(res.relationships_created, 99)
+        self.env.assertEquals(res.result_set, [[99]])
+
+        q = "MATCH (a:N)-[:R]->(b:N) WHERE b.id <> a.id + 1 RETURN count(a)"
+        self.env.assertEquals(graph.query(q).result_set, [[0]])
+
+        # default batch size
+        q = """USING PERIODIC COMMIT
+               LOAD CSV FROM 'file:///edges.csv' AS row
+               CREATE (:M {v: row[0]})"""
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 99)
+
+        # a failing batch is rolled back, committed batches remain
+        q = """USING PERIODIC COMMIT 10
+               LOAD CSV FROM 'file:///edges.csv' AS row
+               CREATE (:F {v: 1 / (toInteger(row[0]) - 50)})"""
+        try:
+            graph.query(q)
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+        q = "MATCH (f:F) RETURN count(f)"
+        self.env.assertEquals(graph.query(q).result_set, [[50]])
+
+        # rows must stream directly into CREATE
+        q = """USING PERIODIC COMMIT 10
+               LOAD CSV FROM 'file:///edges.csv' AS row
+               WITH row ORDER BY row[0]
+               CREATE (:S {v: row[0]})"""
+        try:
+            graph.query(q)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("stream directly into CREATE", str(e))
+
+    def test06_periodic_commit_requires_load_csv(self):
+        try:
+            graph.query("USING PERIODIC COMMIT 10 CREATE (:N)")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("LOAD CSV", str(e))
+
+    def test07_invalid_url(self):
+        queries = [
+            "LOAD CSV FROM 'http://example.com/a.csv' AS row RETURN row",
+            "LOAD CSV FROM 1 AS row RETURN row",
+        ]
+        for q in queries:
+            try:
+                graph.query(q)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertContains("file:///", str(e))
+
+        # escaping the import folder is not allowed
+        try:
+            graph.query("LOAD CSV FROM 'file:///../etc/passwd' AS row RETURN row")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("outside of the import folder", str(e))
+
+        # missing file
+        try:
+            graph.query("LOAD CSV FROM 'file:///missing.csv' AS row RETURN row")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("failed to open", str(e))
+
+    def test08_malformed(self):
+        write_csv("malformed.csv", "a\n\"b\n")
+
+        try:
+            graph.query("LOAD CSV FROM 'file:///malformed.csv' AS row RETURN row")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("row 2", str(e))
+
+    def test09_url_per_record(self):
+        write_csv("a.csv", "1\n2\n")
+        write_csv("b.csv", "3\n")
+
+        q = """UNWIND ['a', 'b'] AS name
+               LOAD CSV FROM 'file:///' + name + '.csv' AS row
+               RETURN name, row[0]"""
+        res = graph.query(q).result_set
+        self.env.assertEquals(res, [['a', '1'], ['a', '2'], ['b', '3']])
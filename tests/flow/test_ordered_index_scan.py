@@ -0,0 +1,149 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "ordered_index_scan"
+
+class testOrderedIndexScan():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # every 10th node misses the 'ts' attribute
+        q = """UNWIND range(0, 999) AS i
+               CREATE (:E {id: i, ts: CASE WHEN i % 10 = 0 THEN NULL
+                                      ELSE (i * 7919) % 1000 END})"""
+        self.graph.query(q)
+
+        # unindexed copy of the data, used as reference
+        q = """MATCH (e:E) CREATE (:R {id: e.id, ts: e.ts})"""
+        self.graph.query(q)
+
+        create_node_exact_match_index(self.graph, 'E', 'ts', sync=True)
+
+    # compare query results against the unindexed reference label
+    def compare(self, query):
+        actual   = self.graph.query(query.format(label='E')).result_set
+        expected = self.graph.query(query.format(label='R')).result_set
+        self.env.assertEquals(actual, expected)
+
+    def test01_plan(self):
+        queries = ["MATCH (n:E) RETURN n ORDER BY n.ts LIMIT 5",
+                   "MATCH (n:E) RETURN n ORDER BY n.ts DESC LIMIT 5",
+                   "MATCH (n:E) WHERE n.id > 5 RETURN n.id ORDER BY n.ts",
+                   "MATCH (n:E) RETURN n.ts AS ts ORDER BY ts SKIP 3 LIMIT 2"]
+
+        for q in queries:
+            plan = str(self.graph.explain(q))
+            self.env.assertIn("Node By Ordered Index Scan", plan)
+            self.env.assertNotIn("Sort", plan)
+            self.env.assertNotIn("Label Scan", plan)
+
+        # sort isn't reduced when it can't be served by the index
+        queries = ["MATCH (n:R) RETURN n ORDER BY n.ts",
+                   "MATCH (n:E) RETURN n ORDER BY n.id",
+                   "MATCH (n:E) RETURN n ORDER BY n.ts, n.id",
+                   "MATCH (n:E) RETURN n ORDER BY n.ts + 1"]
+
+        for q in queries:
+            plan = str(self.graph.explain(q))
+            self.env.assertIn("Sort", plan)
+            self.env.assertNotIn("Node By Ordered Index Scan", plan)
+
+    def test02_order(self):
+        # nulls are last in ascending order and first in descending order
+        # order among nodes missing the attribute is undefined, only their
+        # values are compared
+        queries = ["MATCH (n:{label}) RETURN n.id, n.ts ORDER BY n.ts LIMIT 200",
+                   "MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC LIMIT 200",
+                   "MATCH (n:{label}) RETURN n.ts ORDER BY n.ts",
+                   "MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC",
+                   "MATCH (n:{label}) RETURN n.ts ORDER BY n.ts SKIP 895 LIMIT 10",
+                   "MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC SKIP 95 LIMIT 10",
+                   "MATCH (n:{label}) WHERE n.id % 3 = 0 RETURN n.ts ORDER BY n.ts DESC LIMIT 50"]
+
+        for q in queries:
+            self.compare(q)
+
+        # first nodes in order
+        q = "MATCH (n:E) RETURN n.ts ORDER BY n.ts LIMIT 3"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[1], [2], [3]])
+
+        q = "MATCH (n:E) RETURN n.ts ORDER BY n.ts DESC LIMIT 3"
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res, [[None], [None], [None]])
+
+    def test03_updates(self):
+        # update, remove and delete indexed nodes
+        self.graph.query("MATCH (n:E) WHERE n.id < 50 SET n.ts = -n.id")
+        self.graph.query("MATCH (n:R) WHERE n.id < 50 SET n.ts = -n.id")
+        self.graph.query("MATCH (n:E) WHERE n.id >= 50 AND n.id < 60 SET n.ts = NULL")
+        self.graph.query("MATCH (n:R) WHERE n.id >= 50 AND n.id < 60 SET n.ts = NULL")
+        self.graph.query("MATCH (n:E) WHERE n.id >= 900 DELETE n")
+        self.graph.query("MATCH (n:R) WHERE n.id >= 900 DELETE n")
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:E {id: 1000 + i, ts: 0.5 + i})")
+        self.graph.query("UNWIND range(0, 9) AS i CREATE (:R {id: 1000 + i, ts: 0.5 + i})")
+
+        self.compare("MATCH (n:{label}) RETURN n.id, n.ts ORDER BY n.ts LIMIT 100")
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC LIMIT 100")
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts")
+
+    def test04_non_numeric_values(self):
+        # string values can't be ordered by the index
+        # the operation falls back to a full sort
+        self.graph.query("MATCH (n:E) WHERE n.id IN [1, 2, 3] SET n.ts = toString(n.id)")
+        self.graph.query("MATCH (n:R) WHERE n.id IN [1, 2, 3] SET n.ts = toString(n.id)")
+
+        plan = str(self.graph.explain("MATCH (n:E) RETURN n ORDER BY n.ts"))
+        self.env.assertIn("Node By Ordered Index Scan", plan)
+
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts")
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC LIMIT 10")
+
+        # restore numeric values
+        self.graph.query("MATCH (n:E) WHERE n.id IN [1, 2, 3] SET n.ts = n.id")
+        self.graph.query("MATCH (n:R) WHERE n.id IN [1, 2, 3] SET n.ts = n.id")
+
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC LIMIT 10")
+
+    def test05_persistence(self):
+        # spread the graph and its indices over multiple virtual keys
+        self.redis_con.execute_command("GRAPH.CONFIG", "SET", "VKEY_MAX_ENTITY_COUNT", 10)
+
+        self.graph.query("MATCH (n:E) WHERE n.id IN [4, 5] SET n.ts = 'x'")
+        self.graph.query("MATCH (n:R) WHERE n.id IN [4, 5] SET n.ts = 'x'")
+
+        # ordered index is restored from the RDB rather than rebuilt
+        self.redis_con.execute_command("DEBUG", "RELOAD")
+
+        plan = str(self.graph.explain("MATCH (n:E) RETURN n ORDER BY n.ts"))
+        self.env.assertIn("Node By Ordered Index Scan", plan)
+
+        self.compare("MATCH (n:{label}) RETURN n.id, n.ts ORDER BY n.ts LIMIT 100")
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC")
+
+        # restored index remains updatable
+        self.graph.query("MATCH (n:E) WHERE n.id IN [4, 5] SET n.ts = -100 - n.id")
+        self.graph.query("MATCH (n:R) WHERE n.id IN [4, 5] SET n.ts = -100 - n.id")
+        self.graph.query("MATCH (n:E) WHERE n.id >= 800 AND n.id < 850 DELETE n")
+        self.graph.query("MATCH (n:R) WHERE n.id >= 800 AND n.id < 850 DELETE n")
+
+        self.compare("MATCH (n:{label}) RETURN n.id, n.ts ORDER BY n.ts LIMIT 100")
+        self.compare("MATCH (n:{label}) RETURN n.ts ORDER BY n.ts DESC")
+
+        self.redis_con.execute_command("GRAPH.CONFIG", "SET", "VKEY_MAX_ENTITY_COUNT", 100000)
+
+    def test06_dropped_index(self):
+        # cache the execution plan
+        q = "MATCH (n:{label}) RETURN n.id, n.ts ORDER BY n.ts LIMIT 20"
+        self.compare(q)
+
+        drop_exact_match_index(self.graph, 'E', 'ts')
+
+        # results remain ordered once the index is dropped
+        self.compare(q)
+        plan = str(self.graph.explain(q.format(label='E')))
+        self.env.assertNotIn("Node By Ordered Index Scan", plan)
@@ -369,9 +369,14 @@ class testProcedures(FlowTestsBase):
                            ["WRITE", "db.idx.fulltext.createNodeIndex"],
                            ["WRITE", "db.idx.fulltext.drop"],
                            ["READ", "db.idx.fulltext.queryNodes"],
+                           ["WRITE", "db.idx.vector.createNodeIndex"],
+                           ["WRITE", "db.idx.vector.drop"],
+                           ["READ", "db.idx.vector.query"],
                            ["READ", "db.indexes"],
                            ["READ", "db.labels"],
                            ["READ", "db.propertyKeys"],
+                           ["READ", "db.queryStats"],
+                           ["READ", "db.queryStats.reset"],
                            ["READ", "db.relationshipTypes"],
                            ["READ", "dbms.procedures"]]
         self.env.assertEquals(actual_resultset, expected_result)
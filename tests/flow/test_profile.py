@@ -39,3 +39,35 @@ class testProfile(FlowTestsBase):
         self.env.assertIn("Update | Records produced: 0", profile)
         self.env.assertIn("Conditional Variable Length Traverse | (a)-[@anon_1*1..INF]->(@anon_0) | Records produced: 0", profile)
         self.env.assertIn("Node By Label Scan | (a:L) | Records produced: 0", profile)
+
+    def test03_profile_memory(self):
+        # populate graph
+        redis_graph.query("UNWIND range(1, 100) AS x CREATE (:A {v: x})-[:R]->(:B {s: 'str_' + toString(x)})")
+
+        q = "MATCH (a:A)-[:R]->(b:B) RETURN collect(b.s)"
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+
+        def stats(line):
+            # parse operation statistics, e.g.
+            # "Aggregate | Records produced: 1, Execution time: ...
+            fields = line.split('|')[-1].split(',')
+            return {f.split(':')[0].strip(): f.split(':')[1].strip() for f in fields}
+
+        ops = {x.strip().split(' |')[0]: stats(x) for x in profile}
+
+        # every operation reports its memory consumption
+        for op in ops.values():
+            self.env.assertIn('Memory allocated', op)
+            self.env.assertIn('Peak memory', op)
+            self.env.assertIn('Allocations', op)
+
+        # aggregation allocates its collected list
+        aggregate = ops['Aggregate']
+        self.env.assertGreater(int(aggregate['Memory allocated'].split()[0]), 0)
+        self.env.assertGreater(int(aggregate['Allocations']), 0)
+
+        # traversal ops report GraphBLAS statistics
+        traverse = ops['Conditional Traverse']
+        self.env.assertIn('GraphBLAS time', traverse)
+        self.env.assertEquals(traverse['Matrix entries'], '100')
+        self.env.assertNotIn('GraphBLAS time', ops['Node By Label Scan'])
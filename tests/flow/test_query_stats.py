@@ -0,0 +1,80 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "query_stats"
+
+STATS_QUERY = """CALL db.queryStats()
+                 YIELD query, calls, totalTime, meanTime, maxTime, rows,
+                       cacheHitRatio, memoryPeak, lockWait, planChanges
+                 RETURN query, calls, totalTime, meanTime, maxTime, rows,
+                        cacheHitRatio, memoryPeak, lockWait, planChanges
+                 ORDER BY query"""
+
+
+class testQueryStats():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+        self.graph.query("UNWIND range(0, 99) AS x CREATE (:N {v: x, s: 'str'})")
+
+    def stats(self):
+        # skip procedure calls and graph population
+        res = self.graph.query(STATS_QUERY).result_set
+        return [row for row in res if row[0].startswith("MATCH")]
+
+    def test01_fingerprint(self):
+        self.graph.query("CALL db.queryStats.reset()")
+
+        # queries differing only in literals share a fingerprint
+        self.graph.query("MATCH (n:N) WHERE n.v < 10 RETURN n.v")
+        self.graph.query("MATCH (n:N)  WHERE n.v < 20\nRETURN n.v")
+        self.graph.query("MATCH (n:N) WHERE n.v < 10 RETURN n.v")
+        self.graph.query("MATCH (n:N) WHERE n.s = 'a' AND n.v > 2.5 RETURN count(n)")
+
+        res = self.stats()
+        self.env.assertEquals(len(res), 2)
+
+        count = res[0]
+        self.env.assertEquals(count[0], "MATCH (n:N) WHERE n.s = ? AND n.v > ? RETURN count(n)")
+        self.env.assertEquals(count[1], 1)
+        self.env.assertEquals(count[5], 1)
+
+        scan = res[1]
+        query, calls, total, mean, max, rows, hit_ratio, _, lock_wait, plan_changes = scan
+        self.env.assertEquals(query, "MATCH (n:N) WHERE n.v < ? RETURN n.v")
+        self.env.assertEquals(calls, 3)
+        self.env.assertEquals(rows, 40)
+        self.env.assertAlmostEqual(mean, total / 3, 0.0001)
+        self.env.assertGreaterEqual(total, max)
+        self.env.assertGreaterEqual(lock_wait, 0)
+        # the third execution utilized the plan cached by the first one
+        self.env.assertAlmostEqual(hit_ratio, 1 / 3, 0.0001)
+        self.env.assertEquals(plan_changes, 0)
+
+    def test02_plan_changes(self):
+        self.graph.query("CALL db.queryStats.reset()")
+
+        self.graph.query("MATCH (n:N) WHERE n.v = 1 RETURN n.v")
+
+        # creating an index invalidates the plan cache and changes the plan
+        create_node_exact_match_index(self.graph, 'N', 'v', sync=True)
+        self.graph.query("MATCH (n:N) WHERE n.v = 2 RETURN n.v")
+
+        res = self.stats()
+        self.env.assertEquals(len(res), 1)
+        self.env.assertEquals(res[0][0], "MATCH (n:N) WHERE n.v = ? RETURN n.v")
+        self.env.assertEquals(res[0][1], 2)
+        self.env.assertEquals(res[0][9], 1)
+
+    def test03_reset(self):
+        self.graph.query("MATCH (n:N) RETURN count(n)")
+        self.env.assertGreater(len(self.stats()), 0)
+
+        self.graph.query("CALL db.queryStats.reset()")
+        self.env.assertEquals(len(self.stats()), 0)
+
+        # GRAPH.INFO RESETSTAT clears statistics of all graphs
+        self.graph.query("MATCH (n:N) RETURN count(n)")
+        self.conn.execute_command("GRAPH.INFO", "RESETSTAT")
+        self.env.assertEquals(len(self.stats()), 0)
@@ -189,3 +189,56 @@ class testResultSetFlow(FlowTestsBase):
         query = """RETURN 'Foo\r\nBar'"""
         result = graph.query(query)
         self.env.assertEqual(result.result_set[0][0], 'Foo\r\nBar')
+
+    # result-sets larger than the streaming threshold are emitted
+    # as rows are produced, the reply layout must remain the same
+    def test11_streamed_resultset(self):
+        n = 5000
+        query = f"UNWIND range(1, {n}) AS x RETURN x, toString(x) AS s"
+
+        # compact
+        result = graph.query(query)
+        self.env.assertEquals(len(result.header), 2)
+        self.env.assertEquals(len(result.result_set), n)
+        for i, row in enumerate(result.result_set):
+            self.env.assertEquals(row, [i + 1, str(i + 1)])
+
+        # verbose
+        res = redis_con.execute_command("GRAPH.QUERY", "G", query)
+        self.env.assertEquals(len(res), 3)
+        self.env.assertEquals(res[0], ['x', 's'])
+        self.env.assertEquals(len(res[1]), n)
+        self.env.assertEquals(res[1][0], [1, '1'])
+        self.env.assertEquals(res[1][-1], [n, str(n)])
+
+        # result-set size limit applies to streamed result-sets
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_SIZE", 2000)
+        result = graph.query(query)
+        self.env.assertEquals(len(result.result_set), 2000)
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_SIZE", -1)
+
+    # an error encountered after rows were streamed
+    # takes the place of the statistics
+    def test12_error_while_streaming(self):
+        query = "UNWIND range(1, 3000) AS x RETURN x / (2000 - x)"
+
+        res = redis_con.execute_command("GRAPH.QUERY", "G", query)
+        self.env.assertEquals(len(res), 3)
+        self.env.assertEquals(len(res[1]), 1999)
+        self.env.assertTrue(isinstance(res[2], ResponseError))
+        self.env.assertIn("Division by zero", str(res[2]))
+
+        # the client raises the error
+        try:
+            graph.query(query)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Division by zero", str(e))
+
+        # errors in small result-sets replace the entire reply
+        query = "UNWIND range(1, 10) AS x RETURN x / (5 - x)"
+        try:
+            redis_con.execute_command("GRAPH.QUERY", "G", query)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Division by zero", str(e))
@@ -0,0 +1,257 @@
+from common import *
+from index_utils import *
+import os
+import struct
+import tempfile
+
+GRAPH_ID = "snapshot"
+IMPORT_FOLDER = tempfile.mkdtemp()
+
+
+class testSnapshot():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, enableDebugCommand=True,
+                       moduleArgs=f"IMPORT_FOLDER {IMPORT_FOLDER}")
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        # snapshot paths are relative to the import folder
+        self.path = f"{GRAPH_ID}.snapshot"
+        self.file = os.path.join(IMPORT_FOLDER, self.path)
+        self.populate_graph()
+
+    def populate_graph(self):
+        self.graph.query("""UNWIND range(0, 99) AS x
+                            CREATE (a:A {v: x, s: 'str_' + toString(x), f: x / 3.0, arr: [x, 'e' + toString(x), [x]]})
+                            CREATE (b:B:C {v: x, p: point({latitude: x, longitude: x}), d: date('2020-01-01')})
+                            CREATE (a)-[:R {v: x}]->(b), (a)-[:R {v: -x}]->(b), (b)-[:S]->(a)""")
+
+        # introduce deleted entities
+        self.graph.query("MATCH (a:A) WHERE a.v % 10 = 0 DETACH DELETE a")
+
+        create_node_exact_match_index(self.graph, 'A', 'v', sync=True)
+        create_edge_exact_match_index(self.graph, 'R', 'v', sync=True)
+        create_vector_index(self.graph, 'B', 'p2', 2, sync=True)
+        self.graph.query("MATCH (b:B) SET b.p2 = [b.v, b.v * 2]")
+
+    def queries(self):
+        return [
+            "MATCH (a:A) RETURN a ORDER BY a.v",
+            "MATCH (a)-[r]->(b) RETURN ID(a), type(r), r.v, ID(b) ORDER BY ID(a), r.v, ID(b)",
+            "MATCH (b:B:C) RETURN b ORDER BY b.v",
+            "MATCH (n) RETURN labels(n), count(n) ORDER BY labels(n)",
+            "CALL db.indexes() YIELD type, label, properties, entitytype RETURN type, label, properties, entitytype ORDER BY label, type",
+            "CALL db.idx.vector.query('B', 'p2', 3, [10, 20]) YIELD node RETURN node.v",
+        ]
+
+    def test01_save_and_load(self):
+        expected = [self.graph.query(q).result_set for q in self.queries()]
+
+        res = self.redis_con.execute_command("GRAPH.SNAPSHOT", "SAVE", GRAPH_ID, self.path)
+        self.env.assertEquals(res, "OK")
+
+        # loading requires a new graph key
+        try:
+            self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", GRAPH_ID, self.path)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("already exists", str(e))
+
+        self.redis_con.delete(GRAPH_ID)
+
+        res = self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", GRAPH_ID, self.path)
+        self.env.assertEquals(res, "190 nodes loaded, 270 edges loaded")
+
+        wait_for_indices_to_sync(self.graph)
+
+        actual = [self.graph.query(q).result_set for q in self.queries()]
+        for a, e in zip(actual, expected):
+            self.env.assertEquals(a, e)
+
+        # index lookups are served by restored indices
+        plan = self.graph.execution_plan("MATCH (a:A {v: 5}) RETURN a")
+        self.env.assertIn("Node By Index Scan", plan)
+        res = self.graph.query("MATCH (a:A {v: 5}) RETURN a.s").result_set
+        self.env.assertEquals(res, [["str_5"]])
+
+    def test02_modify_loaded_graph(self):
+        # values loaded from the snapshot are replaced once modified
+        self.graph.query("MATCH (a:A) WHERE a.v < 50 SET a.s = a.s + '_updated'")
+        self.graph.query("MATCH (a:A) WHERE a.v >= 90 DETACH DELETE a")
+        self.graph.query("CREATE (:A {v: 1000, s: 'new'})")
+
+        res = self.graph.query("MATCH (a:A) WHERE a.v IN [1, 55, 1000] RETURN a.s ORDER BY a.v").result_set
+        self.env.assertEquals(res, [["str_1_updated"], ["str_55"], ["new"]])
+
+        # a loaded graph survives being saved over and reloaded
+        expected = [self.graph.query(q).result_set for q in self.queries()]
+        res = self.redis_con.execute_command("GRAPH.SNAPSHOT", "SAVE", GRAPH_ID, self.path)
+        self.env.assertEquals(res, "OK")
+
+        self.redis_con.execute_command("DEBUG", "RELOAD")
+        actual = [self.graph.query(q).result_set for q in self.queries()]
+        for a, e in zip(actual, expected):
+            self.env.assertEquals(a, e)
+
+        self.redis_con.delete(GRAPH_ID)
+        self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", GRAPH_ID, self.path)
+        wait_for_indices_to_sync(self.graph)
+
+        actual = [self.graph.query(q).result_set for q in self.queries()]
+        for a, e in zip(actual, expected):
+            self.env.assertEquals(a, e)
+
+    def test03_invalid_snapshot(self):
+        # missing file and directory
+        # errors don't disclose file system details
+        os.makedirs(os.path.join(IMPORT_FOLDER, "dir"), exist_ok=True)
+        for path in ["nonexistent/file", "dir"]:
+            try:
+                self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", "missing", path)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertEquals("Failed to open snapshot file", str(e))
+            self.env.assertFalse(self.redis_con.exists("missing"))
+
+        # truncated file, no graph is left behind
+        with open(self.file, 'rb') as f:
+            data = f.read()
+
+        for size in [16, len(data) // 2]:
+            truncated = self.path + ".truncated"
+            with open(os.path.join(IMPORT_FOLDER, truncated), 'wb') as f:
+                f.write(data[:size])
+
+            try:
+                self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", "truncated", truncated)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Snapshot file format error", str(e))
+            self.env.assertFalse(self.redis_con.exists("truncated"))
+            os.remove(os.path.join(IMPORT_FOLDER, truncated))
+
+        # unknown subcommand
+        try:
+            self.redis_con.execute_command("GRAPH.SNAPSHOT", "DUMP", GRAPH_ID, self.path)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Unknown GRAPH.SNAPSHOT subcommand", str(e))
+
+        os.remove(self.file)
+
+    def test04_paths_confined_to_import_folder(self):
+        # absolute paths are resolved within the import folder
+        res = self.redis_con.execute_command("GRAPH.SNAPSHOT", "SAVE", GRAPH_ID, "/" + self.path)
+        self.env.assertEquals(res, "OK")
+        self.env.assertTrue(os.path.exists(self.file))
+
+        # paths leading outside of the import folder are rejected
+        outside = os.path.join(os.path.dirname(IMPORT_FOLDER), f"{GRAPH_ID}_{os.getpid()}.snapshot")
+        escape = "../" + os.path.basename(outside)
+        for op, key in [("SAVE", GRAPH_ID), ("LOAD", "escaped")]:
+            try:
+                self.redis_con.execute_command("GRAPH.SNAPSHOT", op, key, escape)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("outside of the import folder", str(e))
+        self.env.assertFalse(os.path.exists(outside))
+        self.env.assertFalse(self.redis_con.exists("escaped"))
+
+        os.remove(self.file)
+
+    def test05_corrupted_matrices(self):
+        # R holds a multi-edge entry, S holds single edges
+        src = Graph(self.redis_con, "corrupted_src")
+        src.query("""CREATE (a:L)-[:R]->(b:L), (a)-[:R]->(b), (a)-[:S]->(b), (b)-[:S]->(a)""")
+        res = self.redis_con.execute_command("GRAPH.SNAPSHOT", "SAVE", "corrupted_src", self.path)
+        self.env.assertEquals(res, "OK")
+
+        with open(self.file, 'rb') as f:
+            data = f.read()
+
+        # locate matrices within the matrices section
+        # header: magic, version, attribute size, section table
+        offset, _ = struct.unpack_from("=QQ", data, 16 + 4 * 16)
+        label_count, relation_count = struct.unpack_from("=QQ", data, offset)
+        pos = offset + 16
+        matrices = []
+        for _ in range(label_count + relation_count):
+            blob_size, multi_len = struct.unpack_from("=QQ", data, pos)
+            blob = pos + 16
+            multi = blob + (blob_size + 7) // 8 * 8
+            matrices.append((blob, blob_size, multi, multi_len))
+            pos = multi + multi_len * 8
+
+        self.env.assertEquals(len(matrices), 3)
+        _, _, r_multi, r_multi_len = matrices[1]
+        s_blob, s_blob_size, _, _ = matrices[2]
+        self.env.assertEquals(r_multi_len, 5)
+
+        corruptions = [
+            r_multi,                    # multi-edge source out of bounds
+            r_multi + 8,                # multi-edge destination out of bounds
+            r_multi + 3 * 8,            # unknown multi-edge ID
+            s_blob + s_blob_size - 8,   # unknown edge ID
+        ]
+
+        corrupted = self.path + ".corrupted"
+        for pos in corruptions:
+            buf = bytearray(data)
+            struct.pack_into("=Q", buf, pos, 1 << 40)
+            with open(os.path.join(IMPORT_FOLDER, corrupted), 'wb') as f:
+                f.write(buf)
+
+            try:
+                self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", "corrupted", corrupted)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Snapshot file format error", str(e))
+            self.env.assertFalse(self.redis_con.exists("corrupted"))
+
+        os.remove(os.path.join(IMPORT_FOLDER, corrupted))
+        os.remove(self.file)
+        src.delete()
+
+
+class testSnapshotReplication():
+    def __init__(self):
+        # skip test if we're running under Valgrind
+        if VALGRIND or SANITIZER != "":
+            Env.skip(None) # valgrind is not working correctly with replication
+
+        self.env = Env(decodeResponses=True, env='oss', useSlaves=True,
+                       useAof=True, enableDebugCommand=True,
+                       moduleArgs=f"IMPORT_FOLDER {IMPORT_FOLDER}")
+        self.redis_con = self.env.getConnection()
+        self.replica_con = self.env.getSlaveConnection()
+        self.path = f"{GRAPH_ID}_replication.snapshot"
+        self.file = os.path.join(IMPORT_FOLDER, self.path)
+
+    def test01_load_replicates_contents(self):
+        g = Graph(self.redis_con, GRAPH_ID)
+        g.query("""UNWIND range(0, 99) AS x
+                   CREATE (:A {v: x, s: toString(x)})-[:R {v: x}]->(:B {v: x})""")
+        g.query("MATCH (a:A) WHERE a.v % 10 = 0 DETACH DELETE a")
+
+        res = self.redis_con.execute_command("GRAPH.SNAPSHOT", "SAVE", GRAPH_ID, self.path)
+        self.env.assertEquals(res, "OK")
+
+        queries = [
+            "MATCH (a:A)-[r:R]->(b:B) RETURN ID(a), a.v, a.s, ID(r), r.v, ID(b), b.v ORDER BY ID(a)",
+            "MATCH (n) RETURN labels(n), count(n) ORDER BY labels(n)",
+        ]
+        expected = [g.query(q).result_set for q in queries]
+
+        self.redis_con.delete(GRAPH_ID)
+        self.redis_con.execute_command("GRAPH.SNAPSHOT", "LOAD", GRAPH_ID, self.path)
+
+        # neither the replica nor the AOF depend on the snapshot file
+        os.remove(self.file)
+        self.redis_con.execute_command("WAIT", "1", "0")
+
+        replica = Graph(self.replica_con, GRAPH_ID)
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(replica.ro_query(q).result_set, e)
+
+        self.redis_con.execute_command("DEBUG", "LOADAOF")
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(g.query(q).result_set, e)
@@ -0,0 +1,121 @@
+from common import *
+import os
+import tempfile
+import time
+
+GRAPH_ID = "tiered_storage"
+SPILL_FOLDER = tempfile.mkdtemp()
+
+# sweep often, spill any string of at least 16 bytes
+SWEEP_INTERVAL = 50
+
+
+class testTieredStorage():
+    def __init__(self):
+        self.env = Env(decodeResponses=True,
+                       moduleArgs=f"TIERED_STORAGE_FOLDER {SPILL_FOLDER} "
+                                  f"TIERED_STORAGE_MIN_VALUE_SIZE 16 "
+                                  f"TIERED_STORAGE_SWEEP_INTERVAL {SWEEP_INTERVAL}")
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+
+    def wait_for_sweeps(self):
+        # an unaccessed value is spilled by the second sweep to visit it
+        time.sleep(SWEEP_INTERVAL * 10 / 1000)
+
+    def test01_config(self):
+        res = self.redis_con.execute_command("GRAPH.CONFIG", "GET", "TIERED_STORAGE_FOLDER")
+        self.env.assertEquals(res, ["TIERED_STORAGE_FOLDER", SPILL_FOLDER])
+
+        res = self.redis_con.execute_command("GRAPH.CONFIG", "GET", "TIERED_STORAGE_MIN_VALUE_SIZE")
+        self.env.assertEquals(res, ["TIERED_STORAGE_MIN_VALUE_SIZE", 16])
+
+        # tiered storage can only be configured at load time
+        try:
+            self.redis_con.execute_command("GRAPH.CONFIG", "SET", "TIERED_STORAGE_MIN_VALUE_SIZE", 32)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("This configuration parameter cannot be set at run-time", str(e))
+
+        # spill file is removed from the file system once created
+        self.env.assertEquals(os.listdir(SPILL_FOLDER), [])
+
+    def test02_spilled_values_are_faulted_in(self):
+        self.graph.query("""UNWIND range(0, 999) AS x
+                            CREATE (a:A {v: x, short: 's' + toString(x), long: 'long_string_value_' + toString(x)})
+                            CREATE (a)-[:R {long: 'long_edge_value_' + toString(x)}]->(a)""")
+
+        expected = self.graph.query("MATCH (a:A)-[r]->() RETURN a.v, a.short, a.long, r.long ORDER BY a.v").result_set
+
+        self.wait_for_sweeps()
+
+        actual = self.graph.query("MATCH (a:A)-[r]->() RETURN a.v, a.short, a.long, r.long ORDER BY a.v").result_set
+        self.env.assertEquals(actual, expected)
+
+        # filter on spilled values
+        self.wait_for_sweeps()
+        res = self.graph.query("MATCH (a:A) WHERE a.long ENDS WITH '_999' RETURN a.v").result_set
+        self.env.assertEquals(res, [[999]])
+
+    def test03_modify_spilled_values(self):
+        self.wait_for_sweeps()
+
+        # update, remove and re-set spilled values
+        self.graph.query("MATCH (a:A) WHERE a.v < 100 SET a.long = a.long + '_updated'")
+        self.graph.query("MATCH (a:A) WHERE a.v >= 100 AND a.v < 200 SET a.long = NULL")
+        self.graph.query("MATCH (a:A) WHERE a.v >= 200 AND a.v < 300 SET a.long = 'long_string_value_' + toString(a.v)")
+        self.graph.query("MATCH (a:A) WHERE a.v >= 900 DETACH DELETE a")
+
+        self.wait_for_sweeps()
+
+        res = self.graph.query("MATCH (a:A) WHERE a.v IN [0, 150, 250, 500] RETURN a.v, a.long ORDER BY a.v").result_set
+        self.env.assertEquals(res, [[0, "long_string_value_0_updated"],
+                                    [150, None],
+                                    [250, "long_string_value_250"],
+                                    [500, "long_string_value_500"]])
+
+        res = self.graph.query("MATCH (a:A) RETURN count(a)").result_set
+        self.env.assertEquals(res, [[900]])
+
+    def test04_persistence(self):
+        self.wait_for_sweeps()
+
+        expected = self.graph.query("MATCH (a:A)-[r]->() RETURN a.v, a.short, a.long, r.long ORDER BY a.v").result_set
+
+        # spilled values are faulted in when the graph is encoded
+        self.wait_for_sweeps()
+        self.redis_con.execute_command("DEBUG", "RELOAD")
+
+        actual = self.graph.query("MATCH (a:A)-[r]->() RETURN a.v, a.short, a.long, r.long ORDER BY a.v").result_set
+        self.env.assertEquals(actual, expected)
+
+    def test05_failed_fault_in(self):
+        g = Graph(self.redis_con, "spill_failure")
+        g.query("UNWIND range(0, 9) AS x CREATE (:B {v: x, long: 'long_string_value_' + toString(x)})")
+
+        self.wait_for_sweeps()
+
+        # truncate the spill file through its open descriptor
+        pid = self.redis_con.info("server")["process_id"]
+        fds = f"/proc/{pid}/fd"
+        for fd in os.listdir(fds):
+            try:
+                target = os.readlink(os.path.join(fds, fd))
+            except OSError:
+                continue
+            if "redisgraph-spill" in target:
+                os.truncate(os.path.join(fds, fd), 0)
+
+        # reading a value which can't be faulted in fails the query
+        # the value remains spilled rather than being replaced
+        for _ in range(2):
+            try:
+                g.query("MATCH (b:B) RETURN b.long")
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Failed to read attribute value from tiered storage", str(e))
+
+        # unreadable values can still be overwritten
+        g.query("MATCH (b:B) SET b.long = 'short'")
+        res = g.query("MATCH (b:B) RETURN DISTINCT b.long").result_set
+        self.env.assertEquals(res, [["short"]])
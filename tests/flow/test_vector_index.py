@@ -0,0 +1,192 @@
+from common import *
+from index_utils import *
+
+GRAPH_ID = "vector_index"
+
+class testVectorIndex():
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        self.redis_con = self.env.getConnection()
+        self.graph = Graph(self.redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # points on a 2D grid, p.v = [x, y]
+        q = """UNWIND range(0, 9) AS x
+               UNWIND range(0, 9) AS y
+               CREATE (:P {x: x, y: y, v: [x, y]})"""
+        self.graph.query(q)
+
+    def knn(self, k, vec):
+        q = f"""CALL db.idx.vector.query('P', 'v', {k}, {vec})
+               YIELD node, distance
+               RETURN node.v, distance"""
+        return self.graph.query(q, read_only=True).result_set
+
+    def test01_create_index(self):
+        res = create_vector_index(self.graph, 'P', 'v', 2, sync=True)
+        self.env.assertEquals(res.indices_created, 1)
+
+        # a single vector index per label
+        try:
+            create_vector_index(self.graph, 'P', 'w', 2)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Index already exists", str(e))
+
+        res = self.graph.query("CALL db.indexes() YIELD type, label, properties, info WHERE type = 'vector' RETURN label, properties, info")
+        self.env.assertEquals(len(res.result_set), 1)
+        self.env.assertEquals(res.result_set[0][0], 'P')
+        self.env.assertEquals(res.result_set[0][1], ['v'])
+        info = res.result_set[0][2]
+        self.env.assertEquals(info['dimension'], 2)
+        self.env.assertEquals(info['similarityFunction'], 'euclidean')
+        self.env.assertEquals(info['numDocuments'], 100)
+
+    def test02_invalid_configuration(self):
+        queries = [
+            "CALL db.idx.vector.createNodeIndex('Q')",
+            "CALL db.idx.vector.createNodeIndex({label: 'Q', attribute: 'v'})",
+            "CALL db.idx.vector.createNodeIndex({label: 'Q', attribute: 'v', dimension: 0})",
+            "CALL db.idx.vector.createNodeIndex({label: 'Q', attribute: 'v', dimension: 4, similarityFunction: 'manhattan'})",
+            "CALL db.idx.vector.createNodeIndex({label: 'Q', attribute: 'v', dimension: 4, M: 1})",
+        ]
+        for q in queries:
+            try:
+                self.graph.query(q)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
+
+        # querying a missing index or with a mismatching vector fails
+        queries = [
+            "CALL db.idx.vector.query('Q', 'v', 1, [1, 2])",
+            "CALL db.idx.vector.query('P', 'v', 1, [1, 2, 3])",
+            "CALL db.idx.vector.query('P', 'v', 1, ['a', 'b'])",
+        ]
+        for q in queries:
+            try:
+                self.graph.query(q)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
+
+    def test03_query(self):
+        res = self.knn(5, [3, 3])
+        self.env.assertEquals(len(res), 5)
+
+        # exact match first, then its 4 direct neighbors
+        self.env.assertEquals(res[0], [[3, 3], 0.0])
+        self.env.assertEquals(sorted(r[0] for r in res[1:]),
+                              [[2, 3], [3, 2], [3, 4], [4, 3]])
+        for r in res[1:]:
+            self.env.assertEquals(r[1], 1.0)
+
+        # k larger than the number of indexed nodes
+        res = self.knn(1000, [0, 0])
+        self.env.assertEquals(len(res), 100)
+        distances = [r[1] for r in res]
+        self.env.assertEquals(distances, sorted(distances))
+
+        # k = 0
+        self.env.assertEquals(self.knn(0, [0, 0]), [])
+
+        # k exceeding the maximum number of results
+        for k in [2**32, 2**63 - 1]:
+            try:
+                self.knn(k, [0, 0])
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertContains("k must be an integer between 0 and 4294967295", str(e))
+
+        # k at the maximum is bounded by the index size
+        self.env.assertEquals(len(self.knn(2**32 - 1, [0, 0])), 100)
+
+    def test04_index_updates(self):
+        # move a node far away
+        self.graph.query("MATCH (p:P {x: 3, y: 3}) SET p.v = [100, 100]")
+        res = self.knn(1, [3, 3])
+        self.env.assertNotEqual(res[0][0], [3, 3])
+        self.env.assertEquals(self.knn(1, [99, 99])[0][0], [100, 100])
+
+        # non vector values aren't indexed
+        self.graph.query("MATCH (p:P {x: 3, y: 3}) SET p.v = 'not a vector'")
+        self.env.assertNotEqual(self.knn(1, [99, 99])[0][0], [100, 100])
+
+        # new nodes are indexed
+        self.graph.query("CREATE (:P {v: [50, 50]})")
+        self.env.assertEquals(self.knn(1, [49, 49])[0][0], [50, 50])
+
+        # deleted nodes are removed from the index
+        self.graph.query("MATCH (p:P) WHERE p.v = [50, 50] DELETE p")
+        self.env.assertNotEqual(self.knn(1, [49, 49])[0][0], [50, 50])
+
+        # restore
+        self.graph.query("MATCH (p:P {x: 3, y: 3}) SET p.v = [3, 3]")
+        self.env.assertEquals(self.knn(1, [3, 3])[0], [[3, 3], 0.0])
+
+    def test05_persistency(self):
+        before = self.knn(10, [7, 2])
+        self.redis_con.execute_command("DEBUG", "RELOAD")
+        wait_for_indices_to_sync(self.graph)
+
+        res = self.graph.query("CALL db.indexes() YIELD type, info WHERE type = 'vector' RETURN info")
+        self.env.assertEquals(res.result_set[0][0]['numDocuments'], 100)
+        self.env.assertEquals(self.knn(10, [7, 2]), before)
+
+    def test06_cosine(self):
+        self.graph.query("UNWIND range(1, 8) AS i CREATE (:C {v: [i, 8 - i]})")
+        res = create_vector_index(self.graph, 'C', 'v', 2, similarity='cosine', sync=True)
+        self.env.assertEquals(res.indices_created, 1)
+
+        # magnitude doesn't affect cosine distance
+        q = """CALL db.idx.vector.query('C', 'v', 1, [0.1, 0.7])
+               YIELD node RETURN node.v"""
+        res = self.graph.query(q).result_set
+        self.env.assertEquals(res[0][0], [1, 7])
+
+    def test07_drop_index(self):
+        drop_vector_index(self.graph, 'P')
+        res = self.graph.query("CALL db.indexes() YIELD type, label WHERE type = 'vector' AND label = 'P' RETURN count(1)")
+        self.env.assertEquals(res.result_set[0][0], 0)
+
+        try:
+            drop_vector_index(self.graph, 'P')
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("no such index", str(e))
+
+        # index can be recreated with a different configuration
+        res = create_vector_index(self.graph, 'P', 'v', 2, similarity='ip', sync=True)
+        self.env.assertEquals(res.indices_created, 1)
+
+    def test08_persisted_contents(self):
+        # spread the graph and its indices over multiple virtual keys
+        self.redis_con.execute_command("GRAPH.CONFIG", "SET", "VKEY_MAX_ENTITY_COUNT", 10)
+
+        # churn the index, removed elements remain as routing points
+        self.graph.query("MATCH (p:P) WHERE p.x % 3 = 0 SET p.v = [p.y, p.x]")
+        self.graph.query("MATCH (p:P) WHERE p.y = 5 SET p.v = NULL")
+
+        queries = [[x / 2, y / 3] for x in range(0, 20, 3) for y in range(0, 30, 4)]
+        before_p = [self.knn(7, q) for q in queries]
+        before_c = self.graph.query("""CALL db.idx.vector.query('C', 'v', 3, [0.5, 0.5])
+                                       YIELD node RETURN node.v""").result_set
+
+        # the index graph is restored as is rather than rebuilt
+        # as such approximate results are identical
+        self.redis_con.execute_command("DEBUG", "RELOAD")
+
+        self.env.assertEquals([self.knn(7, q) for q in queries], before_p)
+        res = self.graph.query("""CALL db.idx.vector.query('C', 'v', 3, [0.5, 0.5])
+                                  YIELD node RETURN node.v""").result_set
+        self.env.assertEquals(res, before_c)
+
+        res = self.graph.query("CALL db.indexes() YIELD type, label, info WHERE type = 'vector' AND label = 'P' RETURN info")
+        self.env.assertEquals(res.result_set[0][0]['numDocuments'], 90)
+
+        # restored index remains updatable
+        self.graph.query("CREATE (:P {v: [-50, -50]})")
+        self.env.assertEquals(self.knn(1, [-49, -49])[0][0], [-50, -50])
+
+        self.redis_con.execute_command("GRAPH.CONFIG", "SET", "VKEY_MAX_ENTITY_COUNT", 100000)
@@ -0,0 +1,143 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/index/ordered/btree.h"
+
+#include <stdlib.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define N 100000
+
+// key of entry id, many entries share a key
+static double _key(uint64_t id) {
+	return (double)((id * 7919) % 1001) - 500;
+}
+
+static int _entry_cmp(const void *a, const void *b) {
+	const BTreeEntry *x = a;
+	const BTreeEntry *y = b;
+	if(x->key != y->key) return x->key < y->key ? -1 : 1;
+	if(x->id  != y->id)  return x->id  < y->id  ? -1 : 1;
+	return 0;
+}
+
+// validate tree content against the entries marked as present
+static void _validate(const BTree *t, const bool *present) {
+	uint64_t n = 0;
+	BTreeEntry *expected = malloc(sizeof(BTreeEntry) * N);
+	for(uint64_t i = 0; i < N; i++) {
+		if(!present[i]) continue;
+		expected[n].key = _key(i);
+		expected[n].id  = i;
+		n++;
+	}
+	qsort(expected, n, sizeof(BTreeEntry), _entry_cmp);
+
+	TEST_ASSERT(BTree_Size(t) == n);
+
+	BTreeEntry batch[37];
+	for(int reverse = 0; reverse < 2; reverse++) {
+		BTreeIterator it;
+		BTree_IteratorInit(&it, t, reverse);
+
+		uint32_t count;
+		uint64_t produced = 0;
+		uint32_t batch_size = 1 + rand() % 37;
+		while((count = BTree_IteratorNext(&it, batch, batch_size)) > 0) {
+			for(uint32_t i = 0; i < count; i++) {
+				uint64_t j = reverse ? n - 1 - produced : produced;
+				TEST_ASSERT(produced < n);
+				TEST_ASSERT(batch[i].id  == expected[j].id);
+				TEST_ASSERT(batch[i].key == expected[j].key);
+				produced++;
+			}
+		}
+		TEST_ASSERT(produced == n);
+	}
+
+	free(expected);
+}
+
+void test_insertRemove() {
+	srand(1);
+	BTree *t = BTree_New();
+	bool *present = calloc(N, sizeof(bool));
+
+	for(int round = 0; round < 8; round++) {
+		// alternate between growing and shrinking rounds
+		int insert_ratio = (round % 2 == 0) ? 3 : 1;
+		for(int i = 0; i < N; i++) {
+			uint64_t id = rand() % N;
+			if(rand() % 4 < insert_ratio) {
+				TEST_ASSERT(BTree_Insert(t, _key(id), id) == !present[id]);
+				present[id] = true;
+			} else {
+				TEST_ASSERT(BTree_Remove(t, _key(id), id) == present[id]);
+				present[id] = false;
+			}
+		}
+		_validate(t, present);
+	}
+
+	// remove everything
+	for(uint64_t i = 0; i < N; i++) {
+		if(present[i]) TEST_ASSERT(BTree_Remove(t, _key(i), i));
+		present[i] = false;
+	}
+	_validate(t, present);
+
+	// tree is usable after being emptied
+	TEST_ASSERT(BTree_Insert(t, _key(1), 1));
+	present[1] = true;
+	_validate(t, present);
+
+	free(present);
+	BTree_Free(t);
+}
+
+void test_modifyWhileScanning() {
+	BTree *t = BTree_New();
+	for(uint64_t i = 0; i < 1000; i++) BTree_Insert(t, i, i);
+
+	BTreeIterator it;
+	BTreeEntry batch[10];
+	BTree_IteratorInit(&it, t, false);
+	TEST_ASSERT(BTree_IteratorNext(&it, batch, 10) == 10);
+	TEST_ASSERT(batch[9].id == 9);
+
+	// remove upcoming entries and entries already produced
+	for(uint64_t i = 0; i < 20; i++) BTree_Remove(t, i, i);
+	BTree_Insert(t, 5, 5);
+
+	// scan resumes after the last produced entry
+	TEST_ASSERT(BTree_IteratorNext(&it, batch, 10) == 10);
+	TEST_ASSERT(batch[0].id == 20);
+
+	// reverse scan
+	BTree_IteratorInit(&it, t, true);
+	TEST_ASSERT(BTree_IteratorNext(&it, batch, 3) == 3);
+	TEST_ASSERT(batch[0].id == 999);
+	TEST_ASSERT(batch[2].id == 997);
+	BTree_Remove(t, 996, 996);
+	TEST_ASSERT(BTree_IteratorNext(&it, batch, 1) == 1);
+	TEST_ASSERT(batch[0].id == 995);
+
+	BTree_Free(t);
+}
+
+TEST_LIST = {
+	{ "insertRemove", test_insertRemove},
+	{ "modifyWhileScanning", test_modifyWhileScanning},
+	{ NULL, NULL }
+};
+
@@ -117,6 +117,34 @@ void test_CircularBuffer_Circularity(void) {
 	CircularBuffer_Free(buff);
 }
 
+void test_CircularBuffer_Peek(void) {
+	int n;
+	int cap = 4;
+	CircularBuffer buff = CircularBuffer_New(sizeof(int), cap);
+
+	// peek into an empty buffer
+	TEST_ASSERT(CircularBuffer_Peek(buff) == NULL);
+
+	// cycle through the buffer, peek should always return the oldest item
+	for(int i = 0; i < cap * 3; i++) {
+		TEST_ASSERT(CircularBuffer_Add(buff, &i) == 1);
+		if(i == 0) continue;
+
+		int *oldest = CircularBuffer_Peek(buff);
+		TEST_ASSERT(oldest != NULL);
+		TEST_ASSERT(*oldest == i - 1);
+
+		// peek doesn't remove items
+		TEST_ASSERT(CircularBuffer_ItemCount(buff) == 2);
+
+		TEST_ASSERT(CircularBuffer_Read(buff, &n) != NULL);
+		TEST_ASSERT(n == i - 1);
+	}
+
+	// clean up
+	CircularBuffer_Free(buff);
+}
+
 void test_CircularBuffer_free(void) {
 	//--------------------------------------------------------------------------
 	// fill a buffer of size 16 with int *
@@ -190,6 +218,7 @@ TEST_LIST = {
 	{"CircularBuffer_Init", test_CircularBufferInit},
 	{"CircularBuffer_Population", test_CircularBufferPopulation},
 	{"CircularBuffer_Circularity", test_CircularBuffer_Circularity},
+	{"CircularBuffer_Peek", test_CircularBuffer_Peek},
 	{"CircularBuffer_Free", test_CircularBuffer_free},
 	{"CircularBuffer_Reserve", test_CircularBuffer_Reserve},
 	{NULL, NULL}
@@ -0,0 +1,140 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/strsimd.h"
+#include "src/util/csv_reader.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CSV_PATH "/tmp/test_csv_reader.csv"
+
+void setup() {
+	Alloc_Reset();
+	str_simd_init();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+static CSVReader *_open(const char *content, char delimiter) {
+	FILE *f = fopen(CSV_PATH, "w");
+	TEST_ASSERT(f != NULL);
+	fwrite(content, 1, strlen(content), f);
+	fclose(f);
+
+	CSVReader *reader = CSVReader_New(CSV_PATH, delimiter);
+	TEST_ASSERT(reader != NULL);
+	return reader;
+}
+
+// validate next row holds the expected fields
+static void _expect_row(CSVReader *reader, const char **expected, uint n) {
+	uint nfields;
+	char buf[256];
+	const CSVField *fields;
+
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_ROW);
+	TEST_ASSERT(nfields == n);
+
+	for(uint i = 0; i < n; i++) {
+		size_t len = CSVField_Copy(fields + i, buf);
+		TEST_ASSERT(len == strlen(expected[i]));
+		TEST_CHECK_(strcmp(buf, expected[i]) == 0, "%s != %s", buf, expected[i]);
+	}
+}
+
+void test_unquoted() {
+	CSVReader *reader = _open("a,b,c\n1,,3\r\n\nlast,row,without newline", ',');
+
+	const char *row0[] = {"a", "b", "c"};
+	const char *row1[] = {"1", "", "3"};
+	const char *row2[] = {"last", "row", "without newline"};
+
+	_expect_row(reader, row0, 3);
+	_expect_row(reader, row1, 3);
+	// blank line is skipped
+	_expect_row(reader, row2, 3);
+
+	uint nfields;
+	const CSVField *fields;
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_EOF);
+
+	CSVReader_Free(&reader);
+	TEST_ASSERT(reader == NULL);
+}
+
+void test_quoted() {
+	CSVReader *reader = _open("\"a,b\",\"say \"\"hi\"\"\"\r\n"
+			"\"multi\nline\",\"\"\n", ',');
+
+	uint nfields;
+	const CSVField *fields;
+	const char *row0[] = {"a,b", "say \"hi\""};
+	const char *row1[] = {"multi\nline", ""};
+
+	_expect_row(reader, row0, 2);
+	_expect_row(reader, row1, 2);
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_EOF);
+
+	CSVReader_Free(&reader);
+}
+
+void test_delimiter() {
+	// long row, exercising the vectorized field scan
+	CSVReader *reader = _open("a field long enough to span a vector;b;\n", ';');
+
+	const char *row0[] = {"a field long enough to span a vector", "b", ""};
+	_expect_row(reader, row0, 3);
+
+	CSVReader_Free(&reader);
+}
+
+void test_malformed() {
+	uint nfields;
+	const CSVField *fields;
+
+	// missing closing quote
+	CSVReader *reader = _open("a,\"b\n", ',');
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_ERROR);
+	CSVReader_Free(&reader);
+
+	// data following closing quote
+	reader = _open("\"a\"b,c\n", ',');
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_ERROR);
+	CSVReader_Free(&reader);
+
+	// missing file
+	unlink(CSV_PATH);
+	TEST_ASSERT(CSVReader_New(CSV_PATH, ',') == NULL);
+}
+
+void test_empty() {
+	uint nfields;
+	const CSVField *fields;
+
+	CSVReader *reader = _open("", ',');
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_EOF);
+	CSVReader_Free(&reader);
+
+	// byte order mark only
+	reader = _open("\xEF\xBB\xBF", ',');
+	TEST_ASSERT(CSVReader_NextRow(reader, &fields, &nfields) == CSV_EOF);
+	CSVReader_Free(&reader);
+
+	unlink(CSV_PATH);
+}
+
+TEST_LIST = {
+	{ "unquoted", test_unquoted},
+	{ "quoted", test_quoted},
+	{ "delimiter", test_delimiter},
+	{ "malformed", test_malformed},
+	{ "empty", test_empty},
+	{ NULL, NULL }
+};
@@ -463,11 +463,226 @@ void test_getEdge() {
 	Graph_Free(g);
 }
 
+void test_bulkCreation() {
+	// create nodes and edges in batches both smaller and larger than
+	// the bulk build threshold, validate matrices and statistics
+
+	GrB_Index nvals;
+	uint64_t small = 4;
+	uint64_t large = GRAPH_BULK_BUILD_THRESHOLD;
+	uint64_t node_count = small + large;
+
+	Graph *g = Graph_New(node_count, node_count);
+	Graph_AcquireWriteLock(g);
+
+	LabelID l = Graph_AddLabel(g);
+	RelationID r = Graph_AddRelationType(g);
+
+	Graph_CreateNodes(g, &l, 1, NULL, small);
+	Graph_CreateNodes(g, &l, 1, NULL, large);
+
+	TEST_ASSERT(Graph_NodeCount(g) == node_count);
+	TEST_ASSERT(GraphStatistics_NodeCount(&g->stats, l) == node_count);
+
+	RG_Matrix L = Graph_GetLabelMatrix(g, l);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, L) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == node_count);
+
+	RG_Matrix nl = Graph_GetNodeLabelMatrix(g);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, nl) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == node_count);
+
+	// connect node i to node i + 1, the large batch connects node 0 to
+	// node 1 once more, forming a multi-edge
+	NodeID *src  = rm_malloc(sizeof(NodeID) * large);
+	NodeID *dest = rm_malloc(sizeof(NodeID) * large);
+	EdgeID *ids  = rm_malloc(sizeof(EdgeID) * large);
+
+	for(uint64_t i = 0; i < large; i++) {
+		src[i]  = i % (node_count - 1);
+		dest[i] = src[i] + 1;
+	}
+
+	Graph_CreateEdges(g, r, src, dest, NULL, ids, small);
+	for(uint64_t i = 0; i < small; i++) TEST_ASSERT(ids[i] == i);
+
+	Graph_CreateEdges(g, r, src, dest, NULL, ids, large);
+	for(uint64_t i = 0; i < large; i++) TEST_ASSERT(ids[i] == small + i);
+
+	TEST_ASSERT(Graph_EdgeCount(g) == small + large);
+	TEST_ASSERT(GraphStatistics_EdgeCount(&g->stats, r) == small + large);
+
+	// edges created by both batches are reachable
+	Edge *edges = array_new(Edge, 2);
+	Graph_GetEdgesConnectingNodes(g, 0, 1, r, &edges);
+	TEST_ASSERT(array_len(edges) == 2);
+	TEST_ASSERT(edges[0].id == 0 || edges[1].id == 0);
+	TEST_ASSERT(edges[0].id == small || edges[1].id == small);
+	array_free(edges);
+
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, adj) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == large);
+
+	rm_free(src);
+	rm_free(dest);
+	rm_free(ids);
+
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+}
+
+void test_bulkDeletion() {
+	// delete a batch of edges larger than the bulk build threshold
+	// hub node 0 is connected to every other node by relationship r0
+	// in addition node 0 is connected to node 1 by a second r0 edge
+	// and to node 2 by an r1 edge
+
+	GrB_Index nvals;
+	uint64_t large = GRAPH_BULK_BUILD_THRESHOLD;
+	uint64_t node_count = large + 1;
+
+	Graph *g = Graph_New(node_count, node_count);
+	Graph_AcquireWriteLock(g);
+
+	RelationID r0 = Graph_AddRelationType(g);
+	RelationID r1 = Graph_AddRelationType(g);
+
+	Graph_CreateNodes(g, NULL, 0, NULL, node_count);
+
+	NodeID *src  = rm_malloc(sizeof(NodeID) * large);
+	NodeID *dest = rm_malloc(sizeof(NodeID) * large);
+
+	for(uint64_t i = 0; i < large; i++) {
+		src[i]  = 0;
+		dest[i] = i + 1;
+	}
+
+	Edge edge;
+	Graph_CreateEdges(g, r0, src, dest, NULL, NULL, large);
+	Graph_CreateEdge(g, 0, 1, r0, &edge);
+	EdgeID kept = ENTITY_GET_ID(&edge);
+	Graph_CreateEdge(g, 0, 2, r1, &edge);
+
+	TEST_ASSERT(Graph_EdgeCount(g) == large + 2);
+
+	// delete all r0 edges but one of the two edges connecting 0 to 1
+	Node hub;
+	Edge *edges = array_new(Edge, large + 1);
+	Graph_GetNode(g, 0, &hub);
+	Graph_GetNodeEdges(g, &hub, GRAPH_EDGE_DIR_OUTGOING, r0, &edges);
+	TEST_ASSERT(array_len(edges) == large + 1);
+
+	for(uint i = 0; i < array_len(edges); i++) {
+		if(ENTITY_GET_ID(edges + i) == kept) {
+			array_del_fast(edges, i);
+			break;
+		}
+	}
+	TEST_ASSERT(array_len(edges) == large);
+
+	Graph_DeleteEdges(g, edges, large);
+	array_free(edges);
+
+	TEST_ASSERT(Graph_EdgeCount(g) == 2);
+	TEST_ASSERT(GraphStatistics_EdgeCount(&g->stats, r0) == 1);
+	TEST_ASSERT(GraphStatistics_EdgeCount(&g->stats, r1) == 1);
+
+	// multi-edge reverted back to the remaining single edge
+	uint64_t x;
+	RG_Matrix R = Graph_GetRelationMatrix(g, r0, false);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, R) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == 1);
+	TEST_ASSERT(RG_Matrix_extractElement_UINT64(&x, R, 0, 1) == GrB_SUCCESS);
+	TEST_ASSERT(x == kept);
+
+	R = Graph_GetRelationMatrix(g, r0, true);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, R) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == 1);
+
+	// node 0 remains connected to nodes 1 and 2
+	RG_Matrix adj = Graph_GetAdjacencyMatrix(g, false);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, adj) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == 2);
+
+	adj = Graph_GetAdjacencyMatrix(g, true);
+	TEST_ASSERT(RG_Matrix_nvals(&nvals, adj) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == 2);
+
+	rm_free(src);
+	rm_free(dest);
+
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+}
+
+void test_bulkNodesEdges() {
+	// collect the edges of a batch of nodes larger than the bulk threshold
+	// every node i > 0 is connected to hub node 0 by relationship r0
+	// in addition hub node 0 is connected to node 1 by relationship r1
+	// and node 2 has an r1 self loop
+
+	uint64_t large = GRAPH_BULK_BUILD_THRESHOLD;
+	uint64_t node_count = large + 1;
+
+	Graph *g = Graph_New(node_count, node_count);
+	Graph_AcquireWriteLock(g);
+
+	RelationID r0 = Graph_AddRelationType(g);
+	RelationID r1 = Graph_AddRelationType(g);
+
+	Graph_CreateNodes(g, NULL, 0, NULL, node_count);
+
+	NodeID *src  = rm_malloc(sizeof(NodeID) * large);
+	NodeID *dest = rm_malloc(sizeof(NodeID) * large);
+
+	for(uint64_t i = 0; i < large; i++) {
+		src[i]  = i + 1;
+		dest[i] = 0;
+	}
+
+	Edge edge;
+	Graph_CreateEdges(g, r0, src, dest, NULL, NULL, large);
+	Graph_CreateEdge(g, 0, 1, r1, &edge);
+	Graph_CreateEdge(g, 2, 2, r1, &edge);
+	EdgeID self_loop = ENTITY_GET_ID(&edge);
+
+	// collect edges of all nodes but the hub
+	Node *nodes = rm_malloc(sizeof(Node) * large);
+	for(uint64_t i = 0; i < large; i++) {
+		Graph_GetNode(g, i + 1, nodes + i);
+	}
+
+	Edge *edges = array_new(Edge, large);
+	Graph_GetNodesEdges(g, nodes, large, &edges);
+
+	// the self loop is reported both as outgoing and incoming
+	uint64_t self_loops = 0;
+	uint64_t edge_count = array_len(edges);
+	for(uint64_t i = 0; i < edge_count; i++) {
+		if(ENTITY_GET_ID(edges + i) == self_loop) self_loops++;
+	}
+
+	TEST_ASSERT(self_loops == 2);
+	TEST_ASSERT(edge_count == large + 3);
+
+	array_free(edges);
+	rm_free(nodes);
+	rm_free(src);
+	rm_free(dest);
+
+	Graph_ReleaseLock(g);
+	Graph_Free(g);
+}
+
 TEST_LIST = {
 	{"newGraph", test_newGraph},
 	{"graphConstruction", test_graphConstruction},
 	{"removeNodes", test_removeNodes},
 	{"getNode", test_getNode},
+	{"bulkCreation", test_bulkCreation},
+	{"bulkDeletion", test_bulkDeletion},
+	{"bulkNodesEdges", test_bulkNodesEdges},
 	{"getEdge", test_getEdge},
 	{NULL, NULL}
 };
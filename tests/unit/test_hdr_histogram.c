@@ -0,0 +1,106 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/hdr_histogram.h"
+
+#include <string.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+static HdrHistogram *_new_histogram(void) {
+	HdrHistogram *h = rm_malloc(sizeof(HdrHistogram));
+	memset(h, 0, sizeof(HdrHistogram));
+	return h;
+}
+
+void test_HdrHistogramEmpty(void) {
+	HdrHistogram *h = _new_histogram();
+
+	TEST_ASSERT(h->count == 0);
+	TEST_ASSERT(HdrHistogram_Percentile(h, 0.5) == 0);
+	TEST_ASSERT(HdrHistogram_Percentile(h, 1) == 0);
+
+	rm_free(h);
+}
+
+void test_HdrHistogramExactValues(void) {
+	HdrHistogram *h = _new_histogram();
+
+	// values smaller than HDR_SUB_BUCKET_COUNT are recorded exactly
+	for(uint64_t v = 1; v <= 20; v++) HdrHistogram_Record(h, v);
+
+	TEST_ASSERT(h->count == 20);
+	TEST_ASSERT(h->sum == 210);
+	TEST_ASSERT(h->max == 20);
+	TEST_ASSERT(HdrHistogram_Percentile(h, 0.5) == 10);
+	TEST_ASSERT(HdrHistogram_Percentile(h, 0.95) == 19);
+	TEST_ASSERT(HdrHistogram_Percentile(h, 1) == 20);
+
+	rm_free(h);
+}
+
+void test_HdrHistogramRelativeError(void) {
+	HdrHistogram *h = _new_histogram();
+
+	uint64_t values[] = {31, 32, 33, 100, 1000, 12345, 999999, 1ULL << 35};
+	for(int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		uint64_t v = values[i];
+
+		HdrHistogram_Reset(h);
+		HdrHistogram_Record(h, v);
+		HdrHistogram_Record(h, v * 2);
+
+		// the reported value is within the recorded value's bucket
+		uint64_t p = HdrHistogram_Percentile(h, 0.5);
+		TEST_ASSERT(p >= v);
+		TEST_ASSERT(p - v <= v / HDR_SUB_BUCKET_HALF);
+	}
+
+	// values beyond range are capped
+	HdrHistogram_Reset(h);
+	HdrHistogram_Record(h, UINT64_MAX);
+	TEST_ASSERT(h->max == HDR_MAX_VALUE);
+	TEST_ASSERT(HdrHistogram_Percentile(h, 1) == HDR_MAX_VALUE);
+
+	rm_free(h);
+}
+
+void test_HdrHistogramMerge(void) {
+	HdrHistogram *a   = _new_histogram();
+	HdrHistogram *b   = _new_histogram();
+	HdrHistogram *sum = _new_histogram();
+
+	for(uint64_t v = 0; v < 1000; v++) HdrHistogram_Record(a, v);
+	for(uint64_t v = 0; v < 10; v++)   HdrHistogram_Record(b, 100000);
+
+	HdrHistogram_Merge(sum, a);
+	HdrHistogram_Merge(sum, b);
+
+	TEST_ASSERT(sum->count == 1010);
+	TEST_ASSERT(sum->max == 100000);
+
+	// the slowest 1% of values come from b
+	TEST_ASSERT(HdrHistogram_Percentile(sum, 0.5) < 1000);
+	TEST_ASSERT(HdrHistogram_Percentile(sum, 0.999) == 100000);
+
+	rm_free(a);
+	rm_free(b);
+	rm_free(sum);
+}
+
+TEST_LIST = {
+	{"HdrHistogram_Empty", test_HdrHistogramEmpty},
+	{"HdrHistogram_ExactValues", test_HdrHistogramExactValues},
+	{"HdrHistogram_RelativeError", test_HdrHistogramRelativeError},
+	{"HdrHistogram_Merge", test_HdrHistogramMerge},
+	{NULL, NULL}
+};
@@ -0,0 +1,250 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/index/vector/hnsw.h"
+#include "src/index/vector/vector_distance.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+void setup() {
+	Alloc_Reset();
+	vec_distance_init();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define DIM   24
+#define COUNT 1000
+#define K     10
+
+static float vectors[COUNT][DIM];
+
+static void _populate(void) {
+	srand(1);
+	for(int i = 0; i < COUNT; i++) {
+		for(int j = 0; j < DIM; j++) {
+			vectors[i][j] = (float)rand() / RAND_MAX - 0.5f;
+		}
+	}
+}
+
+// brute force k nearest neighbors by squared euclidean distance
+static void _knn
+(
+	const float *q,
+	uint64_t *ids
+) {
+	float dists[K];
+	int n = 0;
+
+	for(int i = 0; i < COUNT; i++) {
+		float d = 0;
+		for(int j = 0; j < DIM; j++) {
+			float diff = q[j] - vectors[i][j];
+			d += diff * diff;
+		}
+
+		// insertion into sorted top-k
+		int pos = n < K ? n : K;
+		while(pos > 0 && dists[pos - 1] > d) {
+			if(pos < K) {
+				dists[pos] = dists[pos - 1];
+				ids[pos]   = ids[pos - 1];
+			}
+			pos--;
+		}
+		if(pos < K) {
+			dists[pos] = d;
+			ids[pos]   = i;
+			if(n < K) n++;
+		}
+	}
+}
+
+void test_distanceKernels() {
+	float a[37];
+	float b[37];
+	for(int i = 0; i < 37; i++) {
+		a[i] = i * 0.5f;
+		b[i] = 10 - i * 0.25f;
+	}
+
+	// exercise vectorized loops and their tails
+	for(size_t dim = 0; dim <= 37; dim++) {
+		float l2  = 0;
+		float dot = 0;
+		for(size_t i = 0; i < dim; i++) {
+			l2  += (a[i] - b[i]) * (a[i] - b[i]);
+			dot += a[i] * b[i];
+		}
+		TEST_ASSERT(fabsf(vec_l2sq(a, b, dim) - l2) <= 1e-3f * (1 + l2));
+		TEST_ASSERT(fabsf(vec_dot(a, b, dim) - dot) <= 1e-3f * (1 + fabsf(dot)));
+	}
+
+	vec_normalize(a, 37);
+	TEST_ASSERT(fabsf(vec_dot(a, a, 37) - 1) < 1e-4f);
+}
+
+void test_searchRecall() {
+	_populate();
+
+	HNSW *h = HNSW_New(DIM, VEC_SIM_EUCLIDEAN, 16, 200);
+	for(int i = 0; i < COUNT; i++) HNSW_Insert(h, i, vectors[i]);
+	TEST_ASSERT(HNSW_Size(h) == COUNT);
+
+	int hits = 0;
+	uint64_t ids[K];
+	uint64_t expected[K];
+	float dists[K];
+
+	for(int i = 0; i < 50; i++) {
+		const float *q = vectors[(i * 37) % COUNT];
+		uint32_t n = HNSW_Search(h, q, K, 64, ids, dists);
+		TEST_ASSERT(n == K);
+
+		// results are sorted by ascending distance
+		for(uint32_t j = 1; j < n; j++) TEST_ASSERT(dists[j - 1] <= dists[j]);
+
+		// query vector is part of the graph
+		TEST_ASSERT(ids[0] == (uint64_t)(i * 37) % COUNT);
+		TEST_ASSERT(dists[0] == 0);
+
+		_knn(q, expected);
+		for(int a = 0; a < K; a++) {
+			for(int b = 0; b < K; b++) {
+				if(ids[a] == expected[b]) {
+					hits++;
+					break;
+				}
+			}
+		}
+	}
+
+	// approximate search, expect high recall
+	TEST_ASSERT(hits >= 50 * K * 0.9);
+
+	HNSW_Free(h);
+}
+
+void test_updateAndRemove() {
+	_populate();
+
+	HNSW *h = HNSW_New(DIM, VEC_SIM_EUCLIDEAN, 8, 100);
+	for(int i = 0; i < COUNT; i++) HNSW_Insert(h, i, vectors[i]);
+
+	uint64_t ids[K];
+	float dists[K];
+
+	// remove every other element
+	for(int i = 0; i < COUNT; i += 2) TEST_ASSERT(HNSW_Remove(h, i));
+	TEST_ASSERT(!HNSW_Remove(h, 0));
+	TEST_ASSERT(HNSW_Size(h) == COUNT / 2);
+
+	// removed elements are never returned
+	for(int i = 0; i < COUNT; i += 50) {
+		uint32_t n = HNSW_Search(h, vectors[i], K, 32, ids, dists);
+		TEST_ASSERT(n == K);
+		for(uint32_t j = 0; j < n; j++) TEST_ASSERT(ids[j] % 2 == 1);
+	}
+
+	// move element 1 onto element 4's (removed) position
+	HNSW_Insert(h, 1, vectors[4]);
+	TEST_ASSERT(HNSW_Size(h) == COUNT / 2);
+	HNSW_Search(h, vectors[4], 1, 32, ids, dists);
+	TEST_ASSERT(ids[0] == 1);
+	TEST_ASSERT(dists[0] == 0);
+
+	// empty graph
+	for(int i = 1; i < COUNT; i += 2) TEST_ASSERT(HNSW_Remove(h, i));
+	TEST_ASSERT(HNSW_Size(h) == 0);
+	TEST_ASSERT(HNSW_Search(h, vectors[0], K, 32, ids, dists) == 0);
+
+	// graph is usable after being emptied
+	HNSW_Insert(h, 7, vectors[7]);
+	TEST_ASSERT(HNSW_Search(h, vectors[0], K, 32, ids, dists) == 1);
+	TEST_ASSERT(ids[0] == 7);
+
+	HNSW_Free(h);
+}
+
+void test_cosine() {
+	HNSW *h = HNSW_New(2, VEC_SIM_COSINE, 4, 16);
+
+	float v0[2] = {1, 0};
+	float v1[2] = {0, 5};
+	float v2[2] = {3, 3};
+	HNSW_Insert(h, 0, v0);
+	HNSW_Insert(h, 1, v1);
+	HNSW_Insert(h, 2, v2);
+
+	// magnitude is irrelevant for cosine similarity
+	uint64_t ids[3];
+	float dists[3];
+	float q[2] = {0, 0.1f};
+	TEST_ASSERT(HNSW_Search(h, q, 3, 10, ids, dists) == 3);
+	TEST_ASSERT(ids[0] == 1);
+	TEST_ASSERT(ids[1] == 2);
+	TEST_ASSERT(ids[2] == 0);
+	TEST_ASSERT(fabsf(dists[0]) < 1e-5f);
+	TEST_ASSERT(fabsf(dists[2] - 1) < 1e-5f);
+
+	HNSW_Free(h);
+}
+
+void test_serialize() {
+	_populate();
+
+	HNSW *h = HNSW_New(DIM, VEC_SIM_EUCLIDEAN, 8, 64);
+	for(int i = 0; i < COUNT; i++) HNSW_Insert(h, i, vectors[i]);
+	for(int i = 0; i < COUNT; i += 3) HNSW_Remove(h, i);
+
+	size_t size;
+	unsigned char *buffer = HNSW_Serialize(h, &size);
+	HNSW *restored = HNSW_Deserialize(buffer, size);
+	TEST_ASSERT(restored != NULL);
+	TEST_ASSERT(HNSW_Size(restored) == HNSW_Size(h));
+
+	// restored graph answers queries exactly as the original one
+	uint64_t ids[K];
+	uint64_t restored_ids[K];
+	float dists[K];
+	for(int i = 0; i < COUNT; i += 50) {
+		uint32_t n = HNSW_Search(h, vectors[i], K, 32, ids, dists);
+		TEST_ASSERT(HNSW_Search(restored, vectors[i], K, 32, restored_ids,
+					dists) == n);
+		TEST_ASSERT(memcmp(ids, restored_ids, sizeof(uint64_t) * n) == 0);
+	}
+
+	// restored graph remains updatable
+	HNSW_Insert(restored, 0, vectors[0]);
+	HNSW_Search(restored, vectors[0], 1, 32, ids, dists);
+	TEST_ASSERT(ids[0] == 0);
+
+	// corrupted buffer fails its checksum
+	buffer[size / 2] ^= 0xFF;
+	TEST_ASSERT(HNSW_Deserialize(buffer, size) == NULL);
+
+	// truncated buffer
+	TEST_ASSERT(HNSW_Deserialize(buffer, 4) == NULL);
+
+	rm_free(buffer);
+	HNSW_Free(h);
+	HNSW_Free(restored);
+}
+
+TEST_LIST = {
+	{ "distanceKernels", test_distanceKernels},
+	{ "searchRecall", test_searchRecall},
+	{ "updateAndRemove", test_updateAndRemove},
+	{ "cosine", test_cosine},
+	{ "serialize", test_serialize},
+	{ NULL, NULL }
+};
+
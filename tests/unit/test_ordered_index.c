@@ -0,0 +1,92 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/util/rmalloc.h"
+#include "src/index/ordered/ordered_index.h"
+
+#include <string.h>
+
+void setup() {
+	Alloc_Reset();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define N 10000
+
+// collect tree entries in order
+static uint64_t _entries(const OrderedIndex *oi, BTreeEntry *entries) {
+	uint32_t count;
+	uint64_t n = 0;
+	BTreeIterator it;
+	BTree_IteratorInit(&it, OrderedIndex_Tree(oi), false);
+	while((count = BTree_IteratorNext(&it, entries + n, 64)) > 0) n += count;
+	return n;
+}
+
+void test_serialize() {
+	OrderedIndex *oi = OrderedIndex_New(3);
+	for(uint64_t i = 0; i < N; i++) {
+		if(i % 10 == 0) {
+			// values the tree can't order
+			OrderedIndex_Set(oi, i, SI_ConstStringVal("str"));
+		} else if(i % 2 == 0) {
+			OrderedIndex_Set(oi, i, SI_LongVal(i % 97));
+		} else {
+			OrderedIndex_Set(oi, i, SI_DoubleVal((double)i / 3));
+		}
+	}
+	for(uint64_t i = 0; i < N; i += 7) OrderedIndex_Remove(oi, i);
+
+	size_t size;
+	unsigned char *buffer = OrderedIndex_Serialize(oi, &size);
+	OrderedIndex *restored = OrderedIndex_Deserialize(buffer, size);
+	TEST_ASSERT(restored != NULL);
+	TEST_ASSERT(OrderedIndex_Attribute(restored) == 3);
+	TEST_ASSERT(OrderedIndex_OrderedCount(restored) ==
+			OrderedIndex_OrderedCount(oi));
+	TEST_ASSERT(OrderedIndex_UnorderedCount(restored) ==
+			OrderedIndex_UnorderedCount(oi));
+
+	// restored tree holds the exact same entries
+	BTreeEntry *expected = rm_malloc(sizeof(BTreeEntry) * N);
+	BTreeEntry *actual   = rm_malloc(sizeof(BTreeEntry) * N);
+	uint64_t n = _entries(oi, expected);
+	TEST_ASSERT(_entries(restored, actual) == n);
+	TEST_ASSERT(memcmp(expected, actual, sizeof(BTreeEntry) * n) == 0);
+
+	// restored index remains updatable
+	OrderedIndex_Set(restored, 1, SI_LongVal(-1));
+	OrderedIndex_Set(restored, 10, SI_LongVal(-2));
+	OrderedIndex_Remove(restored, 3);
+	TEST_ASSERT(OrderedIndex_UnorderedCount(restored) ==
+			OrderedIndex_UnorderedCount(oi) - 1);
+	TEST_ASSERT(OrderedIndex_OrderedCount(restored) ==
+			OrderedIndex_OrderedCount(oi));
+	TEST_ASSERT(_entries(restored, actual) == n);
+	TEST_ASSERT(actual[0].key == -2 && actual[0].id == 10);
+	TEST_ASSERT(actual[1].key == -1 && actual[1].id == 1);
+
+	// corrupted buffer fails its checksum
+	buffer[size / 2] ^= 0xFF;
+	TEST_ASSERT(OrderedIndex_Deserialize(buffer, size) == NULL);
+
+	// truncated buffer
+	TEST_ASSERT(OrderedIndex_Deserialize(buffer, 4) == NULL);
+
+	rm_free(actual);
+	rm_free(buffer);
+	rm_free(expected);
+	OrderedIndex_Free(oi);
+	OrderedIndex_Free(restored);
+}
+
+TEST_LIST = {
+	{ "serialize", test_serialize},
+	{ NULL, NULL }
+};
@@ -4,6 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
+#include "src/util/arr.h"
 #include "src/util/rmalloc.h"
 #include "src/configuration/config.h"
 #include "src/graph/rg_matrix/rg_matrix.h"
@@ -1539,6 +1540,83 @@ void test_RGMatrix_resize() {
 	RG_Matrix_free(&A);
 }
 
+// build matrix from tuples
+void test_RGMatrix_build() {
+	RG_Matrix  A      =  NULL;
+	RG_Matrix  B      =  NULL;
+	RG_Matrix  T      =  NULL;
+	GrB_Info   info   =  GrB_SUCCESS;
+	GrB_Index  nrows  =  100;
+	GrB_Index  ncols  =  100;
+	uint64_t   x      =  0;
+	bool       b      =  false;
+
+	info = RG_Matrix_new(&A, GrB_UINT64, nrows, ncols);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	T = RG_Matrix_getTranspose(A);
+
+	// pending entry, merged with built tuples
+	info = RG_Matrix_setElement_UINT64(A, 100, 1, 2);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	// (1,2) and (3,4) are multi-edge entries
+	GrB_Index I[5] = {1, 3, 5, 3, 1};
+	GrB_Index J[5] = {2, 4, 6, 4, 2};
+	uint64_t  X[5] = {0, 1, 2, 3, 4};
+
+	info = RG_Matrix_build_UINT64(A, I, J, X, 5);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	// single edge entry
+	info = RG_Matrix_extractElement_UINT64(&x, A, 5, 6);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	TEST_ASSERT(SINGLE_EDGE(x));
+	TEST_ASSERT(x == 2);
+
+	// multi-edge entry built from tuples
+	info = RG_Matrix_extractElement_UINT64(&x, A, 3, 4);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	TEST_ASSERT(!SINGLE_EDGE(x));
+	uint64_t *ids = (uint64_t *)(CLEAR_MSB(x));
+	TEST_ASSERT(array_len(ids) == 2);
+	TEST_ASSERT(ids[0] == 1 && ids[1] == 3);
+	array_free(ids);
+
+	// multi-edge entry merged with a pre-existing entry
+	info = RG_Matrix_extractElement_UINT64(&x, A, 1, 2);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	TEST_ASSERT(!SINGLE_EDGE(x));
+	ids = (uint64_t *)(CLEAR_MSB(x));
+	TEST_ASSERT(array_len(ids) == 3);
+	TEST_ASSERT(ids[0] == 100 && ids[1] == 0 && ids[2] == 4);
+	array_free(ids);
+
+	// transpose is maintained
+	GrB_Index nvals;
+	RG_Matrix_nvals(&nvals, T);
+	TEST_ASSERT(nvals == 3);
+	info = RG_Matrix_extractElement_BOOL(&b, T, 4, 3);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	info = RG_Matrix_extractElement_BOOL(&b, T, 2, 1);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	// boolean matrix, duplicates collapse
+	info = RG_Matrix_new(&B, GrB_BOOL, nrows, ncols);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	info = RG_Matrix_build_BOOL(B, I, J, 5);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	RG_Matrix_nvals(&nvals, B);
+	TEST_ASSERT(nvals == 3);
+	info = RG_Matrix_extractElement_BOOL(&b, B, 5, 6);
+	TEST_ASSERT(info == GrB_SUCCESS);
+	TEST_ASSERT(b == true);
+
+	RG_Matrix_free(&A);
+	RG_Matrix_free(&B);
+}
+
 TEST_LIST = {
 	{"RGMatrix_new", test_RGMatrix_new},
 	{"RGMatrix_simple_set", test_RGMatrix_simple_set},
@@ -1553,6 +1631,7 @@ TEST_LIST = {
 	{"RGMatrix_copy", test_RGMatrix_copy},
 	{"RGMatrix_mxm", test_RGMatrix_mxm},
 	{"RGMatrix_resize", test_RGMatrix_resize},
+	{"RGMatrix_build", test_RGMatrix_build},
 	{NULL, NULL}
 };
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/util/strsimd.h"
+
+#include <string.h>
+
+void setup() {
+	Alloc_Reset();
+	str_simd_init();
+}
+
+#define TEST_INIT setup();
+#include "acutest.h"
+
+// strings long enough to exercise both the vectorized loops and their tails
+static const char *samples[] = {
+	"",
+	"a",
+	"Hello World",
+	"The Quick Brown Fox Jumps Over The Lazy Dog, The Quick Brown Fox!",
+	"@[`{ boundaries AZaz @[`{ boundaries AZaz @[`{ boundaries AZaz",
+	"ümlaut and ASCII mixed ümlaut and ASCII mixed ümlaut and ASCII",
+	NULL
+};
+
+void test_isAscii() {
+	for(int i = 0; samples[i] != NULL; i++) {
+		const char *s = samples[i];
+		size_t len = strlen(s);
+		bool expected = true;
+		for(size_t j = 0; j < len; j++) {
+			if((unsigned char)s[j] >= 0x80) expected = false;
+		}
+		TEST_ASSERT(str_is_ascii(s, len) == expected);
+	}
+
+	// non-ASCII byte at every position
+	char buf[100];
+	memset(buf, 'x', sizeof(buf));
+	for(int i = 0; i < sizeof(buf); i++) {
+		buf[i] = (char)0xC3;
+		TEST_ASSERT(!str_is_ascii(buf, sizeof(buf)));
+		buf[i] = 'x';
+	}
+	TEST_ASSERT(str_is_ascii(buf, sizeof(buf)));
+}
+
+void test_caseConversion() {
+	char lower[128];
+	char upper[128];
+
+	for(int i = 0; samples[i] != NULL; i++) {
+		const char *s = samples[i];
+		size_t len = strlen(s);
+
+		str_ascii_tolower(s, lower, len);
+		str_ascii_toupper(s, upper, len);
+
+		for(size_t j = 0; j < len; j++) {
+			char c = s[j];
+			char l = (c >= 'A' && c <= 'Z') ? c + 32 : c;
+			char u = (c >= 'a' && c <= 'z') ? c - 32 : c;
+			TEST_ASSERT(lower[j] == l);
+			TEST_ASSERT(upper[j] == u);
+		}
+	}
+
+	// in place conversion
+	char buf[] = "In Place Conversion Of A Reasonably Long String";
+	str_ascii_tolower(buf, buf, strlen(buf));
+	TEST_ASSERT(strcmp(buf, "in place conversion of a reasonably long string") == 0);
+}
+
+void test_find() {
+	const char *needles[] = {"", "a", "Fox", "Dog,", "!", "ASCII",
+		"mixed ü", "not there", "boundaries AZaz @[`{ boundaries AZaz", NULL};
+
+	for(int i = 0; samples[i] != NULL; i++) {
+		const char *hay = samples[i];
+		size_t hay_len = strlen(hay);
+		for(int j = 0; needles[j] != NULL; j++) {
+			const char *needle = needles[j];
+			size_t needle_len = strlen(needle);
+			const char *expected = strstr(hay, needle);
+			TEST_ASSERT(str_find(hay, hay_len, needle, needle_len) == expected);
+		}
+	}
+
+	// match at the very end of a long string
+	char buf[200];
+	memset(buf, 'a', sizeof(buf));
+	memcpy(buf + sizeof(buf) - 3, "abc", 3);
+	TEST_ASSERT(str_find(buf, sizeof(buf), "abc", 3) == buf + sizeof(buf) - 3);
+	TEST_ASSERT(str_find(buf, sizeof(buf) - 1, "abc", 3) == NULL);
+}
+
+void test_findEither() {
+	for(int i = 0; samples[i] != NULL; i++) {
+		const char *s = samples[i];
+		size_t len = strlen(s);
+
+		const char *expected = NULL;
+		for(size_t j = 0; j < len; j++) {
+			if(s[j] == ',' || s[j] == 'z') {
+				expected = s + j;
+				break;
+			}
+		}
+		TEST_ASSERT(str_find_either(s, len, ',', 'z') == expected);
+	}
+
+	// match at every position of a long string
+	char buf[100];
+	memset(buf, 'x', sizeof(buf));
+	for(int i = 0; i < sizeof(buf); i++) {
+		buf[i] = '\n';
+		TEST_ASSERT(str_find_either(buf, sizeof(buf), ',', '\n') == buf + i);
+		buf[i] = 'x';
+	}
+	TEST_ASSERT(str_find_either(buf, sizeof(buf), ',', '\n') == NULL);
+}
+
+TEST_LIST = {
+	{ "isAscii", test_isAscii},
+	{ "caseConversion", test_caseConversion},
+	{ "find", test_find},
+	{ "findEither", test_findEither},
+	{ NULL, NULL }
+};
+